@@ -79,3 +79,32 @@ update_cert server2          "www2.wolfssl.com"                intermediate1-ca
 update_cert server3          "www3.wolfssl.com"                intermediate2-ca v3_req2 07
 update_cert server4          "www4.wolfssl.com"                intermediate2-ca v3_req2 08 # REVOKED
 update_cert server5          "www5.wolfssl.com"                intermediate3-ca v3_req3 09
+
+# $1 cert, $2 issuing ca, $3 index of the ca
+update_resp() {
+    echo "Updating response \"$1-resp.der\""
+    openssl ocsp                \
+        -issuer "$2"-cert.pem   \
+        -cert "$1"-cert.pem     \
+        -no_nonce               \
+        -reqout "$1"-req.der
+    check_result $? "Step 1"
+
+    openssl ocsp                \
+        -index "$3"             \
+        -rsigner "$2"-cert.pem  \
+        -rkey "$2"-key.pem      \
+        -CA "$2"-cert.pem       \
+        -resp_no_certs          \
+        -ndays 1000             \
+        -reqin "$1"-req.der     \
+        -respout "$1"-resp.der
+    check_result $? "Step 2"
+
+    rm "$1"-req.der
+}
+
+# canned responses for the response cache tests
+update_resp server1          intermediate1-ca index-intermediate1-ca-issued-certs.txt
+update_resp server3          intermediate2-ca index-intermediate2-ca-issued-certs.txt
+update_resp intermediate1-ca root-ca          index-ca-and-intermediate-cas.txt
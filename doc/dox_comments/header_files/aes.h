@@ -423,6 +423,139 @@ WOLFSSL_API int  wc_AesGcmDecrypt(Aes* aes, byte* out,
                                    const byte* authTag, word32 authTagSz,
                                    const byte* authIn, word32 authInSz);
 
+/*!
+    \ingroup AES
+    \brief This function starts an incremental AES-GCM operation. The key
+    is optional and may be set once with wc_AesGcmSetKey or an earlier call.
+    The IV must be new for each message; an IV of any length other than 12
+    bytes is hashed as the GCM specification describes. Available when
+    built with WOLFSSL_AESGCM_STREAM.
+
+    \return 0 On success
+    \return BAD_FUNC_ARG If aes is NULL, the key length is not valid, or
+    only one of iv and ivSz is set
+
+    \param aes pointer to the AES object
+    \param key pointer to the key buffer, or NULL to keep the current key
+    \param len length of the key buffer
+    \param iv pointer to the initialization vector, or NULL to only set the
+    key
+    \param ivSz length of the initialization vector
+
+    _Example_
+    \code
+    Aes aes;
+    byte key[32];
+    byte iv[GCM_NONCE_MID_SZ];
+    byte authTag[AES_BLOCK_SIZE];
+
+    wc_AesInit(&aes, NULL, INVALID_DEVID);
+    wc_AesGcmInit(&aes, key, sizeof(key), iv, sizeof(iv));
+    wc_AesGcmEncryptUpdate(&aes, NULL, NULL, 0, authIn, authInSz);
+    while (more data) {
+        wc_AesGcmEncryptUpdate(&aes, out, in, inSz, NULL, 0);
+    }
+    wc_AesGcmEncryptFinal(&aes, authTag, sizeof(authTag));
+    \endcode
+
+    \sa wc_AesGcmEncryptUpdate
+    \sa wc_AesGcmDecryptUpdate
+*/
+WOLFSSL_API int  wc_AesGcmInit(Aes* aes, const byte* key, word32 len,
+                                   const byte* iv, word32 ivSz);
+
+/*!
+    \ingroup AES
+    \brief This function hashes more authentication data and encrypts more
+    plain text of an operation started with wc_AesGcmInit. All of the
+    authentication data must be passed before any plain text. Any length
+    may be passed on each call and in may be the same as out.
+
+    \return 0 On success
+    \return BAD_FUNC_ARG If a pointer is NULL with a non-zero length, or
+    authentication data follows plain text
+    \return BAD_STATE_E If wc_AesGcmInit was not called with an IV
+
+    \param aes pointer to the AES object
+    \param out pointer to the output buffer for the cipher text
+    \param in pointer to the plain text to encrypt
+    \param sz length of the plain text
+    \param authIn pointer to the authentication data
+    \param authInSz length of the authentication data
+
+    \sa wc_AesGcmInit
+    \sa wc_AesGcmEncryptFinal
+*/
+WOLFSSL_API int  wc_AesGcmEncryptUpdate(Aes* aes, byte* out,
+                                   const byte* in, word32 sz,
+                                   const byte* authIn, word32 authInSz);
+
+/*!
+    \ingroup AES
+    \brief This function finishes an incremental AES-GCM encryption and
+    outputs the authentication tag. A new IV must be set with wc_AesGcmInit
+    before the next message.
+
+    \return 0 On success
+    \return BAD_FUNC_ARG If aes or authTag is NULL, or authTagSz is not
+    valid
+    \return BAD_STATE_E If wc_AesGcmInit was not called with an IV
+
+    \param aes pointer to the AES object
+    \param authTag pointer to the buffer to store the authentication tag in
+    \param authTagSz length of the authentication tag
+
+    \sa wc_AesGcmEncryptUpdate
+*/
+WOLFSSL_API int  wc_AesGcmEncryptFinal(Aes* aes, byte* authTag,
+                                   word32 authTagSz);
+
+/*!
+    \ingroup AES
+    \brief This function hashes more authentication data and decrypts more
+    cipher text of an operation started with wc_AesGcmInit. All of the
+    authentication data must be passed before any cipher text. The plain
+    text is not authenticated until wc_AesGcmDecryptFinal returns 0.
+
+    \return 0 On success
+    \return BAD_FUNC_ARG If a pointer is NULL with a non-zero length, or
+    authentication data follows cipher text
+    \return BAD_STATE_E If wc_AesGcmInit was not called with an IV
+
+    \param aes pointer to the AES object
+    \param out pointer to the output buffer for the plain text
+    \param in pointer to the cipher text to decrypt
+    \param sz length of the cipher text
+    \param authIn pointer to the authentication data
+    \param authInSz length of the authentication data
+
+    \sa wc_AesGcmInit
+    \sa wc_AesGcmDecryptFinal
+*/
+WOLFSSL_API int  wc_AesGcmDecryptUpdate(Aes* aes, byte* out,
+                                   const byte* in, word32 sz,
+                                   const byte* authIn, word32 authInSz);
+
+/*!
+    \ingroup AES
+    \brief This function finishes an incremental AES-GCM decryption and
+    checks the authentication tag.
+
+    \return 0 On success
+    \return AES_GCM_AUTH_E If the authentication tag does not match
+    \return BAD_FUNC_ARG If aes or authTag is NULL, or authTagSz is not
+    valid
+    \return BAD_STATE_E If wc_AesGcmInit was not called with an IV
+
+    \param aes pointer to the AES object
+    \param authTag pointer to the authentication tag to check
+    \param authTagSz length of the authentication tag
+
+    \sa wc_AesGcmDecryptUpdate
+*/
+WOLFSSL_API int  wc_AesGcmDecryptFinal(Aes* aes, const byte* authTag,
+                                   word32 authTagSz);
+
 /*!
     \ingroup AES
     \brief This function initializes and sets the key for a GMAC object
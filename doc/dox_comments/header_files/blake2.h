@@ -93,3 +93,100 @@ WOLFSSL_API int wc_Blake2bUpdate(Blake2b*, const byte*, word32);
     \sa wc_Blake2bUpdate
 */
 WOLFSSL_API int wc_Blake2bFinal(Blake2b*, byte*, word32);
+
+/*!
+    \ingroup BLAKE2
+
+    \brief This function initializes a Blake2bp structure for use with the
+    BLAKE2bp hash function. BLAKE2bp is the four-way parallel tree mode of
+    BLAKE2b: four leaves hash interleaved 128 byte blocks of the input and a
+    root hashes the leaf outputs. Its digest differs from BLAKE2b's. When the
+    CPU has AVX2 the four leaves are compressed together.
+
+    \return 0 Returned upon successfully initializing the Blake2bp structure
+    and setting the digest size.
+    \return BAD_FUNC_ARG Returned if b2bp is NULL or digestSz is not between
+    1 and 64
+
+    \param b2bp pointer to the Blake2bp structure to initialize
+    \param digestSz length of the digest to produce
+
+    _Example_
+    \code
+    Blake2bp b2bp;
+    // initialize Blake2bp structure with 64 byte digest
+    wc_InitBlake2bp(&b2bp, 64);
+    \endcode
+
+    \sa wc_Blake2bpUpdate
+*/
+WOLFSSL_API int wc_InitBlake2bp(Blake2bp*, word32);
+
+/*!
+    \ingroup BLAKE2
+
+    \brief This function updates the Blake2bp hash with the given input data.
+    This function should be called after wc_InitBlake2bp, and repeated until
+    one is ready for the final hash: wc_Blake2bpFinal.
+
+    \return 0 Returned upon successfully updating the Blake2bp structure with
+    the given data
+
+    \param b2bp pointer to the Blake2bp structure to update
+    \param data pointer to a buffer containing the data to append
+    \param sz length of the input data to append
+
+    _Example_
+    \code
+    int ret;
+    Blake2bp b2bp;
+    // initialize Blake2bp structure with 64 byte digest
+    wc_InitBlake2bp(&b2bp, 64);
+
+    byte plain[] = { // initialize input };
+
+    ret = wc_Blake2bpUpdate(&b2bp, plain, sizeof(plain));
+    if( ret != 0) {
+    	// error updating blake2bp
+    }
+    \endcode
+
+    \sa wc_InitBlake2bp
+    \sa wc_Blake2bpFinal
+*/
+WOLFSSL_API int wc_Blake2bpUpdate(Blake2bp*, const byte*, word32);
+
+/*!
+    \ingroup BLAKE2
+
+    \brief This function computes the Blake2bp hash of the previously
+    supplied input data. The output hash will be of length requestSz, or, if
+    requestSz==0, the digestSz of the b2bp structure.
+
+    \return 0 Returned upon successfully computing the Blake2bp hash
+
+    \param b2bp pointer to the Blake2bp structure to finalize
+    \param final pointer to a buffer in which to store the blake2bp hash.
+    Should be of length requestSz
+    \param requestSz length of the digest to compute. When this is zero,
+    b2bp->digestSz will be used instead
+
+    _Example_
+    \code
+    int ret;
+    Blake2bp b2bp;
+    byte hash[64];
+    // initialize Blake2bp structure with 64 byte digest
+    wc_InitBlake2bp(&b2bp, 64);
+    ... // call wc_Blake2bpUpdate to add data to hash
+
+    ret = wc_Blake2bpFinal(&b2bp, hash, 64);
+    if( ret != 0) {
+    	// error generating blake2bp hash
+    }
+    \endcode
+
+    \sa wc_InitBlake2bp
+    \sa wc_Blake2bpUpdate
+*/
+WOLFSSL_API int wc_Blake2bpFinal(Blake2bp*, byte*, word32);
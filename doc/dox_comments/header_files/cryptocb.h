@@ -0,0 +1,133 @@
+/*!
+    \ingroup wolfCrypt
+
+    \brief Creates a software crypto callback device that runs public key
+    operations on a pool of worker threads and registers it as devId with
+    wc_CryptoCb_RegisterDevice(). RSA and ECC keys initialized with devId
+    (wc_InitRsaKey_ex(), wc_ecc_init_ex()) then return WC_PENDING_E from
+    RSA, RSA key generation, ECC key generation, ECDH, ECDSA sign and ECDSA
+    verify right away instead of blocking. The operation runs on a worker
+    and its event is returned by wc_CryptoCb_PoolPoll() when done. Calling
+    the same function again with the same arguments then gives the result.
+    The key and buffers must not be used for anything else until then.
+    Workers use their own RNG. Handshakes don't poll the pool, so
+    wolfSSL_CTX_SetDevId() and wolfSSL_SetDevId() reject its devId with
+    BAD_FUNC_ARG. Requires WOLF_CRYPTO_CB_POOL (--enable-cryptocbpool).
+
+    \return pointer to the new pool on success.
+    \return NULL if devId is INVALID_DEVID, threads is <= 0 or above
+    CRYPTOCB_POOL_MAX_THREADS, or memory, RNG or thread setup failed.
+
+    \param devId device id to register the pool as.
+    \param threads number of worker threads.
+    \param heap heap hint for the pool's allocations.
+
+    _Example_
+    \code
+    WC_CRYPTOCB_POOL* pool;
+    ecc_key key;
+    WC_RNG rng;
+
+    pool = wc_CryptoCb_PoolNew(1, 4, NULL);
+    if (pool == NULL) {
+        // failed to create pool
+    }
+    wc_ecc_init_ex(&key, NULL, 1);
+    ret = wc_ecc_make_key(&rng, 32, &key);
+    if (ret == WC_PENDING_E) {
+        // poll with wc_CryptoCb_PoolPoll, then call again
+    }
+    \endcode
+
+    \sa wc_CryptoCb_PoolPoll
+    \sa wc_CryptoCb_PoolFree
+*/
+WOLFSSL_API WC_CRYPTOCB_POOL* wc_CryptoCb_PoolNew(int devId, int threads,
+    void* heap);
+
+/*!
+    \ingroup wolfCrypt
+
+    \brief Stops the pool's workers, unregisters its device and frees it.
+    Operations not yet started are dropped, so wait for pending ones first.
+
+    \return none No returns.
+
+    \param pool pool created with wc_CryptoCb_PoolNew(), may be NULL.
+
+    _Example_
+    \code
+    wc_CryptoCb_PoolFree(pool);
+    \endcode
+
+    \sa wc_CryptoCb_PoolNew
+*/
+WOLFSSL_API void wc_CryptoCb_PoolFree(WC_CRYPTOCB_POOL* pool);
+
+/*!
+    \ingroup wolfCrypt
+
+    \brief Gets the events of operations the pool has finished. Each event's
+    context is the key the operation was for and ret is its result. An event
+    is valid until its operation is called again.
+
+    \return 0 upon success.
+    \return BAD_FUNC_ARG if pool, events or eventCount is NULL or maxEvents
+    is <= 0.
+    \return BAD_MUTEX_E if the pool's lock failed.
+
+    \param pool pool created with wc_CryptoCb_PoolNew().
+    \param events array to get the finished events.
+    \param maxEvents size of events.
+    \param eventCount gets the number of events returned.
+
+    _Example_
+    \code
+    WOLF_EVENT* events[16];
+    int count, i;
+
+    ret = wc_CryptoCb_PoolPoll(pool, events, 16, &count);
+    for (i = 0; ret == 0 && i < count; i++) {
+        // resume the connection using events[i]->context
+    }
+    \endcode
+
+    \sa wc_CryptoCb_PoolNew
+*/
+WOLFSSL_API int  wc_CryptoCb_PoolPoll(WC_CRYPTOCB_POOL* pool,
+    WOLF_EVENT** events, int maxEvents, int* eventCount);
+
+/*!
+    \ingroup wolfCrypt
+
+    \brief Has the pool's workers give queued public key operations of the
+    same type to device devId together, up to maxBatch at a time. The
+    device's callback gets an wc_CryptoInfo with algo_type
+    WC_ALGO_TYPE_PK_BATCH whose batch member holds the operation type, the
+    operations and an array for their results. Returning 0 with a result of
+    CRYPTOCB_UNAVAILABLE for an operation, or returning CRYPTOCB_UNAVAILABLE
+    for the whole batch, has the worker do those operations in software.
+    Any other error fails all of them. The operations' RNG is the worker's.
+
+    \return 0 upon success.
+    \return BAD_FUNC_ARG if pool is NULL, devId is the pool's own device or
+    maxBatch is <= 0 or above CRYPTOCB_POOL_MAX_BATCH.
+    \return BAD_MUTEX_E if the pool's lock failed.
+
+    \param pool pool created with wc_CryptoCb_PoolNew().
+    \param devId registered device to get the batches, INVALID_DEVID to stop
+    batching.
+    \param maxBatch most operations in one batch.
+
+    _Example_
+    \code
+    ret = wc_CryptoCb_RegisterDevice(2, myBatchCb, NULL);
+    if (ret == 0)
+        ret = wc_CryptoCb_PoolSetBatch(pool, 2, 8);
+    \endcode
+
+    \sa wc_CryptoCb_PoolNew
+    \sa wc_CryptoCb_RegisterDevice
+*/
+WOLFSSL_API int  wc_CryptoCb_PoolSetBatch(WC_CRYPTOCB_POOL* pool, int devId,
+    int maxBatch);
@@ -298,3 +298,59 @@ WOLFSSL_API int wolfSSL_StaticBufferSz(byte* buffer, word32 sz, int flag);
     \sa wolfSSL_Free
 */
 WOLFSSL_API int wolfSSL_MemoryPaddingSz(void);
+
+/*!
+    \ingroup Memory
+
+    \brief This function is available when per type memory stats are used
+    (--enable-memtypestats). It gets the memory allocated with XMALLOC of one
+    DYNAMIC_TYPE_* value, either for the whole library (owner 0) or for one
+    WOLFSSL_CTX owner. Counters are kept with atomic operations, so they can
+    be read while other threads allocate. Types at or above
+    WC_MEM_TYPE_COUNT are counted as type 0.
+
+    \return 0 on success.
+    \return BAD_FUNC_ARG if stats is NULL or owner or type is out of range.
+
+    \param owner 0 for the library or an owner from wc_MemStatsNewOwner().
+    \param type DYNAMIC_TYPE_* value, below WC_MEM_TYPE_COUNT.
+    \param stats gets the current and peak bytes and the current and total
+    allocations.
+
+    _Example_
+    \code
+    WC_MEM_TYPE_STATS stats;
+
+    if (wc_MemStatsGet(0, DYNAMIC_TYPE_HASHES, &stats) == 0) {
+        printf("handshake hashes: %llu bytes\n",
+               (unsigned long long)stats.curBytes);
+    }
+    \endcode
+
+    \sa wc_MemStatsPrint
+    \sa wolfSSL_CTX_get_mem_stats
+*/
+WOLFSSL_API int  wc_MemStatsGet(int owner, int type,
+                                    WC_MEM_TYPE_STATS* stats);
+
+/*!
+    \ingroup Memory
+
+    \brief This function is available when per type memory stats are used
+    (--enable-memtypestats). It prints a line to stdout for each
+    DYNAMIC_TYPE_* that owner has allocated: current bytes, peak bytes,
+    current allocations and total allocations.
+
+    \return none No returns.
+
+    \param owner 0 for the library or an owner from wc_MemStatsNewOwner().
+
+    _Example_
+    \code
+    wc_MemStatsPrint(0);
+    \endcode
+
+    \sa wc_MemStatsGet
+    \sa wolfSSL_CTX_print_mem_stats
+*/
+WOLFSSL_API void wc_MemStatsPrint(int owner);
@@ -152,6 +152,51 @@ WOLFSSL_API void wc_Sha256Free(wc_Sha256*);
 */
 WOLFSSL_API int wc_Sha256GetHash(wc_Sha256*, byte*);
 
+/*!
+    \ingroup SHA
+
+    \brief Finishes a batch of independent SHA-256 hashes. Each state takes
+    its last data and is then finalized into its hash and reset, as with
+    wc_Sha256Update() followed by wc_Sha256Final(). When built with
+    WOLFSSL_SHA256_MULTI_BUFFER and USE_INTEL_SPEEDUP the messages are
+    hashed side by side, 8 per pass with AVX2 or 16 with AVX-512, which is
+    much faster than hashing them one at a time for many short messages.
+
+    \return 0 Success
+    \return BAD_FUNC_ARG Returned if an array is NULL, a state or hash is
+    NULL, or data is NULL with a non-zero length.
+
+    \param sha256 array of cnt initialized states, which may already hold
+    hashed data.
+    \param data array of cnt pointers to the last data of each message.
+    \param len array of cnt data lengths.
+    \param hash array of cnt buffers of WC_SHA256_DIGEST_SIZE bytes.
+    \param cnt number of messages.
+
+    _Example_
+    \code
+    wc_Sha256 sha[2];
+    wc_Sha256* shaPtr[2] = { &sha[0], &sha[1] };
+    const byte* data[2] = { msg1, msg2 };
+    word32 len[2] = { msg1Sz, msg2Sz };
+    byte hash1[WC_SHA256_DIGEST_SIZE], hash2[WC_SHA256_DIGEST_SIZE];
+    byte* hash[2] = { hash1, hash2 };
+
+    wc_InitSha256(&sha[0]);
+    wc_InitSha256(&sha[1]);
+    if (wc_Sha256MultiBuffer(shaPtr, data, len, hash, 2) != 0) {
+        // Handle error
+    }
+    \endcode
+
+    \sa wc_Sha256Update
+    \sa wc_Sha256Final
+*/
+WOLFSSL_API int wc_Sha256MultiBuffer(wc_Sha256* const* sha256,
+                                     const byte* const* data,
+                                     const word32* len, byte* const* hash,
+                                     word32 cnt);
+
 /*!
     \ingroup SHA
 
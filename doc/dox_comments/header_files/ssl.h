@@ -994,7 +994,15 @@ WOLFSSL_API int wolfSSL_CTX_load_verify_locations(WOLFSSL_CTX*, const char*,
     \param path pointer to the name of a directory to load PEM-formatted
     certificates from.
     \param flags possible mask values are: WOLFSSL_LOAD_FLAG_IGNORE_ERR,
-    WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY and WOLFSSL_LOAD_FLAG_PEM_CA_ONLY
+    WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY, WOLFSSL_LOAD_FLAG_PEM_CA_ONLY,
+    WOLFSSL_LOAD_FLAG_PARALLEL and WOLFSSL_LOAD_FLAG_LAZY.
+    WOLFSSL_LOAD_FLAG_PARALLEL (WOLFSSL_PARALLEL_CA_LOAD) shares the files of
+    path out to up to CA_LOAD_THREADS threads. CAs are still added in listing
+    order, but a CA is not checked against an issuer loaded in the same call
+    for its path length. WOLFSSL_LOAD_FLAG_LAZY (WOLFSSL_LAZY_CA_LOAD) only
+    indexes each CA by its subject name and key id, the certificate is decoded
+    and its dates and key checked the first time it is looked up. A CA that
+    fails then is dropped and the lookup finds no signer.
 
     _Example_
     \code
@@ -8954,6 +8962,157 @@ WOLFSSL_API int wolfSSL_CertManagerLoadCABuffer(WOLFSSL_CERT_MANAGER*,
 */
 WOLFSSL_API int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm);
 
+/*!
+    \ingroup CertManager
+    \brief This function writes every CA signer held by the certificate
+    manager to a buffer in the precompiled trust store format. The store can
+    later be attached to a certificate manager with
+    wolfSSL_CertManagerLoadTrustStoreBuffer() or
+    wolfSSL_CertManagerLoadTrustStore() without parsing any certificates.
+    The format depends on the signer digest settings of the build, stores are
+    only portable between builds with the same settings.
+
+    \return SSL_SUCCESS returned on success.
+    \return LENGTH_ONLY_E returned when buf is NULL, sz is set to the size
+    needed.
+    \return BUFFER_E returned if sz is too small for the store.
+    \return BAD_FUNC_ARG returned if cm or sz is NULL.
+    \return BAD_MUTEX_E returned if the CA lock could not be taken.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param buf buffer to write the store to, or NULL to get the size.
+    \param sz in: size of buf, out: size of the store.
+
+    _Example_
+    \code
+    int sz = 0;
+    unsigned char* store;
+    if (wolfSSL_CertManagerSaveTrustStoreBuffer(cm, NULL, &sz) ==
+                                                              LENGTH_ONLY_E) {
+        store = malloc(sz);
+        ret = wolfSSL_CertManagerSaveTrustStoreBuffer(cm, store, &sz);
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerLoadTrustStoreBuffer
+    \sa wolfSSL_CertManagerSaveTrustStore
+*/
+WOLFSSL_API int wolfSSL_CertManagerSaveTrustStoreBuffer(
+            WOLFSSL_CERT_MANAGER* cm, unsigned char* buf, int* sz);
+
+/*!
+    \ingroup CertManager
+    \brief This function adds the CA signers of a precompiled trust store
+    in memory to the certificate manager. Signer keys and names point into
+    buf rather than being copied, so buf must stay valid and unmodified until
+    the CAs are unloaded or the certificate manager is freed. CAs already
+    held are skipped.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if cm or buf is NULL or sz is not positive.
+    \return CACHE_MATCH_ERROR returned if buf is not a trust store or was
+    built with different signer digest settings.
+    \return BUFFER_E returned if the store is truncated or corrupt.
+    \return MEMORY_E returned if memory allocation fails.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param buf trust store made by wolfSSL_CertManagerSaveTrustStoreBuffer().
+    \param sz size of buf in bytes.
+
+    _Example_
+    \code
+    extern const unsigned char ca_store[];
+    extern const long ca_store_sz;
+    ret = wolfSSL_CertManagerLoadTrustStoreBuffer(cm, ca_store, ca_store_sz);
+    \endcode
+
+    \sa wolfSSL_CertManagerSaveTrustStoreBuffer
+    \sa wolfSSL_CertManagerLoadTrustStore
+*/
+WOLFSSL_API int wolfSSL_CertManagerLoadTrustStoreBuffer(
+            WOLFSSL_CERT_MANAGER* cm, const unsigned char* buf, long sz);
+
+/*!
+    \ingroup CertManager
+    \brief This function writes every CA signer held by the certificate
+    manager to fname in the precompiled trust store format. The
+    examples/truststore tool wraps this to compile CA bundles.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if cm or fname is NULL.
+    \return WOLFSSL_BAD_FILE returned if fname can't be opened.
+    \return FWRITE_ERROR returned if the write fails.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param fname file to write the trust store to.
+
+    _Example_
+    \code
+    wolfSSL_CertManagerLoadCA(cm, "/etc/ssl/certs/ca-certificates.crt", NULL);
+    ret = wolfSSL_CertManagerSaveTrustStore(cm, "ca.wts");
+    \endcode
+
+    \sa wolfSSL_CertManagerLoadTrustStore
+    \sa wolfSSL_CertManagerSaveTrustStoreBuffer
+*/
+WOLFSSL_API int wolfSSL_CertManagerSaveTrustStore(WOLFSSL_CERT_MANAGER* cm,
+                                                  const char* fname);
+
+/*!
+    \ingroup CertManager
+    \brief This function adds the CA signers of a precompiled trust store
+    file to the certificate manager. Where mmap() is available the file is
+    mapped read only and shared between processes, otherwise it is read into
+    memory. The store stays attached until the CAs are unloaded or the
+    certificate manager is freed.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if cm or fname is NULL.
+    \return WOLFSSL_BAD_FILE returned if fname can't be opened or mapped.
+    \return CACHE_MATCH_ERROR returned if fname is not a trust store or was
+    built with different signer digest settings.
+    \return BUFFER_E returned if the store is truncated or corrupt.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param fname trust store file.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm = wolfSSL_CertManagerNew();
+    if (wolfSSL_CertManagerLoadTrustStore(cm, "ca.wts") != SSL_SUCCESS) {
+        // fall back to wolfSSL_CertManagerLoadCA()
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSaveTrustStore
+    \sa wolfSSL_CTX_LoadTrustStore
+*/
+WOLFSSL_API int wolfSSL_CertManagerLoadTrustStore(WOLFSSL_CERT_MANAGER* cm,
+                                                  const char* fname);
+
+/*!
+    \ingroup CertsKeys
+    \brief This function loads a precompiled trust store file into the
+    certificate manager of ctx. See wolfSSL_CertManagerLoadTrustStore().
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if ctx or fname is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param fname trust store file.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+    ret = wolfSSL_CTX_LoadTrustStore(ctx, "ca.wts");
+    \endcode
+
+    \sa wolfSSL_CertManagerLoadTrustStore
+    \sa wolfSSL_CTX_load_verify_locations
+*/
+WOLFSSL_API int wolfSSL_CTX_LoadTrustStore(WOLFSSL_CTX* ctx,
+                                           const char* fname);
+
 /*!
     \ingroup CertManager
     \brief The function will free the Trusted Peer linked list and unlocks
@@ -9504,6 +9663,37 @@ WOLFSSL_API int wolfSSL_CertManagerSetOCSPOverrideURL(WOLFSSL_CERT_MANAGER*,
 WOLFSSL_API int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
 
+/*!
+    \ingroup CertManager
+    \brief This function sets the maximum number of OCSP responses cached by
+    the WOLFSSL_CERT_MANAGER. Cached responses are looked up by issuer name
+    hash, issuer key hash and serial number. A response is dropped once its
+    nextUpdate time has passed and the least recently used responses are
+    evicted when the cache is full. The default is OCSP_CACHE_SIZE.
+
+    \return SSL_SUCCESS returned on successful execution.
+    \return BAD_FUNC_ARG returned if the WOLFSSL_CERT_MANAGER is NULL.
+    \return BAD_MUTEX_E returned if the cache lock could not be taken.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param sz the maximum number of cached responses, 0 for no limit.
+
+    _Example_
+    \code
+    #include <wolfssl/ssl.h>
+    WOLFSSL_CERT_MANAGER* cm = wolfSSL_CertManagerNew();
+    …
+    if (wolfSSL_CertManagerSetOCSPCacheSize(cm, 10000) != SSL_SUCCESS) {
+        // Failure case.
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerEnableOCSP
+    \sa wolfSSL_CTX_SetOCSPCacheSize
+*/
+WOLFSSL_API int wolfSSL_CertManagerSetOCSPCacheSize(WOLFSSL_CERT_MANAGER*,
+                                                                unsigned int);
+
 /*!
     \ingroup CertManager
     \brief This function turns on OCSP stapling if it is not turned on as well
@@ -10022,6 +10212,31 @@ WOLFSSL_API int wolfSSL_CTX_SetOCSP_OverrideURL(WOLFSSL_CTX*, const char*);
 WOLFSSL_API int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
 
+/*!
+    \ingroup OCSP
+    \brief Sets the maximum number of OCSP responses cached by the
+    WOLFSSL_CERT_MANAGER of the context. See
+    wolfSSL_CertManagerSetOCSPCacheSize().
+
+    \return SSL_SUCCESS returned on successful execution.
+    \return BAD_FUNC_ARG returned if the WOLFSSL_CTX is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created using
+    wolfSSL_CTX_new().
+    \param sz the maximum number of cached responses, 0 for no limit.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new( protocol method );
+    …
+    wolfSSL_CTX_EnableOCSP(ctx, WOLFSSL_OCSP_CHECKALL);
+    wolfSSL_CTX_SetOCSPCacheSize(ctx, 10000);
+    \endcode
+
+    \sa wolfSSL_CertManagerSetOCSPCacheSize
+*/
+WOLFSSL_API int wolfSSL_CTX_SetOCSPCacheSize(WOLFSSL_CTX*, unsigned int);
+
 /*!
     \brief This function enables OCSP stapling by calling
     wolfSSL_CertManagerEnableOCSPStapling().
@@ -10054,6 +10269,44 @@ WOLFSSL_API int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX*,
 */
 WOLFSSL_API int wolfSSL_CTX_EnableOCSPStapling(WOLFSSL_CTX*);
 
+/*!
+    \ingroup OCSP
+    \brief Enables OCSP stapling and keeps the OCSP responses for the
+    certificate (and, with OCSP stapling v2, the certificate chain) loaded
+    into the context fresh from a background thread. The responses are
+    fetched once before this function returns and then refreshed half way
+    to their next update time, so handshakes never wait on the OCSP
+    responder. A failed refresh is retried after a minute while the last
+    good response is still served. Requires the
+    --enable-ocspstapling-refresh build option.
+
+    \return SSL_SUCCESS returned on successful execution, even if the
+    initial fetch failed.
+    \return BAD_FUNC_ARG returned if the WOLFSSL_CTX is NULL.
+    \return NO_CERT_ERROR returned if no certificate is loaded yet.
+    \return ASN_NO_SIGNER_E returned if the issuer of the certificate has
+    not been loaded as a CA.
+    \return THREAD_CREATE_E returned if the refresh thread can't start.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created using
+    wolfSSL_CTX_new().
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new( protocol method );
+    …
+    wolfSSL_CTX_load_verify_locations(ctx, "ca-cert.pem", NULL);
+    wolfSSL_CTX_use_certificate_chain_file(ctx, "server-cert.pem");
+    if (wolfSSL_CTX_EnableOCSPStaplingRefresh(ctx) != SSL_SUCCESS) {
+        // staples will be fetched during each handshake instead
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_EnableOCSPStapling
+    \sa wolfSSL_CTX_SetOCSP_Cb
+*/
+WOLFSSL_API int wolfSSL_CTX_EnableOCSPStaplingRefresh(WOLFSSL_CTX*);
+
 /*!
     \ingroup CertsKeys
 
@@ -10282,6 +10535,82 @@ WOLFSSL_API void wolfSSL_SNI_SetOptions(WOLFSSL* ssl, unsigned char type,
 WOLFSSL_API void wolfSSL_CTX_SNI_SetOptions(WOLFSSL_CTX* ctx,
                                      unsigned char type, unsigned char options);
 
+/*!
+    \brief This function is called on the server side to add a certificate
+    chain and private key to the context's SNI certificate table. When a
+    client's Server Name Indication matches hostName the server sends this
+    certificate instead of the context's. A hostName starting with "*." also
+    matches any single label in its place. Names are matched without regard
+    to case and an exact name is preferred over a wildcard. Adding a name that
+    is already in the table replaces its certificate. Connections that have
+    already picked a certificate keep it. All entries share the context's
+    certificate manager, and the context still needs its own default
+    certificate. Requires WOLFSSL_SNI_TABLE (--enable-snitable).
+
+    \return WOLFSSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx, hostName, chain or key is NULL, a size is
+    <= 0, or hostName is empty, too long, or has a '*' anywhere other than a
+    leading "*." label.
+    \return MEMORY_E if there was an error allocating memory.
+    \return other negative values if the chain or key can not be parsed or
+    the key does not match the certificate.
+
+    \param ctx pointer to a SSL context, created with wolfSSL_CTX_new().
+    \param hostName NUL terminated host name, optionally starting with "*.".
+    \param chain the server certificate followed by any intermediate CA
+    certificates.
+    \param chainSz size of chain in bytes.
+    \param key private key for the server certificate.
+    \param keySz size of key in bytes.
+    \param format format of chain and key, WOLFSSL_FILETYPE_PEM or
+    WOLFSSL_FILETYPE_ASN1.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    byte cert[4096], key[2048];
+    long certSz, keySz;
+    // load the default certificate into ctx, read cert and key...
+    ret = wolfSSL_CTX_SNI_AddCert_buffer(ctx, "*.example.com", cert, certSz,
+                                         key, keySz, WOLFSSL_FILETYPE_PEM);
+    if (ret != WOLFSSL_SUCCESS) {
+        // failed to add certificate
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_SNI_RemoveCert
+    \sa wolfSSL_SNI_GetRequest
+*/
+WOLFSSL_API int wolfSSL_CTX_SNI_AddCert_buffer(WOLFSSL_CTX* ctx,
+                        const char* hostName, const unsigned char* chain,
+                        long chainSz, const unsigned char* key, long keySz,
+                        int format);
+
+/*!
+    \brief This function is called on the server side to remove a host name
+    added with wolfSSL_CTX_SNI_AddCert_buffer(). Connections already using its
+    certificate keep it until they are freed or cleared.
+
+    \return WOLFSSL_SUCCESS upon success.
+    \return WOLFSSL_FAILURE if hostName is not in the table.
+    \return BAD_FUNC_ARG if ctx or hostName is NULL or hostName is invalid.
+
+    \param ctx pointer to a SSL context, created with wolfSSL_CTX_new().
+    \param hostName the host name as it was added, including any "*.".
+
+    _Example_
+    \code
+    ret = wolfSSL_CTX_SNI_RemoveCert(ctx, "*.example.com");
+    if (ret != WOLFSSL_SUCCESS) {
+        // name was not in the table
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_SNI_AddCert_buffer
+*/
+WOLFSSL_API int wolfSSL_CTX_SNI_RemoveCert(WOLFSSL_CTX* ctx,
+                                           const char* hostName);
+
 /*!
     \brief This function is called on the server side to retrieve the Server
     Name Indication provided by the client from the Client Hello message sent
@@ -11357,6 +11686,277 @@ WOLFSSL_API int wolfSSL_UseClientQSHKeys(WOLFSSL* ssl, unsigned char flag);
 */
 WOLFSSL_API int wolfSSL_SetHsDoneCb(WOLFSSL*, HandShakeDoneCb, void*);
 
+/*!
+    \ingroup IO
+
+    \brief Gets where the time of the handshake went. opNs has the
+    nanoseconds spent in each WOLFSSL_HST_ operation: key share generation,
+    key agreement, signing, verifying the peer's signature, verifying the
+    peer's certificates (OCSP included), OCSP and session ticket creation.
+    opCount has how often each ran. msgNs has, by handshake message type, how
+    long after the start each received message was processed. The
+    WOLFSSL_HST_TOTAL entry is set once the handshake is done, so it can be
+    read from the handshake done callback. Times come from a monotonic clock,
+    clock_gettime() or QueryPerformanceCounter(), or WOLFSSL_HS_TIMING_NOW()
+    when defined. Requires WOLFSSL_HANDSHAKE_TIMING (--enable-hstiming).
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ssl or timing is NULL.
+
+    \param ssl a pointer to a WOLFSSL structure, created using wolfSSL_new().
+    \param timing gets the timing of the last or current handshake.
+
+    _Example_
+    \code
+    WOLFSSL_HS_TIMING timing;
+
+    if (wolfSSL_connect(ssl) == SSL_SUCCESS &&
+            wolfSSL_get_handshake_timing(ssl, &timing) == SSL_SUCCESS) {
+        printf("handshake %lu ns, ECDH %lu ns\n",
+               (unsigned long)timing.opNs[WOLFSSL_HST_TOTAL],
+               (unsigned long)timing.opNs[WOLFSSL_HST_KEY_AGREE]);
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_get_handshake_histogram
+    \sa wolfSSL_SetHsDoneCb
+*/
+WOLFSSL_API int wolfSSL_get_handshake_timing(WOLFSSL* ssl,
+                                            WOLFSSL_HS_TIMING* timing);
+
+/*!
+    \ingroup IO
+
+    \brief Copies the CTX histogram of a handshake operation over all the
+    handshakes done with it. Bucket 0 counts handshakes where the operation
+    took under a microsecond, bucket i those taking 2^(i-1) up to 2^i
+    microseconds and the last bucket all longer. Handshakes not running the
+    operation are not counted.
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx or buckets is NULL, op is not a WOLFSSL_HST_
+    operation or bucketsSz is less than WOLFSSL_HST_BUCKETS.
+    \return BAD_MUTEX_E if the CTX lock failed.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param op the operation, WOLFSSL_HST_TOTAL for whole handshakes.
+    \param buckets gets the counts.
+    \param bucketsSz number of entries in buckets.
+
+    _Example_
+    \code
+    word32 buckets[WOLFSSL_HST_BUCKETS];
+
+    ret = wolfSSL_CTX_get_handshake_histogram(ctx, WOLFSSL_HST_TOTAL,
+                                              buckets, WOLFSSL_HST_BUCKETS);
+    \endcode
+
+    \sa wolfSSL_CTX_reset_handshake_histogram
+    \sa wolfSSL_get_handshake_timing
+*/
+WOLFSSL_API int wolfSSL_CTX_get_handshake_histogram(WOLFSSL_CTX* ctx, int op,
+                                            word32* buckets, int bucketsSz);
+
+/*!
+    \ingroup IO
+
+    \brief Clears the CTX handshake timing histograms.
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+    \return BAD_MUTEX_E if the CTX lock failed.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+
+    _Example_
+    \code
+    wolfSSL_CTX_reset_handshake_histogram(ctx);
+    \endcode
+
+    \sa wolfSSL_CTX_get_handshake_histogram
+*/
+WOLFSSL_API int wolfSSL_CTX_reset_handshake_histogram(WOLFSSL_CTX* ctx);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the performance counters of the connections made with ctx:
+    full and resumed handshakes, server session resumption hits and misses,
+    session cache adds, application data bytes and records encrypted and
+    decrypted, alerts sent and received, I/O buffer grows and shrinks, and
+    OCSP and CRL checks of peer certificates. Counters are updated without
+    locking and may be read while connections run. Requires
+    WOLFSSL_PERF_COUNTERS (--enable-perfcounters).
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx or stats is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param stats gets the counters.
+
+    _Example_
+    \code
+    WOLFSSL_PERF_STATS stats;
+
+    if (wolfSSL_CTX_get_perf_stats(ctx, &stats) == SSL_SUCCESS) {
+        printf("resumed %llu of %llu\n", stats.resumedHandshakes,
+               stats.fullHandshakes + stats.resumedHandshakes);
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_reset_perf_stats
+    \sa wolfSSL_get_perf_stats
+*/
+WOLFSSL_API int wolfSSL_CTX_get_perf_stats(WOLFSSL_CTX* ctx,
+                                           WOLFSSL_PERF_STATS* stats);
+
+/*!
+    \ingroup IO
+
+    \brief Sets the performance counters of ctx back to zero.
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+
+    _Example_
+    \code
+    wolfSSL_CTX_reset_perf_stats(ctx);
+    \endcode
+
+    \sa wolfSSL_CTX_get_perf_stats
+*/
+WOLFSSL_API int wolfSSL_CTX_reset_perf_stats(WOLFSSL_CTX* ctx);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the performance counters of all connections in the library,
+    the sum of every CTX since the last wolfSSL_reset_perf_stats().
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if stats is NULL.
+
+    \param stats gets the counters.
+
+    _Example_
+    \code
+    WOLFSSL_PERF_STATS stats;
+
+    ret = wolfSSL_get_perf_stats(&stats);
+    \endcode
+
+    \sa wolfSSL_reset_perf_stats
+    \sa wolfSSL_CTX_get_perf_stats
+*/
+WOLFSSL_API int wolfSSL_get_perf_stats(WOLFSSL_PERF_STATS* stats);
+
+/*!
+    \ingroup IO
+
+    \brief Sets the library wide performance counters back to zero. The
+    counters of each CTX are not changed.
+
+    \return SSL_SUCCESS always.
+
+    _Example_
+    \code
+    wolfSSL_reset_perf_stats();
+    \endcode
+
+    \sa wolfSSL_get_perf_stats
+*/
+WOLFSSL_API int wolfSSL_reset_perf_stats(void);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the memory of one DYNAMIC_TYPE_* charged to ctx. A thread's
+    allocations are charged to the CTX of the last wolfSSL_new(),
+    wolfSSL_connect(), wolfSSL_accept(), wolfSSL_read(), wolfSSL_write() or
+    certificate/key load it ran, so this covers the connections made with
+    ctx and its own setup. Requires WOLFSSL_MEM_TYPE_STATS
+    (--enable-memtypestats).
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx or stats is NULL or type is out of range.
+    \return BAD_STATE_E if ctx got no stats owner because
+    WC_MEM_STATS_OWNERS CTXs were already in use.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param type DYNAMIC_TYPE_* value, below WC_MEM_TYPE_COUNT.
+    \param stats gets the current and peak bytes and allocations.
+
+    _Example_
+    \code
+    WC_MEM_TYPE_STATS stats;
+
+    ret = wolfSSL_CTX_get_mem_stats(ctx, DYNAMIC_TYPE_IN_BUFFER, &stats);
+    \endcode
+
+    \sa wolfSSL_CTX_print_mem_stats
+    \sa wc_MemStatsGet
+*/
+WOLFSSL_API int wolfSSL_CTX_get_mem_stats(WOLFSSL_CTX* ctx, int type,
+                                          WC_MEM_TYPE_STATS* stats);
+
+/*!
+    \ingroup IO
+
+    \brief Prints the memory charged to ctx to stdout, one line per
+    DYNAMIC_TYPE_* it has allocated.
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ctx is NULL.
+    \return BAD_STATE_E if ctx got no stats owner.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+
+    _Example_
+    \code
+    wolfSSL_CTX_print_mem_stats(ctx);
+    \endcode
+
+    \sa wolfSSL_CTX_get_mem_stats
+*/
+WOLFSSL_API int wolfSSL_CTX_print_mem_stats(WOLFSSL_CTX* ctx);
+
+/*!
+    \ingroup IO
+
+    \brief Gets how the handshake arena of ssl was used. Handshake hashes,
+    arrays, keys and the decoded peer certificate are bumped out of one
+    WOLFSSL_HS_ARENA_SZ byte chunk per WOLFSSL. The chunk is allocated when
+    the handshake starts and goes back to the heap once they are freed after
+    the handshake. Space freed during the handshake is only reused once the
+    whole chunk is free. Allocations that do not fit come from the heap.
+    Requires WOLFSSL_HANDSHAKE_ARENA (--enable-hsarena).
+
+    \return SSL_SUCCESS upon success.
+    \return BAD_FUNC_ARG if ssl is NULL.
+
+    \param ssl a pointer to a WOLFSSL structure.
+    \param peak gets the most bytes of the chunk used at once, freed space
+    not yet reused included, may be NULL.
+    \param fallbacks gets the number of allocations that went to the heap
+    as they did not fit, may be NULL.
+
+    _Example_
+    \code
+    word32 peak, fallbacks;
+
+    wolfSSL_get_hs_arena_stats(ssl, &peak, &fallbacks);
+    if (fallbacks > 0) {
+        // build with a bigger WOLFSSL_HS_ARENA_SZ than peak
+    }
+    \endcode
+
+    \sa wolfSSL_new
+*/
+WOLFSSL_API int wolfSSL_get_hs_arena_stats(WOLFSSL* ssl, word32* peak,
+                                           word32* fallbacks);
+
 /*!
     \ingroup IO
 
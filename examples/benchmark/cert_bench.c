@@ -0,0 +1,338 @@
+/* cert_bench.c
+ *
+ * Copyright (C) 2006-2020 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+/*
+Multi-threaded certificate verify benchmark. All threads share one
+certificate manager, so every verify looks its issuer up in the same CA
+table. Runs with 1, 2, 4, ... up to the requested thread count to show how
+verify throughput scales.
+
+Example gcc build statement
+gcc -lwolfssl -lpthread -o cert_bench cert_bench.c
+./cert_bench -t 8
+*/
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/test.h>
+
+/* force certificate test buffers to be included via headers */
+#undef  USE_CERT_BUFFERS_2048
+#define USE_CERT_BUFFERS_2048
+#undef  USE_CERT_BUFFERS_256
+#define USE_CERT_BUFFERS_256
+#include <wolfssl/certs_test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#ifdef HAVE_PTHREAD
+    #include <pthread.h>
+#endif
+
+/* Defaults for configuration parameters */
+#ifndef BENCH_RUNTIME_SEC
+    #define BENCH_RUNTIME_SEC   1
+#endif
+#define BENCH_MAX_THREADS       4
+#define BENCH_THREAD_LIMIT      256
+
+#if !defined(WOLFCRYPT_ONLY) && !defined(NO_CERTS) && \
+    (defined(HAVE_ECC) || !defined(NO_RSA))
+
+typedef struct {
+    WOLFSSL_CERT_MANAGER* cm;
+    const unsigned char*  cert;
+    long                  certSz;
+    int                   runTimeSec;
+    long                  count;
+    int                   ret;
+} bench_thread_t;
+
+/* Global vars for argument parsing */
+int myoptind = 0;
+char* myoptarg = NULL;
+
+static double gettime_secs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
+static void* bench_verify_thread(void* args)
+{
+    bench_thread_t* info = (bench_thread_t*)args;
+    double start = gettime_secs();
+    int ret;
+
+    info->count = 0;
+    info->ret = 0;
+    do {
+        ret = wolfSSL_CertManagerVerifyBuffer(info->cm, info->cert,
+                                              info->certSz,
+                                              WOLFSSL_FILETYPE_ASN1);
+        /* The test certificates may be outside their validity window. The
+         * signer lookup and signature check still ran, so count them. */
+        if (ret != WOLFSSL_SUCCESS && ret != ASN_AFTER_DATE_E &&
+                                      ret != ASN_BEFORE_DATE_E) {
+            info->ret = ret;
+            break;
+        }
+        info->count++;
+    } while ((info->count & 0xF) != 0 ||
+             gettime_secs() - start < info->runTimeSec);
+
+    return NULL;
+}
+
+static int bench_verify(WOLFSSL_CERT_MANAGER* cm, const unsigned char* cert,
+                        long certSz, int threads, int runTimeSec,
+                        double* perSec)
+{
+    bench_thread_t* info;
+    double start, elapsed;
+    long total = 0;
+    int i, ret = 0;
+#ifdef HAVE_PTHREAD
+    pthread_t* tid;
+#endif
+
+    info = (bench_thread_t*)XMALLOC(sizeof(bench_thread_t) * threads, NULL,
+                                    DYNAMIC_TYPE_TMP_BUFFER);
+    if (info == NULL)
+        return MEMORY_E;
+#ifdef HAVE_PTHREAD
+    tid = (pthread_t*)XMALLOC(sizeof(pthread_t) * threads, NULL,
+                              DYNAMIC_TYPE_TMP_BUFFER);
+    if (tid == NULL) {
+        XFREE(info, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        return MEMORY_E;
+    }
+#endif
+
+    start = gettime_secs();
+    for (i = 0; i < threads; i++) {
+        info[i].cm = cm;
+        info[i].cert = cert;
+        info[i].certSz = certSz;
+        info[i].runTimeSec = runTimeSec;
+    #ifdef HAVE_PTHREAD
+        if (pthread_create(&tid[i], NULL, bench_verify_thread, &info[i]) != 0)
+            break;
+    #else
+        bench_verify_thread(&info[i]);
+    #endif
+    }
+#ifdef HAVE_PTHREAD
+    threads = i;
+    for (i = 0; i < threads; i++)
+        pthread_join(tid[i], NULL);
+#endif
+    elapsed = gettime_secs() - start;
+
+    for (i = 0; i < threads; i++) {
+        total += info[i].count;
+        if (info[i].ret != 0)
+            ret = info[i].ret;
+    }
+    *perSec = (elapsed > 0) ? (double)total / elapsed : 0;
+
+#ifdef HAVE_PTHREAD
+    XFREE(tid, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    XFREE(info, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+
+static int bench_cert(const char* desc, const unsigned char* ca, long caSz,
+                      const unsigned char* cert, long certSz, int maxThreads,
+                      int runTimeSec)
+{
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_CERT_MANAGER* cm;
+    double perSec, base = 0;
+    int threads, ret;
+
+#ifndef NO_WOLFSSL_CLIENT
+    ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+#else
+    ctx = wolfSSL_CTX_new(wolfSSLv23_server_method());
+#endif
+    if (ctx == NULL)
+        return MEMORY_E;
+    cm = wolfSSL_CTX_GetCertManager(ctx);
+
+    /* test CA may be outside its validity window, still load it */
+    ret = wolfSSL_CTX_load_verify_buffer_ex(ctx, ca, caSz,
+                    WOLFSSL_FILETYPE_ASN1, 0, WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY);
+    if (ret != WOLFSSL_SUCCESS) {
+        printf("%s: failed to load CA %d\n", desc, ret);
+        wolfSSL_CTX_free(ctx);
+        return ret;
+    }
+
+    for (threads = 1; ; threads *= 2) {
+        if (threads > maxThreads)
+            threads = maxThreads;
+
+        ret = bench_verify(cm, cert, certSz, threads, runTimeSec, &perSec);
+        if (ret != 0) {
+            printf("%s: verify failed %d\n", desc, ret);
+            break;
+        }
+        if (threads == 1)
+            base = perSec;
+        printf("%s\t%d threads\t%10.1f verifies/sec\t%5.2fx\n", desc,
+               threads, perSec, (base > 0) ? perSec / base : 0);
+
+        if (threads == maxThreads)
+            break;
+    }
+
+    wolfSSL_CTX_free(ctx);
+
+    return ret;
+}
+
+static void Usage(void)
+{
+    printf("cert_bench "    LIBWOLFSSL_VERSION_STRING "\n");
+    printf("-?          Help, print this usage\n");
+    printf("-t <num>    Maximum number of verify threads (default %d)\n",
+           BENCH_MAX_THREADS);
+    printf("-s <num>    Time <num> (seconds) to run each test (default %d)\n",
+           BENCH_RUNTIME_SEC);
+#ifdef HAVE_ECC
+    printf("-e          ECC certificates only\n");
+#endif
+#ifndef NO_RSA
+    printf("-r          RSA certificates only\n");
+#endif
+}
+
+static int bench_cert_verify(void* args)
+{
+    int argc = ((func_args*)args)->argc;
+    char** argv = ((func_args*)args)->argv;
+    int ch, ret = 0;
+    int argThreads = BENCH_MAX_THREADS;
+    int argRuntimeSec = BENCH_RUNTIME_SEC;
+    int doEcc = 1, doRsa = 1;
+
+    ((func_args*)args)->return_code = -1; /* error state */
+
+    while ((ch = mygetopt(argc, argv, "?t:s:er")) != -1) {
+        switch (ch) {
+            case '?' :
+                Usage();
+                ((func_args*)args)->return_code = 0;
+                return 0;
+
+            case 't' :
+                argThreads = atoi(myoptarg);
+                break;
+
+            case 's' :
+                argRuntimeSec = atoi(myoptarg);
+                break;
+
+            case 'e' :
+                doRsa = 0;
+                break;
+
+            case 'r' :
+                doEcc = 0;
+                break;
+
+            default:
+                Usage();
+                return MY_EX_USAGE;
+        }
+    }
+
+    if (argThreads <= 0 || argThreads > BENCH_THREAD_LIMIT ||
+                                                        argRuntimeSec <= 0) {
+        Usage();
+        return MY_EX_USAGE;
+    }
+#ifndef HAVE_PTHREAD
+    argThreads = 1;
+#endif
+
+    wolfSSL_Init();
+
+#ifdef HAVE_ECC
+    if (ret == 0 && doEcc) {
+        ret = bench_cert("ECC-256", ca_ecc_cert_der_256,
+                         sizeof_ca_ecc_cert_der_256, serv_ecc_der_256,
+                         sizeof_serv_ecc_der_256, argThreads, argRuntimeSec);
+    }
+#endif
+#ifndef NO_RSA
+    if (ret == 0 && doRsa) {
+        ret = bench_cert("RSA-2048", ca_cert_der_2048,
+                         sizeof_ca_cert_der_2048, server_cert_der_2048,
+                         sizeof_server_cert_der_2048, argThreads,
+                         argRuntimeSec);
+    }
+#endif
+    (void)doEcc;
+    (void)doRsa;
+
+    wolfSSL_Cleanup();
+
+    ((func_args*)args)->return_code = ret;
+
+    return ret;
+}
+#endif /* !WOLFCRYPT_ONLY && !NO_CERTS && (HAVE_ECC || !NO_RSA) */
+
+#ifndef NO_MAIN_DRIVER
+
+int main(int argc, char** argv)
+{
+    func_args args;
+
+    args.argc = argc;
+    args.argv = argv;
+    args.return_code = 0;
+
+#if !defined(WOLFCRYPT_ONLY) && !defined(NO_CERTS) && \
+    (defined(HAVE_ECC) || !defined(NO_RSA))
+    bench_cert_verify(&args);
+#endif
+
+    return args.return_code;
+}
+
+#endif /* !NO_MAIN_DRIVER */
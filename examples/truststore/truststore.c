@@ -0,0 +1,280 @@
+/* truststore.c
+ *
+ * Copyright (C) 2006-2020 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+/*
+Compile CA certificates into a precompiled trust store and time loading it.
+
+./examples/truststore/truststore -f /etc/ssl/certs/ca-certificates.crt \
+    -o ca.wts
+./examples/truststore/truststore -l ca.wts -v certs/server-cert.pem
+
+Applications load the result with wolfSSL_CTX_LoadTrustStore().
+*/
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define MAX_CA_FILES    32
+
+#if defined(WOLFSSL_TRUST_STORE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(WOLFCRYPT_ONLY)
+
+/* Global vars for argument parsing */
+int myoptind = 0;
+char* myoptarg = NULL;
+
+static double gettime_secs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
+static WOLFSSL_CTX* NewCtx(void)
+{
+#ifndef NO_WOLFSSL_CLIENT
+    return wolfSSL_CTX_new(wolfSSLv23_client_method());
+#else
+    return wolfSSL_CTX_new(wolfSSLv23_server_method());
+#endif
+}
+
+/* Signer count from a trust store header */
+static unsigned int StoreCount(const unsigned char* store)
+{
+    return ((unsigned int)store[12] << 24) | ((unsigned int)store[13] << 16) |
+           ((unsigned int)store[14] <<  8) |  (unsigned int)store[15];
+}
+
+static int Compile(const char** files, int numFiles, const char* dir,
+                   const char* out, int flags)
+{
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_CERT_MANAGER* cm;
+    unsigned char* store = NULL;
+    double start, loadTime;
+    int i, sz = 0, ret = WOLFSSL_SUCCESS;
+
+    ctx = NewCtx();
+    if (ctx == NULL)
+        return MEMORY_E;
+
+    start = gettime_secs();
+    for (i = 0; i < numFiles && ret == WOLFSSL_SUCCESS; i++) {
+        ret = wolfSSL_CTX_load_verify_locations_ex(ctx, files[i], NULL, flags);
+        if (ret != WOLFSSL_SUCCESS)
+            printf("Failed to load %s: %d\n", files[i], ret);
+    }
+    if (ret == WOLFSSL_SUCCESS && dir != NULL) {
+        ret = wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, dir, flags);
+        if (ret != WOLFSSL_SUCCESS)
+            printf("Failed to load %s: %d\n", dir, ret);
+    }
+    loadTime = gettime_secs() - start;
+
+    cm = wolfSSL_CTX_GetCertManager(ctx);
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = wolfSSL_CertManagerSaveTrustStoreBuffer(cm, NULL, &sz);
+        if (ret == LENGTH_ONLY_E) {
+            store = (unsigned char*)malloc(sz);
+            ret = (store == NULL) ? MEMORY_E :
+                  wolfSSL_CertManagerSaveTrustStoreBuffer(cm, store, &sz);
+        }
+    }
+    if (ret == WOLFSSL_SUCCESS)
+        ret = wolfSSL_CertManagerSaveTrustStore(cm, out);
+
+    if (ret == WOLFSSL_SUCCESS) {
+        printf("Parsed %u CAs in %.3f ms\n", StoreCount(store),
+               loadTime * 1000);
+        printf("Wrote %s, %d bytes\n", out, sz);
+    }
+    else {
+        printf("Failed to write trust store: %d\n", ret);
+    }
+
+    free(store);
+    wolfSSL_CTX_free(ctx);
+
+    return ret;
+}
+
+static int Load(const char* storeFile, const char* verifyFile)
+{
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_CERT_MANAGER* cm;
+    double start, loadTime;
+    int ret;
+
+    ctx = NewCtx();
+    if (ctx == NULL)
+        return MEMORY_E;
+
+    start = gettime_secs();
+    ret = wolfSSL_CTX_LoadTrustStore(ctx, storeFile);
+    loadTime = gettime_secs() - start;
+    if (ret == WOLFSSL_SUCCESS)
+        printf("Loaded %s in %.3f ms\n", storeFile, loadTime * 1000);
+    else
+        printf("Failed to load %s: %d\n", storeFile, ret);
+
+    if (ret == WOLFSSL_SUCCESS && verifyFile != NULL) {
+        cm = wolfSSL_CTX_GetCertManager(ctx);
+        ret = wolfSSL_CertManagerVerify(cm, verifyFile, WOLFSSL_FILETYPE_PEM);
+        printf("Verify %s: %s (%d)\n", verifyFile,
+               ret == WOLFSSL_SUCCESS ? "OK" : "failed", ret);
+    }
+
+    wolfSSL_CTX_free(ctx);
+
+    return ret;
+}
+
+static void Usage(void)
+{
+    printf("truststore "    LIBWOLFSSL_VERSION_STRING "\n");
+    printf("-?          Help, print this usage\n");
+    printf("-f <file>   CA certificate file to add, PEM (up to %d)\n",
+           MAX_CA_FILES);
+    printf("-d <dir>    Directory of CA certificates to add\n");
+    printf("-o <file>   Write the trust store to <file>\n");
+    printf("-i          Skip certificates that fail to load\n");
+    printf("-D          Accept CA certificates outside their validity\n");
+    printf("-l <file>   Load trust store <file> and report the time taken\n");
+    printf("-v <file>   With -l, verify the PEM certificate <file>\n");
+}
+
+static int truststore_tool(void* args)
+{
+    int argc = ((func_args*)args)->argc;
+    char** argv = ((func_args*)args)->argv;
+    const char* files[MAX_CA_FILES];
+    const char* dir = NULL;
+    const char* out = NULL;
+    const char* load = NULL;
+    const char* verify = NULL;
+    int numFiles = 0;
+    int flags = WOLFSSL_LOAD_VERIFY_DEFAULT_FLAGS;
+    int ch, ret = 0;
+
+    ((func_args*)args)->return_code = -1; /* error state */
+
+    while ((ch = mygetopt(argc, argv, "?f:d:o:iDl:v:")) != -1) {
+        switch (ch) {
+            case '?' :
+                Usage();
+                ((func_args*)args)->return_code = 0;
+                return 0;
+
+            case 'f' :
+                if (numFiles == MAX_CA_FILES) {
+                    Usage();
+                    return MY_EX_USAGE;
+                }
+                files[numFiles++] = myoptarg;
+                break;
+
+            case 'd' :
+                dir = myoptarg;
+                break;
+
+            case 'o' :
+                out = myoptarg;
+                break;
+
+            case 'i' :
+                flags |= WOLFSSL_LOAD_FLAG_IGNORE_ERR;
+                break;
+
+            case 'D' :
+                flags |= WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY;
+                break;
+
+            case 'l' :
+                load = myoptarg;
+                break;
+
+            case 'v' :
+                verify = myoptarg;
+                break;
+
+            default:
+                Usage();
+                return MY_EX_USAGE;
+        }
+    }
+
+    if ((out == NULL && load == NULL) ||
+            (out != NULL && numFiles == 0 && dir == NULL)) {
+        Usage();
+        return MY_EX_USAGE;
+    }
+
+    wolfSSL_Init();
+
+    if (out != NULL)
+        ret = Compile(files, numFiles, dir, out, flags);
+    if (ret == WOLFSSL_SUCCESS && load != NULL)
+        ret = Load(load, verify);
+
+    wolfSSL_Cleanup();
+
+    ((func_args*)args)->return_code = (ret == WOLFSSL_SUCCESS) ? 0 : ret;
+
+    return ret;
+}
+#endif /* WOLFSSL_TRUST_STORE && !NO_FILESYSTEM && !NO_CERTS */
+
+#ifndef NO_MAIN_DRIVER
+
+int main(int argc, char** argv)
+{
+    func_args args;
+
+    args.argc = argc;
+    args.argv = argv;
+    args.return_code = 0;
+
+#if defined(WOLFSSL_TRUST_STORE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(WOLFCRYPT_ONLY)
+    truststore_tool(&args);
+#else
+    printf("Trust store support not compiled in\n");
+#endif
+
+    return args.return_code;
+}
+
+#endif /* !NO_MAIN_DRIVER */
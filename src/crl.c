@@ -59,6 +59,9 @@ int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
     crl->crlList = NULL;
     crl->monitors[0].path = NULL;
     crl->monitors[1].path = NULL;
+#if defined(HAVE_CRL_IO) && defined(HAVE_HTTP_CLIENT_NONBLOCK)
+    crl->crlNb = NULL;
+#endif
 #ifdef HAVE_CRL_MONITOR
     crl->tid   =  0;
     crl->mfd   = -1;    /* mfd for bsd is kqueue fd, eventfd for linux */
@@ -181,6 +184,9 @@ void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
         }
     }
     pthread_cond_destroy(&crl->cond);
+#endif
+#if defined(HAVE_CRL_IO) && defined(HAVE_HTTP_CLIENT_NONBLOCK)
+    wolfIO_HttpNbFree(crl->crlNb);
 #endif
     wc_FreeMutex(&crl->crlLock);
     if (dynamic)   /* free self */
@@ -354,7 +360,12 @@ int CheckCertCRL(WOLFSSL_CRL* crl, DecodedCert* cert)
             ret = crl->crlIOCb(crl, (const char*)cert->extCrlInfo,
                                                         cert->extCrlInfoSz);
             if (ret == WOLFSSL_CBIO_ERR_WANT_READ) {
+            #ifdef WOLFSSL_NONBLOCK_OCSP
+                /* handshake resumes the certificate check like for OCSP */
+                ret = OCSP_WANT_READ;
+            #else
                 ret = WANT_READ;
+            #endif
             }
             else if (ret >= 0) {
                 /* try again */
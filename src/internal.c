@@ -1685,6 +1685,10 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
     ctx->heap     = ctx;        /* defaults to self */
     ctx->timeout  = WOLFSSL_SESSION_TIMEOUT;
     ctx->minDowngrade = WOLFSSL_MIN_DOWNGRADE; /* current default: TLSv1_MINOR */
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    ctx->memOwner = wc_MemStatsNewOwner();
+    MEM_STATS_OWNER(ctx);
+#endif
 
     if (wc_InitMutex(&ctx->countMutex) < 0) {
         WOLFSSL_MSG("Mutex error on CTX init");
@@ -1922,6 +1926,10 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
     TLSX_FreeAll(ctx->extensions, ctx->heap);
 
 #ifndef NO_WOLFSSL_SERVER
+#if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE)
+    FreeSniTable(ctx->sniTable, ctx->heap);
+    ctx->sniTable = NULL;
+#endif
 #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
  || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
     if (ctx->certOcspRequest) {
@@ -1983,6 +1991,9 @@ void FreeSSL_Ctx(WOLFSSL_CTX* ctx)
          * CTX was still malloc'd */
         if (ctx->err == CTX_INIT_MUTEX_E) {
             SSL_CtxResourceFree(ctx);
+        #ifdef WOLFSSL_MEM_TYPE_STATS
+            wc_MemStatsFreeOwner(ctx->memOwner);
+        #endif
             XFREE(ctx, ctx->heap, DYNAMIC_TYPE_CTX);
         }
         return;
@@ -1997,6 +2008,9 @@ void FreeSSL_Ctx(WOLFSSL_CTX* ctx)
         TicketEncCbCtx_Free(&ctx->ticketKeyCtx);
 #endif
         wc_FreeMutex(&ctx->countMutex);
+#ifdef WOLFSSL_MEM_TYPE_STATS
+        wc_MemStatsFreeOwner(ctx->memOwner);
+#endif
 #ifdef WOLFSSL_STATIC_MEMORY
         if (ctx->onHeap == 0) {
             heap = NULL;
@@ -3711,6 +3725,7 @@ int RsaSign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     (void)hashAlgo;
 
     WOLFSSL_ENTER("RsaSign");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_SIGN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -3769,6 +3784,7 @@ int RsaSign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
         ret = 0;
     }
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_SIGN);
     WOLFSSL_LEAVE("RsaSign", ret);
 
     return ret;
@@ -3795,6 +3811,7 @@ int RsaVerify(WOLFSSL* ssl, byte* in, word32 inSz, byte** out, int sigAlgo,
     (void)hashAlgo;
 
     WOLFSSL_ENTER("RsaVerify");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_VERIFY);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -3842,6 +3859,7 @@ int RsaVerify(WOLFSSL* ssl, byte* in, word32 inSz, byte** out, int sigAlgo,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_VERIFY);
     WOLFSSL_LEAVE("RsaVerify", ret);
 
     return ret;
@@ -4000,6 +4018,7 @@ int RsaDec(WOLFSSL* ssl, byte* in, word32 inSz, byte** out, word32* outSz,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("RsaDec");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4037,6 +4056,7 @@ int RsaDec(WOLFSSL* ssl, byte* in, word32 inSz, byte** out, word32* outSz,
         ret = 0;
     }
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
     WOLFSSL_LEAVE("RsaDec", ret);
 
     return ret;
@@ -4061,6 +4081,7 @@ int RsaEnc(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out, word32* outSz,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("RsaEnc");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4093,6 +4114,7 @@ int RsaEnc(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out, word32* outSz,
         ret = 0;
     }
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
     WOLFSSL_LEAVE("RsaEnc", ret);
 
     return ret;
@@ -4122,6 +4144,7 @@ int EccSign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("EccSign");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_SIGN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4151,6 +4174,7 @@ int EccSign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_SIGN);
     WOLFSSL_LEAVE("EccSign", ret);
 
     return ret;
@@ -4174,6 +4198,7 @@ int EccVerify(WOLFSSL* ssl, const byte* in, word32 inSz, const byte* out,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("EccVerify");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_VERIFY);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4205,6 +4230,7 @@ int EccVerify(WOLFSSL* ssl, const byte* in, word32 inSz, const byte* out,
         ret = (ret != 0 || ssl->eccVerifyRes == 0) ? VERIFY_SIGN_ERROR : 0;
     }
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_VERIFY);
     WOLFSSL_LEAVE("EccVerify", ret);
 
     return ret;
@@ -4282,6 +4308,7 @@ int EccSharedSecret(WOLFSSL* ssl, ecc_key* priv_key, ecc_key* pub_key,
     (void)side;
 
     WOLFSSL_ENTER("EccSharedSecret");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef HAVE_PK_CALLBACKS
     if (ssl->ctx->EccSharedSecretCb) {
@@ -4326,6 +4353,7 @@ int EccSharedSecret(WOLFSSL* ssl, ecc_key* priv_key, ecc_key* pub_key,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
     WOLFSSL_LEAVE("EccSharedSecret", ret);
 
     return ret;
@@ -4338,6 +4366,7 @@ int EccMakeKey(WOLFSSL* ssl, ecc_key* key, ecc_key* peer)
     int ecc_curve = ECC_CURVE_DEF;
 
     WOLFSSL_ENTER("EccMakeKey");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEYSHARE_GEN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4386,6 +4415,7 @@ int EccMakeKey(WOLFSSL* ssl, ecc_key* key, ecc_key* peer)
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEYSHARE_GEN);
     WOLFSSL_LEAVE("EccMakeKey", ret);
 
     return ret;
@@ -4460,6 +4490,7 @@ int Ed25519Sign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("Ed25519Sign");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_SIGN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4487,6 +4518,7 @@ int Ed25519Sign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_SIGN);
     WOLFSSL_LEAVE("Ed25519Sign", ret);
 
     return ret;
@@ -4522,6 +4554,7 @@ int Ed25519Verify(WOLFSSL* ssl, const byte* in, word32 inSz, const byte* msg,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("Ed25519Verify");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_VERIFY);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4554,6 +4587,7 @@ int Ed25519Verify(WOLFSSL* ssl, const byte* in, word32 inSz, const byte* msg,
         ret = (ret != 0 || ssl->eccVerifyRes == 0) ? VERIFY_SIGN_ERROR : 0;
     }
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_VERIFY);
     WOLFSSL_LEAVE("Ed25519Verify", ret);
 
     return ret;
@@ -4612,6 +4646,7 @@ static int X25519SharedSecret(WOLFSSL* ssl, curve25519_key* priv_key,
     (void)side;
 
     WOLFSSL_ENTER("X25519SharedSecret");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4645,6 +4680,7 @@ static int X25519SharedSecret(WOLFSSL* ssl, curve25519_key* priv_key,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
     WOLFSSL_LEAVE("X25519SharedSecret", ret);
 
     return ret;
@@ -4658,6 +4694,7 @@ static int X25519MakeKey(WOLFSSL* ssl, curve25519_key* key,
     (void)peer;
 
     WOLFSSL_ENTER("X25519MakeKey");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEYSHARE_GEN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4691,6 +4728,7 @@ static int X25519MakeKey(WOLFSSL* ssl, curve25519_key* key,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEYSHARE_GEN);
     WOLFSSL_LEAVE("X25519MakeKey", ret);
 
     return ret;
@@ -4765,6 +4803,7 @@ int Ed448Sign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("Ed448Sign");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_SIGN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4792,6 +4831,7 @@ int Ed448Sign(WOLFSSL* ssl, const byte* in, word32 inSz, byte* out,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_SIGN);
     WOLFSSL_LEAVE("Ed448Sign", ret);
 
     return ret;
@@ -4827,6 +4867,7 @@ int Ed448Verify(WOLFSSL* ssl, const byte* in, word32 inSz, const byte* msg,
     (void)keyBufInfo;
 
     WOLFSSL_ENTER("Ed448Verify");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_VERIFY);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4859,6 +4900,7 @@ int Ed448Verify(WOLFSSL* ssl, const byte* in, word32 inSz, const byte* msg,
         ret = (ret != 0 || ssl->eccVerifyRes == 0) ? VERIFY_SIGN_ERROR : 0;
     }
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_VERIFY);
     WOLFSSL_LEAVE("Ed448Verify", ret);
 
     return ret;
@@ -4915,6 +4957,7 @@ static int X448SharedSecret(WOLFSSL* ssl, curve448_key* priv_key,
     (void)side;
 
     WOLFSSL_ENTER("X448SharedSecret");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4948,6 +4991,7 @@ static int X448SharedSecret(WOLFSSL* ssl, curve448_key* priv_key,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
     WOLFSSL_LEAVE("X448SharedSecret", ret);
 
     return ret;
@@ -4960,6 +5004,7 @@ static int X448MakeKey(WOLFSSL* ssl, curve448_key* key, curve448_key* peer)
     (void)peer;
 
     WOLFSSL_ENTER("X448MakeKey");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEYSHARE_GEN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -4993,6 +5038,7 @@ static int X448MakeKey(WOLFSSL* ssl, curve448_key* key, curve448_key* peer)
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEYSHARE_GEN);
     WOLFSSL_LEAVE("X448MakeKey", ret);
 
     return ret;
@@ -5009,6 +5055,7 @@ int DhGenKeyPair(WOLFSSL* ssl, DhKey* dhKey,
     int ret;
 
     WOLFSSL_ENTER("DhGenKeyPair");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEYSHARE_GEN);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -5026,6 +5073,7 @@ int DhGenKeyPair(WOLFSSL* ssl, DhKey* dhKey,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEYSHARE_GEN);
     WOLFSSL_LEAVE("DhGenKeyPair", ret);
 
     return ret;
@@ -5041,6 +5089,7 @@ int DhAgree(WOLFSSL* ssl, DhKey* dhKey,
     (void)ssl;
 
     WOLFSSL_ENTER("DhAgree");
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     /* initialize event */
@@ -5083,6 +5132,7 @@ int DhAgree(WOLFSSL* ssl, DhKey* dhKey,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
     WOLFSSL_LEAVE("DhAgree", ret);
 
     return ret;
@@ -5546,7 +5596,7 @@ int InitHandshakeHashes(WOLFSSL* ssl)
     }
 
     /* allocate handshake hashes */
-    ssl->hsHashes = (HS_Hashes*)XMALLOC(sizeof(HS_Hashes), ssl->heap,
+    ssl->hsHashes = (HS_Hashes*)HS_XMALLOC(ssl, sizeof(HS_Hashes),
                                                            DYNAMIC_TYPE_HASHES);
     if (ssl->hsHashes == NULL) {
         WOLFSSL_MSG("HS_Hashes Memory error");
@@ -5628,7 +5678,7 @@ void FreeHandshakeHashes(WOLFSSL* ssl)
          }
     #endif
 
-        XFREE(ssl->hsHashes, ssl->heap, DYNAMIC_TYPE_HASHES);
+        HS_XFREE(ssl, ssl->hsHashes, DYNAMIC_TYPE_HASHES);
         ssl->hsHashes = NULL;
     }
 }
@@ -5888,7 +5938,7 @@ int InitSSL(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
 
     if (!writeDup) {
         /* arrays */
-        ssl->arrays = (Arrays*)XMALLOC(sizeof(Arrays), ssl->heap,
+        ssl->arrays = (Arrays*)HS_XMALLOC(ssl, sizeof(Arrays),
                                                            DYNAMIC_TYPE_ARRAYS);
         if (ssl->arrays == NULL) {
             WOLFSSL_MSG("Arrays Memory error");
@@ -6068,7 +6118,7 @@ void FreeArrays(WOLFSSL* ssl, int keep)
         ssl->arrays->pendingMsg = NULL;
         ForceZero(ssl->arrays, sizeof(Arrays)); /* clear arrays struct */
     }
-    XFREE(ssl->arrays, ssl->heap, DYNAMIC_TYPE_ARRAYS);
+    HS_XFREE(ssl, ssl->arrays, DYNAMIC_TYPE_ARRAYS);
     ssl->arrays = NULL;
 }
 
@@ -6114,7 +6164,7 @@ void FreeKey(WOLFSSL* ssl, int type, void** pKey)
             default:
                 break;
         }
-        XFREE(*pKey, ssl->heap, type);
+        HS_XFREE(ssl, *pKey, type);
 
         /* Reset pointer */
         *pKey = NULL;
@@ -6182,7 +6232,7 @@ int AllocKey(WOLFSSL* ssl, int type, void** pKey)
     }
 
     /* Allocate memory for key */
-    *pKey = (void *)XMALLOC(sz, ssl->heap, type);
+    *pKey = (void *)HS_XMALLOC(ssl, sz, type);
     if (*pKey == NULL) {
         return MEMORY_E;
     }
@@ -6397,6 +6447,10 @@ void SSL_ResourceFree(WOLFSSL* ssl)
     ssl->keepCert = 0; /* make sure certificate is free'd */
     wolfSSL_UnloadCertsKeys(ssl);
 #endif
+#if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE) && \
+                                                !defined(NO_WOLFSSL_SERVER)
+    SNI_ReleaseCert(ssl, 0);
+#endif
 #ifndef NO_RSA
     FreeKey(ssl, DYNAMIC_TYPE_RSA, (void**)&ssl->peerRsaKey);
     ssl->peerRsaKeyPresent = 0;
@@ -6616,6 +6670,9 @@ void SSL_ResourceFree(WOLFSSL* ssl)
     wolfSSL_sk_CIPHER_free(ssl->supportedCiphers);
     wolfSSL_sk_X509_free(ssl->peerCertChain);
 #endif
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+    HsArenaRelease(ssl, 1);
+#endif
 }
 
 /* Free any handshake resources no longer needed */
@@ -6838,6 +6895,10 @@ void FreeHandshakeResources(WOLFSSL* ssl)
     #endif
     }
 #endif /* WOLFSSL_STATIC_MEMORY */
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+    /* chunk goes back to the heap unless arrays or keys are kept */
+    HsArenaRelease(ssl, 0);
+#endif
 }
 
 
@@ -7834,6 +7895,290 @@ ProtocolVersion MakeDTLSv1_2(void)
     }
 #endif
 #endif /* !NO_ASN_TIME */
+
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+#if defined(WOLFSSL_HS_TIMING_NOW)
+    /* user supplied monotonic clock in nanoseconds */
+    #define HsTimingNow() ((word64)WOLFSSL_HS_TIMING_NOW())
+#elif defined(USE_WINDOWS_API)
+    static word64 HsTimingNow(void)
+    {
+        static LARGE_INTEGER freq;
+        LARGE_INTEGER        count;
+
+        if (freq.QuadPart == 0)
+            QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+
+        return (word64)(count.QuadPart / freq.QuadPart) * 1000000000 +
+               (word64)(count.QuadPart % freq.QuadPart) * 1000000000 /
+               (word64)freq.QuadPart;
+    }
+#else
+    #include <time.h>
+
+    static word64 HsTimingNow(void)
+    {
+        struct timespec ts;
+
+        if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+            return 0;
+
+        return (word64)ts.tv_sec * 1000000000 + (word64)ts.tv_nsec;
+    }
+#endif
+
+/* Histogram bucket for ns: 0 is under a microsecond, then bucket i holds
+ * 2^(i-1) up to 2^i microseconds with the last taking the rest. */
+static int HsTimingBucket(word64 ns)
+{
+    word64 us = ns / 1000;
+    int    bucket = 0;
+
+    while (us > 0 && bucket < WOLFSSL_HST_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/* Start timing a handshake, called on each connect and accept */
+void HsTimingStart(WOLFSSL* ssl)
+{
+    if (ssl->hsTiming.started || ssl->options.handShakeDone)
+        return;
+
+    XMEMSET(&ssl->hsTiming, 0, sizeof(ssl->hsTiming));
+    ssl->hsTiming.start = HsTimingNow();
+    ssl->hsTiming.started = 1;
+}
+
+/* Handshake finished, set its total and add it to the CTX histograms */
+void HsTimingDone(WOLFSSL* ssl)
+{
+    HsTiming* t = &ssl->hsTiming;
+    int       op;
+
+    if (!t->started)
+        return;
+    t->started = 0;
+    t->rec.opNs[WOLFSSL_HST_TOTAL] = HsTimingNow() - t->start;
+    t->rec.opCount[WOLFSSL_HST_TOTAL] = 1;
+
+    if (ssl->ctx != NULL && wc_LockMutex(&ssl->ctx->countMutex) == 0) {
+        for (op = 0; op < WOLFSSL_HST_OP_COUNT; op++) {
+            if (t->rec.opCount[op] > 0)
+                ssl->ctx->hsHist[op][HsTimingBucket(t->rec.opNs[op])]++;
+        }
+        wc_UnLockMutex(&ssl->ctx->countMutex);
+    }
+}
+
+void HsTimingBegin(WOLFSSL* ssl, int op)
+{
+    if (ssl != NULL && ssl->hsTiming.started)
+        ssl->hsTiming.opStart[op] = HsTimingNow();
+}
+
+void HsTimingEnd(WOLFSSL* ssl, int op)
+{
+    HsTiming* t;
+
+    if (ssl == NULL || !ssl->hsTiming.started)
+        return;
+    t = &ssl->hsTiming;
+    if (t->opStart[op] != 0) {
+        t->rec.opNs[op] += HsTimingNow() - t->opStart[op];
+        t->rec.opCount[op]++;
+        t->opStart[op] = 0;
+    }
+}
+
+/* Handshake message of type processed, ret is how that went */
+void HsTimingMsg(WOLFSSL* ssl, byte type, int ret)
+{
+    if (ret == 0 && ssl->hsTiming.started && type < WOLFSSL_HST_MSG_COUNT)
+        ssl->hsTiming.rec.msgNs[type] = HsTimingNow() - ssl->hsTiming.start;
+}
+#endif /* WOLFSSL_HANDSHAKE_TIMING */
+
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+#define HS_ARENA_ALIGN 16
+
+/* Allocate sz bytes from the handshake arena, from the heap when it does not
+ * fit or before the handshake has started. Free with HsArenaFree(). */
+void* HsArenaAlloc(WOLFSSL* ssl, word32 sz, int type)
+{
+    HsArena* a = &ssl->hsArena;
+    void*    ptr;
+
+    if (a->buf == NULL && !a->started)
+        return XMALLOC(sz, ssl->heap, type);
+    /* too big for any chunk, also keeps the round up from wrapping */
+    if (sz > WOLFSSL_HS_ARENA_SZ) {
+        a->fallbacks++;
+        return XMALLOC(sz, ssl->heap, type);
+    }
+
+    sz = (sz + HS_ARENA_ALIGN - 1) & ~(word32)(HS_ARENA_ALIGN - 1);
+
+    if (a->buf == NULL) {
+        a->buf = (byte*)XMALLOC(WOLFSSL_HS_ARENA_SZ, ssl->heap,
+                                                         DYNAMIC_TYPE_HS_ARENA);
+        a->used = 0;
+        a->live = 0;
+    }
+    if (a->buf == NULL || sz > WOLFSSL_HS_ARENA_SZ - a->used) {
+        a->fallbacks++;
+        return XMALLOC(sz, ssl->heap, type);
+    }
+
+    ptr = a->buf + a->used;
+    a->used += sz;
+    a->live++;
+    if (a->used > a->peak)
+        a->peak = a->used;
+
+    return ptr;
+}
+
+/* Free ptr from HsArenaAlloc(). The chunk is reused when its last allocation
+ * is freed, or released if the handshake is already done. */
+void HsArenaFree(WOLFSSL* ssl, void* ptr, int type)
+{
+    HsArena* a = &ssl->hsArena;
+
+    if (ptr == NULL)
+        return;
+    if (a->buf == NULL || (byte*)ptr < a->buf ||
+                                    (byte*)ptr >= a->buf + WOLFSSL_HS_ARENA_SZ) {
+        XFREE(ptr, ssl->heap, type);
+        return;
+    }
+
+    if (--a->live == 0) {
+        if (ssl->options.handShakeDone)
+            HsArenaRelease(ssl, 0);
+        else
+            a->used = 0;
+    }
+    (void)type;
+}
+
+/* Move *ptr, allocated on the heap before the handshake started, into the
+ * chunk */
+static void HsArenaMove(WOLFSSL* ssl, void** ptr, word32 sz, int type)
+{
+    void* moved;
+
+    if (*ptr == NULL)
+        return;
+
+    moved = HsArenaAlloc(ssl, sz, type);
+    if (moved != NULL) {
+        XMEMCPY(moved, *ptr, sz);
+        XFREE(*ptr, ssl->heap, type);
+        *ptr = moved;
+    }
+}
+
+/* Handshake starting, called on each connect and accept. From now on the
+ * chunk is used, the arrays and hashes wolfSSL_new put on the heap are moved
+ * into it as nothing has been hashed yet. */
+void HsArenaStart(WOLFSSL* ssl)
+{
+    if (ssl->hsArena.started || ssl->options.handShakeDone)
+        return;
+
+    ssl->hsArena.started = 1;
+    HsArenaMove(ssl, (void**)&ssl->arrays, sizeof(Arrays),
+                                                           DYNAMIC_TYPE_ARRAYS);
+    HsArenaMove(ssl, (void**)&ssl->hsHashes, sizeof(HS_Hashes),
+                                                           DYNAMIC_TYPE_HASHES);
+}
+
+/* Give the chunk back to the heap when empty, or always when force is set
+ * as the WOLFSSL is going away. The next handshake makes a new one. */
+void HsArenaRelease(WOLFSSL* ssl, int force)
+{
+    HsArena* a = &ssl->hsArena;
+
+    if (a->buf != NULL && (force || a->live == 0)) {
+        XFREE(a->buf, ssl->heap, DYNAMIC_TYPE_HS_ARENA);
+        a->buf = NULL;
+        a->used = 0;
+        a->live = 0;
+        a->started = 0;
+    }
+}
+#endif /* WOLFSSL_HANDSHAKE_ARENA */
+
+#ifdef WOLFSSL_PERF_COUNTERS
+#if defined(SINGLE_THREADED)
+    #define PERF_ATOMIC_ADD(p, n)  (*(p) += (n))
+    #define PERF_ATOMIC_LOAD(p)    (*(p))
+    #define PERF_ATOMIC_CLEAR(p)   (*(p) = 0)
+#elif defined(__GNUC__)
+    #define PERF_ATOMIC_ADD(p, n)  \
+                        ((void)__atomic_fetch_add((p), (n), __ATOMIC_RELAXED))
+    #define PERF_ATOMIC_LOAD(p)    __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define PERF_ATOMIC_CLEAR(p)   __atomic_store_n((p), 0, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+    #define PERF_ATOMIC_ADD(p, n)  \
+        ((void)InterlockedExchangeAdd64((volatile LONG64*)(p), (LONG64)(n)))
+    #define PERF_ATOMIC_LOAD(p)    \
+        ((word64)InterlockedCompareExchange64((volatile LONG64*)(p), 0, 0))
+    #define PERF_ATOMIC_CLEAR(p)   \
+        ((void)InterlockedExchange64((volatile LONG64*)(p), 0))
+#else
+    #error WOLFSSL_PERF_COUNTERS needs atomic operations or SINGLE_THREADED
+#endif
+
+static word64 perfGlobal[PERF_COUNTER_COUNT];
+
+/* Add n to counter of ctx and of the library */
+void PerfAdd(WOLFSSL_CTX* ctx, int counter, word64 n)
+{
+    PERF_ATOMIC_ADD(&perfGlobal[counter], n);
+    if (ctx != NULL)
+        PERF_ATOMIC_ADD(&ctx->perf[counter], n);
+}
+
+/* Counters of ctx, or of the library when NULL. Each is read on its own so
+ * they may be from slightly different moments. */
+void PerfGet(WOLFSSL_CTX* ctx, WOLFSSL_PERF_STATS* stats)
+{
+    word64* c = (ctx != NULL) ? ctx->perf : perfGlobal;
+
+    stats->fullHandshakes     = PERF_ATOMIC_LOAD(&c[PERF_FULL_HANDSHAKE]);
+    stats->resumedHandshakes  = PERF_ATOMIC_LOAD(&c[PERF_RESUMED_HANDSHAKE]);
+    stats->sessionCacheHits   = PERF_ATOMIC_LOAD(&c[PERF_SESSION_HIT]);
+    stats->sessionCacheMisses = PERF_ATOMIC_LOAD(&c[PERF_SESSION_MISS]);
+    stats->sessionCacheAdds   = PERF_ATOMIC_LOAD(&c[PERF_SESSION_ADD]);
+    stats->bytesEncrypted     = PERF_ATOMIC_LOAD(&c[PERF_BYTES_ENCRYPTED]);
+    stats->bytesDecrypted     = PERF_ATOMIC_LOAD(&c[PERF_BYTES_DECRYPTED]);
+    stats->recordsEncrypted   = PERF_ATOMIC_LOAD(&c[PERF_RECORDS_ENCRYPTED]);
+    stats->recordsDecrypted   = PERF_ATOMIC_LOAD(&c[PERF_RECORDS_DECRYPTED]);
+    stats->alertsSent         = PERF_ATOMIC_LOAD(&c[PERF_ALERTS_SENT]);
+    stats->alertsReceived     = PERF_ATOMIC_LOAD(&c[PERF_ALERTS_RECEIVED]);
+    stats->bufferGrows        = PERF_ATOMIC_LOAD(&c[PERF_BUFFER_GROWS]);
+    stats->bufferShrinks      = PERF_ATOMIC_LOAD(&c[PERF_BUFFER_SHRINKS]);
+    stats->ocspLookups        = PERF_ATOMIC_LOAD(&c[PERF_OCSP_LOOKUPS]);
+    stats->crlLookups         = PERF_ATOMIC_LOAD(&c[PERF_CRL_LOOKUPS]);
+}
+
+/* Clear counters of ctx, or of the library when NULL */
+void PerfReset(WOLFSSL_CTX* ctx)
+{
+    word64* c = (ctx != NULL) ? ctx->perf : perfGlobal;
+    int     i;
+
+    for (i = 0; i < PERF_COUNTER_COUNT; i++)
+        PERF_ATOMIC_CLEAR(&c[i]);
+}
+#endif /* WOLFSSL_PERF_COUNTERS */
+
 #if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
                ((defined(HAVE_ED25519) && !defined(NO_ED25519_CLIENT_AUTH)) || \
                 (defined(HAVE_ED448) && !defined(NO_ED448_CLIENT_AUTH)))
@@ -8210,6 +8555,11 @@ void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree)
     ssl->buffers.inputBuffer.offset      = 0;
     ssl->buffers.inputBuffer.idx = 0;
     ssl->buffers.inputBuffer.length = usedLength;
+#ifdef WOLFSSL_PERF_COUNTERS
+    /* the CTX may already be freed when cleaning up */
+    if (!forcedFree)
+        PERF_INC(ssl, PERF_BUFFER_SHRINKS);
+#endif
 }
 
 int SendBuffered(WOLFSSL* ssl)
@@ -8285,8 +8635,10 @@ int SendBuffered(WOLFSSL* ssl)
 
     ssl->buffers.outputBuffer.idx = 0;
 
-    if (ssl->buffers.outputBuffer.dynamicFlag)
+    if (ssl->buffers.outputBuffer.dynamicFlag) {
         ShrinkOutputBuffer(ssl);
+        PERF_INC(ssl, PERF_BUFFER_SHRINKS);
+    }
 
     return 0;
 }
@@ -8346,6 +8698,9 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
               ssl->buffers.outputBuffer.offset, ssl->heap,
               DYNAMIC_TYPE_OUT_BUFFER);
     ssl->buffers.outputBuffer.dynamicFlag = 1;
+    PERF_INC(ssl, PERF_BUFFER_GROWS);
+    WC_USDT_PROBE3(output__buffer__grow, ssl, size,
+                   ssl->buffers.outputBuffer.length);
 
 #if WOLFSSL_GENERAL_ALIGNMENT > 0
     if (align)
@@ -8420,6 +8775,8 @@ int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
               ssl->heap,DYNAMIC_TYPE_IN_BUFFER);
 
     ssl->buffers.inputBuffer.dynamicFlag = 1;
+    PERF_INC(ssl, PERF_BUFFER_GROWS);
+    WC_USDT_PROBE3(input__buffer__grow, ssl, size, usedLength);
 #if defined(WOLFSSL_DTLS) || WOLFSSL_GENERAL_ALIGNMENT > 0
     if (align)
         ssl->buffers.inputBuffer.offset = align - hdrSz;
@@ -10520,7 +10877,7 @@ static void FreeProcPeerCertArgs(WOLFSSL* ssl, void* pArgs)
             FreeDecodedCert(args->dCert);
             args->dCertInit = 0;
         }
-        XFREE(args->dCert, ssl->heap, DYNAMIC_TYPE_DCERT);
+        HS_XFREE(ssl, args->dCert, DYNAMIC_TYPE_DCERT);
         args->dCert = NULL;
     }
 }
@@ -10571,7 +10928,7 @@ static int ProcessPeerCertParse(WOLFSSL* ssl, ProcPeerCertArgs* args,
                 FreeDecodedCert(args->dCert);
                 args->dCertInit = 0;
             }
-            XFREE(args->dCert, ssl->heap, DYNAMIC_TYPE_DCERT);
+            HS_XFREE(ssl, args->dCert, DYNAMIC_TYPE_DCERT);
             args->dCert = NULL;
         }
 
@@ -10593,9 +10950,8 @@ static int ProcessPeerCertParse(WOLFSSL* ssl, ProcPeerCertArgs* args,
     ) {
     #ifdef WOLFSSL_SMALL_CERT_VERIFY
         if (args->dCert == NULL) {
-            args->dCert = (DecodedCert*)XMALLOC(
-                                 sizeof(DecodedCert), ssl->heap,
-                                 DYNAMIC_TYPE_DCERT);
+            args->dCert = (DecodedCert*)HS_XMALLOC(ssl,
+                                 sizeof(DecodedCert), DYNAMIC_TYPE_DCERT);
             if (args->dCert == NULL) {
                 return MEMORY_E;
             }
@@ -10968,7 +11324,7 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
 
             args->dCertInit = 0;
         #ifndef WOLFSSL_SMALL_CERT_VERIFY
-            args->dCert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), ssl->heap,
+            args->dCert = (DecodedCert*)HS_XMALLOC(ssl, sizeof(DecodedCert),
                                                        DYNAMIC_TYPE_DCERT);
             if (args->dCert == NULL) {
                 ERROR_OUT(MEMORY_E, exit_ppc);
@@ -11097,8 +11453,13 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                         if (ssl->ctx->cm->ocspEnabled &&
                                             ssl->ctx->cm->ocspCheckAll) {
                             WOLFSSL_MSG("Doing Non Leaf OCSP check");
+                            HS_TIMING_BEGIN(ssl, WOLFSSL_HST_OCSP);
                             ret = CheckCertOCSP_ex(ssl->ctx->cm->ocsp,
                                                     args->dCert, NULL, ssl);
+                            HS_TIMING_END(ssl, WOLFSSL_HST_OCSP);
+                            /* once done, not on each WANT_READ re-entry */
+                            PERF_ADD(ssl, PERF_OCSP_LOOKUPS,
+                                     ret != OCSP_WANT_READ);
                         #ifdef WOLFSSL_NONBLOCK_OCSP
                             if (ret == OCSP_WANT_READ) {
                                 args->lastErr = ret;
@@ -11119,6 +11480,8 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                                                 ssl->ctx->cm->crlCheckAll) {
                             WOLFSSL_MSG("Doing Non Leaf CRL check");
                             ret = CheckCertCRL(ssl->ctx->cm->crl, args->dCert);
+                            PERF_ADD(ssl, PERF_CRL_LOOKUPS,
+                                     ret != OCSP_WANT_READ);
                         #ifdef WOLFSSL_NONBLOCK_OCSP
                             if (ret == OCSP_WANT_READ) {
                                 args->lastErr = ret;
@@ -11409,8 +11772,12 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                 #ifdef HAVE_OCSP
                     if (doLookup && ssl->ctx->cm->ocspEnabled) {
                         WOLFSSL_MSG("Doing Leaf OCSP check");
+                        HS_TIMING_BEGIN(ssl, WOLFSSL_HST_OCSP);
                         ret = CheckCertOCSP_ex(ssl->ctx->cm->ocsp,
                                                     args->dCert, NULL, ssl);
+                        HS_TIMING_END(ssl, WOLFSSL_HST_OCSP);
+                        PERF_ADD(ssl, PERF_OCSP_LOOKUPS,
+                                 ret != OCSP_WANT_READ);
                     #ifdef WOLFSSL_NONBLOCK_OCSP
                         if (ret == OCSP_WANT_READ) {
                             goto exit_ppc;
@@ -11431,6 +11798,8 @@ int ProcessPeerCerts(WOLFSSL* ssl, byte* input, word32* inOutIdx,
                     if (doLookup && ssl->ctx->cm->crlEnabled) {
                         WOLFSSL_MSG("Doing Leaf CRL check");
                         ret = CheckCertCRL(ssl->ctx->cm->crl, args->dCert);
+                        PERF_ADD(ssl, PERF_CRL_LOOKUPS,
+                                 ret != OCSP_WANT_READ);
                     #ifdef WOLFSSL_NONBLOCK_OCSP
                         if (ret == OCSP_WANT_READ) {
                             goto exit_ppc;
@@ -11984,7 +12353,9 @@ static int DoCertificate(WOLFSSL* ssl, byte* input, word32* inOutIdx,
     #endif
 #endif /* SESSION_CERTS */
 
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_CERT_VERIFY);
     ret = ProcessPeerCerts(ssl, input, inOutIdx, size);
+    HS_TIMING_END(ssl, WOLFSSL_HST_CERT_VERIFY);
 #ifdef WOLFSSL_EXTRA_ALERTS
     if (ret == BUFFER_ERROR || ret == ASN_PARSE_E)
         SendAlert(ssl, alert_fatal, decode_error);
@@ -12312,6 +12683,8 @@ int DoFinished(WOLFSSL* ssl, const byte* input, word32* inOutIdx, word32 size,
             }
 #endif
             ssl->options.handShakeState = HANDSHAKE_DONE;
+            PERF_HANDSHAKE_DONE(ssl);
+            WC_USDT_PROBE2(handshake__done, ssl, (int)ssl->options.resuming);
             ssl->options.handShakeDone  = 1;
         }
     }
@@ -12328,6 +12701,8 @@ int DoFinished(WOLFSSL* ssl, const byte* input, word32* inOutIdx, word32 size,
             }
 #endif
             ssl->options.handShakeState = HANDSHAKE_DONE;
+            PERF_HANDSHAKE_DONE(ssl);
+            WC_USDT_PROBE2(handshake__done, ssl, (int)ssl->options.resuming);
             ssl->options.handShakeDone  = 1;
         }
     }
@@ -12904,7 +13279,9 @@ static int DoHandShakeMsgType(WOLFSSL* ssl, byte* input, word32* inOutIdx,
 
     case certificate_status:
         WOLFSSL_MSG("processing certificate status");
+        HS_TIMING_BEGIN(ssl, WOLFSSL_HST_OCSP);
         ret = DoCertificateStatus(ssl, input, inOutIdx, size);
+        HS_TIMING_END(ssl, WOLFSSL_HST_OCSP);
         break;
 #endif
 
@@ -13050,6 +13427,8 @@ static int DoHandShakeMsgType(WOLFSSL* ssl, byte* input, word32* inOutIdx,
     }
 #endif /* WOLFSSL_ASYNC_CRYPT || WOLFSSL_NONBLOCK_OCSP */
 
+    HS_TIMING_MSG(ssl, type, ret);
+    WC_USDT_PROBE3(handshake__msg, ssl, type, ret);
     WOLFSSL_LEAVE("DoHandShakeMsgType()", ret);
     return ret;
 }
@@ -13831,15 +14210,14 @@ static int  ChachaAEADEncrypt(WOLFSSL* ssl, byte* out, const byte* input,
     }
     ForceZero(nonce, CHACHA20_NONCE_SZ); /* done with nonce, clear it */
 
-    /* encrypt the plain text */
-    if ((ret = wc_Chacha_Process(ssl->encrypt.chacha, out,
-                                                         input, msgLen)) != 0) {
-        ForceZero(poly, sizeof(poly));
-        return ret;
-    }
-
-    /* get the poly1305 tag using either old padding scheme or more recent */
+    /* encrypt the plain text and get the poly1305 tag using either old
+     * padding scheme or more recent */
     if (ssl->options.oldPoly != 0) {
+        if ((ret = wc_Chacha_Process(ssl->encrypt.chacha, out,
+                                                         input, msgLen)) != 0) {
+            ForceZero(poly, sizeof(poly));
+            return ret;
+        }
         if ((ret = Poly1305TagOld(ssl, add, (const byte* )out,
                                                          poly, sz, tag)) != 0) {
             ForceZero(poly, sizeof(poly));
@@ -13852,8 +14230,10 @@ static int  ChachaAEADEncrypt(WOLFSSL* ssl, byte* out, const byte* input,
             ForceZero(poly, sizeof(poly));
             return ret;
         }
-        if ((ret = wc_Poly1305_MAC(ssl->auth.poly1305, add,
-                            sizeof(add), out, msgLen, tag, sizeof(tag))) != 0) {
+        /* one pass over the record: encrypt and MAC */
+        if ((ret = wc_ChaCha20Poly1305_Process(ssl->encrypt.chacha,
+                        ssl->auth.poly1305, add, sizeof(add), input, out,
+                        msgLen, 1, tag)) != 0) {
             ForceZero(poly, sizeof(poly));
             return ret;
         }
@@ -13998,8 +14378,10 @@ static int ChachaAEADDecrypt(WOLFSSL* ssl, byte* plain, const byte* input,
             ForceZero(poly, sizeof(poly));
             return ret;
         }
-        if ((ret = wc_Poly1305_MAC(ssl->auth.poly1305, add,
-                   sizeof(add), (byte*)input, msgLen, tag, sizeof(tag))) != 0) {
+        /* one pass over the record: MAC and decrypt */
+        if ((ret = wc_ChaCha20Poly1305_Process(ssl->decrypt.chacha,
+                        ssl->auth.poly1305, add, sizeof(add), input, plain,
+                        msgLen, 0, tag)) != 0) {
             ForceZero(poly, sizeof(poly));
             return ret;
         }
@@ -14009,15 +14391,20 @@ static int ChachaAEADDecrypt(WOLFSSL* ssl, byte* plain, const byte* input,
     /* check tag sent along with packet */
     if (ConstantCompare(input + msgLen, tag, ssl->specs.aead_mac_size) != 0) {
         WOLFSSL_MSG("MAC did not match");
+        /* don't leave unauthenticated plaintext behind */
+        if (ssl->options.oldPoly == 0)
+            ForceZero(plain, msgLen);
         if (!ssl->options.dtls)
             SendAlert(ssl, alert_fatal, bad_record_mac);
         return VERIFY_MAC_ERROR;
     }
 
     /* if the tag was good decrypt message */
-    if ((ret = wc_Chacha_Process(ssl->decrypt.chacha, plain,
+    if (ssl->options.oldPoly != 0) {
+        if ((ret = wc_Chacha_Process(ssl->decrypt.chacha, plain,
                                                            input, msgLen)) != 0)
-        return ret;
+            return ret;
+    }
 
     #ifdef CHACHA_AEAD_TEST
        printf("plain after decrypt :\n");
@@ -15007,6 +15394,7 @@ static int DoAlert(WOLFSSL* ssl, byte* input, word32* inOutIdx, int* type,
     ssl->alert_history.last_rx.code = code;
     ssl->alert_history.last_rx.level = level;
     *type = code;
+    PERF_INC(ssl, PERF_ALERTS_RECEIVED);
     if (level == alert_fatal) {
         ssl->options.isClosed = 1;  /* Don't send close_notify */
     }
@@ -15517,6 +15905,8 @@ int ProcessReply(WOLFSSL* ssl)
                     return ret;
                 }
 
+                WC_USDT_PROBE3(record__decrypt__start, ssl, ssl->curRL.type,
+                               ssl->curSize);
                 if (atomicUser) {
         #ifdef ATOMIC_USER
             #if defined(HAVE_ENCRYPT_THEN_MAC) && !defined(WOLFSSL_AEAD_ONLY)
@@ -15581,6 +15971,7 @@ int ProcessReply(WOLFSSL* ssl)
                 #endif /* WOLFSSL_TLS13 */
                     }
                 }
+                WC_USDT_PROBE2(record__decrypt__done, ssl, ret);
 
             #ifdef WOLFSSL_ASYNC_CRYPT
                 if (ret == WC_PENDING_E)
@@ -15588,6 +15979,7 @@ int ProcessReply(WOLFSSL* ssl)
             #endif
 
                 if (ret >= 0) {
+                    PERF_INC(ssl, PERF_RECORDS_DECRYPTED);
             #ifndef WOLFSSL_NO_TLS12
                     /* handle success */
                 #ifndef WOLFSSL_AEAD_ONLY
@@ -16827,6 +17219,7 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                         ssl->keys.dtls_prev_sequence_number_lo;
             }
     #endif
+            WC_USDT_PROBE3(record__encrypt__start, ssl, type, args->size);
     #if defined(HAVE_ENCRYPT_THEN_MAC) && !defined(WOLFSSL_AEAD_ONLY)
             if (ssl->options.startedETMWrite) {
                 ret = Encrypt(ssl, output + args->headerSz,
@@ -16847,8 +17240,10 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                 ssl->keys.dtls_sequence_number_lo = dtls_sequence_number_lo;
             }
     #endif
+            WC_USDT_PROBE2(record__encrypt__done, ssl, ret);
             if (ret != 0)
                 goto exit_buildmsg;
+            PERF_INC(ssl, PERF_RECORDS_ENCRYPTED);
             ssl->options.buildMsgState = BUILD_MSG_ENCRYPTED_VERIFY_MAC;
         }
         FALL_THROUGH;
@@ -17016,6 +17411,8 @@ int SendFinished(WOLFSSL* ssl)
                 ssl->CBIS(ssl, SSL_CB_HANDSHAKE_DONE, SSL_SUCCESS);
         #endif
             ssl->options.handShakeState = HANDSHAKE_DONE;
+            PERF_HANDSHAKE_DONE(ssl);
+            WC_USDT_PROBE2(handshake__done, ssl, (int)ssl->options.resuming);
             ssl->options.handShakeDone  = 1;
         }
     }
@@ -17028,6 +17425,8 @@ int SendFinished(WOLFSSL* ssl)
                 ssl->CBIS(ssl, SSL_CB_HANDSHAKE_DONE, SSL_SUCCESS);
         #endif
             ssl->options.handShakeState = HANDSHAKE_DONE;
+            PERF_HANDSHAKE_DONE(ssl);
+            WC_USDT_PROBE2(handshake__done, ssl, (int)ssl->options.resuming);
             ssl->options.handShakeDone  = 1;
         }
     }
@@ -17088,7 +17487,11 @@ static int CreateOcspRequest(WOLFSSL* ssl, OcspRequest* request,
         ret = InitOcspRequest(request, cert, 0, ssl->heap);
     if (ret == 0) {
         /* make sure ctx OCSP request is updated */
-        if (!ssl->buffers.weOwnCert) {
+        if (!ssl->buffers.weOwnCert
+        #if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE)
+                && ssl->sniCert == NULL
+        #endif
+            ) {
             wolfSSL_Mutex* ocspLock = &ssl->ctx->cm->ocsp_stapling->ocspLock;
             if (wc_LockMutex(ocspLock) == 0) {
                 if (ssl->ctx->certOcspRequest == NULL)
@@ -17132,7 +17535,11 @@ int CreateOcspResponse(WOLFSSL* ssl, OcspRequest** ocspRequest,
     if (ssl->ctx->cm == NULL || ssl->ctx->cm->ocspStaplingEnabled == 0)
         return 0;
 
-    if (request == NULL || ssl->buffers.weOwnCert) {
+    if (request == NULL || ssl->buffers.weOwnCert
+    #if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE)
+                        || ssl->sniCert != NULL
+    #endif
+        ) {
         DerBuffer* der = ssl->buffers.certificate;
         #ifdef WOLFSSL_SMALL_STACK
             DecodedCert* cert = NULL;
@@ -17850,7 +18257,11 @@ int SendCertificateStatus(WOLFSSL* ssl)
             }
 
             if (ret == 0 && (!ssl->ctx->chainOcspRequest[0]
-                                              || ssl->buffers.weOwnCertChain)) {
+                                              || ssl->buffers.weOwnCertChain
+                        #if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE)
+                                              || ssl->sniCert != NULL
+                        #endif
+                                              )) {
                 buffer der;
                 word32 idx = 0;
             #ifdef WOLFSSL_SMALL_STACK
@@ -18185,6 +18596,7 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         }
 
         ssl->buffers.outputBuffer.length += sendSz;
+        PERF_ADD(ssl, PERF_BYTES_ENCRYPTED, buffSz);
 
         if ( (ssl->error = SendBuffered(ssl)) < 0) {
             WOLFSSL_ERROR(ssl->error);
@@ -18350,6 +18762,7 @@ startScr:
     if (peek == 0) {
         ssl->buffers.clearOutputBuffer.length -= size;
         ssl->buffers.clearOutputBuffer.buffer += size;
+        PERF_ADD(ssl, PERF_BYTES_DECRYPTED, size);
     }
 
     if (ssl->buffers.clearOutputBuffer.length == 0 &&
@@ -18469,6 +18882,7 @@ int SendAlert(WOLFSSL* ssl, int severity, int type)
 
     ssl->buffers.outputBuffer.length += sendSz;
     ssl->options.sendAlertState = 1;
+    PERF_INC(ssl, PERF_ALERTS_SENT);
 
     ret = SendBuffered(ssl);
 
@@ -27599,6 +28013,8 @@ static int DoSessionTicket(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
                     session = &ssl->session;
                 }
             #endif
+            PERF_INC(ssl, session != NULL ? PERF_SESSION_HIT :
+                                            PERF_SESSION_MISS);
 
             if (!session) {
                 WOLFSSL_MSG("Session lookup for resume failed");
@@ -27658,6 +28074,7 @@ static int DoSessionTicket(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
                 return BUFFER_ERROR;
             }
         #endif
+        PERF_INC(ssl, session != NULL ? PERF_SESSION_HIT : PERF_SESSION_MISS);
 
         if (!session) {
             WOLFSSL_MSG("Session lookup for resume failed");
@@ -29120,7 +29537,9 @@ static int DoSessionTicket(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
         WOLFSSL_ENTER("SendTicket");
 
         if (ssl->options.createTicket) {
+            HS_TIMING_BEGIN(ssl, WOLFSSL_HST_TICKET_ENC);
             ret = CreateTicket(ssl);
+            HS_TIMING_END(ssl, WOLFSSL_HST_TICKET_ENC);
             if (ret != 0) return ret;
         }
 
@@ -42,6 +42,15 @@
     #include <wolfcrypt/src/misc.c>
 #endif
 
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+    #if !defined(__MACH__) && !defined(__FreeBSD__) && !defined(__linux__)
+        #error "OCSP stapling refresh only currently supported on linux or mach"
+    #endif
+    #if defined(SINGLE_THREADED) || defined(NO_ASN_TIME)
+        #error "OCSP stapling refresh requires threads and ASN time"
+    #endif
+#endif
+
 
 int InitOCSP(WOLFSSL_OCSP* ocsp, WOLFSSL_CERT_MANAGER* cm)
 {
@@ -53,21 +62,41 @@ int InitOCSP(WOLFSSL_OCSP* ocsp, WOLFSSL_CERT_MANAGER* cm)
         return BAD_MUTEX_E;
 
     ocsp->cm = cm;
+    ocsp->ocspMaxCount = cm->ocspCacheSz;
+
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+    if (pthread_cond_init(&ocsp->refreshCond, 0) != 0) {
+        WOLFSSL_MSG("Pthread condition init failed");
+        wc_FreeMutex(&ocsp->ocspLock);
+        return BAD_COND_E;
+    }
+#endif
+
+    ocsp->ocspTable = (OcspEntry**)XMALLOC(sizeof(OcspEntry*) * OCSP_TABLE_SIZE,
+                                           cm->heap, DYNAMIC_TYPE_OCSP);
+    if (ocsp->ocspTable == NULL) {
+    #ifdef HAVE_OCSP_STAPLING_REFRESH
+        pthread_cond_destroy(&ocsp->refreshCond);
+    #endif
+        wc_FreeMutex(&ocsp->ocspLock);
+        return MEMORY_E;
+    }
+    XMEMSET(ocsp->ocspTable, 0, sizeof(OcspEntry*) * OCSP_TABLE_SIZE);
+    ocsp->ocspTableSz = OCSP_TABLE_SIZE;
 
     return 0;
 }
 
 
-static int InitOcspEntry(OcspEntry* entry, OcspRequest* request)
+static void InitOcspEntry(OcspEntry* entry, OcspEntry* single)
 {
     WOLFSSL_ENTER("InitOcspEntry");
 
     ForceZero(entry, sizeof(OcspEntry));
 
-    XMEMCPY(entry->issuerHash,    request->issuerHash,    OCSP_DIGEST_SIZE);
-    XMEMCPY(entry->issuerKeyHash, request->issuerKeyHash, OCSP_DIGEST_SIZE);
-
-    return 0;
+    entry->hashAlgoOID = single->hashAlgoOID;
+    XMEMCPY(entry->issuerHash,    single->issuerHash,    OCSP_DIGEST_SIZE);
+    XMEMCPY(entry->issuerKeyHash, single->issuerKeyHash, OCSP_DIGEST_SIZE);
 }
 
 
@@ -103,18 +132,58 @@ static void FreeOcspEntry(OcspEntry* entry, void* heap)
 }
 
 
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+static void StopOcspRefresh(WOLFSSL_OCSP* ocsp)
+{
+    OcspStaple *staple, *next;
+
+    if (ocsp->refreshTid != 0) {
+        WOLFSSL_MSG("stopping OCSP refresh thread");
+        if (wc_LockMutex(&ocsp->ocspLock) == 0) {
+            ocsp->refreshStop = 1;
+            pthread_cond_signal(&ocsp->refreshCond);
+            wc_UnLockMutex(&ocsp->ocspLock);
+            pthread_join(ocsp->refreshTid, NULL);
+        }
+        else {
+            WOLFSSL_MSG("stop OCSP refresh failed");
+        }
+        ocsp->refreshTid = 0;
+    }
+
+    for (staple = ocsp->staples; staple; staple = next) {
+        next = staple->next;
+        FreeOcspRequest(staple->request);
+        XFREE(staple->request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_REQUEST);
+        if (staple->response)
+            XFREE(staple->response, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_STATUS);
+        XFREE(staple, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
+    }
+    ocsp->staples = NULL;
+}
+#endif /* HAVE_OCSP_STAPLING_REFRESH */
+
+
 void FreeOCSP(WOLFSSL_OCSP* ocsp, int dynamic)
 {
     OcspEntry *entry, *next;
 
     WOLFSSL_ENTER("FreeOCSP");
 
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+    StopOcspRefresh(ocsp);
+    pthread_cond_destroy(&ocsp->refreshCond);
+#endif
+
     for (entry = ocsp->ocspList; entry; entry = next) {
         next = entry->next;
         FreeOcspEntry(entry, ocsp->cm->heap);
         XFREE(entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
     }
 
+    if (ocsp->ocspTable)
+        XFREE(ocsp->ocspTable, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+
     wc_FreeMutex(&ocsp->ocspLock);
 
     if (dynamic)
@@ -123,6 +192,231 @@ void FreeOCSP(WOLFSSL_OCSP* ocsp, int dynamic)
 }
 
 
+/* The issuer hashes are SHA digests so their front words are already random.
+ * The serial number is mixed in so certificates of one issuer spread out. */
+static WC_INLINE word32 HashOcspEntry(const byte* issuerHash,
+                                      const byte* issuerKeyHash,
+                                      const byte* serial, int serialSz)
+{
+    word32 hash;
+    int    i;
+
+    hash = (((word32)issuerHash[0] << 24) | ((word32)issuerHash[1] << 16) |
+            ((word32)issuerHash[2] <<  8) |  (word32)issuerHash[3]) ^
+           (((word32)issuerKeyHash[0] << 24) | ((word32)issuerKeyHash[1] << 16) |
+            ((word32)issuerKeyHash[2] <<  8) |  (word32)issuerKeyHash[3]);
+
+    for (i = 0; i < serialSz; i++)
+        hash = (hash * 31) + serial[i];
+
+    return hash;
+}
+
+
+static WC_INLINE word32 OcspEntryRow(WOLFSSL_OCSP* ocsp, OcspEntry* entry)
+{
+    return HashOcspEntry(entry->issuerHash, entry->issuerKeyHash,
+                         entry->status->serial, entry->status->serialSz) &
+           (ocsp->ocspTableSz - 1);
+}
+
+
+/* Move entry to the front of the list, ocspLock must be held */
+static void OcspEntryToFront(WOLFSSL_OCSP* ocsp, OcspEntry* entry)
+{
+    if (ocsp->ocspList == entry)
+        return;
+
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else if (ocsp->ocspTail == entry)
+        ocsp->ocspTail = entry->prev;
+
+    entry->prev = NULL;
+    entry->next = ocsp->ocspList;
+    if (ocsp->ocspList)
+        ocsp->ocspList->prev = entry;
+    ocsp->ocspList = entry;
+    if (ocsp->ocspTail == NULL)
+        ocsp->ocspTail = entry;
+}
+
+
+/* Find cached entry for the certificate, ocspLock must be held */
+static OcspEntry* FindOcspEntry(WOLFSSL_OCSP* ocsp, const byte* issuerHash,
+                    const byte* issuerKeyHash, const byte* serial, int serialSz)
+{
+    OcspEntry* entry;
+    word32     row;
+
+    row = HashOcspEntry(issuerHash, issuerKeyHash, serial, serialSz) &
+          (ocsp->ocspTableSz - 1);
+
+    for (entry = ocsp->ocspTable[row]; entry; entry = entry->hashNext) {
+        if (entry->status->serialSz == serialSz
+        &&  XMEMCMP(entry->status->serial, serial, serialSz) == 0
+        &&  XMEMCMP(entry->issuerHash,    issuerHash,    OCSP_DIGEST_SIZE) == 0
+        &&  XMEMCMP(entry->issuerKeyHash, issuerKeyHash, OCSP_DIGEST_SIZE) == 0)
+            break;
+    }
+
+    return entry;
+}
+
+
+/* Unlink entry from the cache and free it, ocspLock must be held */
+static void RemoveOcspEntry(WOLFSSL_OCSP* ocsp, OcspEntry* entry)
+{
+    OcspEntry** prev;
+
+    prev = &ocsp->ocspTable[OcspEntryRow(ocsp, entry)];
+    while (*prev && *prev != entry)
+        prev = &(*prev)->hashNext;
+    if (*prev)
+        *prev = entry->hashNext;
+
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        ocsp->ocspList = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        ocsp->ocspTail = entry->prev;
+
+    ocsp->ocspCount--;
+
+    FreeOcspEntry(entry, ocsp->cm->heap);
+    XFREE(entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
+}
+
+
+/* Double the number of hash rows, ocspLock must be held.
+ * On allocation failure the current table is kept. */
+static void GrowOcspTable(WOLFSSL_OCSP* ocsp)
+{
+    OcspEntry** table;
+    OcspEntry*  entry;
+    word32      sz = ocsp->ocspTableSz * 2;
+    word32      row;
+
+    table = (OcspEntry**)XMALLOC(sizeof(OcspEntry*) * sz, ocsp->cm->heap,
+                                 DYNAMIC_TYPE_OCSP);
+    if (table == NULL)
+        return;
+    XMEMSET(table, 0, sizeof(OcspEntry*) * sz);
+
+    XFREE(ocsp->ocspTable, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    ocsp->ocspTable   = table;
+    ocsp->ocspTableSz = sz;
+
+    for (entry = ocsp->ocspList; entry; entry = entry->next) {
+        row = OcspEntryRow(ocsp, entry);
+        entry->hashNext = table[row];
+        table[row] = entry;
+    }
+}
+
+
+/* Evict least recently used responses until there is room for count more,
+ * ocspLock must be held */
+static void TrimOcspCache(WOLFSSL_OCSP* ocsp, word32 count)
+{
+    if (ocsp->ocspMaxCount == 0)
+        return;
+
+    while (ocsp->ocspTail && ocsp->ocspCount + count > ocsp->ocspMaxCount) {
+        WOLFSSL_MSG("Evicting least recently used OCSP response");
+        RemoveOcspEntry(ocsp, ocsp->ocspTail);
+    }
+}
+
+
+/* Store status of the single response in the cache, replacing any previous
+ * status of the same certificate. ocspLock must be held.
+ *
+ * Returns the cached status or NULL on memory failure */
+static CertStatus* AddOcspEntry(WOLFSSL_OCSP* ocsp, OcspEntry* single)
+{
+    OcspEntry*  entry;
+    CertStatus* status;
+    word32      row;
+
+    entry = FindOcspEntry(ocsp, single->issuerHash, single->issuerKeyHash,
+                       single->status->serial, single->status->serialSz);
+    if (entry != NULL) {
+        status = entry->status;
+        if (status->rawOcspResponse) {
+            XFREE(status->rawOcspResponse, ocsp->cm->heap,
+                  DYNAMIC_TYPE_OCSP_STATUS);
+        }
+
+        /* Replace existing certificate entry with updated */
+        XMEMCPY(status, single->status, sizeof(CertStatus));
+        status->next = NULL;
+        OcspEntryToFront(ocsp, entry);
+
+        return status;
+    }
+
+    TrimOcspCache(ocsp, 1);
+    if (ocsp->ocspCount >= ocsp->ocspTableSz)
+        GrowOcspTable(ocsp);
+
+    entry = (OcspEntry*)XMALLOC(sizeof(OcspEntry), ocsp->cm->heap,
+                                DYNAMIC_TYPE_OCSP_ENTRY);
+    status = (CertStatus*)XMALLOC(sizeof(CertStatus), ocsp->cm->heap,
+                                  DYNAMIC_TYPE_OCSP_STATUS);
+    if (entry == NULL || status == NULL) {
+        if (entry)
+            XFREE(entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
+        if (status)
+            XFREE(status, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_STATUS);
+        return NULL;
+    }
+
+    InitOcspEntry(entry, single);
+    XMEMCPY(status, single->status, sizeof(CertStatus));
+    status->next = NULL;
+    entry->status = status;
+    entry->totalStatus = 1;
+
+    row = OcspEntryRow(ocsp, entry);
+    entry->hashNext = ocsp->ocspTable[row];
+    ocsp->ocspTable[row] = entry;
+
+    entry->next = ocsp->ocspList;
+    if (ocsp->ocspList)
+        ocsp->ocspList->prev = entry;
+    ocsp->ocspList = entry;
+    if (ocsp->ocspTail == NULL)
+        ocsp->ocspTail = entry;
+    ocsp->ocspCount++;
+
+    return status;
+}
+
+
+/* Set the maximum number of cached responses, 0 for no limit.
+ * Responses beyond the new bound are evicted. */
+int SetOCSPCacheSize(WOLFSSL_OCSP* ocsp, word32 sz)
+{
+    WOLFSSL_ENTER("SetOCSPCacheSize");
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0)
+        return BAD_MUTEX_E;
+
+    ocsp->ocspMaxCount = sz;
+    TrimOcspCache(ocsp, 0);
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    return 0;
+}
+
+
 static int xstat2err(int st)
 {
     switch (st) {
@@ -160,7 +454,24 @@ int CheckCertOCSP_ex(WOLFSSL_OCSP* ocsp, DecodedCert* cert, buffer* responseBuff
     if (InitOcspRequest(ocspRequest, cert, ocsp->cm->ocspSendNonce,
                                                          ocsp->cm->heap) == 0) {
         ocspRequest->ssl = ssl;
+    #ifdef WOLFSSL_NONBLOCK_OCSP
+        /* a resumed lookup has to repeat the request in flight */
+        if (ssl != NULL && ssl->ocspNonceSz > 0 && ocspRequest->nonceSz > 0) {
+            XMEMCPY(ocspRequest->nonce, ssl->ocspNonce, ssl->ocspNonceSz);
+            ocspRequest->nonceSz = ssl->ocspNonceSz;
+        }
+    #endif
         ret = CheckOcspRequest(ocsp, ocspRequest, responseBuffer);
+    #ifdef WOLFSSL_NONBLOCK_OCSP
+        if (ssl != NULL) {
+            ssl->ocspNonceSz = 0;
+            if (ret == OCSP_WANT_READ) {
+                XMEMCPY(ssl->ocspNonce, ocspRequest->nonce,
+                                                        ocspRequest->nonceSz);
+                ssl->ocspNonceSz = ocspRequest->nonceSz;
+            }
+        }
+    #endif
 
         FreeOcspRequest(ocspRequest);
     }
@@ -177,91 +488,61 @@ int CheckCertOCSP(WOLFSSL_OCSP* ocsp, DecodedCert* cert, buffer* responseBuffer)
     return CheckCertOCSP_ex(ocsp, cert, responseBuffer, NULL);
 }
 
-static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
-                                                              OcspEntry** entry)
-{
-    WOLFSSL_ENTER("GetOcspEntry");
-
-    *entry = NULL;
-
-    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
-        WOLFSSL_LEAVE("CheckCertOCSP", BAD_MUTEX_E);
-        return BAD_MUTEX_E;
-    }
-
-    for (*entry = ocsp->ocspList; *entry; *entry = (*entry)->next)
-        if (XMEMCMP((*entry)->issuerHash,    request->issuerHash,
-                                                         OCSP_DIGEST_SIZE) == 0
-        &&  XMEMCMP((*entry)->issuerKeyHash, request->issuerKeyHash,
-                                                         OCSP_DIGEST_SIZE) == 0)
-            break;
-
-    if (*entry == NULL) {
-        *entry = (OcspEntry*)XMALLOC(sizeof(OcspEntry),
-                                       ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
-        if (*entry) {
-            InitOcspEntry(*entry, request);
-            (*entry)->next = ocsp->ocspList;
-            ocsp->ocspList = *entry;
-        }
-    }
-
-    wc_UnLockMutex(&ocsp->ocspLock);
-
-    return *entry ? 0 : MEMORY_ERROR;
-}
-
-
 /* Mallocs responseBuffer->buffer and is up to caller to free on success
  *
  * Returns OCSP status
  */
 static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
-                  OcspEntry* entry, CertStatus** status, buffer* responseBuffer)
+                                                        buffer* responseBuffer)
 {
     int ret = OCSP_INVALID_STATUS;
+    OcspEntry*  entry;
+    CertStatus* status;
 
     WOLFSSL_ENTER("GetOcspStatus");
 
-    *status = NULL;
-
     if (wc_LockMutex(&ocsp->ocspLock) != 0) {
         WOLFSSL_LEAVE("CheckCertOCSP", BAD_MUTEX_E);
         return BAD_MUTEX_E;
     }
 
-    for (*status = entry->status; *status; *status = (*status)->next)
-        if ((*status)->serialSz == request->serialSz
-        &&  !XMEMCMP((*status)->serial, request->serial, (*status)->serialSz))
-            break;
+    entry = FindOcspEntry(ocsp, request->issuerHash, request->issuerKeyHash,
+                          request->serial, request->serialSz);
+    status = entry ? entry->status : NULL;
 
-    if (responseBuffer && *status && !(*status)->rawOcspResponse) {
+    if (responseBuffer && status && !status->rawOcspResponse) {
         /* force fetching again */
         ret = OCSP_INVALID_STATUS;
     }
-    else if (*status) {
+    else if (status) {
 #ifndef NO_ASN_TIME
-        if (XVALIDATE_DATE((*status)->thisDate,
-                                             (*status)->thisDateFormat, BEFORE)
-        &&  ((*status)->nextDate[0] != 0)
-        &&  XVALIDATE_DATE((*status)->nextDate,
-                                             (*status)->nextDateFormat, AFTER))
+        if (XVALIDATE_DATE(status->thisDate, status->thisDateFormat, BEFORE)
+        &&  (status->nextDate[0] != 0)
+        &&  XVALIDATE_DATE(status->nextDate, status->nextDateFormat, AFTER))
 #endif
         {
-            ret = xstat2err((*status)->status);
+            ret = xstat2err(status->status);
+            OcspEntryToFront(ocsp, entry);
 
             if (responseBuffer) {
                 responseBuffer->buffer = (byte*)XMALLOC(
-                   (*status)->rawOcspResponseSz, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+                   status->rawOcspResponseSz, NULL, DYNAMIC_TYPE_TMP_BUFFER);
 
                 if (responseBuffer->buffer) {
-                    responseBuffer->length = (*status)->rawOcspResponseSz;
+                    responseBuffer->length = status->rawOcspResponseSz;
                     XMEMCPY(responseBuffer->buffer,
-                            (*status)->rawOcspResponse,
-                            (*status)->rawOcspResponseSz);
+                            status->rawOcspResponse,
+                            status->rawOcspResponseSz);
                 }
             }
         }
+#ifndef NO_ASN_TIME
+        else {
+            /* past nextUpdate, drop it so a fresh response gets fetched */
+            WOLFSSL_MSG("Cached OCSP response expired");
+            RemoveOcspEntry(ocsp, entry);
+        }
+#endif
     }
 
     wc_UnLockMutex(&ocsp->ocspLock);
@@ -363,7 +644,7 @@ WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int resp
         newSingle->status->next = status->next;
         XMEMCPY(status, newSingle->status, sizeof(CertStatus));
     }
-    else {
+    else if (entry != NULL) {
         /* Save new certificate entry */
         status = (CertStatus*)XMALLOC(sizeof(CertStatus),
                                       ocsp->cm->heap, DYNAMIC_TYPE_OCSP_STATUS);
@@ -374,6 +655,10 @@ WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int resp
             entry->totalStatus++;
         }
     }
+    else {
+        /* Save in the response cache */
+        status = AddOcspEntry(ocsp, ocspResponse->single);
+    }
 
     if (status && responseBuffer && responseBuffer->buffer) {
         status->rawOcspResponse = (byte*)XMALLOC(responseBuffer->length,
@@ -404,12 +689,430 @@ end:
     return ret;
 }
 
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+/* Convert ASN date to seconds since the epoch, 0 on failure */
+static time_t OcspDateToTime(const byte* date, byte format)
+{
+    struct tm t;
+    int       idx = 0;
+
+    if (!ExtractDate(date, format, &t, &idx))
+        return 0;
+
+    return timegm(&t);
+}
+
+
+/* Find staple of certificate, ocspLock must be held */
+static OcspStaple* FindOcspStaple(WOLFSSL_OCSP* ocsp, OcspRequest* request)
+{
+    OcspStaple* staple;
+
+    for (staple = ocsp->staples; staple; staple = staple->next) {
+        if (staple->request->serialSz == request->serialSz
+        &&  XMEMCMP(staple->request->serial, request->serial,
+                                                       request->serialSz) == 0
+        &&  XMEMCMP(staple->request->issuerHash, request->issuerHash,
+                                                         OCSP_DIGEST_SIZE) == 0
+        &&  XMEMCMP(staple->request->issuerKeyHash, request->issuerKeyHash,
+                                                         OCSP_DIGEST_SIZE) == 0)
+            break;
+    }
+
+    return staple;
+}
+
+
+/* Copy the refreshed response of a registered certificate. Never fetches.
+ * Mallocs responseBuffer->buffer and is up to caller to free on success
+ *
+ * Returns OCSP status, OCSP_INVALID_STATUS when certificate not registered
+ * and OCSP_LOOKUP_FAIL when no current response is available */
+static int GetOcspStaple(WOLFSSL_OCSP* ocsp, OcspRequest* request,
+                                                        buffer* responseBuffer)
+{
+    int         ret = OCSP_INVALID_STATUS;
+    OcspStaple* staple;
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0)
+        return BAD_MUTEX_E;
+
+    staple = FindOcspStaple(ocsp, request);
+    if (staple != NULL) {
+        if (staple->response == NULL ||
+                (staple->nextUpdate != 0 && staple->nextUpdate <= XTIME(0))) {
+            WOLFSSL_MSG("No current OCSP staple, refresh pending");
+            ret = OCSP_LOOKUP_FAIL;
+        }
+        else {
+            ret = staple->status;
+
+            if (responseBuffer) {
+                responseBuffer->buffer = (byte*)XMALLOC(staple->responseSz,
+                                                NULL, DYNAMIC_TYPE_TMP_BUFFER);
+                if (responseBuffer->buffer) {
+                    responseBuffer->length = staple->responseSz;
+                    XMEMCPY(responseBuffer->buffer, staple->response,
+                            staple->responseSz);
+                }
+            }
+        }
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    return ret;
+}
+
+
+/* Fetch and check a new response for staple then swap it in.
+ * Called without ocspLock held, the request of a staple never changes. */
+static int RefreshOcspStaple(WOLFSSL_OCSP* ocsp, OcspStaple* staple)
+{
+#ifdef WOLFSSL_SMALL_STACK
+    CertStatus*   newStatus;
+    OcspEntry*    newSingle;
+    OcspResponse* ocspResponse;
+#else
+    CertStatus    newStatus[1];
+    OcspEntry     newSingle[1];
+    OcspResponse  ocspResponse[1];
+#endif
+    OcspRequest* ocspRequest = staple->request;
+    void*        heap        = ocsp->cm->heap;
+    byte*        request     = NULL;
+    int          requestSz   = 2048;
+    byte*        response    = NULL;
+    int          responseSz  = 0;
+    byte*        der         = NULL;
+    const char*  url         = NULL;
+    int          urlSz       = 0;
+    int          status      = 0;
+    time_t       now;
+    time_t       nextUpdate  = 0;
+    int          ret;
+
+    WOLFSSL_ENTER("RefreshOcspStaple");
+
+    if (ocsp->cm->ocspUseOverrideURL) {
+        url = ocsp->cm->ocspOverrideURL;
+        if (url != NULL && url[0] != '\0')
+            urlSz = (int)XSTRLEN(url);
+    }
+    else if (ocspRequest->urlSz != 0 && ocspRequest->url != NULL) {
+        url = (const char *)ocspRequest->url;
+        urlSz = ocspRequest->urlSz;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    newStatus = (CertStatus*)XMALLOC(sizeof(CertStatus), NULL,
+                                                       DYNAMIC_TYPE_OCSP_STATUS);
+    newSingle = (OcspEntry*)XMALLOC(sizeof(OcspEntry), NULL,
+                                                       DYNAMIC_TYPE_OCSP_ENTRY);
+    ocspResponse = (OcspResponse*)XMALLOC(sizeof(OcspResponse), NULL,
+                                                       DYNAMIC_TYPE_OCSP_REQUEST);
+
+    if (newStatus == NULL || newSingle == NULL || ocspResponse == NULL) {
+        if (newStatus) XFREE(newStatus, NULL, DYNAMIC_TYPE_OCSP_STATUS);
+        if (newSingle) XFREE(newSingle, NULL, DYNAMIC_TYPE_OCSP_ENTRY);
+        if (ocspResponse) XFREE(ocspResponse, NULL, DYNAMIC_TYPE_OCSP_REQUEST);
+
+        ret = MEMORY_E;
+        goto end;
+    }
+#endif
+
+    if (urlSz == 0) {
+        WOLFSSL_MSG("Cert has no OCSP URL, nothing to staple");
+        ret = OCSP_NEED_URL;
+    }
+    else if (ocsp->cm->ocspIOCb == NULL) {
+        ret = OCSP_LOOKUP_FAIL;
+    }
+    else if ((request = (byte*)XMALLOC(requestSz, heap,
+                                              DYNAMIC_TYPE_OCSP)) == NULL) {
+        ret = MEMORY_E;
+    }
+    else {
+        ret = OCSP_LOOKUP_FAIL;
+        requestSz = EncodeOcspRequest(ocspRequest, request, requestSz);
+        if (requestSz > 0) {
+            responseSz = ocsp->cm->ocspIOCb(ocsp->cm->ocspIOCtx, url, urlSz,
+                                            request, requestSz, &response);
+        }
+        XFREE(request, heap, DYNAMIC_TYPE_OCSP);
+    }
+
+    if (responseSz > 0 && response != NULL) {
+        InitOcspResponse(ocspResponse, newSingle, newStatus, response,
+                         responseSz, heap);
+
+        if (OcspResponseDecode(ocspResponse, ocsp->cm, heap, 0) == 0
+        &&  ocspResponse->responseStatus == OCSP_SUCCESSFUL
+        &&  CompareOcspReqResp(ocspRequest, ocspResponse) == 0) {
+            status = xstat2err(ocspResponse->single->status->status);
+            if (ocspResponse->single->status->nextDate[0] != 0) {
+                nextUpdate = OcspDateToTime(
+                                  ocspResponse->single->status->nextDate,
+                                  ocspResponse->single->status->nextDateFormat);
+            }
+
+            der = (byte*)XMALLOC(responseSz, heap, DYNAMIC_TYPE_OCSP_STATUS);
+            if (der != NULL) {
+                XMEMCPY(der, response, responseSz);
+                ret = 0;
+            }
+            else {
+                ret = MEMORY_E;
+            }
+        }
+        else {
+            WOLFSSL_MSG("OCSP staple response not valid");
+        }
+
+        FreeOcspResponse(ocspResponse);
+    }
+
+    if (response != NULL && ocsp->cm->ocspRespFreeCb)
+        ocsp->cm->ocspRespFreeCb(ocsp->cm->ocspIOCtx, response);
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(newStatus,    NULL, DYNAMIC_TYPE_OCSP_STATUS);
+    XFREE(newSingle,    NULL, DYNAMIC_TYPE_OCSP_ENTRY);
+    XFREE(ocspResponse, NULL, DYNAMIC_TYPE_OCSP_REQUEST);
+end:
+#endif
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+        if (der != NULL)
+            XFREE(der, heap, DYNAMIC_TYPE_OCSP_STATUS);
+        return BAD_MUTEX_E;
+    }
+
+    now = XTIME(0);
+    if (ret == 0) {
+        if (staple->response)
+            XFREE(staple->response, heap, DYNAMIC_TYPE_OCSP_STATUS);
+        staple->response   = der;
+        staple->responseSz = (word32)responseSz;
+        staple->status     = status;
+        staple->nextUpdate = nextUpdate;
+
+        /* refresh half way to nextUpdate so there is time to retry */
+        if (nextUpdate == 0)
+            staple->refreshAt = now + OCSP_STAPLING_REFRESH_DEFAULT;
+        else if (nextUpdate > now + 1)
+            staple->refreshAt = now + (nextUpdate - now) / 2;
+        else
+            staple->refreshAt = now + 1;
+    }
+    else if (ret == OCSP_NEED_URL) {
+        /* only an override URL set later can help */
+        staple->refreshAt = now + OCSP_STAPLING_REFRESH_DEFAULT;
+    }
+    else {
+        staple->refreshAt = now + OCSP_STAPLING_REFRESH_RETRY;
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    WOLFSSL_LEAVE("RefreshOcspStaple", ret);
+    return ret;
+}
+
+
+/* Refresh thread, fetches each staple when due and sleeps in between */
+static void* DoOcspRefresh(void* arg)
+{
+    WOLFSSL_OCSP*   ocsp = (WOLFSSL_OCSP*)arg;
+    OcspStaple*     staple;
+    time_t          now;
+    time_t          wake;
+    struct timespec ts;
+
+    WOLFSSL_ENTER("DoOcspRefresh");
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex ocspLock error");
+        return NULL;
+    }
+
+    while (!ocsp->refreshStop) {
+        now  = XTIME(0);
+        wake = (time_t)-1;
+
+        for (staple = ocsp->staples; staple; staple = staple->next) {
+            if (staple->refreshAt <= now)
+                break;
+            if (staple->refreshAt < wake || wake == (time_t)-1)
+                wake = staple->refreshAt;
+        }
+
+        if (staple != NULL) {
+            /* don't pick it again right away should the fetch fail */
+            staple->refreshAt = now + OCSP_STAPLING_REFRESH_RETRY;
+
+            wc_UnLockMutex(&ocsp->ocspLock);
+            RefreshOcspStaple(ocsp, staple);
+            if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+                WOLFSSL_MSG("wc_LockMutex ocspLock error");
+                return NULL;
+            }
+            continue;
+        }
+
+        if (wake == (time_t)-1) {
+            pthread_cond_wait(&ocsp->refreshCond, &ocsp->ocspLock);
+        }
+        else {
+            /* relative to the condition clock in case XTIME differs */
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec += wake - now;
+            pthread_cond_timedwait(&ocsp->refreshCond, &ocsp->ocspLock, &ts);
+        }
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    return NULL;
+}
+
+
+/* Register certificate to be stapled with a refreshed response.
+ * The issuer has to be loaded into the certificate manager.
+ *
+ * Returns 0 on success */
+int AddOcspStaple(WOLFSSL_OCSP* ocsp, const byte* der, word32 derSz)
+{
+    int          ret;
+    void*        heap    = ocsp->cm->heap;
+    OcspStaple*  staple  = NULL;
+    OcspRequest* request = NULL;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert;
+#else
+    DecodedCert  cert[1];
+#endif
+
+    WOLFSSL_ENTER("AddOcspStaple");
+
+#ifdef WOLFSSL_SMALL_STACK
+    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), heap,
+                                                            DYNAMIC_TYPE_DCERT);
+    if (cert == NULL)
+        return MEMORY_E;
+#endif
+
+    staple = (OcspStaple*)XMALLOC(sizeof(OcspStaple), heap,
+                                                       DYNAMIC_TYPE_OCSP_ENTRY);
+    request = (OcspRequest*)XMALLOC(sizeof(OcspRequest), heap,
+                                                     DYNAMIC_TYPE_OCSP_REQUEST);
+    if (staple == NULL || request == NULL) {
+        if (staple)
+            XFREE(staple, heap, DYNAMIC_TYPE_OCSP_ENTRY);
+        if (request)
+            XFREE(request, heap, DYNAMIC_TYPE_OCSP_REQUEST);
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(cert, heap, DYNAMIC_TYPE_DCERT);
+    #endif
+        return MEMORY_E;
+    }
+    XMEMSET(staple, 0, sizeof(OcspStaple));
+    XMEMSET(request, 0, sizeof(OcspRequest));
+
+    InitDecodedCert(cert, (byte*)der, derSz, heap);
+    ret = ParseCertRelative(cert, CERT_TYPE, VERIFY, ocsp->cm);
+    if (ret != 0) {
+        WOLFSSL_MSG("ParseCert failed");
+    }
+    if (ret == 0)
+        ret = InitOcspRequest(request, cert, 0, heap);
+    FreeDecodedCert(cert);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(cert, heap, DYNAMIC_TYPE_DCERT);
+#endif
+
+    if (ret == 0 && wc_LockMutex(&ocsp->ocspLock) != 0)
+        ret = BAD_MUTEX_E;
+    if (ret == 0) {
+        if (FindOcspStaple(ocsp, request) == NULL) {
+            staple->request = request;
+            staple->next    = ocsp->staples;
+            ocsp->staples   = staple;
+            staple  = NULL;
+            request = NULL;
+            /* new staple is due now */
+            pthread_cond_signal(&ocsp->refreshCond);
+        }
+        wc_UnLockMutex(&ocsp->ocspLock);
+    }
+
+    if (request != NULL) {
+        FreeOcspRequest(request);
+        XFREE(request, heap, DYNAMIC_TYPE_OCSP_REQUEST);
+    }
+    if (staple != NULL)
+        XFREE(staple, heap, DYNAMIC_TYPE_OCSP_ENTRY);
+
+    WOLFSSL_LEAVE("AddOcspStaple", ret);
+    return ret;
+}
+
+
+/* Fetch responses of registered certificates not yet fetched and start the
+ * thread keeping them fresh. A failed fetch is retried by the thread.
+ *
+ * Returns 0 on success */
+int StartOcspRefresh(WOLFSSL_OCSP* ocsp)
+{
+    OcspStaple* staple;
+    int         ret = 0;
+
+    WOLFSSL_ENTER("StartOcspRefresh");
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0)
+        return BAD_MUTEX_E;
+
+    /* prefetch so the first handshakes have a staple, the lock is dropped
+     * for each fetch and staples are only freed with the manager */
+    while (ocsp->refreshTid == 0) {
+        for (staple = ocsp->staples; staple; staple = staple->next) {
+            if (staple->refreshAt == 0)
+                break;
+        }
+        if (staple == NULL)
+            break;
+
+        /* claimed, a concurrent start won't fetch it again */
+        staple->refreshAt = XTIME(0) + OCSP_STAPLING_REFRESH_RETRY;
+
+        wc_UnLockMutex(&ocsp->ocspLock);
+        RefreshOcspStaple(ocsp, staple);
+        if (wc_LockMutex(&ocsp->ocspLock) != 0)
+            return BAD_MUTEX_E;
+    }
+
+    if (ocsp->refreshTid != 0) {
+        WOLFSSL_MSG("OCSP refresh thread already running");
+        /* new staples already signaled */
+    }
+    else if (pthread_create(&ocsp->refreshTid, NULL, DoOcspRefresh,
+                                                                 ocsp) != 0) {
+        WOLFSSL_MSG("Thread creation error");
+        ocsp->refreshTid = 0;
+        ret = THREAD_CREATE_E;
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    return ret;
+}
+#endif /* HAVE_OCSP_STAPLING_REFRESH */
+
 /* 0 on success */
 int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
                                                       buffer* responseBuffer)
 {
-    OcspEntry*  entry          = NULL;
-    CertStatus* status         = NULL;
     byte*       request        = NULL;
     int         requestSz      = 2048;
     int         responseSz     = 0;
@@ -430,11 +1133,14 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
         responseBuffer->length = 0;
     }
 
-    ret = GetOcspEntry(ocsp, ocspRequest, &entry);
-    if (ret != 0)
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+    /* registered certificates are only ever served from memory */
+    ret = GetOcspStaple(ocsp, ocspRequest, responseBuffer);
+    if (ret != OCSP_INVALID_STATUS)
         return ret;
+#endif
 
-    ret = GetOcspStatus(ocsp, ocspRequest, entry, &status, responseBuffer);
+    ret = GetOcspStatus(ocsp, ocspRequest, responseBuffer);
     if (ret != OCSP_INVALID_STATUS)
         return ret;
 
@@ -448,8 +1154,8 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
         ret = ocsp->statusCb(ssl, ioCtx);
         if (ret == 0) {
             ret = wolfSSL_get_ocsp_response(ssl, &response);
-            ret = CheckOcspResponse(ocsp, response, ret, responseBuffer, status,
-                                entry, NULL);
+            ret = CheckOcspResponse(ocsp, response, ret, responseBuffer, NULL,
+                                NULL, NULL);
             if (response != NULL)
                 XFREE(response, NULL, DYNAMIC_TYPE_OPENSSL);
             return ret;
@@ -498,8 +1204,8 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
     XFREE(request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
 
     if (responseSz >= 0 && response) {
-        ret = CheckOcspResponse(ocsp, response, responseSz, responseBuffer, status,
-                            entry, ocspRequest);
+        ret = CheckOcspResponse(ocsp, response, responseSz, responseBuffer,
+                                NULL, NULL, ocspRequest);
     }
 
     if (response != NULL && ocsp->cm->ocspRespFreeCb)
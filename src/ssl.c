@@ -48,6 +48,13 @@
     #include <errno.h>
 #endif
 
+#ifdef WOLFSSL_TRUST_STORE_MMAP
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
 
 #if !defined(WOLFSSL_ALLOW_NO_SUITES) && !defined(WOLFCRYPT_ONLY)
     #if defined(NO_DH) && !defined(HAVE_ECC) && !defined(WOLFSSL_STATIC_RSA) \
@@ -391,8 +398,12 @@ WOLFSSL_CTX* wolfSSL_CTX_new_ex(WOLFSSL_METHOD* method, void* heap)
     ctx = (WOLFSSL_CTX*) XMALLOC(sizeof(WOLFSSL_CTX), heap, DYNAMIC_TYPE_CTX);
     if (ctx) {
         int ret;
+        int prevOwner;
 
+        /* InitSSL_Ctx charges this thread to the new CTX, give it back */
+        MEM_STATS_PUSH((WOLFSSL_CTX*)NULL, prevOwner);
         ret = InitSSL_Ctx(ctx, method, heap);
+        MEM_STATS_POP(prevOwner);
     #ifdef WOLFSSL_STATIC_MEMORY
         if (heap != NULL) {
             ctx->onHeap = 1; /* free the memory back to heap when done */
@@ -539,6 +550,7 @@ WOLFSSL* wolfSSL_new(WOLFSSL_CTX* ctx)
 {
     WOLFSSL* ssl = NULL;
     int ret = 0;
+    int prevOwner;
 
     (void)ret;
     WOLFSSL_ENTER("SSL_new");
@@ -546,12 +558,14 @@ WOLFSSL* wolfSSL_new(WOLFSSL_CTX* ctx)
     if (ctx == NULL)
         return ssl;
 
+    MEM_STATS_PUSH(ctx, prevOwner);
     ssl = (WOLFSSL*) XMALLOC(sizeof(WOLFSSL), ctx->heap, DYNAMIC_TYPE_SSL);
     if (ssl)
         if ( (ret = InitSSL(ssl, ctx, 0)) < 0) {
             FreeSSL(ssl, ctx->heap);
             ssl = 0;
         }
+    MEM_STATS_POP(prevOwner);
 
     WOLFSSL_LEAVE("SSL_new", ret);
     return ssl;
@@ -1939,16 +1953,12 @@ int wolfSSL_GetDhKey_Sz(WOLFSSL* ssl)
 #endif /* !NO_DH */
 
 
-WOLFSSL_ABI
-int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+static int wolfSSL_write_internal(WOLFSSL* ssl, const void* data, int sz)
 {
     int ret;
 
     WOLFSSL_ENTER("SSL_write()");
 
-    if (ssl == NULL || data == NULL || sz < 0)
-        return BAD_FUNC_ARG;
-
 #ifdef WOLFSSL_EARLY_DATA
     if (ssl->earlyData != no_early_data && (ret = wolfSSL_negotiate(ssl)) < 0) {
         ssl->error = ret;
@@ -2007,9 +2017,26 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
         return ret;
 }
 
+WOLFSSL_ABI
+int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+{
+    int ret;
+    int prevOwner;
+
+    if (ssl == NULL || data == NULL || sz < 0)
+        return BAD_FUNC_ARG;
+
+    MEM_STATS_PUSH(ssl->ctx, prevOwner);
+    ret = wolfSSL_write_internal(ssl, data, sz);
+    MEM_STATS_POP(prevOwner);
+
+    return ret;
+}
+
 static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
 {
     int ret;
+    int prevOwner;
 
     WOLFSSL_ENTER("wolfSSL_read_internal()");
 
@@ -2022,6 +2049,7 @@ static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
         return WRITE_DUP_READ_E;
     }
 #endif
+    MEM_STATS_PUSH(ssl->ctx, prevOwner);
 
 #ifdef HAVE_ERRNO_H
         errno = 0;
@@ -2061,6 +2089,7 @@ static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
     }
 #endif
 
+    MEM_STATS_POP(prevOwner);
     WOLFSSL_LEAVE("wolfSSL_read_internal()", ret);
 
     if (ret < 0)
@@ -2119,6 +2148,13 @@ int wolfSSL_SetDevId(WOLFSSL* ssl, int devId)
 {
     if (ssl == NULL)
         return BAD_FUNC_ARG;
+#ifdef WOLF_CRYPTO_CB_POOL
+    /* handshakes don't poll the pool, its WC_PENDING_E would fail them */
+    if (wc_CryptoCb_PoolIsDevice(devId)) {
+        WOLFSSL_MSG("Crypto callback pool devId not supported on a WOLFSSL");
+        return BAD_FUNC_ARG;
+    }
+#endif
 
     ssl->devId = devId;
 
@@ -2130,6 +2166,13 @@ int wolfSSL_CTX_SetDevId(WOLFSSL_CTX* ctx, int devId)
 {
     if (ctx == NULL)
         return BAD_FUNC_ARG;
+#ifdef WOLF_CRYPTO_CB_POOL
+    if (wc_CryptoCb_PoolIsDevice(devId)) {
+        WOLFSSL_MSG("Crypto callback pool devId not supported on a "
+                    "WOLFSSL_CTX");
+        return BAD_FUNC_ARG;
+    }
+#endif
 
     ctx->devId = devId;
 
@@ -2223,6 +2266,793 @@ int wolfSSL_SNI_GetFromBuffer(const byte* clientHello, word32 helloSz,
     return BAD_FUNC_ARG;
 }
 
+#ifdef WOLFSSL_SNI_TABLE
+
+/* DNS names compare without case */
+static WC_INLINE char SniLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+
+/* FNV-1a of the lower case name */
+static word32 HashSniName(const char* name, word16 sz)
+{
+    word32 hash = 2166136261U;
+    word16 i;
+
+    for (i = 0; i < sz; i++) {
+        hash ^= (byte)SniLower(name[i]);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+
+/* Return the link to the entry for name, or to the end of its row, have
+ * lock */
+static SniName** FindSniName(SniTable* table, const char* name, word16 sz,
+                             byte wildcard, word32 hash)
+{
+    SniName** link = &table->rows[hash % table->rowsSz];
+    word16    i;
+
+    for (; *link != NULL; link = &(*link)->next) {
+        SniName* entry = *link;
+
+        if (entry->hash != hash || entry->nameSz != sz ||
+                                   entry->wildcard != wildcard)
+            continue;
+        for (i = 0; i < sz; i++) {
+            if (SniLower(name[i]) != entry->name[i])
+                break;
+        }
+        if (i == sz)
+            break;
+    }
+
+    return link;
+}
+
+
+/* Grow the rows once the average row is over SNI_TABLE_LOAD, have write
+ * lock. Rows are only a speed up, so failing to grow is not an error. */
+static void GrowSniTable(SniTable* table, void* heap)
+{
+    SniName** rows;
+    SniName*  entry;
+    SniName*  next;
+    word32    rowsSz;
+    word32    i, row;
+
+    if (table->count <= table->rowsSz * SNI_TABLE_LOAD ||
+            table->rowsSz >= SNI_TABLE_MAX_SIZE) {
+        return;
+    }
+    rowsSz = table->rowsSz * 2 + 1;
+
+    rows = (SniName**)XMALLOC(sizeof(SniName*) * rowsSz, heap,
+                              DYNAMIC_TYPE_TLSX);
+    if (rows == NULL)
+        return;
+    XMEMSET(rows, 0, sizeof(SniName*) * rowsSz);
+
+    for (i = 0; i < table->rowsSz; i++) {
+        for (entry = table->rows[i]; entry != NULL; entry = next) {
+            next = entry->next;
+            row = entry->hash % rowsSz;
+            entry->next = rows[row];
+            rows[row] = entry;
+        }
+    }
+
+    XFREE(table->rows, heap, DYNAMIC_TYPE_TLSX);
+    table->rows   = rows;
+    table->rowsSz = rowsSz;
+}
+
+
+/* Drop a reference to cert, the last one frees it */
+static void SniCertFree(SniCert* cert, void* heap)
+{
+    int refCount = 0;
+
+    if (cert == NULL)
+        return;
+
+    if (wc_LockMutex(&cert->refMutex) == 0) {
+        refCount = --cert->refCount;
+        wc_UnLockMutex(&cert->refMutex);
+    }
+    else {
+        WOLFSSL_MSG("Couldn't lock SNI cert count mutex");
+        return;
+    }
+    if (refCount > 0)
+        return;
+
+    FreeDer(&cert->certificate);
+    FreeDer(&cert->certChain);
+    FreeDer(&cert->key);
+    wc_FreeMutex(&cert->refMutex);
+    XFREE(cert, heap, DYNAMIC_TYPE_TLSX);
+    (void)heap;
+}
+
+
+void FreeSniTable(SniTable* table, void* heap)
+{
+    SniName* entry;
+    SniName* next;
+    word32   i;
+
+    if (table == NULL)
+        return;
+
+    for (i = 0; i < table->rowsSz; i++) {
+        for (entry = table->rows[i]; entry != NULL; entry = next) {
+            next = entry->next;
+            SniCertFree(entry->cert, heap);
+            XFREE(entry, heap, DYNAMIC_TYPE_TLSX);
+        }
+    }
+    XFREE(table->rows, heap, DYNAMIC_TYPE_TLSX);
+    wc_FreeRwLock(&table->lock);
+    XFREE(table, heap, DYNAMIC_TYPE_TLSX);
+}
+
+
+/* Get the DER of the next certificate or key in buff, used is set to the
+ * bytes consumed */
+static int SniCertDer(WOLFSSL_CTX* ctx, const byte* buff, long sz, int format,
+                      int type, DerBuffer** pDer, long* used)
+{
+    int ret = 0;
+#ifdef WOLFSSL_SMALL_STACK
+    EncryptedInfo* info = NULL;
+#else
+    EncryptedInfo  info[1];
+#endif
+
+    if (format == WOLFSSL_FILETYPE_PEM) {
+    #ifdef WOLFSSL_PEM_TO_DER
+    #ifdef WOLFSSL_SMALL_STACK
+        info = (EncryptedInfo*)XMALLOC(sizeof(EncryptedInfo), ctx->heap,
+                                       DYNAMIC_TYPE_ENCRYPTEDINFO);
+        if (info == NULL)
+            return MEMORY_E;
+    #endif
+        XMEMSET(info, 0, sizeof(EncryptedInfo));
+    #if defined(WOLFSSL_ENCRYPTED_KEYS) && !defined(NO_PWDBASED)
+        info->passwd_cb       = ctx->passwd_cb;
+        info->passwd_userdata = ctx->passwd_userdata;
+    #endif
+        ret = PemToDer(buff, sz, type, pDer, ctx->heap, info, NULL);
+        *used = info->consumed;
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(info, ctx->heap, DYNAMIC_TYPE_ENCRYPTEDINFO);
+    #endif
+    #else
+        ret = NOT_COMPILED_IN;
+    #endif
+    }
+    else if (format == WOLFSSL_FILETYPE_ASN1) {
+        word32 idx = 0;
+        int    length;
+
+        if (GetSequence(buff, &idx, &length, (word32)sz) < 0)
+            return ASN_NO_PEM_HEADER;
+        length += idx; /* include leading sequence */
+        *used = length;
+
+        ret = AllocDer(pDer, (word32)length, type, ctx->heap);
+        if (ret == 0)
+            XMEMCPY((*pDer)->buffer, buff, length);
+    #ifdef HAVE_PKCS8
+        /* remove any PKCS8 header from a private key */
+        if (ret == 0 && type == PRIVATEKEY_TYPE) {
+            word32 algId;
+            int    tradSz = ToTraditional_ex((*pDer)->buffer, (*pDer)->length,
+                                             &algId);
+            if (tradSz > 0)
+                (*pDer)->length = (word32)tradSz;
+        }
+    #endif
+    }
+    else {
+        ret = WOLFSSL_BAD_FILETYPE;
+    }
+
+    if (ret != 0)
+        FreeDer(pDer);
+
+    return ret;
+}
+
+
+/* Split chain into the certificate and the size prefixed chain after it */
+static int SniCertLoadChain(WOLFSSL_CTX* ctx, SniCert* sc, const byte* chain,
+                            long chainSz, int format)
+{
+    DerBuffer* part = NULL;
+    byte*      chainBuf;
+    word32     bufferSz;
+    word32     idx = 0;
+    long       used = 0;
+    long       consumed;
+    int        ret = 0;
+
+    bufferSz = (word32)chainSz + (CERT_HEADER_SZ * MAX_CHAIN_DEPTH);
+    chainBuf = (byte*)XMALLOC(bufferSz, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (chainBuf == NULL)
+        return MEMORY_E;
+
+    while (ret == 0 && used < chainSz) {
+        consumed = 0;
+        ret = SniCertDer(ctx, chain + used, chainSz - used, format, CERT_TYPE,
+                         &part, &consumed);
+        if (ret == ASN_NO_PEM_HEADER && sc->certificate != NULL) {
+            WOLFSSL_MSG("We got one good cert, so stuff at end ok");
+            ret = 0;
+            break;
+        }
+        if (ret != 0)
+            break;
+        used += consumed;
+
+        if (sc->certificate == NULL) {
+            sc->certificate = part;
+            part = NULL;
+        }
+        else if (sc->certChainCnt >= MAX_CHAIN_DEPTH ||
+                 idx + CERT_HEADER_SZ + part->length > bufferSz) {
+            WOLFSSL_MSG("   Cert Chain bigger than buffer");
+            ret = BUFFER_E;
+        }
+        else {
+            c32to24(part->length, &chainBuf[idx]);
+            idx += CERT_HEADER_SZ;
+            XMEMCPY(&chainBuf[idx], part->buffer, part->length);
+            idx += part->length;
+            sc->certChainCnt++;
+        }
+        FreeDer(&part);
+    }
+
+    if (ret == 0 && idx > 0) {
+        ret = AllocDer(&sc->certChain, idx, CERT_TYPE, ctx->heap);
+        if (ret == 0)
+            XMEMCPY(sc->certChain->buffer, chainBuf, idx);
+    }
+    XFREE(chainBuf, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+
+
+/* Set the key type and size and what it allows from the certificate, the
+ * same checks as loading the CTX certificate */
+static int SniCertSetKeyInfo(WOLFSSL_CTX* ctx, SniCert* sc, DecodedCert* cert)
+{
+    int    ret = 0;
+    word32 idx;
+
+    switch (cert->signatureOID) {
+        case CTC_SHAwECDSA:
+        case CTC_SHA256wECDSA:
+        case CTC_SHA384wECDSA:
+        case CTC_SHA512wECDSA:
+        case CTC_ED25519:
+        case CTC_ED448:
+            sc->haveECDSAsig = 1;
+            break;
+        default:
+            break;
+    }
+#ifdef WC_STRICT_SIG
+    sc->haveECC = sc->haveECDSAsig;
+#endif
+    sc->pkCurveOID = cert->pkCurveOID;
+
+    switch (cert->keyOID) {
+    #ifndef NO_RSA
+        case RSAk:
+            sc->keyType = rsa_sa_algo;
+            idx = 0;
+            ret = wc_RsaPublicKeyDecode_ex(cert->publicKey, &idx,
+                cert->pubKeySize, NULL, (word32*)&sc->keySz, NULL, NULL);
+            if (ret == 0 && !ctx->verifyNone &&
+                    (ctx->minRsaKeySz < 0 || sc->keySz < ctx->minRsaKeySz)) {
+                WOLFSSL_MSG("Certificate RSA key size too small");
+                ret = RSA_KEY_SIZE_E;
+            }
+            break;
+    #endif
+    #ifdef HAVE_ECC
+        case ECDSAk:
+            sc->keyType = ecc_dsa_sa_algo;
+            sc->keySz = wc_ecc_get_curve_size_from_id(
+                wc_ecc_get_oid(cert->pkCurveOID, NULL, NULL));
+            sc->haveStaticECC = 1;
+        #ifndef WC_STRICT_SIG
+            sc->haveECC = 1;
+        #endif
+            break;
+    #endif
+    #ifdef HAVE_ED25519
+        case ED25519k:
+            sc->keyType = ed25519_sa_algo;
+            sc->keySz = ED25519_KEY_SIZE;
+        #ifndef WC_STRICT_SIG
+            sc->haveECC = 1;
+        #endif
+            break;
+    #endif
+    #ifdef HAVE_ED448
+        case ED448k:
+            sc->keyType = ed448_sa_algo;
+            sc->keySz = ED448_KEY_SIZE;
+        #ifndef WC_STRICT_SIG
+            sc->haveECC = 1;
+        #endif
+            break;
+    #endif
+        default:
+            WOLFSSL_MSG("Unsupported SNI certificate key type");
+            ret = WOLFSSL_BAD_FILE;
+            break;
+    }
+
+    if (ret == 0 && sc->keyType != rsa_sa_algo && !ctx->verifyNone &&
+            (ctx->minEccKeySz < 0 || sc->keySz < ctx->minEccKeySz)) {
+        WOLFSSL_MSG("Certificate ECC key size error");
+        ret = ECC_KEY_SIZE_E;
+    }
+
+    (void)idx;
+
+    return ret;
+}
+
+
+/* Make a shared certificate from the chain and key */
+static int SniCertNew(WOLFSSL_CTX* ctx, const byte* chain, long chainSz,
+                      const byte* key, long keySz, int format, SniCert** pCert)
+{
+    SniCert*     sc;
+    long         used;
+    int          ret;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert = NULL;
+#else
+    DecodedCert  cert[1];
+#endif
+
+    sc = (SniCert*)XMALLOC(sizeof(SniCert), ctx->heap, DYNAMIC_TYPE_TLSX);
+    if (sc == NULL)
+        return MEMORY_E;
+    XMEMSET(sc, 0, sizeof(SniCert));
+    if (wc_InitMutex(&sc->refMutex) != 0) {
+        XFREE(sc, ctx->heap, DYNAMIC_TYPE_TLSX);
+        return BAD_MUTEX_E;
+    }
+    sc->refCount = 1;
+
+    ret = SniCertLoadChain(ctx, sc, chain, chainSz, format);
+    if (ret == 0) {
+        ret = SniCertDer(ctx, key, keySz, format, PRIVATEKEY_TYPE, &sc->key,
+                         &used);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    if (ret == 0) {
+        cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), ctx->heap,
+                                     DYNAMIC_TYPE_DCERT);
+        if (cert == NULL)
+            ret = MEMORY_E;
+    }
+#endif
+    if (ret == 0) {
+        InitDecodedCert(cert, sc->certificate->buffer,
+                        sc->certificate->length, ctx->heap);
+        ret = ParseCert(cert, CERT_TYPE, NO_VERIFY, ctx->cm);
+        if (ret == 0)
+            ret = SniCertSetKeyInfo(ctx, sc, cert);
+    #ifndef NO_CHECK_PRIVATE_KEY
+        if (ret == 0 && wc_CheckPrivateKeyCert(sc->key->buffer,
+                                               sc->key->length, cert) != 1) {
+            WOLFSSL_MSG("SNI private key does not match certificate");
+            ret = WOLFSSL_BAD_FILE;
+        }
+    #endif
+        FreeDecodedCert(cert);
+    }
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(cert, ctx->heap, DYNAMIC_TYPE_DCERT);
+#endif
+
+    if (ret != 0) {
+        SniCertFree(sc, ctx->heap);
+        return ret;
+    }
+    *pCert = sc;
+
+    return 0;
+}
+
+
+/* Check the host name and get the name to key it on, "*.example.com" is a
+ * wildcard for "example.com" */
+static int SniNameKey(const char* hostName, const char** name, word16* sz,
+                      byte* wildcard)
+{
+    size_t len;
+    size_t i;
+
+    *wildcard = 0;
+    if (hostName[0] == '*' && hostName[1] == '.') {
+        *wildcard = 1;
+        hostName += 2;
+    }
+    len = XSTRLEN(hostName);
+    if (len == 0 || len > SNI_TABLE_NAME_MAX)
+        return BAD_FUNC_ARG;
+    for (i = 0; i < len; i++) {
+        if (hostName[i] == '*')
+            return BAD_FUNC_ARG;
+    }
+
+    *name = hostName;
+    *sz   = (word16)len;
+
+    return 0;
+}
+
+
+/* Make the CTX SNI table on first use */
+static int SniTableGet(WOLFSSL_CTX* ctx, SniTable** pTable)
+{
+    SniTable* table;
+    int       ret = 0;
+
+    if (wc_LockMutex(&ctx->countMutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock CTX count mutex");
+        return BAD_MUTEX_E;
+    }
+    if (ctx->sniTable == NULL) {
+        table = (SniTable*)XMALLOC(sizeof(SniTable), ctx->heap,
+                                   DYNAMIC_TYPE_TLSX);
+        if (table == NULL)
+            ret = MEMORY_E;
+        else {
+            XMEMSET(table, 0, sizeof(SniTable));
+            table->rows = (SniName**)XMALLOC(sizeof(SniName*) * SNI_TABLE_SIZE,
+                                             ctx->heap, DYNAMIC_TYPE_TLSX);
+            if (table->rows == NULL)
+                ret = MEMORY_E;
+            else if (wc_InitRwLock(&table->lock) != 0)
+                ret = BAD_MUTEX_E;
+            if (ret == 0) {
+                XMEMSET(table->rows, 0, sizeof(SniName*) * SNI_TABLE_SIZE);
+                table->rowsSz = SNI_TABLE_SIZE;
+                ctx->sniTable = table;
+            }
+            else {
+                XFREE(table->rows, ctx->heap, DYNAMIC_TYPE_TLSX);
+                XFREE(table, ctx->heap, DYNAMIC_TYPE_TLSX);
+            }
+        }
+    }
+    *pTable = ctx->sniTable;
+    wc_UnLockMutex(&ctx->countMutex);
+
+    return ret;
+}
+
+/* Get the CTX SNI table, NULL until the first certificate is added. Read
+ * under the count mutex SniTableGet() publishes it under. */
+int SNI_GetTable(WOLFSSL_CTX* ctx, SniTable** pTable)
+{
+    if (wc_LockMutex(&ctx->countMutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock CTX count mutex");
+        return BAD_MUTEX_E;
+    }
+    *pTable = ctx->sniTable;
+    wc_UnLockMutex(&ctx->countMutex);
+
+    return 0;
+}
+
+
+/* Add or replace the server certificate, chain and key used when the client
+ * asks for hostName with SNI. hostName may be a "*.example.com" wildcard.
+ * Connections that already picked a replaced certificate keep it.
+ * Returns WOLFSSL_SUCCESS on ok */
+int wolfSSL_CTX_SNI_AddCert_buffer(WOLFSSL_CTX* ctx, const char* hostName,
+                                   const byte* chain, long chainSz,
+                                   const byte* key, long keySz, int format)
+{
+    SniTable*   table = NULL;
+    SniCert*    cert = NULL;
+    SniCert*    old = NULL;
+    SniName*    entry = NULL;
+    SniName**   link;
+    const char* name;
+    word16      nameSz;
+    word32      hash;
+    byte        wildcard;
+    int         ret;
+    word16      i;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_SNI_AddCert_buffer");
+
+    if (ctx == NULL || hostName == NULL || chain == NULL || chainSz <= 0 ||
+                                           key == NULL || keySz <= 0)
+        return BAD_FUNC_ARG;
+
+    ret = SniNameKey(hostName, &name, &nameSz, &wildcard);
+    if (ret == 0)
+        ret = SniCertNew(ctx, chain, chainSz, key, keySz, format, &cert);
+    if (ret == 0)
+        ret = SniTableGet(ctx, &table);
+    if (ret == 0) {
+        entry = (SniName*)XMALLOC(sizeof(SniName) + nameSz, ctx->heap,
+                                  DYNAMIC_TYPE_TLSX);
+        if (entry == NULL)
+            ret = MEMORY_E;
+    }
+    if (ret == 0) {
+        hash = HashSniName(name, nameSz);
+        XMEMSET(entry, 0, sizeof(SniName));
+        for (i = 0; i < nameSz; i++)
+            entry->name[i] = SniLower(name[i]);
+        entry->name[nameSz] = '\0';
+        entry->nameSz   = nameSz;
+        entry->wildcard = wildcard;
+        entry->hash     = hash;
+        entry->cert     = cert;
+
+        if (wc_LockRwLock_Wr(&table->lock) != 0) {
+            WOLFSSL_MSG("SNI table lock failed");
+            ret = BAD_MUTEX_E;
+        }
+    }
+    if (ret == 0) {
+        link = FindSniName(table, name, nameSz, wildcard, hash);
+        if (*link != NULL) {
+            /* swap in the new certificate */
+            old = (*link)->cert;
+            (*link)->cert = cert;
+        }
+        else {
+            *link = entry;
+            entry = NULL;
+            table->count++;
+            GrowSniTable(table, ctx->heap);
+        }
+        cert = NULL;
+        wc_UnLockRwLock(&table->lock);
+    }
+
+    XFREE(entry, ctx->heap, DYNAMIC_TYPE_TLSX);
+    SniCertFree(cert, ctx->heap);
+    SniCertFree(old, ctx->heap);
+
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+    WOLFSSL_LEAVE("wolfSSL_CTX_SNI_AddCert_buffer", ret);
+
+    return ret;
+}
+
+
+/* Remove the certificate for hostName, as added. Connections that already
+ * picked it keep it. Returns WOLFSSL_SUCCESS on ok and WOLFSSL_FAILURE when
+ * there is no such name */
+int wolfSSL_CTX_SNI_RemoveCert(WOLFSSL_CTX* ctx, const char* hostName)
+{
+    SniTable*   table;
+    SniName*    entry = NULL;
+    SniName**   link;
+    const char* name;
+    word16      nameSz;
+    byte        wildcard;
+    int         ret;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_SNI_RemoveCert");
+
+    if (ctx == NULL || hostName == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = SniNameKey(hostName, &name, &nameSz, &wildcard);
+    if (ret != 0)
+        return ret;
+
+    ret = SNI_GetTable(ctx, &table);
+    if (ret != 0)
+        return ret;
+    if (table == NULL)
+        return WOLFSSL_FAILURE;
+
+    if (wc_LockRwLock_Wr(&table->lock) != 0) {
+        WOLFSSL_MSG("SNI table lock failed");
+        return BAD_MUTEX_E;
+    }
+    link = FindSniName(table, name, nameSz, wildcard,
+                       HashSniName(name, nameSz));
+    if (*link != NULL) {
+        entry = *link;
+        *link = entry->next;
+        table->count--;
+    }
+    wc_UnLockRwLock(&table->lock);
+
+    if (entry == NULL)
+        return WOLFSSL_FAILURE;
+    SniCertFree(entry->cert, ctx->heap);
+    XFREE(entry, ctx->heap, DYNAMIC_TYPE_TLSX);
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_SNI_RemoveCert", WOLFSSL_SUCCESS);
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Suites depend on the key, reset them after changing it */
+static void SniResetSuites(WOLFSSL* ssl)
+{
+    word16 havePSK = 0;
+    word16 haveRSA = 0;
+
+#ifndef NO_PSK
+    havePSK = ssl->options.havePSK;
+#endif
+#ifndef NO_RSA
+    haveRSA = 1;
+#endif
+
+    InitSuites(ssl->suites, ssl->version, ssl->buffers.keySz, haveRSA,
+               havePSK, ssl->options.haveDH, ssl->options.haveNTRU,
+               ssl->options.haveECDSAsig, ssl->options.haveECC,
+               ssl->options.haveStaticECC, ssl->options.side);
+}
+
+
+/* Drop the certificate picked by SNI. With restore the CTX certificate is
+ * put back for the next handshake. */
+void SNI_ReleaseCert(WOLFSSL* ssl, int restore)
+{
+    SniCert* cert = ssl->sniCert;
+
+    if (cert == NULL)
+        return;
+    ssl->sniCert = NULL;
+
+    if (restore) {
+        ssl->buffers.certificate = ssl->ctx->certificate;
+        ssl->buffers.certChain   = ssl->ctx->certChain;
+    #ifdef WOLFSSL_TLS13
+        ssl->buffers.certChainCnt = ssl->ctx->certChainCnt;
+    #endif
+        ssl->buffers.key      = ssl->ctx->privateKey;
+        ssl->buffers.keyType  = ssl->ctx->privateKeyType;
+        ssl->buffers.keyId    = ssl->ctx->privateKeyId;
+        ssl->buffers.keyLabel = ssl->ctx->privateKeyLabel;
+        ssl->buffers.keySz    = ssl->ctx->privateKeySz;
+        ssl->buffers.keyDevId = ssl->ctx->privateKeyDevId;
+        ssl->options.haveECDSAsig  = ssl->ctx->haveECDSAsig;
+        ssl->options.haveECC       = ssl->ctx->haveECC;
+        ssl->options.haveStaticECC = ssl->ctx->haveStaticECC;
+    #if defined(HAVE_ECC) || defined(HAVE_ED25519) || defined(HAVE_ED448)
+        ssl->pkCurveOID = ssl->ctx->pkCurveOID;
+    #endif
+        if (ssl->suites != NULL)
+            SniResetSuites(ssl);
+    }
+
+    /* the CTX may be gone when freeing, the WOLFSSL shares its heap */
+    SniCertFree(cert, ssl->heap);
+}
+
+
+/* Use the certificate in the CTX SNI table for the name the client asked
+ * for, an exact name first and then a wildcard for its parent domain.
+ * Returns 1 when one was found, 0 when not, or a negative error */
+int SNI_SelectCert(WOLFSSL* ssl, const byte* name, word16 sz)
+{
+    SniTable*   table;
+    SniName*    entry;
+    SniCert*    cert = NULL;
+    const char* host = (const char*)name;
+    word16      i;
+    int         ret;
+
+    if (sz == 0)
+        return 0;
+    ret = SNI_GetTable(ssl->ctx, &table);
+    if (ret != 0)
+        return ret;
+    if (table == NULL)
+        return 0;
+
+    if (wc_LockRwLock_Rd(&table->lock) != 0) {
+        WOLFSSL_MSG("SNI table lock failed");
+        return BAD_MUTEX_E;
+    }
+    entry = *FindSniName(table, host, sz, 0, HashSniName(host, sz));
+    if (entry == NULL) {
+        /* "*.example.com" matches one label in front of example.com */
+        i = 0;
+        while (i < sz && host[i] != '.')
+            i++;
+        if (i > 0 && i + 1 < sz) {
+            entry = *FindSniName(table, host + i + 1, (word16)(sz - i - 1), 1,
+                                 HashSniName(host + i + 1,
+                                             (word16)(sz - i - 1)));
+        }
+    }
+    if (entry != NULL) {
+        cert = entry->cert;
+        if (wc_LockMutex(&cert->refMutex) == 0) {
+            cert->refCount++;
+            wc_UnLockMutex(&cert->refMutex);
+        }
+        else
+            cert = NULL;
+    }
+    wc_UnLockRwLock(&table->lock);
+
+    if (cert == NULL)
+        return (entry == NULL) ? 0 : BAD_MUTEX_E;
+
+    WOLFSSL_MSG("Using certificate from SNI table");
+    SNI_ReleaseCert(ssl, 0);
+
+    /* drop anything set on the WOLFSSL itself */
+    if (ssl->buffers.weOwnCert) {
+        FreeDer(&ssl->buffers.certificate);
+    #ifdef KEEP_OUR_CERT
+        wolfSSL_X509_free(ssl->ourCert);
+        ssl->ourCert = NULL;
+    #endif
+        ssl->buffers.weOwnCert = 0;
+    }
+    if (ssl->buffers.weOwnCertChain) {
+        FreeDer(&ssl->buffers.certChain);
+        ssl->buffers.weOwnCertChain = 0;
+    }
+    if (ssl->buffers.weOwnKey) {
+        FreeDer(&ssl->buffers.key);
+        ssl->buffers.weOwnKey = 0;
+    }
+
+    ssl->sniCert = cert;
+    ssl->buffers.certificate = cert->certificate;
+    ssl->buffers.certChain   = cert->certChain;
+#ifdef WOLFSSL_TLS13
+    ssl->buffers.certChainCnt = cert->certChainCnt;
+#endif
+    ssl->buffers.key      = cert->key;
+    ssl->buffers.keyType  = cert->keyType;
+    ssl->buffers.keyId    = 0;
+    ssl->buffers.keyLabel = 0;
+    ssl->buffers.keySz    = cert->keySz;
+    ssl->buffers.keyDevId = INVALID_DEVID;
+    ssl->options.haveECDSAsig  = cert->haveECDSAsig;
+    ssl->options.haveECC       = cert->haveECC;
+    ssl->options.haveStaticECC = cert->haveStaticECC;
+#if defined(HAVE_ECC) || defined(HAVE_ED25519) || defined(HAVE_ED448)
+    ssl->pkCurveOID = cert->pkCurveOID;
+#endif
+    if (ssl->suites != NULL)
+        SniResetSuites(ssl);
+
+    return 1;
+}
+
+#endif /* WOLFSSL_SNI_TABLE */
+
 #endif /* NO_WOLFSSL_SERVER */
 
 #endif /* HAVE_SNI */
@@ -3668,6 +4498,84 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CTX_GetCertManager(WOLFSSL_CTX* ctx)
     return cm;
 }
 
+/* Allocate empty CA tables with rows, return 0 on success */
+static int InitCATables(WOLFSSL_CERT_MANAGER* cm, word32 rows, void* heap)
+{
+    cm->caTable = (Signer**)XMALLOC(sizeof(Signer*) * rows, heap,
+                                    DYNAMIC_TYPE_CERT_MANAGER);
+    if (cm->caTable == NULL)
+        return MEMORY_E;
+    XMEMSET(cm->caTable, 0, sizeof(Signer*) * rows);
+#ifndef NO_SKID
+    cm->caNameTable = (Signer**)XMALLOC(sizeof(Signer*) * rows, heap,
+                                        DYNAMIC_TYPE_CERT_MANAGER);
+    if (cm->caNameTable == NULL) {
+        XFREE(cm->caTable, heap, DYNAMIC_TYPE_CERT_MANAGER);
+        cm->caTable = NULL;
+        return MEMORY_E;
+    }
+    XMEMSET(cm->caNameTable, 0, sizeof(Signer*) * rows);
+#endif
+    cm->caTableSz = rows;
+    cm->caCount   = 0;
+
+    (void)heap;
+
+    return 0;
+}
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+static int  DecodeLazySigner(WOLFSSL_CERT_MANAGER* cm, Signer* signer);
+static void DecodeLazySigners(WOLFSSL_CERT_MANAGER* cm);
+#endif
+
+
+#ifdef WOLFSSL_TRUST_STORE
+/* Release a trust store's memory, no signers may still point into it */
+static void FreeTrustStore(TrustStore* store, void* heap)
+{
+#ifdef WOLFSSL_TRUST_STORE_MMAP
+    if (store->mapped)
+        munmap((void*)store->mem, store->sz);
+    else
+#endif
+    if (store->owned)
+        XFREE((void*)store->mem, heap, DYNAMIC_TYPE_CERT);
+    XFREE(store, heap, DYNAMIC_TYPE_CERT_MANAGER);
+
+    (void)heap;
+}
+
+
+/* Release all attached trust stores, have write lock or last reference */
+static void FreeTrustStores(WOLFSSL_CERT_MANAGER* cm)
+{
+    while (cm->trustStores != NULL) {
+        TrustStore* next = cm->trustStores->next;
+        FreeTrustStore(cm->trustStores, cm->heap);
+        cm->trustStores = next;
+    }
+}
+#endif /* WOLFSSL_TRUST_STORE */
+
+
+/* Free all CA signers but keep the table rows, have write lock */
+static void ClearCATables(WOLFSSL_CERT_MANAGER* cm)
+{
+    FreeSignerTable(cm->caTable, (int)cm->caTableSz, cm->heap);
+#ifndef NO_SKID
+    XMEMSET(cm->caNameTable, 0, sizeof(Signer*) * cm->caTableSz);
+#endif
+    cm->caCount = 0;
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    FreeSignerTable(&cm->caRetired, 1, cm->heap);
+#endif
+#ifdef WOLFSSL_TRUST_STORE
+    FreeTrustStores(cm);
+#endif
+}
+
+
 WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
 {
     WOLFSSL_CERT_MANAGER* cm;
@@ -3680,7 +4588,7 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
         XMEMSET(cm, 0, sizeof(WOLFSSL_CERT_MANAGER));
         cm->refCount = 1;
 
-        if (wc_InitMutex(&cm->caLock) != 0) {
+        if (wc_InitRwLock(&cm->caLock) != 0) {
             WOLFSSL_MSG("Bad mutex init");
             wolfSSL_CertManagerFree(cm);
             return NULL;
@@ -3699,12 +4607,21 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
         }
         #endif
 
+        if (InitCATables(cm, CA_TABLE_SIZE, heap) != 0) {
+            WOLFSSL_MSG("CA table alloc failed");
+            wolfSSL_CertManagerFree(cm);
+            return NULL;
+        }
+
         /* set default minimum key size allowed */
         #ifndef NO_RSA
             cm->minRsaKeySz = MIN_RSAKEY_SZ;
         #endif
         #ifdef HAVE_ECC
             cm->minEccKeySz = MIN_ECCKEY_SZ;
+        #endif
+        #ifdef HAVE_OCSP
+            cm->ocspCacheSz = OCSP_CACHE_SIZE;
         #endif
             cm->heap = heap;
     }
@@ -3748,8 +4665,19 @@ void wolfSSL_CertManagerFree(WOLFSSL_CERT_MANAGER* cm)
                     FreeOCSP(cm->ocsp_stapling, 1);
             #endif
             #endif
-            FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
-            wc_FreeMutex(&cm->caLock);
+            if (cm->caTable != NULL)
+                FreeSignerTable(cm->caTable, (int)cm->caTableSz, cm->heap);
+            XFREE(cm->caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        #ifndef NO_SKID
+            XFREE(cm->caNameTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        #endif
+        #ifdef WOLFSSL_LAZY_CA_LOAD
+            FreeSignerTable(&cm->caRetired, 1, cm->heap);
+        #endif
+        #ifdef WOLFSSL_TRUST_STORE
+            FreeTrustStores(cm);
+        #endif
+            wc_FreeRwLock(&cm->caLock);
 
             #ifdef WOLFSSL_TRUST_PEER_CERT
             FreeTrustedPeerTable(cm->tpTable, TP_TABLE_SIZE, cm->heap);
@@ -3806,11 +4734,15 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
         return NULL;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    DecodeLazySigners(cm);
+#endif
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
         goto error_init;
     }
 
-    for (row = 0; row < CA_TABLE_SIZE; row++) {
+    for (row = 0; row < cm->caTableSz; row++) {
         signers = cm->caTable[row];
         while (signers && signers->derCert && signers->derCert->buffer) {
 
@@ -3861,7 +4793,7 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
             dCert = NULL;
         }
     }
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     if (!found) {
        goto error_init;
@@ -3870,7 +4802,7 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
     return sk;
 
 error:
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
 error_init:
 
@@ -3983,12 +4915,12 @@ int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm)
     if (cm == NULL)
         return BAD_FUNC_ARG;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0)
         return BAD_MUTEX_E;
 
-    FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    ClearCATables(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
 
     return WOLFSSL_SUCCESS;
@@ -4282,45 +5214,165 @@ static WC_INLINE word32 MakeWordFromHash(const byte* hashID)
 #ifndef NO_CERTS
 
 /* hash is the SHA digest of name, just use first 32 bits as hash */
-static WC_INLINE word32 HashSigner(const byte* hash)
+static WC_INLINE word32 HashSigner(const byte* hash, word32 rows)
 {
-    return MakeWordFromHash(hash) % CA_TABLE_SIZE;
+    return MakeWordFromHash(hash) % rows;
 }
 
 
-/* does CA already exist on signer list */
-int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
+/* hash the CA table is keyed on */
+static WC_INLINE const byte* SignerKeyHash(const Signer* signer)
 {
-    Signer* signers;
-    int     ret = 0;
-    word32  row;
+#ifndef NO_SKID
+    return signer->subjectKeyIdHash;
+#else
+    return signer->subjectNameHash;
+#endif
+}
 
-    if (cm == NULL || hash == NULL) {
-        return ret;
+
+/* Grow the CA tables once the average row is over CA_TABLE_LOAD, have write
+ * lock. Rows are only a speed up, so failing to grow is not an error. */
+static void GrowCATables(WOLFSSL_CERT_MANAGER* cm)
+{
+    Signer** table;
+#ifndef NO_SKID
+    Signer** nameTable;
+#endif
+    Signer*  signer;
+    Signer*  next;
+    word32   rows;
+    word32   i, row;
+
+    if (cm->caCount <= cm->caTableSz * CA_TABLE_LOAD ||
+            cm->caTableSz >= CA_TABLE_MAX_SIZE) {
+        return;
     }
+    rows = cm->caTableSz * 2 + 1;
 
-    row = HashSigner(hash);
+    table = (Signer**)XMALLOC(sizeof(Signer*) * rows, cm->heap,
+                              DYNAMIC_TYPE_CERT_MANAGER);
+    if (table == NULL)
+        return;
+    XMEMSET(table, 0, sizeof(Signer*) * rows);
+#ifndef NO_SKID
+    nameTable = (Signer**)XMALLOC(sizeof(Signer*) * rows, cm->heap,
+                                  DYNAMIC_TYPE_CERT_MANAGER);
+    if (nameTable == NULL) {
+        XFREE(table, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        return;
+    }
+    XMEMSET(nameTable, 0, sizeof(Signer*) * rows);
+#endif
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        return ret;
+    /* every signer is on the key id table, rebuild both indexes from it */
+    for (i = 0; i < cm->caTableSz; i++) {
+        for (signer = cm->caTable[i]; signer != NULL; signer = next) {
+            next = signer->next;
+
+            row = HashSigner(SignerKeyHash(signer), rows);
+            signer->next = table[row];
+            table[row] = signer;
+        #ifndef NO_SKID
+            row = HashSigner(signer->subjectNameHash, rows);
+            signer->nameNext = nameTable[row];
+            nameTable[row] = signer;
+        #endif
+        }
     }
-    signers = cm->caTable[row];
-    while (signers) {
-        byte* subjectHash;
 
-    #ifndef NO_SKID
-        subjectHash = signers->subjectKeyIdHash;
-    #else
-        subjectHash = signers->subjectNameHash;
-    #endif
+    XFREE(cm->caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->caTable = table;
+#ifndef NO_SKID
+    XFREE(cm->caNameTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->caNameTable = nameTable;
+#endif
+    cm->caTableSz = rows;
+}
 
-        if (XMEMCMP(hash, subjectHash, SIGNER_DIGEST_SIZE) == 0) {
-            ret = 1; /* success */
+
+/* return CA with key id hash if on the CA table, have lock */
+static Signer* FindCA(WOLFSSL_CERT_MANAGER* cm, const byte* hash)
+{
+    Signer* signers = cm->caTable[HashSigner(hash, cm->caTableSz)];
+
+    while (signers) {
+        if (XMEMCMP(hash, SignerKeyHash(signers), SIGNER_DIGEST_SIZE) == 0)
             break;
-        }
         signers = signers->next;
     }
-    wc_UnLockMutex(&cm->caLock);
+
+    return signers;
+}
+
+
+/* Add signer to the CA tables, takes ownership, have write lock.
+ * Returns the key id table row used. */
+static word32 AddSignerToCATables(WOLFSSL_CERT_MANAGER* cm, Signer* signer)
+{
+    word32 row;
+
+#ifndef NO_SKID
+    row = HashSigner(signer->subjectNameHash, cm->caTableSz);
+    signer->nameNext = cm->caNameTable[row];
+    cm->caNameTable[row] = signer;
+#endif
+    row = HashSigner(SignerKeyHash(signer), cm->caTableSz);
+    signer->next = cm->caTable[row];
+    cm->caTable[row] = signer;
+    cm->caCount++;
+
+    GrowCATables(cm);
+
+    return row;
+}
+
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+/* Move a signer from the CA tables to the retired list, have write lock.
+ * Lookups may still hold it so it is only freed with the tables. */
+static void RetireSigner(WOLFSSL_CERT_MANAGER* cm, Signer* signer)
+{
+    Signer** prev;
+
+    prev = &cm->caTable[HashSigner(SignerKeyHash(signer), cm->caTableSz)];
+    while (*prev != NULL && *prev != signer)
+        prev = &(*prev)->next;
+    if (*prev != NULL)
+        *prev = signer->next;
+#ifndef NO_SKID
+    prev = &cm->caNameTable[HashSigner(signer->subjectNameHash,
+                                       cm->caTableSz)];
+    while (*prev != NULL && *prev != signer)
+        prev = &(*prev)->nameNext;
+    if (*prev != NULL)
+        *prev = signer->nameNext;
+    signer->nameNext = NULL;
+#endif
+    cm->caCount--;
+
+    signer->lazyRetired = 1;
+    signer->next = cm->caRetired;
+    cm->caRetired = signer;
+}
+#endif /* WOLFSSL_LAZY_CA_LOAD */
+
+
+/* does CA already exist on signer list */
+int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
+{
+    int     ret = 0;
+
+    if (cm == NULL || hash == NULL) {
+        return ret;
+    }
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        return ret;
+    }
+    if (FindCA(cm, hash) != NULL)
+        ret = 1; /* success */
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -4437,63 +5489,67 @@ Signer* GetCA(void* vp, byte* hash)
 {
     WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
     Signer* ret = NULL;
-    Signer* signers;
-    word32  row = 0;
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    int     lazy;
+#endif
 
     if (cm == NULL || hash == NULL)
         return NULL;
 
-    row = HashSigner(hash);
-
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
         return ret;
 
-    signers = cm->caTable[row];
-    while (signers) {
-        byte* subjectHash;
-        #ifndef NO_SKID
-            subjectHash = signers->subjectKeyIdHash;
-        #else
-            subjectHash = signers->subjectNameHash;
-        #endif
-        if (XMEMCMP(hash, subjectHash, SIGNER_DIGEST_SIZE) == 0) {
-            ret = signers;
-            break;
-        }
-        signers = signers->next;
-    }
-    wc_UnLockMutex(&cm->caLock);
+    ret = FindCA(cm, hash);
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    lazy = (ret != NULL && ret->lazyDer != NULL);
+#endif
+    wc_UnLockRwLock(&cm->caLock);
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    if (lazy && DecodeLazySigner(cm, ret) != 0)
+        ret = NULL;
+#endif
 
     return ret;
 }
 
 
 #ifndef NO_SKID
-/* return CA if found, otherwise NULL. Walk through hash table. */
+/* return CA if found, otherwise NULL. Look up on the name hash table. */
 Signer* GetCAByName(void* vp, byte* hash)
 {
     WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
     Signer* ret = NULL;
     Signer* signers;
     word32  row;
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    int     lazy;
+#endif
 
-    if (cm == NULL)
+    if (cm == NULL || hash == NULL)
         return NULL;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
         return ret;
 
-    for (row = 0; row < CA_TABLE_SIZE && ret == NULL; row++) {
-        signers = cm->caTable[row];
-        while (signers && ret == NULL) {
-            if (XMEMCMP(hash, signers->subjectNameHash,
-                        SIGNER_DIGEST_SIZE) == 0) {
-                ret = signers;
-            }
-            signers = signers->next;
+    row = HashSigner(hash, cm->caTableSz);
+    signers = cm->caNameTable[row];
+    while (signers) {
+        if (XMEMCMP(hash, signers->subjectNameHash, SIGNER_DIGEST_SIZE) == 0) {
+            ret = signers;
+            break;
         }
+        signers = signers->nameNext;
     }
-    wc_UnLockMutex(&cm->caLock);
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    lazy = (ret != NULL && ret->lazyDer != NULL);
+#endif
+    wc_UnLockRwLock(&cm->caLock);
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    if (lazy && DecodeLazySigner(cm, ret) != 0)
+        ret = NULL;
+#endif
 
     return ret;
 }
@@ -4630,48 +5686,16 @@ int AddTrustedPeer(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int verify)
 #endif /* WOLFSSL_TRUST_PEER_CERT */
 
 
-/* owns der, internal now uses too */
-/* type flag ids from user or from chain received during verify
-   don't allow chain ones to be added w/o isCA extension */
-int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
+/* Parse a CA certificate and check it may be added to the cert manager.
+ * lookupCm is used to find the CA's issuer, NULL skips the issuer. */
+static int ParseCA(WOLFSSL_CERT_MANAGER* cm, DecodedCert* cert, int type,
+                   int verify, WOLFSSL_CERT_MANAGER* lookupCm)
 {
-    int         ret;
-    Signer*     signer = NULL;
-    word32      row;
-    byte*       subjectHash;
-#ifdef WOLFSSL_SMALL_STACK
-    DecodedCert* cert = NULL;
-#else
-    DecodedCert  cert[1];
-#endif
-    DerBuffer*   der = *pDer;
-
-    WOLFSSL_MSG("Adding a CA");
-
-    if (cm == NULL) {
-        FreeDer(pDer);
-        return BAD_FUNC_ARG;
-    }
-
-#ifdef WOLFSSL_SMALL_STACK
-    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), NULL,
-                                 DYNAMIC_TYPE_DCERT);
-    if (cert == NULL) {
-        FreeDer(pDer);
-        return MEMORY_E;
-    }
-#endif
+    int ret;
 
-    InitDecodedCert(cert, der->buffer, der->length, cm->heap);
-    ret = ParseCert(cert, CA_TYPE, verify, cm);
+    ret = ParseCert(cert, CA_TYPE, verify, lookupCm);
     WOLFSSL_MSG("\tParsed new CA");
 
-#ifndef NO_SKID
-    subjectHash = cert->extSubjKeyId;
-#else
-    subjectHash = cert->subjectHash;
-#endif
-
     /* check CA key size */
     if (verify) {
         switch (cert->keyOID) {
@@ -4731,7 +5755,106 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         ret = NOT_CA_ERROR;
     }
 #endif
-    else if (ret == 0 && AlreadySigner(cm, subjectHash)) {
+
+    return ret;
+}
+
+
+/* Take over the signer parts of a parsed CA */
+static int FillSigner(Signer* signer, DecodedCert* cert, DerBuffer* der)
+{
+    int ret = 0;
+
+#ifdef WOLFSSL_SIGNER_DER_CERT
+    ret = AllocDer(&signer->derCert, der->length, der->type, NULL);
+    if (ret != 0)
+        return ret;
+    XMEMCPY(signer->derCert->buffer, der->buffer, der->length);
+#endif
+    signer->keyOID         = cert->keyOID;
+    if (cert->pubKeyStored) {
+        signer->publicKey      = cert->publicKey;
+        signer->pubKeySize     = cert->pubKeySize;
+    }
+    if (cert->subjectCNStored) {
+        signer->nameLen        = cert->subjectCNLen;
+        signer->name           = cert->subjectCN;
+    }
+    signer->pathLength     = cert->pathLength;
+    signer->maxPathLen     = cert->maxPathLen;
+    signer->pathLengthSet  = cert->pathLengthSet;
+    signer->selfSigned     = cert->selfSigned;
+#ifndef IGNORE_NAME_CONSTRAINTS
+    signer->permittedNames = cert->permittedNames;
+    signer->excludedNames  = cert->excludedNames;
+#endif
+#ifndef NO_SKID
+    XMEMCPY(signer->subjectKeyIdHash, cert->extSubjKeyId,
+            SIGNER_DIGEST_SIZE);
+#endif
+    XMEMCPY(signer->subjectNameHash, cert->subjectHash,
+            SIGNER_DIGEST_SIZE);
+#ifdef HAVE_OCSP
+    XMEMCPY(signer->subjectKeyHash, cert->subjectKeyHash,
+            KEYID_SIZE);
+#endif
+    signer->keyUsage = cert->extKeyUsageSet ? cert->extKeyUsage
+                                            : 0xFFFF;
+    cert->publicKey = 0;    /* signer owns these now */
+    cert->subjectCN = 0;
+#ifndef IGNORE_NAME_CONSTRAINTS
+    cert->permittedNames = NULL;
+    cert->excludedNames = NULL;
+#endif
+
+    (void)der;
+
+    return ret;
+}
+
+
+/* owns der, internal now uses too */
+/* type flag ids from user or from chain received during verify
+   don't allow chain ones to be added w/o isCA extension */
+int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
+{
+    int         ret;
+    Signer*     signer = NULL;
+    word32      row = 0;
+    byte*       subjectHash;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert = NULL;
+#else
+    DecodedCert  cert[1];
+#endif
+    DerBuffer*   der = *pDer;
+
+    WOLFSSL_MSG("Adding a CA");
+
+    if (cm == NULL) {
+        FreeDer(pDer);
+        return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), NULL,
+                                 DYNAMIC_TYPE_DCERT);
+    if (cert == NULL) {
+        FreeDer(pDer);
+        return MEMORY_E;
+    }
+#endif
+
+    InitDecodedCert(cert, der->buffer, der->length, cm->heap);
+    ret = ParseCA(cm, cert, type, verify, cm);
+
+#ifndef NO_SKID
+    subjectHash = cert->extSubjKeyId;
+#else
+    subjectHash = cert->subjectHash;
+#endif
+
+    if (ret == 0 && AlreadySigner(cm, subjectHash)) {
         WOLFSSL_MSG("\tAlready have this CA, not adding again");
         (void)ret;
     }
@@ -4740,61 +5863,15 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         signer = MakeSigner(cm->heap);
         if (!signer)
             ret = MEMORY_ERROR;
+        else if ((ret = FillSigner(signer, cert, der)) != 0) {
+            FreeSigner(signer, cm->heap);
+            signer = NULL;
+        }
     }
     if (ret == 0 && signer != NULL) {
-    #ifdef WOLFSSL_SIGNER_DER_CERT
-        ret = AllocDer(&signer->derCert, der->length, der->type, NULL);
-    }
-    if (ret == 0 && signer != NULL) {
-        XMEMCPY(signer->derCert->buffer, der->buffer, der->length);
-    #endif
-        signer->keyOID         = cert->keyOID;
-        if (cert->pubKeyStored) {
-            signer->publicKey      = cert->publicKey;
-            signer->pubKeySize     = cert->pubKeySize;
-        }
-        if (cert->subjectCNStored) {
-            signer->nameLen        = cert->subjectCNLen;
-            signer->name           = cert->subjectCN;
-        }
-        signer->pathLength     = cert->pathLength;
-        signer->maxPathLen     = cert->maxPathLen;
-        signer->pathLengthSet  = cert->pathLengthSet;
-        signer->selfSigned     = cert->selfSigned;
-    #ifndef IGNORE_NAME_CONSTRAINTS
-        signer->permittedNames = cert->permittedNames;
-        signer->excludedNames  = cert->excludedNames;
-    #endif
-    #ifndef NO_SKID
-        XMEMCPY(signer->subjectKeyIdHash, cert->extSubjKeyId,
-                SIGNER_DIGEST_SIZE);
-    #endif
-        XMEMCPY(signer->subjectNameHash, cert->subjectHash,
-                SIGNER_DIGEST_SIZE);
-    #ifdef HAVE_OCSP
-        XMEMCPY(signer->subjectKeyHash, cert->subjectKeyHash,
-                KEYID_SIZE);
-    #endif
-        signer->keyUsage = cert->extKeyUsageSet ? cert->extKeyUsage
-                                                : 0xFFFF;
-        signer->next    = NULL; /* If Key Usage not set, all uses valid. */
-        cert->publicKey = 0;    /* in case lock fails don't free here.   */
-        cert->subjectCN = 0;
-    #ifndef IGNORE_NAME_CONSTRAINTS
-        cert->permittedNames = NULL;
-        cert->excludedNames = NULL;
-    #endif
-
-    #ifndef NO_SKID
-        row = HashSigner(signer->subjectKeyIdHash);
-    #else
-        row = HashSigner(signer->subjectNameHash);
-    #endif
-
-        if (wc_LockMutex(&cm->caLock) == 0) {
-            signer->next = cm->caTable[row];
-            cm->caTable[row] = signer;   /* takes ownership */
-            wc_UnLockMutex(&cm->caLock);
+        if (wc_LockRwLock_Wr(&cm->caLock) == 0) {
+            row = AddSignerToCATables(cm, signer);   /* takes ownership */
+            wc_UnLockRwLock(&cm->caLock);
             if (cm->caCacheCallback)
                 cm->caCacheCallback(der->buffer, (int)der->length, type);
         }
@@ -4823,6 +5900,8 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
                 WOLFSSL_MSG("tsip_tls_RootCertVerify() succeed");
         }
     }
+#else
+    (void)row;
 #endif
     WOLFSSL_MSG("\tFreeing Parsed CA");
     FreeDecodedCert(cert);
@@ -4838,6 +5917,461 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
     return ret == 0 ? WOLFSSL_SUCCESS : ret;
 }
 
+#ifdef WOLFSSL_LAZY_CA_LOAD
+#ifndef LAZY_CA_DECODE_DEPTH
+    #define LAZY_CA_DECODE_DEPTH MAX_CHAIN_DEPTH
+#endif
+/* Lazy CAs this thread is decoding, innermost last. Looking up the issuer
+ * decodes it first, the list stops a cross signed pair from looping. */
+static THREAD_LS_T Signer* lazyDecoding[LAZY_CA_DECODE_DEPTH];
+static THREAD_LS_T int     lazyDecodingCnt = 0;
+
+/* Decode a lazily loaded CA the first time it is looked up. The certificate
+ * is parsed without the lock. Its issuer is looked up, and decoded when lazy
+ * too, so the CA inherits the issuer's path length constraint as when loaded
+ * eagerly. An issuer already being decoded by this thread is treated as not
+ * found. Returns 0 when the signer is ready, otherwise the CA has been
+ * retired from the tables. */
+static int DecodeLazySigner(WOLFSSL_CERT_MANAGER* cm, Signer* signer)
+{
+    int          ret = 0;
+    int          verify = 0;
+    int          i;
+    DerBuffer*   der = NULL;
+    WOLFSSL_CERT_MANAGER* lookupCm = NULL;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert = NULL;
+#else
+    DecodedCert  cert[1];
+#endif
+
+    for (i = 0; i < lazyDecodingCnt; i++) {
+        if (lazyDecoding[i] == signer) {
+            WOLFSSL_MSG("\tLazy CA issuer loops back, not using it");
+            return ASN_NO_SIGNER_E;
+        }
+    }
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
+        return BAD_MUTEX_E;
+    if (signer->lazyDer != NULL) {
+        /* copy, another thread may finish decoding and free it */
+        ret = AllocDer(&der, signer->lazyDer->length, CA_TYPE, cm->heap);
+        if (ret == 0) {
+            XMEMCPY(der->buffer, signer->lazyDer->buffer, der->length);
+            verify = signer->lazyVerify;
+        }
+    }
+    else if (signer->lazyRetired) {
+        ret = ASN_NO_SIGNER_E;
+    }
+    wc_UnLockRwLock(&cm->caLock);
+    if (der == NULL)
+        return ret;
+
+#ifdef WOLFSSL_SMALL_STACK
+    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), NULL,
+                                 DYNAMIC_TYPE_DCERT);
+    if (cert == NULL) {
+        FreeDer(&der);
+        return MEMORY_E;
+    }
+#endif
+
+    WOLFSSL_MSG("Decoding lazily loaded CA");
+    InitDecodedCert(cert, der->buffer, der->length, cm->heap);
+    if (lazyDecodingCnt < LAZY_CA_DECODE_DEPTH) {
+        lazyDecoding[lazyDecodingCnt++] = signer;
+        lookupCm = cm;
+    }
+    ret = ParseCA(cm, cert, WOLFSSL_USER_CA, verify, lookupCm);
+    if (lookupCm != NULL)
+        lazyDecoding[--lazyDecodingCnt] = NULL;
+    if (ret == 0 && (
+    #ifndef NO_SKID
+            XMEMCMP(cert->extSubjKeyId, signer->subjectKeyIdHash,
+                    SIGNER_DIGEST_SIZE) != 0 ||
+    #endif
+            XMEMCMP(cert->subjectHash, signer->subjectNameHash,
+                    SIGNER_DIGEST_SIZE) != 0)) {
+        WOLFSSL_MSG("\tLazy CA hashes don't match decoded CA");
+        ret = ASN_PARSE_E;
+    }
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        ret = BAD_MUTEX_E;
+    }
+    else {
+        if (signer->lazyDer != NULL) {
+            if (ret == 0)
+                ret = FillSigner(signer, cert, der);
+            FreeDer(&signer->lazyDer);
+            if (ret != 0) {
+                WOLFSSL_MSG("\tLazy CA failed to decode, retiring");
+                RetireSigner(cm, signer);
+            }
+        }
+        else {
+            /* decoded by another thread meanwhile */
+            ret = signer->lazyRetired ? ASN_NO_SIGNER_E : 0;
+        }
+        wc_UnLockRwLock(&cm->caLock);
+    }
+
+    FreeDecodedCert(cert);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(cert, NULL, DYNAMIC_TYPE_DCERT);
+#endif
+    FreeDer(&der);
+
+    return ret;
+}
+
+
+/* Decode all lazily loaded CAs, call before walking the tables for keys */
+static void DecodeLazySigners(WOLFSSL_CERT_MANAGER* cm)
+{
+    Signer* signer;
+    word32  row;
+    int     decoded;
+
+    /* decoding drops the lock and may grow the tables, rescan until a pass
+     * finds nothing left to decode */
+    do {
+        decoded = 0;
+        row = 0;
+        while (wc_LockRwLock_Rd(&cm->caLock) == 0) {
+            signer = NULL;
+            if (row < cm->caTableSz) {
+                signer = cm->caTable[row];
+                while (signer != NULL && signer->lazyDer == NULL)
+                    signer = signer->next;
+            }
+            else {
+                wc_UnLockRwLock(&cm->caLock);
+                break;
+            }
+            wc_UnLockRwLock(&cm->caLock);
+
+            if (signer == NULL)
+                row++;
+            else if (DecodeLazySigner(cm, signer) == BAD_MUTEX_E)
+                return;
+            else
+                decoded = 1;
+        }
+    } while (decoded);
+}
+#endif /* WOLFSSL_LAZY_CA_LOAD */
+
+
+#if defined(WOLFSSL_PARALLEL_CA_LOAD) || defined(WOLFSSL_LAZY_CA_LOAD)
+/* CA signers waiting to be added to the tables under one lock */
+typedef struct CABatch {
+    WOLFSSL_CERT_MANAGER* cm;
+    Signer**    signers;
+    DerBuffer** ders;                     /* for the CA cache callback */
+    int         count;
+    int         max;
+    int         lazy;                     /* only index, decode on use */
+    int         verify;
+    int         hold;                     /* grow instead of adding, the
+                                           * owner adds them in order */
+    Signer*     signersBuf[CA_LOAD_BATCH];
+    DerBuffer*  dersBuf[CA_LOAD_BATCH];
+} CABatch;
+
+
+static void InitCABatch(CABatch* batch, WOLFSSL_CERT_MANAGER* cm, int lazy,
+                        int verify)
+{
+    XMEMSET(batch, 0, sizeof(CABatch));
+    batch->cm      = cm;
+    batch->signers = batch->signersBuf;
+    batch->ders    = batch->dersBuf;
+    batch->max     = CA_LOAD_BATCH;
+    batch->lazy    = lazy;
+    batch->verify  = verify;
+}
+
+
+/* Make room for more signers on a held batch */
+static int GrowCABatch(CABatch* batch)
+{
+    void*       heap = batch->cm->heap;
+    int         max  = batch->max * 2;
+    Signer**    signers;
+    DerBuffer** ders;
+
+    signers = (Signer**)XMALLOC(sizeof(Signer*) * max, heap,
+                                DYNAMIC_TYPE_TMP_BUFFER);
+    ders = (DerBuffer**)XMALLOC(sizeof(DerBuffer*) * max, heap,
+                                DYNAMIC_TYPE_TMP_BUFFER);
+    if (signers == NULL || ders == NULL) {
+        XFREE(signers, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(ders, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return MEMORY_E;
+    }
+    XMEMCPY(signers, batch->signers, sizeof(Signer*) * batch->count);
+    XMEMCPY(ders, batch->ders, sizeof(DerBuffer*) * batch->count);
+    if (batch->signers != batch->signersBuf) {
+        XFREE(batch->signers, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(batch->ders, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    batch->signers = signers;
+    batch->ders    = ders;
+    batch->max     = max;
+
+    return 0;
+}
+
+
+/* Add the batched signers to the tables under one write lock. CAs another
+ * loader added in the meantime are dropped. */
+static int FlushCABatch(CABatch* batch)
+{
+    WOLFSSL_CERT_MANAGER* cm = batch->cm;
+    int ret = 0;
+    int i;
+
+    if (batch->count == 0)
+        return 0;
+
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("\tCA Mutex Lock failed");
+        ret = BAD_MUTEX_E;
+    }
+    else {
+        for (i = 0; i < batch->count; i++) {
+            if (FindCA(cm, SignerKeyHash(batch->signers[i])) != NULL) {
+                WOLFSSL_MSG("\tAlready have this CA, not adding again");
+                FreeSigner(batch->signers[i], cm->heap);
+                FreeDer(&batch->ders[i]);
+            }
+            else {
+                AddSignerToCATables(cm, batch->signers[i]); /* takes it */
+            }
+            batch->signers[i] = NULL;
+        }
+        wc_UnLockRwLock(&cm->caLock);
+    }
+
+    for (i = 0; i < batch->count; i++) {
+        if (batch->signers[i] != NULL) {
+            FreeSigner(batch->signers[i], cm->heap);
+            batch->signers[i] = NULL;
+        }
+        else if (ret == 0 && batch->ders[i] != NULL && cm->caCacheCallback) {
+            cm->caCacheCallback(batch->ders[i]->buffer,
+                                (int)batch->ders[i]->length, WOLFSSL_USER_CA);
+        }
+        FreeDer(&batch->ders[i]);
+    }
+    batch->count = 0;
+    if (batch->signers != batch->signersBuf) {
+        XFREE(batch->signers, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(batch->ders, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        batch->signers = batch->signersBuf;
+        batch->ders    = batch->dersBuf;
+        batch->max     = CA_LOAD_BATCH;
+    }
+
+    return ret;
+}
+
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+/* Make a lazy signer holding only the hashes and the DER. Returns ASN_NO_SKID
+ * when the quick scan can't get the hashes and the CA needs a full parse. */
+static int MakeLazySigner(CABatch* batch, DerBuffer** pDer, Signer** pSigner)
+{
+    WOLFSSL_CERT_MANAGER* cm = batch->cm;
+    DerBuffer* der = *pDer;
+    Signer*    signer;
+    byte       nameHash[KEYID_SIZE];
+    byte       keyIdHash[KEYID_SIZE];
+    int        ret;
+
+    if (GetCertSignerHashes(der->buffer, der->length, nameHash,
+                            keyIdHash) != 0)
+        return ASN_NO_SKID;
+
+#ifndef NO_SKID
+    if (AlreadySigner(cm, keyIdHash))
+#else
+    if (AlreadySigner(cm, nameHash))
+#endif
+    {
+        WOLFSSL_MSG("\tAlready have this CA, not adding again");
+        return 0;
+    }
+
+    signer = MakeSigner(cm->heap);
+    if (signer == NULL)
+        return MEMORY_ERROR;
+    XMEMCPY(signer->subjectNameHash, nameHash, SIGNER_DIGEST_SIZE);
+#ifndef NO_SKID
+    XMEMCPY(signer->subjectKeyIdHash, keyIdHash, SIGNER_DIGEST_SIZE);
+#endif
+    signer->lazyVerify = (byte)batch->verify;
+    signer->lazyDer = der;                  /* takes ownership */
+    *pDer = NULL;
+
+    /* the signer's DER is freed once decoded, copy for the cache callback */
+    if (cm->caCacheCallback) {
+        ret = AllocDer(pDer, der->length, der->type, cm->heap);
+        if (ret == 0)
+            XMEMCPY((*pDer)->buffer, der->buffer, der->length);
+        else {
+            FreeSigner(signer, cm->heap);
+            return ret;
+        }
+    }
+
+    *pSigner = signer;
+
+    return 0;
+}
+#endif /* WOLFSSL_LAZY_CA_LOAD */
+
+
+/* Parse a CA, or only index it when lazy, and queue it on the batch. Takes
+ * ownership of the DER. */
+static int QueueCA(CABatch* batch, DerBuffer** pDer)
+{
+    WOLFSSL_CERT_MANAGER* cm = batch->cm;
+    Signer*      signer = NULL;
+    int          ret = 0;
+    int          parse = 1;
+    byte*        subjectHash;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert = NULL;
+#else
+    DecodedCert  cert[1];
+#endif
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    if (batch->lazy) {
+        ret = MakeLazySigner(batch, pDer, &signer);
+        parse = (ret == ASN_NO_SKID);
+    }
+#endif
+
+    if (parse) {
+    #ifdef WOLFSSL_SMALL_STACK
+        cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), NULL,
+                                     DYNAMIC_TYPE_DCERT);
+        if (cert == NULL) {
+            FreeDer(pDer);
+            return MEMORY_E;
+        }
+    #endif
+
+        InitDecodedCert(cert, (*pDer)->buffer, (*pDer)->length, cm->heap);
+        ret = ParseCA(cm, cert, WOLFSSL_USER_CA, batch->verify, cm);
+
+    #ifndef NO_SKID
+        subjectHash = cert->extSubjKeyId;
+    #else
+        subjectHash = cert->subjectHash;
+    #endif
+
+        if (ret == 0 && AlreadySigner(cm, subjectHash)) {
+            WOLFSSL_MSG("\tAlready have this CA, not adding again");
+        }
+        else if (ret == 0) {
+            signer = MakeSigner(cm->heap);
+            if (signer == NULL)
+                ret = MEMORY_ERROR;
+            else if ((ret = FillSigner(signer, cert, *pDer)) != 0) {
+                FreeSigner(signer, cm->heap);
+                signer = NULL;
+            }
+        }
+
+        FreeDecodedCert(cert);
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(cert, NULL, DYNAMIC_TYPE_DCERT);
+    #endif
+    }
+
+    if (ret == 0 && signer != NULL) {
+        batch->signers[batch->count] = signer;
+        batch->ders[batch->count] = *pDer;
+        *pDer = NULL;
+        if (++batch->count == batch->max) {
+            if (!batch->hold || (ret = GrowCABatch(batch)) != 0)
+                ret = FlushCABatch(batch);
+        }
+    }
+    FreeDer(pDer);
+
+    return ret;
+}
+
+
+#ifdef WOLFSSL_PEM_TO_DER
+/* Queue each CA of a PEM buffer like ProcessChainBuffer, WOLFSSL_SUCCESS
+ * if at least one was good */
+static int QueueCABuffer(CABatch* batch, const byte* buff, long sz)
+{
+    long used   = 0;
+    int  ret    = 0;
+    int  gotOne = 0;
+#ifdef WOLFSSL_SMALL_STACK
+    EncryptedInfo* info = NULL;
+#else
+    EncryptedInfo  info[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    info = (EncryptedInfo*)XMALLOC(sizeof(EncryptedInfo), batch->cm->heap,
+                                   DYNAMIC_TYPE_ENCRYPTEDINFO);
+    if (info == NULL)
+        return MEMORY_E;
+#endif
+
+    while (used < sz) {
+        DerBuffer* der = NULL;
+
+        XMEMSET(info, 0, sizeof(EncryptedInfo));
+        ret = PemToDer(buff + used, sz - used, CA_TYPE, &der, batch->cm->heap,
+                       info, NULL);
+        if (ret == 0)
+            ret = QueueCA(batch, &der);
+        else
+            FreeDer(&der);
+
+        if (ret < 0) {
+            if (info->consumed > 0) { /* Made progress in file */
+                WOLFSSL_ERROR(ret);
+                WOLFSSL_MSG("CA Parse failed, with progress in file.");
+                WOLFSSL_MSG("Search for other certs in file");
+            }
+            else {
+                WOLFSSL_MSG("CA Parse failed, no progress in file.");
+                WOLFSSL_MSG("Do not continue search for other certs in file");
+                break;
+            }
+        }
+        else {
+            WOLFSSL_MSG("   Queued a CA");
+            gotOne = 1;
+        }
+        used += info->consumed;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(info, batch->cm->heap, DYNAMIC_TYPE_ENCRYPTEDINFO);
+#endif
+
+    if (gotOne)
+        return WOLFSSL_SUCCESS;
+    return ret;
+}
+#endif /* WOLFSSL_PEM_TO_DER */
+#endif /* WOLFSSL_PARALLEL_CA_LOAD || WOLFSSL_LAZY_CA_LOAD */
+
 #endif /* !NO_CERTS */
 
 
@@ -5376,10 +6910,7 @@ static int ProcessBufferTryDecode(WOLFSSL_CTX* ctx, WOLFSSL* ssl, DerBuffer* der
     return ret;
 }
 
-/* process the buffer buff, length sz, into ctx of format and type
-   used tracks bytes consumed, userChain specifies a user cert chain
-   to pass during the handshake */
-int ProcessBuffer(WOLFSSL_CTX* ctx, const unsigned char* buff,
+static int ProcessBufferInternal(WOLFSSL_CTX* ctx, const unsigned char* buff,
                          long sz, int format, int type, WOLFSSL* ssl,
                          long* used, int userChain, int verify)
 {
@@ -5945,6 +7476,24 @@ int ProcessBuffer(WOLFSSL_CTX* ctx, const unsigned char* buff,
     return WOLFSSL_SUCCESS;
 }
 
+/* process the buffer buff, length sz, into ctx of format and type
+   used tracks bytes consumed, userChain specifies a user cert chain
+   to pass during the handshake */
+int ProcessBuffer(WOLFSSL_CTX* ctx, const unsigned char* buff,
+                         long sz, int format, int type, WOLFSSL* ssl,
+                         long* used, int userChain, int verify)
+{
+    int ret;
+    int prevOwner;
+
+    MEM_STATS_PUSH(ssl != NULL ? ssl->ctx : ctx, prevOwner);
+    ret = ProcessBufferInternal(ctx, buff, sz, format, type, ssl, used,
+                                userChain, verify);
+    MEM_STATS_POP(prevOwner);
+
+    return ret;
+}
+
 
 /* CA PEM file for verification, may have multiple/chain certs to process */
 static int ProcessChainBuffer(WOLFSSL_CTX* ctx, const unsigned char* buff,
@@ -6561,6 +8110,29 @@ int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER* cm,
     return WOLFSSL_SUCCESS;
 }
 
+/* Set the maximum number of OCSP responses each checker caches, 0 for no
+ * limit. Least recently used responses are evicted beyond this. */
+int wolfSSL_CertManagerSetOCSPCacheSize(WOLFSSL_CERT_MANAGER* cm,
+                                        unsigned int sz)
+{
+    int ret = 0;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerSetOCSPCacheSize");
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    cm->ocspCacheSz = sz;
+    if (cm->ocsp != NULL)
+        ret = SetOCSPCacheSize(cm->ocsp, sz);
+#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
+                               ||  defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    if (ret == 0 && cm->ocsp_stapling != NULL)
+        ret = SetOCSPCacheSize(cm->ocsp_stapling, sz);
+#endif
+
+    return ret == 0 ? WOLFSSL_SUCCESS : ret;
+}
+
 
 int wolfSSL_EnableOCSP(WOLFSSL* ssl, int options)
 {
@@ -6664,6 +8236,15 @@ int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX* ctx, CbOCSPIO ioCb,
         return BAD_FUNC_ARG;
 }
 
+int wolfSSL_CTX_SetOCSPCacheSize(WOLFSSL_CTX* ctx, unsigned int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_SetOCSPCacheSize");
+    if (ctx)
+        return wolfSSL_CertManagerSetOCSPCacheSize(ctx->cm, sz);
+    else
+        return BAD_FUNC_ARG;
+}
+
 #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
  || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
 int wolfSSL_CTX_EnableOCSPStapling(WOLFSSL_CTX* ctx)
@@ -6701,6 +8282,63 @@ int wolfSSL_CTX_DisableOCSPMustStaple(WOLFSSL_CTX* ctx)
     else
         return BAD_FUNC_ARG;
 }
+
+#if defined(HAVE_OCSP_STAPLING_REFRESH) && !defined(NO_WOLFSSL_SERVER)
+/* Prefetch the OCSP responses of the certificate and chain loaded into ctx
+ * and keep them fresh from a background thread. Handshakes then only copy
+ * the current response and never wait on the OCSP responder. The issuers
+ * have to be loaded as CAs first. */
+int wolfSSL_CTX_EnableOCSPStaplingRefresh(WOLFSSL_CTX* ctx)
+{
+    int    ret;
+    word32 idx = 0;
+    word32 certSz;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_EnableOCSPStaplingRefresh");
+
+    if (ctx == NULL || ctx->cm == NULL)
+        return BAD_FUNC_ARG;
+    if (ctx->certificate == NULL || ctx->certificate->length == 0)
+        return NO_CERT_ERROR;
+
+    /* keep the OCSP I/O callbacks already set on an enabled manager */
+    if (!ctx->cm->ocspStaplingEnabled || ctx->cm->ocsp_stapling == NULL) {
+        ret = wolfSSL_CertManagerEnableOCSPStapling(ctx->cm);
+        if (ret != WOLFSSL_SUCCESS)
+            return ret;
+    }
+
+    ret = AddOcspStaple(ctx->cm->ocsp_stapling, ctx->certificate->buffer,
+                        ctx->certificate->length);
+
+#ifdef HAVE_CERTIFICATE_STATUS_REQUEST_V2
+    /* chain certificates are stapled with status_request_v2 multi */
+    while (ret == 0 && ctx->certChain != NULL &&
+                               idx + OPAQUE24_LEN < ctx->certChain->length) {
+        c24to32(ctx->certChain->buffer + idx, &certSz);
+        idx += OPAQUE24_LEN;
+        if (idx + certSz > ctx->certChain->length)
+            break;
+
+        /* the chain may end with a root that has no OCSP URL */
+        if (AddOcspStaple(ctx->cm->ocsp_stapling,
+                          ctx->certChain->buffer + idx, certSz) != 0) {
+            WOLFSSL_MSG("Not stapling chain certificate");
+        }
+        idx += certSz;
+    }
+#else
+    (void)idx;
+    (void)certSz;
+#endif
+
+    if (ret == 0)
+        ret = StartOcspRefresh(ctx->cm->ocsp_stapling);
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_EnableOCSPStaplingRefresh", ret);
+    return ret == 0 ? WOLFSSL_SUCCESS : ret;
+}
+#endif /* HAVE_OCSP_STAPLING_REFRESH && !NO_WOLFSSL_SERVER */
 #endif /* HAVE_CERTIFICATE_STATUS_REQUEST || HAVE_CERTIFICATE_STATUS_REQUEST_V2 */
 
 #endif /* HAVE_OCSP */
@@ -6810,6 +8448,355 @@ int ProcessFile(WOLFSSL_CTX* ctx, const char* fname, int format, int type,
     return ret;
 }
 
+#if (defined(WOLFSSL_PARALLEL_CA_LOAD) || defined(WOLFSSL_LAZY_CA_LOAD)) && \
+    defined(WOLFSSL_PEM_TO_DER)
+/* CA files shared by the loader threads */
+typedef struct CALoadFiles {
+    WOLFSSL_CERT_MANAGER* cm;
+    char**       names;
+    int*         rets;              /* load result of each file */
+    int          count;
+    int          next;              /* next file to claim */
+    int          threads;
+    int          lazy;
+    int          verify;
+    int          ret;               /* batch add failure */
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    CABatch**    held;              /* parsed files waiting for their turn */
+    CABatch      none;              /* held for a file with nothing to add */
+    int          added;             /* files added so far, in order */
+    wolfSSL_Mutex lock;
+#endif
+} CALoadFiles;
+
+
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+/* Hand over the parsed CAs of file idx and add every file whose turn has
+ * come. Files are added in listing order so the same CA wins as in the
+ * serial walk when files repeat one. Called with the load lock held. */
+static void AddCAFilesInOrder(CALoadFiles* load, int idx, CABatch* batch)
+{
+    int ret;
+
+    load->held[idx] = batch;
+    while (load->added < load->count && load->held[load->added] != NULL) {
+        batch = load->held[load->added];
+        ret = FlushCABatch(batch);
+        if (ret != 0)
+            load->ret = ret;
+        if (batch != &load->none)
+            XFREE(batch, load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        load->held[load->added++] = NULL;
+    }
+}
+#endif
+
+
+/* Claim CA files and queue them on a batch of this thread's own, the table
+ * lock is only taken to add full batches */
+static void* LoadCAFilesThread(void* args)
+{
+    CALoadFiles* load = (CALoadFiles*)args;
+    CABatch      batch[1];
+    CABatch*     fileBatch;
+    byte*        buff;
+    size_t       sz;
+    int          idx;
+    int          ret;
+
+    InitCABatch(batch, load->cm, load->lazy, load->verify);
+
+    for (;;) {
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        if (load->threads > 1 && wc_LockMutex(&load->lock) != 0)
+            break;
+    #endif
+        idx = load->next++;
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        if (load->threads > 1)
+            wc_UnLockMutex(&load->lock);
+    #endif
+        if (idx >= load->count)
+            break;
+
+        fileBatch = batch;
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        if (load->threads > 1) {
+            /* keep this file's CAs to themselves until their turn */
+            fileBatch = (CABatch*)XMALLOC(sizeof(CABatch), load->cm->heap,
+                                          DYNAMIC_TYPE_TMP_BUFFER);
+            if (fileBatch == NULL) {
+                load->rets[idx] = MEMORY_E;
+                if (wc_LockMutex(&load->lock) == 0) {
+                    AddCAFilesInOrder(load, idx, &load->none);
+                    wc_UnLockMutex(&load->lock);
+                }
+                continue;
+            }
+            InitCABatch(fileBatch, load->cm, load->lazy, load->verify);
+            fileBatch->hold = 1;
+        }
+    #endif
+
+        WOLFSSL_MSG(load->names[idx]); /* log file name */
+        buff = NULL;
+        ret = wc_FileLoad(load->names[idx], &buff, &sz, load->cm->heap);
+        if (ret != 0 || sz > MAX_WOLFSSL_FILE_SIZE)
+            ret = WOLFSSL_BAD_FILE;
+        else
+            ret = QueueCABuffer(fileBatch, buff, (long)sz);
+        XFREE(buff, load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        load->rets[idx] = ret;
+
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        if (fileBatch != batch) {
+            if (wc_LockMutex(&load->lock) == 0) {
+                AddCAFilesInOrder(load, idx, fileBatch);
+                wc_UnLockMutex(&load->lock);
+            }
+            else {
+                FlushCABatch(fileBatch);
+                XFREE(fileBatch, load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+                load->rets[idx] = BAD_MUTEX_E;
+            }
+        }
+    #endif
+    }
+
+    ret = FlushCABatch(batch);
+    if (ret != 0) {
+    #ifdef WOLFSSL_PARALLEL_CA_LOAD
+        if (load->threads > 1 && wc_LockMutex(&load->lock) == 0) {
+            load->ret = ret;
+            wc_UnLockMutex(&load->lock);
+        }
+        else
+    #endif
+            load->ret = ret;
+    }
+
+    return NULL;
+}
+
+
+/* Load count CA files, on up to CA_LOAD_THREADS threads when parallel.
+ * Returns 0 or a failure adding CAs, per file results are in rets. */
+static int LoadCAFiles(CALoadFiles* load, char** names, int* rets, int count,
+                       word32 flags)
+{
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    pthread_t tid[CA_LOAD_THREADS];
+    int       i;
+    int       started = 0;
+#endif
+
+    load->names   = names;
+    load->rets    = rets;
+    load->count   = count;
+    load->next    = 0;
+    load->threads = 1;
+    load->ret     = 0;
+
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    load->added = 0;
+    load->held  = NULL;
+    if ((flags & WOLFSSL_LOAD_FLAG_PARALLEL) && count > 1) {
+        load->held = (CABatch**)XMALLOC(sizeof(CABatch*) * count,
+                                        load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    if (load->held != NULL && wc_InitMutex(&load->lock) != 0) {
+        XFREE(load->held, load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        load->held = NULL;
+    }
+    if (load->held != NULL) {
+        XMEMSET(load->held, 0, sizeof(CABatch*) * count);
+        load->threads = (count < CA_LOAD_THREADS) ? count : CA_LOAD_THREADS;
+        /* this thread is the first worker */
+        for (i = 1; i < load->threads; i++) {
+            if (pthread_create(&tid[started], NULL, LoadCAFilesThread,
+                               load) != 0) {
+                WOLFSSL_MSG("CA load thread create failed, using fewer");
+                break;
+            }
+            started++;
+        }
+    }
+#endif
+
+    LoadCAFilesThread(load);
+
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    if (load->held != NULL) {
+        for (i = 0; i < started; i++)
+            pthread_join(tid[i], NULL);
+        wc_FreeMutex(&load->lock);
+
+        /* add anything left behind by a failed lock */
+        for (i = load->added; i < count; i++) {
+            if (load->held[i] != NULL && load->held[i] != &load->none) {
+                if (FlushCABatch(load->held[i]) != 0)
+                    load->ret = BAD_MUTEX_E;
+                XFREE(load->held[i], load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            }
+        }
+        XFREE(load->held, load->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+#endif
+
+    (void)flags;
+
+    return load->ret;
+}
+
+
+/* wolfSSL_CTX_load_verify_locations_ex with WOLFSSL_LOAD_FLAG_PARALLEL or
+ * WOLFSSL_LOAD_FLAG_LAZY. The directory is listed up front so its files can be
+ * shared out to the loader threads, results are counted like the serial walk
+ * in listing order. */
+static int LoadCALocations(WOLFSSL_CTX* ctx, const char* file,
+                           const char* path, word32 flags, int verify)
+{
+    int         ret = WOLFSSL_SUCCESS;
+    CALoadFiles load;
+#ifndef NO_WOLFSSL_DIR
+    int         fileRet;
+    int         successCount = 0;
+    int         failCount = 0;
+    int         i;
+#endif
+
+    XMEMSET(&load, 0, sizeof(load));
+    load.cm     = ctx->cm;
+    load.lazy   = (flags & WOLFSSL_LOAD_FLAG_LAZY) != 0;
+    load.verify = verify;
+
+    if (file) {
+        char* names[1];
+        int   rets[1];
+
+        names[0] = (char*)file;
+        ret = LoadCAFiles(&load, names, rets, 1, flags);
+        if (ret == 0)
+            ret = rets[0];
+#ifndef NO_WOLFSSL_DIR
+        if (ret == WOLFSSL_SUCCESS)
+            successCount++;
+#endif
+    }
+
+    if (ret == WOLFSSL_SUCCESS && path) {
+#ifndef NO_WOLFSSL_DIR
+        char*  name = NULL;
+        char** names = NULL;
+        char** tmp;
+        int*   rets = NULL;
+        int    count = 0;
+        int    max = 0;
+        word32 nameSz;
+    #ifdef WOLFSSL_SMALL_STACK
+        ReadDirCtx* readCtx;
+        readCtx = (ReadDirCtx*)XMALLOC(sizeof(ReadDirCtx), ctx->heap,
+                                                       DYNAMIC_TYPE_DIRCTX);
+        if (readCtx == NULL)
+            return MEMORY_E;
+    #else
+        ReadDirCtx readCtx[1];
+    #endif
+
+        /* list each regular file in path */
+        fileRet = wc_ReadDirFirst(readCtx, path, &name);
+        while (fileRet == 0 && name) {
+            if (count == max) {
+                max = (max == 0) ? 64 : max * 2;
+                tmp = (char**)XREALLOC(names, sizeof(char*) * max, ctx->heap,
+                                       DYNAMIC_TYPE_TMP_BUFFER);
+                if (tmp == NULL) {
+                    fileRet = MEMORY_E;
+                    break;
+                }
+                names = tmp;
+            }
+            nameSz = XSTRLEN(name) + 1;
+            names[count] = (char*)XMALLOC(nameSz, ctx->heap,
+                                          DYNAMIC_TYPE_TMP_BUFFER);
+            if (names[count] == NULL) {
+                fileRet = MEMORY_E;
+                break;
+            }
+            XMEMCPY(names[count], name, nameSz);
+            count++;
+            fileRet = wc_ReadDirNext(readCtx, path, &name);
+        }
+        wc_ReadDirClose(readCtx);
+
+        if (fileRet == WC_READDIR_NOFILE && count > 0) {
+            rets = (int*)XMALLOC(sizeof(int) * count, ctx->heap,
+                                 DYNAMIC_TYPE_TMP_BUFFER);
+            if (rets == NULL)
+                fileRet = MEMORY_E;
+        }
+        if (rets != NULL) {
+            ret = LoadCAFiles(&load, names, rets, count, flags);
+            if (ret != 0)
+                fileRet = ret;
+            ret = WOLFSSL_SUCCESS;
+
+            for (i = 0; i < count; i++) {
+                ret = rets[i];
+                if (ret != WOLFSSL_SUCCESS) {
+                    /* handle flags for ignoring errors, skipping expired certs
+                       or by PEM certificate header error */
+                    if ( (flags & WOLFSSL_LOAD_FLAG_IGNORE_ERR) ||
+                        ((flags & WOLFSSL_LOAD_FLAG_PEM_CA_ONLY) &&
+                           (ret == ASN_NO_PEM_HEADER))) {
+                        /* Do not fail here if a certificate fails to load,
+                           continue to next file */
+                        ret = WOLFSSL_SUCCESS;
+                    }
+                    else {
+                        WOLFSSL_ERROR(ret);
+                        WOLFSSL_MSG("Load CA file failed, continuing");
+                        failCount++;
+                    }
+                }
+                else {
+                    successCount++;
+                }
+            }
+        }
+
+        for (i = 0; i < count; i++)
+            XFREE(names[i], ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(names, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(rets, ctx->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+        /* pass directory read failure to response code */
+        if (fileRet != WC_READDIR_NOFILE) {
+            ret = fileRet;
+        }
+        /* report failure if no files were loaded or there were failures */
+        else if (successCount == 0 || failCount > 0) {
+            /* use existing error code if exists */
+            if (ret == WOLFSSL_SUCCESS)
+                ret = WOLFSSL_FAILURE;
+        }
+        else {
+            ret = WOLFSSL_SUCCESS;
+        }
+
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(readCtx, ctx->heap, DYNAMIC_TYPE_DIRCTX);
+    #endif
+#else
+        ret = NOT_COMPILED_IN;
+#endif
+    }
+
+    return ret;
+}
+#endif /* (WOLFSSL_PARALLEL_CA_LOAD || WOLFSSL_LAZY_CA_LOAD) &&
+          WOLFSSL_PEM_TO_DER */
+
 /* loads file then loads each file in path, no c_rehash */
 int wolfSSL_CTX_load_verify_locations_ex(WOLFSSL_CTX* ctx, const char* file,
                                      const char* path, word32 flags)
@@ -6832,6 +8819,12 @@ int wolfSSL_CTX_load_verify_locations_ex(WOLFSSL_CTX* ctx, const char* file,
     if (flags & WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY)
         verify = VERIFY_SKIP_DATE;
 
+#if (defined(WOLFSSL_PARALLEL_CA_LOAD) || defined(WOLFSSL_LAZY_CA_LOAD)) && \
+    defined(WOLFSSL_PEM_TO_DER)
+    if (flags & (WOLFSSL_LOAD_FLAG_PARALLEL | WOLFSSL_LOAD_FLAG_LAZY))
+        return LoadCALocations(ctx, file, path, flags, verify);
+#endif
+
     if (file) {
         ret = ProcessFile(ctx, file, WOLFSSL_FILETYPE_PEM, CA_TYPE, NULL, 0,
                           NULL, verify);
@@ -11326,19 +13319,19 @@ long wolfSSL_CTX_set_session_cache_mode(WOLFSSL_CTX* ctx, long mode)
 #if defined(PERSIST_CERT_CACHE)
 
 
-#define WOLFSSL_CACHE_CERT_VERSION 1
+#define WOLFSSL_CACHE_CERT_VERSION 2
 
 typedef struct {
     int version;                 /* cache cert layout version id */
-    int rows;                    /* hash table rows, CA_TABLE_SIZE */
-    int columns[CA_TABLE_SIZE];  /* columns per row on list */
+    int signers;                 /* number of signers that follow */
     int signerSz;                /* sizeof Signer object */
 } CertCacheHeader;
 
 /* current cert persistence layout is:
 
    1) CertCacheHeader
-   2) caTable
+   2) caTable signers, row by row. The table size isn't stored, signers are
+      rehashed into the table on restore.
 
    update WOLFSSL_CERT_CACHE_VERSION if change layout for the following
    PERSIST_CERT_CACHE functions
@@ -11385,41 +13378,22 @@ static WC_INLINE int GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 
     sz = sizeof(CertCacheHeader);
 
-    for (i = 0; i < CA_TABLE_SIZE; i++)
+    for (i = 0; i < (int)cm->caTableSz; i++)
         sz += GetCertCacheRowMemory(cm->caTable[i]);
 
     return sz;
 }
 
 
-/* Store cert cache header columns with number of items per list, have lock */
-static WC_INLINE void SetCertHeaderColumns(WOLFSSL_CERT_MANAGER* cm, int* columns)
-{
-    int     i;
-    Signer* row;
-
-    for (i = 0; i < CA_TABLE_SIZE; i++) {
-        int count = 0;
-        row = cm->caTable[i];
-
-        while (row) {
-            ++count;
-            row = row->next;
-        }
-        columns[i] = count;
-    }
-}
-
-
-/* Restore whole cert row from memory, have lock, return bytes consumed,
+/* Restore listSz signers from memory, have lock, return bytes consumed,
    < 0 on error, have lock */
-static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
-                                 int row, int listSz, const byte* end)
+static WC_INLINE int RestoreCertSigners(WOLFSSL_CERT_MANAGER* cm,
+                                 byte* current, int listSz, const byte* end)
 {
     int idx = 0;
 
     if (listSz < 0) {
-        WOLFSSL_MSG("Row header corrupted, negative value");
+        WOLFSSL_MSG("Cache header corrupted, negative value");
         return PARSE_ERROR;
     }
 
@@ -11496,8 +13470,7 @@ static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
             idx += SIGNER_DIGEST_SIZE;
         #endif
 
-        signer->next = cm->caTable[row];
-        cm->caTable[row] = signer;
+        AddSignerToCATables(cm, signer);
 
         --listSz;
     }
@@ -11563,14 +13536,13 @@ static WC_INLINE int DoMemSaveCertCache(WOLFSSL_CERT_MANAGER* cm,
         CertCacheHeader hdr;
 
         hdr.version  = WOLFSSL_CACHE_CERT_VERSION;
-        hdr.rows     = CA_TABLE_SIZE;
-        SetCertHeaderColumns(cm, hdr.columns);
+        hdr.signers  = (int)cm->caCount;
         hdr.signerSz = (int)sizeof(Signer);
 
         XMEMCPY(mem, &hdr, sizeof(CertCacheHeader));
         current = (byte*)mem + sizeof(CertCacheHeader);
 
-        for (i = 0; i < CA_TABLE_SIZE; ++i)
+        for (i = 0; i < (int)cm->caTableSz; ++i)
             current += StoreCertRow(cm, current, i);
     }
 
@@ -11596,8 +13568,12 @@ int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm, const char* fname)
        return WOLFSSL_BAD_FILE;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    DecodeLazySigners(cm);
+#endif
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
     }
@@ -11619,7 +13595,7 @@ int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm, const char* fname)
         XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
     }
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
     XFCLOSE(file);
 
     return rc;
@@ -11690,8 +13666,12 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
 
     WOLFSSL_ENTER("CM_MemSaveCertCache");
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    DecodeLazySigners(cm);
+#endif
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
         return BAD_MUTEX_E;
     }
 
@@ -11699,7 +13679,7 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
     if (ret == WOLFSSL_SUCCESS)
         *used  = GetCertCacheMemSize(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -11709,7 +13689,7 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
 int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
 {
     int ret = WOLFSSL_SUCCESS;
-    int i;
+    int added;
     CertCacheHeader* hdr = (CertCacheHeader*)mem;
     byte*            current = (byte*)mem + sizeof(CertCacheHeader);
     byte*            end     = (byte*)mem + sz;  /* don't go over */
@@ -11722,31 +13702,26 @@ int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
     }
 
     if (hdr->version  != WOLFSSL_CACHE_CERT_VERSION ||
-        hdr->rows     != CA_TABLE_SIZE ||
         hdr->signerSz != (int)sizeof(Signer)) {
 
         WOLFSSL_MSG("Cert Cache Memory header mismatch");
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
         return BAD_MUTEX_E;
     }
 
-    FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    ClearCATables(cm);
 
-    for (i = 0; i < CA_TABLE_SIZE; ++i) {
-        int added = RestoreCertRow(cm, current, i, hdr->columns[i], end);
-        if (added < 0) {
-            WOLFSSL_MSG("RestoreCertRow error");
-            ret = added;
-            break;
-        }
-        current += added;
+    added = RestoreCertSigners(cm, current, hdr->signers, end);
+    if (added < 0) {
+        WOLFSSL_MSG("RestoreCertSigners error");
+        ret = added;
     }
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -11759,19 +13734,654 @@ int CM_GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 
     WOLFSSL_ENTER("CM_GetCertCacheMemSize");
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    DecodeLazySigners(cm);
+#endif
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
         return BAD_MUTEX_E;
     }
 
     sz = GetCertCacheMemSize(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return sz;
 }
 
 #endif /* PERSIST_CERT_CACHE */
+
+#ifdef WOLFSSL_TRUST_STORE
+
+/* Precompiled trust store layout, integers are big endian:
+
+   1) header
+      magic "wTS1" (4), version (2), signer digest size (2), key id size (2),
+      flags (2), signer count (4), total size (4)
+   2) signers, each
+      record size (4), keyOID (4), public key size (4), name size (4),
+      key usage (2), maxPathLen (1), pathLength (1), flags (1), reserved (1),
+      permitted names (2), excluded names (2),
+      subject name hash, subject key id hash, subject key hash,
+      public key, name,
+      then per name constraint: type (1), size (2), name
+
+   Loading fills in Signer objects with the key and name pointing into the
+   store, nothing is decoded. */
+#define TRUST_STORE_MAGIC         "wTS1"
+#define TRUST_STORE_VERSION       1
+#define TRUST_STORE_HDR_SZ        20
+#define TRUST_STORE_REC_SZ        26
+#define TRUST_STORE_FLAG_SKID     0x0001  /* subject key id hashes set */
+#define TRUST_STORE_FLAG_KEYHASH  0x0002  /* subject key hashes set */
+#define TRUST_STORE_REC_PATHLEN   0x01    /* pathLengthSet */
+#define TRUST_STORE_REC_SELF      0x02    /* selfSigned */
+#define TRUST_STORE_HASHES_SZ     (2 * SIGNER_DIGEST_SIZE + KEYID_SIZE)
+
+
+#ifndef IGNORE_NAME_CONSTRAINTS
+/* Return bytes needed to store name constraints, count set to entries */
+static word32 TrustStoreNamesSz(const Base_entry* names, word16* count)
+{
+    word32 sz = 0;
+
+    *count = 0;
+    for (; names != NULL; names = names->next) {
+        sz += OPAQUE8_LEN + OPAQUE16_LEN + (word32)names->nameSz;
+        (*count)++;
+    }
+
+    return sz;
+}
+
+
+/* Store name constraints, return bytes added */
+static word32 TrustStoreStoreNames(const Base_entry* names, byte* out)
+{
+    word32 idx = 0;
+
+    for (; names != NULL; names = names->next) {
+        out[idx++] = names->type;
+        c16toa((word16)names->nameSz, out + idx);
+        idx += OPAQUE16_LEN;
+        XMEMCPY(out + idx, names->name, names->nameSz);
+        idx += (word32)names->nameSz;
+    }
+
+    return idx;
+}
+
+
+/* Rebuild count name constraints, return bytes consumed or < 0 on error */
+static int TrustStoreRestoreNames(const byte* in, word32 inSz, word16 count,
+                                  Base_entry** names, void* heap)
+{
+    word32 idx = 0;
+    word16 nameSz;
+
+    while (count--) {
+        Base_entry* entry;
+
+        if (idx + OPAQUE8_LEN + OPAQUE16_LEN > inSz)
+            return BUFFER_E;
+        ato16(in + idx + OPAQUE8_LEN, &nameSz);
+        if (idx + OPAQUE8_LEN + OPAQUE16_LEN + nameSz > inSz)
+            return BUFFER_E;
+
+        entry = (Base_entry*)XMALLOC(sizeof(Base_entry), heap,
+                                     DYNAMIC_TYPE_ALTNAME);
+        if (entry == NULL)
+            return MEMORY_E;
+        entry->name = (char*)XMALLOC(nameSz, heap, DYNAMIC_TYPE_ALTNAME);
+        if (entry->name == NULL) {
+            XFREE(entry, heap, DYNAMIC_TYPE_ALTNAME);
+            return MEMORY_E;
+        }
+        entry->type = in[idx];
+        idx += OPAQUE8_LEN + OPAQUE16_LEN;
+        XMEMCPY(entry->name, in + idx, nameSz);
+        entry->nameSz = nameSz;
+        idx += nameSz;
+
+        entry->next = *names;
+        *names = entry;
+    }
+
+    (void)heap;
+
+    return (int)idx;
+}
+#endif /* !IGNORE_NAME_CONSTRAINTS */
+
+
+/* Return bytes needed to store signer */
+static word32 TrustStoreSignerSz(const Signer* signer)
+{
+    word32 sz = TRUST_STORE_REC_SZ + TRUST_STORE_HASHES_SZ +
+                signer->pubKeySize + (word32)signer->nameLen;
+#ifndef IGNORE_NAME_CONSTRAINTS
+    word16 count;
+
+    sz += TrustStoreNamesSz(signer->permittedNames, &count);
+    sz += TrustStoreNamesSz(signer->excludedNames, &count);
+#endif
+
+    return sz;
+}
+
+
+/* Return bytes needed to store all CA signers, have lock */
+static word32 GetTrustStoreSz(WOLFSSL_CERT_MANAGER* cm)
+{
+    word32  sz = TRUST_STORE_HDR_SZ;
+    word32  i;
+    Signer* signer;
+
+    for (i = 0; i < cm->caTableSz; i++) {
+        for (signer = cm->caTable[i]; signer != NULL; signer = signer->next)
+            sz += TrustStoreSignerSz(signer);
+    }
+
+    return sz;
+}
+
+
+/* Store signer record, return bytes added */
+static word32 TrustStoreStoreSigner(const Signer* signer, byte* out)
+{
+    word32 idx = OPAQUE32_LEN;
+    word16 permitted = 0, excluded = 0;
+    byte   flags = 0;
+
+#ifndef IGNORE_NAME_CONSTRAINTS
+    (void)TrustStoreNamesSz(signer->permittedNames, &permitted);
+    (void)TrustStoreNamesSz(signer->excludedNames, &excluded);
+#endif
+    if (signer->pathLengthSet)
+        flags |= TRUST_STORE_REC_PATHLEN;
+    if (signer->selfSigned)
+        flags |= TRUST_STORE_REC_SELF;
+
+    c32toa(TrustStoreSignerSz(signer), out);
+    c32toa(signer->keyOID, out + idx);              idx += OPAQUE32_LEN;
+    c32toa(signer->pubKeySize, out + idx);          idx += OPAQUE32_LEN;
+    c32toa((word32)signer->nameLen, out + idx);     idx += OPAQUE32_LEN;
+    c16toa(signer->keyUsage, out + idx);            idx += OPAQUE16_LEN;
+    out[idx++] = signer->maxPathLen;
+    out[idx++] = signer->pathLength;
+    out[idx++] = flags;
+    out[idx++] = 0;
+    c16toa(permitted, out + idx);                   idx += OPAQUE16_LEN;
+    c16toa(excluded, out + idx);                    idx += OPAQUE16_LEN;
+
+    XMEMCPY(out + idx, signer->subjectNameHash, SIGNER_DIGEST_SIZE);
+    idx += SIGNER_DIGEST_SIZE;
+#ifndef NO_SKID
+    XMEMCPY(out + idx, signer->subjectKeyIdHash, SIGNER_DIGEST_SIZE);
+#else
+    XMEMSET(out + idx, 0, SIGNER_DIGEST_SIZE);
+#endif
+    idx += SIGNER_DIGEST_SIZE;
+#ifdef HAVE_OCSP
+    XMEMCPY(out + idx, signer->subjectKeyHash, KEYID_SIZE);
+#else
+    XMEMSET(out + idx, 0, KEYID_SIZE);
+#endif
+    idx += KEYID_SIZE;
+
+    XMEMCPY(out + idx, signer->publicKey, signer->pubKeySize);
+    idx += signer->pubKeySize;
+    XMEMCPY(out + idx, signer->name, signer->nameLen);
+    idx += (word32)signer->nameLen;
+
+#ifndef IGNORE_NAME_CONSTRAINTS
+    idx += TrustStoreStoreNames(signer->permittedNames, out + idx);
+    idx += TrustStoreStoreNames(signer->excludedNames, out + idx);
+#endif
+
+    return idx;
+}
+
+
+/* Store all CA signers, have lock */
+static int DoSaveTrustStore(WOLFSSL_CERT_MANAGER* cm, byte* out, word32 sz)
+{
+    word32  idx = TRUST_STORE_HDR_SZ;
+    word32  i;
+    word16  flags = 0;
+    Signer* signer;
+
+    if (GetTrustStoreSz(cm) > sz)
+        return BUFFER_E;
+
+#ifndef NO_SKID
+    flags |= TRUST_STORE_FLAG_SKID;
+#endif
+#ifdef HAVE_OCSP
+    flags |= TRUST_STORE_FLAG_KEYHASH;
+#endif
+
+    XMEMCPY(out, TRUST_STORE_MAGIC, 4);
+    c16toa(TRUST_STORE_VERSION, out + 4);
+    c16toa(SIGNER_DIGEST_SIZE, out + 6);
+    c16toa(KEYID_SIZE, out + 8);
+    c16toa(flags, out + 10);
+    c32toa(cm->caCount, out + 12);
+
+    for (i = 0; i < cm->caTableSz; i++) {
+        for (signer = cm->caTable[i]; signer != NULL; signer = signer->next)
+            idx += TrustStoreStoreSigner(signer, out + idx);
+    }
+    c32toa(idx, out + 16);
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Make a signer from the record at in, key and name point into in.
+ * Return bytes consumed or < 0 on error. */
+static int TrustStoreRestoreSigner(const byte* in, word32 inSz,
+                                   Signer** out, void* heap)
+{
+    Signer* signer;
+    word32  recSz, nameLen, idx = OPAQUE32_LEN;
+    word16  permitted, excluded;
+    byte    flags;
+    int     ret = 0;
+
+    if (inSz < TRUST_STORE_REC_SZ + TRUST_STORE_HASHES_SZ)
+        return BUFFER_E;
+    ato32(in, &recSz);
+    if (recSz < TRUST_STORE_REC_SZ + TRUST_STORE_HASHES_SZ || recSz > inSz)
+        return BUFFER_E;
+
+    signer = MakeSigner(heap);
+    if (signer == NULL)
+        return MEMORY_E;
+    signer->trustStore = 1;
+
+    ato32(in + idx, &signer->keyOID);               idx += OPAQUE32_LEN;
+    ato32(in + idx, &signer->pubKeySize);           idx += OPAQUE32_LEN;
+    ato32(in + idx, &nameLen);                      idx += OPAQUE32_LEN;
+    ato16(in + idx, &signer->keyUsage);             idx += OPAQUE16_LEN;
+    signer->maxPathLen = in[idx++];
+    signer->pathLength = in[idx++];
+    flags = in[idx++];
+    idx++; /* reserved */
+    ato16(in + idx, &permitted);                    idx += OPAQUE16_LEN;
+    ato16(in + idx, &excluded);                     idx += OPAQUE16_LEN;
+    signer->pathLengthSet = (flags & TRUST_STORE_REC_PATHLEN) ? 1 : 0;
+    signer->selfSigned = (flags & TRUST_STORE_REC_SELF) ? 1 : 0;
+
+    XMEMCPY(signer->subjectNameHash, in + idx, SIGNER_DIGEST_SIZE);
+    idx += SIGNER_DIGEST_SIZE;
+#ifndef NO_SKID
+    XMEMCPY(signer->subjectKeyIdHash, in + idx, SIGNER_DIGEST_SIZE);
+#endif
+    idx += SIGNER_DIGEST_SIZE;
+#ifdef HAVE_OCSP
+    XMEMCPY(signer->subjectKeyHash, in + idx, KEYID_SIZE);
+#endif
+    idx += KEYID_SIZE;
+
+    if (signer->pubKeySize > recSz - idx ||
+                                nameLen > recSz - idx - signer->pubKeySize) {
+        ret = BUFFER_E;
+    }
+    if (ret == 0) {
+        signer->publicKey = in + idx;
+        idx += signer->pubKeySize;
+        signer->name = (char*)in + idx;
+        signer->nameLen = (int)nameLen;
+        idx += nameLen;
+    }
+
+#ifndef IGNORE_NAME_CONSTRAINTS
+    if (ret == 0) {
+        ret = TrustStoreRestoreNames(in + idx, recSz - idx, permitted,
+                                     &signer->permittedNames, heap);
+        if (ret >= 0) {
+            idx += (word32)ret;
+            ret = TrustStoreRestoreNames(in + idx, recSz - idx, excluded,
+                                         &signer->excludedNames, heap);
+        }
+        if (ret >= 0) {
+            idx += (word32)ret;
+            ret = 0;
+        }
+    }
+#else
+    if (ret == 0 && (permitted != 0 || excluded != 0)) {
+        WOLFSSL_MSG("Trust store has name constraints, not compiled in");
+        ret = NOT_COMPILED_IN;
+    }
+#endif
+
+    if (ret == 0 && idx != recSz)
+        ret = BUFFER_E;
+    if (ret != 0) {
+        FreeSigner(signer, heap);
+        return ret;
+    }
+
+    *out = signer;
+
+    return (int)recSz;
+}
+
+
+/* Attach store to cm, takes ownership of store */
+static int DoLoadTrustStore(WOLFSSL_CERT_MANAGER* cm, TrustStore* store)
+{
+    const byte* mem = store->mem;
+    Signer*     list = NULL;
+    Signer*     signer;
+    word32      count, total, flags, idx = TRUST_STORE_HDR_SZ;
+    word16      u16;
+    int         ret = WOLFSSL_SUCCESS;
+    int         added = 0;
+
+    if (store->sz < TRUST_STORE_HDR_SZ ||
+                            XMEMCMP(mem, TRUST_STORE_MAGIC, 4) != 0) {
+        WOLFSSL_MSG("Not a trust store");
+        ret = CACHE_MATCH_ERROR;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        ato16(mem + 10, &u16);
+        flags = u16;
+        ato32(mem + 12, &count);
+        ato32(mem + 16, &total);
+        if (total < TRUST_STORE_HDR_SZ || total > store->sz)
+            ret = BUFFER_E;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        ato16(mem + 4, &u16);
+        if (u16 != TRUST_STORE_VERSION)
+            ret = CACHE_MATCH_ERROR;
+        ato16(mem + 6, &u16);
+        if (u16 != SIGNER_DIGEST_SIZE)
+            ret = CACHE_MATCH_ERROR;
+        ato16(mem + 8, &u16);
+        if (u16 != KEYID_SIZE)
+            ret = CACHE_MATCH_ERROR;
+    #ifndef NO_SKID
+        if ((flags & TRUST_STORE_FLAG_SKID) == 0)
+            ret = CACHE_MATCH_ERROR;
+    #endif
+        if (ret != WOLFSSL_SUCCESS) {
+            WOLFSSL_MSG("Trust store built with different settings");
+        }
+    }
+    (void)flags;
+
+    while (ret == WOLFSSL_SUCCESS && count-- > 0) {
+        int used = TrustStoreRestoreSigner(mem + idx, total - idx, &signer,
+                                           cm->heap);
+        if (used < 0) {
+            WOLFSSL_MSG("Bad trust store signer record");
+            ret = used;
+            break;
+        }
+        idx += (word32)used;
+        signer->next = list;
+        list = signer;
+    }
+
+    if (ret == WOLFSSL_SUCCESS && wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr on caLock failed");
+        ret = BAD_MUTEX_E;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        while (list != NULL) {
+            signer = list;
+            list = list->next;
+            if (FindCA(cm, SignerKeyHash(signer)) != NULL) {
+                FreeSigner(signer, cm->heap);
+            }
+            else {
+                AddSignerToCATables(cm, signer);
+                added++;
+            }
+        }
+        if (added > 0) {
+            store->next = cm->trustStores;
+            cm->trustStores = store;
+        }
+        wc_UnLockRwLock(&cm->caLock);
+    }
+
+    while (list != NULL) {
+        signer = list;
+        list = list->next;
+        FreeSigner(signer, cm->heap);
+    }
+    if (added == 0)
+        FreeTrustStore(store, cm->heap);
+
+    return ret;
+}
+
+
+/* Load precompiled trust store from buffer. The signers point into buf, so
+ * it must stay valid until the CAs are unloaded or cm is freed. */
+int wolfSSL_CertManagerLoadTrustStoreBuffer(WOLFSSL_CERT_MANAGER* cm,
+                                            const unsigned char* buf, long sz)
+{
+    TrustStore* store;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerLoadTrustStoreBuffer");
+
+    if (cm == NULL || buf == NULL || sz <= 0 || (long)(word32)sz != sz)
+        return BAD_FUNC_ARG;
+
+    store = (TrustStore*)XMALLOC(sizeof(TrustStore), cm->heap,
+                                 DYNAMIC_TYPE_CERT_MANAGER);
+    if (store == NULL)
+        return MEMORY_E;
+    XMEMSET(store, 0, sizeof(TrustStore));
+    store->mem = buf;
+    store->sz  = (word32)sz;
+
+    return DoLoadTrustStore(cm, store);
+}
+
+
+/* Store all CA signers in trust store format. If buf is NULL, sz is set to
+ * the size needed and LENGTH_ONLY_E returned. */
+int wolfSSL_CertManagerSaveTrustStoreBuffer(WOLFSSL_CERT_MANAGER* cm,
+                                            unsigned char* buf, int* sz)
+{
+    int    ret;
+    word32 needed;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerSaveTrustStoreBuffer");
+
+    if (cm == NULL || sz == NULL)
+        return BAD_FUNC_ARG;
+
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    DecodeLazySigners(cm);
+#endif
+
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd on caLock failed");
+        return BAD_MUTEX_E;
+    }
+
+    needed = GetTrustStoreSz(cm);
+    if (buf == NULL)
+        ret = LENGTH_ONLY_E;
+    else if (*sz < 0 || (word32)*sz < needed)
+        ret = BUFFER_E;
+    else
+        ret = DoSaveTrustStore(cm, buf, needed);
+    *sz = (int)needed;
+
+    wc_UnLockRwLock(&cm->caLock);
+
+    return ret;
+}
+
+
+#ifndef NO_FILESYSTEM
+
+/* Load precompiled trust store file, mapped read only where supported */
+int wolfSSL_CertManagerLoadTrustStore(WOLFSSL_CERT_MANAGER* cm,
+                                      const char* fname)
+{
+    TrustStore* store;
+    int         ret = WOLFSSL_SUCCESS;
+#ifdef WOLFSSL_TRUST_STORE_MMAP
+    struct stat st;
+    void*       mem;
+    int         fd;
+#else
+    XFILE       file;
+    long        sz = 0;
+    byte*       mem = NULL;
+#endif
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerLoadTrustStore");
+
+    if (cm == NULL || fname == NULL)
+        return BAD_FUNC_ARG;
+
+    store = (TrustStore*)XMALLOC(sizeof(TrustStore), cm->heap,
+                                 DYNAMIC_TYPE_CERT_MANAGER);
+    if (store == NULL)
+        return MEMORY_E;
+    XMEMSET(store, 0, sizeof(TrustStore));
+
+#ifdef WOLFSSL_TRUST_STORE_MMAP
+    fd = open(fname, O_RDONLY);
+    if (fd < 0) {
+        WOLFSSL_MSG("Couldn't open trust store file");
+        ret = WOLFSSL_BAD_FILE;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        if (fstat(fd, &st) != 0 || st.st_size <= 0 ||
+                                (off_t)(word32)st.st_size != st.st_size) {
+            WOLFSSL_MSG("Trust store file size error");
+            ret = WOLFSSL_BAD_FILE;
+        }
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) {
+            WOLFSSL_MSG("Trust store mmap failed");
+            ret = WOLFSSL_BAD_FILE;
+        }
+        else {
+            store->mem    = (const byte*)mem;
+            store->sz     = (word32)st.st_size;
+            store->mapped = 1;
+        }
+    }
+    if (fd >= 0)
+        close(fd);
+#else
+    file = XFOPEN(fname, "rb");
+    if (file == XBADFILE) {
+        WOLFSSL_MSG("Couldn't open trust store file");
+        ret = WOLFSSL_BAD_FILE;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        if (XFSEEK(file, 0, XSEEK_END) != 0 || (sz = XFTELL(file)) <= 0 ||
+                                            sz > MAX_WOLFSSL_FILE_SIZE) {
+            WOLFSSL_MSG("Trust store file size error");
+            ret = WOLFSSL_BAD_FILE;
+        }
+        else {
+            XREWIND(file);
+            mem = (byte*)XMALLOC(sz, cm->heap, DYNAMIC_TYPE_CERT);
+            if (mem == NULL)
+                ret = MEMORY_E;
+            else if ((int)XFREAD(mem, sz, 1, file) != 1) {
+                WOLFSSL_MSG("Trust store file read error");
+                XFREE(mem, cm->heap, DYNAMIC_TYPE_CERT);
+                ret = FREAD_ERROR;
+            }
+            else {
+                store->mem   = mem;
+                store->sz    = (word32)sz;
+                store->owned = 1;
+            }
+        }
+        XFCLOSE(file);
+    }
+#endif
+
+    if (ret != WOLFSSL_SUCCESS) {
+        FreeTrustStore(store, cm->heap);
+        return ret;
+    }
+
+    return DoLoadTrustStore(cm, store);
+}
+
+
+/* Store all CA signers to a trust store file */
+int wolfSSL_CertManagerSaveTrustStore(WOLFSSL_CERT_MANAGER* cm,
+                                      const char* fname)
+{
+    XFILE file;
+    byte* mem = NULL;
+    int   sz = 0;
+    int   ret;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerSaveTrustStore");
+
+    if (cm == NULL || fname == NULL)
+        return BAD_FUNC_ARG;
+
+    /* CAs may be added between the size query and the save, retry then */
+    do {
+        XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        mem = NULL;
+        ret = wolfSSL_CertManagerSaveTrustStoreBuffer(cm, NULL, &sz);
+        if (ret != LENGTH_ONLY_E)
+            return ret;
+        mem = (byte*)XMALLOC(sz, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (mem == NULL)
+            return MEMORY_E;
+        ret = wolfSSL_CertManagerSaveTrustStoreBuffer(cm, mem, &sz);
+    } while (ret == BUFFER_E);
+
+    if (ret == WOLFSSL_SUCCESS) {
+        file = XFOPEN(fname, "wb");
+        if (file == XBADFILE) {
+            WOLFSSL_MSG("Couldn't open trust store save file");
+            ret = WOLFSSL_BAD_FILE;
+        }
+        else {
+            if ((int)XFWRITE(mem, sz, 1, file) != 1) {
+                WOLFSSL_MSG("Trust store file write failed");
+                ret = FWRITE_ERROR;
+            }
+            XFCLOSE(file);
+        }
+    }
+    XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+
+
+/* Load precompiled trust store file into the ctx cert manager */
+int wolfSSL_CTX_LoadTrustStore(WOLFSSL_CTX* ctx, const char* fname)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_LoadTrustStore");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    return wolfSSL_CertManagerLoadTrustStore(ctx->cm, fname);
+}
+
+#endif /* !NO_FILESYSTEM */
+
+#endif /* WOLFSSL_TRUST_STORE */
 #endif /* NO_CERTS */
 
 #ifdef OPENSSL_EXTRA
@@ -12398,9 +15008,7 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
     #endif /* WOLFSSL_DTLS || !WOLFSSL_NO_TLS12 || !NO_OLD_TLS */
 
 
-    /* please see note at top of README if you get an error from connect */
-    WOLFSSL_ABI
-    int wolfSSL_connect(WOLFSSL* ssl)
+    static int wolfSSL_connect_internal(WOLFSSL* ssl)
     {
     #if !(defined(WOLFSSL_NO_TLS12) && defined(NO_OLD_TLS) && defined(WOLFSSL_TLS13))
         int neededState;
@@ -12412,9 +15020,6 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
             errno = 0;
         #endif
 
-        if (ssl == NULL)
-            return BAD_FUNC_ARG;
-
     #if defined(OPENSSL_EXTRA) || defined(WOLFSSL_EITHER_SIDE)
         if (ssl->options.side == WOLFSSL_NEITHER_END) {
             ssl->error = InitSSL_Side(ssl, WOLFSSL_CLIENT_END);
@@ -12433,6 +15038,9 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
     #endif
     #endif /* OPENSSL_EXTRA || WOLFSSL_EITHER_SIDE */
 
+        HS_TIMING_START(ssl);
+        HS_ARENA_START(ssl);
+
     #if defined(WOLFSSL_NO_TLS12) && defined(NO_OLD_TLS) && defined(WOLFSSL_TLS13)
         return wolfSSL_connect_TLSv13(ssl);
     #else
@@ -12666,6 +15274,7 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
             FALL_THROUGH;
 
         case SECOND_REPLY_DONE:
+            HS_TIMING_DONE(ssl);
         #ifndef NO_HANDSHAKE_DONE_CB
             if (ssl->hsDoneCb) {
                 int cbret = ssl->hsDoneCb(ssl, ssl->hsDoneCtx);
@@ -12707,6 +15316,24 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
     #endif /* !WOLFSSL_NO_TLS12 || !NO_OLD_TLS || !WOLFSSL_TLS13 */
     }
 
+
+    /* please see note at top of README if you get an error from connect */
+    WOLFSSL_ABI
+    int wolfSSL_connect(WOLFSSL* ssl)
+    {
+        int ret;
+        int prevOwner;
+
+        if (ssl == NULL)
+            return BAD_FUNC_ARG;
+
+        MEM_STATS_PUSH(ssl->ctx, prevOwner);
+        ret = wolfSSL_connect_internal(ssl);
+        MEM_STATS_POP(prevOwner);
+
+        return ret;
+    }
+
 #endif /* NO_WOLFSSL_CLIENT */
 
 
@@ -12778,8 +15405,7 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
     }
 
 
-    WOLFSSL_ABI
-    int wolfSSL_accept(WOLFSSL* ssl)
+    static int wolfSSL_accept_internal(WOLFSSL* ssl)
     {
 #if !(defined(WOLFSSL_NO_TLS12) && defined(NO_OLD_TLS) && defined(WOLFSSL_TLS13))
         word16 havePSK = 0;
@@ -12787,9 +15413,6 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
         word16 haveMcast = 0;
 #endif
 
-        if (ssl == NULL)
-            return WOLFSSL_FATAL_ERROR;
-
     #if defined(OPENSSL_EXTRA) || defined(WOLFSSL_EITHER_SIDE)
         if (ssl->options.side == WOLFSSL_NEITHER_END) {
             WOLFSSL_MSG("Setting WOLFSSL_SSL to be server side");
@@ -12802,6 +15425,9 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
         }
     #endif /* OPENSSL_EXTRA || WOLFSSL_EITHER_SIDE */
 
+        HS_TIMING_START(ssl);
+        HS_ARENA_START(ssl);
+
 #if defined(WOLFSSL_NO_TLS12) && defined(NO_OLD_TLS) && defined(WOLFSSL_TLS13)
         return wolfSSL_accept_TLSv13(ssl);
 #else
@@ -13057,6 +15683,7 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
             FALL_THROUGH;
 
         case ACCEPT_THIRD_REPLY_DONE :
+            HS_TIMING_DONE(ssl);
 #ifndef NO_HANDSHAKE_DONE_CB
             if (ssl->hsDoneCb) {
                 int cbret = ssl->hsDoneCb(ssl, ssl->hsDoneCtx);
@@ -13107,6 +15734,23 @@ int wolfSSL_DTLS_SetCookieSecret(WOLFSSL* ssl,
 #endif /* !WOLFSSL_NO_TLS12 */
     }
 
+
+    WOLFSSL_ABI
+    int wolfSSL_accept(WOLFSSL* ssl)
+    {
+        int ret;
+        int prevOwner;
+
+        if (ssl == NULL)
+            return WOLFSSL_FATAL_ERROR;
+
+        MEM_STATS_PUSH(ssl->ctx, prevOwner);
+        ret = wolfSSL_accept_internal(ssl);
+        MEM_STATS_POP(prevOwner);
+
+        return ret;
+    }
+
 #endif /* NO_WOLFSSL_SERVER */
 
 
@@ -13128,6 +15772,162 @@ int wolfSSL_SetHsDoneCb(WOLFSSL* ssl, HandShakeDoneCb cb, void* user_ctx)
 
 #endif /* NO_HANDSHAKE_DONE_CB */
 
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+/* Get where the time of the last or current handshake went. The total is set
+ * once the handshake is done. */
+int wolfSSL_get_handshake_timing(WOLFSSL* ssl, WOLFSSL_HS_TIMING* timing)
+{
+    WOLFSSL_ENTER("wolfSSL_get_handshake_timing");
+
+    if (ssl == NULL || timing == NULL)
+        return BAD_FUNC_ARG;
+
+    XMEMCPY(timing, &ssl->hsTiming.rec, sizeof(WOLFSSL_HS_TIMING));
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Copy the CTX histogram of op over its handshakes, bucketsSz must be at
+ * least WOLFSSL_HST_BUCKETS. */
+int wolfSSL_CTX_get_handshake_histogram(WOLFSSL_CTX* ctx, int op,
+                                        word32* buckets, int bucketsSz)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_get_handshake_histogram");
+
+    if (ctx == NULL || buckets == NULL || op < 0 ||
+            op >= WOLFSSL_HST_OP_COUNT || bucketsSz < WOLFSSL_HST_BUCKETS)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&ctx->countMutex) != 0)
+        return BAD_MUTEX_E;
+    XMEMCPY(buckets, ctx->hsHist[op], sizeof(ctx->hsHist[op]));
+    wc_UnLockMutex(&ctx->countMutex);
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_CTX_reset_handshake_histogram(WOLFSSL_CTX* ctx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_reset_handshake_histogram");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&ctx->countMutex) != 0)
+        return BAD_MUTEX_E;
+    XMEMSET(ctx->hsHist, 0, sizeof(ctx->hsHist));
+    wc_UnLockMutex(&ctx->countMutex);
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_HANDSHAKE_TIMING */
+
+#ifdef WOLFSSL_PERF_COUNTERS
+/* Get the counters of the connections made with ctx. */
+int wolfSSL_CTX_get_perf_stats(WOLFSSL_CTX* ctx, WOLFSSL_PERF_STATS* stats)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_get_perf_stats");
+
+    if (ctx == NULL || stats == NULL)
+        return BAD_FUNC_ARG;
+
+    PerfGet(ctx, stats);
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_CTX_reset_perf_stats(WOLFSSL_CTX* ctx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_reset_perf_stats");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    PerfReset(ctx);
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Get the counters of all connections in the library. */
+int wolfSSL_get_perf_stats(WOLFSSL_PERF_STATS* stats)
+{
+    WOLFSSL_ENTER("wolfSSL_get_perf_stats");
+
+    if (stats == NULL)
+        return BAD_FUNC_ARG;
+
+    PerfGet(NULL, stats);
+
+    return WOLFSSL_SUCCESS;
+}
+
+int wolfSSL_reset_perf_stats(void)
+{
+    WOLFSSL_ENTER("wolfSSL_reset_perf_stats");
+
+    PerfReset(NULL);
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_PERF_COUNTERS */
+
+#ifdef WOLFSSL_MEM_TYPE_STATS
+/* Get the memory of type charged to ctx: what its connections allocated
+ * in wolfSSL_new, the handshake, read and write, and its own setup. */
+int wolfSSL_CTX_get_mem_stats(WOLFSSL_CTX* ctx, int type,
+                              WC_MEM_TYPE_STATS* stats)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_get_mem_stats");
+
+    if (ctx == NULL || stats == NULL)
+        return BAD_FUNC_ARG;
+    if (ctx->memOwner == 0)
+        return BAD_STATE_E; /* all WC_MEM_STATS_OWNERS were in use */
+
+    if (wc_MemStatsGet(ctx->memOwner, type, stats) != 0)
+        return BAD_FUNC_ARG;
+
+    return WOLFSSL_SUCCESS;
+}
+
+#if !defined(NO_FILESYSTEM) && !defined(NO_STDIO_FILESYSTEM)
+int wolfSSL_CTX_print_mem_stats(WOLFSSL_CTX* ctx)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_print_mem_stats");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+    if (ctx->memOwner == 0)
+        return BAD_STATE_E;
+
+    wc_MemStatsPrint(ctx->memOwner);
+
+    return WOLFSSL_SUCCESS;
+}
+#endif
+#endif /* WOLFSSL_MEM_TYPE_STATS */
+
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+/* Get how much of the handshake arena ssl used at most, with space freed
+ * during the handshake still counted, and how many of its handshake
+ * allocations went to the heap as they did not fit. Use to size
+ * WOLFSSL_HS_ARENA_SZ. */
+int wolfSSL_get_hs_arena_stats(WOLFSSL* ssl, word32* peak, word32* fallbacks)
+{
+    WOLFSSL_ENTER("wolfSSL_get_hs_arena_stats");
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    if (peak != NULL)
+        *peak = ssl->hsArena.peak;
+    if (fallbacks != NULL)
+        *fallbacks = ssl->hsArena.fallbacks;
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_HANDSHAKE_ARENA */
+
 WOLFSSL_ABI
 int wolfSSL_Cleanup(void)
 {
@@ -13407,6 +16207,7 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
         return NULL;
     }
 
+    WC_USDT_PROBE1(session__lookup__start, ssl);
     if (wc_LockMutex(&session_mutex) != 0)
         return 0;
 
@@ -13442,6 +16243,7 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
     }
 
     wc_UnLockMutex(&session_mutex);
+    WC_USDT_PROBE2(session__lookup__done, ssl, ret != NULL);
 
     return ret;
 }
@@ -13902,6 +16704,8 @@ int AddSession(WOLFSSL* ssl)
     if (ssl->options.internalCacheOff && cbRet == 0)
         FreeSession(session, 1);
 #endif
+    PERF_ADD(ssl, PERF_SESSION_ADD, error == 0);
+    WC_USDT_PROBE2(session__add, ssl, error);
 
     return error;
 }
@@ -14617,6 +17421,20 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         if (flags & WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY)
             verify = VERIFY_SKIP_DATE;
 
+    #if defined(WOLFSSL_LAZY_CA_LOAD) && defined(WOLFSSL_PEM_TO_DER)
+        if (format == WOLFSSL_FILETYPE_PEM && ctx != NULL &&
+                                        (flags & WOLFSSL_LOAD_FLAG_LAZY)) {
+            CABatch batch;
+            int     flushRet;
+
+            InitCABatch(&batch, ctx->cm, 1, verify);
+            ret = QueueCABuffer(&batch, in, sz);
+            flushRet = FlushCABatch(&batch);
+            if (flushRet != 0)
+                ret = flushRet;
+        }
+        else
+    #endif
         if (format == WOLFSSL_FILETYPE_PEM)
             ret = ProcessChainBuffer(ctx, in, sz, format, CA_TYPE, NULL,
                                       verify);
@@ -17842,6 +20660,9 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
 
         ssl->keys.encryptionOn = 0;
         XMEMSET(&ssl->msgsReceived, 0, sizeof(ssl->msgsReceived));
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+        XMEMSET(&ssl->hsTiming, 0, sizeof(ssl->hsTiming));
+#endif
 
         if (ssl->hsHashes != NULL) {
 #ifndef NO_OLD_TLS
@@ -17899,6 +20720,11 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
         FreeX509(&ssl->peerCert);
         InitX509(&ssl->peerCert, 0, ssl->heap);
 #endif
+#if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE) && \
+    !defined(NO_WOLFSSL_SERVER)
+        /* next handshake picks its certificate by SNI again */
+        SNI_ReleaseCert(ssl, 1);
+#endif
 
         return WOLFSSL_SUCCESS;
     }
@@ -51294,9 +54120,7 @@ int wolfSSL_i2c_ASN1_INTEGER(WOLFSSL_ASN1_INTEGER *a, unsigned char **pp)
 #ifndef NO_CERTS
 int wolfSSL_X509_CA_num(WOLFSSL_X509_STORE* store)
 {
-    int i = 0;
     int cnt_ret = 0;
-    Signer **table;
 
     WOLFSSL_ENTER("wolfSSL_X509_CA_num");
     if (store == NULL || store->cm == NULL){
@@ -51304,19 +54128,9 @@ int wolfSSL_X509_CA_num(WOLFSSL_X509_STORE* store)
         return WOLFSSL_FAILURE;
     }
 
-    table = store->cm->caTable;
-    if (table){
-        if (wc_LockMutex(&store->cm->caLock) == 0){
-            for (i = 0; i < CA_TABLE_SIZE; i++) {
-                Signer* signer = table[i];
-                while (signer) {
-                    Signer* next = signer->next;
-                    cnt_ret++;
-                    signer = next;
-                }
-            }
-            wc_UnLockMutex(&store->cm->caLock);
-        }
+    if (wc_LockRwLock_Rd(&store->cm->caLock) == 0){
+        cnt_ret = (int)store->cm->caCount;
+        wc_UnLockRwLock(&store->cm->caLock);
     }
 
     return cnt_ret;
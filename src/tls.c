@@ -1984,6 +1984,9 @@ static int TLSX_SNI_Parse(WOLFSSL* ssl, byte* input, word16 length,
     byte type;
     int matchStat;
     byte matched;
+#ifdef WOLFSSL_SNI_TABLE
+    int tableMatch = 0;
+#endif
 #endif
 
     TLSX *extension = TLSX_Find(ssl->extensions, TLSX_SERVER_NAME);
@@ -2025,6 +2028,14 @@ static int TLSX_SNI_Parse(WOLFSSL* ssl, byte* input, word16 length,
             cacheOnly = 1;
             WOLFSSL_MSG("Forcing SSL object to store SNI parameter");
         #else
+            #ifdef WOLFSSL_SNI_TABLE
+            SniTable* table = NULL;
+
+            /* keep the name a table certificate is picked for */
+            if (SNI_GetTable(ssl->ctx, &table) == 0 && table != NULL)
+                cacheOnly = 1;
+            else
+            #endif
             /* Skipping, SNI not enabled at server side. */
             return 0;
         #endif
@@ -2067,12 +2078,29 @@ static int TLSX_SNI_Parse(WOLFSSL* ssl, byte* input, word16 length,
     matched = cacheOnly || (XSTRLEN(sni->data.host_name) == size &&
          XSTRNCMP(sni->data.host_name, (const char*)input + offset, size) == 0);
 
+#ifdef WOLFSSL_SNI_TABLE
+    /* the table's certificate for the name is used over the CTX's */
+    tableMatch = SNI_SelectCert(ssl, input + offset, size);
+    if (tableMatch < 0)
+        return tableMatch;
+    if (tableMatch)
+        matched = 1;
+#endif
+
     if (matched || sni->options & WOLFSSL_SNI_ANSWER_ON_MISMATCH) {
         int r = TLSX_UseSNI(&ssl->extensions, type, input + offset, size,
                                                                      ssl->heap);
         if (r != WOLFSSL_SUCCESS)
             return r; /* throws error. */
 
+    #ifdef WOLFSSL_SNI_TABLE
+        if (tableMatch) {
+            WOLFSSL_MSG("SNI table did match!");
+            matchStat = WOLFSSL_SNI_REAL_MATCH;
+            cacheOnly = 0;
+        }
+        else
+    #endif
         if (cacheOnly) {
             WOLFSSL_MSG("Forcing storage of SNI, Fake match");
             matchStat = WOLFSSL_SNI_FORCE_KEEP;
@@ -7077,14 +7105,21 @@ end:
  */
 static int TLSX_KeyShare_GenKey(WOLFSSL *ssl, KeyShareEntry *kse)
 {
+    int ret;
+
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEYSHARE_GEN);
     /* Named FFHE groups have a bit set to identify them. */
     if ((kse->group & NAMED_DH_MASK) == NAMED_DH_MASK)
-        return TLSX_KeyShare_GenDhKey(ssl, kse);
-    if (kse->group == WOLFSSL_ECC_X25519)
-        return TLSX_KeyShare_GenX25519Key(ssl, kse);
-    if (kse->group == WOLFSSL_ECC_X448)
-        return TLSX_KeyShare_GenX448Key(ssl, kse);
-    return TLSX_KeyShare_GenEccKey(ssl, kse);
+        ret = TLSX_KeyShare_GenDhKey(ssl, kse);
+    else if (kse->group == WOLFSSL_ECC_X25519)
+        ret = TLSX_KeyShare_GenX25519Key(ssl, kse);
+    else if (kse->group == WOLFSSL_ECC_X448)
+        ret = TLSX_KeyShare_GenX448Key(ssl, kse);
+    else
+        ret = TLSX_KeyShare_GenEccKey(ssl, kse);
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEYSHARE_GEN);
+
+    return ret;
 }
 
 /* Free the key share dynamic data.
@@ -7616,6 +7651,7 @@ static int TLSX_KeyShare_Process(WOLFSSL* ssl, KeyShareEntry* keyShareEntry)
 #if defined(HAVE_SESSION_TICKET) || !defined(NO_PSK)
     ssl->session.namedGroup = (byte)keyShareEntry->group;
 #endif
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_KEY_AGREE);
     /* Use Key Share Data from server. */
     if (keyShareEntry->group & NAMED_DH_MASK)
         ret = TLSX_KeyShare_ProcessDh(ssl, keyShareEntry);
@@ -7625,6 +7661,7 @@ static int TLSX_KeyShare_Process(WOLFSSL* ssl, KeyShareEntry* keyShareEntry)
         ret = TLSX_KeyShare_ProcessX448(ssl, keyShareEntry);
     else
         ret = TLSX_KeyShare_ProcessEcc(ssl, keyShareEntry);
+    HS_TIMING_END(ssl, WOLFSSL_HST_KEY_AGREE);
 
 #ifdef WOLFSSL_DEBUG_TLS
     WOLFSSL_MSG("KE Secret");
@@ -1704,10 +1704,6 @@ static int ChaCha20Poly1305_Encrypt(WOLFSSL* ssl, byte* output,
     if (ret != 0)
         return ret;
     ret = wc_Chacha_SetIV(ssl->encrypt.chacha, nonce, 1);
-    if (ret != 0)
-        return ret;
-    /* Encrypt the plain text. */
-    ret = wc_Chacha_Process(ssl->encrypt.chacha, output, input, sz);
     if (ret != 0) {
         ForceZero(poly, sizeof(poly));
         return ret;
@@ -1718,9 +1714,10 @@ static int ChaCha20Poly1305_Encrypt(WOLFSSL* ssl, byte* output,
     ForceZero(poly, sizeof(poly)); /* done with poly1305 key, clear it */
     if (ret != 0)
         return ret;
-    /* Add authentication code of encrypted data to end. */
-    ret = wc_Poly1305_MAC(ssl->auth.poly1305, (byte*)aad, aadSz, output, sz,
-                          tag, POLY1305_AUTH_SZ);
+    /* Encrypt the plain text and add authentication code of encrypted data
+     * to end - in one pass over the data. */
+    ret = wc_ChaCha20Poly1305_Process(ssl->encrypt.chacha, ssl->auth.poly1305,
+                                      aad, aadSz, input, output, sz, 1, tag);
 
     return ret;
 }
@@ -1995,21 +1992,22 @@ static int ChaCha20Poly1305_Decrypt(WOLFSSL* ssl, byte* output,
     ForceZero(poly, sizeof(poly)); /* done with poly1305 key, clear it */
     if (ret != 0)
         return ret;
-    /* Generate authentication tag for encrypted data. */
-    if ((ret = wc_Poly1305_MAC(ssl->auth.poly1305, (byte*)aad, aadSz,
-                                    (byte*)input, sz, tag, sizeof(tag))) != 0) {
+    /* Generate authentication tag for encrypted data and decrypt - in one
+     * pass over the data. */
+    if ((ret = wc_ChaCha20Poly1305_Process(ssl->decrypt.chacha,
+                    ssl->auth.poly1305, aad, aadSz, input, output, sz, 0,
+                    tag)) != 0) {
         return ret;
     }
 
     /* Check tag sent along with packet. */
     if (ConstantCompare(tagIn, tag, POLY1305_AUTH_SZ) != 0) {
         WOLFSSL_MSG("MAC did not match");
+        /* Don't leave unauthenticated plaintext behind. */
+        ForceZero(output, sz);
         return VERIFY_MAC_ERROR;
     }
 
-    /* If the tag was good decrypt message. */
-    ret = wc_Chacha_Process(ssl->decrypt.chacha, output, input, sz);
-
     return ret;
 }
 #endif
@@ -2377,6 +2375,7 @@ int BuildTls13Message(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
 
         case BUILD_MSG_ENCRYPT:
         {
+            WC_USDT_PROBE3(record__encrypt__start, ssl, type, args->size);
         #ifdef ATOMIC_USER
             if (ssl->ctx->MacEncryptCb) {
                 /* User Record Layer Callback handling */
@@ -2394,6 +2393,8 @@ int BuildTls13Message(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                 ret = EncryptTls13(ssl, output, output, args->size, aad,
                                    RECORD_HEADER_SZ, asyncOkay);
             }
+            WC_USDT_PROBE2(record__encrypt__done, ssl, ret);
+            PERF_ADD(ssl, PERF_RECORDS_ENCRYPTED, ret == 0);
             break;
         }
     }
@@ -3517,6 +3518,11 @@ static int DoPreSharedKeys(WOLFSSL* ssl, const byte* input, word32 helloSz,
                                      diff - MAX_TICKET_AGE_SECS * 1000 > 1000) {
                 /* Invalid difference, fallback to full handshake. */
                 ssl->options.resuming = 0;
+            #ifdef WOLFSSL_PERF_COUNTERS
+                if (ssl->options.serverState !=
+                                          SERVER_HELLO_RETRY_REQUEST_COMPLETE)
+                    PERF_INC(ssl, PERF_SESSION_MISS);
+            #endif
                 /* Hash the rest of the ClientHello. */
                 return HashRaw(ssl, input + helloSz - bindersLen, bindersLen);
             }
@@ -3643,6 +3649,17 @@ static int DoPreSharedKeys(WOLFSSL* ssl, const byte* input, word32 helloSz,
     if (ret != 0)
         return ret;
 
+#ifdef WOLFSSL_PERF_COUNTERS
+    /* Session resumed from a ticket or none of the keys could be used, once
+     * per handshake and not again for the ClientHello after a retry. */
+    if (ssl->options.serverState != SERVER_HELLO_RETRY_REQUEST_COMPLETE) {
+        if (current == NULL)
+            PERF_INC(ssl, PERF_SESSION_MISS);
+        else if (ssl->options.resuming)
+            PERF_INC(ssl, PERF_SESSION_HIT);
+    }
+#endif
+
     if (current == NULL) {
 #ifdef WOLFSSL_PSK_ID_PROTECTION
     #ifndef NO_CERTS
@@ -5615,7 +5632,9 @@ static int DoTls13Certificate(WOLFSSL* ssl, byte* input, word32* inOutIdx,
     WOLFSSL_START(WC_FUNC_CERTIFICATE_DO);
     WOLFSSL_ENTER("DoTls13Certificate");
 
+    HS_TIMING_BEGIN(ssl, WOLFSSL_HST_CERT_VERIFY);
     ret = ProcessPeerCerts(ssl, input, inOutIdx, totalSz);
+    HS_TIMING_END(ssl, WOLFSSL_HST_CERT_VERIFY);
     if (ret == 0) {
 #if !defined(NO_WOLFSSL_CLIENT)
         if (ssl->options.side == WOLFSSL_CLIENT_END)
@@ -6125,6 +6144,8 @@ int DoTls13Finished(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
     if (ssl->options.side == WOLFSSL_SERVER_END) {
         ssl->options.clientState = CLIENT_FINISHED_COMPLETE;
         ssl->options.handShakeState = HANDSHAKE_DONE;
+        PERF_HANDSHAKE_DONE(ssl);
+        WC_USDT_PROBE2(handshake__done, ssl, (int)ssl->options.resuming);
         ssl->options.handShakeDone  = 1;
     }
 #endif
@@ -6261,6 +6282,8 @@ static int SendTls13Finished(WOLFSSL* ssl)
     if (ssl->options.side == WOLFSSL_CLIENT_END) {
         ssl->options.clientState = CLIENT_FINISHED_COMPLETE;
         ssl->options.handShakeState = HANDSHAKE_DONE;
+        PERF_HANDSHAKE_DONE(ssl);
+        WC_USDT_PROBE2(handshake__done, ssl, (int)ssl->options.resuming);
         ssl->options.handShakeDone  = 1;
     }
 #endif
@@ -6765,7 +6788,10 @@ static int SendTls13NewSessionTicket(WOLFSSL* ssl)
         ssl->session.ticketNonce.data[0]++;
 
     if (!ssl->options.noTicketTls13) {
-        if ((ret = CreateTicket(ssl)) != 0)
+        HS_TIMING_BEGIN(ssl, WOLFSSL_HST_TICKET_ENC);
+        ret = CreateTicket(ssl);
+        HS_TIMING_END(ssl, WOLFSSL_HST_TICKET_ENC);
+        if (ret != 0)
             return ret;
     }
 
@@ -7402,6 +7428,8 @@ int DoTls13HandShakeMsgType(WOLFSSL* ssl, byte* input, word32* inOutIdx,
     }
 #endif
 
+    HS_TIMING_MSG(ssl, type, ret);
+    WC_USDT_PROBE3(handshake__msg, ssl, type, ret);
     WOLFSSL_LEAVE("DoTls13HandShakeMsgType()", ret);
     return ret;
 }
@@ -7541,6 +7569,9 @@ int wolfSSL_connect_TLSv13(WOLFSSL* ssl)
         return WOLFSSL_FATAL_ERROR;
     }
 
+    HS_TIMING_START(ssl);
+    HS_ARENA_START(ssl);
+
     if (ssl->buffers.outputBuffer.length > 0
     #ifdef WOLFSSL_ASYNC_CRYPT
         /* do not send buffered or advance state if last error was an
@@ -7732,6 +7763,7 @@ int wolfSSL_connect_TLSv13(WOLFSSL* ssl)
             FALL_THROUGH;
 
         case FINISHED_DONE:
+            HS_TIMING_DONE(ssl);
         #ifndef NO_HANDSHAKE_DONE_CB
             if (ssl->hsDoneCb != NULL) {
                 int cbret = ssl->hsDoneCb(ssl, ssl->hsDoneCtx);
@@ -8272,6 +8304,9 @@ int wolfSSL_accept_TLSv13(WOLFSSL* ssl)
         return WOLFSSL_FATAL_ERROR;
     }
 
+    HS_TIMING_START(ssl);
+    HS_ARENA_START(ssl);
+
 #ifndef NO_CERTS
     /* allow no private key if using PK callbacks and CB is set */
     if (!havePSK) {
@@ -8536,6 +8571,7 @@ int wolfSSL_accept_TLSv13(WOLFSSL* ssl)
             FALL_THROUGH;
 
         case TLS13_TICKET_SENT :
+            HS_TIMING_DONE(ssl);
 #ifndef NO_HANDSHAKE_DONE_CB
             if (ssl->hsDoneCb) {
                 int cbret = ssl->hsDoneCb(ssl, ssl->hsDoneCtx);
@@ -732,7 +732,9 @@ int wolfIO_Send(SOCKET_T sd, char *buf, int sz, int wrFlags)
     {
         io_timeout_sec = to_sec;
     }
+#endif /* HAVE_IO_TIMEOUT */
 
+#if defined(HAVE_IO_TIMEOUT) || defined(HAVE_HTTP_CLIENT_NONBLOCK)
     int wolfIO_SetBlockingMode(SOCKET_T sockfd, int non_blocking)
     {
         int ret = 0;
@@ -758,7 +760,9 @@ int wolfIO_Send(SOCKET_T sd, char *buf, int sz, int wrFlags)
 
         return ret;
     }
+#endif /* HAVE_IO_TIMEOUT || HAVE_HTTP_CLIENT_NONBLOCK */
 
+#ifdef HAVE_IO_TIMEOUT
     int wolfIO_Select(SOCKET_T sockfd, int to_sec)
     {
         fd_set rfds, wfds;
@@ -821,12 +825,11 @@ static int wolfIO_Word16ToString(char* d, word16 number)
     return i;
 }
 
-int wolfIO_TcpConnect(SOCKET_T* sockfd, const char* ip, word16 port, int to_sec)
-{
 #ifdef HAVE_SOCKADDR
-    int ret = 0;
-    SOCKADDR_S addr;
-    int sockaddr_len = sizeof(SOCKADDR_IN);
+/* Look up address of responder, blocks on DNS */
+static int wolfIO_TcpAddr(SOCKADDR_S* addr, int* addrSz, const char* ip,
+                          word16 port)
+{
     /* use gethostbyname for c99 */
 #if defined(HAVE_GETADDRINFO) && !defined(WOLF_C99)
     ADDRINFO hints;
@@ -837,11 +840,8 @@ int wolfIO_TcpConnect(SOCKET_T* sockfd, const char* ip, word16 port, int to_sec)
     SOCKADDR_IN *sin;
 #endif
 
-    if (sockfd == NULL || ip == NULL) {
-        return -1;
-    }
-
-    XMEMSET(&addr, 0, sizeof(addr));
+    XMEMSET(addr, 0, sizeof(*addr));
+    *addrSz = sizeof(SOCKADDR_IN);
 
 #ifdef WOLFIO_DEBUG
     printf("TCP Connect: %s:%d\n", ip, port);
@@ -864,12 +864,12 @@ int wolfIO_TcpConnect(SOCKET_T* sockfd, const char* ip, word16 port, int to_sec)
         return -1;
     }
 
-    sockaddr_len = answer->ai_addrlen;
-    XMEMCPY(&addr, answer->ai_addr, sockaddr_len);
+    *addrSz = answer->ai_addrlen;
+    XMEMCPY(addr, answer->ai_addr, *addrSz);
     freeaddrinfo(answer);
 #else
     entry = gethostbyname(ip);
-    sin = (SOCKADDR_IN *)&addr;
+    sin = (SOCKADDR_IN *)addr;
 
     if (entry) {
         sin->sin_family = AF_INET;
@@ -882,6 +882,25 @@ int wolfIO_TcpConnect(SOCKET_T* sockfd, const char* ip, word16 port, int to_sec)
     }
 #endif
 
+    return 0;
+}
+#endif /* HAVE_SOCKADDR */
+
+int wolfIO_TcpConnect(SOCKET_T* sockfd, const char* ip, word16 port, int to_sec)
+{
+#ifdef HAVE_SOCKADDR
+    int ret = 0;
+    SOCKADDR_S addr;
+    int sockaddr_len;
+
+    if (sockfd == NULL || ip == NULL) {
+        return -1;
+    }
+
+    if (wolfIO_TcpAddr(&addr, &sockaddr_len, ip, port) != 0) {
+        return -1;
+    }
+
     *sockfd = (SOCKET_T)socket(addr.ss_family, SOCK_STREAM, 0);
 #ifdef USE_WINDOWS_API
     if (*sockfd == SOCKET_INVALID)
@@ -1377,6 +1396,422 @@ int wolfIO_HttpBuildRequest(const char *reqType, const char *domainName,
 }
 
 
+#ifdef HAVE_HTTP_CLIENT_NONBLOCK
+
+#ifndef WOLFIO_HTTP_NB_MAX_SZ
+    #define WOLFIO_HTTP_NB_MAX_SZ (1024 * 1024) /* largest response accepted */
+#endif
+
+#ifdef USE_WINDOWS_API
+    #define SOCKET_EINPROGRESS WSAEWOULDBLOCK
+    #define SOCKET_ENOTCONN    WSAENOTCONN
+#else
+    #define SOCKET_EINPROGRESS EINPROGRESS
+    #define SOCKET_ENOTCONN    ENOTCONN
+#endif
+
+enum {
+    WOLFIO_HTTP_NB_IDLE = 0,
+    WOLFIO_HTTP_NB_CONNECT,
+    WOLFIO_HTTP_NB_SEND,
+    WOLFIO_HTTP_NB_RECV
+};
+
+WOLFIO_HTTP_NB* wolfIO_HttpNbNew(void* heap)
+{
+    WOLFIO_HTTP_NB* nb;
+
+    nb = (WOLFIO_HTTP_NB*)XMALLOC(sizeof(WOLFIO_HTTP_NB), heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (nb != NULL) {
+        XMEMSET(nb, 0, sizeof(WOLFIO_HTTP_NB));
+        nb->sfd   = SOCKET_INVALID;
+        nb->state = WOLFIO_HTTP_NB_IDLE;
+        nb->heap  = heap;
+    }
+
+    return nb;
+}
+
+/* Abandon the lookup in flight, if any */
+static void wolfIO_HttpNbReset(WOLFIO_HTTP_NB* nb)
+{
+    if (nb->sfd != SOCKET_INVALID) {
+        CloseSocket(nb->sfd);
+        nb->sfd = SOCKET_INVALID;
+    }
+    if (nb->key != NULL) {
+        XFREE(nb->key, nb->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        nb->key = NULL;
+    }
+    if (nb->buf != NULL) {
+        XFREE(nb->buf, nb->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        nb->buf = NULL;
+    }
+    nb->keySz = 0;
+    nb->bufSz = 0;
+    nb->len   = 0;
+    nb->idx   = 0;
+    nb->state = WOLFIO_HTTP_NB_IDLE;
+}
+
+void wolfIO_HttpNbFree(WOLFIO_HTTP_NB* nb)
+{
+    if (nb != NULL) {
+        wolfIO_HttpNbReset(nb);
+        XFREE(nb, nb->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+}
+
+/* Socket of the lookup in flight for the application's event loop,
+ * SOCKET_INVALID when idle */
+SOCKET_T wolfIO_HttpNbGetFd(WOLFIO_HTTP_NB* nb)
+{
+    if (nb == NULL)
+        return SOCKET_INVALID;
+
+    return nb->sfd;
+}
+
+/* 1 when the socket should be polled for writing, 0 for reading */
+int wolfIO_HttpNbWantWrite(WOLFIO_HTTP_NB* nb)
+{
+    if (nb == NULL)
+        return 0;
+
+    return nb->state == WOLFIO_HTTP_NB_CONNECT ||
+           nb->state == WOLFIO_HTTP_NB_SEND;
+}
+
+/* 1 when the lookup in flight has the key1 || key2 given */
+static int wolfIO_HttpNbMatch(WOLFIO_HTTP_NB* nb, const byte* key1, int key1Sz,
+                              const byte* key2, int key2Sz)
+{
+    return nb->state != WOLFIO_HTTP_NB_IDLE &&
+           nb->keySz == key1Sz + key2Sz &&
+           XMEMCMP(nb->key, key1, key1Sz) == 0 &&
+           (key2Sz == 0 || XMEMCMP(nb->key + key1Sz, key2, key2Sz) == 0);
+}
+
+/* Start sending hdr and body to domainName:port without blocking, only the
+ * name lookup may block. The key identifies the lookup on later calls.
+ *
+ * Returns 0 on success */
+static int wolfIO_HttpNbStart(WOLFIO_HTTP_NB* nb, const byte* key1,
+    int key1Sz, const byte* key2, int key2Sz, const char* domainName,
+    word16 port, const byte* hdr, int hdrSz, const byte* body, int bodySz)
+{
+    int addrSz;
+    int ret;
+
+    wolfIO_HttpNbReset(nb);
+
+    nb->key = (byte*)XMALLOC(key1Sz + key2Sz, nb->heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    nb->bufSz = hdrSz + bodySz;
+    if (nb->bufSz < HTTP_SCRATCH_BUFFER_SIZE)
+        nb->bufSz = HTTP_SCRATCH_BUFFER_SIZE;
+    nb->buf = (byte*)XMALLOC(nb->bufSz, nb->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (nb->key == NULL || nb->buf == NULL) {
+        wolfIO_HttpNbReset(nb);
+        return MEMORY_E;
+    }
+
+    XMEMCPY(nb->key, key1, key1Sz);
+    if (key2Sz > 0)
+        XMEMCPY(nb->key + key1Sz, key2, key2Sz);
+    nb->keySz = key1Sz + key2Sz;
+    XMEMCPY(nb->buf, hdr, hdrSz);
+    if (bodySz > 0)
+        XMEMCPY(nb->buf + hdrSz, body, bodySz);
+    nb->len = hdrSz + bodySz;
+
+    if (wolfIO_TcpAddr(&nb->addr, &addrSz, domainName, port) != 0) {
+        wolfIO_HttpNbReset(nb);
+        return -1;
+    }
+    nb->addrSz = (XSOCKLENT)addrSz;
+
+    nb->sfd = (SOCKET_T)socket(nb->addr.ss_family, SOCK_STREAM, 0);
+#ifdef USE_WINDOWS_API
+    if (nb->sfd == SOCKET_INVALID)
+#else
+    if (nb->sfd <= SOCKET_INVALID)
+#endif
+    {
+        WOLFSSL_MSG("bad socket fd, out of fds?");
+        nb->sfd = SOCKET_INVALID;
+        wolfIO_HttpNbReset(nb);
+        return -1;
+    }
+
+    if (wolfIO_SetBlockingMode(nb->sfd, 1) < 0) {
+        wolfIO_HttpNbReset(nb);
+        return -1;
+    }
+
+    nb->state = WOLFIO_HTTP_NB_CONNECT;
+    ret = connect(nb->sfd, (SOCKADDR*)&nb->addr, nb->addrSz);
+    if (ret == 0) {
+        nb->state = WOLFIO_HTTP_NB_SEND;
+    }
+    else {
+        ret = wolfSSL_LastError(ret);
+        if (ret != SOCKET_EINPROGRESS && ret != SOCKET_EWOULDBLOCK) {
+            WOLFSSL_MSG("Responder tcp connect failed");
+            wolfIO_HttpNbReset(nb);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Send and receive what the socket allows without blocking.
+ *
+ * Returns WOLFSSL_CBIO_ERR_WANT_READ when the socket would block, 0 when
+ * the responder closed the connection and -1 on error */
+static int wolfIO_HttpNbIO(WOLFIO_HTTP_NB* nb)
+{
+    int ret;
+    int err;
+
+    if (nb->state == WOLFIO_HTTP_NB_CONNECT) {
+        SOCKADDR_S peer;
+        XSOCKLENT  peerSz = (XSOCKLENT)sizeof(peer);
+        XSOCKLENT  errSz = (XSOCKLENT)sizeof(err);
+
+        /* no select(), the descriptor may be past FD_SETSIZE with many
+         * lookups open. A failed connect leaves its pending socket error. */
+        err = 0;
+        if (getsockopt(nb->sfd, SOL_SOCKET, SO_ERROR, (char*)&err,
+                                                             &errSz) != 0 ||
+                                                                   err != 0) {
+            WOLFSSL_MSG("Responder tcp connect failed");
+            return -1;
+        }
+        /* and there is no peer until it completes */
+        if (getpeername(nb->sfd, (SOCKADDR*)&peer, &peerSz) != 0) {
+            if (wolfSSL_LastError(-1) == SOCKET_ENOTCONN)
+                return WOLFSSL_CBIO_ERR_WANT_READ;
+            WOLFSSL_MSG("Responder tcp connect getpeername failed");
+            return -1;
+        }
+        nb->state = WOLFIO_HTTP_NB_SEND;
+    }
+
+    while (nb->state == WOLFIO_HTTP_NB_SEND) {
+        ret = wolfIO_Send(nb->sfd, (char*)nb->buf + nb->idx,
+                          nb->len - nb->idx, 0);
+        if (ret <= 0) {
+            err = wolfSSL_LastError(ret);
+            if (ret < 0 && (err == SOCKET_EWOULDBLOCK || err == SOCKET_EAGAIN))
+                return WOLFSSL_CBIO_ERR_WANT_READ;
+            WOLFSSL_MSG("HTTP request send failed");
+            return -1;
+        }
+        nb->idx += ret;
+        if (nb->idx == nb->len) {
+            /* buffer now collects the response */
+            nb->state = WOLFIO_HTTP_NB_RECV;
+            nb->len   = 0;
+        }
+    }
+
+    for (;;) {
+        /* keep room for null terminator */
+        if (nb->len + 1 >= nb->bufSz) {
+            byte* newBuf;
+            int   newSz = nb->bufSz * 2;
+
+            if (nb->bufSz >= WOLFIO_HTTP_NB_MAX_SZ) {
+                WOLFSSL_MSG("HTTP response too large");
+                return -1;
+            }
+            if (newSz > WOLFIO_HTTP_NB_MAX_SZ)
+                newSz = WOLFIO_HTTP_NB_MAX_SZ;
+            newBuf = (byte*)XMALLOC(newSz, nb->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            if (newBuf == NULL)
+                return MEMORY_E;
+            XMEMCPY(newBuf, nb->buf, nb->len);
+            XFREE(nb->buf, nb->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            nb->buf   = newBuf;
+            nb->bufSz = newSz;
+        }
+
+        ret = wolfIO_Recv(nb->sfd, (char*)nb->buf + nb->len,
+                          nb->bufSz - nb->len - 1, 0);
+        if (ret == 0) {
+            nb->buf[nb->len] = '\0';
+            return 0;
+        }
+        if (ret < 0) {
+            nb->buf[nb->len] = '\0';
+            err = wolfSSL_LastError(ret);
+            if (err == SOCKET_EWOULDBLOCK || err == SOCKET_EAGAIN)
+                return WOLFSSL_CBIO_ERR_WANT_READ;
+            WOLFSSL_MSG("HTTP response recv failed");
+            return -1;
+        }
+        nb->len += ret;
+    }
+}
+
+/* Size and optionally copy out the chunked body at body.
+ *
+ * Returns the body size, WOLFSSL_CBIO_ERR_WANT_READ when incomplete and -1
+ * on error */
+static int wolfIO_HttpNbChunks(const char* body, int bodyLen, byte* out)
+{
+    int   pos = 0;
+    int   sz  = 0;
+    long  chunkSz;
+    char* end;
+
+    for (;;) {
+        end = XSTRSTR(body + pos, "\r\n");
+        if (end == NULL)
+            return WOLFSSL_CBIO_ERR_WANT_READ;
+
+        chunkSz = strtol(body + pos, NULL, 16); /* hex format */
+        pos = (int)(end - body) + 2;
+        if (chunkSz == 0)
+            return sz;
+        if (chunkSz < 0 || chunkSz > WOLFIO_HTTP_NB_MAX_SZ)
+            return -1;
+        if (pos + chunkSz + 2 > bodyLen)
+            return WOLFSSL_CBIO_ERR_WANT_READ;
+
+        if (out != NULL)
+            XMEMCPY(out + sz, body + pos, chunkSz);
+        sz  += (int)chunkSz;
+        pos += (int)chunkSz + 2;
+    }
+}
+
+/* Parse the response buffered in nb into a new respBuf of dynType.
+ *
+ * Returns the body size, WOLFSSL_CBIO_ERR_WANT_READ when more is expected
+ * and -1 on error */
+static int wolfIO_HttpNbParse(WOLFIO_HTTP_NB* nb, const char** appStrList,
+                              int closed, byte** respBuf, int dynType)
+{
+    char* http = (char*)nb->buf;
+    char* hdrEnd;
+    char* line;
+    char* body;
+    int   bodyLen;
+    int   sz = -1;
+    int   isChunked = 0;
+    int   i;
+
+    hdrEnd = XSTRSTR(http, "\r\n\r\n");
+    if (hdrEnd == NULL)
+        return closed ? -1 : WOLFSSL_CBIO_ERR_WANT_READ;
+
+    if (hdrEnd - http < 12 || XSTRNCASECMP(http, "HTTP/1", 6) != 0 ||
+                                          XSTRNCMP(http + 9, "200", 3) != 0) {
+        WOLFSSL_MSG("wolfIO_HttpNbParse not OK");
+        return -1;
+    }
+
+    /* header lines follow the status line, up to the blank line */
+    line = http;
+    while ((line = XSTRSTR(line, "\r\n")) != NULL && line < hdrEnd) {
+        line += 2;
+
+        if (XSTRNCASECMP(line, "Content-Type:", 13) == 0) {
+            line += 13;
+            while (*line == ' ') line++;
+
+            for (i = 0; appStrList[i] != NULL; i++) {
+                if (XSTRNCASECMP(line, appStrList[i],
+                                            XSTRLEN(appStrList[i])) == 0) {
+                    break;
+                }
+            }
+            if (appStrList[i] == NULL) {
+                WOLFSSL_MSG("wolfIO_HttpNbParse appstr mismatch");
+                return -1;
+            }
+        }
+        else if (XSTRNCASECMP(line, "Content-Length:", 15) == 0) {
+            sz = XATOI(line + 15);
+        }
+        else if (XSTRNCASECMP(line, "Transfer-Encoding:", 18) == 0) {
+            line += 18;
+            while (*line == ' ') line++;
+            if (XSTRNCASECMP(line, "chunked", 7) == 0)
+                isChunked = 1;
+        }
+    }
+
+    body    = hdrEnd + 4;
+    bodyLen = nb->len - (int)(body - http);
+
+    if (isChunked) {
+        sz = wolfIO_HttpNbChunks(body, bodyLen, NULL);
+    }
+    else if (sz >= 0) {
+        if (bodyLen < sz)
+            sz = WOLFSSL_CBIO_ERR_WANT_READ;
+    }
+    else {
+        /* no length, response ends with the connection */
+        sz = closed ? bodyLen : WOLFSSL_CBIO_ERR_WANT_READ;
+    }
+
+    if (sz == WOLFSSL_CBIO_ERR_WANT_READ && closed)
+        sz = -1;
+    if (sz == 0)
+        sz = -1;
+    if (sz < 0)
+        return sz;
+
+    *respBuf = (byte*)XMALLOC(sz, nb->heap, dynType);
+    if (*respBuf == NULL)
+        return MEMORY_E;
+
+    if (isChunked)
+        wolfIO_HttpNbChunks(body, bodyLen, *respBuf);
+    else
+        XMEMCPY(*respBuf, body, sz);
+
+    return sz;
+}
+
+/* Drive the lookup in flight, nb is idle again once it finishes.
+ *
+ * Returns the response size with the body in a new respBuf,
+ * WOLFSSL_CBIO_ERR_WANT_READ while pending and negative on error */
+static int wolfIO_HttpNbFetch(WOLFIO_HTTP_NB* nb, const char** appStrList,
+                              byte** respBuf, int dynType)
+{
+    int ret;
+
+    *respBuf = NULL;
+
+    ret = wolfIO_HttpNbIO(nb);
+    if (ret == WOLFSSL_CBIO_ERR_WANT_READ && nb->state != WOLFIO_HTTP_NB_RECV)
+        return ret;
+
+    if (ret == 0 || ret == WOLFSSL_CBIO_ERR_WANT_READ) {
+        ret = wolfIO_HttpNbParse(nb, appStrList, ret == 0, respBuf, dynType);
+        if (ret == WOLFSSL_CBIO_ERR_WANT_READ)
+            return ret;
+    }
+
+    wolfIO_HttpNbReset(nb);
+
+    if (ret < 0) {
+        WOLFSSL_ERROR(ret);
+    }
+    return ret;
+}
+
+#endif /* HAVE_HTTP_CLIENT_NONBLOCK */
+
+
 #ifdef HAVE_OCSP
 
 int wolfIO_HttpBuildRequestOcsp(const char* domainName, const char* path,
@@ -1489,6 +1924,110 @@ void EmbedOcspRespFree(void* ctx, byte *resp)
 
     (void)ctx;
 }
+
+#ifdef HAVE_HTTP_CLIENT_NONBLOCK
+/* Nonblocking EmbedOcspLookup, ctx is a WOLFIO_HTTP_NB from
+ * wolfIO_HttpNbNew(), one per concurrent lookup. Returns
+ * WOLFSSL_CBIO_ERR_WANT_READ until the response arrives and expects the
+ * same lookup to be repeated. */
+int EmbedOcspLookupNonBlock(void* ctx, const char* url, int urlSz,
+                        byte* ocspReqBuf, int ocspReqSz, byte** ocspRespBuf)
+{
+    WOLFIO_HTTP_NB* nb = (WOLFIO_HTTP_NB*)ctx;
+    word16   port;
+    int      ret = -1;
+#ifdef WOLFSSL_SMALL_STACK
+    char*    path;
+    char*    domainName;
+#else
+    char     path[MAX_URL_ITEM_SIZE];
+    char     domainName[MAX_URL_ITEM_SIZE];
+#endif
+    const char* appStrList[] = {
+        "application/ocsp-response",
+        NULL
+    };
+
+    if (nb == NULL || url == NULL || urlSz <= 0) {
+        WOLFSSL_MSG("OCSP nonblocking lookup needs context and URL");
+        return -1;
+    }
+    if (ocspReqBuf == NULL || ocspReqSz == 0) {
+        WOLFSSL_MSG("OCSP request is required for lookup");
+        return -1;
+    }
+    if (ocspRespBuf == NULL) {
+        WOLFSSL_MSG("Cannot save OCSP response");
+        return -1;
+    }
+
+    if (wolfIO_HttpNbMatch(nb, (const byte*)url, urlSz, ocspReqBuf,
+                                                                ocspReqSz)) {
+        return wolfIO_HttpNbFetch(nb, appStrList, ocspRespBuf,
+                                                             DYNAMIC_TYPE_OCSP);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    path = (char*)XMALLOC(MAX_URL_ITEM_SIZE, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (path == NULL)
+        return MEMORY_E;
+
+    domainName = (char*)XMALLOC(MAX_URL_ITEM_SIZE, NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+    if (domainName == NULL) {
+        XFREE(path, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        return MEMORY_E;
+    }
+#endif
+
+    if (wolfIO_DecodeUrl(url, urlSz, domainName, path, &port) < 0) {
+        WOLFSSL_MSG("Unable to decode OCSP URL");
+    }
+    else {
+        int   httpBufSz = HTTP_SCRATCH_BUFFER_SIZE;
+        byte* httpBuf   = (byte*)XMALLOC(httpBufSz, nb->heap,
+                                                             DYNAMIC_TYPE_OCSP);
+
+        if (httpBuf == NULL) {
+            WOLFSSL_MSG("Unable to create OCSP request buffer");
+        }
+        else {
+            httpBufSz = wolfIO_HttpBuildRequestOcsp(domainName, path, ocspReqSz,
+                                                            httpBuf, httpBufSz);
+
+            ret = wolfIO_HttpNbStart(nb, (const byte*)url, urlSz, ocspReqBuf,
+                    ocspReqSz, domainName, port, httpBuf, httpBufSz,
+                    ocspReqBuf, ocspReqSz);
+            if (ret != 0) {
+                WOLFSSL_MSG("OCSP Responder connection failed");
+            }
+            else {
+                ret = wolfIO_HttpNbFetch(nb, appStrList, ocspRespBuf,
+                                                             DYNAMIC_TYPE_OCSP);
+            }
+            XFREE(httpBuf, nb->heap, DYNAMIC_TYPE_OCSP);
+        }
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(path,       NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(domainName, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
+/* ctx is the WOLFIO_HTTP_NB the response was fetched with */
+void EmbedOcspRespFreeNonBlock(void* ctx, byte *resp)
+{
+    WOLFIO_HTTP_NB* nb = (WOLFIO_HTTP_NB*)ctx;
+
+    if (resp)
+        XFREE(resp, nb ? nb->heap : NULL, DYNAMIC_TYPE_OCSP);
+
+    (void)nb;
+}
+#endif /* HAVE_HTTP_CLIENT_NONBLOCK */
 #endif /* HAVE_OCSP */
 
 
@@ -1581,6 +2120,105 @@ int EmbedCrlLookup(WOLFSSL_CRL* crl, const char* url, int urlSz)
 
     return ret;
 }
+
+#ifdef HAVE_HTTP_CLIENT_NONBLOCK
+/* Nonblocking EmbedCrlLookup. Returns WOLFSSL_CBIO_ERR_WANT_READ until the
+ * CRL is loaded. Lookups share one download per WOLFSSL_CRL: a lookup for
+ * another URL advances the download in flight and starts its own once that
+ * one is loaded. */
+int EmbedCrlLookupNonBlock(WOLFSSL_CRL* crl, const char* url, int urlSz)
+{
+    word16   port;
+    int      ret = -1;
+    int      mine = 1;
+    byte*    respBuf = NULL;
+#ifdef WOLFSSL_SMALL_STACK
+    char*    domainName;
+#else
+    char     domainName[MAX_URL_ITEM_SIZE];
+#endif
+    const char* appStrList[] = {
+        "application/pkix-crl",
+        "application/x-pkcs7-crl",
+        NULL
+    };
+
+    if (crl == NULL || url == NULL || urlSz <= 0)
+        return -1;
+
+#ifdef WOLFSSL_SMALL_STACK
+    domainName = (char*)XMALLOC(MAX_URL_ITEM_SIZE, crl->heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (domainName == NULL) {
+        return MEMORY_E;
+    }
+#endif
+
+    if (wc_LockMutex(&crl->crlLock) != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(domainName, crl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return BAD_MUTEX_E;
+    }
+
+    if (crl->crlNb == NULL)
+        crl->crlNb = wolfIO_HttpNbNew(crl->heap);
+
+    if (crl->crlNb == NULL) {
+        ret = MEMORY_E;
+    }
+    else if (crl->crlNb->state != WOLFIO_HTTP_NB_IDLE) {
+        mine = wolfIO_HttpNbMatch(crl->crlNb, (const byte*)url, urlSz,
+                                                                      NULL, 0);
+        ret = wolfIO_HttpNbFetch(crl->crlNb, appStrList, &respBuf,
+                                                              DYNAMIC_TYPE_CRL);
+    }
+    else if (wolfIO_DecodeUrl(url, urlSz, domainName, NULL, &port) < 0) {
+        WOLFSSL_MSG("Unable to decode CRL URL");
+    }
+    else {
+        int   httpBufSz = HTTP_SCRATCH_BUFFER_SIZE;
+        byte* httpBuf   = (byte*)XMALLOC(httpBufSz, crl->heap,
+                                                              DYNAMIC_TYPE_CRL);
+        if (httpBuf == NULL) {
+            WOLFSSL_MSG("Unable to create CRL request buffer");
+        }
+        else {
+            httpBufSz = wolfIO_HttpBuildRequestCrl(url, urlSz, domainName,
+                httpBuf, httpBufSz);
+
+            ret = wolfIO_HttpNbStart(crl->crlNb, (const byte*)url, urlSz,
+                    NULL, 0, domainName, port, httpBuf, httpBufSz, NULL, 0);
+            if (ret != 0) {
+                WOLFSSL_MSG("CRL connection failed");
+            }
+            else {
+                ret = wolfIO_HttpNbFetch(crl->crlNb, appStrList, &respBuf,
+                                                              DYNAMIC_TYPE_CRL);
+            }
+            XFREE(httpBuf, crl->heap, DYNAMIC_TYPE_CRL);
+        }
+    }
+
+    wc_UnLockMutex(&crl->crlLock);
+
+    /* load outside of the lock, adding the CRL takes it */
+    if (ret > 0) {
+        ret = BufferLoadCRL(crl, respBuf, ret, WOLFSSL_FILETYPE_ASN1, 0);
+    }
+    XFREE(respBuf, crl->heap, DYNAMIC_TYPE_CRL);
+
+    /* the other download is done, start ours on the next call */
+    if (!mine && ret != WOLFSSL_CBIO_ERR_WANT_READ)
+        ret = WOLFSSL_CBIO_ERR_WANT_READ;
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(domainName, crl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+#endif /* HAVE_HTTP_CLIENT_NONBLOCK */
 #endif /* HAVE_CRL && HAVE_CRL_IO */
 
 #endif /* HAVE_HTTP_CLIENT */
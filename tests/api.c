@@ -336,9 +336,7 @@
         #include <wolfssl/wolfcrypt/srp.h>
 #endif
 
-#if defined(SESSION_CERTS) && defined(TEST_PEER_CERT_CHAIN)
-#include "wolfssl/internal.h" /* for testing SSL_get_peer_cert_chain */
-#endif
+#include "wolfssl/internal.h" /* for tests checking internal state */
 
 /* force enable test buffers */
 #ifndef USE_CERT_BUFFERS_2048
@@ -1168,6 +1166,177 @@ static void test_wolfSSL_CertManagerGetCerts(void)
           defined(WOLFSSL_SIGNER_DER_CERT) */
 }
 
+static void test_wolfSSL_CertManagerCATableGrow(void)
+{
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    defined(HAVE_ECC)
+    WOLFSSL_CERT_MANAGER* cm;
+    const char* caFiles[] = {
+        "./certs/ca-cert.pem",
+        "./certs/ca-ecc-cert.pem",
+        "./certs/ca-ecc384-cert.pem",
+        "./certs/client-cert.pem",
+        "./certs/client-ecc-cert.pem",
+        "./certs/client-ca.pem",
+        "./certs/wolfssl-website-ca.pem",
+        "./certs/1024/ca-cert.pem",
+        "./certs/1024/client-cert.pem",
+        "./certs/external/ca_collection.pem",
+        "./certs/external/ca-digicert-ev.pem",
+        "./certs/external/ca-google-root.pem",
+        "./certs/external/DigiCertGlobalRootCA.pem",
+        "./certs/intermediate/ca-int-cert.pem",
+        "./certs/intermediate/ca-int2-cert.pem",
+        "./certs/intermediate/ca-int-ecc-cert.pem",
+        "./certs/intermediate/ca-int2-ecc-cert.pem",
+        "./certs/ocsp/root-ca-cert.pem",
+        "./certs/ocsp/intermediate1-ca-cert.pem",
+        "./certs/ocsp/intermediate2-ca-cert.pem",
+        "./certs/ocsp/intermediate3-ca-cert.pem",
+        "./certs/test-pathlen/chainG-assembled.pem",
+        "./certs/test-pathlen/chainJ-assembled.pem",
+    };
+    size_t i;
+    word32 rows;
+
+    printf(testingFmt, "wolfSSL_CertManagerCATableGrow()");
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(cm->caTableSz, CA_TABLE_SIZE);
+
+    /* enough CAs to grow the table past its initial rows, not every file has
+     * to load in every build */
+    for (i = 0; i < sizeof(caFiles) / sizeof(*caFiles); i++)
+        (void)wolfSSL_CertManagerLoadCA(cm, caFiles[i], NULL);
+
+    /* grown to the first size in the 2n+1 sequence under the load factor */
+    AssertIntGT(cm->caCount, CA_TABLE_SIZE * CA_TABLE_LOAD);
+    for (rows = CA_TABLE_SIZE; cm->caCount > rows * CA_TABLE_LOAD; )
+        rows = rows * 2 + 1;
+    AssertIntEQ(cm->caTableSz, rows);
+
+    /* signers are still found by key id and by name after growing */
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm, "./certs/server-ecc.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm,
+                "./certs/intermediate/server-int-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm,
+                "./certs/intermediate/server-int-ecc-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+    AssertIntNE(wolfSSL_CertManagerVerify(cm, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm, "./certs/ca-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+    wolfSSL_CertManagerFree(cm);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_wolfSSL_CertManagerTrustStore(void)
+{
+#if defined(WOLFSSL_TRUST_STORE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA)
+    WOLFSSL_CERT_MANAGER* cm;
+    WOLFSSL_CERT_MANAGER* cm2;
+    const char* storeFile = "./test-truststore.wts";
+    unsigned char* store;
+    unsigned char* bad;
+    int sz = 0;
+    int smallSz;
+
+    printf(testingFmt, "wolfSSL_CertManagerTrustStore()");
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm, "./certs/ca-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm,
+                "./certs/intermediate/ca-int-cert.pem", NULL), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm,
+                "./certs/intermediate/ca-int2-cert.pem", NULL), WOLFSSL_SUCCESS);
+#ifdef HAVE_ECC
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm, "./certs/ca-ecc-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+#endif
+
+    AssertIntEQ(wolfSSL_CertManagerSaveTrustStoreBuffer(NULL, NULL, &sz),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CertManagerSaveTrustStoreBuffer(cm, NULL, &sz),
+                LENGTH_ONLY_E);
+    AssertIntGT(sz, 0);
+    AssertNotNull(store = (unsigned char*)XMALLOC(sz, NULL,
+                                                  DYNAMIC_TYPE_TMP_BUFFER));
+    smallSz = sz - 1;
+    AssertIntEQ(wolfSSL_CertManagerSaveTrustStoreBuffer(cm, store, &smallSz),
+                BUFFER_E);
+    AssertIntEQ(wolfSSL_CertManagerSaveTrustStoreBuffer(cm, store, &sz),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerSaveTrustStore(cm, storeFile),
+                WOLFSSL_SUCCESS);
+    wolfSSL_CertManagerFree(cm);
+
+    /* signers come straight from the store, no certificates parsed */
+    AssertNotNull(cm2 = wolfSSL_CertManagerNew());
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStoreBuffer(cm2, NULL, sz),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStoreBuffer(cm2, store, sz),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm2, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm2,
+                "./certs/intermediate/server-int-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+#ifdef HAVE_ECC
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm2, "./certs/server-ecc.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+#endif
+    /* loading again adds nothing, the store can be released with the CAs */
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStore(cm2, storeFile),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm2), WOLFSSL_SUCCESS);
+    AssertIntNE(wolfSSL_CertManagerVerify(cm2, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStore(cm2, storeFile),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerify(cm2, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    wolfSSL_CertManagerFree(cm2);
+
+    /* corrupt and truncated stores are rejected */
+    AssertNotNull(cm2 = wolfSSL_CertManagerNew());
+    AssertNotNull(bad = (unsigned char*)XMALLOC(sz, NULL,
+                                                DYNAMIC_TYPE_TMP_BUFFER));
+    XMEMCPY(bad, store, sz);
+    bad[0] ^= 0xFF;
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStoreBuffer(cm2, bad, sz),
+                CACHE_MATCH_ERROR);
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStoreBuffer(cm2, store, sz - 1),
+                BUFFER_E);
+    XMEMCPY(bad, store, sz);
+    bad[20] = 0xFF; /* first record size */
+    AssertIntEQ(wolfSSL_CertManagerLoadTrustStoreBuffer(cm2, bad, sz),
+                BUFFER_E);
+    AssertIntNE(wolfSSL_CertManagerVerify(cm2, "./certs/server-cert.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    wolfSSL_CertManagerFree(cm2);
+
+    XFREE(bad, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(store, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    (void)remove(storeFile);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 static int test_wolfSSL_CertManagerSetVerify(void)
 {
     int ret = 0;
@@ -1454,6 +1623,138 @@ static void test_wolfSSL_CTX_load_verify_locations_ex(void)
 #endif
 }
 
+static void test_wolfSSL_CTX_load_verify_locations_parallel_lazy(void)
+{
+#if (defined(WOLFSSL_PARALLEL_CA_LOAD) || defined(WOLFSSL_LAZY_CA_LOAD)) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    defined(HAVE_ECC) && !defined(NO_WOLFSSL_DIR) && \
+    !defined(NO_WOLFSSL_CLIENT)
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_CERT_MANAGER* cm;
+    const char* verifyFiles[] = {
+        "./certs/server-cert.pem",
+        "./certs/server-ecc.pem",
+        "./certs/client-cert.pem",
+        "./certs/intermediate/server-int-cert.pem",
+        "./certs/test/expired/expired-cert.pem"
+    };
+    const word32 modes[] = {
+        WOLFSSL_LOAD_FLAG_PARALLEL,
+        WOLFSSL_LOAD_FLAG_LAZY,
+        WOLFSSL_LOAD_FLAG_PARALLEL | WOLFSSL_LOAD_FLAG_LAZY
+    };
+    int expected[sizeof(verifyFiles) / sizeof(*verifyFiles)];
+    int i, j;
+    byte* buf;
+    long  sz;
+    XFILE fp;
+
+    printf(testingFmt, "wolfSSL_CTX_load_verify_locations_ex parallel/lazy");
+
+    /* serial load gives the expected verify results */
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertNotNull(cm = wolfSSL_CTX_GetCertManager(ctx));
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs",
+        WOLFSSL_LOAD_FLAG_IGNORE_ERR), WOLFSSL_SUCCESS);
+    for (i = 0; i < (int)(sizeof(verifyFiles) / sizeof(*verifyFiles)); i++) {
+        expected[i] = wolfSSL_CertManagerVerify(cm, verifyFiles[i],
+                                                WOLFSSL_FILETYPE_PEM);
+    }
+    AssertIntEQ(expected[0], WOLFSSL_SUCCESS);
+    AssertIntEQ(expected[1], WOLFSSL_SUCCESS);
+    wolfSSL_CTX_free(ctx);
+
+    for (j = 0; j < (int)(sizeof(modes) / sizeof(*modes)); j++) {
+        AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+        AssertNotNull(cm = wolfSSL_CTX_GetCertManager(ctx));
+
+        /* results and error handling match the serial walk */
+        AssertIntNE(wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs",
+            modes[j]), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx, NULL,
+            "./certs/test/does-not-exist", modes[j]), BAD_PATH_ERROR);
+        AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs",
+            modes[j] | WOLFSSL_LOAD_FLAG_IGNORE_ERR), WOLFSSL_SUCCESS);
+        for (i = 0; i < (int)(sizeof(verifyFiles) / sizeof(*verifyFiles));
+                                                                         i++) {
+            AssertIntEQ(wolfSSL_CertManagerVerify(cm, verifyFiles[i],
+                WOLFSSL_FILETYPE_PEM), expected[i]);
+        }
+
+        /* loading again adds nothing and still verifies */
+        AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx,
+            "./certs/ca-cert.pem", "./certs",
+            modes[j] | WOLFSSL_LOAD_FLAG_IGNORE_ERR), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CertManagerVerify(cm, verifyFiles[0],
+            WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+        AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+        AssertIntNE(wolfSSL_CertManagerVerify(cm, verifyFiles[0],
+            WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+    #ifdef WOLFSSL_LAZY_CA_LOAD
+        if (modes[j] & WOLFSSL_LOAD_FLAG_LAZY) {
+            /* a lazily loaded CA that fails to decode on first use is
+             * dropped, and can then be loaded again */
+            AssertIntEQ(wolfSSL_CTX_SetMinRsaKey_Sz(ctx, 4096),
+                        WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx,
+                "./certs/ca-cert.pem", NULL, modes[j]), WOLFSSL_SUCCESS);
+            AssertIntNE(wolfSSL_CertManagerVerify(cm, verifyFiles[0],
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+            AssertIntNE(wolfSSL_CertManagerVerify(cm, verifyFiles[0],
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CTX_SetMinRsaKey_Sz(ctx, 1024),
+                        WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx,
+                "./certs/ca-cert.pem", NULL, modes[j]), WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CertManagerVerify(cm, verifyFiles[0],
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+
+            /* lazy PEM buffer */
+            AssertTrue((fp = XFOPEN("./certs/ca-cert.pem", "rb")) != XBADFILE);
+            AssertIntEQ(XFSEEK(fp, 0, XSEEK_END), 0);
+            sz = XFTELL(fp);
+            XREWIND(fp);
+            AssertNotNull(buf = (byte*)XMALLOC(sz, NULL,
+                                               DYNAMIC_TYPE_TMP_BUFFER));
+            AssertIntEQ((long)XFREAD(buf, 1, sz, fp), sz);
+            XFCLOSE(fp);
+            AssertIntEQ(wolfSSL_CTX_load_verify_buffer_ex(ctx, buf, sz,
+                WOLFSSL_FILETYPE_PEM, 0, WOLFSSL_LOAD_FLAG_LAZY),
+                WOLFSSL_SUCCESS);
+            XFREE(buf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+            AssertIntEQ(wolfSSL_CertManagerVerify(cm, verifyFiles[0],
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+            /* a lazy CA inherits its issuer's path length, a CA under the
+             * pathLen 0 CA is still rejected */
+            AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx,
+                "./certs/test-pathlen/chainF-ICA2-pathlen0.pem", NULL,
+                modes[j]), WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CertManagerVerify(cm,
+                "./certs/test-pathlen/chainF-ICA1-pathlen1.pem",
+                WOLFSSL_FILETYPE_PEM), ASN_PATHLEN_INV_E);
+            AssertIntEQ(wolfSSL_CTX_load_verify_locations_ex(ctx,
+                "./certs/test-pathlen/chainF-ICA1-pathlen1.pem", NULL,
+                modes[j]), WOLFSSL_SUCCESS);
+            AssertIntEQ(wolfSSL_CertManagerVerify(cm,
+                "./certs/test-pathlen/chainF-entity.pem",
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        }
+    #endif
+
+        wolfSSL_CTX_free(ctx);
+    }
+    (void)buf;
+    (void)sz;
+    (void)fp;
+
+    printf(resultFmt, passed);
+#endif
+}
+
 static void test_wolfSSL_CTX_load_verify_buffer_ex(void)
 {
 #if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
@@ -1695,6 +1996,7 @@ static void test_wolfSSL_CTX_enable_disable(void)
   #ifdef HAVE_OCSP
     AssertIntEQ(wolfSSL_CTX_DisableOCSP(ctx), BAD_FUNC_ARG);
     AssertIntEQ(wolfSSL_CTX_EnableOCSP(ctx, 0), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_SetOCSPCacheSize(ctx, 8), BAD_FUNC_ARG);
   #endif
 
   #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) || \
@@ -1736,6 +2038,8 @@ static void test_wolfSSL_CTX_enable_disable(void)
                 WOLFSSL_SUCCESS);
     AssertIntEQ(wolfSSL_CTX_EnableOCSP(ctx, WOLFSSL_OCSP_CHECKALL),
                 WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetOCSPCacheSize(ctx, 8), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetOCSPCacheSize(ctx, 0), WOLFSSL_SUCCESS);
   #endif
 
   #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) || \
@@ -1767,6 +2071,150 @@ static void test_wolfSSL_CTX_ticket_API(void)
 #endif /* HAVE_SESSION_TICKET && !NO_WOLFSSL_SERVER */
 }
 
+#if defined(HAVE_OCSP_STAPLING_REFRESH) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_RSA)
+static int ocspRefreshIOCalls = 0;
+
+static int test_OcspRefreshIOCb(void* ctx, const char* url, int urlSz,
+                                unsigned char* req, int reqSz,
+                                unsigned char** resp)
+{
+    (void)ctx;
+    (void)url;
+    (void)urlSz;
+    (void)req;
+    (void)reqSz;
+    (void)resp;
+
+    ocspRefreshIOCalls++;
+
+    return -1;  /* responder unreachable */
+}
+#endif
+
+static void test_wolfSSL_CTX_EnableOCSPStaplingRefresh(void)
+{
+#if defined(HAVE_OCSP_STAPLING_REFRESH) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_RSA)
+    WOLFSSL_CTX* ctx;
+
+    printf(testingFmt, "wolfSSL_CTX_EnableOCSPStaplingRefresh()");
+
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStaplingRefresh(NULL), BAD_FUNC_ARG);
+
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStaplingRefresh(ctx), NO_CERT_ERROR);
+
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx, caCertFile, 0),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_use_certificate_file(ctx, svrCertFile,
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetOCSP_OverrideURL(ctx, "http://127.0.0.1:1"),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_EnableOCSP(ctx, WOLFSSL_OCSP_URL_OVERRIDE),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStapling(ctx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetOCSP_Cb(ctx, test_OcspRefreshIOCb, NULL, NULL),
+                WOLFSSL_SUCCESS);
+
+    /* failed prefetch is retried from the refresh thread */
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStaplingRefresh(ctx), WOLFSSL_SUCCESS);
+    AssertIntEQ(ocspRefreshIOCalls, 1);
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStaplingRefresh(ctx), WOLFSSL_SUCCESS);
+
+    /* joins the refresh thread */
+    wolfSSL_CTX_free(ctx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_EmbedOcspLookupNonBlock(void)
+{
+#if defined(HAVE_HTTP_CLIENT_NONBLOCK) && defined(HAVE_OCSP) && \
+    !defined(USE_WINDOWS_API)
+    WOLFIO_HTTP_NB*    nb;
+    SOCKET_T           lfd;
+    SOCKET_T           cfd;
+    struct sockaddr_in addr;
+    socklen_t          addrSz = sizeof(addr);
+    char               url[64];
+    char               rx[512];
+    byte*              resp = NULL;
+    const byte         req[] = { 0x30, 0x03, 0x02, 0x01, 0x01 };
+    const byte         der[] = { 0x30, 0x03, 0x0a, 0x01, 0x00 };
+    const char*        hdr = "HTTP/1.1 200 OK\r\n"
+                             "Content-Type: application/ocsp-response\r\n"
+                             "Content-Length: 5\r\n\r\n";
+    int                ret = 0;
+    int                i;
+
+    printf(testingFmt, "EmbedOcspLookupNonBlock()");
+
+    /* local stand-in for the OCSP responder */
+    XMEMSET(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    lfd = socket(AF_INET, SOCK_STREAM, 0);
+    AssertIntGE(lfd, 0);
+    AssertIntEQ(bind(lfd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    AssertIntEQ(listen(lfd, 1), 0);
+    AssertIntEQ(getsockname(lfd, (struct sockaddr*)&addr, &addrSz), 0);
+    XSNPRINTF(url, sizeof(url), "http://127.0.0.1:%d/ocsp",
+              ntohs(addr.sin_port));
+
+    AssertNotNull(nb = wolfIO_HttpNbNew(HEAP_HINT));
+    AssertIntEQ(wolfIO_HttpNbGetFd(nb), SOCKET_INVALID);
+    AssertIntEQ(EmbedOcspLookupNonBlock(NULL, url, (int)XSTRLEN(url),
+                (byte*)req, sizeof(req), &resp), -1);
+
+    AssertIntEQ(EmbedOcspLookupNonBlock(nb, url, (int)XSTRLEN(url),
+                (byte*)req, sizeof(req), &resp), WOLFSSL_CBIO_ERR_WANT_READ);
+    AssertIntNE(wolfIO_HttpNbGetFd(nb), SOCKET_INVALID);
+    cfd = accept(lfd, NULL, NULL);
+    AssertIntGE(cfd, 0);
+
+    /* request goes out once connected, then waits on the responder */
+    AssertIntEQ(EmbedOcspLookupNonBlock(nb, url, (int)XSTRLEN(url),
+                (byte*)req, sizeof(req), &resp), WOLFSSL_CBIO_ERR_WANT_READ);
+    AssertIntEQ(wolfIO_HttpNbWantWrite(nb), 0);
+    AssertIntGT((int)recv(cfd, rx, sizeof(rx), 0), 0);
+    AssertIntEQ(XSTRNCMP(rx, "POST /ocsp HTTP/1.1", 19), 0);
+
+    /* headers without the body are not a response yet */
+    AssertIntEQ((int)send(cfd, hdr, XSTRLEN(hdr), 0), (int)XSTRLEN(hdr));
+    AssertIntEQ(EmbedOcspLookupNonBlock(nb, url, (int)XSTRLEN(url),
+                (byte*)req, sizeof(req), &resp), WOLFSSL_CBIO_ERR_WANT_READ);
+    AssertNull(resp);
+
+    AssertIntEQ((int)send(cfd, der, sizeof(der), 0), (int)sizeof(der));
+    AssertIntEQ(EmbedOcspLookupNonBlock(nb, url, (int)XSTRLEN(url),
+                (byte*)req, sizeof(req), &resp), (int)sizeof(der));
+    AssertNotNull(resp);
+    AssertIntEQ(XMEMCMP(resp, der, sizeof(der)), 0);
+    AssertIntEQ(wolfIO_HttpNbGetFd(nb), SOCKET_INVALID);
+    EmbedOcspRespFreeNonBlock(nb, resp);
+    resp = NULL;
+
+    CloseSocket(cfd);
+    CloseSocket(lfd);
+
+    /* a refused connect is learned from the socket error */
+    for (i = 0; i < 1000; i++) {
+        ret = EmbedOcspLookupNonBlock(nb, url, (int)XSTRLEN(url),
+                                      (byte*)req, sizeof(req), &resp);
+        if (ret != WOLFSSL_CBIO_ERR_WANT_READ)
+            break;
+    }
+    AssertIntEQ(ret, -1);
+    AssertNull(resp);
+    AssertIntEQ(wolfIO_HttpNbGetFd(nb), SOCKET_INVALID);
+    wolfIO_HttpNbFree(nb);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 
 /*----------------------------------------------------------------------------*
  | SSL
@@ -3486,7 +3934,9 @@ static THREAD_RETURN WOLFSSL_THREAD run_wolfssl_server(void* args)
 {
     callback_functions* callbacks = ((func_args*)args)->callbacks;
 
-    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(callbacks->method());
+    /* a CTX given by the test is kept across connections and not freed */
+    WOLFSSL_CTX* ctx = callbacks->ctx != NULL ? callbacks->ctx :
+                                           wolfSSL_CTX_new(callbacks->method());
     WOLFSSL*     ssl = NULL;
     SOCKET_T    sfd = 0;
     SOCKET_T    cfd = 0;
@@ -3620,7 +4070,8 @@ static THREAD_RETURN WOLFSSL_THREAD run_wolfssl_server(void* args)
 
     wolfSSL_shutdown(ssl);
     wolfSSL_free(ssl);
-    wolfSSL_CTX_free(ctx);
+    if (callbacks->ctx == NULL)
+        wolfSSL_CTX_free(ctx);
     CloseSocket(cfd);
 
 
@@ -3642,7 +4093,8 @@ static void run_wolfssl_client(void* args)
 {
     callback_functions* callbacks = ((func_args*)args)->callbacks;
 
-    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(callbacks->method());
+    WOLFSSL_CTX* ctx = callbacks->ctx != NULL ? callbacks->ctx :
+                                           wolfSSL_CTX_new(callbacks->method());
     WOLFSSL*     ssl = NULL;
     SOCKET_T    sfd = 0;
 
@@ -3721,7 +4173,8 @@ static void run_wolfssl_client(void* args)
         callbacks->on_result(ssl);
 
     wolfSSL_free(ssl);
-    wolfSSL_CTX_free(ctx);
+    if (callbacks->ctx == NULL)
+        wolfSSL_CTX_free(ctx);
     CloseSocket(sfd);
 
 #ifdef WOLFSSL_TIRTOS
@@ -4102,6 +4555,47 @@ static void test_wolfSSL_client_server(callback_functions* client_callbacks,
     fdCloseSession(Task_self());
 #endif
 }
+
+#if defined(WOLFSSL_HANDSHAKE_TIMING) || defined(WOLFSSL_PERF_COUNTERS) || \
+    defined(WOLFSSL_HANDSHAKE_ARENA)
+/* connections at the highest version then at TLS 1.2, the methods set in the
+ * callbacks for each. More than one connection of a version is made on the
+ * same CTXs. */
+static void test_wolfSSL_client_server_versions(
+    callback_functions* client_callbacks, callback_functions* server_callbacks,
+    int connections)
+{
+    method_provider methods[] = {
+        wolfSSLv23_client_method,  wolfSSLv23_server_method,
+    #ifndef WOLFSSL_NO_TLS12
+        wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+    #endif
+    };
+    unsigned long m;
+    int           i;
+
+    for (m = 0; m < sizeof(methods) / sizeof(method_provider); m += 2) {
+        client_callbacks->method = methods[m];
+        server_callbacks->method = methods[m + 1];
+        if (connections > 1) {
+            AssertNotNull(client_callbacks->ctx = wolfSSL_CTX_new(
+                                                   client_callbacks->method()));
+            AssertNotNull(server_callbacks->ctx = wolfSSL_CTX_new(
+                                                   server_callbacks->method()));
+        }
+
+        for (i = 0; i < connections; i++)
+            test_wolfSSL_client_server(client_callbacks, server_callbacks);
+
+        if (connections > 1) {
+            wolfSSL_CTX_free(client_callbacks->ctx);
+            wolfSSL_CTX_free(server_callbacks->ctx);
+            client_callbacks->ctx = NULL;
+            server_callbacks->ctx = NULL;
+        }
+    }
+}
+#endif
 #endif /* defined(HAVE_SNI) || defined(HAVE_ALPN) */
 
 #ifdef HAVE_SNI
@@ -4287,7 +4781,7 @@ static void test_wolfSSL_UseSNI_connection(void)
 
 static void test_wolfSSL_SNI_GetFromBuffer(void)
 {
-    byte buffer[] = { /* www.paypal.com */
+    byte buff[] = { /* www.paypal.com */
         0x00, 0x00, 0x00, 0x00, 0xff, 0x01, 0x00, 0x00, 0x60, 0x03, 0x03, 0x5c,
         0xc4, 0xb3, 0x8c, 0x87, 0xef, 0xa4, 0x09, 0xe0, 0x02, 0xab, 0x86, 0xca,
         0x76, 0xf0, 0x9e, 0x01, 0x65, 0xf6, 0xa6, 0x06, 0x13, 0x1d, 0x0f, 0xa5,
@@ -4369,23 +4863,23 @@ static void test_wolfSSL_SNI_GetFromBuffer(void)
     AssertIntEQ(0, wolfSSL_SNI_GetFromBuffer(buffer2, sizeof(buffer2),
                                                            1, result, &length));
 
-    AssertIntEQ(BUFFER_ERROR, wolfSSL_SNI_GetFromBuffer(buffer, sizeof(buffer),
+    AssertIntEQ(BUFFER_ERROR, wolfSSL_SNI_GetFromBuffer(buff, sizeof(buff),
                                                            0, result, &length));
-    buffer[0] = 0x16;
+    buff[0] = 0x16;
 
-    AssertIntEQ(BUFFER_ERROR, wolfSSL_SNI_GetFromBuffer(buffer, sizeof(buffer),
+    AssertIntEQ(BUFFER_ERROR, wolfSSL_SNI_GetFromBuffer(buff, sizeof(buff),
                                                            0, result, &length));
-    buffer[1] = 0x03;
+    buff[1] = 0x03;
 
-    AssertIntEQ(SNI_UNSUPPORTED, wolfSSL_SNI_GetFromBuffer(buffer,
-                                           sizeof(buffer), 0, result, &length));
-    buffer[2] = 0x03;
+    AssertIntEQ(SNI_UNSUPPORTED, wolfSSL_SNI_GetFromBuffer(buff,
+                                           sizeof(buff), 0, result, &length));
+    buff[2] = 0x03;
 
-    AssertIntEQ(INCOMPLETE_DATA, wolfSSL_SNI_GetFromBuffer(buffer,
-                                           sizeof(buffer), 0, result, &length));
-    buffer[4] = 0x64;
+    AssertIntEQ(INCOMPLETE_DATA, wolfSSL_SNI_GetFromBuffer(buff,
+                                           sizeof(buff), 0, result, &length));
+    buff[4] = 0x64;
 
-    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_SNI_GetFromBuffer(buffer, sizeof(buffer),
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_SNI_GetFromBuffer(buff, sizeof(buff),
                                                            0, result, &length));
     result[length] = 0;
     AssertStrEQ("www.paypal.com", (const char*) result);
@@ -4416,11 +4910,184 @@ static void test_wolfSSL_SNI_GetFromBuffer(void)
 
 #endif /* HAVE_SNI */
 
+#if defined(WOLFSSL_SNI_TABLE) && !defined(NO_WOLFSSL_SERVER) && \
+    defined(HAVE_ECC) && !defined(NO_RSA)
+/* SNI certificate table callbacks: the client only trusts the ECC CA, so
+ * the handshake only completes when the table's ECC certificate is sent */
+static void trust_ECC_at_ctx(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_UnloadCAs(ctx));
+    AssertIntEQ(WOLFSSL_SUCCESS,
+                wolfSSL_CTX_load_verify_locations(ctx, caEccCertFile, 0));
+}
+
+static void add_ECC_SNI_cert(WOLFSSL_CTX* ctx, const char* hostName)
+{
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SNI_AddCert_buffer(ctx, hostName,
+                serv_ecc_der_256, sizeof_serv_ecc_der_256, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1));
+}
+
+static void SNI_table_exact_at_ctx(WOLFSSL_CTX* ctx)
+{
+    add_ECC_SNI_cert(ctx, "www.wolfssl.com");
+}
+
+static void SNI_table_wildcard_at_ctx(WOLFSSL_CTX* ctx)
+{
+    byte*  cert = NULL;
+    byte*  key = NULL;
+    size_t certSz = 0;
+    size_t keySz = 0;
+
+    /* PEM this time, and host names don't care about case */
+    AssertIntEQ(0, load_file(eccCertFile, &cert, &certSz));
+    AssertIntEQ(0, load_file(eccKeyFile, &key, &keySz));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SNI_AddCert_buffer(ctx,
+                "*.WolfSSL.com", cert, (long)certSz, key, (long)keySz,
+                WOLFSSL_FILETYPE_PEM));
+    free(cert);
+    free(key);
+}
+
+static void SNI_table_other_at_ctx(WOLFSSL_CTX* ctx)
+{
+    add_ECC_SNI_cert(ctx, "*.example.com");
+    add_ECC_SNI_cert(ctx, "wolfssl.com");
+}
+
+static void SNI_table_removed_at_ctx(WOLFSSL_CTX* ctx)
+{
+    add_ECC_SNI_cert(ctx, "www.wolfssl.com");
+    AssertIntEQ(WOLFSSL_SUCCESS,
+                wolfSSL_CTX_SNI_RemoveCert(ctx, "www.wolfssl.com"));
+}
+
+static void SNI_table_replaced_at_ctx(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SNI_AddCert_buffer(ctx,
+                "www.wolfssl.com", server_cert_der_2048,
+                sizeof_server_cert_der_2048, server_key_der_2048,
+                sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1));
+    add_ECC_SNI_cert(ctx, "www.wolfssl.com");
+}
+
+static void verify_SNI_table_connected(WOLFSSL* ssl)
+{
+    AssertIntEQ(1, wolfSSL_is_init_finished(ssl));
+}
+
+static void verify_SNI_table_not_connected(WOLFSSL* ssl)
+{
+    AssertIntEQ(0, wolfSSL_is_init_finished(ssl));
+}
+
+static void test_wolfSSL_SNI_AddCert_params(void)
+{
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfSSLv23_server_method());
+
+    AssertNotNull(ctx);
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(NULL,
+                "www.wolfssl.com", serv_ecc_der_256, sizeof_serv_ecc_der_256,
+                ecc_key_der_256, sizeof_ecc_key_der_256,
+                WOLFSSL_FILETYPE_ASN1));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(ctx, NULL,
+                serv_ecc_der_256, sizeof_serv_ecc_der_256, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(ctx,
+                "www.wolfssl.com", NULL, 0, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(ctx,
+                "www.wolfssl.com", serv_ecc_der_256, sizeof_serv_ecc_der_256,
+                NULL, 0, WOLFSSL_FILETYPE_ASN1));
+
+    /* only a leading "*." label is a wildcard */
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(ctx, "",
+                serv_ecc_der_256, sizeof_serv_ecc_der_256, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(ctx, "*.",
+                serv_ecc_der_256, sizeof_serv_ecc_der_256, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_AddCert_buffer(ctx,
+                "www.*.com", serv_ecc_der_256, sizeof_serv_ecc_der_256,
+                ecc_key_der_256, sizeof_ecc_key_der_256,
+                WOLFSSL_FILETYPE_ASN1));
+
+    /* key doesn't go with the certificate */
+    AssertIntNE(WOLFSSL_SUCCESS, wolfSSL_CTX_SNI_AddCert_buffer(ctx,
+                "www.wolfssl.com", serv_ecc_der_256, sizeof_serv_ecc_der_256,
+                server_key_der_2048, sizeof_server_key_der_2048,
+                WOLFSSL_FILETYPE_ASN1));
+    AssertIntEQ(WOLFSSL_FAILURE,
+                wolfSSL_CTX_SNI_RemoveCert(ctx, "www.wolfssl.com"));
+
+    add_ECC_SNI_cert(ctx, "www.wolfssl.com");
+    add_ECC_SNI_cert(ctx, "*.wolfssl.com");
+    AssertIntEQ(WOLFSSL_SUCCESS,
+                wolfSSL_CTX_SNI_RemoveCert(ctx, "WWW.wolfssl.com"));
+    AssertIntEQ(WOLFSSL_FAILURE,
+                wolfSSL_CTX_SNI_RemoveCert(ctx, "www.wolfssl.com"));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_RemoveCert(NULL, "*.wolfssl.com"));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SNI_RemoveCert(ctx, NULL));
+
+    /* the wildcard is left for wolfSSL_CTX_free */
+    wolfSSL_CTX_free(ctx);
+}
+
+static void test_wolfSSL_SNI_AddCert_connection(void)
+{
+    unsigned long i;
+    callback_functions callbacks[] = {
+        /* exact name */
+        {wolfSSLv23_client_method, trust_ECC_at_ctx, use_SNI_at_ssl,
+                                   verify_SNI_table_connected, 0, 0},
+        {wolfSSLv23_server_method, SNI_table_exact_at_ctx, 0,
+                                   verify_SNI_real_matching, 0, 0},
+    #ifndef WOLFSSL_NO_TLS12
+        {wolfTLSv1_2_client_method, trust_ECC_at_ctx, use_SNI_at_ssl,
+                                    verify_SNI_table_connected, 0, 0},
+        {wolfTLSv1_2_server_method, SNI_table_exact_at_ctx, 0,
+                                    verify_SNI_real_matching, 0, 0},
+    #endif
+
+        /* wildcard */
+        {wolfSSLv23_client_method, trust_ECC_at_ctx, use_SNI_at_ssl,
+                                   verify_SNI_table_connected, 0, 0},
+        {wolfSSLv23_server_method, SNI_table_wildcard_at_ctx, 0,
+                                   verify_SNI_real_matching, 0, 0},
+
+        /* no name in the table, the CTX certificate is used */
+        {wolfSSLv23_client_method, 0, use_SNI_at_ssl,
+                                   verify_SNI_table_connected, 0, 0},
+        {wolfSSLv23_server_method, SNI_table_other_at_ctx, 0, 0, 0, 0},
+
+        /* removed name uses the CTX certificate again */
+        {wolfSSLv23_client_method, trust_ECC_at_ctx, use_SNI_at_ssl,
+                                   verify_SNI_table_not_connected, 0, 0},
+        {wolfSSLv23_server_method, SNI_table_removed_at_ctx, 0, 0, 0, 0},
+
+        /* adding a name again replaces its certificate */
+        {wolfSSLv23_client_method, trust_ECC_at_ctx, use_SNI_at_ssl,
+                                   verify_SNI_table_connected, 0, 0},
+        {wolfSSLv23_server_method, SNI_table_replaced_at_ctx, 0, 0, 0, 0},
+    };
+
+    for (i = 0; i < sizeof(callbacks) / sizeof(callback_functions); i += 2)
+        test_wolfSSL_client_server(&callbacks[i], &callbacks[i + 1]);
+}
+#endif /* WOLFSSL_SNI_TABLE && !NO_WOLFSSL_SERVER && HAVE_ECC && !NO_RSA */
+
 static void test_wolfSSL_UseSNI(void)
 {
 #ifdef HAVE_SNI
     test_wolfSSL_UseSNI_params();
     test_wolfSSL_UseSNI_connection();
+#if defined(WOLFSSL_SNI_TABLE) && !defined(NO_WOLFSSL_SERVER) && \
+    defined(HAVE_ECC) && !defined(NO_RSA)
+    test_wolfSSL_SNI_AddCert_params();
+    test_wolfSSL_SNI_AddCert_connection();
+#endif
 
     test_wolfSSL_SNI_GetFromBuffer();
 #endif
@@ -4428,6 +5095,399 @@ static void test_wolfSSL_UseSNI(void)
 
 #endif /* HAVE_IO_TESTS_DEPENDENCIES */
 
+#if defined(WOLFSSL_HANDSHAKE_TIMING) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+static void verify_handshake_timing(WOLFSSL* ssl)
+{
+    WOLFSSL_HS_TIMING timing;
+    word32 buckets[WOLFSSL_HST_BUCKETS];
+    word32 handshakes = 0;
+    word64 total;
+    int    i;
+    /* handshake message types */
+    const int clientHello = 1, serverHello = 2, finishedMsg = 20;
+
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_get_handshake_timing(ssl, &timing));
+    total = timing.opNs[WOLFSSL_HST_TOTAL];
+    AssertIntEQ(1, timing.opCount[WOLFSSL_HST_TOTAL]);
+    AssertTrue(total > 0);
+    for (i = 0; i < WOLFSSL_HST_OP_COUNT; i++)
+        AssertTrue(timing.opNs[i] <= total);
+    for (i = 0; i < WOLFSSL_HST_MSG_COUNT; i++)
+        AssertTrue(timing.msgNs[i] <= total);
+
+    /* ECDHE both ways */
+    AssertIntGT(timing.opCount[WOLFSSL_HST_KEYSHARE_GEN], 0);
+    AssertIntGT(timing.opCount[WOLFSSL_HST_KEY_AGREE], 0);
+    AssertTrue(timing.msgNs[finishedMsg] > 0);
+    /* the server signs its key exchange and the client its certificate
+     * verify, the check of an RSA signature made is not timed again */
+    AssertIntEQ(1, timing.opCount[WOLFSSL_HST_SIGN]);
+    if (wolfSSL_is_server(ssl)) {
+        AssertTrue(timing.msgNs[clientHello] > 0);
+        AssertTrue(timing.msgNs[clientHello] < timing.msgNs[finishedMsg]);
+    }
+    else {
+        AssertIntGT(timing.opCount[WOLFSSL_HST_VERIFY], 0);
+        AssertIntGT(timing.opCount[WOLFSSL_HST_CERT_VERIFY], 0);
+        AssertTrue(timing.msgNs[serverHello] > 0);
+        AssertTrue(timing.msgNs[serverHello] < timing.msgNs[finishedMsg]);
+    }
+
+    /* the CTX saw just this handshake */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_handshake_histogram(
+              wolfSSL_get_SSL_CTX(ssl), WOLFSSL_HST_TOTAL, buckets,
+              WOLFSSL_HST_BUCKETS));
+    for (i = 0; i < WOLFSSL_HST_BUCKETS; i++)
+        handshakes += buckets[i];
+    AssertIntEQ(1, handshakes);
+}
+#endif
+
+static void test_wolfSSL_handshake_timing(void)
+{
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+    WOLFSSL_CTX*      ctx;
+    WOLFSSL*          ssl;
+    WOLFSSL_HS_TIMING timing;
+    word32            buckets[WOLFSSL_HST_BUCKETS];
+    int               i;
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    callback_functions client_cb = {0, 0, 0, verify_handshake_timing, 0, 0};
+    callback_functions server_cb = {0, 0, 0, verify_handshake_timing, 0, 0};
+#endif
+
+#ifndef NO_WOLFSSL_CLIENT
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+#else
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+#endif
+    AssertNotNull(ssl = wolfSSL_new(ctx));
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_get_handshake_timing(NULL, &timing));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_get_handshake_timing(ssl, NULL));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_handshake_histogram(NULL,
+                      WOLFSSL_HST_TOTAL, buckets, WOLFSSL_HST_BUCKETS));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_handshake_histogram(ctx,
+                      WOLFSSL_HST_OP_COUNT, buckets, WOLFSSL_HST_BUCKETS));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_handshake_histogram(ctx,
+                      WOLFSSL_HST_TOTAL, NULL, WOLFSSL_HST_BUCKETS));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_handshake_histogram(ctx,
+                      WOLFSSL_HST_TOTAL, buckets, WOLFSSL_HST_BUCKETS - 1));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_reset_handshake_histogram(NULL));
+
+    /* nothing timed before a handshake */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_get_handshake_timing(ssl, &timing));
+    for (i = 0; i < WOLFSSL_HST_OP_COUNT; i++)
+        AssertIntEQ(0, timing.opCount[i]);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_reset_handshake_histogram(ctx));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_handshake_histogram(ctx,
+                      WOLFSSL_HST_TOTAL, buckets, WOLFSSL_HST_BUCKETS));
+    for (i = 0; i < WOLFSSL_HST_BUCKETS; i++)
+        AssertIntEQ(0, buckets[i]);
+
+    wolfSSL_free(ssl);
+    wolfSSL_CTX_free(ctx);
+
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    test_wolfSSL_client_server_versions(&client_cb, &server_cb, 1);
+#endif
+#endif /* WOLFSSL_HANDSHAKE_TIMING */
+}
+
+#if defined(WOLFSSL_PERF_COUNTERS) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+static void verify_perf_stats(WOLFSSL* ssl)
+{
+    WOLFSSL_PERF_STATS stats;
+    WOLFSSL_PERF_STATS global;
+
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_perf_stats(
+                                      wolfSSL_get_SSL_CTX(ssl), &stats));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_get_perf_stats(&global));
+
+    /* one full handshake then a message each way on this CTX */
+    AssertTrue(stats.fullHandshakes == 1);
+    AssertTrue(stats.resumedHandshakes == 0);
+    AssertTrue(stats.recordsEncrypted > 0);
+    AssertTrue(stats.recordsDecrypted > 0);
+    AssertTrue(stats.bytesEncrypted > 0);
+    AssertTrue(stats.bytesDecrypted > 0);
+    AssertTrue(stats.sessionCacheHits == 0);
+    /* close_notify is sent by the server after this */
+    AssertTrue(stats.alertsSent == 0);
+    AssertTrue(stats.alertsReceived == 0);
+
+    /* library counters include this CTX */
+    AssertTrue(global.fullHandshakes >= stats.fullHandshakes);
+    AssertTrue(global.recordsEncrypted >= stats.recordsEncrypted);
+    AssertTrue(global.bytesDecrypted >= stats.bytesDecrypted);
+}
+
+static WOLFSSL_SESSION* perfSession = NULL;
+
+static void use_perf_session(WOLFSSL* ssl)
+{
+    if (perfSession != NULL)
+        AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_set_session(ssl, perfSession));
+}
+
+static void verify_perf_resumed(WOLFSSL* ssl)
+{
+    WOLFSSL_PERF_STATS stats;
+
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_perf_stats(
+                                      wolfSSL_get_SSL_CTX(ssl), &stats));
+
+    /* the CTX made a full handshake then resumed it */
+    AssertTrue(stats.fullHandshakes == 1);
+    AssertTrue(stats.resumedHandshakes == 1);
+    AssertTrue(stats.alertsReceived == 0);
+    if (wolfSSL_is_server(ssl)) {
+        AssertTrue(stats.sessionCacheHits == 1);
+        AssertTrue(stats.sessionCacheMisses == 0);
+        /* close_notify of the first connection */
+        AssertTrue(stats.alertsSent == 1);
+    }
+    else {
+        AssertTrue(stats.alertsSent == 0);
+    }
+}
+
+/* the first connection on the CTXs is a full handshake and the client keeps
+ * its session for the second to resume */
+static void verify_perf_connection(WOLFSSL* ssl)
+{
+    if (!wolfSSL_session_reused(ssl)) {
+        verify_perf_stats(ssl);
+        /* a TLS 1.3 ticket came in with the reply read */
+        if (!wolfSSL_is_server(ssl))
+            AssertNotNull(perfSession = wolfSSL_get_session(ssl));
+    }
+    else {
+        verify_perf_resumed(ssl);
+        if (!wolfSSL_is_server(ssl))
+            perfSession = NULL;
+    }
+}
+#endif
+
+static void test_wolfSSL_perf_stats(void)
+{
+#ifdef WOLFSSL_PERF_COUNTERS
+    WOLFSSL_CTX*       ctx;
+    WOLFSSL_PERF_STATS stats;
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    callback_functions client_cb = {
+        0, 0, use_perf_session, verify_perf_connection, 0, 0};
+    callback_functions server_cb = {0, 0, 0, verify_perf_connection, 0, 0};
+#endif
+
+#ifndef NO_WOLFSSL_CLIENT
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+#else
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+#endif
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_perf_stats(NULL, &stats));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_perf_stats(ctx, NULL));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_reset_perf_stats(NULL));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_get_perf_stats(NULL));
+
+    /* nothing counted on a new CTX */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_perf_stats(ctx, &stats));
+    AssertTrue(stats.fullHandshakes == 0);
+    AssertTrue(stats.recordsEncrypted == 0);
+    AssertTrue(stats.bufferGrows == 0);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_reset_perf_stats(ctx));
+
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_reset_perf_stats());
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_get_perf_stats(&stats));
+    AssertTrue(stats.fullHandshakes == 0);
+    AssertTrue(stats.bytesEncrypted == 0);
+
+    wolfSSL_CTX_free(ctx);
+
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    /* the second connection on the CTXs resumes the first */
+    test_wolfSSL_client_server_versions(&client_cb, &server_cb, 2);
+#endif
+#endif /* WOLFSSL_PERF_COUNTERS */
+}
+
+#if defined(WOLFSSL_MEM_TYPE_STATS) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+static void verify_mem_stats_owner(WOLFSSL* ssl)
+{
+    WC_MEM_TYPE_STATS stats;
+
+    /* connect or accept, write and read gave the thread's owner back */
+    AssertIntEQ(0, wc_MemStatsSetOwner(0));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_mem_stats(
+                  wolfSSL_get_SSL_CTX(ssl), DYNAMIC_TYPE_SSL, &stats));
+    AssertTrue(stats.curAllocs == 1);
+}
+#endif
+
+static void test_wolfSSL_CTX_get_mem_stats(void)
+{
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    WOLFSSL_CTX*      ctx;
+    WOLFSSL*          ssl;
+    WC_MEM_TYPE_STATS stats;
+    WC_MEM_TYPE_STATS all;
+    word64            sslSz;
+    byte*             p;
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    callback_functions client_cb = {
+        wolfSSLv23_client_method, 0, 0, verify_mem_stats_owner, 0, 0};
+    callback_functions server_cb = {
+        wolfSSLv23_server_method, 0, 0, verify_mem_stats_owner, 0, 0};
+#endif
+
+#ifndef NO_WOLFSSL_CLIENT
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+#else
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+#endif
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_mem_stats(NULL,
+                                                 DYNAMIC_TYPE_SSL, &stats));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_mem_stats(ctx,
+                                                 DYNAMIC_TYPE_SSL, NULL));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_get_mem_stats(ctx,
+                                                 WC_MEM_TYPE_COUNT, &stats));
+    AssertIntEQ(BAD_FUNC_ARG, wc_MemStatsGet(WC_MEM_STATS_OWNERS,
+                                                 DYNAMIC_TYPE_SSL, &stats));
+
+    /* the calls charge the CTX only while they run */
+    AssertIntEQ(0, wc_MemStatsSetOwner(0));
+
+    /* the SSL object is charged to its CTX and to the library */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_mem_stats(ctx,
+                                                 DYNAMIC_TYPE_SSL, &stats));
+    AssertTrue(stats.curAllocs == 0);
+    AssertTrue(stats.curBytes == 0);
+    AssertNotNull(ssl = wolfSSL_new(ctx));
+    AssertIntEQ(0, wc_MemStatsSetOwner(0));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_mem_stats(ctx,
+                                                 DYNAMIC_TYPE_SSL, &stats));
+    AssertTrue(stats.curAllocs == 1);
+    AssertTrue(stats.totalAllocs == 1);
+    AssertTrue(stats.curBytes > 0);
+    AssertTrue(stats.peakBytes == stats.curBytes);
+    sslSz = stats.curBytes;
+    AssertIntEQ(0, wc_MemStatsGet(0, DYNAMIC_TYPE_SSL, &all));
+    AssertTrue(all.curBytes >= stats.curBytes);
+    wolfSSL_free(ssl);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_mem_stats(ctx,
+                                                 DYNAMIC_TYPE_SSL, &stats));
+    AssertTrue(stats.curAllocs == 0);
+    AssertTrue(stats.curBytes == 0);
+    AssertTrue(stats.peakBytes == sslSz);
+
+    /* realloc moves the bytes, counted under the new size */
+    AssertIntEQ(0, wc_MemStatsGet(0, DYNAMIC_TYPE_TMP_BUFFER, &all));
+    AssertNotNull(p = (byte*)XMALLOC(100, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    AssertNotNull(p = (byte*)XREALLOC(p, 300, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    AssertIntEQ(0, wc_MemStatsGet(0, DYNAMIC_TYPE_TMP_BUFFER, &stats));
+    AssertTrue(stats.curBytes - all.curBytes == 300);
+    AssertTrue(stats.curAllocs - all.curAllocs == 1);
+    XFREE(p, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+#if !defined(NO_FILESYSTEM) && !defined(NO_STDIO_FILESYSTEM)
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_print_mem_stats(NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_print_mem_stats(ctx));
+#endif
+
+    wolfSSL_CTX_free(ctx);
+
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    test_wolfSSL_client_server(&client_cb, &server_cb);
+#endif
+#endif /* WOLFSSL_MEM_TYPE_STATS */
+}
+
+#if defined(WOLFSSL_HANDSHAKE_ARENA) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+static void verify_hs_arena_stats(WOLFSSL* ssl)
+{
+    word32 peak = 0;
+    word32 fallbacks = 1;
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    WC_MEM_TYPE_STATS stats;
+#endif
+
+    /* hashes, arrays and keys of the handshake came from the arena */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_get_hs_arena_stats(ssl, &peak,
+                                                            &fallbacks));
+    AssertTrue(peak >= sizeof(Arrays));
+    AssertTrue(fallbacks == 0);
+
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    /* all freed with the handshake done and the chunk given back */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_mem_stats(
+              wolfSSL_get_SSL_CTX(ssl), DYNAMIC_TYPE_HS_ARENA, &stats));
+    AssertTrue(stats.totalAllocs == 1);
+    AssertTrue(stats.curAllocs == 0);
+#endif
+}
+#endif
+
+static void test_wolfSSL_get_hs_arena_stats(void)
+{
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+    WOLFSSL_CTX* ctx;
+    WOLFSSL*     ssl;
+    word32       peak = 0;
+    word32       fallbacks = 1;
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    WC_MEM_TYPE_STATS stats;
+#endif
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    callback_functions client_cb = {0, 0, 0, verify_hs_arena_stats, 0, 0};
+    callback_functions server_cb = {0, 0, 0, verify_hs_arena_stats, 0, 0};
+#endif
+
+#ifndef NO_WOLFSSL_CLIENT
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+#else
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+#endif
+    AssertNotNull(ssl = wolfSSL_new(ctx));
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_get_hs_arena_stats(NULL, &peak,
+                                                         &fallbacks));
+
+    /* nothing comes from the arena and no chunk is held until a handshake
+     * starts */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_get_hs_arena_stats(ssl, &peak,
+                                                            &fallbacks));
+    AssertTrue(peak == 0);
+    AssertTrue(fallbacks == 0);
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_get_mem_stats(ctx,
+                                            DYNAMIC_TYPE_HS_ARENA, &stats));
+    AssertTrue(stats.totalAllocs == 0);
+#endif
+
+    wolfSSL_free(ssl);
+    wolfSSL_CTX_free(ctx);
+
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN))
+    test_wolfSSL_client_server_versions(&client_cb, &server_cb, 1);
+#endif
+#endif /* WOLFSSL_HANDSHAKE_ARENA */
+}
+
 static void test_wolfSSL_UseTrustedCA(void)
 {
 #if defined(HAVE_TRUSTED_CA) && !defined(NO_CERTS) && !defined(NO_FILESYSTEM)
@@ -4965,7 +6025,7 @@ static void test_wolfSSL_PKCS12(void)
 #if defined(OPENSSL_EXTRA) && !defined(NO_DES3) && !defined(NO_FILESYSTEM) && \
     !defined(NO_ASN) && !defined(NO_PWDBASED) && !defined(NO_RSA) && \
     !defined(NO_SHA)
-    byte buffer[6000];
+    byte buff[6000];
     char file[] = "./certs/test-servercert.p12";
     char order[] = "./certs/ecc-rsa-server.p12";
 #ifdef WC_RC2
@@ -4996,10 +6056,10 @@ static void test_wolfSSL_PKCS12(void)
 
     f = XFOPEN(file, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
 
-    bio = BIO_new_mem_buf((void*)buffer, bytes);
+    bio = BIO_new_mem_buf((void*)buff, bytes);
     AssertNotNull(bio);
 
     pkcs12 = d2i_PKCS12_bio(bio, NULL);
@@ -5136,10 +6196,10 @@ static void test_wolfSSL_PKCS12(void)
     /* test order of parsing */
     f = XFOPEN(order, "rb");
     AssertTrue(f != XBADFILE);
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
 
-    AssertNotNull(bio = BIO_new_mem_buf((void*)buffer, bytes));
+    AssertNotNull(bio = BIO_new_mem_buf((void*)buff, bytes));
     AssertNotNull(pkcs12 = d2i_PKCS12_bio(bio, NULL));
     AssertIntEQ((ret = PKCS12_parse(pkcs12, "", &pkey, &cert, &ca)),
             WOLFSSL_SUCCESS);
@@ -5219,10 +6279,10 @@ static void test_wolfSSL_PKCS12(void)
     /* test PKCS#12 with RC2 encryption */
     f = XFOPEN(rc2p12, "rb");
     AssertTrue(f != XBADFILE);
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
 
-    AssertNotNull(bio = BIO_new_mem_buf((void*)buffer, bytes));
+    AssertNotNull(bio = BIO_new_mem_buf((void*)buff, bytes));
     AssertNotNull(pkcs12 = d2i_PKCS12_bio(bio, NULL));
 
     /* check verify MAC fail case */
@@ -5312,7 +6372,7 @@ static void test_wolfSSL_no_password_cb(void)
 #if !defined(NO_FILESYSTEM) && !defined(NO_ASN) && defined(HAVE_PKCS8) \
     && defined(HAVE_ECC) && defined(WOLFSSL_ENCRYPTED_KEYS)
     WOLFSSL_CTX* ctx;
-    byte buffer[FOURK_BUF];
+    byte buff[FOURK_BUF];
     const char eccPkcs8PrivKeyDerFile[] = "./certs/ecc-privkeyPkcs8.der";
     const char eccPkcs8PrivKeyPemFile[] = "./certs/ecc-privkeyPkcs8.pem";
     XFILE f;
@@ -5328,17 +6388,17 @@ static void test_wolfSSL_no_password_cb(void)
     wolfSSL_CTX_set_default_passwd_cb(ctx, FailTestCallBack);
 
     AssertTrue((f = XFOPEN(eccPkcs8PrivKeyDerFile, "rb")) != XBADFILE);
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
-    AssertIntLE(bytes, sizeof(buffer));
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntLE(bytes, sizeof(buff));
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
 
     AssertTrue((f = XFOPEN(eccPkcs8PrivKeyPemFile, "rb")) != XBADFILE);
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
-    AssertIntLE(bytes, sizeof(buffer));
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntLE(bytes, sizeof(buff));
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 
     wolfSSL_CTX_free(ctx);
@@ -5381,7 +6441,7 @@ static int PKCS8TestCallBack(char* passwd, int sz, int rw, void* userdata)
 static void test_wolfSSL_PKCS8(void)
 {
 #if !defined(NO_FILESYSTEM) && !defined(NO_ASN) && defined(HAVE_PKCS8)
-    byte buffer[FOURK_BUF];
+    byte buff[FOURK_BUF];
     byte der[FOURK_BUF];
     #ifndef NO_RSA
         const char serverKeyPkcs8PemFile[] = "./certs/server-keyPkcs8.pem";
@@ -5436,36 +6496,36 @@ static void test_wolfSSL_PKCS8(void)
     /* test loading PEM PKCS8 encrypted file */
     f = XFOPEN(serverKeyPkcs8EncPemFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 
     /* this next case should fail because of password callback return code */
     flag = 0; /* used by password callback as return code */
-    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 
     /* decrypt PKCS8 PEM to key in DER format with not using WOLFSSL_CTX */
-    AssertIntGT(wc_KeyPemToDer(buffer, bytes, der, (word32)sizeof(der),
+    AssertIntGT(wc_KeyPemToDer(buff, bytes, der, (word32)sizeof(der),
         "yassl123"), 0);
 
     /* test that error value is returned with a bad password */
-    AssertIntLT(wc_KeyPemToDer(buffer, bytes, der, (word32)sizeof(der),
+    AssertIntLT(wc_KeyPemToDer(buff, bytes, der, (word32)sizeof(der),
         "bad"), 0);
 
     /* test loading PEM PKCS8 encrypted file */
     f = XFOPEN(serverKeyPkcs8EncDerFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
     flag = 1; /* used by password callback as return code */
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
 
     /* this next case should fail because of password callback return code */
     flag = 0; /* used by password callback as return code */
-    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
     #endif /* !NO_RSA && !NO_SHA */
 
@@ -5473,37 +6533,37 @@ static void test_wolfSSL_PKCS8(void)
     /* test loading PEM PKCS8 encrypted ECC Key file */
     f = XFOPEN(eccPkcs8EncPrivKeyPemFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
     flag = 1; /* used by password callback as return code */
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 
     /* this next case should fail because of password callback return code */
     flag = 0; /* used by password callback as return code */
-    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 
     /* decrypt PKCS8 PEM to key in DER format with not using WOLFSSL_CTX */
-    AssertIntGT(wc_KeyPemToDer(buffer, bytes, der, (word32)sizeof(der),
+    AssertIntGT(wc_KeyPemToDer(buff, bytes, der, (word32)sizeof(der),
         "yassl123"), 0);
 
     /* test that error value is returned with a bad password */
-    AssertIntLT(wc_KeyPemToDer(buffer, bytes, der, (word32)sizeof(der),
+    AssertIntLT(wc_KeyPemToDer(buff, bytes, der, (word32)sizeof(der),
         "bad"), 0);
 
     /* test loading DER PKCS8 encrypted ECC Key file */
     f = XFOPEN(eccPkcs8EncPrivKeyDerFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
     flag = 1; /* used by password callback as return code */
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
 
     /* this next case should fail because of password callback return code */
     flag = 0; /* used by password callback as return code */
-    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntNE(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
 
     /* leave flag as "okay" */
@@ -5516,32 +6576,32 @@ static void test_wolfSSL_PKCS8(void)
     /* test loading ASN.1 (DER) PKCS8 private key file (not encrypted) */
     f = XFOPEN(serverKeyPkcs8DerFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
 
     /* test loading PEM PKCS8 private key file (not encrypted) */
     f = XFOPEN(serverKeyPkcs8PemFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 #endif /* !NO_RSA */
 
     /* Test PKCS8 PEM ECC key no crypt */
     f = XFOPEN(eccPkcs8PrivKeyPemFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
 #ifdef HAVE_ECC
     /* Test PKCS8 PEM ECC key no crypt */
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
 
     /* decrypt PKCS8 PEM to key in DER format */
-    AssertIntGT((bytes = wc_KeyPemToDer(buffer, bytes, der,
+    AssertIntGT((bytes = wc_KeyPemToDer(buff, bytes, der,
         (word32)sizeof(der), NULL)), 0);
     ret = wc_ecc_init(&key);
     if (ret == 0) {
@@ -5553,15 +6613,15 @@ static void test_wolfSSL_PKCS8(void)
     /* Test PKCS8 DER ECC key no crypt */
     f = XFOPEN(eccPkcs8PrivKeyDerFile, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
 
     /* Test using a PKCS8 ECC PEM */
-    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buffer, bytes,
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_buffer(ctx, buff, bytes,
                 WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
 #else
     /* if HAVE_ECC is not defined then BEGIN EC PRIVATE KEY is not found */
-    AssertIntEQ((bytes = wc_KeyPemToDer(buffer, bytes, der,
+    AssertIntEQ((bytes = wc_KeyPemToDer(buff, bytes, der,
         (word32)sizeof(der), NULL)), ASN_NO_PEM_HEADER);
 #endif /* HAVE_ECC */
 
@@ -5722,7 +6782,7 @@ static void test_wolfSSL_X509_verify(void)
 #if !defined(NO_CERTS) && !defined(NO_RSA) && !defined(NO_FILESYSTEM) \
     && defined(OPENSSL_EXTRA)
     WOLFSSL_X509* ca;
-    WOLFSSL_X509* server;
+    WOLFSSL_X509* serv;
     WOLFSSL_EVP_PKEY* pkey;
     unsigned char buf[2048];
     const unsigned char* pt = NULL;
@@ -5746,7 +6806,7 @@ static void test_wolfSSL_X509_verify(void)
     AssertIntEQ(wolfSSL_X509_get_pubkey_type(ca), RSAk);
 
 
-    AssertNotNull(server =
+    AssertNotNull(serv =
           wolfSSL_X509_load_certificate_file(svrCertFile, WOLFSSL_FILETYPE_PEM));
 
     /* success case */
@@ -5755,23 +6815,23 @@ static void test_wolfSSL_X509_verify(void)
 
     AssertIntEQ(i2d_PUBKEY(pkey, NULL), bufSz);
 
-    AssertIntEQ(wolfSSL_X509_verify(server, pkey), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_X509_verify(serv, pkey), WOLFSSL_SUCCESS);
     wolfSSL_EVP_PKEY_free(pkey);
 
     /* fail case */
     bufSz = 2048;
-    AssertIntEQ(wolfSSL_X509_get_pubkey_buffer(server, buf, &bufSz),
+    AssertIntEQ(wolfSSL_X509_get_pubkey_buffer(serv, buf, &bufSz),
             WOLFSSL_SUCCESS);
     pt = buf;
     AssertNotNull(pkey = wolfSSL_d2i_PUBKEY(NULL, &pt, bufSz));
-    AssertIntEQ(wolfSSL_X509_verify(server, pkey), WOLFSSL_FAILURE);
+    AssertIntEQ(wolfSSL_X509_verify(serv, pkey), WOLFSSL_FAILURE);
 
     AssertIntEQ(wolfSSL_X509_verify(NULL, pkey), WOLFSSL_FATAL_ERROR);
-    AssertIntEQ(wolfSSL_X509_verify(server, NULL), WOLFSSL_FATAL_ERROR);
+    AssertIntEQ(wolfSSL_X509_verify(serv, NULL), WOLFSSL_FATAL_ERROR);
     wolfSSL_EVP_PKEY_free(pkey);
 
     wolfSSL_FreeX509(ca);
-    wolfSSL_FreeX509(server);
+    wolfSSL_FreeX509(serv);
 
     printf(resultFmt, passed);
 #endif
@@ -6032,6 +7092,226 @@ static int test_wolfSSL_CTX_SetMinVersion(void)
  *----------------------------------------------------------------------------*/
 
 
+#if defined(HAVE_OCSP) && !defined(NO_FILESYSTEM) && !defined(NO_RSA) && \
+    !defined(NO_SHA) && defined(WOLFSSL_PEM_TO_DER) && !defined(NO_ASN_TIME)
+static byte* ocspTestResp = NULL;  /* response served by the IO callback */
+static int   ocspTestRespSz = 0;
+static int   ocspTestIOCalls = 0;
+
+static int test_OcspRespIOCb(void* ctx, const char* url, int urlSz,
+                              unsigned char* req, int reqSz,
+                              unsigned char** resp)
+{
+    (void)ctx;
+    (void)url;
+    (void)urlSz;
+    (void)req;
+    (void)reqSz;
+
+    ocspTestIOCalls++;
+    *resp = ocspTestResp;
+
+    return ocspTestRespSz;
+}
+
+/* Checks the certificate with the response the responder will answer with.
+ * Returns the number of responder calls made, or -1 when the check failed. */
+static int test_OcspCacheCheck(WOLFSSL_CERT_MANAGER* cm, DerBuffer* cert,
+                               byte* resp, size_t respSz)
+{
+    int calls = ocspTestIOCalls;
+
+    ocspTestResp = resp;
+    ocspTestRespSz = (int)respSz;
+    if (wolfSSL_CertManagerCheckOCSP(cm, cert->buffer, (int)cert->length)
+            != WOLFSSL_SUCCESS)
+        return -1;
+
+    return ocspTestIOCalls - calls;
+}
+#endif
+
+static void test_wolfSSL_CertManagerOCSPCache(void)
+{
+#if defined(HAVE_OCSP) && !defined(NO_FILESYSTEM) && !defined(NO_RSA) && \
+    !defined(NO_SHA) && defined(WOLFSSL_PEM_TO_DER) && !defined(NO_ASN_TIME)
+    const char* certFiles[] = {
+        "./certs/ocsp/server1-cert.pem",           /* intermediate CA 1 */
+        "./certs/ocsp/server3-cert.pem",           /* intermediate CA 2 */
+        "./certs/ocsp/intermediate1-ca-cert.pem",  /* root CA */
+    };
+    const char* respFiles[] = {
+        "./certs/ocsp/server1-resp.der",
+        "./certs/ocsp/server3-resp.der",
+        "./certs/ocsp/intermediate1-ca-resp.der",
+    };
+    WOLFSSL_CERT_MANAGER* cm;
+    DerBuffer* cert[3] = { NULL, NULL, NULL };
+    byte*      resp[3] = { NULL, NULL, NULL };
+    size_t     respSz[3];
+    byte*      buf;
+    size_t     bufSz;
+    CertStatus* status;
+    int i;
+
+    printf(testingFmt, "wolfSSL_CertManagerOCSPCache()");
+
+    for (i = 0; i < 3; i++) {
+        AssertIntEQ(load_file(certFiles[i], &buf, &bufSz), 0);
+        AssertIntEQ(wc_PemToDer(buf, (long)bufSz, CERT_TYPE, &cert[i], NULL,
+                                NULL, NULL), 0);
+        free(buf);
+        AssertIntEQ(load_file(respFiles[i], &resp[i], &respSz[i]), 0);
+    }
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm,
+                "./certs/ocsp/intermediate1-ca-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCA(cm,
+                "./certs/ocsp/intermediate2-ca-cert.pem", NULL),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerEnableOCSP(cm, WOLFSSL_OCSP_URL_OVERRIDE |
+                WOLFSSL_OCSP_NO_NONCE), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerSetOCSPOverrideURL(cm,
+                "http://127.0.0.1:22221"), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerSetOCSP_Cb(cm, test_OcspRespIOCb, NULL,
+                NULL), WOLFSSL_SUCCESS);
+
+    /* each certificate is fetched once and then found in the cache */
+    for (i = 0; i < 3; i++)
+        AssertIntEQ(test_OcspCacheCheck(cm, cert[i], resp[i], respSz[i]), 1);
+    AssertIntEQ(cm->ocsp->ocspCount, 3);
+    for (i = 0; i < 3; i++)
+        AssertIntEQ(test_OcspCacheCheck(cm, cert[i], NULL, 0), 0);
+
+    /* the lookup is keyed on the certificate, not any cached neighbour */
+    AssertIntEQ(wolfSSL_CertManagerSetOCSPCacheSize(cm, 1), WOLFSSL_SUCCESS);
+    AssertIntEQ(cm->ocsp->ocspCount, 1);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[0], resp[1], respSz[1]), -1);
+
+    /* filling past the cap evicts the least recently used response */
+    AssertIntEQ(wolfSSL_CertManagerSetOCSPCacheSize(cm, 2), WOLFSSL_SUCCESS);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[0], resp[0], respSz[0]), 1);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[2], NULL, 0), 0);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[1], resp[1], respSz[1]), 1);
+    AssertIntEQ(cm->ocsp->ocspCount, 2);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[2], NULL, 0), 0);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[1], NULL, 0), 0);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[0], resp[0], respSz[0]), 1);
+    AssertIntEQ(cm->ocsp->ocspCount, 2);
+
+    /* a response past its nextUpdate is dropped and fetched again */
+    AssertNotNull(cm->ocsp->ocspList);
+    status = cm->ocsp->ocspList->status;
+    XMEMCPY(status->nextDate, status->thisDate, MAX_DATE_SIZE);
+    status->nextDateFormat = status->thisDateFormat;
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[0], resp[0], respSz[0]), 1);
+    AssertIntEQ(test_OcspCacheCheck(cm, cert[0], NULL, 0), 0);
+    AssertIntEQ(cm->ocsp->ocspCount, 2);
+
+    wolfSSL_CertManagerFree(cm);
+    for (i = 0; i < 3; i++) {
+        wc_FreeDer(&cert[i]);
+        free(resp[i]);
+    }
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if defined(HAVE_OCSP_STAPLING_REFRESH) && \
+    defined(HAVE_CERTIFICATE_STATUS_REQUEST) && \
+    defined(HAVE_IO_TESTS_DEPENDENCIES) && !defined(NO_SHA) && \
+    defined(WOLFSSL_PEM_TO_DER) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN) || defined(WOLFSSL_SESSION_EXPORT))
+static void test_OcspStaplingRefresh_server_ctx_ready(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(wolfSSL_CTX_use_certificate_file(ctx,
+                "./certs/ocsp/server1-cert.pem", WOLFSSL_FILETYPE_PEM),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx,
+                "./certs/ocsp/server1-key.pem", WOLFSSL_FILETYPE_PEM),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx,
+                "./certs/ocsp/intermediate1-ca-cert.pem", 0), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStapling(ctx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetOCSP_Cb(ctx, test_OcspRespIOCb, NULL, NULL),
+                WOLFSSL_SUCCESS);
+
+    /* the staple is fetched once up front */
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStaplingRefresh(ctx), WOLFSSL_SUCCESS);
+    AssertIntEQ(ocspTestIOCalls, 1);
+}
+
+static void test_OcspStaplingRefresh_server_on_result(WOLFSSL* ssl)
+{
+    (void)ssl;
+
+    /* and served from memory during the handshake */
+    AssertIntEQ(ocspTestIOCalls, 1);
+}
+
+static void test_OcspStaplingRefresh_client_ctx_ready(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(wolfSSL_CTX_load_verify_locations(ctx,
+                "./certs/ocsp/intermediate1-ca-cert.pem", 0), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPStapling(ctx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_EnableOCSPMustStaple(ctx), WOLFSSL_SUCCESS);
+}
+
+static void test_OcspStaplingRefresh_client_ssl_ready(WOLFSSL* ssl)
+{
+    AssertIntEQ(wolfSSL_UseOCSPStapling(ssl, WOLFSSL_CSR_OCSP, 0),
+                WOLFSSL_SUCCESS);
+}
+
+static void test_OcspStaplingRefresh_client_on_result(WOLFSSL* ssl)
+{
+    /* must staple, only completes with the refreshed response */
+    AssertIntEQ(wolfSSL_is_init_finished(ssl), 1);
+}
+#endif
+
+static void test_wolfSSL_OCSPStaplingRefresh_handshake(void)
+{
+#if defined(HAVE_OCSP_STAPLING_REFRESH) && \
+    defined(HAVE_CERTIFICATE_STATUS_REQUEST) && \
+    defined(HAVE_IO_TESTS_DEPENDENCIES) && !defined(NO_SHA) && \
+    defined(WOLFSSL_PEM_TO_DER) && \
+    (defined(HAVE_SNI) || defined(HAVE_ALPN) || defined(WOLFSSL_SESSION_EXPORT))
+    callback_functions client_cb;
+    callback_functions server_cb;
+    byte*  resp;
+    size_t respSz;
+
+    printf(testingFmt, "wolfSSL_OCSPStaplingRefresh_handshake()");
+
+    AssertIntEQ(load_file("./certs/ocsp/server1-resp.der", &resp, &respSz), 0);
+    ocspTestResp = resp;
+    ocspTestRespSz = (int)respSz;
+    ocspTestIOCalls = 0;
+
+    XMEMSET(&client_cb, 0, sizeof(callback_functions));
+    XMEMSET(&server_cb, 0, sizeof(callback_functions));
+    client_cb.method    = wolfSSLv23_client_method;
+    client_cb.ctx_ready = test_OcspStaplingRefresh_client_ctx_ready;
+    client_cb.ssl_ready = test_OcspStaplingRefresh_client_ssl_ready;
+    client_cb.on_result = test_OcspStaplingRefresh_client_on_result;
+    server_cb.method    = wolfSSLv23_server_method;
+    server_cb.ctx_ready = test_OcspStaplingRefresh_server_ctx_ready;
+    server_cb.on_result = test_OcspStaplingRefresh_server_on_result;
+
+    test_wolfSSL_client_server(&client_cb, &server_cb);
+
+    ocspTestResp = NULL;
+    ocspTestRespSz = 0;
+    free(resp);
+
+    printf(resultFmt, passed);
+#endif
+}
+
 /* Testing wolfSSL_UseOCSPStapling function. OCSP stapling eliminates the need
  * need to contact the CA, lowering the cost of cert revocation checking.
  * PRE: HAVE_OCSP and HAVE_CERTIFICATE_STATUS_REQUEST
@@ -22119,6 +23399,353 @@ static int test_wc_ecc_sig_size_calc (void)
 #endif
     return ret;
 } /* END test_wc_ecc_sig_size_calc */
+
+#if defined(WOLF_CRYPTO_CB_POOL) && defined(HAVE_ECC) && !defined(NO_RSA) && \
+    !defined(WC_NO_RNG) && !defined(NO_SHA256) && defined(USE_CERT_BUFFERS_2048)
+/* Poll pool until the operation on key is done, returns its result */
+static int crypto_cb_pool_wait(WC_CRYPTOCB_POOL* pool, void* key)
+{
+    WOLF_EVENT* events[4];
+    long tries;
+    int  count;
+    int  i;
+
+    for (tries = 0; tries < (1L << 26); tries++) {
+        AssertIntEQ(0, wc_CryptoCb_PoolPoll(pool, events, 4, &count));
+        for (i = 0; i < count; i++) {
+            AssertIntEQ(WOLF_EVENT_STATE_DONE, events[i]->state);
+            if (events[i]->context == key)
+                return events[i]->ret;
+        }
+    }
+
+    return WC_TIMEOUT_E;
+}
+#endif
+
+/*
+ * Testing wc_CryptoCb_PoolNew(), wc_CryptoCb_PoolPoll() and
+ * wc_CryptoCb_PoolFree()
+ */
+static void test_wc_CryptoCb_Pool(void)
+{
+#if defined(WOLF_CRYPTO_CB_POOL) && defined(HAVE_ECC) && !defined(NO_RSA) && \
+    !defined(WC_NO_RNG) && !defined(NO_SHA256) && defined(USE_CERT_BUFFERS_2048)
+    const int         poolDevId = 10;
+    WC_CRYPTOCB_POOL* pool;
+#ifndef NO_WOLFSSL_CLIENT
+    WOLFSSL_CTX*      ctx;
+    WOLFSSL*          ssl;
+#endif
+    WOLF_EVENT*       events[1];
+    WC_RNG            rng;
+    ecc_key           key;
+    ecc_key           peer;
+    RsaKey            rsa;
+    RsaKey            rsaSw;
+    byte              hash[WC_SHA256_DIGEST_SIZE];
+    byte              sig[ECC_MAX_SIG_SIZE];
+    byte              secret[MAX_ECC_BYTES];
+    byte              peerSecret[MAX_ECC_BYTES];
+    byte              rsaSig[256];
+    byte              plain[256];
+    word32            sigSz = sizeof(sig);
+    word32            secretSz = sizeof(secret);
+    word32            peerSecretSz = sizeof(peerSecret);
+    word32            idx;
+    int               verified = 0;
+    int               count;
+
+    printf(testingFmt, "wc_CryptoCb_Pool()");
+
+    AssertNull(wc_CryptoCb_PoolNew(INVALID_DEVID, 2, HEAP_HINT));
+    AssertNull(wc_CryptoCb_PoolNew(poolDevId, 0, HEAP_HINT));
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolPoll(NULL, events, 1, &count));
+
+    AssertNotNull(pool = wc_CryptoCb_PoolNew(poolDevId, 2, HEAP_HINT));
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolPoll(pool, NULL, 1, &count));
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolPoll(pool, events, 0, &count));
+    AssertIntEQ(0, wc_CryptoCb_PoolPoll(pool, events, 1, &count));
+    AssertIntEQ(0, count);
+
+    AssertIntEQ(0, wc_InitRng(&rng));
+    XMEMSET(hash, 0x5a, sizeof(hash));
+
+    /* ECC runs on the pool, calling again after it is done gets the result */
+    AssertIntEQ(0, wc_ecc_init_ex(&key, HEAP_HINT, poolDevId));
+    AssertIntEQ(WC_PENDING_E, wc_ecc_make_key(&rng, 32, &key));
+    AssertIntEQ(0, crypto_cb_pool_wait(pool, &key));
+    AssertIntEQ(0, wc_ecc_make_key(&rng, 32, &key));
+
+    AssertIntEQ(WC_PENDING_E, wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz,
+                                               &rng, &key));
+    AssertIntEQ(0, crypto_cb_pool_wait(pool, &key));
+    AssertIntEQ(0, wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng,
+                                    &key));
+
+    AssertIntEQ(WC_PENDING_E, wc_ecc_verify_hash(sig, sigSz, hash,
+                                                 sizeof(hash), &verified, &key));
+    AssertIntEQ(0, crypto_cb_pool_wait(pool, &key));
+    AssertIntEQ(0, wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash),
+                                      &verified, &key));
+    AssertIntEQ(1, verified);
+
+    /* same secret as the software peer */
+    AssertIntEQ(0, wc_ecc_init_ex(&peer, HEAP_HINT, INVALID_DEVID));
+    AssertIntEQ(0, wc_ecc_make_key(&rng, 32, &peer));
+#if defined(ECC_TIMING_RESISTANT) && (!defined(HAVE_FIPS) || \
+    (!defined(HAVE_FIPS_VERSION) || (HAVE_FIPS_VERSION != 2))) && \
+    !defined(HAVE_SELFTEST)
+    AssertIntEQ(0, wc_ecc_set_rng(&peer, &rng));
+#endif
+    AssertIntEQ(WC_PENDING_E, wc_ecc_shared_secret(&key, &peer, secret,
+                                                   &secretSz));
+    AssertIntEQ(0, crypto_cb_pool_wait(pool, &key));
+    AssertIntEQ(0, wc_ecc_shared_secret(&key, &peer, secret, &secretSz));
+    AssertIntEQ(0, wc_ecc_shared_secret(&peer, &key, peerSecret,
+                                        &peerSecretSz));
+    AssertIntEQ(secretSz, peerSecretSz);
+    AssertIntEQ(0, XMEMCMP(secret, peerSecret, secretSz));
+
+    /* RSA with padding calls the pool again for it, verify in software */
+    idx = 0;
+    AssertIntEQ(0, wc_InitRsaKey_ex(&rsa, HEAP_HINT, poolDevId));
+    AssertIntEQ(0, wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &rsa,
+                                          sizeof_client_key_der_2048));
+    idx = 0;
+    AssertIntEQ(0, wc_InitRsaKey_ex(&rsaSw, HEAP_HINT, INVALID_DEVID));
+    AssertIntEQ(0, wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &rsaSw,
+                                          sizeof_client_key_der_2048));
+    for (count = 0; count < 2; count++) {
+        AssertIntEQ(WC_PENDING_E, wc_RsaSSL_Sign(hash, sizeof(hash), rsaSig,
+                                            sizeof(rsaSig), &rsa, &rng));
+        AssertIntEQ(0, crypto_cb_pool_wait(pool, &rsa));
+        AssertIntEQ(sizeof(rsaSig), wc_RsaSSL_Sign(hash, sizeof(hash), rsaSig,
+                                            sizeof(rsaSig), &rsa, &rng));
+        AssertIntEQ(sizeof(hash), wc_RsaSSL_Verify(rsaSig, sizeof(rsaSig),
+                                            plain, sizeof(plain), &rsaSw));
+        AssertIntEQ(0, XMEMCMP(plain, hash, sizeof(hash)));
+    }
+#ifndef NO_RSA_BOUNDS_CHECK
+    /* with padding too, calling again returns the worker's failure */
+#ifdef WC_RSA_BLINDING
+    AssertIntEQ(0, wc_RsaSetRNG(&rsa, &rng));
+#endif
+    XMEMSET(rsaSig, 0xff, sizeof(rsaSig));
+    AssertIntEQ(WC_PENDING_E, wc_RsaPrivateDecrypt(rsaSig, sizeof(rsaSig),
+                                            plain, sizeof(plain), &rsa));
+    AssertIntEQ(RSA_OUT_OF_RANGE_E, crypto_cb_pool_wait(pool, &rsa));
+    AssertIntEQ(RSA_OUT_OF_RANGE_E, wc_RsaPrivateDecrypt(rsaSig,
+                                    sizeof(rsaSig), plain, sizeof(plain), &rsa));
+#endif
+
+#ifndef NO_WOLFSSL_CLIENT
+    /* handshakes don't poll the pool */
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CTX_SetDevId(ctx, poolDevId));
+    AssertNotNull(ssl = wolfSSL_new(ctx));
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_SetDevId(ssl, poolDevId));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_SetDevId(ssl, INVALID_DEVID));
+    wolfSSL_free(ssl);
+    wolfSSL_CTX_free(ctx);
+#endif
+
+    wc_FreeRsaKey(&rsaSw);
+    wc_FreeRsaKey(&rsa);
+    wc_ecc_free(&peer);
+    wc_ecc_free(&key);
+    wc_FreeRng(&rng);
+    wc_CryptoCb_PoolFree(pool);
+
+    printf(resultFmt, passed);
+#endif
+} /* END test_wc_CryptoCb_Pool */
+
+#if defined(WOLF_CRYPTO_CB_POOL) && defined(HAVE_ECC) && !defined(NO_RSA) && \
+    !defined(WC_NO_RNG) && !defined(NO_SHA256) && defined(USE_CERT_BUFFERS_2048)
+typedef struct crypto_cb_batch_ctx {
+    wolfSSL_Mutex lock; /* workers call in at once, held to queue up jobs */
+    int unavailable;
+    int calls;
+    int ops;
+    int maxCount;
+} crypto_cb_batch_ctx;
+
+/* Batch device doing the operations with wolfCrypt, on a pool worker the
+ * keys' pool device runs them in software */
+static int crypto_cb_batch(int thisDevId, wc_CryptoInfo* info, void* ctx)
+{
+    crypto_cb_batch_ctx* batch = (crypto_cb_batch_ctx*)ctx;
+    wc_CryptoInfo* op;
+    int i;
+
+    (void)thisDevId;
+
+    if (info->algo_type != WC_ALGO_TYPE_PK_BATCH || batch->unavailable)
+        return CRYPTOCB_UNAVAILABLE;
+
+    if (wc_LockMutex(&batch->lock) != 0)
+        return BAD_MUTEX_E;
+    batch->calls++;
+    if (info->batch.count > batch->maxCount)
+        batch->maxCount = info->batch.count;
+    for (i = 0; i < info->batch.count; i++) {
+        op = info->batch.ops[i];
+        if (op->pk.type != info->batch.type) {
+            wc_UnLockMutex(&batch->lock);
+            return BAD_FUNC_ARG;
+        }
+        batch->ops++;
+        switch (op->pk.type) {
+            case WC_PK_TYPE_EC_KEYGEN:
+                info->batch.rets[i] = wc_ecc_make_key_ex(op->pk.eckg.rng,
+                            op->pk.eckg.size, op->pk.eckg.key,
+                            op->pk.eckg.curveId);
+                break;
+            case WC_PK_TYPE_ECDSA_SIGN:
+                info->batch.rets[i] = wc_ecc_sign_hash(op->pk.eccsign.in,
+                            op->pk.eccsign.inlen, op->pk.eccsign.out,
+                            op->pk.eccsign.outlen, op->pk.eccsign.rng,
+                            op->pk.eccsign.key);
+                break;
+            case WC_PK_TYPE_ECDSA_VERIFY:
+                info->batch.rets[i] = wc_ecc_verify_hash(op->pk.eccverify.sig,
+                            op->pk.eccverify.siglen, op->pk.eccverify.hash,
+                            op->pk.eccverify.hashlen, op->pk.eccverify.res,
+                            op->pk.eccverify.key);
+                break;
+            default:
+                batch->ops--;
+                info->batch.rets[i] = CRYPTOCB_UNAVAILABLE;
+                break;
+        }
+    }
+    wc_UnLockMutex(&batch->lock);
+
+    return 0;
+}
+
+/* Poll pool until n operations are done, returns the first failure */
+static int crypto_cb_pool_wait_all(WC_CRYPTOCB_POOL* pool, int n)
+{
+    WOLF_EVENT* events[4];
+    long tries;
+    int  ret = 0;
+    int  count;
+    int  i;
+
+    for (tries = 0; n > 0 && tries < (1L << 26); tries++) {
+        AssertIntEQ(0, wc_CryptoCb_PoolPoll(pool, events, 4, &count));
+        for (i = 0; i < count; i++) {
+            if (ret == 0)
+                ret = events[i]->ret;
+        }
+        n -= count;
+    }
+
+    return (n == 0) ? ret : WC_TIMEOUT_E;
+}
+#endif
+
+/*
+ * Testing wc_CryptoCb_PoolSetBatch()
+ */
+static void test_wc_CryptoCb_PoolSetBatch(void)
+{
+#if defined(WOLF_CRYPTO_CB_POOL) && defined(HAVE_ECC) && !defined(NO_RSA) && \
+    !defined(WC_NO_RNG) && !defined(NO_SHA256) && defined(USE_CERT_BUFFERS_2048)
+    #define BATCH_TEST_KEYS 4
+    const int           poolDevId = 10;
+    const int           batchDevId = 11;
+    WC_CRYPTOCB_POOL*   pool;
+    crypto_cb_batch_ctx batch;
+    WC_RNG              rng;
+    ecc_key             key[BATCH_TEST_KEYS];
+    byte                hash[WC_SHA256_DIGEST_SIZE];
+    byte                sig[BATCH_TEST_KEYS][ECC_MAX_SIG_SIZE];
+    word32              sigSz[BATCH_TEST_KEYS];
+    int                 verified[BATCH_TEST_KEYS];
+    int                 round;
+    int                 i;
+
+    printf(testingFmt, "wc_CryptoCb_PoolSetBatch()");
+
+    XMEMSET(&batch, 0, sizeof(batch));
+    AssertIntEQ(0, wc_InitMutex(&batch.lock));
+    AssertIntEQ(0, wc_CryptoCb_RegisterDevice(batchDevId, crypto_cb_batch,
+                                              &batch));
+    AssertNotNull(pool = wc_CryptoCb_PoolNew(poolDevId, 2, HEAP_HINT));
+
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolSetBatch(NULL, batchDevId, 4));
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolSetBatch(pool, poolDevId, 4));
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolSetBatch(pool, batchDevId, 0));
+    AssertIntEQ(BAD_FUNC_ARG, wc_CryptoCb_PoolSetBatch(pool, batchDevId,
+                                                  CRYPTOCB_POOL_MAX_BATCH + 1));
+    AssertIntEQ(0, wc_CryptoCb_PoolSetBatch(pool, batchDevId,
+                                            BATCH_TEST_KEYS));
+
+    AssertIntEQ(0, wc_InitRng(&rng));
+    XMEMSET(hash, 0x5a, sizeof(hash));
+    for (i = 0; i < BATCH_TEST_KEYS; i++)
+        AssertIntEQ(0, wc_ecc_init_ex(&key[i], HEAP_HINT, poolDevId));
+
+    /* first round through the batch device, second with it declining */
+    for (round = 0; round < 2; round++) {
+        batch.unavailable = round;
+
+        /* the workers wait in the device while all the jobs queue up, so
+         * the first to get back takes the rest as one batch */
+        AssertIntEQ(0, wc_LockMutex(&batch.lock));
+        for (i = 0; i < BATCH_TEST_KEYS; i++)
+            AssertIntEQ(WC_PENDING_E, wc_ecc_make_key(&rng, 32, &key[i]));
+        wc_UnLockMutex(&batch.lock);
+        AssertIntEQ(0, crypto_cb_pool_wait_all(pool, BATCH_TEST_KEYS));
+        for (i = 0; i < BATCH_TEST_KEYS; i++)
+            AssertIntEQ(0, wc_ecc_make_key(&rng, 32, &key[i]));
+
+        for (i = 0; i < BATCH_TEST_KEYS; i++) {
+            sigSz[i] = sizeof(sig[i]);
+            AssertIntEQ(WC_PENDING_E, wc_ecc_sign_hash(hash, sizeof(hash),
+                                            sig[i], &sigSz[i], &rng, &key[i]));
+        }
+        AssertIntEQ(0, crypto_cb_pool_wait_all(pool, BATCH_TEST_KEYS));
+        for (i = 0; i < BATCH_TEST_KEYS; i++) {
+            AssertIntEQ(0, wc_ecc_sign_hash(hash, sizeof(hash), sig[i],
+                                            &sigSz[i], &rng, &key[i]));
+        }
+
+        for (i = 0; i < BATCH_TEST_KEYS; i++) {
+            verified[i] = 0;
+            AssertIntEQ(WC_PENDING_E, wc_ecc_verify_hash(sig[i], sigSz[i],
+                                     hash, sizeof(hash), &verified[i], &key[i]));
+        }
+        AssertIntEQ(0, crypto_cb_pool_wait_all(pool, BATCH_TEST_KEYS));
+        for (i = 0; i < BATCH_TEST_KEYS; i++) {
+            AssertIntEQ(0, wc_ecc_verify_hash(sig[i], sigSz[i], hash,
+                                 sizeof(hash), &verified[i], &key[i]));
+            AssertIntEQ(1, verified[i]);
+        }
+
+        /* every operation went through the batch device exactly once */
+        AssertIntEQ(3 * BATCH_TEST_KEYS, batch.ops);
+        AssertIntGT(batch.calls, 0);
+        AssertIntLE(batch.calls, 3 * BATCH_TEST_KEYS);
+        AssertIntGT(batch.maxCount, 1);
+    }
+
+    AssertIntEQ(0, wc_CryptoCb_PoolSetBatch(pool, INVALID_DEVID, 0));
+
+    for (i = 0; i < BATCH_TEST_KEYS; i++)
+        wc_ecc_free(&key[i]);
+    wc_FreeRng(&rng);
+    wc_CryptoCb_PoolFree(pool);
+    wc_CryptoCb_UnRegisterDevice(batchDevId);
+    wc_FreeMutex(&batch.lock);
+    #undef BATCH_TEST_KEYS
+
+    printf(resultFmt, passed);
+#endif
+} /* END test_wc_CryptoCb_PoolSetBatch */
 /*
  * Testing ToTraditional
  */
@@ -26865,7 +28492,7 @@ static void test_wolfSSL_tmp_dh(void)
 {
 #if defined(OPENSSL_EXTRA) && !defined(NO_CERTS) && !defined(NO_FILESYSTEM) && \
     !defined(NO_DSA) && !defined(NO_RSA) && !defined(NO_DH) && !defined(NO_BIO)
-    byte buffer[6000];
+    byte buff[6000];
     char file[] = "./certs/dsaparams.pem";
     XFILE f;
     int  bytes;
@@ -26891,10 +28518,10 @@ static void test_wolfSSL_tmp_dh(void)
 
     f = XFOPEN(file, "rb");
     AssertTrue((f != XBADFILE));
-    bytes = (int)XFREAD(buffer, 1, sizeof(buffer), f);
+    bytes = (int)XFREAD(buff, 1, sizeof(buff), f);
     XFCLOSE(f);
 
-    bio = BIO_new_mem_buf((void*)buffer, bytes);
+    bio = BIO_new_mem_buf((void*)buff, bytes);
     AssertNotNull(bio);
 
     dsa = wolfSSL_PEM_read_bio_DSAparams(bio, NULL, NULL, NULL);
@@ -38811,6 +40438,7 @@ static void test_wolfssl_EVP_aes_gcm_AAD_2_parts(void)
     byte outTag2Part[16];
     byte decryptBuf[16];
     int len;
+    int tlen;
     EVP_CIPHER_CTX* ctx = NULL;
 
     printf(testingFmt, "wolfssl_EVP_aes_gcm_AAD_2_parts");
@@ -38821,9 +40449,12 @@ static void test_wolfssl_EVP_aes_gcm_AAD_2_parts(void)
     AssertIntEQ(EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(), NULL, NULL, NULL), 1);
     AssertIntEQ(EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv), 1);
     AssertIntEQ(EVP_EncryptUpdate(ctx, NULL, &len, aad, sizeof(aad)), 1);
+    tlen = 0;
     AssertIntEQ(EVP_EncryptUpdate(ctx, out1Part, &len, cleartext, sizeof(cleartext)), 1);
-    AssertIntEQ(EVP_EncryptFinal_ex(ctx, out1Part, &len), 1);
-    AssertIntEQ(len, sizeof(cleartext));
+    tlen += len;
+    AssertIntEQ(EVP_EncryptFinal_ex(ctx, out1Part + tlen, &len), 1);
+    tlen += len;
+    AssertIntEQ(tlen, sizeof(cleartext));
     AssertIntEQ(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, outTag1Part), 1);
     EVP_CIPHER_CTX_free(ctx);
 
@@ -38833,13 +40464,16 @@ static void test_wolfssl_EVP_aes_gcm_AAD_2_parts(void)
     AssertIntEQ(EVP_DecryptInit_ex(ctx, EVP_aes_128_gcm(), NULL, NULL, NULL), 1);
     AssertIntEQ(EVP_DecryptInit_ex(ctx, NULL, NULL, key, iv), 1);
     AssertIntEQ(EVP_DecryptUpdate(ctx, NULL, &len, aad, sizeof(aad)), 1);
+    tlen = 0;
     AssertIntEQ(EVP_DecryptUpdate(ctx, decryptBuf, &len, out1Part, sizeof(cleartext)), 1);
+    tlen += len;
     AssertIntEQ(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, 16, outTag1Part), 1);
-    AssertIntEQ(EVP_DecryptFinal_ex(ctx, decryptBuf, &len), 1);
-    AssertIntEQ(len, sizeof(cleartext));
+    AssertIntEQ(EVP_DecryptFinal_ex(ctx, decryptBuf + tlen, &len), 1);
+    tlen += len;
+    AssertIntEQ(tlen, sizeof(cleartext));
     EVP_CIPHER_CTX_free(ctx);
 
-    AssertIntEQ(XMEMCMP(decryptBuf, cleartext, len), 0);
+    AssertIntEQ(XMEMCMP(decryptBuf, cleartext, tlen), 0);
 
     /* ENCRYPT */
     /* Send AAD and data in 2 parts */
@@ -38848,11 +40482,15 @@ static void test_wolfssl_EVP_aes_gcm_AAD_2_parts(void)
     AssertIntEQ(EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv), 1);
     AssertIntEQ(EVP_EncryptUpdate(ctx, NULL, &len, aad, 1), 1);
     AssertIntEQ(EVP_EncryptUpdate(ctx, NULL, &len, aad + 1, sizeof(aad) - 1), 1);
+    tlen = 0;
     AssertIntEQ(EVP_EncryptUpdate(ctx, out2Part, &len, cleartext, 1), 1);
-    AssertIntEQ(EVP_EncryptUpdate(ctx, out2Part, &len, cleartext + 1,
+    tlen += len;
+    AssertIntEQ(EVP_EncryptUpdate(ctx, out2Part + tlen, &len, cleartext + 1,
                                   sizeof(cleartext) - 1), 1);
-    AssertIntEQ(EVP_EncryptFinal_ex(ctx, out2Part, &len), 1);
-    AssertIntEQ(len, sizeof(cleartext));
+    tlen += len;
+    AssertIntEQ(EVP_EncryptFinal_ex(ctx, out2Part + tlen, &len), 1);
+    tlen += len;
+    AssertIntEQ(tlen, sizeof(cleartext));
     AssertIntEQ(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, outTag2Part), 1);
 
     AssertIntEQ(XMEMCMP(out1Part, out2Part, sizeof(out1Part)), 0);
@@ -38866,14 +40504,18 @@ static void test_wolfssl_EVP_aes_gcm_AAD_2_parts(void)
     AssertIntEQ(EVP_DecryptInit_ex(ctx, NULL, NULL, key, iv), 1);
     AssertIntEQ(EVP_DecryptUpdate(ctx, NULL, &len, aad, 1), 1);
     AssertIntEQ(EVP_DecryptUpdate(ctx, NULL, &len, aad + 1, sizeof(aad) - 1), 1);
+    tlen = 0;
     AssertIntEQ(EVP_DecryptUpdate(ctx, decryptBuf, &len, out1Part, 1), 1);
-    AssertIntEQ(EVP_DecryptUpdate(ctx, decryptBuf, &len, out1Part + 1,
+    tlen += len;
+    AssertIntEQ(EVP_DecryptUpdate(ctx, decryptBuf + tlen, &len, out1Part + 1,
                                   sizeof(cleartext) - 1), 1);
+    tlen += len;
     AssertIntEQ(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, 16, outTag1Part), 1);
-    AssertIntEQ(EVP_DecryptFinal_ex(ctx, decryptBuf, &len), 1);
-    AssertIntEQ(len, sizeof(cleartext));
+    AssertIntEQ(EVP_DecryptFinal_ex(ctx, decryptBuf + tlen, &len), 1);
+    tlen += len;
+    AssertIntEQ(tlen, sizeof(cleartext));
 
-    AssertIntEQ(XMEMCMP(decryptBuf, cleartext, len), 0);
+    AssertIntEQ(XMEMCMP(decryptBuf, cleartext, tlen), 0);
 
     /* Test AAD re-use */
     EVP_CIPHER_CTX_free(ctx);
@@ -40295,11 +41937,14 @@ void ApiTest(void)
     test_wolfSSL_CTX_load_verify_locations();
     test_wolfSSL_CertManagerLoadCABuffer();
     test_wolfSSL_CertManagerGetCerts();
+    test_wolfSSL_CertManagerCATableGrow();
+    test_wolfSSL_CertManagerTrustStore();
     test_wolfSSL_CertManagerSetVerify();
     test_wolfSSL_CertManagerNameConstraint();
     test_wolfSSL_CertManagerNameConstraint2();
     test_wolfSSL_CertManagerCRL();
     test_wolfSSL_CTX_load_verify_locations_ex();
+    test_wolfSSL_CTX_load_verify_locations_parallel_lazy();
     test_wolfSSL_CTX_load_verify_buffer_ex();
     test_wolfSSL_CTX_load_verify_chain_buffer_format();
     test_wolfSSL_CTX_use_certificate_chain_file_format();
@@ -40310,6 +41955,8 @@ void ApiTest(void)
     test_wolfSSL_CTX_der_load_verify_locations();
     test_wolfSSL_CTX_enable_disable();
     test_wolfSSL_CTX_ticket_API();
+    test_wolfSSL_CTX_EnableOCSPStaplingRefresh();
+    test_EmbedOcspLookupNonBlock();
     test_server_wolfSSL_new();
     test_client_wolfSSL_new();
     test_wolfSSL_SetTmpDH_file();
@@ -40332,6 +41979,10 @@ void ApiTest(void)
 #ifdef HAVE_IO_TESTS_DEPENDENCIES
     test_wolfSSL_UseSNI();
 #endif
+    test_wolfSSL_handshake_timing();
+    test_wolfSSL_perf_stats();
+    test_wolfSSL_CTX_get_mem_stats();
+    test_wolfSSL_get_hs_arena_stats();
     test_wolfSSL_UseTrustedCA();
     test_wolfSSL_UseMaxFragment();
     test_wolfSSL_UseTruncatedHMAC();
@@ -40360,6 +42011,8 @@ void ApiTest(void)
     test_wc_PemPubKeyToDer();
 
     /*OCSP Stapling. */
+    test_wolfSSL_CertManagerOCSPCache();
+    test_wolfSSL_OCSPStaplingRefresh_handshake();
     AssertIntEQ(test_wolfSSL_UseOCSPStapling(), WOLFSSL_SUCCESS);
     AssertIntEQ(test_wolfSSL_UseOCSPStaplingV2(), WOLFSSL_SUCCESS);
 
@@ -40959,6 +42612,8 @@ void ApiTest(void)
     AssertIntEQ(test_wc_ecc_is_valid_idx(), 0);
     AssertIntEQ(test_wc_ecc_get_curve_id_from_oid(), 0);
     AssertIntEQ(test_wc_ecc_sig_size_calc(), 0);
+    test_wc_CryptoCb_Pool();
+    test_wc_CryptoCb_PoolSetBatch();
 
 
     AssertIntEQ(test_ToTraditional(), 0);
@@ -254,6 +254,9 @@
 #define BENCH_RIPEMD             0x00001000
 #define BENCH_BLAKE2B            0x00002000
 #define BENCH_BLAKE2S            0x00004000
+#define BENCH_SHAKE_X4           0x00008000
+#define BENCH_BLAKE2BP           0x00010000
+#define BENCH_BLAKE2SP           0x00020000
 
 /* MAC algorithms. */
 #define BENCH_CMAC               0x00000001
@@ -419,14 +422,19 @@ static const bench_alg bench_digest_opt[] = {
     { "-sha3-512",           BENCH_SHA3_512          },
     #endif
 #endif
+#ifdef WOLFSSL_SHAKE_X4
+    { "-shake-x4",           BENCH_SHAKE_X4          },
+#endif
 #ifdef WOLFSSL_RIPEMD
     { "-ripemd",             BENCH_RIPEMD            },
 #endif
 #ifdef HAVE_BLAKE2
     { "-blake2b",            BENCH_BLAKE2B           },
+    { "-blake2bp",           BENCH_BLAKE2BP          },
 #endif
 #ifdef HAVE_BLAKE2S
     { "-blake2s",            BENCH_BLAKE2S           },
+    { "-blake2sp",           BENCH_BLAKE2SP          },
 #endif
     { NULL, 0}
 };
@@ -1669,6 +1677,10 @@ static void* benchmarks_do(void* args)
     }
     #endif /* WOLFSSL_NOSHA3_512 */
 #endif
+#ifdef WOLFSSL_SHAKE_X4
+    if (bench_all || (bench_digest_algs & BENCH_SHAKE_X4))
+        bench_shake_x4();
+#endif
 #ifdef WOLFSSL_RIPEMD
     if (bench_all || (bench_digest_algs & BENCH_RIPEMD))
         bench_ripemd();
@@ -1676,10 +1688,14 @@ static void* benchmarks_do(void* args)
 #ifdef HAVE_BLAKE2
     if (bench_all || (bench_digest_algs & BENCH_BLAKE2B))
         bench_blake2b();
+    if (bench_all || (bench_digest_algs & BENCH_BLAKE2BP))
+        bench_blake2bp();
 #endif
 #ifdef HAVE_BLAKE2S
     if (bench_all || (bench_digest_algs & BENCH_BLAKE2S))
         bench_blake2s();
+    if (bench_all || (bench_digest_algs & BENCH_BLAKE2SP))
+        bench_blake2sp();
 #endif
 #ifdef WOLFSSL_CMAC
     if (bench_all || (bench_mac_algs & BENCH_CMAC))
@@ -3925,6 +3941,48 @@ exit:
 #endif /* WOLFSSL_NOSHA3_512 */
 #endif
 
+#ifdef WOLFSSL_SHAKE_X4
+/* Four messages of the benchmark size hashed at once - the count is in
+ * messages so the throughput covers all four. */
+void bench_shake_x4(void)
+{
+    const byte* in[4];
+    byte* out[4];
+    byte digest[4][WC_SHA3_256_DIGEST_SIZE];
+    double start;
+    int    ret = 0, i, count, times;
+
+    for (i = 0; i < 4; i++) {
+        in[i] = bench_plain;
+        out[i] = digest[i];
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_Shake128_x4(in, BENCH_SIZE, out, sizeof(digest[0]));
+            if (ret != 0)
+                goto exit_shake128_x4;
+        }
+        count += times * 4;
+    } while (bench_stats_sym_check(start));
+exit_shake128_x4:
+    bench_stats_sym_finish("SHAKE128x4", 0, count, bench_size, start, ret);
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_Shake256_x4(in, BENCH_SIZE, out, sizeof(digest[0]));
+            if (ret != 0)
+                goto exit_shake256_x4;
+        }
+        count += times * 4;
+    } while (bench_stats_sym_check(start));
+exit_shake256_x4:
+    bench_stats_sym_finish("SHAKE256x4", 0, count, bench_size, start, ret);
+}
+#endif /* WOLFSSL_SHAKE_X4 */
+
 
 #ifdef WOLFSSL_RIPEMD
 int bench_ripemd(void)
@@ -4042,6 +4100,65 @@ void bench_blake2b(void)
 }
 #endif
 
+#ifdef HAVE_BLAKE2
+void bench_blake2bp(void)
+{
+    Blake2bp b2bp;
+    byte     digest[64];
+    double   start;
+    int      ret = 0, i, count;
+
+    if (digest_stream) {
+        ret = wc_InitBlake2bp(&b2bp, 64);
+        if (ret != 0) {
+            printf("InitBlake2bp failed, ret = %d\n", ret);
+            return;
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_Blake2bpUpdate(&b2bp, bench_plain, BENCH_SIZE);
+                if (ret != 0) {
+                    printf("Blake2bpUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+            }
+            ret = wc_Blake2bpFinal(&b2bp, digest, 64);
+            if (ret != 0) {
+                printf("Blake2bpFinal failed, ret = %d\n", ret);
+                return;
+            }
+            count += i;
+        } while (bench_stats_sym_check(start));
+    }
+    else {
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_InitBlake2bp(&b2bp, 64);
+                if (ret != 0) {
+                    printf("InitBlake2bp failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2bpUpdate(&b2bp, bench_plain, BENCH_SIZE);
+                if (ret != 0) {
+                    printf("Blake2bpUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2bpFinal(&b2bp, digest, 64);
+                if (ret != 0) {
+                    printf("Blake2bpFinal failed, ret = %d\n", ret);
+                    return;
+                }
+            }
+            count += i;
+        } while (bench_stats_sym_check(start));
+    }
+    bench_stats_sym_finish("BLAKE2bp", 0, count, bench_size, start, ret);
+}
+#endif
+
 #if defined(HAVE_BLAKE2S)
 void bench_blake2s(void)
 {
@@ -4101,6 +4218,65 @@ void bench_blake2s(void)
 }
 #endif
 
+#if defined(HAVE_BLAKE2S)
+void bench_blake2sp(void)
+{
+    Blake2sp b2sp;
+    byte     digest[32];
+    double   start;
+    int      ret = 0, i, count;
+
+    if (digest_stream) {
+        ret = wc_InitBlake2sp(&b2sp, 32);
+        if (ret != 0) {
+            printf("InitBlake2sp failed, ret = %d\n", ret);
+            return;
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_Blake2spUpdate(&b2sp, bench_plain, BENCH_SIZE);
+                if (ret != 0) {
+                    printf("Blake2spUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+            }
+            ret = wc_Blake2spFinal(&b2sp, digest, 32);
+            if (ret != 0) {
+                printf("Blake2spFinal failed, ret = %d\n", ret);
+                return;
+            }
+            count += i;
+        } while (bench_stats_sym_check(start));
+    }
+    else {
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_InitBlake2sp(&b2sp, 32);
+                if (ret != 0) {
+                    printf("InitBlake2sp failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2spUpdate(&b2sp, bench_plain, BENCH_SIZE);
+                if (ret != 0) {
+                    printf("Blake2spUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2spFinal(&b2sp, digest, 32);
+                if (ret != 0) {
+                    printf("Blake2spFinal failed, ret = %d\n", ret);
+                    return;
+                }
+            }
+            count += i;
+        } while (bench_stats_sym_check(start));
+    }
+    bench_stats_sym_finish("BLAKE2sp", 0, count, bench_size, start, ret);
+}
+#endif
+
 
 #ifdef WOLFSSL_CMAC
 
@@ -61,6 +61,15 @@ block cipher mechanism that uses n-bit binary string parameter key with 128-bits
 
 #include <wolfssl/wolfcrypt/cpuid.h>
 
+/* AES-GCM and AES-XTS on AVX-512 VAES/VPCLMULQDQ */
+#if defined(WOLFSSL_AESNI) && \
+    (defined(HAVE_AESGCM) || defined(WOLFSSL_AES_XTS)) && \
+    defined(USE_INTEL_SPEEDUP) && !defined(NO_INTEL_VAES) && \
+    defined(WC_HAVE_TARGET_ATTR_VAES)
+    #define HAVE_INTEL_VAES
+    #include <immintrin.h>
+#endif
+
 #ifdef WOLF_CRYPTO_CB
     #include <wolfssl/wolfcrypt/cryptocb.h>
 #endif
@@ -726,6 +735,13 @@ block cipher mechanism that uses n-bit binary string parameter key with 128-bits
                          unsigned long length, const unsigned char* KS, int nr)
                          XASM_LINK("AES_ECB_encrypt");
 
+    #if defined(WOLFSSL_AES_COUNTER) && !defined(_MSC_VER)
+        void AES_CTR_encrypt_by8(const unsigned char* in, unsigned char* out,
+                                 unsigned char* ctr, unsigned long length,
+                                 const unsigned char* KS, int nr)
+                                 XASM_LINK("AES_CTR_encrypt_by8");
+    #endif
+
     #ifdef HAVE_AES_DECRYPT
         void AES_ECB_decrypt(const unsigned char* in, unsigned char* out,
                              unsigned long length, const unsigned char* KS, int nr)
@@ -4099,6 +4115,22 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
                sz--;
             }
 
+        #if defined(WOLFSSL_AESNI) && !defined(_MSC_VER)
+            /* eight blocks at a time, counter kept in registers */
+            if (haveAESNI && aes->use_aesni && sz >= AES_BLOCK_SIZE) {
+                word32 blocksSz = sz & ~(word32)(AES_BLOCK_SIZE - 1);
+
+                SAVE_VECTOR_REGISTERS();
+                AES_CTR_encrypt_by8(in, out, (byte*)aes->reg, blocksSz,
+                                    (byte*)aes->key, aes->rounds);
+                RESTORE_VECTOR_REGISTERS();
+                out += blocksSz;
+                in  += blocksSz;
+                sz  -= blocksSz;
+                aes->left = 0;
+            }
+        #endif
+
             /* do as many block size ops as possible */
             while (sz >= AES_BLOCK_SIZE) {
             #ifdef XTRANSFORM_AESCTRBLOCK
@@ -4325,6 +4357,10 @@ static void GenerateM0(Aes* aes)
 
 #endif /* GCM_TABLE */
 
+#if defined(WOLFSSL_AESNI) && defined(WOLFSSL_AESGCM_STREAM)
+static void AesGcmStreamSetKeyAesni(Aes* aes);
+#endif
+
 /* Software AES - GCM SetKey */
 int wc_AesGcmSetKey(Aes* aes, const byte* key, word32 len)
 {
@@ -4362,8 +4398,16 @@ int wc_AesGcmSetKey(Aes* aes, const byte* key, word32 len)
 
     #ifdef WOLFSSL_AESNI
         /* AES-NI code generates its own H value. */
-        if (haveAESNI)
+        if (haveAESNI) {
+        #ifdef WOLFSSL_AESGCM_STREAM
+            if (ret == 0 && aes->use_aesni) {
+                SAVE_VECTOR_REGISTERS();
+                AesGcmStreamSetKeyAesni(aes);
+                RESTORE_VECTOR_REGISTERS();
+            }
+        #endif
             return ret;
+        }
     #endif /* WOLFSSL_AESNI */
 
 #if !defined(FREESCALE_LTC_AES_GCM)
@@ -4453,13 +4497,22 @@ void AES_GCM_decrypt_avx2(const unsigned char *in, unsigned char *out,
 #endif /* HAVE_INTEL_AVX1 */
 #endif /* HAVE_AES_DECRYPT */
 
-#else /* _MSC_VER */
+#endif /* !_MSC_VER */
+
+/* Carry-less multiply helpers shared by the intrinsics AES-GCM below and the
+ * streaming API */
+#if defined(_MSC_VER) || defined(WOLFSSL_AESGCM_STREAM)
 
+#ifdef _MSC_VER
 #define S(w,z) ((char)((unsigned long long)(w) >> (8*(7-(z))) & 0xFF))
 #define M128_INIT(x,y) { S((x),7), S((x),6), S((x),5), S((x),4), \
                          S((x),3), S((x),2), S((x),1), S((x),0), \
                          S((y),7), S((y),6), S((y),5), S((y),4), \
                          S((y),3), S((y),2), S((y),1), S((y),0) }
+#else
+/* __m128i is two 64-bit integers, low one first */
+#define M128_INIT(x,y) { (long long)(x), (long long)(y) }
+#endif
 
 static const __m128i MOD2_128 =
         M128_INIT(0x1, (long long int)0xc200000000000000UL);
@@ -4488,6 +4541,275 @@ static const __m128i BSWAP_EPI64 =
 static const __m128i BSWAP_MASK =
         M128_INIT(0x08090a0b0c0d0e0f, 0x0001020304050607);
 
+static void gfmul_only(__m128i a, __m128i b, __m128i* r0, __m128i* r1)
+{
+    __m128i t1, t2, t3, t4;
+
+    /* 128 x 128 Carryless Multiply */
+    t2 = _mm_shuffle_epi32(b, 78);
+    t3 = _mm_shuffle_epi32(a, 78);
+    t2 = _mm_xor_si128(t2, b);
+    t3 = _mm_xor_si128(t3, a);
+    t4 = _mm_clmulepi64_si128(b, a, 0x11);
+    t1 = _mm_clmulepi64_si128(b, a, 0x00);
+    t2 = _mm_clmulepi64_si128(t2, t3, 0x00);
+    t2 = _mm_xor_si128(t2, t1);
+    t2 = _mm_xor_si128(t2, t4);
+    t3 = _mm_slli_si128(t2, 8);
+    t2 = _mm_srli_si128(t2, 8);
+    t1 = _mm_xor_si128(t1, t3);
+    t4 = _mm_xor_si128(t4, t2);
+    *r0 = _mm_xor_si128(t1, *r0);
+    *r1 = _mm_xor_si128(t4, *r1);
+}
+
+static __m128i gfmul_shl1(__m128i a)
+{
+    __m128i t1 = a, t2;
+    t2 = _mm_srli_epi64(t1, 63);
+    t1 = _mm_slli_epi64(t1, 1);
+    t2 = _mm_slli_si128(t2, 8);
+    t1 = _mm_or_si128(t1, t2);
+    /* if (a[1] >> 63) t1 = _mm_xor_si128(t1, MOD2_128); */
+    a = _mm_shuffle_epi32(a, 0xff);
+    a = _mm_srai_epi32(a, 31);
+    a = _mm_and_si128(a, MOD2_128);
+    t1 = _mm_xor_si128(t1, a);
+    return t1;
+}
+
+static __m128i ghash_red(__m128i r0, __m128i r1)
+{
+    __m128i t2, t3;
+    __m128i t5, t6, t7;
+
+    t5 = _mm_slli_epi32(r0, 31);
+    t6 = _mm_slli_epi32(r0, 30);
+    t7 = _mm_slli_epi32(r0, 25);
+    t5 = _mm_xor_si128(t5, t6);
+    t5 = _mm_xor_si128(t5, t7);
+
+    t6 = _mm_srli_si128(t5, 4);
+    t5 = _mm_slli_si128(t5, 12);
+    r0 = _mm_xor_si128(r0, t5);
+    t7 = _mm_srli_epi32(r0, 1);
+    t3 = _mm_srli_epi32(r0, 2);
+    t2 = _mm_srli_epi32(r0, 7);
+
+    t7 = _mm_xor_si128(t7, t3);
+    t7 = _mm_xor_si128(t7, t2);
+    t7 = _mm_xor_si128(t7, t6);
+    t7 = _mm_xor_si128(t7, r0);
+    return _mm_xor_si128(r1, t7);
+}
+
+static __m128i gfmul_shifted(__m128i a, __m128i b)
+{
+    __m128i t0 = _mm_setzero_si128(), t1 = _mm_setzero_si128();
+    gfmul_only(a, b, &t0, &t1);
+    return ghash_red(t0, t1);
+}
+
+#ifndef AES_GCM_AESNI_NO_UNROLL
+static __m128i gfmul8(__m128i a1, __m128i a2, __m128i a3, __m128i a4,
+                      __m128i a5, __m128i a6, __m128i a7, __m128i a8,
+                      __m128i b1, __m128i b2, __m128i b3, __m128i b4,
+                      __m128i b5, __m128i b6, __m128i b7, __m128i b8)
+{
+    __m128i t0 = _mm_setzero_si128(), t1 = _mm_setzero_si128();
+    gfmul_only(a1, b8, &t0, &t1);
+    gfmul_only(a2, b7, &t0, &t1);
+    gfmul_only(a3, b6, &t0, &t1);
+    gfmul_only(a4, b5, &t0, &t1);
+    gfmul_only(a5, b4, &t0, &t1);
+    gfmul_only(a6, b3, &t0, &t1);
+    gfmul_only(a7, b2, &t0, &t1);
+    gfmul_only(a8, b1, &t0, &t1);
+    return ghash_red(t0, t1);
+}
+#endif
+#endif /* _MSC_VER || WOLFSSL_AESGCM_STREAM */
+
+#ifdef WOLFSSL_AESGCM_STREAM
+/* Streaming AES-GCM with AES-NI keeps the GHASH in aes->gcmX byte reversed,
+ * as the __m128i the functions above work on, and H to H^8 in aes->gcmHt in
+ * the shifted form of gfmul_shifted(). */
+
+/* H = E(K, 0) and its powers */
+static void AesGcmStreamSetKeyAesni(Aes* aes)
+{
+    const __m128i* KEY = (const __m128i*)aes->key;
+    __m128i*       HT = (__m128i*)aes->gcmHt;
+    __m128i        H = _mm_xor_si128(_mm_setzero_si128(),
+                                     _mm_loadu_si128(&KEY[0]));
+    int            r;
+
+    for (r = 1; r < (int)aes->rounds; r++)
+        H = _mm_aesenc_si128(H, _mm_loadu_si128(&KEY[r]));
+    H = _mm_aesenclast_si128(H, _mm_loadu_si128(&KEY[aes->rounds]));
+    H = gfmul_shl1(_mm_shuffle_epi8(H, BSWAP_MASK));
+
+    HT[0] = H;
+    HT[1] = gfmul_shifted(H, H);
+    HT[2] = gfmul_shifted(H, HT[1]);
+    HT[3] = gfmul_shifted(HT[1], HT[1]);
+    HT[4] = gfmul_shifted(HT[1], HT[2]);
+    HT[5] = gfmul_shifted(HT[2], HT[2]);
+    HT[6] = gfmul_shifted(HT[2], HT[3]);
+    HT[7] = gfmul_shifted(HT[3], HT[3]);
+}
+
+#ifndef AES_GCM_AESNI_NO_UNROLL
+/* GHASH eight blocks into X */
+static WC_INLINE __m128i AesGcmStreamHash8Aesni(__m128i X, const __m128i* d,
+                                                const __m128i* HT)
+{
+    return gfmul8(
+        _mm_xor_si128(X, _mm_shuffle_epi8(_mm_loadu_si128(d), BSWAP_MASK)),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 1), BSWAP_MASK),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 2), BSWAP_MASK),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 3), BSWAP_MASK),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 4), BSWAP_MASK),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 5), BSWAP_MASK),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 6), BSWAP_MASK),
+        _mm_shuffle_epi8(_mm_loadu_si128(d + 7), BSWAP_MASK),
+        HT[0], HT[1], HT[2], HT[3], HT[4], HT[5], HT[6], HT[7]);
+}
+#endif
+
+/* GHASH whole blocks into aes->gcmX */
+static void AesGcmStreamHashAesni(Aes* aes, const byte* in, word32 blocks)
+{
+    const __m128i* HT = (const __m128i*)aes->gcmHt;
+    const __m128i* d = (const __m128i*)in;
+    __m128i        X = _mm_load_si128((const __m128i*)aes->gcmX);
+
+#ifndef AES_GCM_AESNI_NO_UNROLL
+    for (; blocks >= 8; blocks -= 8) {
+        X = AesGcmStreamHash8Aesni(X, d, HT);
+        d += 8;
+    }
+#endif
+    for (; blocks > 0; blocks--) {
+        X = _mm_xor_si128(X, _mm_shuffle_epi8(_mm_loadu_si128(d), BSWAP_MASK));
+        X = gfmul_shifted(X, HT[0]);
+        d++;
+    }
+
+    _mm_store_si128((__m128i*)aes->gcmX, X);
+}
+
+/* CTR encrypt or decrypt whole blocks, eight at a time, and GHASH the cipher
+ * text. When encrypting, the previous eight blocks of cipher text are hashed
+ * while the next eight are encrypted. The counter in aes->gcmCtr is the last
+ * one used. */
+static void AesGcmStreamCryptAesni(Aes* aes, byte* out, const byte* in,
+                                   word32 blocks, int enc)
+{
+    const __m128i* KEY = (const __m128i*)aes->key;
+    const __m128i* HT = (const __m128i*)aes->gcmHt;
+    const int      nr = (int)aes->rounds;
+    __m128i        X = _mm_load_si128((const __m128i*)aes->gcmX);
+    __m128i        ctr = _mm_shuffle_epi8(
+                       _mm_load_si128((const __m128i*)aes->gcmCtr),
+                       BSWAP_EPI64);
+    __m128i        t1, c1;
+    int            r;
+#ifndef AES_GCM_AESNI_NO_UNROLL
+    __m128i        k, t2, t3, t4, t5, t6, t7, t8;
+    const __m128i* h = NULL; /* eight blocks of cipher text to hash */
+
+    for (; blocks >= 8; blocks -= 8) {
+        if (!enc)
+            h = (const __m128i*)in;
+        k = _mm_loadu_si128(&KEY[0]);
+        t1 = _mm_shuffle_epi8(_mm_add_epi32(ctr, ONE), BSWAP_EPI64);
+        t2 = _mm_shuffle_epi8(_mm_add_epi32(ctr, TWO), BSWAP_EPI64);
+        t3 = _mm_shuffle_epi8(_mm_add_epi32(ctr, THREE), BSWAP_EPI64);
+        t4 = _mm_shuffle_epi8(_mm_add_epi32(ctr, FOUR), BSWAP_EPI64);
+        t5 = _mm_shuffle_epi8(_mm_add_epi32(ctr, FIVE), BSWAP_EPI64);
+        t6 = _mm_shuffle_epi8(_mm_add_epi32(ctr, SIX), BSWAP_EPI64);
+        t7 = _mm_shuffle_epi8(_mm_add_epi32(ctr, SEVEN), BSWAP_EPI64);
+        t8 = _mm_shuffle_epi8(_mm_add_epi32(ctr, EIGHT), BSWAP_EPI64);
+        ctr = _mm_add_epi32(ctr, EIGHT);
+        t1 = _mm_xor_si128(t1, k); t2 = _mm_xor_si128(t2, k);
+        t3 = _mm_xor_si128(t3, k); t4 = _mm_xor_si128(t4, k);
+        t5 = _mm_xor_si128(t5, k); t6 = _mm_xor_si128(t6, k);
+        t7 = _mm_xor_si128(t7, k); t8 = _mm_xor_si128(t8, k);
+        /* independent of the AES rounds below - decrypting in place reads
+         * the cipher text before it is overwritten */
+        if (h != NULL)
+            X = AesGcmStreamHash8Aesni(X, h, HT);
+        for (r = 1; r < nr; r++) {
+            k = _mm_loadu_si128(&KEY[r]);
+            t1 = _mm_aesenc_si128(t1, k); t2 = _mm_aesenc_si128(t2, k);
+            t3 = _mm_aesenc_si128(t3, k); t4 = _mm_aesenc_si128(t4, k);
+            t5 = _mm_aesenc_si128(t5, k); t6 = _mm_aesenc_si128(t6, k);
+            t7 = _mm_aesenc_si128(t7, k); t8 = _mm_aesenc_si128(t8, k);
+        }
+        k = _mm_loadu_si128(&KEY[nr]);
+        t1 = _mm_aesenclast_si128(t1, k); t2 = _mm_aesenclast_si128(t2, k);
+        t3 = _mm_aesenclast_si128(t3, k); t4 = _mm_aesenclast_si128(t4, k);
+        t5 = _mm_aesenclast_si128(t5, k); t6 = _mm_aesenclast_si128(t6, k);
+        t7 = _mm_aesenclast_si128(t7, k); t8 = _mm_aesenclast_si128(t8, k);
+
+        t1 = _mm_xor_si128(t1, _mm_loadu_si128((const __m128i*)in + 0));
+        t2 = _mm_xor_si128(t2, _mm_loadu_si128((const __m128i*)in + 1));
+        t3 = _mm_xor_si128(t3, _mm_loadu_si128((const __m128i*)in + 2));
+        t4 = _mm_xor_si128(t4, _mm_loadu_si128((const __m128i*)in + 3));
+        t5 = _mm_xor_si128(t5, _mm_loadu_si128((const __m128i*)in + 4));
+        t6 = _mm_xor_si128(t6, _mm_loadu_si128((const __m128i*)in + 5));
+        t7 = _mm_xor_si128(t7, _mm_loadu_si128((const __m128i*)in + 6));
+        t8 = _mm_xor_si128(t8, _mm_loadu_si128((const __m128i*)in + 7));
+        _mm_storeu_si128((__m128i*)out + 0, t1);
+        _mm_storeu_si128((__m128i*)out + 1, t2);
+        _mm_storeu_si128((__m128i*)out + 2, t3);
+        _mm_storeu_si128((__m128i*)out + 3, t4);
+        _mm_storeu_si128((__m128i*)out + 4, t5);
+        _mm_storeu_si128((__m128i*)out + 5, t6);
+        _mm_storeu_si128((__m128i*)out + 6, t7);
+        _mm_storeu_si128((__m128i*)out + 7, t8);
+        if (enc)
+            h = (const __m128i*)out;
+
+        in  += AES_BLOCK_SIZE * 8;
+        out += AES_BLOCK_SIZE * 8;
+    }
+    if (enc && h != NULL)
+        X = AesGcmStreamHash8Aesni(X, h, HT);
+#endif /* !AES_GCM_AESNI_NO_UNROLL */
+    for (; blocks > 0; blocks--) {
+        ctr = _mm_add_epi32(ctr, ONE);
+        t1 = _mm_xor_si128(_mm_shuffle_epi8(ctr, BSWAP_EPI64),
+                           _mm_loadu_si128(&KEY[0]));
+        for (r = 1; r < nr; r++)
+            t1 = _mm_aesenc_si128(t1, _mm_loadu_si128(&KEY[r]));
+        t1 = _mm_aesenclast_si128(t1, _mm_loadu_si128(&KEY[nr]));
+        c1 = _mm_loadu_si128((const __m128i*)in);
+        t1 = _mm_xor_si128(t1, c1);
+        _mm_storeu_si128((__m128i*)out, t1);
+        if (enc)
+            c1 = t1;
+        X = _mm_xor_si128(X, _mm_shuffle_epi8(c1, BSWAP_MASK));
+        X = gfmul_shifted(X, HT[0]);
+        in  += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    _mm_store_si128((__m128i*)aes->gcmX, X);
+    _mm_store_si128((__m128i*)aes->gcmCtr,
+                    _mm_shuffle_epi8(ctr, BSWAP_EPI64));
+}
+
+/* aes->gcmX in the byte order of the GCM specification */
+static void AesGcmStreamGetHashAesni(Aes* aes, byte* x)
+{
+    _mm_storeu_si128((__m128i*)x, _mm_shuffle_epi8(
+                     _mm_load_si128((const __m128i*)aes->gcmX), BSWAP_MASK));
+}
+#endif /* WOLFSSL_AESGCM_STREAM */
+
+#ifdef _MSC_VER
 
 /* The following are for MSC based builds which do not allow
  * inline assembly. Intrinsic functions are used instead. */
@@ -4705,95 +5027,6 @@ static __m128i gfmul_sw(__m128i a, __m128i b)
     return r;
 }
 
-static void gfmul_only(__m128i a, __m128i b, __m128i* r0, __m128i* r1)
-{
-    __m128i t1, t2, t3, t4;
-
-    /* 128 x 128 Carryless Multiply */
-    t2 = _mm_shuffle_epi32(b, 78);
-    t3 = _mm_shuffle_epi32(a, 78);
-    t2 = _mm_xor_si128(t2, b);
-    t3 = _mm_xor_si128(t3, a);
-    t4 = _mm_clmulepi64_si128(b, a, 0x11);
-    t1 = _mm_clmulepi64_si128(b, a, 0x00);
-    t2 = _mm_clmulepi64_si128(t2, t3, 0x00);
-    t2 = _mm_xor_si128(t2, t1);
-    t2 = _mm_xor_si128(t2, t4);
-    t3 = _mm_slli_si128(t2, 8);
-    t2 = _mm_srli_si128(t2, 8);
-    t1 = _mm_xor_si128(t1, t3);
-    t4 = _mm_xor_si128(t4, t2);
-    *r0 = _mm_xor_si128(t1, *r0);
-    *r1 = _mm_xor_si128(t4, *r1);
-}
-
-static __m128i gfmul_shl1(__m128i a)
-{
-    __m128i t1 = a, t2;
-    t2 = _mm_srli_epi64(t1, 63);
-    t1 = _mm_slli_epi64(t1, 1);
-    t2 = _mm_slli_si128(t2, 8);
-    t1 = _mm_or_si128(t1, t2);
-    /* if (a[1] >> 63) t1 = _mm_xor_si128(t1, MOD2_128); */
-    a = _mm_shuffle_epi32(a, 0xff);
-    a = _mm_srai_epi32(a, 31);
-    a = _mm_and_si128(a, MOD2_128);
-    t1 = _mm_xor_si128(t1, a);
-    return t1;
-}
-
-static __m128i ghash_red(__m128i r0, __m128i r1)
-{
-    __m128i t2, t3;
-    __m128i t5, t6, t7;
-
-    t5 = _mm_slli_epi32(r0, 31);
-    t6 = _mm_slli_epi32(r0, 30);
-    t7 = _mm_slli_epi32(r0, 25);
-    t5 = _mm_xor_si128(t5, t6);
-    t5 = _mm_xor_si128(t5, t7);
-
-    t6 = _mm_srli_si128(t5, 4);
-    t5 = _mm_slli_si128(t5, 12);
-    r0 = _mm_xor_si128(r0, t5);
-    t7 = _mm_srli_epi32(r0, 1);
-    t3 = _mm_srli_epi32(r0, 2);
-    t2 = _mm_srli_epi32(r0, 7);
-
-    t7 = _mm_xor_si128(t7, t3);
-    t7 = _mm_xor_si128(t7, t2);
-    t7 = _mm_xor_si128(t7, t6);
-    t7 = _mm_xor_si128(t7, r0);
-    return _mm_xor_si128(r1, t7);
-}
-
-static __m128i gfmul_shifted(__m128i a, __m128i b)
-{
-    __m128i t0 = _mm_setzero_si128(), t1 = _mm_setzero_si128();
-    gfmul_only(a, b, &t0, &t1);
-    return ghash_red(t0, t1);
-}
-
-#ifndef AES_GCM_AESNI_NO_UNROLL
-static __m128i gfmul8(__m128i a1, __m128i a2, __m128i a3, __m128i a4,
-                      __m128i a5, __m128i a6, __m128i a7, __m128i a8,
-                      __m128i b1, __m128i b2, __m128i b3, __m128i b4,
-                      __m128i b5, __m128i b6, __m128i b7, __m128i b8)
-{
-    __m128i t0 = _mm_setzero_si128(), t1 = _mm_setzero_si128();
-    gfmul_only(a1, b8, &t0, &t1);
-    gfmul_only(a2, b7, &t0, &t1);
-    gfmul_only(a3, b6, &t0, &t1);
-    gfmul_only(a4, b5, &t0, &t1);
-    gfmul_only(a5, b4, &t0, &t1);
-    gfmul_only(a6, b3, &t0, &t1);
-    gfmul_only(a7, b2, &t0, &t1);
-    gfmul_only(a8, b1, &t0, &t1);
-    return ghash_red(t0, t1);
-}
-#endif
-
-
 static void AES_GCM_encrypt(const unsigned char *in, unsigned char *out,
                             const unsigned char* addt,
                             const unsigned char* ivec, unsigned char *tag,
@@ -5562,32 +5795,487 @@ static void AES_GCM_decrypt(const unsigned char *in, unsigned char *out,
 
 #endif /* HAVE_AES_DECRYPT */
 #endif /* _MSC_VER */
-#endif /* WOLFSSL_AESNI */
-
 
-#if defined(GCM_SMALL)
-static void GMULT(byte* X, byte* Y)
+#ifdef HAVE_INTEL_VAES
+/* Shorter messages are faster on the AVX2 code: key schedule broadcast and
+ * H powers cost more than the wider rounds save. */
+#ifndef AESGCM_VAES_MIN_SZ
+    #define AESGCM_VAES_MIN_SZ 1024
+#endif
+#define IS_AESGCM_VAES(f, sz) ((sz) >= AESGCM_VAES_MIN_SZ && \
+                               IS_INTEL_AVX512(f) && IS_INTEL_VAES(f) && \
+                               IS_INTEL_VPCLMULQDQ(f))
+
+/* AES-GCM with VAES and VPCLMULQDQ on ZMM registers: four blocks per AES
+ * round instruction and per carry-less multiply, 16 blocks a loop with the
+ * GHASH of one group stitched into the AES rounds of the next. Field
+ * arithmetic follows the shifted H method of the intrinsics implementation
+ * above: H is multiplied by x once and products are reduced without
+ * shifting. */
+
+/* byte mask for the first n (up to 64) bytes of a ZMM register */
+static WC_INLINE __mmask64 vaes_mask(word32 n)
 {
-    byte Z[AES_BLOCK_SIZE];
-    byte V[AES_BLOCK_SIZE];
-    int i, j;
+    return (n >= 64) ? ~(__mmask64)0 : (((__mmask64)1 << n) - 1);
+}
 
-    XMEMSET(Z, 0, AES_BLOCK_SIZE);
-    XMEMCPY(V, X, AES_BLOCK_SIZE);
-    for (i = 0; i < AES_BLOCK_SIZE; i++)
-    {
-        byte y = Y[i];
-        for (j = 0; j < 8; j++)
-        {
-            if (y & 0x80) {
-                xorbuf(Z, V, AES_BLOCK_SIZE);
-            }
+/* X in the lowest 128 bits, zero above */
+static WC_INLINE WC_TARGET_VAES __m512i vaes_lane0(__m128i x)
+{
+    return _mm512_maskz_mov_epi64(0x03, _mm512_castsi128_si512(x));
+}
 
-            RIGHTSHIFTX(V);
-            y = y << 1;
-        }
-    }
-    XMEMCPY(X, Z, AES_BLOCK_SIZE);
+/* XOR of the four 128-bit lanes */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_fold(__m512i a)
+{
+    __m256i t = _mm256_xor_si256(_mm512_castsi512_si256(a),
+                                 _mm512_extracti64x4_epi64(a, 1));
+    return _mm_xor_si128(_mm256_castsi256_si128(t),
+                         _mm256_extracti128_si256(t, 1));
+}
+
+/* Reduce the 256-bit product r1:r0 modulo the GCM polynomial */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_ghash_red(__m128i r0, __m128i r1)
+{
+    __m128i t2, t3, t5, t6, t7;
+
+    t5 = _mm_slli_epi32(r0, 31);
+    t6 = _mm_slli_epi32(r0, 30);
+    t7 = _mm_slli_epi32(r0, 25);
+    t5 = _mm_xor_si128(t5, t6);
+    t5 = _mm_xor_si128(t5, t7);
+
+    t6 = _mm_srli_si128(t5, 4);
+    t5 = _mm_slli_si128(t5, 12);
+    r0 = _mm_xor_si128(r0, t5);
+    t7 = _mm_srli_epi32(r0, 1);
+    t3 = _mm_srli_epi32(r0, 2);
+    t2 = _mm_srli_epi32(r0, 7);
+
+    t7 = _mm_xor_si128(t7, t3);
+    t7 = _mm_xor_si128(t7, t2);
+    t7 = _mm_xor_si128(t7, t6);
+    t7 = _mm_xor_si128(t7, r0);
+    return _mm_xor_si128(r1, t7);
+}
+
+/* Sum the lanes of the partial products and reduce */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_ghash_sum(__m512i lo, __m512i mid,
+                                                   __m512i hi)
+{
+    __m128i l = vaes_fold(lo);
+    __m128i m = vaes_fold(mid);
+    __m128i h = vaes_fold(hi);
+
+    l = _mm_xor_si128(l, _mm_slli_si128(m, 8));
+    h = _mm_xor_si128(h, _mm_srli_si128(m, 8));
+    return vaes_ghash_red(l, h);
+}
+
+/* Lane by lane 128 x 128 carry-less multiply of a and b added to lo:mid:hi */
+#define VAES_CLMUL_ACC(a, b, lo, mid, hi)                                     \
+    do {                                                                      \
+        lo  = _mm512_xor_si512(lo, _mm512_clmulepi64_epi128(a, b, 0x00));     \
+        hi  = _mm512_xor_si512(hi, _mm512_clmulepi64_epi128(a, b, 0x11));     \
+        mid = _mm512_ternarylogic_epi64(mid,                                  \
+                  _mm512_clmulepi64_epi128(a, b, 0x01),                       \
+                  _mm512_clmulepi64_epi128(a, b, 0x10), 0x96);                \
+    } while (0)
+
+/* a * b for b a shifted H power */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_gfmul(__m128i a, __m128i b)
+{
+    __m128i lo  = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i hi  = _mm_clmulepi64_si128(a, b, 0x11);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x01),
+                                _mm_clmulepi64_si128(a, b, 0x10));
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    return vaes_ghash_red(lo, hi);
+}
+
+/* Lane by lane a * b for b shifted H powers, reduced as vaes_ghash_red() */
+static WC_INLINE WC_TARGET_VAES __m512i vaes_gfmul4(__m512i a, __m512i b)
+{
+    __m512i z = _mm512_setzero_si512();
+    __m512i lo = z, mid = z, hi = z;
+    __m512i t5, t6, t7;
+
+    VAES_CLMUL_ACC(a, b, lo, mid, hi);
+    lo = _mm512_xor_si512(lo, _mm512_bslli_epi128(mid, 8));
+    hi = _mm512_xor_si512(hi, _mm512_bsrli_epi128(mid, 8));
+
+    t5 = _mm512_ternarylogic_epi64(_mm512_slli_epi32(lo, 31),
+                                   _mm512_slli_epi32(lo, 30),
+                                   _mm512_slli_epi32(lo, 25), 0x96);
+    t6 = _mm512_bsrli_epi128(t5, 4);
+    lo = _mm512_xor_si512(lo, _mm512_bslli_epi128(t5, 12));
+    t7 = _mm512_ternarylogic_epi64(_mm512_srli_epi32(lo, 1),
+                                   _mm512_srli_epi32(lo, 2),
+                                   _mm512_srli_epi32(lo, 7), 0x96);
+    t7 = _mm512_ternarylogic_epi64(t7, t6, lo, 0x96);
+    return _mm512_xor_si512(hi, t7);
+}
+
+/* State of one AES-GCM operation on ZMM registers */
+typedef struct VaesGcm {
+    __m512i rk[15];       /* round keys in all four lanes */
+    __m128i hr[20];       /* H^16 down to H^1 then zeros, for 1-16 blocks */
+    __m128i T;            /* E(K, Y0) */
+} VaesGcm;
+
+static const word64 vaes_bswap[2] = {
+    W64LIT(0x08090a0b0c0d0e0f), W64LIT(0x0001020304050607)
+};
+static const word64 vaes_bswap64[2] = {
+    W64LIT(0x0001020304050607), W64LIT(0x08090a0b0c0d0e0f)
+};
+
+#define VAES_BSWAP() \
+    _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)vaes_bswap))
+#define VAES_BSWAP64() \
+    _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)vaes_bswap64))
+/* counter step of a ZMM register, 32-bit counter in dword 2 of each lane */
+#define VAES_FOUR() \
+    _mm512_set_epi32(0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0)
+
+/* X * H^nb + d[0] * H^nb + ... + d[nb-1] * H for 1 to 4 byte reversed
+ * blocks in d, lanes above nb zero */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_ghash4(const VaesGcm* g, __m128i X,
+                                                __m512i d, word32 nb)
+{
+    __m512i h = _mm512_loadu_si512((const void*)&g->hr[16 - nb]);
+    __m512i z = _mm512_setzero_si512();
+    __m512i lo = z, mid = z, hi = z;
+
+    d = _mm512_xor_si512(d, vaes_lane0(X));
+    VAES_CLMUL_ACC(d, h, lo, mid, hi);
+    return vaes_ghash_sum(lo, mid, hi);
+}
+
+/* GHASH of sz bytes at p, the last block zero padded */
+static WC_TARGET_VAES __m128i vaes_ghash_buf(const VaesGcm* g, __m128i X,
+                                          const byte* p, word32 sz)
+{
+    const __m512i bswap = VAES_BSWAP();
+
+    while (sz > 0) {
+        word32  n = (sz < 64) ? sz : 64;
+        __m512i d = _mm512_maskz_loadu_epi8(vaes_mask(n), p);
+
+        d = _mm512_shuffle_epi8(d, bswap);
+        X = vaes_ghash4(g, X, d, (n + 15) / 16);
+        p += n;
+        sz -= n;
+    }
+    return X;
+}
+
+/* Encrypt one 128-bit block */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_enc_block(const __m128i* KEY,
+                                                   __m128i b, int nr)
+{
+    int r;
+
+    b = _mm_xor_si128(b, _mm_loadu_si128(&KEY[0]));
+    for (r = 1; r < nr; r++)
+        b = _mm_aesenc_si128(b, _mm_loadu_si128(&KEY[r]));
+    return _mm_aesenclast_si128(b, _mm_loadu_si128(&KEY[nr]));
+}
+
+/* Encrypt the four counter blocks in ctr */
+static WC_INLINE WC_TARGET_VAES __m512i vaes_enc4(const VaesGcm* g, __m512i ctr,
+                                              __m512i bswap64, int nr)
+{
+    __m512i b = _mm512_xor_si512(_mm512_shuffle_epi8(ctr, bswap64), g->rk[0]);
+    int     r;
+
+    for (r = 1; r < nr; r++)
+        b = _mm512_aesenc_epi128(b, g->rk[r]);
+    return _mm512_aesenclast_epi128(b, g->rk[nr]);
+}
+
+/* One AES round on b0-b3 */
+#define VAES_ROUND16(k)                                                       \
+    do {                                                                      \
+        __m512i rk_ = (k);                                                    \
+        b0 = _mm512_aesenc_epi128(b0, rk_);                                   \
+        b1 = _mm512_aesenc_epi128(b1, rk_);                                   \
+        b2 = _mm512_aesenc_epi128(b2, rk_);                                   \
+        b3 = _mm512_aesenc_epi128(b3, rk_);                                   \
+    } while (0)
+
+/* Encrypt the next 16 counter blocks into b0-b3 while hashing the 16 byte
+ * reversed blocks in d0-d3 into X, one multiply per round while the AES
+ * unit works */
+#define VAES_CTR16_GHASH(g, nr)                                               \
+    do {                                                                      \
+        __m512i lo_ = _mm512_setzero_si512();                                 \
+        __m512i mid_ = lo_, hi_ = lo_;                                        \
+        __m512i k_ = (g)->rk[0];                                              \
+        int     r_;                                                           \
+                                                                              \
+        b0 = _mm512_xor_si512(_mm512_shuffle_epi8(ctr, bswap64), k_);         \
+        ctr = _mm512_add_epi32(ctr, four);                                    \
+        b1 = _mm512_xor_si512(_mm512_shuffle_epi8(ctr, bswap64), k_);         \
+        ctr = _mm512_add_epi32(ctr, four);                                    \
+        b2 = _mm512_xor_si512(_mm512_shuffle_epi8(ctr, bswap64), k_);         \
+        ctr = _mm512_add_epi32(ctr, four);                                    \
+        b3 = _mm512_xor_si512(_mm512_shuffle_epi8(ctr, bswap64), k_);         \
+        ctr = _mm512_add_epi32(ctr, four);                                    \
+        d0 = _mm512_xor_si512(d0, vaes_lane0(X));                             \
+        VAES_ROUND16((g)->rk[1]);                                             \
+        VAES_CLMUL_ACC(d0, _mm512_loadu_si512((g)->hr + 0), lo_, mid_, hi_);  \
+        VAES_ROUND16((g)->rk[2]);                                             \
+        VAES_CLMUL_ACC(d1, _mm512_loadu_si512((g)->hr + 4), lo_, mid_, hi_);  \
+        VAES_ROUND16((g)->rk[3]);                                             \
+        VAES_CLMUL_ACC(d2, _mm512_loadu_si512((g)->hr + 8), lo_, mid_, hi_);  \
+        VAES_ROUND16((g)->rk[4]);                                             \
+        VAES_CLMUL_ACC(d3, _mm512_loadu_si512((g)->hr + 12), lo_, mid_, hi_); \
+        for (r_ = 5; r_ < (nr); r_++)                                         \
+            VAES_ROUND16((g)->rk[r_]);                                        \
+        X = vaes_ghash_sum(lo_, mid_, hi_);                                   \
+        k_ = (g)->rk[nr];                                                     \
+        b0 = _mm512_aesenclast_epi128(b0, k_);                                \
+        b1 = _mm512_aesenclast_epi128(b1, k_);                                \
+        b2 = _mm512_aesenclast_epi128(b2, k_);                                \
+        b3 = _mm512_aesenclast_epi128(b3, k_);                                \
+    } while (0)
+
+/* Round keys, H powers, E(K, Y0) and first counter. The powers above H^4
+ * are only needed, and only computed, for 16 block loops. */
+static WC_TARGET_VAES void vaes_gcm_init(VaesGcm* g, const unsigned char* key,
+                                      int nr, const unsigned char* ivec,
+                                      word32 ibytes, word32 nbytes,
+                                      __m512i* ctr)
+{
+    const __m128i* KEY = (const __m128i*)key;
+    const __m128i  bswap = _mm_loadu_si128((const __m128i*)vaes_bswap);
+    const __m128i  mod2_128 = _mm_set_epi64x((long long)0xc200000000000000ULL,
+                                             1);
+    __m128i        H, Y, t;
+    int            i;
+
+    for (i = 0; i <= nr; i++)
+        g->rk[i] = _mm512_broadcast_i32x4(_mm_loadu_si128(&KEY[i]));
+
+    /* H = E(K, 0) shifted left by one, as gfmul_shl1() */
+    H = vaes_enc_block(KEY, _mm_setzero_si128(), nr);
+    H = _mm_shuffle_epi8(H, bswap);
+    t = _mm_or_si128(_mm_slli_epi64(H, 1),
+                     _mm_slli_si128(_mm_srli_epi64(H, 63), 8));
+    H = _mm_and_si128(_mm_srai_epi32(_mm_shuffle_epi32(H, 0xff), 31),
+                      mod2_128);
+    H = _mm_xor_si128(t, H);
+
+    g->hr[15] = H;
+    g->hr[14] = vaes_gfmul(H, H);
+    g->hr[13] = vaes_gfmul(g->hr[14], H);
+    g->hr[12] = vaes_gfmul(g->hr[13], H);
+    for (i = 16; i < 20; i++)
+        g->hr[i] = _mm_setzero_si128();
+    if (nbytes >= 256) {
+        __m512i h4 = _mm512_broadcast_i32x4(g->hr[12]);
+        __m512i p = _mm512_loadu_si512((const void*)&g->hr[12]);
+
+        for (i = 8; i >= 0; i -= 4) {
+            p = vaes_gfmul4(p, h4);
+            _mm512_storeu_si512((void*)&g->hr[i], p);
+        }
+    }
+
+    if (ibytes == GCM_NONCE_MID_SZ) {
+        word32 iv12[4];
+
+        XMEMCPY(iv12, ivec, GCM_NONCE_MID_SZ);
+        iv12[3] = 0x01000000;
+        Y = _mm_loadu_si128((const __m128i*)iv12);
+    }
+    else {
+        Y = vaes_ghash_buf(g, _mm_setzero_si128(), ivec, ibytes);
+        Y = _mm_xor_si128(Y, _mm_set_epi64x(0, (long long)ibytes * 8));
+        Y = vaes_gfmul(Y, H);
+        Y = _mm_shuffle_epi8(Y, bswap);
+    }
+    g->T = vaes_enc_block(KEY, Y, nr);
+
+    /* first data block uses counter Y0 + 1 */
+    t = _mm_add_epi32(_mm_shuffle_epi8(Y,
+                          _mm_loadu_si128((const __m128i*)vaes_bswap64)),
+                      _mm_set_epi32(0, 1, 0, 0));
+    *ctr = _mm512_add_epi32(_mm512_broadcast_i32x4(t),
+                            _mm512_set_epi32(0, 3, 0, 0, 0, 2, 0, 0,
+                                             0, 1, 0, 0, 0, 0, 0, 0));
+}
+
+/* GHASH of the lengths, tag is the result XOR E(K, Y0) */
+static WC_INLINE WC_TARGET_VAES __m128i vaes_gcm_final(const VaesGcm* g,
+                                                   __m128i X, word32 nbytes,
+                                                   word32 abytes)
+{
+    X = _mm_xor_si128(X, _mm_set_epi64x((long long)abytes * 8,
+                                        (long long)nbytes * 8));
+    X = vaes_gfmul(X, g->hr[15]);
+    X = _mm_shuffle_epi8(X, _mm_loadu_si128((const __m128i*)vaes_bswap));
+    return _mm_xor_si128(X, g->T);
+}
+
+static WC_TARGET_VAES void AES_GCM_encrypt_vaes(const unsigned char *in,
+                                unsigned char *out,
+                                const unsigned char* addt,
+                                const unsigned char* ivec, unsigned char *tag,
+                                word32 nbytes, word32 abytes, word32 ibytes,
+                                word32 tbytes, const unsigned char* key,
+                                int nr)
+{
+    VaesGcm g;
+    __m512i ctr, b0, b1, b2, b3, d0, d1, d2, d3;
+    __m512i bswap = VAES_BSWAP();
+    __m512i bswap64 = VAES_BSWAP64();
+    __m512i four = VAES_FOUR();
+    __m128i X, T;
+    word32  i = 0;
+
+    vaes_gcm_init(&g, key, nr, ivec, ibytes, nbytes, &ctr);
+    X = vaes_ghash_buf(&g, _mm_setzero_si128(), addt, abytes);
+
+    if (nbytes >= 256) {
+        /* first 16 blocks, their GHASH goes with the next ones */
+        b0 = vaes_enc4(&g, ctr, bswap64, nr);
+        ctr = _mm512_add_epi32(ctr, four);
+        b1 = vaes_enc4(&g, ctr, bswap64, nr);
+        ctr = _mm512_add_epi32(ctr, four);
+        b2 = vaes_enc4(&g, ctr, bswap64, nr);
+        ctr = _mm512_add_epi32(ctr, four);
+        b3 = vaes_enc4(&g, ctr, bswap64, nr);
+        ctr = _mm512_add_epi32(ctr, four);
+        for (i = 0; ; ) {
+            b0 = _mm512_xor_si512(b0, _mm512_loadu_si512(in + i));
+            b1 = _mm512_xor_si512(b1, _mm512_loadu_si512(in + i + 64));
+            b2 = _mm512_xor_si512(b2, _mm512_loadu_si512(in + i + 128));
+            b3 = _mm512_xor_si512(b3, _mm512_loadu_si512(in + i + 192));
+            _mm512_storeu_si512(out + i, b0);
+            _mm512_storeu_si512(out + i + 64, b1);
+            _mm512_storeu_si512(out + i + 128, b2);
+            _mm512_storeu_si512(out + i + 192, b3);
+            d0 = _mm512_shuffle_epi8(b0, bswap);
+            d1 = _mm512_shuffle_epi8(b1, bswap);
+            d2 = _mm512_shuffle_epi8(b2, bswap);
+            d3 = _mm512_shuffle_epi8(b3, bswap);
+            i += 256;
+            if (i + 256 > nbytes)
+                break;
+            VAES_CTR16_GHASH(&g, nr);
+        }
+        /* GHASH of the last 16 */
+        {
+            __m512i lo = _mm512_setzero_si512();
+            __m512i mid = lo, hi = lo;
+
+            d0 = _mm512_xor_si512(d0, vaes_lane0(X));
+            VAES_CLMUL_ACC(d0, _mm512_loadu_si512(g.hr + 0), lo, mid, hi);
+            VAES_CLMUL_ACC(d1, _mm512_loadu_si512(g.hr + 4), lo, mid, hi);
+            VAES_CLMUL_ACC(d2, _mm512_loadu_si512(g.hr + 8), lo, mid, hi);
+            VAES_CLMUL_ACC(d3, _mm512_loadu_si512(g.hr + 12), lo, mid, hi);
+            X = vaes_ghash_sum(lo, mid, hi);
+        }
+    }
+    while (i < nbytes) {
+        word32    n = (nbytes - i < 64) ? nbytes - i : 64;
+        __mmask64 m = vaes_mask(n);
+
+        b0 = vaes_enc4(&g, ctr, bswap64, nr);
+        ctr = _mm512_add_epi32(ctr, four);
+        b0 = _mm512_xor_si512(b0, _mm512_maskz_loadu_epi8(m, in + i));
+        _mm512_mask_storeu_epi8(out + i, m, b0);
+        b0 = _mm512_maskz_mov_epi8(m, b0);
+        X = vaes_ghash4(&g, X, _mm512_shuffle_epi8(b0, bswap), (n + 15) / 16);
+        i += n;
+    }
+
+    T = vaes_gcm_final(&g, X, nbytes, abytes);
+    XMEMCPY(tag, &T, tbytes);
+}
+
+#ifdef HAVE_AES_DECRYPT
+static WC_TARGET_VAES void AES_GCM_decrypt_vaes(const unsigned char *in,
+                                unsigned char *out,
+                                const unsigned char* addt,
+                                const unsigned char* ivec,
+                                const unsigned char *tag, word32 nbytes,
+                                word32 abytes, word32 ibytes, word32 tbytes,
+                                const unsigned char* key, int nr, int* res)
+{
+    VaesGcm g;
+    __m512i ctr, b0, b1, b2, b3, d0, d1, d2, d3;
+    __m512i bswap = VAES_BSWAP();
+    __m512i bswap64 = VAES_BSWAP64();
+    __m512i four = VAES_FOUR();
+    __m128i X, T;
+    word32  i;
+
+    vaes_gcm_init(&g, key, nr, ivec, ibytes, nbytes, &ctr);
+    X = vaes_ghash_buf(&g, _mm_setzero_si128(), addt, abytes);
+
+    for (i = 0; i + 256 <= nbytes; i += 256) {
+        d0 = _mm512_shuffle_epi8(_mm512_loadu_si512(in + i), bswap);
+        d1 = _mm512_shuffle_epi8(_mm512_loadu_si512(in + i + 64), bswap);
+        d2 = _mm512_shuffle_epi8(_mm512_loadu_si512(in + i + 128), bswap);
+        d3 = _mm512_shuffle_epi8(_mm512_loadu_si512(in + i + 192), bswap);
+        VAES_CTR16_GHASH(&g, nr);
+        _mm512_storeu_si512(out + i, _mm512_xor_si512(b0,
+                            _mm512_loadu_si512(in + i)));
+        _mm512_storeu_si512(out + i + 64, _mm512_xor_si512(b1,
+                            _mm512_loadu_si512(in + i + 64)));
+        _mm512_storeu_si512(out + i + 128, _mm512_xor_si512(b2,
+                            _mm512_loadu_si512(in + i + 128)));
+        _mm512_storeu_si512(out + i + 192, _mm512_xor_si512(b3,
+                            _mm512_loadu_si512(in + i + 192)));
+    }
+    while (i < nbytes) {
+        word32    n = (nbytes - i < 64) ? nbytes - i : 64;
+        __mmask64 m = vaes_mask(n);
+        __m512i   c = _mm512_maskz_loadu_epi8(m, in + i);
+
+        X = vaes_ghash4(&g, X, _mm512_shuffle_epi8(c, bswap), (n + 15) / 16);
+        b0 = vaes_enc4(&g, ctr, bswap64, nr);
+        ctr = _mm512_add_epi32(ctr, four);
+        _mm512_mask_storeu_epi8(out + i, m, _mm512_xor_si512(b0, c));
+        i += n;
+    }
+
+    T = vaes_gcm_final(&g, X, nbytes, abytes);
+    *res = ConstantCompare(tag, (const byte*)&T, (int)tbytes) == 0;
+}
+#endif /* HAVE_AES_DECRYPT */
+#endif /* HAVE_INTEL_VAES */
+#endif /* WOLFSSL_AESNI */
+
+
+#if defined(GCM_SMALL)
+static void GMULT(byte* X, byte* Y)
+{
+    byte Z[AES_BLOCK_SIZE];
+    byte V[AES_BLOCK_SIZE];
+    int i, j;
+
+    XMEMSET(Z, 0, AES_BLOCK_SIZE);
+    XMEMCPY(V, X, AES_BLOCK_SIZE);
+    for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+        byte y = Y[i];
+        for (j = 0; j < 8; j++)
+        {
+            if (y & 0x80) {
+                xorbuf(Z, V, AES_BLOCK_SIZE);
+            }
+
+            RIGHTSHIFTX(V);
+            y = y << 1;
+        }
+    }
+    XMEMCPY(X, Z, AES_BLOCK_SIZE);
 }
 
 
@@ -6407,6 +7095,408 @@ void GHASH(Aes* aes, const byte* a, word32 aSz, const byte* c,
 #endif /* end GCM_WORD32 */
 
 
+#ifdef WOLFSSL_AESGCM_STREAM
+
+#ifdef FREESCALE_LTC_AES_GCM
+    #error "AES-GCM streaming is not supported with FREESCALE_LTC_AES_GCM"
+#endif
+
+/* GHASH whole blocks into x, the running hash of an incremental operation */
+static void GcmHashBlocks(Aes* aes, byte* x, const byte* in, word32 blocks)
+{
+#if defined(GCM_SMALL) || defined(GCM_TABLE) || defined(GCM_TABLE_4BIT)
+    while (blocks--) {
+        xorbuf(x, in, AES_BLOCK_SIZE);
+    #ifdef GCM_SMALL
+        GMULT(x, aes->H);
+    #else
+        GMULT(x, aes->M0);
+    #endif
+        in += AES_BLOCK_SIZE;
+    }
+#elif defined(WORD64_AVAILABLE) && !defined(GCM_WORD32)
+    word64 bigX[2];
+    word64 bigA[2];
+    word64 bigH[2];
+
+    XMEMCPY(bigH, aes->H, AES_BLOCK_SIZE);
+    XMEMCPY(bigX, x, AES_BLOCK_SIZE);
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords64(bigH, bigH, AES_BLOCK_SIZE);
+        ByteReverseWords64(bigX, bigX, AES_BLOCK_SIZE);
+    #endif
+    while (blocks--) {
+        XMEMCPY(bigA, in, AES_BLOCK_SIZE);
+        #ifdef LITTLE_ENDIAN_ORDER
+            ByteReverseWords64(bigA, bigA, AES_BLOCK_SIZE);
+        #endif
+        bigX[0] ^= bigA[0];
+        bigX[1] ^= bigA[1];
+        GMULT(bigX, bigH);
+        in += AES_BLOCK_SIZE;
+    }
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords64(bigX, bigX, AES_BLOCK_SIZE);
+    #endif
+    XMEMCPY(x, bigX, AES_BLOCK_SIZE);
+#else
+    word32 bigX[4];
+    word32 bigA[4];
+    word32 bigH[4];
+
+    XMEMCPY(bigH, aes->H, AES_BLOCK_SIZE);
+    XMEMCPY(bigX, x, AES_BLOCK_SIZE);
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords(bigH, bigH, AES_BLOCK_SIZE);
+        ByteReverseWords(bigX, bigX, AES_BLOCK_SIZE);
+    #endif
+    while (blocks--) {
+        XMEMCPY(bigA, in, AES_BLOCK_SIZE);
+        #ifdef LITTLE_ENDIAN_ORDER
+            ByteReverseWords(bigA, bigA, AES_BLOCK_SIZE);
+        #endif
+        bigX[0] ^= bigA[0];
+        bigX[1] ^= bigA[1];
+        bigX[2] ^= bigA[2];
+        bigX[3] ^= bigA[3];
+        GMULT(bigX, bigH);
+        in += AES_BLOCK_SIZE;
+    }
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords(bigX, bigX, AES_BLOCK_SIZE);
+    #endif
+    XMEMCPY(x, bigX, AES_BLOCK_SIZE);
+#endif
+}
+
+/* GHASH whole blocks into the running hash */
+static void GcmStreamHash(Aes* aes, const byte* in, word32 blocks)
+{
+#ifdef WOLFSSL_AESNI
+    if (haveAESNI && aes->use_aesni) {
+        SAVE_VECTOR_REGISTERS();
+        AesGcmStreamHashAesni(aes, in, blocks);
+        RESTORE_VECTOR_REGISTERS();
+        return;
+    }
+#endif
+    GcmHashBlocks(aes, aes->gcmX, in, blocks);
+}
+
+/* GHASH the last, partial, block of a field zero padded */
+static void GcmStreamHashPartial(Aes* aes, const byte* in, word32 sz)
+{
+    byte scratch[AES_BLOCK_SIZE];
+
+    XMEMSET(scratch, 0, AES_BLOCK_SIZE);
+    XMEMCPY(scratch, in, sz);
+    GcmStreamHash(aes, scratch, 1);
+}
+
+/* GHASH the block of lengths in bits: 64-bit big-endian aSz then cSz */
+static void GcmStreamHashLengths(Aes* aes, word32 aHi, word32 aLo, word32 cHi,
+                                 word32 cLo)
+{
+    byte scratch[AES_BLOCK_SIZE];
+
+    c32toa((aHi << 3) | (aLo >> 29), &scratch[0]);
+    c32toa(aLo << 3, &scratch[4]);
+    c32toa((cHi << 3) | (cLo >> 29), &scratch[8]);
+    c32toa(cLo << 3, &scratch[12]);
+    GcmStreamHash(aes, scratch, 1);
+}
+
+/* Running hash in the byte order of the GCM specification */
+static void GcmStreamGetHash(Aes* aes, byte* x)
+{
+#ifdef WOLFSSL_AESNI
+    if (haveAESNI && aes->use_aesni) {
+        SAVE_VECTOR_REGISTERS();
+        AesGcmStreamGetHashAesni(aes, x);
+        RESTORE_VECTOR_REGISTERS();
+        return;
+    }
+#endif
+    XMEMCPY(x, aes->gcmX, AES_BLOCK_SIZE);
+}
+
+/* CTR encrypt or decrypt whole blocks and GHASH the cipher text */
+static void GcmStreamCrypt(Aes* aes, byte* out, const byte* in, word32 blocks,
+                           int enc)
+{
+    word32 i;
+
+#ifdef WOLFSSL_AESNI
+    if (haveAESNI && aes->use_aesni) {
+        SAVE_VECTOR_REGISTERS();
+        AesGcmStreamCryptAesni(aes, out, in, blocks, enc);
+        RESTORE_VECTOR_REGISTERS();
+        return;
+    }
+#endif
+
+    /* hash cipher text before it is overwritten when decrypting in place */
+    if (!enc)
+        GcmHashBlocks(aes, aes->gcmX, in, blocks);
+    for (i = 0; i < blocks; i++) {
+        IncrementGcmCounter(aes->gcmCtr);
+        wc_AesEncrypt(aes, aes->gcmCtr, aes->gcmKs);
+        xorbufout(out + i * AES_BLOCK_SIZE, in + i * AES_BLOCK_SIZE,
+                  aes->gcmKs, AES_BLOCK_SIZE);
+    }
+    if (enc)
+        GcmHashBlocks(aes, aes->gcmX, out, blocks);
+}
+
+/* Encrypt or decrypt sz bytes against the key stream left in aes->gcmKs */
+static void GcmStreamCryptPartial(Aes* aes, byte* out, const byte* in,
+                                  word32 sz, int enc)
+{
+    byte*       part = aes->gcmPart + aes->gcmCOver;
+    const byte* ks = aes->gcmKs + aes->gcmCOver;
+    word32      i;
+
+    for (i = 0; i < sz; i++) {
+        byte c = in[i];
+
+        out[i] = c ^ ks[i];
+        part[i] = enc ? out[i] : c;
+    }
+
+    aes->gcmCOver += (byte)sz;
+    if (aes->gcmCOver == AES_BLOCK_SIZE) {
+        GcmStreamHash(aes, aes->gcmPart, 1);
+        aes->gcmCOver = 0;
+    }
+}
+
+int wc_AesGcmInit(Aes* aes, const byte* key, word32 len, const byte* iv,
+                  word32 ivSz)
+{
+    int ret = 0;
+
+    if (aes == NULL || (iv == NULL && ivSz != 0) ||
+                                                 (iv != NULL && ivSz == 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (key != NULL) {
+        ret = wc_AesGcmSetKey(aes, key, len);
+        aes->gcmIvSet = 0;
+    }
+
+    if (ret == 0 && iv != NULL) {
+        XMEMSET(aes->gcmX, 0, AES_BLOCK_SIZE);
+
+        if (ivSz == GCM_NONCE_MID_SZ) {
+            XMEMCPY(aes->gcmCtr, iv, ivSz);
+            XMEMSET(aes->gcmCtr + GCM_NONCE_MID_SZ, 0,
+                    AES_BLOCK_SIZE - GCM_NONCE_MID_SZ - 1);
+            aes->gcmCtr[AES_BLOCK_SIZE - 1] = 1;
+        }
+        else {
+            /* Y0 = GHASH(IV || 0-pad || [0]64 || [len(IV)]64) */
+            GcmStreamHash(aes, iv, ivSz / AES_BLOCK_SIZE);
+            if (ivSz % AES_BLOCK_SIZE != 0) {
+                GcmStreamHashPartial(aes, iv + ivSz - ivSz % AES_BLOCK_SIZE,
+                                     ivSz % AES_BLOCK_SIZE);
+            }
+            GcmStreamHashLengths(aes, 0, 0, 0, ivSz);
+            GcmStreamGetHash(aes, aes->gcmCtr);
+            XMEMSET(aes->gcmX, 0, AES_BLOCK_SIZE);
+        }
+
+        wc_AesEncrypt(aes, aes->gcmCtr, aes->gcmEky0);
+        aes->gcmASz = 0;
+        aes->gcmCSz = 0;
+        aes->gcmAOver = 0;
+        aes->gcmCOver = 0;
+        aes->gcmIvSet = 1;
+    }
+
+    return ret;
+}
+
+/* Hash in more AAD and encrypt or decrypt more text. AAD must all be passed
+ * before any text. */
+static int AesGcmStreamUpdate(Aes* aes, byte* out, const byte* in, word32 sz,
+                              const byte* authIn, word32 authInSz, int enc)
+{
+    word32 n;
+    word32 blocks;
+
+    if (aes == NULL || (sz != 0 && (in == NULL || out == NULL)) ||
+                                        (authInSz != 0 && authIn == NULL)) {
+        return BAD_FUNC_ARG;
+    }
+    if (!aes->gcmIvSet) {
+        WOLFSSL_MSG("AES-GCM stream not initialized with an IV");
+        return BAD_STATE_E;
+    }
+
+    if (authInSz != 0) {
+        if (aes->gcmCSz != 0) {
+            WOLFSSL_MSG("AES-GCM AAD passed after text");
+            return BAD_FUNC_ARG;
+        }
+    #ifndef WORD64_AVAILABLE
+        if (aes->gcmASz + authInSz < aes->gcmASz)
+            return BAD_FUNC_ARG;
+    #endif
+        aes->gcmASz += authInSz;
+
+        if (aes->gcmAOver != 0) {
+            n = min(AES_BLOCK_SIZE - aes->gcmAOver, authInSz);
+            XMEMCPY(aes->gcmPart + aes->gcmAOver, authIn, n);
+            aes->gcmAOver += (byte)n;
+            authIn += n;
+            authInSz -= n;
+            if (aes->gcmAOver == AES_BLOCK_SIZE) {
+                GcmStreamHash(aes, aes->gcmPart, 1);
+                aes->gcmAOver = 0;
+            }
+        }
+        blocks = authInSz / AES_BLOCK_SIZE;
+        if (blocks != 0) {
+            GcmStreamHash(aes, authIn, blocks);
+            authIn += blocks * AES_BLOCK_SIZE;
+            authInSz -= blocks * AES_BLOCK_SIZE;
+        }
+        if (authInSz != 0) {
+            XMEMCPY(aes->gcmPart, authIn, authInSz);
+            aes->gcmAOver = (byte)authInSz;
+        }
+    }
+
+    if (sz != 0) {
+    #ifdef WORD64_AVAILABLE
+        /* At most 2^32 - 2 blocks of text per IV. */
+        if (aes->gcmCSz + sz > ((word64)0xFFFFFFFE * AES_BLOCK_SIZE))
+            return BAD_FUNC_ARG;
+    #else
+        if (aes->gcmCSz + sz < aes->gcmCSz)
+            return BAD_FUNC_ARG;
+    #endif
+
+        if (aes->gcmAOver != 0) {
+            GcmStreamHashPartial(aes, aes->gcmPart, aes->gcmAOver);
+            aes->gcmAOver = 0;
+        }
+        aes->gcmCSz += sz;
+
+        if (aes->gcmCOver != 0) {
+            n = min(AES_BLOCK_SIZE - aes->gcmCOver, sz);
+            GcmStreamCryptPartial(aes, out, in, n, enc);
+            in += n;
+            out += n;
+            sz -= n;
+        }
+        blocks = sz / AES_BLOCK_SIZE;
+        if (blocks != 0) {
+            GcmStreamCrypt(aes, out, in, blocks, enc);
+            in += blocks * AES_BLOCK_SIZE;
+            out += blocks * AES_BLOCK_SIZE;
+            sz -= blocks * AES_BLOCK_SIZE;
+        }
+        if (sz != 0) {
+            IncrementGcmCounter(aes->gcmCtr);
+            wc_AesEncrypt(aes, aes->gcmCtr, aes->gcmKs);
+            GcmStreamCryptPartial(aes, out, in, sz, enc);
+        }
+    }
+
+    return 0;
+}
+
+/* Hash in what is left and the lengths, and calculate the full tag */
+static int AesGcmStreamFinal(Aes* aes, byte* tag, word32 authTagSz)
+{
+    if (aes == NULL || authTagSz > AES_BLOCK_SIZE) {
+        return BAD_FUNC_ARG;
+    }
+    if (authTagSz < WOLFSSL_MIN_AUTH_TAG_SZ) {
+        WOLFSSL_MSG("GcmFinal authTagSz too small error");
+        return BAD_FUNC_ARG;
+    }
+    if (!aes->gcmIvSet) {
+        WOLFSSL_MSG("AES-GCM stream not initialized with an IV");
+        return BAD_STATE_E;
+    }
+
+    if (aes->gcmAOver != 0) {
+        GcmStreamHashPartial(aes, aes->gcmPart, aes->gcmAOver);
+        aes->gcmAOver = 0;
+    }
+    if (aes->gcmCOver != 0) {
+        GcmStreamHashPartial(aes, aes->gcmPart, aes->gcmCOver);
+        aes->gcmCOver = 0;
+    }
+#ifdef WORD64_AVAILABLE
+    GcmStreamHashLengths(aes, (word32)(aes->gcmASz >> 32), (word32)aes->gcmASz,
+                         (word32)(aes->gcmCSz >> 32), (word32)aes->gcmCSz);
+#else
+    GcmStreamHashLengths(aes, 0, aes->gcmASz, 0, aes->gcmCSz);
+#endif
+    GcmStreamGetHash(aes, tag);
+    xorbuf(tag, aes->gcmEky0, AES_BLOCK_SIZE);
+
+    /* the IV must not be used again */
+    aes->gcmIvSet = 0;
+    ForceZero(aes->gcmKs, sizeof(aes->gcmKs));
+    ForceZero(aes->gcmPart, sizeof(aes->gcmPart));
+
+    return 0;
+}
+
+int wc_AesGcmEncryptUpdate(Aes* aes, byte* out, const byte* in, word32 sz,
+                           const byte* authIn, word32 authInSz)
+{
+    return AesGcmStreamUpdate(aes, out, in, sz, authIn, authInSz, 1);
+}
+
+int wc_AesGcmEncryptFinal(Aes* aes, byte* authTag, word32 authTagSz)
+{
+    byte tag[AES_BLOCK_SIZE];
+    int  ret;
+
+    if (authTag == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = AesGcmStreamFinal(aes, tag, authTagSz);
+    if (ret == 0)
+        XMEMCPY(authTag, tag, authTagSz);
+    ForceZero(tag, sizeof(tag));
+
+    return ret;
+}
+
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+int wc_AesGcmDecryptUpdate(Aes* aes, byte* out, const byte* in, word32 sz,
+                           const byte* authIn, word32 authInSz)
+{
+    return AesGcmStreamUpdate(aes, out, in, sz, authIn, authInSz, 0);
+}
+
+int wc_AesGcmDecryptFinal(Aes* aes, const byte* authTag, word32 authTagSz)
+{
+    byte tag[AES_BLOCK_SIZE];
+    int  ret;
+
+    if (authTag == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = AesGcmStreamFinal(aes, tag, authTagSz);
+    if (ret == 0 && ConstantCompare(authTag, tag, (int)authTagSz) != 0)
+        ret = AES_GCM_AUTH_E;
+    ForceZero(tag, sizeof(tag));
+
+    return ret;
+}
+#endif /* HAVE_AES_DECRYPT || HAVE_AESGCM_DECRYPT */
+
+#endif /* WOLFSSL_AESGCM_STREAM */
+
+
 #if !defined(WOLFSSL_XILINX_CRYPT) && !defined(WOLFSSL_AFALG_XILINX_AES)
 #ifdef FREESCALE_LTC_AES_GCM
 int wc_AesGcmEncrypt(Aes* aes, byte* out, const byte* in, word32 sz,
@@ -6845,6 +7935,16 @@ int wc_AesGcmEncrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 #endif /* STM32_CRYPTO_AES_GCM */
 
 #ifdef WOLFSSL_AESNI
+    #ifdef HAVE_INTEL_VAES
+    if (IS_AESGCM_VAES(intel_flags, sz)) {
+        SAVE_VECTOR_REGISTERS();
+        AES_GCM_encrypt_vaes(in, out, authIn, iv, authTag, sz, authInSz, ivSz,
+                                 authTagSz, (const byte*)aes->key, aes->rounds);
+        RESTORE_VECTOR_REGISTERS();
+        return 0;
+    }
+    else
+    #endif
     #ifdef HAVE_INTEL_AVX2
     if (IS_INTEL_AVX2(intel_flags)) {
         SAVE_VECTOR_REGISTERS();
@@ -7339,6 +8439,18 @@ int wc_AesGcmDecrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 #endif /* STM32_CRYPTO_AES_GCM */
 
 #ifdef WOLFSSL_AESNI
+    #ifdef HAVE_INTEL_VAES
+    if (IS_AESGCM_VAES(intel_flags, sz)) {
+        SAVE_VECTOR_REGISTERS();
+        AES_GCM_decrypt_vaes(in, out, authIn, iv, authTag, sz, authInSz, ivSz,
+                                 authTagSz, (byte*)aes->key, aes->rounds, &res);
+        RESTORE_VECTOR_REGISTERS();
+        if (res == 0)
+            return AES_GCM_AUTH_E;
+        return 0;
+    }
+    else
+    #endif
     #ifdef HAVE_INTEL_AVX2
     if (IS_INTEL_AVX2(intel_flags)) {
         SAVE_VECTOR_REGISTERS();
@@ -7820,44 +8932,124 @@ static WC_INLINE void AesCcmCtrInc(byte* B, word32 lenSz)
 }
 
 #ifdef WOLFSSL_AESNI
-static WC_INLINE void AesCcmCtrIncSet4(byte* B, word32 lenSz)
+/* Counter block of CCM as a little endian value, the counter in the low
+ * lenSz bytes. Adding one only within those bytes keeps the wrap of
+ * AesCcmCtrInc(). */
+#define AESCCM_CTR_INC(c, one, fmask) \
+    _mm_blendv_epi8((c), _mm_add_epi64((c), (one)), (fmask))
+
+/* byte swap for the counter block */
+#define AESCCM_BSWAP_MASK \
+    _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+
+/* mask of the low lenSz bytes of the little endian counter block */
+static WC_INLINE __m128i AesCcmCtrMask(word32 lenSz)
 {
-    word32 i;
+    ALIGN16 byte m[AES_BLOCK_SIZE];
 
-    /* B+1 = B */
-    XMEMCPY(B + AES_BLOCK_SIZE * 1, B, AES_BLOCK_SIZE);
-    /* B+2,B+3 = B,B+1 */
-    XMEMCPY(B + AES_BLOCK_SIZE * 2, B, AES_BLOCK_SIZE * 2);
+    XMEMSET(m, 0, sizeof(m));
+    XMEMSET(m, 0xFF, lenSz);
+    return _mm_load_si128((const __m128i*)m);
+}
 
-    for (i = 0; i < lenSz; i++) {
-        if (++B[AES_BLOCK_SIZE * 2 - 1 - i] != 0) break;
-    }
-    B[AES_BLOCK_SIZE * 3 - 1] += 2;
-    if (B[AES_BLOCK_SIZE * 3 - 1] < 2) {
-        for (i = 1; i < lenSz; i++) {
-            if (++B[AES_BLOCK_SIZE * 3 - 1 - i] != 0) break;
-        }
-    }
-    B[AES_BLOCK_SIZE * 4 - 1] += 3;
-    if (B[AES_BLOCK_SIZE * 4 - 1] < 3) {
-        for (i = 1; i < lenSz; i++) {
-            if (++B[AES_BLOCK_SIZE * 4 - 1 - i] != 0) break;
-        }
+/* CBC-MAC and CTR encrypt whole blocks with AES-NI. The CBC-MAC is a serial
+ * chain, so the rounds of each counter block are interleaved with it and run
+ * in the gaps left by the latency of the MAC rounds. mac holds the running
+ * CBC-MAC and ctr the counter block, both are updated. */
+static void AesCcmEncryptAesni(const byte* in, byte* out, word32 blocks,
+                               byte* mac, byte* ctr, word32 lenSz,
+                               const byte* key, int nr)
+{
+    const __m128i* KEY = (const __m128i*)key;
+    const __m128i bswap = AESCCM_BSWAP_MASK;
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    const __m128i fmask = AesCcmCtrMask(lenSz);
+    __m128i m = _mm_loadu_si128((const __m128i*)mac);
+    __m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ctr), bswap);
+    __m128i k0 = _mm_loadu_si128(&KEY[0]);
+    __m128i p, x, k;
+    int     r;
+
+    for (; blocks > 0; blocks--) {
+        p = _mm_loadu_si128((const __m128i*)in);
+        m = _mm_xor_si128(_mm_xor_si128(m, p), k0);
+        x = _mm_xor_si128(_mm_shuffle_epi8(c, bswap), k0);
+        for (r = 1; r < nr; r++) {
+            k = _mm_loadu_si128(&KEY[r]);
+            m = _mm_aesenc_si128(m, k);
+            x = _mm_aesenc_si128(x, k);
+        }
+        k = _mm_loadu_si128(&KEY[nr]);
+        m = _mm_aesenclast_si128(m, k);
+        x = _mm_aesenclast_si128(x, k);
+        _mm_storeu_si128((__m128i*)out, _mm_xor_si128(x, p));
+        c = AESCCM_CTR_INC(c, one, fmask);
+        in  += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
     }
+
+    _mm_storeu_si128((__m128i*)mac, m);
+    _mm_storeu_si128((__m128i*)ctr, _mm_shuffle_epi8(c, bswap));
 }
 
-static WC_INLINE void AesCcmCtrInc4(byte* B, word32 lenSz)
+#ifdef HAVE_AES_DECRYPT
+/* CTR decrypt and CBC-MAC whole blocks with AES-NI, blocks must not be zero.
+ * The CBC-MAC needs the plain text, so each counter block is interleaved with
+ * the MAC of the block before it. mac and ctr as AesCcmEncryptAesni(). */
+static void AesCcmDecryptAesni(const byte* in, byte* out, word32 blocks,
+                               byte* mac, byte* ctr, word32 lenSz,
+                               const byte* key, int nr)
 {
-    word32 i;
-
-    B[AES_BLOCK_SIZE - 1] += 4;
-    if (B[AES_BLOCK_SIZE - 1] < 4) {
-        for (i = 1; i < lenSz; i++) {
-            if (++B[AES_BLOCK_SIZE - 1 - i] != 0) break;
-        }
+    const __m128i* KEY = (const __m128i*)key;
+    const __m128i bswap = AESCCM_BSWAP_MASK;
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    const __m128i fmask = AesCcmCtrMask(lenSz);
+    __m128i m = _mm_loadu_si128((const __m128i*)mac);
+    __m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ctr), bswap);
+    __m128i k0 = _mm_loadu_si128(&KEY[0]);
+    __m128i p, x, k;
+    int     r;
+
+    /* first counter block on its own */
+    x = _mm_xor_si128(_mm_shuffle_epi8(c, bswap), k0);
+    for (r = 1; r < nr; r++)
+        x = _mm_aesenc_si128(x, _mm_loadu_si128(&KEY[r]));
+    x = _mm_aesenclast_si128(x, _mm_loadu_si128(&KEY[nr]));
+    p = _mm_xor_si128(x, _mm_loadu_si128((const __m128i*)in));
+    _mm_storeu_si128((__m128i*)out, p);
+    c = AESCCM_CTR_INC(c, one, fmask);
+    in  += AES_BLOCK_SIZE;
+    out += AES_BLOCK_SIZE;
+
+    for (blocks--; blocks > 0; blocks--) {
+        m = _mm_xor_si128(_mm_xor_si128(m, p), k0);
+        x = _mm_xor_si128(_mm_shuffle_epi8(c, bswap), k0);
+        for (r = 1; r < nr; r++) {
+            k = _mm_loadu_si128(&KEY[r]);
+            m = _mm_aesenc_si128(m, k);
+            x = _mm_aesenc_si128(x, k);
+        }
+        k = _mm_loadu_si128(&KEY[nr]);
+        m = _mm_aesenclast_si128(m, k);
+        x = _mm_aesenclast_si128(x, k);
+        p = _mm_xor_si128(x, _mm_loadu_si128((const __m128i*)in));
+        _mm_storeu_si128((__m128i*)out, p);
+        c = AESCCM_CTR_INC(c, one, fmask);
+        in  += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
     }
+
+    /* MAC of the last block on its own */
+    m = _mm_xor_si128(_mm_xor_si128(m, p), k0);
+    for (r = 1; r < nr; r++)
+        m = _mm_aesenc_si128(m, _mm_loadu_si128(&KEY[r]));
+    m = _mm_aesenclast_si128(m, _mm_loadu_si128(&KEY[nr]));
+
+    _mm_storeu_si128((__m128i*)mac, m);
+    _mm_storeu_si128((__m128i*)ctr, _mm_shuffle_epi8(c, bswap));
 }
-#endif
+#endif /* HAVE_AES_DECRYPT */
+#endif /* WOLFSSL_AESNI */
 
 /* Software AES - CCM Encrypt */
 /* return 0 on success */
@@ -7866,12 +9058,12 @@ int wc_AesCcmEncrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
                    byte* authTag, word32 authTagSz,
                    const byte* authIn, word32 authInSz)
 {
-#ifndef WOLFSSL_AESNI
     byte A[AES_BLOCK_SIZE];
+#ifndef WOLFSSL_AESNI
     byte B[AES_BLOCK_SIZE];
 #else
-    ALIGN128 byte A[AES_BLOCK_SIZE * 4];
-    ALIGN128 byte B[AES_BLOCK_SIZE * 4];
+    /* counter block and the key stream of a trailing partial block */
+    byte B[AES_BLOCK_SIZE * 2];
 #endif
     byte lenSz;
     word32 i;
@@ -7905,6 +9097,34 @@ int wc_AesCcmEncrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
 
     if (authInSz > 0)
         roll_auth(aes, authIn, authInSz, A);
+
+#ifdef WOLFSSL_AESNI
+    /* CBC-MAC and encrypt the payload in one pass */
+    if (haveAESNI && aes->use_aesni && inSz >= AES_BLOCK_SIZE) {
+        word32 blocksSz = inSz & ~(word32)(AES_BLOCK_SIZE - 1);
+
+        B[0] = lenSz - 1;
+        for (i = 0; i < lenSz; i++)
+            B[AES_BLOCK_SIZE - 1 - i] = 0;
+        B[15] = 1;
+
+        SAVE_VECTOR_REGISTERS();
+        AesCcmEncryptAesni(in, out, blocksSz / AES_BLOCK_SIZE, A, B, lenSz,
+                           (byte*)aes->key, aes->rounds);
+        RESTORE_VECTOR_REGISTERS();
+        in   += blocksSz;
+        out  += blocksSz;
+        inSz -= blocksSz;
+
+        if (inSz > 0) {
+            roll_x(aes, in, inSz, A);
+            wc_AesEncrypt(aes, B, B + AES_BLOCK_SIZE);
+            xorbuf(B + AES_BLOCK_SIZE, in, inSz);
+            XMEMCPY(out, B + AES_BLOCK_SIZE, inSz);
+            inSz = 0;
+        }
+    }
+#endif
     if (inSz > 0)
         roll_x(aes, in, inSz, A);
     XMEMCPY(authTag, A, authTagSz);
@@ -7916,27 +9136,6 @@ int wc_AesCcmEncrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
     xorbuf(authTag, A, authTagSz);
 
     B[15] = 1;
-#ifdef WOLFSSL_AESNI
-    if (haveAESNI && aes->use_aesni) {
-        while (inSz >= AES_BLOCK_SIZE * 4) {
-            AesCcmCtrIncSet4(B, lenSz);
-
-            SAVE_VECTOR_REGISTERS();
-            AES_ECB_encrypt(B, A, AES_BLOCK_SIZE * 4, (byte*)aes->key,
-                            aes->rounds);
-            RESTORE_VECTOR_REGISTERS();
-
-            xorbuf(A, in, AES_BLOCK_SIZE * 4);
-            XMEMCPY(out, A, AES_BLOCK_SIZE * 4);
-
-            inSz -= AES_BLOCK_SIZE * 4;
-            in += AES_BLOCK_SIZE * 4;
-            out += AES_BLOCK_SIZE * 4;
-
-            AesCcmCtrInc4(B, lenSz);
-        }
-    }
-#endif
     while (inSz >= AES_BLOCK_SIZE) {
         wc_AesEncrypt(aes, B, A);
         xorbuf(A, in, AES_BLOCK_SIZE);
@@ -7953,8 +9152,8 @@ int wc_AesCcmEncrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
         XMEMCPY(out, A, inSz);
     }
 
-    ForceZero(A, AES_BLOCK_SIZE);
-    ForceZero(B, AES_BLOCK_SIZE);
+    ForceZero(A, sizeof(A));
+    ForceZero(B, sizeof(B));
 
     return 0;
 }
@@ -7966,12 +9165,12 @@ int  wc_AesCcmDecrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
                    const byte* authTag, word32 authTagSz,
                    const byte* authIn, word32 authInSz)
 {
-#ifndef WOLFSSL_AESNI
     byte A[AES_BLOCK_SIZE];
+#ifndef WOLFSSL_AESNI
     byte B[AES_BLOCK_SIZE];
 #else
-    ALIGN128 byte B[AES_BLOCK_SIZE * 4];
-    ALIGN128 byte A[AES_BLOCK_SIZE * 4];
+    /* counter block and the key stream of a trailing partial block */
+    byte B[AES_BLOCK_SIZE * 2];
 #endif
     byte* o;
     byte lenSz;
@@ -7996,70 +9195,89 @@ int  wc_AesCcmDecrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
     XMEMCPY(B+1, nonce, nonceSz);
     lenSz = AES_BLOCK_SIZE - 1 - (byte)nonceSz;
 
-    B[0] = lenSz - 1;
-    for (i = 0; i < lenSz; i++)
-        B[AES_BLOCK_SIZE - 1 - i] = 0;
-    B[15] = 1;
-
 #ifdef WOLFSSL_AESNI
-    if (haveAESNI && aes->use_aesni) {
-        while (oSz >= AES_BLOCK_SIZE * 4) {
-            AesCcmCtrIncSet4(B, lenSz);
+    /* CBC-MAC the auth data first so the payload can be decrypted and
+     * CBC-MACed in one pass */
+    if (haveAESNI && aes->use_aesni && inSz >= AES_BLOCK_SIZE) {
+        word32 blocksSz = inSz & ~(word32)(AES_BLOCK_SIZE - 1);
 
-            SAVE_VECTOR_REGISTERS();
-            AES_ECB_encrypt(B, A, AES_BLOCK_SIZE * 4, (byte*)aes->key,
-                            aes->rounds);
-            RESTORE_VECTOR_REGISTERS();
+        B[0] = (authInSz > 0 ? 64 : 0)
+             + (8 * (((byte)authTagSz - 2) / 2))
+             + (lenSz - 1);
+        for (i = 0; i < lenSz; i++) {
+            if (mask && i >= wordSz)
+                mask = 0x00;
+            B[AES_BLOCK_SIZE - 1 - i] = (inSz >> ((8 * i) & mask)) & mask;
+        }
 
-            xorbuf(A, in, AES_BLOCK_SIZE * 4);
-            XMEMCPY(o, A, AES_BLOCK_SIZE * 4);
+        wc_AesEncrypt(aes, B, A);
+
+        if (authInSz > 0)
+            roll_auth(aes, authIn, authInSz, A);
 
-            oSz -= AES_BLOCK_SIZE * 4;
-            in += AES_BLOCK_SIZE * 4;
-            o += AES_BLOCK_SIZE * 4;
+        B[0] = lenSz - 1;
+        for (i = 0; i < lenSz; i++)
+            B[AES_BLOCK_SIZE - 1 - i] = 0;
+        B[15] = 1;
 
-            AesCcmCtrInc4(B, lenSz);
+        SAVE_VECTOR_REGISTERS();
+        AesCcmDecryptAesni(in, o, blocksSz / AES_BLOCK_SIZE, A, B, lenSz,
+                           (byte*)aes->key, aes->rounds);
+        RESTORE_VECTOR_REGISTERS();
+        in  += blocksSz;
+        o   += blocksSz;
+        oSz -= blocksSz;
+
+        if (oSz > 0) {
+            wc_AesEncrypt(aes, B, B + AES_BLOCK_SIZE);
+            xorbuf(B + AES_BLOCK_SIZE, in, oSz);
+            XMEMCPY(o, B + AES_BLOCK_SIZE, oSz);
+            roll_x(aes, o, oSz, A);
         }
     }
+    else
 #endif
-    while (oSz >= AES_BLOCK_SIZE) {
-        wc_AesEncrypt(aes, B, A);
-        xorbuf(A, in, AES_BLOCK_SIZE);
-        XMEMCPY(o, A, AES_BLOCK_SIZE);
+    {
+        B[0] = lenSz - 1;
+        for (i = 0; i < lenSz; i++)
+            B[AES_BLOCK_SIZE - 1 - i] = 0;
+        B[15] = 1;
 
-        AesCcmCtrInc(B, lenSz);
-        oSz -= AES_BLOCK_SIZE;
-        in += AES_BLOCK_SIZE;
-        o += AES_BLOCK_SIZE;
-    }
-    if (inSz > 0) {
-        wc_AesEncrypt(aes, B, A);
-        xorbuf(A, in, oSz);
-        XMEMCPY(o, A, oSz);
-    }
+        while (oSz >= AES_BLOCK_SIZE) {
+            wc_AesEncrypt(aes, B, A);
+            xorbuf(A, in, AES_BLOCK_SIZE);
+            XMEMCPY(o, A, AES_BLOCK_SIZE);
 
-    for (i = 0; i < lenSz; i++)
-        B[AES_BLOCK_SIZE - 1 - i] = 0;
-    wc_AesEncrypt(aes, B, A);
+            AesCcmCtrInc(B, lenSz);
+            oSz -= AES_BLOCK_SIZE;
+            in += AES_BLOCK_SIZE;
+            o += AES_BLOCK_SIZE;
+        }
+        if (inSz > 0) {
+            wc_AesEncrypt(aes, B, A);
+            xorbuf(A, in, oSz);
+            XMEMCPY(o, A, oSz);
+        }
 
-    o = out;
-    oSz = inSz;
+        o = out;
+        oSz = inSz;
 
-    B[0] = (authInSz > 0 ? 64 : 0)
-         + (8 * (((byte)authTagSz - 2) / 2))
-         + (lenSz - 1);
-    for (i = 0; i < lenSz; i++) {
-        if (mask && i >= wordSz)
-            mask = 0x00;
-        B[AES_BLOCK_SIZE - 1 - i] = (inSz >> ((8 * i) & mask)) & mask;
-    }
+        B[0] = (authInSz > 0 ? 64 : 0)
+             + (8 * (((byte)authTagSz - 2) / 2))
+             + (lenSz - 1);
+        for (i = 0; i < lenSz; i++) {
+            if (mask && i >= wordSz)
+                mask = 0x00;
+            B[AES_BLOCK_SIZE - 1 - i] = (inSz >> ((8 * i) & mask)) & mask;
+        }
 
-    wc_AesEncrypt(aes, B, A);
+        wc_AesEncrypt(aes, B, A);
 
-    if (authInSz > 0)
-        roll_auth(aes, authIn, authInSz, A);
-    if (inSz > 0)
-        roll_x(aes, o, oSz, A);
+        if (authInSz > 0)
+            roll_auth(aes, authIn, authInSz, A);
+        if (inSz > 0)
+            roll_x(aes, o, oSz, A);
+    }
 
     B[0] = lenSz - 1;
     for (i = 0; i < lenSz; i++)
@@ -8081,8 +9299,8 @@ int  wc_AesCcmDecrypt(Aes* aes, byte* out, const byte* in, word32 inSz,
         result = AES_CCM_AUTH_E;
     }
 
-    ForceZero(A, AES_BLOCK_SIZE);
-    ForceZero(B, AES_BLOCK_SIZE);
+    ForceZero(A, sizeof(A));
+    ForceZero(B, sizeof(B));
     o = NULL;
 
     return result;
@@ -9221,6 +10439,237 @@ int wc_AesXtsDecryptSector(XtsAes* aes, byte* out, const byte* in, word32 sz,
     return wc_AesXtsDecrypt(aes, out, in, sz, (const byte*)i, AES_BLOCK_SIZE);
 }
 
+#ifdef WOLFSSL_AESNI
+/* Multiply the tweak by x: shift left one bit across the 128-bit little
+ * endian value, reducing with GF_XTS */
+static WC_INLINE __m128i AesXtsMulX(__m128i t)
+{
+    const __m128i poly = _mm_set_epi32(0, 1, 0, GF_XTS);
+    __m128i       c = _mm_srai_epi32(_mm_shuffle_epi32(t, 0x13), 31);
+
+    return _mm_xor_si128(_mm_add_epi64(t, t), _mm_and_si128(c, poly));
+}
+
+#define XTS_ROUND8(rnd, k)                                                    \
+    do {                                                                      \
+        __m128i rk_ = (k);                                                    \
+        b0 = rnd(b0, rk_); b1 = rnd(b1, rk_);                                 \
+        b2 = rnd(b2, rk_); b3 = rnd(b3, rk_);                                 \
+        b4 = rnd(b4, rk_); b5 = rnd(b5, rk_);                                 \
+        b6 = rnd(b6, rk_); b7 = rnd(b7, rk_);                                 \
+    } while (0)
+
+#define XTS_AESNI_RND(b, k)  (enc ? _mm_aesenc_si128(b, k) : \
+                                    _mm_aesdec_si128(b, k))
+#define XTS_AESNI_LAST(b, k) (enc ? _mm_aesenclast_si128(b, k) : \
+                                    _mm_aesdeclast_si128(b, k))
+
+/* Encrypt or decrypt whole blocks with AES-NI, eight at a time. The tweaks
+ * are XORed into the first and last round keys. tweak holds the tweak of the
+ * first block and gets the one following the last. */
+static WC_INLINE void AesXtsBlocksAesni(const byte* in, byte* out,
+                                        word32 blocks, byte* tweak,
+                                        const byte* key, int nr, int enc)
+{
+    const __m128i* KEY = (const __m128i*)key;
+    __m128i t = _mm_loadu_si128((const __m128i*)tweak);
+    __m128i k0 = _mm_loadu_si128(&KEY[0]);
+    __m128i kl = _mm_loadu_si128(&KEY[nr]);
+    __m128i b0, b1, b2, b3, b4, b5, b6, b7;
+    __m128i t0, t1, t2, t3, t4, t5, t6, t7;
+    int     r;
+
+    for (; blocks >= 8; blocks -= 8) {
+        t0 = t;
+        t1 = AesXtsMulX(t0);
+        t2 = AesXtsMulX(t1);
+        t3 = AesXtsMulX(t2);
+        t4 = AesXtsMulX(t3);
+        t5 = AesXtsMulX(t4);
+        t6 = AesXtsMulX(t5);
+        t7 = AesXtsMulX(t6);
+        t = AesXtsMulX(t7);
+
+        b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 0), t0);
+        b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 1), t1);
+        b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 2), t2);
+        b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 3), t3);
+        b4 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 4), t4);
+        b5 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 5), t5);
+        b6 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 6), t6);
+        b7 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in + 7), t7);
+        XTS_ROUND8(_mm_xor_si128, k0);
+        for (r = 1; r < nr; r++)
+            XTS_ROUND8(XTS_AESNI_RND, _mm_loadu_si128(&KEY[r]));
+        b0 = XTS_AESNI_LAST(b0, _mm_xor_si128(kl, t0));
+        b1 = XTS_AESNI_LAST(b1, _mm_xor_si128(kl, t1));
+        b2 = XTS_AESNI_LAST(b2, _mm_xor_si128(kl, t2));
+        b3 = XTS_AESNI_LAST(b3, _mm_xor_si128(kl, t3));
+        b4 = XTS_AESNI_LAST(b4, _mm_xor_si128(kl, t4));
+        b5 = XTS_AESNI_LAST(b5, _mm_xor_si128(kl, t5));
+        b6 = XTS_AESNI_LAST(b6, _mm_xor_si128(kl, t6));
+        b7 = XTS_AESNI_LAST(b7, _mm_xor_si128(kl, t7));
+        _mm_storeu_si128((__m128i*)out + 0, b0);
+        _mm_storeu_si128((__m128i*)out + 1, b1);
+        _mm_storeu_si128((__m128i*)out + 2, b2);
+        _mm_storeu_si128((__m128i*)out + 3, b3);
+        _mm_storeu_si128((__m128i*)out + 4, b4);
+        _mm_storeu_si128((__m128i*)out + 5, b5);
+        _mm_storeu_si128((__m128i*)out + 6, b6);
+        _mm_storeu_si128((__m128i*)out + 7, b7);
+        in  += AES_BLOCK_SIZE * 8;
+        out += AES_BLOCK_SIZE * 8;
+    }
+    for (; blocks > 0; blocks--) {
+        b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), t);
+        b0 = _mm_xor_si128(b0, k0);
+        for (r = 1; r < nr; r++)
+            b0 = XTS_AESNI_RND(b0, _mm_loadu_si128(&KEY[r]));
+        b0 = XTS_AESNI_LAST(b0, _mm_xor_si128(kl, t));
+        _mm_storeu_si128((__m128i*)out, b0);
+        t = AesXtsMulX(t);
+        in  += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+    _mm_storeu_si128((__m128i*)tweak, t);
+}
+
+#ifdef HAVE_INTEL_VAES
+/* Fewer blocks than this run faster on the AES-NI code */
+#ifndef AESXTS_VAES_MIN_BLOCKS
+    #define AESXTS_VAES_MIN_BLOCKS 16
+#endif
+#define IS_AESXTS_VAES(f, blocks) ((blocks) >= AESXTS_VAES_MIN_BLOCKS && \
+                                   IS_INTEL_AVX512(f) && IS_INTEL_VAES(f) && \
+                                   IS_INTEL_VPCLMULQDQ(f))
+
+/* Multiply the tweak in each 128-bit lane by x^k, 0 < k < 64 */
+static WC_INLINE WC_TARGET_VAES __m512i AesXtsMulXk(__m512i t, int k)
+{
+    const __m512i poly = _mm512_set_epi64(0, GF_XTS, 0, GF_XTS,
+                                          0, GF_XTS, 0, GF_XTS);
+    __m512i       c = _mm512_srli_epi64(_mm512_bsrli_epi128(t, 8), 64 - k);
+
+    t = _mm512_or_si512(_mm512_slli_epi64(t, k),
+                        _mm512_srli_epi64(_mm512_bslli_epi128(t, 8), 64 - k));
+    return _mm512_xor_si512(t, _mm512_clmulepi64_epi128(c, poly, 0x00));
+}
+
+#define XTS_ROUND16(rnd, k)                                                   \
+    do {                                                                      \
+        __m512i rk_ = (k);                                                    \
+        b0 = rnd(b0, rk_); b1 = rnd(b1, rk_);                                 \
+        b2 = rnd(b2, rk_); b3 = rnd(b3, rk_);                                 \
+    } while (0)
+
+#define XTS_VAES_RND(b, k)  (enc ? _mm512_aesenc_epi128(b, k) : \
+                                   _mm512_aesdec_epi128(b, k))
+#define XTS_VAES_LAST(b, k) (enc ? _mm512_aesenclast_epi128(b, k) : \
+                                   _mm512_aesdeclast_epi128(b, k))
+
+/* As AesXtsBlocksAesni() with four blocks per ZMM register, 16 a loop */
+static WC_INLINE WC_TARGET_VAES void AesXtsBlocksVaes(const byte* in, byte* out,
+                                                   word32 blocks, byte* tweak,
+                                                   const byte* key, int nr,
+                                                   int enc)
+{
+    const __m128i* KEY = (const __m128i*)key;
+    __m512i rk[15];
+    __m512i b0, b1, b2, b3, t0, t1, t2, t3;
+    __m128i t = _mm_loadu_si128((const __m128i*)tweak);
+    __m128i lanes[4];
+    int     r;
+
+    for (r = 0; r <= nr; r++)
+        rk[r] = _mm512_broadcast_i32x4(_mm_loadu_si128(&KEY[r]));
+
+    /* tweaks of the first four blocks */
+    lanes[0] = t;
+    for (r = 1; r < 4; r++)
+        lanes[r] = AesXtsMulX(lanes[r - 1]);
+    t0 = _mm512_loadu_si512((const void*)lanes);
+
+    for (; blocks >= 16; blocks -= 16) {
+        t1 = AesXtsMulXk(t0, 4);
+        t2 = AesXtsMulXk(t0, 8);
+        t3 = AesXtsMulXk(t0, 12);
+
+        b0 = _mm512_ternarylogic_epi64(_mm512_loadu_si512(in), t0, rk[0],
+                                       0x96);
+        b1 = _mm512_ternarylogic_epi64(_mm512_loadu_si512(in + 64), t1, rk[0],
+                                       0x96);
+        b2 = _mm512_ternarylogic_epi64(_mm512_loadu_si512(in + 128), t2,
+                                       rk[0], 0x96);
+        b3 = _mm512_ternarylogic_epi64(_mm512_loadu_si512(in + 192), t3,
+                                       rk[0], 0x96);
+        for (r = 1; r < nr; r++)
+            XTS_ROUND16(XTS_VAES_RND, rk[r]);
+        b0 = XTS_VAES_LAST(b0, _mm512_xor_si512(rk[nr], t0));
+        b1 = XTS_VAES_LAST(b1, _mm512_xor_si512(rk[nr], t1));
+        b2 = XTS_VAES_LAST(b2, _mm512_xor_si512(rk[nr], t2));
+        b3 = XTS_VAES_LAST(b3, _mm512_xor_si512(rk[nr], t3));
+        _mm512_storeu_si512(out, b0);
+        _mm512_storeu_si512(out + 64, b1);
+        _mm512_storeu_si512(out + 128, b2);
+        _mm512_storeu_si512(out + 192, b3);
+        t0 = AesXtsMulXk(t0, 16);
+        in  += AES_BLOCK_SIZE * 16;
+        out += AES_BLOCK_SIZE * 16;
+    }
+    while (blocks > 0) {
+        word32    n = (blocks < 4) ? blocks : 4;
+        __mmask64 m = (n == 4) ? ~(__mmask64)0 :
+                                 (((__mmask64)1 << (n * AES_BLOCK_SIZE)) - 1);
+
+        b0 = _mm512_ternarylogic_epi64(_mm512_maskz_loadu_epi8(m, in), t0,
+                                       rk[0], 0x96);
+        for (r = 1; r < nr; r++)
+            b0 = XTS_VAES_RND(b0, rk[r]);
+        b0 = XTS_VAES_LAST(b0, _mm512_xor_si512(rk[nr], t0));
+        _mm512_mask_storeu_epi8(out, m, b0);
+        if (n < 4) {
+            /* tweak after the last block is in lane n */
+            _mm512_storeu_si512((void*)lanes, t0);
+            t0 = _mm512_castsi128_si512(lanes[n]);
+        }
+        else {
+            t0 = AesXtsMulXk(t0, 4);
+        }
+        in  += AES_BLOCK_SIZE * n;
+        out += AES_BLOCK_SIZE * n;
+        blocks -= n;
+    }
+    _mm_storeu_si128((__m128i*)tweak, _mm512_castsi512_si128(t0));
+}
+#endif /* HAVE_INTEL_VAES */
+
+/* XTS encrypt whole blocks with AES-NI, see AesXtsBlocksAesni() */
+static void AesXtsEncryptAesni(const byte* in, byte* out, word32 blocks,
+                               byte* tweak, const byte* key, int nr)
+{
+#ifdef HAVE_INTEL_VAES
+    if (IS_AESXTS_VAES(intel_flags, blocks)) {
+        AesXtsBlocksVaes(in, out, blocks, tweak, key, nr, 1);
+        return;
+    }
+#endif
+    AesXtsBlocksAesni(in, out, blocks, tweak, key, nr, 1);
+}
+
+/* XTS decrypt whole blocks with AES-NI, see AesXtsBlocksAesni() */
+static void AesXtsDecryptAesni(const byte* in, byte* out, word32 blocks,
+                               byte* tweak, const byte* key, int nr)
+{
+#ifdef HAVE_INTEL_VAES
+    if (IS_AESXTS_VAES(intel_flags, blocks)) {
+        AesXtsBlocksVaes(in, out, blocks, tweak, key, nr, 0);
+        return;
+    }
+#endif
+    AesXtsBlocksAesni(in, out, blocks, tweak, key, nr, 0);
+}
+#endif /* WOLFSSL_AESNI */
+
 #ifdef HAVE_AES_ECB
 /* helper function for encrypting / decrypting full buffer at once */
 static int _AesXtsHelper(Aes* aes, byte* out, const byte* in, word32 sz, int dir)
@@ -9300,9 +10749,22 @@ int wc_AesXtsEncrypt(XtsAes* xaes, byte* out, const byte* in, word32 sz,
 
         wc_AesEncryptDirect(tweak, tmp, i);
 
+    #ifdef WOLFSSL_AESNI
+        if (haveAESNI && aes->use_aesni) {
+            SAVE_VECTOR_REGISTERS();
+            AesXtsEncryptAesni(in, out, blocks, tmp, (byte*)aes->key,
+                               aes->rounds);
+            RESTORE_VECTOR_REGISTERS();
+            in  += blocks * AES_BLOCK_SIZE;
+            out += blocks * AES_BLOCK_SIZE;
+            sz  -= blocks * AES_BLOCK_SIZE;
+            blocks = 0;
+        }
+    #endif
+
     #ifdef HAVE_AES_ECB
         /* encrypt all of buffer at once when possible */
-        if (in != out) { /* can not handle inline */
+        if (in != out && blocks > 0) { /* can not handle inline */
             XMEMCPY(out, tmp, AES_BLOCK_SIZE);
             if ((ret = _AesXtsHelper(aes, out, in, sz, AES_ENCRYPTION)) != 0) {
                 return ret;
@@ -9417,9 +10879,22 @@ int wc_AesXtsDecrypt(XtsAes* xaes, byte* out, const byte* in, word32 sz,
             blocks--;
         }
 
+    #ifdef WOLFSSL_AESNI
+        if (haveAESNI && aes->use_aesni) {
+            SAVE_VECTOR_REGISTERS();
+            AesXtsDecryptAesni(in, out, blocks, tmp, (byte*)aes->key,
+                               aes->rounds);
+            RESTORE_VECTOR_REGISTERS();
+            in  += blocks * AES_BLOCK_SIZE;
+            out += blocks * AES_BLOCK_SIZE;
+            sz  -= blocks * AES_BLOCK_SIZE;
+            blocks = 0;
+        }
+    #endif
+
     #ifdef HAVE_AES_ECB
         /* decrypt all of buffer at once when possible */
-        if (in != out) { /* can not handle inline */
+        if (in != out && blocks > 0) { /* can not handle inline */
             XMEMCPY(out, tmp, AES_BLOCK_SIZE);
             if ((ret = _AesXtsHelper(aes, out, in, sz, AES_DECRYPTION)) != 0) {
                 return ret;
@@ -6794,6 +6794,118 @@ int DecodeToKey(DecodedCert* cert, int verify)
     return ret;
 }
 
+#ifdef WOLFSSL_LAZY_CA_LOAD
+/* Get the subject name hash and subject key id hash of a certificate without
+ * decoding it. Only the TBS headers and the extension OIDs are walked, names
+ * and the key are skipped, nothing is allocated and dates aren't checked.
+ * The hashes are the same ParseCert stores in subjectHash and extSubjKeyId.
+ *
+ * source     DER encoded certificate.
+ * sz         Length of source.
+ * nameHash   Buffer of KEYID_SIZE bytes for the subject name hash.
+ * keyIdHash  Buffer of KEYID_SIZE bytes for the subject key id hash, unused
+ *            with NO_SKID.
+ * returns ASN_NO_SKID when there is no subject key id extension, the key id
+ *         is then a hash of the public key and needs a full parse.
+ *         ASN_PARSE_E on bad encoding, otherwise 0.
+ */
+int GetCertSignerHashes(const byte* source, word32 sz, byte* nameHash,
+                        byte* keyIdHash)
+{
+    word32 idx = 0;
+    word32 tbsEnd;
+    int    len;
+    int    version;
+    int    i;
+    byte   tag;
+#ifndef NO_SKID
+    word32 extEnd;
+    word32 next;
+    word32 oid;
+    word32 localIdx;
+    int    found = 0;
+#endif
+
+    if (source == NULL || nameHash == NULL || keyIdHash == NULL)
+        return BAD_FUNC_ARG;
+
+    if (GetSequence(source, &idx, &len, sz) < 0)
+        return ASN_PARSE_E;
+    sz = idx + len;
+    if (GetSequence(source, &idx, &len, sz) < 0)
+        return ASN_PARSE_E;
+    tbsEnd = idx + len;
+
+    if (GetExplicitVersion(source, &idx, &version, tbsEnd) < 0)
+        return ASN_PARSE_E;
+
+    /* skip serial number, signature algorithm, issuer and validity */
+    for (i = 0; i < 4; i++) {
+        if (GetHeader(source, &tag, &idx, &len, tbsEnd, 1) < 0)
+            return ASN_PARSE_E;
+        idx += len;
+    }
+
+    if (GetNameHash(source, &idx, nameHash, tbsEnd) < 0)
+        return ASN_PARSE_E;
+
+#ifdef NO_SKID
+    return 0;
+#else
+    /* skip public key and optional unique ids to get to the extensions */
+    while (idx < tbsEnd) {
+        if (GetHeader(source, &tag, &idx, &len, tbsEnd, 1) < 0)
+            return ASN_PARSE_E;
+        if (tag == ASN_EXTENSIONS) {
+            found = 1;
+            break;
+        }
+        idx += len;
+    }
+    if (!found)
+        return ASN_NO_SKID;
+
+    extEnd = idx + len;
+    if (GetSequence(source, &idx, &len, extEnd) < 0)
+        return ASN_PARSE_E;
+
+    while (idx < extEnd) {
+        if (GetSequence(source, &idx, &len, extEnd) < 0)
+            return ASN_PARSE_E;
+        next = idx + len;
+
+        oid = 0;
+        if (GetObjectId(source, &idx, &oid, oidCertExtType, next) < 0)
+            return ASN_PARSE_E;
+
+        if (oid == SUBJ_KEY_OID) {
+            /* skip critical flag */
+            localIdx = idx;
+            if (GetASNTag(source, &localIdx, &tag, next) == 0 &&
+                                                        tag == ASN_BOOLEAN) {
+                if (GetBoolean(source, &idx, next) < 0)
+                    return ASN_PARSE_E;
+            }
+
+            /* extension value wraps the key id, as in DecodeSubjKeyId */
+            if (GetOctetString(source, &idx, &len, next) < 0 ||
+                    GetOctetString(source, &idx, &len, next) < 0)
+                return ASN_PARSE_E;
+
+            if (len == KEYID_SIZE) {
+                XMEMCPY(keyIdHash, source + idx, KEYID_SIZE);
+                return 0;
+            }
+            return CalcHashId(source + idx, len, keyIdHash);
+        }
+        idx = next;
+    }
+
+    return ASN_NO_SKID;
+#endif /* NO_SKID */
+}
+#endif /* WOLFSSL_LAZY_CA_LOAD */
+
 #ifndef NO_CERTS
 static int GetSignature(DecodedCert* cert)
 {
@@ -10054,8 +10166,13 @@ Signer* MakeSigner(void* heap)
 /* Free an individual signer */
 void FreeSigner(Signer* signer, void* heap)
 {
-    XFREE(signer->name, heap, DYNAMIC_TYPE_SUBJECT_CN);
-    XFREE((void*)signer->publicKey, heap, DYNAMIC_TYPE_PUBLIC_KEY);
+#ifdef WOLFSSL_TRUST_STORE
+    if (!signer->trustStore)
+#endif
+    {
+        XFREE(signer->name, heap, DYNAMIC_TYPE_SUBJECT_CN);
+        XFREE((void*)signer->publicKey, heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    }
 #ifndef IGNORE_NAME_CONSTRAINTS
     if (signer->permittedNames)
         FreeNameSubtrees(signer->permittedNames, heap);
@@ -10064,6 +10181,9 @@ void FreeSigner(Signer* signer, void* heap)
 #endif
 #ifdef WOLFSSL_SIGNER_DER_CERT
     FreeDer(&signer->derCert);
+#endif
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    FreeDer(&signer->lazyDer);
 #endif
     XFREE(signer, heap, DYNAMIC_TYPE_SIGNER);
 
@@ -17971,6 +18091,7 @@ int CompareOcspReqResp(OcspRequest* req, OcspResponse* resp)
                 }
                 break;
             }
+            cmp = -1; /* same serial size, different certificate */
         }
         next = single->next;
         prev = single;
@@ -45,6 +45,14 @@
 #include <wolfssl/wolfcrypt/blake2-impl.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 
+/* SSE4.1 and AVX2 compression */
+#ifdef USE_INTEL_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+#endif
+#if defined(USE_INTEL_SPEEDUP) && defined(WC_HAVE_TARGET_ATTR)
+    #include <immintrin.h>
+    #define HAVE_INTEL_BLAKE2B
+#endif
 
 static const word64 blake2b_IV[8] =
 {
@@ -70,6 +78,219 @@ static const byte blake2b_sigma[12][16] =
   { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
 };
 
+#ifdef HAVE_INTEL_BLAKE2B
+/* Gather the message words of round r for the four G functions a to d. */
+#define B2B_MSG_AVX2(r, a, b, c, d)                                       \
+    _mm256_set_epi64x((long long)m[blake2b_sigma[r][d]],                  \
+                      (long long)m[blake2b_sigma[r][c]],                  \
+                      (long long)m[blake2b_sigma[r][b]],                  \
+                      (long long)m[blake2b_sigma[r][a]])
+
+#define B2B_ROTR32_AVX2(x)  _mm256_shuffle_epi32(x, _MM_SHUFFLE(2,3,0,1))
+#define B2B_ROTR24_AVX2(x)  _mm256_shuffle_epi8(x, r24)
+#define B2B_ROTR16_AVX2(x)  _mm256_shuffle_epi8(x, r16)
+#define B2B_ROTR63_AVX2(x)                                                \
+    _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x))
+
+/* Half of the G function on all four columns (or diagonals) at once. */
+#define B2B_G1_AVX2(b)                                                    \
+    row1 = _mm256_add_epi64(_mm256_add_epi64(row1, b), row2);             \
+    row4 = B2B_ROTR32_AVX2(_mm256_xor_si256(row4, row1));                 \
+    row3 = _mm256_add_epi64(row3, row4);                                  \
+    row2 = B2B_ROTR24_AVX2(_mm256_xor_si256(row2, row3))
+#define B2B_G2_AVX2(b)                                                    \
+    row1 = _mm256_add_epi64(_mm256_add_epi64(row1, b), row2);             \
+    row4 = B2B_ROTR16_AVX2(_mm256_xor_si256(row4, row1));                 \
+    row3 = _mm256_add_epi64(row3, row4);                                  \
+    row2 = B2B_ROTR63_AVX2(_mm256_xor_si256(row2, row3))
+
+/* Rotate rows 2 to 4 so that the diagonals line up as columns and back. */
+#define B2B_DIAG_AVX2()                                                   \
+    row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(0,3,2,1));          \
+    row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1,0,3,2));          \
+    row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(2,1,0,3))
+#define B2B_UNDIAG_AVX2()                                                 \
+    row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(2,1,0,3));          \
+    row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1,0,3,2));          \
+    row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(0,3,2,1))
+
+#define B2B_ROUND_AVX2(r)                                                 \
+    do {                                                                  \
+        B2B_G1_AVX2(B2B_MSG_AVX2(r,  0,  2,  4,  6));                     \
+        B2B_G2_AVX2(B2B_MSG_AVX2(r,  1,  3,  5,  7));                     \
+        B2B_DIAG_AVX2();                                                  \
+        B2B_G1_AVX2(B2B_MSG_AVX2(r,  8, 10, 12, 14));                     \
+        B2B_G2_AVX2(B2B_MSG_AVX2(r,  9, 11, 13, 15));                     \
+        B2B_UNDIAG_AVX2();                                                \
+    } while (0)
+
+/* Compress a block with a row of the working state in each YMM register. */
+static WC_TARGET_AVX2 void blake2b_compress_avx2( blake2b_state *S,
+                                                       const byte *block )
+{
+  const __m256i r16 = _mm256_setr_epi8(
+      2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+      2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+  const __m256i r24 = _mm256_setr_epi8(
+      3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+      3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+  word64 m[16];
+  __m256i row1, row2, row3, row4;
+  __m256i h0, h1;
+
+  XMEMCPY( m, block, sizeof( m ) );
+
+  row1 = h0 = _mm256_loadu_si256( (const __m256i*)&S->h[0] );
+  row2 = h1 = _mm256_loadu_si256( (const __m256i*)&S->h[4] );
+  row3 = _mm256_loadu_si256( (const __m256i*)&blake2b_IV[0] );
+  /* t[0], t[1], f[0] and f[1] are consecutive */
+  row4 = _mm256_xor_si256( _mm256_loadu_si256( (const __m256i*)&blake2b_IV[4] ),
+                           _mm256_loadu_si256( (const __m256i*)&S->t[0] ) );
+
+  B2B_ROUND_AVX2( 0 );
+  B2B_ROUND_AVX2( 1 );
+  B2B_ROUND_AVX2( 2 );
+  B2B_ROUND_AVX2( 3 );
+  B2B_ROUND_AVX2( 4 );
+  B2B_ROUND_AVX2( 5 );
+  B2B_ROUND_AVX2( 6 );
+  B2B_ROUND_AVX2( 7 );
+  B2B_ROUND_AVX2( 8 );
+  B2B_ROUND_AVX2( 9 );
+  B2B_ROUND_AVX2( 10 );
+  B2B_ROUND_AVX2( 11 );
+
+  _mm256_storeu_si256( (__m256i*)&S->h[0],
+      _mm256_xor_si256( h0, _mm256_xor_si256( row1, row3 ) ) );
+  _mm256_storeu_si256( (__m256i*)&S->h[4],
+      _mm256_xor_si256( h1, _mm256_xor_si256( row2, row4 ) ) );
+}
+
+#define B2B_MSG_SSE(r, a, b)                                              \
+    _mm_set_epi64x((long long)m[blake2b_sigma[r][b]],                     \
+                   (long long)m[blake2b_sigma[r][a]])
+
+#define B2B_ROTR32_SSE(x)   _mm_shuffle_epi32(x, _MM_SHUFFLE(2,3,0,1))
+#define B2B_ROTR24_SSE(x)   _mm_shuffle_epi8(x, r24)
+#define B2B_ROTR16_SSE(x)   _mm_shuffle_epi8(x, r16)
+#define B2B_ROTR63_SSE(x)                                                 \
+    _mm_xor_si128(_mm_srli_epi64(x, 63), _mm_add_epi64(x, x))
+
+/* Half of the G function with each row split into a low and high half. */
+#define B2B_G_SSE(bl, bh, ROTD, ROTB)                                     \
+    row1l = _mm_add_epi64(_mm_add_epi64(row1l, bl), row2l);               \
+    row1h = _mm_add_epi64(_mm_add_epi64(row1h, bh), row2h);               \
+    row4l = ROTD(_mm_xor_si128(row4l, row1l));                            \
+    row4h = ROTD(_mm_xor_si128(row4h, row1h));                            \
+    row3l = _mm_add_epi64(row3l, row4l);                                  \
+    row3h = _mm_add_epi64(row3h, row4h);                                  \
+    row2l = ROTB(_mm_xor_si128(row2l, row3l));                            \
+    row2h = ROTB(_mm_xor_si128(row2h, row3h))
+
+#define B2B_DIAG_SSE()                                                    \
+    t0 = _mm_alignr_epi8(row2h, row2l, 8);                                \
+    t1 = _mm_alignr_epi8(row2l, row2h, 8);                                \
+    row2l = t0; row2h = t1;                                               \
+    t0 = row3l; row3l = row3h; row3h = t0;                                \
+    t0 = _mm_alignr_epi8(row4h, row4l, 8);                                \
+    t1 = _mm_alignr_epi8(row4l, row4h, 8);                                \
+    row4l = t1; row4h = t0
+#define B2B_UNDIAG_SSE()                                                  \
+    t0 = _mm_alignr_epi8(row2l, row2h, 8);                                \
+    t1 = _mm_alignr_epi8(row2h, row2l, 8);                                \
+    row2l = t0; row2h = t1;                                               \
+    t0 = row3l; row3l = row3h; row3h = t0;                                \
+    t0 = _mm_alignr_epi8(row4l, row4h, 8);                                \
+    t1 = _mm_alignr_epi8(row4h, row4l, 8);                                \
+    row4l = t1; row4h = t0
+
+#define B2B_ROUND_SSE(r)                                                  \
+    do {                                                                  \
+        B2B_G_SSE(B2B_MSG_SSE(r,  0,  2), B2B_MSG_SSE(r,  4,  6),         \
+                  B2B_ROTR32_SSE, B2B_ROTR24_SSE);                        \
+        B2B_G_SSE(B2B_MSG_SSE(r,  1,  3), B2B_MSG_SSE(r,  5,  7),         \
+                  B2B_ROTR16_SSE, B2B_ROTR63_SSE);                        \
+        B2B_DIAG_SSE();                                                   \
+        B2B_G_SSE(B2B_MSG_SSE(r,  8, 10), B2B_MSG_SSE(r, 12, 14),         \
+                  B2B_ROTR32_SSE, B2B_ROTR24_SSE);                        \
+        B2B_G_SSE(B2B_MSG_SSE(r,  9, 11), B2B_MSG_SSE(r, 13, 15),         \
+                  B2B_ROTR16_SSE, B2B_ROTR63_SSE);                        \
+        B2B_UNDIAG_SSE();                                                 \
+    } while (0)
+
+/* Compress a block with a row of the working state in two XMM registers. */
+static WC_TARGET_SSE41 void blake2b_compress_sse41( blake2b_state *S,
+                                                         const byte *block )
+{
+  const __m128i r16 = _mm_setr_epi8(
+      2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+  const __m128i r24 = _mm_setr_epi8(
+      3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+  word64 m[16];
+  __m128i row1l, row1h, row2l, row2h, row3l, row3h, row4l, row4h;
+  __m128i t0, t1;
+
+  XMEMCPY( m, block, sizeof( m ) );
+
+  row1l = _mm_loadu_si128( (const __m128i*)&S->h[0] );
+  row1h = _mm_loadu_si128( (const __m128i*)&S->h[2] );
+  row2l = _mm_loadu_si128( (const __m128i*)&S->h[4] );
+  row2h = _mm_loadu_si128( (const __m128i*)&S->h[6] );
+  row3l = _mm_loadu_si128( (const __m128i*)&blake2b_IV[0] );
+  row3h = _mm_loadu_si128( (const __m128i*)&blake2b_IV[2] );
+  row4l = _mm_xor_si128( _mm_loadu_si128( (const __m128i*)&blake2b_IV[4] ),
+                         _mm_loadu_si128( (const __m128i*)&S->t[0] ) );
+  row4h = _mm_xor_si128( _mm_loadu_si128( (const __m128i*)&blake2b_IV[6] ),
+                         _mm_loadu_si128( (const __m128i*)&S->f[0] ) );
+
+  B2B_ROUND_SSE( 0 );
+  B2B_ROUND_SSE( 1 );
+  B2B_ROUND_SSE( 2 );
+  B2B_ROUND_SSE( 3 );
+  B2B_ROUND_SSE( 4 );
+  B2B_ROUND_SSE( 5 );
+  B2B_ROUND_SSE( 6 );
+  B2B_ROUND_SSE( 7 );
+  B2B_ROUND_SSE( 8 );
+  B2B_ROUND_SSE( 9 );
+  B2B_ROUND_SSE( 10 );
+  B2B_ROUND_SSE( 11 );
+
+  row1l = _mm_xor_si128( row3l, row1l );
+  row1h = _mm_xor_si128( row3h, row1h );
+  row2l = _mm_xor_si128( row4l, row2l );
+  row2h = _mm_xor_si128( row4h, row2h );
+  _mm_storeu_si128( (__m128i*)&S->h[0], _mm_xor_si128(
+      _mm_loadu_si128( (const __m128i*)&S->h[0] ), row1l ) );
+  _mm_storeu_si128( (__m128i*)&S->h[2], _mm_xor_si128(
+      _mm_loadu_si128( (const __m128i*)&S->h[2] ), row1h ) );
+  _mm_storeu_si128( (__m128i*)&S->h[4], _mm_xor_si128(
+      _mm_loadu_si128( (const __m128i*)&S->h[4] ), row2l ) );
+  _mm_storeu_si128( (__m128i*)&S->h[6], _mm_xor_si128(
+      _mm_loadu_si128( (const __m128i*)&S->h[6] ), row2h ) );
+}
+
+static void (*blake2b_compress_vec)( blake2b_state *S, const byte *block );
+static int compress_check = 0;
+static word32 intel_flags;
+
+/* Choose the compression function for the CPU - once. */
+static void blake2b_set_compress( void )
+{
+  if( compress_check )
+    return;
+
+  intel_flags = cpuid_get_flags();
+  if( IS_INTEL_AVX2( intel_flags ) )
+    blake2b_compress_vec = blake2b_compress_avx2;
+  else if( IS_INTEL_SSE41( intel_flags ) )
+    blake2b_compress_vec = blake2b_compress_sse41;
+
+  compress_check = 1;
+}
+#endif /* HAVE_INTEL_BLAKE2B */
+
+
 
 static WC_INLINE int blake2b_set_lastnode( blake2b_state *S )
 {
@@ -101,6 +322,10 @@ static WC_INLINE int blake2b_init0( blake2b_state *S )
 
   for( i = 0; i < 8; ++i ) S->h[i] = blake2b_IV[i];
 
+#ifdef HAVE_INTEL_BLAKE2B
+  blake2b_set_compress();
+#endif
+
   return 0;
 }
 
@@ -215,6 +440,16 @@ static WC_INLINE int blake2b_compress(
 {
   int i;
 
+#ifdef HAVE_INTEL_BLAKE2B
+  if( blake2b_compress_vec != NULL )
+  {
+    SAVE_VECTOR_REGISTERS();
+    blake2b_compress_vec( S, block );
+    RESTORE_VECTOR_REGISTERS();
+    return 0;
+  }
+#endif
+
   for( i = 0; i < 16; ++i )
     m[i] = load64( block + i * sizeof( m[i] ) );
 
@@ -416,6 +651,366 @@ int blake2b( byte *out, const void *in, const void *key, const byte outlen,
   return blake2b_final( S, out, outlen );
 }
 
+/* BLAKE2bp: four leaves hash interleaved blocks and a root hashes the leaf
+ * outputs. */
+#define BLAKE2BP_LEAVES 4
+
+#ifdef HAVE_INTEL_BLAKE2B
+#define B2BP_ROTR32_AVX2(x) _mm256_shuffle_epi32(x, _MM_SHUFFLE(2,3,0,1))
+#define B2BP_ROTR24_AVX2(x) _mm256_shuffle_epi8(x, r24)
+#define B2BP_ROTR16_AVX2(x) _mm256_shuffle_epi8(x, r16)
+#define B2BP_ROTR63_AVX2(x)                                               \
+    _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x))
+
+#define B2BP_G_AVX2(r,i,a,b,c,d)                                          \
+  do {                                                                    \
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_sigma[r][2*i+0]]); \
+    d = B2BP_ROTR32_AVX2(_mm256_xor_si256(d, a));                         \
+    c = _mm256_add_epi64(c, d);                                           \
+    b = B2BP_ROTR24_AVX2(_mm256_xor_si256(b, c));                         \
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_sigma[r][2*i+1]]); \
+    d = B2BP_ROTR16_AVX2(_mm256_xor_si256(d, a));                         \
+    c = _mm256_add_epi64(c, d);                                           \
+    b = B2BP_ROTR63_AVX2(_mm256_xor_si256(b, c));                         \
+  } while(0)
+#define B2BP_ROUND_AVX2(r)                                                \
+  do {                                                                    \
+    B2BP_G_AVX2(r,0,v[ 0],v[ 4],v[ 8],v[12]);                             \
+    B2BP_G_AVX2(r,1,v[ 1],v[ 5],v[ 9],v[13]);                             \
+    B2BP_G_AVX2(r,2,v[ 2],v[ 6],v[10],v[14]);                             \
+    B2BP_G_AVX2(r,3,v[ 3],v[ 7],v[11],v[15]);                             \
+    B2BP_G_AVX2(r,4,v[ 0],v[ 5],v[10],v[15]);                             \
+    B2BP_G_AVX2(r,5,v[ 1],v[ 6],v[11],v[12]);                             \
+    B2BP_G_AVX2(r,6,v[ 2],v[ 7],v[ 8],v[13]);                             \
+    B2BP_G_AVX2(r,7,v[ 3],v[ 4],v[ 9],v[14]);                             \
+  } while(0)
+
+/* Compress one block into each of the four leaves with a leaf in each 64-bit
+ * lane. The leaves are in step so the counter of leaf 0 applies to all. */
+static WC_TARGET_AVX2 void blake2bp_compress4_avx2( blake2bp_state *S,
+                                                         const byte *blocks )
+{
+  const __m256i r16 = _mm256_setr_epi8(
+      2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+      2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+  const __m256i r24 = _mm256_setr_epi8(
+      3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+      3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+  __m256i m[16];
+  __m256i v[16];
+  word64 h[4];
+  int i;
+
+  /* Transpose so that m[i] holds word i of every leaf's block. */
+  for( i = 0; i < 16; i += 4 )
+  {
+    __m256i a0 = _mm256_loadu_si256( (const __m256i*)
+        ( blocks + 0 * BLAKE2B_BLOCKBYTES + i * 8 ) );
+    __m256i a1 = _mm256_loadu_si256( (const __m256i*)
+        ( blocks + 1 * BLAKE2B_BLOCKBYTES + i * 8 ) );
+    __m256i a2 = _mm256_loadu_si256( (const __m256i*)
+        ( blocks + 2 * BLAKE2B_BLOCKBYTES + i * 8 ) );
+    __m256i a3 = _mm256_loadu_si256( (const __m256i*)
+        ( blocks + 3 * BLAKE2B_BLOCKBYTES + i * 8 ) );
+    __m256i t0 = _mm256_unpacklo_epi64( a0, a1 );
+    __m256i t1 = _mm256_unpackhi_epi64( a0, a1 );
+    __m256i t2 = _mm256_unpacklo_epi64( a2, a3 );
+    __m256i t3 = _mm256_unpackhi_epi64( a2, a3 );
+    m[i + 0] = _mm256_permute2x128_si256( t0, t2, 0x20 );
+    m[i + 1] = _mm256_permute2x128_si256( t1, t3, 0x20 );
+    m[i + 2] = _mm256_permute2x128_si256( t0, t2, 0x31 );
+    m[i + 3] = _mm256_permute2x128_si256( t1, t3, 0x31 );
+  }
+
+  for( i = 0; i < 8; ++i )
+  {
+    v[i] = _mm256_set_epi64x( (long long)S->S[3]->h[i],
+                              (long long)S->S[2]->h[i],
+                              (long long)S->S[1]->h[i],
+                              (long long)S->S[0]->h[i] );
+  }
+  v[ 8] = _mm256_set1_epi64x( (long long)blake2b_IV[0] );
+  v[ 9] = _mm256_set1_epi64x( (long long)blake2b_IV[1] );
+  v[10] = _mm256_set1_epi64x( (long long)blake2b_IV[2] );
+  v[11] = _mm256_set1_epi64x( (long long)blake2b_IV[3] );
+  v[12] = _mm256_set1_epi64x( (long long)(S->S[0]->t[0] ^ blake2b_IV[4]) );
+  v[13] = _mm256_set1_epi64x( (long long)(S->S[0]->t[1] ^ blake2b_IV[5]) );
+  v[14] = _mm256_set1_epi64x( (long long)blake2b_IV[6] );
+  v[15] = _mm256_set1_epi64x( (long long)blake2b_IV[7] );
+
+  B2BP_ROUND_AVX2( 0 );
+  B2BP_ROUND_AVX2( 1 );
+  B2BP_ROUND_AVX2( 2 );
+  B2BP_ROUND_AVX2( 3 );
+  B2BP_ROUND_AVX2( 4 );
+  B2BP_ROUND_AVX2( 5 );
+  B2BP_ROUND_AVX2( 6 );
+  B2BP_ROUND_AVX2( 7 );
+  B2BP_ROUND_AVX2( 8 );
+  B2BP_ROUND_AVX2( 9 );
+  B2BP_ROUND_AVX2( 10 );
+  B2BP_ROUND_AVX2( 11 );
+
+  for( i = 0; i < 8; ++i )
+  {
+    _mm256_storeu_si256( (__m256i*)h,
+                         _mm256_xor_si256( v[i], v[i + 8] ) );
+    S->S[0]->h[i] ^= h[0];
+    S->S[1]->h[i] ^= h[1];
+    S->S[2]->h[i] ^= h[2];
+    S->S[3]->h[i] ^= h[3];
+  }
+}
+#endif /* HAVE_INTEL_BLAKE2B */
+
+/* Compress the next block of every leaf. blocks holds them back to back. */
+static int blake2bp_compress( blake2bp_state *S, const byte *blocks )
+{
+  int ret = 0;
+  int i;
+#ifdef WOLFSSL_SMALL_STACK
+  word64* m;
+  word64* v;
+
+  m = (word64*)XMALLOC(sizeof(word64) * 32, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+  if ( m == NULL ) return MEMORY_E;
+
+  v = &m[16];
+#else
+  word64 m[16];
+  word64 v[16];
+#endif
+
+  /* Keyed leaves still hold their key block. */
+  for( i = 0; i < BLAKE2BP_LEAVES; ++i )
+  {
+    if( S->S[i]->buflen == BLAKE2B_BLOCKBYTES )
+    {
+      blake2b_increment_counter( S->S[i], BLAKE2B_BLOCKBYTES );
+      ret = blake2b_compress( S->S[i], S->S[i]->buf, m, v );
+      if (ret < 0) goto out;
+      S->S[i]->buflen = 0;
+    }
+  }
+
+  for( i = 0; i < BLAKE2BP_LEAVES; ++i )
+    blake2b_increment_counter( S->S[i], BLAKE2B_BLOCKBYTES );
+
+#ifdef HAVE_INTEL_BLAKE2B
+  if( IS_INTEL_AVX2( intel_flags ) )
+  {
+    SAVE_VECTOR_REGISTERS();
+    blake2bp_compress4_avx2( S, blocks );
+    RESTORE_VECTOR_REGISTERS();
+    goto out;
+  }
+#endif
+
+  for( i = 0; i < BLAKE2BP_LEAVES; ++i )
+  {
+    ret = blake2b_compress( S->S[i], blocks + i * BLAKE2B_BLOCKBYTES, m, v );
+    if (ret < 0) break;
+  }
+
+ out:
+
+#ifdef WOLFSSL_SMALL_STACK
+  XFREE(m, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+  return ret;
+}
+
+static int blake2bp_init_leaf( blake2b_state *S, byte outlen, byte keylen,
+                               word64 offset )
+{
+  blake2b_param P[1];
+
+  XMEMSET( P, 0, sizeof( *P ) );
+  P->digest_length = outlen;
+  P->key_length    = keylen;
+  P->fanout        = BLAKE2BP_LEAVES;
+  P->depth         = 2;
+  store64( &P->node_offset, offset );
+  P->inner_length  = BLAKE2B_OUTBYTES;
+  return blake2b_init_param( S, P );
+}
+
+static int blake2bp_init_root( blake2b_state *S, byte outlen, byte keylen )
+{
+  blake2b_param P[1];
+
+  XMEMSET( P, 0, sizeof( *P ) );
+  P->digest_length = outlen;
+  P->key_length    = keylen;
+  P->fanout        = BLAKE2BP_LEAVES;
+  P->depth         = 2;
+  P->node_depth    = 1;
+  P->inner_length  = BLAKE2B_OUTBYTES;
+  return blake2b_init_param( S, P );
+}
+
+static int blake2bp_init_nodes( blake2bp_state *S, byte outlen, byte keylen )
+{
+  int ret;
+  int i;
+
+  XMEMSET( S->buf, 0, sizeof( S->buf ) );
+  S->buflen = 0;
+
+  ret = blake2bp_init_root( S->R, outlen, keylen );
+  for( i = 0; ret == 0 && i < BLAKE2BP_LEAVES; ++i )
+    ret = blake2bp_init_leaf( S->S[i], outlen, keylen, (word64)i );
+
+  S->R->last_node = 1;
+  S->S[BLAKE2BP_LEAVES - 1]->last_node = 1;
+
+  return ret;
+}
+
+int blake2bp_init( blake2bp_state *S, const byte outlen )
+{
+  if ( ( !outlen ) || ( outlen > BLAKE2B_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  return blake2bp_init_nodes( S, outlen, 0 );
+}
+
+int blake2bp_init_key( blake2bp_state *S, const byte outlen, const void *key,
+                       const byte keylen )
+{
+  int ret;
+  int i;
+
+  if ( ( !outlen ) || ( outlen > BLAKE2B_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  if ( !key || !keylen || keylen > BLAKE2B_KEYBYTES ) return BAD_FUNC_ARG;
+
+  ret = blake2bp_init_nodes( S, outlen, keylen );
+  if ( ret < 0 ) return ret;
+
+  {
+#ifdef WOLFSSL_SMALL_STACK
+    byte* block;
+
+    block = (byte*)XMALLOC(BLAKE2B_BLOCKBYTES, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    if ( block == NULL ) return MEMORY_E;
+#else
+    byte block[BLAKE2B_BLOCKBYTES];
+#endif
+
+    XMEMSET( block, 0, BLAKE2B_BLOCKBYTES );
+    XMEMCPY( block, key, keylen );
+    for( i = 0; ret == 0 && i < BLAKE2BP_LEAVES; ++i )
+      ret = blake2b_update( S->S[i], block, BLAKE2B_BLOCKBYTES );
+    secure_zero_memory( block, BLAKE2B_BLOCKBYTES ); /* Burn the key from */
+                                                     /* memory */
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(block, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+  }
+  return ret;
+}
+
+/* A round of blocks is only compressed once more than a round less one block
+ * follows it, so every leaf's last block is still buffered for final. */
+int blake2bp_update( blake2bp_state *S, const byte *in, word64 inlen )
+{
+  const word64 round = BLAKE2BP_LEAVES * BLAKE2B_BLOCKBYTES;
+  int ret = 0;
+
+  while( S->buflen + inlen > 2 * round - BLAKE2B_BLOCKBYTES )
+  {
+    if( S->buflen == 0 )
+    {
+      ret = blake2bp_compress( S, in );
+      in += round;
+      inlen -= round;
+    }
+    else if( S->buflen >= round )
+    {
+      ret = blake2bp_compress( S, S->buf );
+      S->buflen -= round;
+      XMEMMOVE( S->buf, S->buf + round, (wolfssl_word)S->buflen );
+    }
+    else
+    {
+      word64 fill = round - S->buflen;
+
+      XMEMCPY( S->buf + S->buflen, in, (wolfssl_word)fill );
+      ret = blake2bp_compress( S, S->buf );
+      S->buflen = 0;
+      in += fill;
+      inlen -= fill;
+    }
+    if (ret < 0) return ret;
+  }
+
+  XMEMCPY( S->buf + S->buflen, in, (wolfssl_word)inlen );
+  S->buflen += inlen;
+
+  return 0;
+}
+
+int blake2bp_final( blake2bp_state *S, byte *out, byte outlen )
+{
+  byte hash[BLAKE2BP_LEAVES][BLAKE2B_OUTBYTES];
+  int ret = 0;
+  int i;
+
+  for( i = 0; ret == 0 && i < BLAKE2BP_LEAVES; ++i )
+  {
+    word64 off;
+
+    for( off = (word64)i * BLAKE2B_BLOCKBYTES; ret == 0 && off < S->buflen;
+         off += BLAKE2BP_LEAVES * BLAKE2B_BLOCKBYTES )
+    {
+      word64 left = S->buflen - off;
+
+      if( left > BLAKE2B_BLOCKBYTES ) left = BLAKE2B_BLOCKBYTES;
+      ret = blake2b_update( S->S[i], S->buf + off, left );
+    }
+    if ( ret == 0 )
+      ret = blake2b_final( S->S[i], hash[i], BLAKE2B_OUTBYTES );
+  }
+
+  for( i = 0; ret == 0 && i < BLAKE2BP_LEAVES; ++i )
+    ret = blake2b_update( S->R, hash[i], BLAKE2B_OUTBYTES );
+  if ( ret == 0 )
+    ret = blake2b_final( S->R, out, outlen );
+
+  secure_zero_memory( hash, sizeof( hash ) );
+
+  return ret;
+}
+
+int blake2bp( byte *out, const void *in, const void *key, const byte outlen,
+              const word64 inlen, byte keylen )
+{
+  blake2bp_state S[1];
+  int ret;
+
+  /* Verify parameters */
+  if ( NULL == in ) return BAD_FUNC_ARG;
+
+  if ( NULL == out ) return BAD_FUNC_ARG;
+
+  if( NULL == key ) keylen = 0;
+
+  if( keylen > 0 )
+    ret = blake2bp_init_key( S, outlen, key, keylen );
+  else
+    ret = blake2bp_init( S, outlen );
+  if (ret < 0) return ret;
+
+  ret = blake2bp_update( S, ( const byte * )in, inlen );
+  if (ret < 0) return ret;
+
+  return blake2bp_final( S, out, outlen );
+}
+
 #if defined(BLAKE2B_SELFTEST)
 #include <string.h>
 #include "blake2-kat.h"
@@ -498,6 +1093,52 @@ int wc_Blake2bFinal(Blake2b* b2b, byte* final, word32 requestSz)
 }
 
 
+/* Init Blake2bp digest, track size in case final doesn't want to "remember" */
+int wc_InitBlake2bp(Blake2bp* b2bp, word32 digestSz)
+{
+    if (b2bp == NULL){
+        return BAD_FUNC_ARG;
+    }
+    b2bp->digestSz = digestSz;
+
+    return blake2bp_init(b2bp->S, (byte)digestSz);
+}
+
+/* Init Blake2bp digest with key, track size in case final doesn't want to
+ * "remember" */
+int wc_InitBlake2bp_WithKey(Blake2bp* b2bp, word32 digestSz, const byte *key,
+                            word32 keylen)
+{
+    if (b2bp == NULL){
+        return BAD_FUNC_ARG;
+    }
+    b2bp->digestSz = digestSz;
+
+    if (keylen >= 256)
+        return BAD_FUNC_ARG;
+
+    if (key)
+        return blake2bp_init_key(b2bp->S, (byte)digestSz, key, (byte)keylen);
+    else
+        return blake2bp_init(b2bp->S, (byte)digestSz);
+}
+
+/* Blake2bp Update */
+int wc_Blake2bpUpdate(Blake2bp* b2bp, const byte* data, word32 sz)
+{
+    return blake2bp_update(b2bp->S, data, sz);
+}
+
+
+/* Blake2bp Final, if pass in zero size we use init digestSz */
+int wc_Blake2bpFinal(Blake2bp* b2bp, byte* final, word32 requestSz)
+{
+    word32 sz = requestSz ? requestSz : b2bp->digestSz;
+
+    return blake2bp_final(b2bp->S, final, (byte)sz);
+}
+
+
 /* end CTaoCrypt API */
 
 #endif  /* HAVE_BLAKE2 */
@@ -45,6 +45,14 @@
 #include <wolfssl/wolfcrypt/blake2-impl.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 
+/* SSE4.1 and AVX2 compression */
+#ifdef USE_INTEL_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+#endif
+#if defined(USE_INTEL_SPEEDUP) && defined(WC_HAVE_TARGET_ATTR)
+    #include <immintrin.h>
+    #define HAVE_INTEL_BLAKE2S
+#endif
 
 static const word32 blake2s_IV[8] =
 {
@@ -67,6 +75,102 @@ static const byte blake2s_sigma[10][16] =
 };
 
 
+#ifdef HAVE_INTEL_BLAKE2S
+#define B2S_MSG_SSE(r, a, b, c, d)                                        \
+    _mm_set_epi32((int)m[blake2s_sigma[r][d]], (int)m[blake2s_sigma[r][c]], \
+                  (int)m[blake2s_sigma[r][b]], (int)m[blake2s_sigma[r][a]])
+
+#define B2S_ROTR16_SSE(x)   _mm_shuffle_epi8(x, r16)
+#define B2S_ROTR8_SSE(x)    _mm_shuffle_epi8(x, r8)
+#define B2S_ROTR12_SSE(x)                                                 \
+    _mm_or_si128(_mm_srli_epi32(x, 12), _mm_slli_epi32(x, 20))
+#define B2S_ROTR7_SSE(x)                                                  \
+    _mm_or_si128(_mm_srli_epi32(x, 7), _mm_slli_epi32(x, 25))
+
+/* Half of the G function on all four columns (or diagonals) at once. */
+#define B2S_G_SSE(b, ROTD, ROTB)                                          \
+    row1 = _mm_add_epi32(_mm_add_epi32(row1, b), row2);                   \
+    row4 = ROTD(_mm_xor_si128(row4, row1));                               \
+    row3 = _mm_add_epi32(row3, row4);                                     \
+    row2 = ROTB(_mm_xor_si128(row2, row3))
+
+/* Rotate rows 2 to 4 so that the diagonals line up as columns and back. */
+#define B2S_DIAG_SSE()                                                    \
+    row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(0,3,2,1));                 \
+    row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(1,0,3,2));                 \
+    row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(2,1,0,3))
+#define B2S_UNDIAG_SSE()                                                  \
+    row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(2,1,0,3));                 \
+    row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(1,0,3,2));                 \
+    row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(0,3,2,1))
+
+#define B2S_ROUND_SSE(r)                                                  \
+    do {                                                                  \
+        B2S_G_SSE(B2S_MSG_SSE(r,  0,  2,  4,  6),                         \
+                  B2S_ROTR16_SSE, B2S_ROTR12_SSE);                        \
+        B2S_G_SSE(B2S_MSG_SSE(r,  1,  3,  5,  7),                         \
+                  B2S_ROTR8_SSE, B2S_ROTR7_SSE);                          \
+        B2S_DIAG_SSE();                                                   \
+        B2S_G_SSE(B2S_MSG_SSE(r,  8, 10, 12, 14),                         \
+                  B2S_ROTR16_SSE, B2S_ROTR12_SSE);                        \
+        B2S_G_SSE(B2S_MSG_SSE(r,  9, 11, 13, 15),                         \
+                  B2S_ROTR8_SSE, B2S_ROTR7_SSE);                          \
+        B2S_UNDIAG_SSE();                                                 \
+    } while (0)
+
+/* Compress a block with a row of the working state in each XMM register. */
+static WC_TARGET_SSE41 void blake2s_compress_sse41( blake2s_state *S,
+                                                         const byte *block )
+{
+  const __m128i r16 = _mm_setr_epi8(
+      2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+  const __m128i r8 = _mm_setr_epi8(
+      1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+  word32 m[16];
+  __m128i row1, row2, row3, row4;
+  __m128i h0, h1;
+
+  XMEMCPY( m, block, sizeof( m ) );
+
+  row1 = h0 = _mm_loadu_si128( (const __m128i*)&S->h[0] );
+  row2 = h1 = _mm_loadu_si128( (const __m128i*)&S->h[4] );
+  row3 = _mm_loadu_si128( (const __m128i*)&blake2s_IV[0] );
+  /* t[0], t[1], f[0] and f[1] are consecutive */
+  row4 = _mm_xor_si128( _mm_loadu_si128( (const __m128i*)&blake2s_IV[4] ),
+                        _mm_loadu_si128( (const __m128i*)&S->t[0] ) );
+
+  B2S_ROUND_SSE( 0 );
+  B2S_ROUND_SSE( 1 );
+  B2S_ROUND_SSE( 2 );
+  B2S_ROUND_SSE( 3 );
+  B2S_ROUND_SSE( 4 );
+  B2S_ROUND_SSE( 5 );
+  B2S_ROUND_SSE( 6 );
+  B2S_ROUND_SSE( 7 );
+  B2S_ROUND_SSE( 8 );
+  B2S_ROUND_SSE( 9 );
+
+  _mm_storeu_si128( (__m128i*)&S->h[0],
+      _mm_xor_si128( h0, _mm_xor_si128( row1, row3 ) ) );
+  _mm_storeu_si128( (__m128i*)&S->h[4],
+      _mm_xor_si128( h1, _mm_xor_si128( row2, row4 ) ) );
+}
+
+static int compress_check = 0;
+static word32 intel_flags;
+
+/* Read the CPU features - once. */
+static void blake2s_set_compress( void )
+{
+  if( compress_check )
+    return;
+
+  intel_flags = cpuid_get_flags();
+  compress_check = 1;
+}
+#endif /* HAVE_INTEL_BLAKE2S */
+
+
 static WC_INLINE int blake2s_set_lastnode( blake2s_state *S )
 {
   S->f[1] = ~0;
@@ -97,6 +201,10 @@ static WC_INLINE int blake2s_init0( blake2s_state *S )
 
   for( i = 0; i < 8; ++i ) S->h[i] = blake2s_IV[i];
 
+#ifdef HAVE_INTEL_BLAKE2S
+  blake2s_set_compress();
+#endif
+
   return 0;
 }
 
@@ -212,6 +320,16 @@ static WC_INLINE int blake2s_compress(
 {
   int i;
 
+#ifdef HAVE_INTEL_BLAKE2S
+  if( IS_INTEL_SSE41( intel_flags ) )
+  {
+    SAVE_VECTOR_REGISTERS();
+    blake2s_compress_sse41( S, block );
+    RESTORE_VECTOR_REGISTERS();
+    return 0;
+  }
+#endif
+
   for( i = 0; i < 16; ++i )
     m[i] = load32( block + i * sizeof( m[i] ) );
 
@@ -411,6 +529,371 @@ int blake2s( byte *out, const void *in, const void *key, const byte outlen,
   return blake2s_final( S, out, outlen );
 }
 
+/* BLAKE2sp: eight leaves hash interleaved blocks and a root hashes the leaf
+ * outputs. */
+#define BLAKE2SP_LEAVES 8
+
+#ifdef HAVE_INTEL_BLAKE2S
+#define B2SP_ROTR16_AVX2(x) _mm256_shuffle_epi8(x, r16)
+#define B2SP_ROTR8_AVX2(x)  _mm256_shuffle_epi8(x, r8)
+#define B2SP_ROTR12_AVX2(x)                                               \
+    _mm256_or_si256(_mm256_srli_epi32(x, 12), _mm256_slli_epi32(x, 20))
+#define B2SP_ROTR7_AVX2(x)                                                \
+    _mm256_or_si256(_mm256_srli_epi32(x, 7), _mm256_slli_epi32(x, 25))
+
+#define B2SP_G_AVX2(r,i,a,b,c,d)                                          \
+  do {                                                                    \
+    a = _mm256_add_epi32(_mm256_add_epi32(a, b), m[blake2s_sigma[r][2*i+0]]); \
+    d = B2SP_ROTR16_AVX2(_mm256_xor_si256(d, a));                         \
+    c = _mm256_add_epi32(c, d);                                           \
+    b = B2SP_ROTR12_AVX2(_mm256_xor_si256(b, c));                         \
+    a = _mm256_add_epi32(_mm256_add_epi32(a, b), m[blake2s_sigma[r][2*i+1]]); \
+    d = B2SP_ROTR8_AVX2(_mm256_xor_si256(d, a));                          \
+    c = _mm256_add_epi32(c, d);                                           \
+    b = B2SP_ROTR7_AVX2(_mm256_xor_si256(b, c));                          \
+  } while(0)
+#define B2SP_ROUND_AVX2(r)                                                \
+  do {                                                                    \
+    B2SP_G_AVX2(r,0,v[ 0],v[ 4],v[ 8],v[12]);                             \
+    B2SP_G_AVX2(r,1,v[ 1],v[ 5],v[ 9],v[13]);                             \
+    B2SP_G_AVX2(r,2,v[ 2],v[ 6],v[10],v[14]);                             \
+    B2SP_G_AVX2(r,3,v[ 3],v[ 7],v[11],v[15]);                             \
+    B2SP_G_AVX2(r,4,v[ 0],v[ 5],v[10],v[15]);                             \
+    B2SP_G_AVX2(r,5,v[ 1],v[ 6],v[11],v[12]);                             \
+    B2SP_G_AVX2(r,6,v[ 2],v[ 7],v[ 8],v[13]);                             \
+    B2SP_G_AVX2(r,7,v[ 3],v[ 4],v[ 9],v[14]);                             \
+  } while(0)
+
+/* Compress one block into each of the eight leaves with a leaf in each 32-bit
+ * lane. The leaves are in step so the counter of leaf 0 applies to all. */
+static WC_TARGET_AVX2 void blake2sp_compress8_avx2( blake2sp_state *S,
+                                                         const byte *blocks )
+{
+  const __m256i r16 = _mm256_setr_epi8(
+      2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+      2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+  const __m256i r8 = _mm256_setr_epi8(
+      1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+      1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+  __m256i m[16];
+  __m256i v[16];
+  word32 h[8];
+  int i, j;
+
+  /* Transpose so that m[i] holds word i of every leaf's block. */
+  for( i = 0; i < 16; i += 8 )
+  {
+    __m256i a[8];
+    __m256i t[8];
+    __m256i u[8];
+
+    for( j = 0; j < 8; ++j )
+      a[j] = _mm256_loadu_si256( (const __m256i*)
+          ( blocks + j * BLAKE2S_BLOCKBYTES + i * 4 ) );
+    for( j = 0; j < 8; j += 2 )
+    {
+      t[j + 0] = _mm256_unpacklo_epi32( a[j], a[j + 1] );
+      t[j + 1] = _mm256_unpackhi_epi32( a[j], a[j + 1] );
+    }
+    for( j = 0; j < 8; j += 4 )
+    {
+      u[j + 0] = _mm256_unpacklo_epi64( t[j + 0], t[j + 2] );
+      u[j + 1] = _mm256_unpackhi_epi64( t[j + 0], t[j + 2] );
+      u[j + 2] = _mm256_unpacklo_epi64( t[j + 1], t[j + 3] );
+      u[j + 3] = _mm256_unpackhi_epi64( t[j + 1], t[j + 3] );
+    }
+    for( j = 0; j < 4; ++j )
+    {
+      m[i + j + 0] = _mm256_permute2x128_si256( u[j], u[j + 4], 0x20 );
+      m[i + j + 4] = _mm256_permute2x128_si256( u[j], u[j + 4], 0x31 );
+    }
+  }
+
+  for( i = 0; i < 8; ++i )
+  {
+    v[i] = _mm256_set_epi32( (int)S->S[7]->h[i], (int)S->S[6]->h[i],
+                             (int)S->S[5]->h[i], (int)S->S[4]->h[i],
+                             (int)S->S[3]->h[i], (int)S->S[2]->h[i],
+                             (int)S->S[1]->h[i], (int)S->S[0]->h[i] );
+  }
+  v[ 8] = _mm256_set1_epi32( (int)blake2s_IV[0] );
+  v[ 9] = _mm256_set1_epi32( (int)blake2s_IV[1] );
+  v[10] = _mm256_set1_epi32( (int)blake2s_IV[2] );
+  v[11] = _mm256_set1_epi32( (int)blake2s_IV[3] );
+  v[12] = _mm256_set1_epi32( (int)(S->S[0]->t[0] ^ blake2s_IV[4]) );
+  v[13] = _mm256_set1_epi32( (int)(S->S[0]->t[1] ^ blake2s_IV[5]) );
+  v[14] = _mm256_set1_epi32( (int)blake2s_IV[6] );
+  v[15] = _mm256_set1_epi32( (int)blake2s_IV[7] );
+
+  B2SP_ROUND_AVX2( 0 );
+  B2SP_ROUND_AVX2( 1 );
+  B2SP_ROUND_AVX2( 2 );
+  B2SP_ROUND_AVX2( 3 );
+  B2SP_ROUND_AVX2( 4 );
+  B2SP_ROUND_AVX2( 5 );
+  B2SP_ROUND_AVX2( 6 );
+  B2SP_ROUND_AVX2( 7 );
+  B2SP_ROUND_AVX2( 8 );
+  B2SP_ROUND_AVX2( 9 );
+
+  for( i = 0; i < 8; ++i )
+  {
+    _mm256_storeu_si256( (__m256i*)h,
+                         _mm256_xor_si256( v[i], v[i + 8] ) );
+    for( j = 0; j < BLAKE2SP_LEAVES; ++j )
+      S->S[j]->h[i] ^= h[j];
+  }
+}
+#endif /* HAVE_INTEL_BLAKE2S */
+
+/* Compress the next block of every leaf. blocks holds them back to back. */
+static int blake2sp_compress( blake2sp_state *S, const byte *blocks )
+{
+  int ret = 0;
+  int i;
+#ifdef WOLFSSL_SMALL_STACK
+  word32* m;
+  word32* v;
+
+  m = (word32*)XMALLOC(sizeof(word32) * 32, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+  if ( m == NULL ) return MEMORY_E;
+
+  v = &m[16];
+#else
+  word32 m[16];
+  word32 v[16];
+#endif
+
+  /* Keyed leaves still hold their key block. */
+  for( i = 0; i < BLAKE2SP_LEAVES; ++i )
+  {
+    if( S->S[i]->buflen == BLAKE2S_BLOCKBYTES )
+    {
+      blake2s_increment_counter( S->S[i], BLAKE2S_BLOCKBYTES );
+      ret = blake2s_compress( S->S[i], S->S[i]->buf, m, v );
+      if (ret < 0) goto out;
+      S->S[i]->buflen = 0;
+    }
+  }
+
+  for( i = 0; i < BLAKE2SP_LEAVES; ++i )
+    blake2s_increment_counter( S->S[i], BLAKE2S_BLOCKBYTES );
+
+#ifdef HAVE_INTEL_BLAKE2S
+  if( IS_INTEL_AVX2( intel_flags ) )
+  {
+    SAVE_VECTOR_REGISTERS();
+    blake2sp_compress8_avx2( S, blocks );
+    RESTORE_VECTOR_REGISTERS();
+    goto out;
+  }
+#endif
+
+  for( i = 0; i < BLAKE2SP_LEAVES; ++i )
+  {
+    ret = blake2s_compress( S->S[i], blocks + i * BLAKE2S_BLOCKBYTES, m, v );
+    if (ret < 0) break;
+  }
+
+ out:
+
+#ifdef WOLFSSL_SMALL_STACK
+  XFREE(m, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+  return ret;
+}
+
+static int blake2sp_init_leaf( blake2s_state *S, byte outlen, byte keylen,
+                               word32 offset )
+{
+  blake2s_param P[1];
+
+  XMEMSET( P, 0, sizeof( *P ) );
+  P->digest_length = outlen;
+  P->key_length    = keylen;
+  P->fanout        = BLAKE2SP_LEAVES;
+  P->depth         = 2;
+  store48( P->node_offset, offset );
+  P->inner_length  = BLAKE2S_OUTBYTES;
+  return blake2s_init_param( S, P );
+}
+
+static int blake2sp_init_root( blake2s_state *S, byte outlen, byte keylen )
+{
+  blake2s_param P[1];
+
+  XMEMSET( P, 0, sizeof( *P ) );
+  P->digest_length = outlen;
+  P->key_length    = keylen;
+  P->fanout        = BLAKE2SP_LEAVES;
+  P->depth         = 2;
+  P->node_depth    = 1;
+  P->inner_length  = BLAKE2S_OUTBYTES;
+  return blake2s_init_param( S, P );
+}
+
+static int blake2sp_init_nodes( blake2sp_state *S, byte outlen, byte keylen )
+{
+  int ret;
+  int i;
+
+  XMEMSET( S->buf, 0, sizeof( S->buf ) );
+  S->buflen = 0;
+
+  ret = blake2sp_init_root( S->R, outlen, keylen );
+  for( i = 0; ret == 0 && i < BLAKE2SP_LEAVES; ++i )
+    ret = blake2sp_init_leaf( S->S[i], outlen, keylen, (word32)i );
+
+  S->R->last_node = 1;
+  S->S[BLAKE2SP_LEAVES - 1]->last_node = 1;
+
+  return ret;
+}
+
+int blake2sp_init( blake2sp_state *S, const byte outlen )
+{
+  if ( ( !outlen ) || ( outlen > BLAKE2S_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  return blake2sp_init_nodes( S, outlen, 0 );
+}
+
+int blake2sp_init_key( blake2sp_state *S, const byte outlen, const void *key,
+                       const byte keylen )
+{
+  int ret;
+  int i;
+
+  if ( ( !outlen ) || ( outlen > BLAKE2S_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  if ( !key || !keylen || keylen > BLAKE2S_KEYBYTES ) return BAD_FUNC_ARG;
+
+  ret = blake2sp_init_nodes( S, outlen, keylen );
+  if ( ret < 0 ) return ret;
+
+  {
+#ifdef WOLFSSL_SMALL_STACK
+    byte* block;
+
+    block = (byte*)XMALLOC(BLAKE2S_BLOCKBYTES, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    if ( block == NULL ) return MEMORY_E;
+#else
+    byte block[BLAKE2S_BLOCKBYTES];
+#endif
+
+    XMEMSET( block, 0, BLAKE2S_BLOCKBYTES );
+    XMEMCPY( block, key, keylen );
+    for( i = 0; ret == 0 && i < BLAKE2SP_LEAVES; ++i )
+      ret = blake2s_update( S->S[i], block, BLAKE2S_BLOCKBYTES );
+    secure_zero_memory( block, BLAKE2S_BLOCKBYTES ); /* Burn the key from */
+                                                     /* memory */
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(block, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+  }
+  return ret;
+}
+
+/* A round of blocks is only compressed once more than a round less one block
+ * follows it, so every leaf's last block is still buffered for final. */
+int blake2sp_update( blake2sp_state *S, const byte *in, word32 inlen )
+{
+  const word32 round = BLAKE2SP_LEAVES * BLAKE2S_BLOCKBYTES;
+  int ret = 0;
+
+  while( inlen > 2 * round - BLAKE2S_BLOCKBYTES - S->buflen )
+  {
+    if( S->buflen == 0 )
+    {
+      ret = blake2sp_compress( S, in );
+      in += round;
+      inlen -= round;
+    }
+    else if( S->buflen >= round )
+    {
+      ret = blake2sp_compress( S, S->buf );
+      S->buflen -= round;
+      XMEMMOVE( S->buf, S->buf + round, (wolfssl_word)S->buflen );
+    }
+    else
+    {
+      word32 fill = round - S->buflen;
+
+      XMEMCPY( S->buf + S->buflen, in, (wolfssl_word)fill );
+      ret = blake2sp_compress( S, S->buf );
+      S->buflen = 0;
+      in += fill;
+      inlen -= fill;
+    }
+    if (ret < 0) return ret;
+  }
+
+  XMEMCPY( S->buf + S->buflen, in, (wolfssl_word)inlen );
+  S->buflen += inlen;
+
+  return 0;
+}
+
+int blake2sp_final( blake2sp_state *S, byte *out, byte outlen )
+{
+  byte hash[BLAKE2SP_LEAVES][BLAKE2S_OUTBYTES];
+  int ret = 0;
+  int i;
+
+  for( i = 0; ret == 0 && i < BLAKE2SP_LEAVES; ++i )
+  {
+    word32 off;
+
+    for( off = (word32)i * BLAKE2S_BLOCKBYTES; ret == 0 && off < S->buflen;
+         off += BLAKE2SP_LEAVES * BLAKE2S_BLOCKBYTES )
+    {
+      word32 left = S->buflen - off;
+
+      if( left > BLAKE2S_BLOCKBYTES ) left = BLAKE2S_BLOCKBYTES;
+      ret = blake2s_update( S->S[i], S->buf + off, left );
+    }
+    if ( ret == 0 )
+      ret = blake2s_final( S->S[i], hash[i], BLAKE2S_OUTBYTES );
+  }
+
+  for( i = 0; ret == 0 && i < BLAKE2SP_LEAVES; ++i )
+    ret = blake2s_update( S->R, hash[i], BLAKE2S_OUTBYTES );
+  if ( ret == 0 )
+    ret = blake2s_final( S->R, out, outlen );
+
+  secure_zero_memory( hash, sizeof( hash ) );
+
+  return ret;
+}
+
+int blake2sp( byte *out, const void *in, const void *key, const byte outlen,
+              const word32 inlen, byte keylen )
+{
+  blake2sp_state S[1];
+  int ret;
+
+  /* Verify parameters */
+  if ( NULL == in ) return BAD_FUNC_ARG;
+
+  if ( NULL == out ) return BAD_FUNC_ARG;
+
+  if( NULL == key ) keylen = 0;
+
+  if( keylen > 0 )
+    ret = blake2sp_init_key( S, outlen, key, keylen );
+  else
+    ret = blake2sp_init( S, outlen );
+  if (ret < 0) return ret;
+
+  ret = blake2sp_update( S, ( const byte * )in, inlen );
+  if (ret < 0) return ret;
+
+  return blake2sp_final( S, out, outlen );
+}
+
 #if defined(BLAKE2S_SELFTEST)
 #include <string.h>
 #include "blake2-kat.h"
@@ -495,6 +978,52 @@ int wc_Blake2sFinal(Blake2s* b2s, byte* final, word32 requestSz)
 }
 
 
+/* Init Blake2sp digest, track size in case final doesn't want to "remember" */
+int wc_InitBlake2sp(Blake2sp* b2sp, word32 digestSz)
+{
+    if (b2sp == NULL){
+        return BAD_FUNC_ARG;
+    }
+    b2sp->digestSz = digestSz;
+
+    return blake2sp_init(b2sp->S, (byte)digestSz);
+}
+
+/* Init Blake2sp digest with key, track size in case final doesn't want to
+ * "remember" */
+int wc_InitBlake2sp_WithKey(Blake2sp* b2sp, word32 digestSz, const byte *key,
+                            word32 keylen)
+{
+    if (b2sp == NULL){
+        return BAD_FUNC_ARG;
+    }
+    b2sp->digestSz = digestSz;
+
+    if (keylen >= 256)
+        return BAD_FUNC_ARG;
+
+    if (key)
+        return blake2sp_init_key(b2sp->S, (byte)digestSz, key, (byte)keylen);
+    else
+        return blake2sp_init(b2sp->S, (byte)digestSz);
+}
+
+/* Blake2sp Update */
+int wc_Blake2spUpdate(Blake2sp* b2sp, const byte* data, word32 sz)
+{
+    return blake2sp_update(b2sp->S, data, sz);
+}
+
+
+/* Blake2sp Final, if pass in zero size we use init digestSz */
+int wc_Blake2spFinal(Blake2sp* b2sp, byte* final, word32 requestSz)
+{
+    word32 sz = requestSz ? requestSz : b2sp->digestSz;
+
+    return blake2sp_final(b2sp->S, final, (byte)sz);
+}
+
+
 /* end CTaoCrypt API */
 
 #endif  /* HAVE_BLAKE2S */
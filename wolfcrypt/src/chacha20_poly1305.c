@@ -46,6 +46,640 @@ or Authenticated Encryption with Additional Data (AEAD) algorithm.
 #include <wolfcrypt/src/misc.c>
 #endif
 
+/* Single pass ChaCha20-Poly1305 with AVX2 and AVX-512 kernels */
+#ifdef USE_INTEL_CHACHA_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+#endif
+#if defined(USE_INTEL_CHACHA_SPEEDUP) && defined(WC_HAVE_TARGET_ATTR)
+    #include <immintrin.h>
+    #define HAVE_INTEL_CHAPOLY
+#endif
+
+#ifdef HAVE_INTEL_CHAPOLY
+
+/* Bytes of data per pass of the kernels: 8 and 16 ChaCha blocks. */
+#define CHAPOLY_AVX2_CHUNK      (8 * CHACHA_CHUNK_BYTES)
+#define CHAPOLY_AVX512_CHUNK    (16 * CHACHA_CHUNK_BYTES)
+
+#define CHAPOLY_M26             0x3ffffff
+
+/* Poly1305 state of the single pass code.
+ * Radix 2^26 so that the vector lanes fold in and out without conversion.
+ */
+typedef struct ChaChaPoly_Mac {
+    word32 r[8][5];     /* r^1 .. r^8 */
+    word32 h[5];
+    word32 pad[4];
+} ChaChaPoly_Mac;
+
+static word32 intel_flags;
+static int cpu_flags_set = 0;
+
+/* h = h * r mod 2^130 - 5, limbs left partially reduced. */
+static void chapoly_mul(word32* h, const word32* r)
+{
+    word64 s1 = (word64)r[1] * 5;
+    word64 s2 = (word64)r[2] * 5;
+    word64 s3 = (word64)r[3] * 5;
+    word64 s4 = (word64)r[4] * 5;
+    word64 d0, d1, d2, d3, d4, c;
+
+    d0 = (word64)h[0] * r[0] + h[1] * s4 + h[2] * s3 + h[3] * s2 + h[4] * s1;
+    d1 = (word64)h[0] * r[1] + (word64)h[1] * r[0] + h[2] * s4 + h[3] * s3 +
+         h[4] * s2;
+    d2 = (word64)h[0] * r[2] + (word64)h[1] * r[1] + (word64)h[2] * r[0] +
+         h[3] * s4 + h[4] * s3;
+    d3 = (word64)h[0] * r[3] + (word64)h[1] * r[2] + (word64)h[2] * r[1] +
+         (word64)h[3] * r[0] + h[4] * s4;
+    d4 = (word64)h[0] * r[4] + (word64)h[1] * r[3] + (word64)h[2] * r[2] +
+         (word64)h[3] * r[1] + (word64)h[4] * r[0];
+
+    c = d0 >> 26; h[0] = (word32)d0 & CHAPOLY_M26; d1 += c;
+    c = d1 >> 26; h[1] = (word32)d1 & CHAPOLY_M26; d2 += c;
+    c = d2 >> 26; h[2] = (word32)d2 & CHAPOLY_M26; d3 += c;
+    c = d3 >> 26; h[3] = (word32)d3 & CHAPOLY_M26; d4 += c;
+    c = d4 >> 26; h[4] = (word32)d4 & CHAPOLY_M26;
+    d0 = h[0] + c * 5;
+    h[0] = (word32)d0 & CHAPOLY_M26;
+    h[1] += (word32)(d0 >> 26);
+}
+
+/* Load the one-time key set by wc_Poly1305SetKey and the powers of r. */
+static void chapoly_setkey(ChaChaPoly_Mac* mac, const Poly1305* poly)
+{
+    int i;
+    word64 r0 = poly->r[0];
+    word64 r1 = poly->r[1];
+
+    mac->r[0][0] = (word32)( r0                     ) & CHAPOLY_M26;
+    mac->r[0][1] = (word32)( r0 >> 26               ) & CHAPOLY_M26;
+    mac->r[0][2] = (word32)((r0 >> 52) | (r1 << 12)) & CHAPOLY_M26;
+    mac->r[0][3] = (word32)( r1 >> 14               ) & CHAPOLY_M26;
+    mac->r[0][4] = (word32)( r1 >> 40               ) & CHAPOLY_M26;
+    for (i = 1; i < 8; i++) {
+        XMEMCPY(mac->r[i], mac->r[i - 1], sizeof(mac->r[i]));
+        chapoly_mul(mac->r[i], mac->r[0]);
+    }
+
+    XMEMSET(mac->h, 0, sizeof(mac->h));
+    mac->pad[0] = (word32)poly->pad[0];
+    mac->pad[1] = (word32)(poly->pad[0] >> 32);
+    mac->pad[2] = (word32)poly->pad[1];
+    mac->pad[3] = (word32)(poly->pad[1] >> 32);
+}
+
+/* MAC data, zero padding the last block to 16 bytes. */
+static void chapoly_update(ChaChaPoly_Mac* mac, const byte* m, word32 sz)
+{
+    byte block[POLY1305_BLOCK_SIZE];
+    word32 w[4];
+
+    while (sz > 0) {
+        if (sz < POLY1305_BLOCK_SIZE) {
+            XMEMSET(block, 0, sizeof(block));
+            XMEMCPY(block, m, sz);
+            m = block;
+            sz = POLY1305_BLOCK_SIZE;
+        }
+        XMEMCPY(w, m, sizeof(w));
+        mac->h[0] +=  w[0]                      & CHAPOLY_M26;
+        mac->h[1] += ((w[0] >> 26) | (w[1] <<  6)) & CHAPOLY_M26;
+        mac->h[2] += ((w[1] >> 20) | (w[2] << 12)) & CHAPOLY_M26;
+        mac->h[3] += ((w[2] >> 14) | (w[3] << 18)) & CHAPOLY_M26;
+        mac->h[4] +=  (w[3] >>  8) | (1 << 24);
+        chapoly_mul(mac->h, mac->r[0]);
+
+        m += POLY1305_BLOCK_SIZE;
+        sz -= POLY1305_BLOCK_SIZE;
+    }
+}
+
+/* MAC the lengths block and put out the tag. */
+static void chapoly_final(ChaChaPoly_Mac* mac, word32 aadSz, word32 sz,
+                          byte* tag)
+{
+    word32 len[4];
+    word32 h0, h1, h2, h3, h4, g0, g1, g2, g3, g4, c, mask;
+    word64 f;
+
+    len[0] = aadSz; len[1] = 0;
+    len[2] = sz;    len[3] = 0;
+    chapoly_update(mac, (const byte*)len, sizeof(len));
+
+    h0 = mac->h[0]; h1 = mac->h[1]; h2 = mac->h[2];
+    h3 = mac->h[3]; h4 = mac->h[4];
+
+    /* fully carry h */
+    c = h1 >> 26; h1 &= CHAPOLY_M26;
+    h2 += c; c = h2 >> 26; h2 &= CHAPOLY_M26;
+    h3 += c; c = h3 >> 26; h3 &= CHAPOLY_M26;
+    h4 += c; c = h4 >> 26; h4 &= CHAPOLY_M26;
+    h0 += c * 5; c = h0 >> 26; h0 &= CHAPOLY_M26;
+    h1 += c;
+
+    /* compute h + -p and select h if h < p */
+    g0 = h0 + 5; c = g0 >> 26; g0 &= CHAPOLY_M26;
+    g1 = h1 + c; c = g1 >> 26; g1 &= CHAPOLY_M26;
+    g2 = h2 + c; c = g2 >> 26; g2 &= CHAPOLY_M26;
+    g3 = h3 + c; c = g3 >> 26; g3 &= CHAPOLY_M26;
+    g4 = h4 + c - (1UL << 26);
+
+    mask = (g4 >> 31) - 1;
+    g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+    h3 = (h3 & mask) | g3;
+    h4 = (h4 & mask) | g4;
+
+    /* h = (h % 2^128) + pad */
+    h0 = ((h0      ) | (h1 << 26));
+    h1 = ((h1 >>  6) | (h2 << 20));
+    h2 = ((h2 >> 12) | (h3 << 14));
+    h3 = ((h3 >> 18) | (h4 <<  8));
+
+    f = (word64)h0 + mac->pad[0];             len[0] = (word32)f;
+    f = (word64)h1 + mac->pad[1] + (f >> 32); len[1] = (word32)f;
+    f = (word64)h2 + mac->pad[2] + (f >> 32); len[2] = (word32)f;
+    f = (word64)h3 + mac->pad[3] + (f >> 32); len[3] = (word32)f;
+    XMEMCPY(tag, len, POLY1305_DIGEST_SIZE);
+}
+
+/* Operations for lanes of 26-bit limbs in 64-bit elements. */
+#define CHAPOLY256_ADD  _mm256_add_epi64
+#define CHAPOLY256_MUL  _mm256_mul_epu32
+#define CHAPOLY256_AND  _mm256_and_si256
+#define CHAPOLY256_SRL  _mm256_srli_epi64
+#define CHAPOLY256_SLL  _mm256_slli_epi64
+#define CHAPOLY512_ADD  _mm512_add_epi64
+#define CHAPOLY512_MUL  _mm512_mul_epu32
+#define CHAPOLY512_AND  _mm512_and_si512
+#define CHAPOLY512_SRL  _mm512_srli_epi64
+#define CHAPOLY512_SLL  _mm512_slli_epi64
+
+/* h = h * r mod 2^130 - 5 in each lane, s = 5 * r. */
+#define CHAPOLY_VMUL(V, T, h, r, s, m26)                                     \
+    do {                                                                     \
+        T d0_, d1_, d2_, d3_, d4_, c_;                                       \
+        d0_ = V##_MUL(h[0], r[0]);                                           \
+        d1_ = V##_MUL(h[0], r[1]);                                           \
+        d2_ = V##_MUL(h[0], r[2]);                                           \
+        d3_ = V##_MUL(h[0], r[3]);                                           \
+        d4_ = V##_MUL(h[0], r[4]);                                           \
+        d0_ = V##_ADD(d0_, V##_MUL(h[1], s[4]));                             \
+        d1_ = V##_ADD(d1_, V##_MUL(h[1], r[0]));                             \
+        d2_ = V##_ADD(d2_, V##_MUL(h[1], r[1]));                             \
+        d3_ = V##_ADD(d3_, V##_MUL(h[1], r[2]));                             \
+        d4_ = V##_ADD(d4_, V##_MUL(h[1], r[3]));                             \
+        d0_ = V##_ADD(d0_, V##_MUL(h[2], s[3]));                             \
+        d1_ = V##_ADD(d1_, V##_MUL(h[2], s[4]));                             \
+        d2_ = V##_ADD(d2_, V##_MUL(h[2], r[0]));                             \
+        d3_ = V##_ADD(d3_, V##_MUL(h[2], r[1]));                             \
+        d4_ = V##_ADD(d4_, V##_MUL(h[2], r[2]));                             \
+        d0_ = V##_ADD(d0_, V##_MUL(h[3], s[2]));                             \
+        d1_ = V##_ADD(d1_, V##_MUL(h[3], s[3]));                             \
+        d2_ = V##_ADD(d2_, V##_MUL(h[3], s[4]));                             \
+        d3_ = V##_ADD(d3_, V##_MUL(h[3], r[0]));                             \
+        d4_ = V##_ADD(d4_, V##_MUL(h[3], r[1]));                             \
+        d0_ = V##_ADD(d0_, V##_MUL(h[4], s[1]));                             \
+        d1_ = V##_ADD(d1_, V##_MUL(h[4], s[2]));                             \
+        d2_ = V##_ADD(d2_, V##_MUL(h[4], s[3]));                             \
+        d3_ = V##_ADD(d3_, V##_MUL(h[4], s[4]));                             \
+        d4_ = V##_ADD(d4_, V##_MUL(h[4], r[0]));                             \
+        c_ = V##_SRL(d0_, 26); h[0] = V##_AND(d0_, m26);                     \
+        d1_ = V##_ADD(d1_, c_);                                              \
+        c_ = V##_SRL(d3_, 26); h[3] = V##_AND(d3_, m26);                     \
+        d4_ = V##_ADD(d4_, c_);                                              \
+        c_ = V##_SRL(d1_, 26); h[1] = V##_AND(d1_, m26);                     \
+        d2_ = V##_ADD(d2_, c_);                                              \
+        c_ = V##_SRL(d4_, 26); h[4] = V##_AND(d4_, m26);                     \
+        h[0] = V##_ADD(h[0], V##_ADD(c_, V##_SLL(c_, 2)));                   \
+        c_ = V##_SRL(d2_, 26); h[2] = V##_AND(d2_, m26);                     \
+        h[3] = V##_ADD(h[3], c_);                                            \
+        c_ = V##_SRL(h[0], 26); h[0] = V##_AND(h[0], m26);                   \
+        h[1] = V##_ADD(h[1], c_);                                            \
+        c_ = V##_SRL(h[3], 26); h[3] = V##_AND(h[3], m26);                   \
+        h[4] = V##_ADD(h[4], c_);                                            \
+    } while (0)
+
+/* Split 128-bit blocks, as low and high 64-bit halves per lane, into limbs
+ * and add them to h. */
+#define CHAPOLY_VADD_BLOCKS(V, h, lo, hi, m26, hibit)                        \
+    do {                                                                     \
+        h[0] = V##_ADD(h[0], V##_AND(lo, m26));                              \
+        h[1] = V##_ADD(h[1], V##_AND(V##_SRL(lo, 26), m26));                 \
+        h[2] = V##_ADD(h[2], V##_AND(V##_ADD(V##_SRL(lo, 52),                \
+                                             V##_SLL(hi, 12)), m26));        \
+        h[3] = V##_ADD(h[3], V##_AND(V##_SRL(hi, 14), m26));                 \
+        h[4] = V##_ADD(h[4], V##_ADD(V##_SRL(hi, 40), hibit));               \
+    } while (0)
+
+/* Fold the lanes into the scalar state: lane i of h has been multiplied by
+ * r^(lanes - i) and the lanes are summed. */
+static void chapoly_fold(ChaChaPoly_Mac* mac, const word64* lanes, int n)
+{
+    word64 d[5];
+    word64 c;
+    int i, j;
+
+    for (i = 0; i < 5; i++) {
+        d[i] = 0;
+        for (j = 0; j < n; j++)
+            d[i] += lanes[i * n + j];
+    }
+    c = d[0] >> 26; d[0] &= CHAPOLY_M26; d[1] += c;
+    c = d[1] >> 26; d[1] &= CHAPOLY_M26; d[2] += c;
+    c = d[2] >> 26; d[2] &= CHAPOLY_M26; d[3] += c;
+    c = d[3] >> 26; d[3] &= CHAPOLY_M26; d[4] += c;
+    c = d[4] >> 26; d[4] &= CHAPOLY_M26; d[0] += c * 5;
+    c = d[0] >> 26; d[0] &= CHAPOLY_M26; d[1] += c;
+    for (i = 0; i < 5; i++)
+        mac->h[i] = (word32)d[i];
+}
+
+/* ChaCha20 quarter round on vectors of 32-bit words. */
+#define CHACHA_VQR(V, a, b, c, d)                                            \
+    a = V##_ADD32(a, b); d = V##_XOR(d, a); d = V##_ROTL16(d);               \
+    c = V##_ADD32(c, d); b = V##_XOR(b, c); b = V##_ROTL12(b);               \
+    a = V##_ADD32(a, b); d = V##_XOR(d, a); d = V##_ROTL8(d);                \
+    c = V##_ADD32(c, d); b = V##_XOR(b, c); b = V##_ROTL7(b)
+
+#define CHACHA_VDOUBLE_ROUND(V, x)                                           \
+    do {                                                                     \
+        CHACHA_VQR(V, x[0], x[4], x[ 8], x[12]);                             \
+        CHACHA_VQR(V, x[1], x[5], x[ 9], x[13]);                             \
+        CHACHA_VQR(V, x[2], x[6], x[10], x[14]);                             \
+        CHACHA_VQR(V, x[3], x[7], x[11], x[15]);                             \
+        CHACHA_VQR(V, x[0], x[5], x[10], x[15]);                             \
+        CHACHA_VQR(V, x[1], x[6], x[11], x[12]);                             \
+        CHACHA_VQR(V, x[2], x[7], x[ 8], x[13]);                             \
+        CHACHA_VQR(V, x[3], x[4], x[ 9], x[14]);                             \
+    } while (0)
+
+/* Transpose words 4g..4g+3 so that element k of each 128-bit lane of
+ * x[4g+k] holds them for one block. */
+#define CHACHA_VTRANSPOSE4(V, T, x, g)                                       \
+    do {                                                                     \
+        T t0_ = V##_UNPACKLO32(x[4*(g)+0], x[4*(g)+1]);                      \
+        T t1_ = V##_UNPACKHI32(x[4*(g)+0], x[4*(g)+1]);                      \
+        T t2_ = V##_UNPACKLO32(x[4*(g)+2], x[4*(g)+3]);                      \
+        T t3_ = V##_UNPACKHI32(x[4*(g)+2], x[4*(g)+3]);                      \
+        x[4*(g)+0] = V##_UNPACKLO64(t0_, t2_);                               \
+        x[4*(g)+1] = V##_UNPACKHI64(t0_, t2_);                               \
+        x[4*(g)+2] = V##_UNPACKLO64(t1_, t3_);                               \
+        x[4*(g)+3] = V##_UNPACKHI64(t1_, t3_);                               \
+    } while (0)
+
+#define CHACHA256_ADD32      _mm256_add_epi32
+#define CHACHA256_XOR        _mm256_xor_si256
+#define CHACHA256_ROTL16(a)  _mm256_shuffle_epi8(a, rot16)
+#define CHACHA256_ROTL8(a)   _mm256_shuffle_epi8(a, rot8)
+#define CHACHA256_ROTL12(a)  _mm256_or_si256(_mm256_slli_epi32(a, 12),        \
+                                             _mm256_srli_epi32(a, 20))
+#define CHACHA256_ROTL7(a)   _mm256_or_si256(_mm256_slli_epi32(a, 7),         \
+                                             _mm256_srli_epi32(a, 25))
+#define CHACHA256_UNPACKLO32 _mm256_unpacklo_epi32
+#define CHACHA256_UNPACKHI32 _mm256_unpackhi_epi32
+#define CHACHA256_UNPACKLO64 _mm256_unpacklo_epi64
+#define CHACHA256_UNPACKHI64 _mm256_unpackhi_epi64
+
+#define CHACHA512_ADD32      _mm512_add_epi32
+#define CHACHA512_XOR        _mm512_xor_si512
+#define CHACHA512_ROTL16(a)  _mm512_rol_epi32(a, 16)
+#define CHACHA512_ROTL12(a)  _mm512_rol_epi32(a, 12)
+#define CHACHA512_ROTL8(a)   _mm512_rol_epi32(a, 8)
+#define CHACHA512_ROTL7(a)   _mm512_rol_epi32(a, 7)
+#define CHACHA512_UNPACKLO32 _mm512_unpacklo_epi32
+#define CHACHA512_UNPACKHI32 _mm512_unpackhi_epi32
+#define CHACHA512_UNPACKLO64 _mm512_unpacklo_epi64
+#define CHACHA512_UNPACKHI64 _mm512_unpackhi_epi64
+
+/* Poly1305 step over 4 blocks: h = h * r^4 + m, or h = h + m first time. */
+#define CHAPOLY_AVX2_STEP(p)                                                 \
+    do {                                                                     \
+        __m256i a_ = _mm256_loadu_si256((const __m256i*)(p));                \
+        __m256i b_ = _mm256_loadu_si256((const __m256i*)((p) + 32));         \
+        __m256i lo_ = _mm256_permute4x64_epi64(                              \
+                                     _mm256_unpacklo_epi64(a_, b_), 0xd8);   \
+        __m256i hi_ = _mm256_permute4x64_epi64(                              \
+                                     _mm256_unpackhi_epi64(a_, b_), 0xd8);   \
+        if (started)                                                         \
+            CHAPOLY_VMUL(CHAPOLY256, __m256i, h, r4, s4, m26);               \
+        CHAPOLY_VADD_BLOCKS(CHAPOLY256, h, lo_, hi_, m26, hibit);            \
+        started = 1;                                                         \
+    } while (0)
+
+/* Encrypt or decrypt whole chunks of 8 blocks with ChaCha20 and MAC them
+ * with 4-way Poly1305 in the same pass.
+ * The MAC of each group of 4 blocks is done between double rounds. When
+ * encrypting, the previous chunk's ciphertext is MACed while the keystream
+ * for the next is generated. When decrypting, the input is MACed before the
+ * plaintext is written so in-place works.
+ * When encrypting, the rest of the data is encrypted here too.
+ * Returns the number of bytes of ciphertext that are MACed.
+ */
+static WC_TARGET_AVX2 word32 chapoly_crypt_avx2(ChaCha* ctx,
+    ChaChaPoly_Mac* mac, const byte* in, byte* out, word32 sz, int isEncrypt)
+{
+    const __m256i rot16 = _mm256_set_epi8(
+        13, 12, 15, 14,  9,  8, 11, 10,  5,  4,  7,  6,  1,  0,  3,  2,
+        13, 12, 15, 14,  9,  8, 11, 10,  5,  4,  7,  6,  1,  0,  3,  2);
+    const __m256i rot8 = _mm256_set_epi8(
+        14, 13, 12, 15, 10,  9,  8, 11,  6,  5,  4,  7,  2,  1,  0,  3,
+        14, 13, 12, 15, 10,  9,  8, 11,  6,  5,  4,  7,  2,  1,  0,  3);
+    const __m256i m26 = _mm256_set1_epi64x(CHAPOLY_M26);
+    const __m256i hibit = _mm256_set1_epi64x(1 << 24);
+    __m256i x[16];
+    __m256i h[5], r4[5], s4[5];
+    word64 lanes[5 * 4];
+    const byte* c = isEncrypt ? out : in;
+    const byte* mp;
+    word32 done, macSz;
+    int started = 0;
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        h[i] = _mm256_set_epi64x(0, 0, 0, mac->h[i]);
+        r4[i] = _mm256_set1_epi64x(mac->r[3][i]);
+        s4[i] = _mm256_set1_epi64x((word64)mac->r[3][i] * 5);
+    }
+
+    for (done = 0; sz - done >= CHAPOLY_AVX2_CHUNK;
+                                                 done += CHAPOLY_AVX2_CHUNK) {
+        if (isEncrypt)
+            mp = (done == 0) ? NULL : c + done - CHAPOLY_AVX2_CHUNK;
+        else
+            mp = c + done;
+
+        for (i = 0; i < 16; i++)
+            x[i] = _mm256_set1_epi32((int)ctx->X[i]);
+        x[12] = _mm256_add_epi32(x[12], _mm256_set_epi32(7, 6, 5, 4,
+                                                         3, 2, 1, 0));
+        for (i = 0; i < 10; i++) {
+            if (mp != NULL && i < 8)
+                CHAPOLY_AVX2_STEP(mp + i * 64);
+            CHACHA_VDOUBLE_ROUND(CHACHA256, x);
+        }
+        for (i = 0; i < 16; i++)
+            x[i] = _mm256_add_epi32(x[i], _mm256_set1_epi32((int)ctx->X[i]));
+        x[12] = _mm256_add_epi32(x[12], _mm256_set_epi32(7, 6, 5, 4,
+                                                         3, 2, 1, 0));
+
+        CHACHA_VTRANSPOSE4(CHACHA256, __m256i, x, 0);
+        CHACHA_VTRANSPOSE4(CHACHA256, __m256i, x, 1);
+        CHACHA_VTRANSPOSE4(CHACHA256, __m256i, x, 2);
+        CHACHA_VTRANSPOSE4(CHACHA256, __m256i, x, 3);
+        for (i = 0; i < 4; i++) {
+            const __m256i* ip = (const __m256i*)(in + done + 64 * i);
+            __m256i* op = (__m256i*)(out + done + 64 * i);
+            __m256i k0 = _mm256_permute2x128_si256(x[i], x[4 + i], 0x20);
+            __m256i k1 = _mm256_permute2x128_si256(x[8 + i], x[12 + i], 0x20);
+            __m256i k2 = _mm256_permute2x128_si256(x[i], x[4 + i], 0x31);
+            __m256i k3 = _mm256_permute2x128_si256(x[8 + i], x[12 + i], 0x31);
+
+            k0 = _mm256_xor_si256(k0, _mm256_loadu_si256(ip + 0));
+            k1 = _mm256_xor_si256(k1, _mm256_loadu_si256(ip + 1));
+            k2 = _mm256_xor_si256(k2, _mm256_loadu_si256(ip + 8));
+            k3 = _mm256_xor_si256(k3, _mm256_loadu_si256(ip + 9));
+            _mm256_storeu_si256(op + 0, k0);
+            _mm256_storeu_si256(op + 1, k1);
+            _mm256_storeu_si256(op + 8, k2);
+            _mm256_storeu_si256(op + 9, k3);
+        }
+        ctx->X[CHACHA_MATRIX_CNT_IV] += 8;
+    }
+
+    if (isEncrypt) {
+        for (i = 0; i < 8; i++)
+            CHAPOLY_AVX2_STEP(c + done - CHAPOLY_AVX2_CHUNK + i * 64);
+        if (done < sz)
+            wc_Chacha_Process(ctx, out + done, in + done, sz - done);
+    }
+    for (macSz = done; sz - macSz >= 64; macSz += 64)
+        CHAPOLY_AVX2_STEP(c + macSz);
+
+    /* lane i times r^(4 - i) */
+    for (i = 0; i < 5; i++) {
+        r4[i] = _mm256_set_epi64x(mac->r[0][i], mac->r[1][i], mac->r[2][i],
+                                  mac->r[3][i]);
+        s4[i] = _mm256_add_epi64(r4[i], _mm256_slli_epi64(r4[i], 2));
+    }
+    CHAPOLY_VMUL(CHAPOLY256, __m256i, h, r4, s4, m26);
+    for (i = 0; i < 5; i++)
+        _mm256_storeu_si256((__m256i*)&lanes[i * 4], h[i]);
+    chapoly_fold(mac, lanes, 4);
+
+    return macSz;
+}
+
+/* Poly1305 step over 8 blocks: h = h * r^8 + m, or h = h + m first time. */
+#define CHAPOLY_AVX512_STEP(p)                                               \
+    do {                                                                     \
+        __m512i a_ = _mm512_loadu_si512((const void*)(p));                   \
+        __m512i b_ = _mm512_loadu_si512((const void*)((p) + 64));            \
+        __m512i lo_ = _mm512_permutex2var_epi64(a_, idxLo, b_);              \
+        __m512i hi_ = _mm512_permutex2var_epi64(a_, idxHi, b_);              \
+        if (started)                                                         \
+            CHAPOLY_VMUL(CHAPOLY512, __m512i, h, r8, s8, m26);               \
+        CHAPOLY_VADD_BLOCKS(CHAPOLY512, h, lo_, hi_, m26, hibit);            \
+        started = 1;                                                         \
+    } while (0)
+
+/* Put out 4 blocks: element k of the 128-bit lanes of a, b, c and d. */
+#define CHACHA512_XOR_STORE4(a, b, c, d, k)                                  \
+    do {                                                                     \
+        __m512i u0_ = _mm512_shuffle_i32x4(a, b, 0x44);                      \
+        __m512i u1_ = _mm512_shuffle_i32x4(a, b, 0xee);                      \
+        __m512i u2_ = _mm512_shuffle_i32x4(c, d, 0x44);                      \
+        __m512i u3_ = _mm512_shuffle_i32x4(c, d, 0xee);                      \
+        __m512i o0_ = _mm512_shuffle_i32x4(u0_, u2_, 0x88);                  \
+        __m512i o1_ = _mm512_shuffle_i32x4(u0_, u2_, 0xdd);                  \
+        __m512i o2_ = _mm512_shuffle_i32x4(u1_, u3_, 0x88);                  \
+        __m512i o3_ = _mm512_shuffle_i32x4(u1_, u3_, 0xdd);                  \
+        const byte* ip_ = in + done + 64 * (k);                              \
+        byte* op_ = out + done + 64 * (k);                                   \
+        o0_ = _mm512_xor_si512(o0_, _mm512_loadu_si512(ip_ +   0));          \
+        o1_ = _mm512_xor_si512(o1_, _mm512_loadu_si512(ip_ + 256));          \
+        o2_ = _mm512_xor_si512(o2_, _mm512_loadu_si512(ip_ + 512));          \
+        o3_ = _mm512_xor_si512(o3_, _mm512_loadu_si512(ip_ + 768));          \
+        _mm512_storeu_si512(op_ +   0, o0_);                                 \
+        _mm512_storeu_si512(op_ + 256, o1_);                                 \
+        _mm512_storeu_si512(op_ + 512, o2_);                                 \
+        _mm512_storeu_si512(op_ + 768, o3_);                                 \
+    } while (0)
+
+/* As chapoly_crypt_avx2 but 16 ChaCha20 blocks and 8-way Poly1305. */
+static WC_TARGET_AVX512 word32 chapoly_crypt_avx512(ChaCha* ctx,
+    ChaChaPoly_Mac* mac, const byte* in, byte* out, word32 sz, int isEncrypt)
+{
+    const __m512i idxLo = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i idxHi = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+    const __m512i ctr = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+                                          7,  6,  5,  4,  3,  2, 1, 0);
+    const __m512i m26 = _mm512_set1_epi64(CHAPOLY_M26);
+    const __m512i hibit = _mm512_set1_epi64(1 << 24);
+    __m512i x[16];
+    __m512i h[5], r8[5], s8[5];
+    word64 lanes[5 * 8];
+    const byte* c = isEncrypt ? out : in;
+    const byte* mp;
+    word32 done, macSz;
+    int started = 0;
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        h[i] = _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, mac->h[i]);
+        r8[i] = _mm512_set1_epi64(mac->r[7][i]);
+        s8[i] = _mm512_set1_epi64((word64)mac->r[7][i] * 5);
+    }
+
+    for (done = 0; sz - done >= CHAPOLY_AVX512_CHUNK;
+                                               done += CHAPOLY_AVX512_CHUNK) {
+        if (isEncrypt)
+            mp = (done == 0) ? NULL : c + done - CHAPOLY_AVX512_CHUNK;
+        else
+            mp = c + done;
+
+        for (i = 0; i < 16; i++)
+            x[i] = _mm512_set1_epi32((int)ctx->X[i]);
+        x[12] = _mm512_add_epi32(x[12], ctr);
+        for (i = 0; i < 10; i++) {
+            if (mp != NULL && i < 8)
+                CHAPOLY_AVX512_STEP(mp + i * 128);
+            CHACHA_VDOUBLE_ROUND(CHACHA512, x);
+        }
+        for (i = 0; i < 16; i++)
+            x[i] = _mm512_add_epi32(x[i], _mm512_set1_epi32((int)ctx->X[i]));
+        x[12] = _mm512_add_epi32(x[12], ctr);
+
+        CHACHA_VTRANSPOSE4(CHACHA512, __m512i, x, 0);
+        CHACHA_VTRANSPOSE4(CHACHA512, __m512i, x, 1);
+        CHACHA_VTRANSPOSE4(CHACHA512, __m512i, x, 2);
+        CHACHA_VTRANSPOSE4(CHACHA512, __m512i, x, 3);
+        CHACHA512_XOR_STORE4(x[0], x[4], x[ 8], x[12], 0);
+        CHACHA512_XOR_STORE4(x[1], x[5], x[ 9], x[13], 1);
+        CHACHA512_XOR_STORE4(x[2], x[6], x[10], x[14], 2);
+        CHACHA512_XOR_STORE4(x[3], x[7], x[11], x[15], 3);
+        ctx->X[CHACHA_MATRIX_CNT_IV] += 16;
+    }
+
+    if (isEncrypt) {
+        for (i = 0; i < 8; i++)
+            CHAPOLY_AVX512_STEP(c + done - CHAPOLY_AVX512_CHUNK + i * 128);
+        if (done < sz)
+            wc_Chacha_Process(ctx, out + done, in + done, sz - done);
+    }
+    for (macSz = done; sz - macSz >= 128; macSz += 128)
+        CHAPOLY_AVX512_STEP(c + macSz);
+
+    /* lane i times r^(8 - i) */
+    for (i = 0; i < 5; i++) {
+        r8[i] = _mm512_set_epi64(mac->r[0][i], mac->r[1][i], mac->r[2][i],
+                                 mac->r[3][i], mac->r[4][i], mac->r[5][i],
+                                 mac->r[6][i], mac->r[7][i]);
+        s8[i] = _mm512_add_epi64(r8[i], _mm512_slli_epi64(r8[i], 2));
+    }
+    CHAPOLY_VMUL(CHAPOLY512, __m512i, h, r8, s8, m26);
+    for (i = 0; i < 5; i++)
+        _mm512_storeu_si512(&lanes[i * 8], h[i]);
+    chapoly_fold(mac, lanes, 8);
+
+    return macSz;
+}
+
+/* Single pass encrypt/decrypt and MAC when the CPU and length allow.
+ * Returns 1 when done and 0 to fall back to separate passes.
+ */
+static int ChaCha20Poly1305_Crypt_Intel(ChaCha* chacha, Poly1305* poly,
+    const byte* aad, word32 aadSz, const byte* in, byte* out, word32 sz,
+    int isEncrypt, byte* tag)
+{
+    ChaChaPoly_Mac mac;
+    word32 macSz;
+    int avx512;
+
+    if (!cpu_flags_set) {
+        intel_flags = cpuid_get_flags();
+        cpu_flags_set = 1;
+    }
+    avx512 = IS_INTEL_AVX512(intel_flags) && sz >= CHAPOLY_AVX512_CHUNK;
+    if (!avx512 && (!IS_INTEL_AVX2(intel_flags) || sz < CHAPOLY_AVX2_CHUNK))
+        return 0;
+    if (chacha->left != 0)
+        return 0;
+
+    chapoly_setkey(&mac, poly);
+    chapoly_update(&mac, aad, aadSz);
+
+    SAVE_VECTOR_REGISTERS();
+    if (avx512)
+        macSz = chapoly_crypt_avx512(chacha, &mac, in, out, sz, isEncrypt);
+    else
+        macSz = chapoly_crypt_avx2(chacha, &mac, in, out, sz, isEncrypt);
+    RESTORE_VECTOR_REGISTERS();
+
+    if (isEncrypt) {
+        chapoly_update(&mac, out + macSz, sz - macSz);
+    }
+    else {
+        word32 done = sz & ~(word32)((avx512 ? CHAPOLY_AVX512_CHUNK :
+                                               CHAPOLY_AVX2_CHUNK) - 1);
+        chapoly_update(&mac, in + macSz, sz - macSz);
+        if (done < sz)
+            wc_Chacha_Process(chacha, out + done, in + done, sz - done);
+    }
+    chapoly_final(&mac, aadSz, sz, tag);
+
+    ForceZero(&mac, sizeof(mac));
+    ForceZero(poly, sizeof(Poly1305));
+
+    return 1;
+}
+
+#endif /* HAVE_INTEL_CHAPOLY */
+
+/* Encrypt or decrypt data with ChaCha20 and calculate the Poly1305 tag over
+ * the AAD and ciphertext as in RFC 8439.
+ * chacha has the key and nonce set with the block counter at 1.
+ * poly has the one-time key set.
+ * in and out can be the same pointer.
+ */
+int wc_ChaCha20Poly1305_Process(ChaCha* chacha, Poly1305* poly,
+    const byte* aad, word32 aadSz, const byte* in, byte* out, word32 sz,
+    int isEncrypt, byte tag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE])
+{
+    int ret;
+
+    if (chacha == NULL || poly == NULL || (aad == NULL && aadSz > 0) ||
+            in == NULL || out == NULL || tag == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+#ifdef HAVE_INTEL_CHAPOLY
+    if (ChaCha20Poly1305_Crypt_Intel(chacha, poly, aad, aadSz, in, out, sz,
+                                     isEncrypt, tag)) {
+        return 0;
+    }
+#endif
+
+    if (isEncrypt) {
+        ret = wc_Chacha_Process(chacha, out, in, sz);
+        if (ret == 0) {
+            ret = wc_Poly1305_MAC(poly, (byte*)aad, aadSz, out, sz, tag,
+                                  CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE);
+        }
+    }
+    else {
+        ret = wc_Poly1305_MAC(poly, (byte*)aad, aadSz, (byte*)in, sz, tag,
+                              CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE);
+        if (ret == 0)
+            ret = wc_Chacha_Process(chacha, out, in, sz);
+    }
+
+    return ret;
+}
+
 #define CHACHA20_POLY1305_AEAD_INITIAL_COUNTER  0
 int wc_ChaCha20Poly1305_Encrypt(
                 const byte inKey[CHACHA20_POLY1305_AEAD_KEYSIZE],
@@ -70,12 +704,13 @@ int wc_ChaCha20Poly1305_Encrypt(
     ret = wc_ChaCha20Poly1305_Init(&aead, inKey, inIV,
         CHACHA20_POLY1305_AEAD_ENCRYPT);
     if (ret == 0)
-        ret = wc_ChaCha20Poly1305_UpdateAad(&aead, inAAD, inAADLen);
-    if (ret == 0)
-        ret = wc_ChaCha20Poly1305_UpdateData(&aead, inPlaintext, outCiphertext,
-            inPlaintextLen);
-    if (ret == 0)
-        ret = wc_ChaCha20Poly1305_Final(&aead, outAuthTag);
+        ret = wc_ChaCha20Poly1305_Process(&aead.chacha, &aead.poly, inAAD,
+            inAADLen, inPlaintext, outCiphertext, inPlaintextLen, 1,
+            outAuthTag);
+
+    /* reset and cleanup sensitive context */
+    ForceZero(&aead, sizeof(ChaChaPoly_Aead));
+
     return ret;
 }
 
@@ -105,12 +740,13 @@ int wc_ChaCha20Poly1305_Decrypt(
     ret = wc_ChaCha20Poly1305_Init(&aead, inKey, inIV,
         CHACHA20_POLY1305_AEAD_DECRYPT);
     if (ret == 0)
-        ret = wc_ChaCha20Poly1305_UpdateAad(&aead, inAAD, inAADLen);
-    if (ret == 0)
-        ret = wc_ChaCha20Poly1305_UpdateData(&aead, inCiphertext, outPlaintext,
-            inCiphertextLen);
-    if (ret == 0)
-        ret = wc_ChaCha20Poly1305_Final(&aead, calculatedAuthTag);
+        ret = wc_ChaCha20Poly1305_Process(&aead.chacha, &aead.poly, inAAD,
+            inAADLen, inCiphertext, outPlaintext, inCiphertextLen, 0,
+            calculatedAuthTag);
+
+    /* reset and cleanup sensitive context */
+    ForceZero(&aead, sizeof(ChaChaPoly_Aead));
+
     if (ret == 0)
         ret = wc_ChaCha20Poly1305_CheckTag(inAuthTag, calculatedAuthTag);
     return ret;
@@ -41,11 +41,17 @@
                 "=a" (reg[0]), "=b" (reg[1]), "=c" (reg[2]), "=d" (reg[3]) :\
                 "a" (leaf), "c"(sub));
 
+        #define xgetbv(idx, lo, hi)\
+            __asm__ __volatile__ ("xgetbv": "=a" (lo), "=d" (hi) : "c" (idx));
+
         #define XASM_LINK(f) asm(f)
     #else
         #include <intrin.h>
 
         #define cpuid(a,b,c) __cpuidex((int*)a,b,c)
+        #define xgetbv(idx, lo, hi)\
+            { unsigned __int64 xcr = _xgetbv(idx);\
+              lo = (word32)xcr; hi = (word32)(xcr >> 32); }
 
         #define XASM_LINK(f)
     #endif /* _MSC_VER */
@@ -87,6 +93,22 @@
         return 0;
     }
 
+    /* AVX-512 F, BW and VL are there and the OS saves the opmask and ZMM
+     * registers (XCR0 bits 1, 2 and 5 to 7) */
+    static word32 cpuid_avx512(void)
+    {
+        word32 lo, hi;
+
+        if (!cpuid_flag(7, 0, EBX, 16) || !cpuid_flag(7, 0, EBX, 30) ||
+                !cpuid_flag(7, 0, EBX, 31) || !cpuid_flag(1, 0, ECX, 27)) {
+            return 0;
+        }
+        xgetbv(0, lo, hi);
+        (void)hi;
+
+        return (lo & 0xE6) == 0xE6;
+    }
+
 
     void cpuid_set_flags(void)
     {
@@ -99,6 +121,11 @@
             if (cpuid_flag(1, 0, ECX, 25)) { cpuid_flags |= CPUID_AESNI ; }
             if (cpuid_flag(7, 0, EBX, 19)) { cpuid_flags |= CPUID_ADX   ; }
             if (cpuid_flag(1, 0, ECX, 22)) { cpuid_flags |= CPUID_MOVBE ; }
+            if (cpuid_avx512())            { cpuid_flags |= CPUID_AVX512; }
+            if (cpuid_flag(7, 0, ECX,  9)) { cpuid_flags |= CPUID_VAES  ; }
+            if (cpuid_flag(7, 0, ECX, 10)) { cpuid_flags |= CPUID_VPCLMULQDQ; }
+            if (cpuid_flag(7, 0, EBX, 29)) { cpuid_flags |= CPUID_SHA   ; }
+            if (cpuid_flag(1, 0, ECX, 19)) { cpuid_flags |= CPUID_SSE41 ; }
             cpuid_check = 1;
         }
     }
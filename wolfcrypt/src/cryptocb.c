@@ -707,4 +707,629 @@ int wc_CryptoCb_RandomSeed(OS_Seed* os, byte* seed, word32 sz)
 }
 #endif /* !WC_NO_RNG */
 
+#ifdef WOLF_CRYPTO_CB_POOL
+/* Hand count public key operations of one type to the device at once. On
+ * success rets has each one's result. */
+int wc_CryptoCb_PkBatch(int devId, int type, wc_CryptoInfo** ops, int* rets,
+    int count)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+    CryptoCb* dev;
+
+    if (devId == INVALID_DEVID || ops == NULL || rets == NULL || count <= 0)
+        return ret;
+
+    /* locate registered callback */
+    dev = wc_CryptoCb_FindDevice(devId);
+    if (dev && dev->cb) {
+        wc_CryptoInfo cryptoInfo;
+        XMEMSET(&cryptoInfo, 0, sizeof(cryptoInfo));
+        cryptoInfo.algo_type = WC_ALGO_TYPE_PK_BATCH;
+        cryptoInfo.batch.type = type;
+        cryptoInfo.batch.ops = ops;
+        cryptoInfo.batch.rets = rets;
+        cryptoInfo.batch.count = count;
+
+        ret = dev->cb(dev->devId, &cryptoInfo, dev->ctx);
+    }
+
+    return wc_CryptoCb_TranslateErrorCode(ret);
+}
+
+/* Software device that runs public key operations on a pool of worker
+ * threads. The operation returns WC_PENDING_E, its event is returned by
+ * wc_CryptoCb_PoolPoll when done and calling it again gives the result. */
+
+#ifndef CRYPTOCB_POOL_ROWS
+    #define CRYPTOCB_POOL_ROWS        64    /* job rows, hashed by key */
+#endif
+#ifndef CRYPTOCB_POOL_MAX_THREADS
+    #define CRYPTOCB_POOL_MAX_THREADS 64
+#endif
+
+typedef struct CryptoCbPoolJob CryptoCbPoolJob;
+struct CryptoCbPoolJob {
+    WOLF_EVENT       event;    /* first, context is the key */
+    wc_CryptoInfo    info;     /* copy of the request */
+    const void*      key;
+    const void*      out;      /* tells the repeated call from a new one */
+    CryptoCbPoolJob* next;     /* in row */
+    CryptoCbPoolJob* work;     /* in work list */
+    word32           outLen;   /* RSA output length, the caller's may change */
+    byte             queued;   /* in done queue */
+};
+
+typedef struct CryptoCbPoolWorker {
+    WC_CRYPTOCB_POOL* pool;
+    pthread_t         tid;
+    WC_RNG            rng;     /* own RNG, the caller's may be in use */
+    byte              started;
+    byte              haveRng;
+} CryptoCbPoolWorker;
+
+struct WC_CRYPTOCB_POOL {
+    CryptoCbPoolJob*    rows[CRYPTOCB_POOL_ROWS];
+    CryptoCbPoolJob*    workHead;
+    CryptoCbPoolJob*    workTail;
+    CryptoCbPoolWorker* workers;
+    WOLF_EVENT_QUEUE    done;
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    void*               heap;
+    int                 devId;
+    int                 threads;
+    int                 batchDevId; /* gets queued jobs of a type at once */
+    int                 maxBatch;
+    byte                stop;
+};
+
+
+static word32 CryptoCbPoolRow(const void* key)
+{
+    size_t v = (size_t)key;
+
+    /* key objects are at least word aligned */
+    v = (v >> 4) ^ (v >> 12);
+    return (word32)(v % CRYPTOCB_POOL_ROWS);
+}
+
+static int CryptoCbPoolIsWorker(WC_CRYPTOCB_POOL* pool)
+{
+    pthread_t self = pthread_self();
+    int i;
+
+    for (i = 0; i < pool->threads; i++) {
+        if (pool->workers[i].started &&
+                                 pthread_equal(pool->workers[i].tid, self))
+            return 1;
+    }
+    return 0;
+}
+
+/* Get the key the request is for and the output it writes. Returns 0 when
+ * the operation is run on the pool. */
+static int CryptoCbPoolJobKey(const wc_CryptoInfo* info, const void** key,
+                              const void** out)
+{
+    switch (info->pk.type) {
+    #ifndef NO_RSA
+        case WC_PK_TYPE_RSA:
+            *key = info->pk.rsa.key;
+            *out = info->pk.rsa.out;
+            return 0;
+        #ifdef WOLFSSL_KEY_GEN
+        case WC_PK_TYPE_RSA_KEYGEN:
+            *key = info->pk.rsakg.key;
+            *out = info->pk.rsakg.key;
+            return 0;
+        #endif
+    #endif
+    #ifdef HAVE_ECC
+        case WC_PK_TYPE_EC_KEYGEN:
+            *key = info->pk.eckg.key;
+            *out = info->pk.eckg.key;
+            return 0;
+        case WC_PK_TYPE_ECDH:
+            *key = info->pk.ecdh.private_key;
+            *out = info->pk.ecdh.out;
+            return 0;
+        case WC_PK_TYPE_ECDSA_SIGN:
+            *key = info->pk.eccsign.key;
+            *out = info->pk.eccsign.out;
+            return 0;
+        case WC_PK_TYPE_ECDSA_VERIFY:
+            *key = info->pk.eccverify.key;
+            *out = info->pk.eccverify.res;
+            return 0;
+    #endif
+        default:
+            return CRYPTOCB_UNAVAILABLE;
+    }
+}
+
+/* Run the request in software on a worker */
+static int CryptoCbPoolRun(wc_CryptoInfo* info, WC_RNG* rng)
+{
+    int ret = CRYPTOCB_UNAVAILABLE;
+
+    switch (info->pk.type) {
+    #ifndef NO_RSA
+        case WC_PK_TYPE_RSA:
+        {
+            RsaKey* key = info->pk.rsa.key;
+        #ifdef WC_RSA_BLINDING
+            WC_RNG* keyRng = key->rng;
+
+            if (keyRng != NULL)
+                key->rng = rng;
+        #endif
+            ret = wc_RsaFunction(info->pk.rsa.in, info->pk.rsa.inLen,
+                                 info->pk.rsa.out, info->pk.rsa.outLen,
+                                 info->pk.rsa.type, key,
+                                 info->pk.rsa.rng != NULL ? rng : NULL);
+        #ifdef WC_RSA_BLINDING
+            key->rng = keyRng;
+        #endif
+            break;
+        }
+        #ifdef WOLFSSL_KEY_GEN
+        case WC_PK_TYPE_RSA_KEYGEN:
+            ret = wc_MakeRsaKey(info->pk.rsakg.key, info->pk.rsakg.size,
+                                info->pk.rsakg.e, rng);
+            break;
+        #endif
+    #endif
+    #ifdef HAVE_ECC
+        case WC_PK_TYPE_EC_KEYGEN:
+            ret = wc_ecc_make_key_ex2(rng, info->pk.eckg.size,
+                                      info->pk.eckg.key, info->pk.eckg.curveId,
+                                      info->pk.eckg.key->flags);
+            break;
+        case WC_PK_TYPE_ECDH:
+        {
+            ecc_key* key = info->pk.ecdh.private_key;
+        #ifdef ECC_TIMING_RESISTANT
+            WC_RNG* keyRng = key->rng;
+
+            key->rng = rng;
+        #endif
+            ret = wc_ecc_shared_secret(key, info->pk.ecdh.public_key,
+                                       info->pk.ecdh.out,
+                                       info->pk.ecdh.outlen);
+        #ifdef ECC_TIMING_RESISTANT
+            key->rng = keyRng;
+        #endif
+            break;
+        }
+        case WC_PK_TYPE_ECDSA_SIGN:
+            ret = wc_ecc_sign_hash(info->pk.eccsign.in, info->pk.eccsign.inlen,
+                                   info->pk.eccsign.out,
+                                   info->pk.eccsign.outlen, rng,
+                                   info->pk.eccsign.key);
+            break;
+        case WC_PK_TYPE_ECDSA_VERIFY:
+            ret = wc_ecc_verify_hash(info->pk.eccverify.sig,
+                                     info->pk.eccverify.siglen,
+                                     info->pk.eccverify.hash,
+                                     info->pk.eccverify.hashlen,
+                                     info->pk.eccverify.res,
+                                     info->pk.eccverify.key);
+            break;
+    #endif
+        default:
+            break;
+    }
+    (void)rng;
+
+    return ret;
+}
+
+/* Give the batch device the worker's RNG, the caller's may be in use */
+static void CryptoCbPoolSetRng(wc_CryptoInfo* info, WC_RNG* rng)
+{
+    switch (info->pk.type) {
+    #ifndef NO_RSA
+        case WC_PK_TYPE_RSA:
+            if (info->pk.rsa.rng != NULL)
+                info->pk.rsa.rng = rng;
+            break;
+        #ifdef WOLFSSL_KEY_GEN
+        case WC_PK_TYPE_RSA_KEYGEN:
+            info->pk.rsakg.rng = rng;
+            break;
+        #endif
+    #endif
+    #ifdef HAVE_ECC
+        case WC_PK_TYPE_EC_KEYGEN:
+            info->pk.eckg.rng = rng;
+            break;
+        case WC_PK_TYPE_ECDSA_SIGN:
+            info->pk.eccsign.rng = rng;
+            break;
+    #endif
+        default:
+            break;
+    }
+}
+
+/* Take the next job and, with a batch device, more queued jobs of the same
+ * type. Pool is locked. Returns the number of jobs taken. */
+static int CryptoCbPoolTake(WC_CRYPTOCB_POOL* pool, CryptoCbPoolJob** jobs)
+{
+    CryptoCbPoolJob** link = &pool->workHead;
+    CryptoCbPoolJob*  last = NULL;
+    CryptoCbPoolJob*  job;
+    int type = pool->workHead->info.pk.type;
+    int max = (pool->batchDevId != INVALID_DEVID) ? pool->maxBatch : 1;
+    int count = 0;
+
+    while (*link != NULL && count < max) {
+        job = *link;
+        if (job->info.pk.type == type) {
+            *link = job->work;
+            job->work = NULL;
+            jobs[count++] = job;
+        }
+        else {
+            last = job;
+            link = &job->work;
+        }
+    }
+    if (*link == NULL)
+        pool->workTail = last;
+
+    return count;
+}
+
+static void* CryptoCbPoolThread(void* arg)
+{
+    CryptoCbPoolWorker* worker = (CryptoCbPoolWorker*)arg;
+    WC_CRYPTOCB_POOL*   pool = worker->pool;
+    WC_RNG*             rng = worker->haveRng ? &worker->rng : NULL;
+    CryptoCbPoolJob*    jobs[CRYPTOCB_POOL_MAX_BATCH];
+    wc_CryptoInfo*      ops[CRYPTOCB_POOL_MAX_BATCH];
+    int                 rets[CRYPTOCB_POOL_MAX_BATCH];
+    int                 batchDevId;
+    int                 count;
+    int                 ret;
+    int                 i;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->workHead == NULL)
+            pthread_cond_wait(&pool->cond, &pool->lock);
+        if (pool->workHead == NULL) {
+            /* stopping with nothing left to do */
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        batchDevId = pool->batchDevId;
+        count = CryptoCbPoolTake(pool, jobs);
+        pthread_mutex_unlock(&pool->lock);
+
+        ret = CRYPTOCB_UNAVAILABLE;
+        for (i = 0; i < count; i++)
+            rets[i] = CRYPTOCB_UNAVAILABLE;
+        if (batchDevId != INVALID_DEVID) {
+            for (i = 0; i < count; i++) {
+                CryptoCbPoolSetRng(&jobs[i]->info, rng);
+                ops[i] = &jobs[i]->info;
+            }
+            ret = wc_CryptoCb_PkBatch(batchDevId, jobs[0]->info.pk.type, ops,
+                                      rets, count);
+        }
+        for (i = 0; i < count; i++) {
+            if (ret != 0)
+                rets[i] = ret;
+            /* what the device didn't do is done in software */
+            if (rets[i] == CRYPTOCB_UNAVAILABLE)
+                rets[i] = CryptoCbPoolRun(&jobs[i]->info, rng);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        for (i = 0; i < count; i++) {
+            jobs[i]->event.ret = rets[i];
+            jobs[i]->event.state = WOLF_EVENT_STATE_DONE;
+            if (wolfEventQueue_Push(&pool->done, &jobs[i]->event) == 0)
+                jobs[i]->queued = 1;
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+/* Take job out of its row and the done queue. Pool is locked. */
+static void CryptoCbPoolUnlink(WC_CRYPTOCB_POOL* pool, CryptoCbPoolJob** link)
+{
+    CryptoCbPoolJob* job = *link;
+
+    *link = job->next;
+    job->next = NULL;
+    if (job->queued) {
+        if (wc_LockMutex(&pool->done.lock) == 0) {
+            wolfEventQueue_Remove(&pool->done, &job->event);
+            wc_UnLockMutex(&pool->done.lock);
+        }
+        job->queued = 0;
+    }
+}
+
+static int CryptoCbPoolCb(int devId, wc_CryptoInfo* info, void* ctx)
+{
+    WC_CRYPTOCB_POOL* pool = (WC_CRYPTOCB_POOL*)ctx;
+    CryptoCbPoolJob** link;
+    CryptoCbPoolJob*  job;
+    const void*       key = NULL;
+    const void*       out = NULL;
+    int               ret;
+
+    (void)devId;
+
+    if (pool == NULL || info->algo_type != WC_ALGO_TYPE_PK)
+        return CRYPTOCB_UNAVAILABLE;
+    /* on a worker the operation is done in software */
+    if (CryptoCbPoolIsWorker(pool))
+        return CRYPTOCB_UNAVAILABLE;
+    if (CryptoCbPoolJobKey(info, &key, &out) != 0)
+        return CRYPTOCB_UNAVAILABLE;
+
+    if (pthread_mutex_lock(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+
+    link = &pool->rows[CryptoCbPoolRow(key)];
+    while (*link != NULL && (*link)->key != key)
+        link = &(*link)->next;
+
+    job = *link;
+    if (job != NULL) {
+        if (job->event.state == WOLF_EVENT_STATE_PENDING) {
+            if (job->out == out && job->info.pk.type == info->pk.type)
+                ret = WC_PENDING_E;     /* called again too soon */
+            else
+                ret = BAD_STATE_E;      /* key is busy with another one */
+            pthread_mutex_unlock(&pool->lock);
+            return ret;
+        }
+
+        CryptoCbPoolUnlink(pool, link);
+        if (job->out == out && job->info.pk.type == info->pk.type) {
+            /* the call again after completion */
+            ret = job->event.ret;
+        #ifndef NO_RSA
+            if (info->pk.type == WC_PK_TYPE_RSA)
+                *info->pk.rsa.outLen = job->outLen;
+        #endif
+            pthread_mutex_unlock(&pool->lock);
+            XFREE(job, pool->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            return ret;
+        }
+        /* result never collected, drop it */
+        XFREE(job, pool->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+
+    job = (CryptoCbPoolJob*)XMALLOC(sizeof(CryptoCbPoolJob), pool->heap,
+                                    DYNAMIC_TYPE_TMP_BUFFER);
+    if (job == NULL) {
+        pthread_mutex_unlock(&pool->lock);
+        return MEMORY_E;
+    }
+    XMEMSET(job, 0, sizeof(CryptoCbPoolJob));
+    wolfEvent_Init(&job->event, WOLF_EVENT_TYPE_CRYPTOCB_POOL, (void*)key);
+    job->event.state = WOLF_EVENT_STATE_PENDING;
+    XMEMCPY(&job->info, info, sizeof(wc_CryptoInfo));
+    job->key = key;
+    job->out = out;
+#ifndef NO_RSA
+    if (info->pk.type == WC_PK_TYPE_RSA) {
+        /* the RSA state machine sets its length again when calling back */
+        job->outLen = *info->pk.rsa.outLen;
+        job->info.pk.rsa.outLen = &job->outLen;
+    }
+#endif
+
+    job->next = pool->rows[CryptoCbPoolRow(key)];
+    pool->rows[CryptoCbPoolRow(key)] = job;
+    if (pool->workTail != NULL)
+        pool->workTail->work = job;
+    else
+        pool->workHead = job;
+    pool->workTail = job;
+
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    return WC_PENDING_E;
+}
+
+static void CryptoCbPoolFreeJobs(WC_CRYPTOCB_POOL* pool)
+{
+    CryptoCbPoolJob* job;
+    int i;
+
+    for (i = 0; i < CRYPTOCB_POOL_ROWS; i++) {
+        while ((job = pool->rows[i]) != NULL) {
+            pool->rows[i] = job->next;
+            XFREE(job, pool->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        }
+    }
+}
+
+
+/* Create a pool of threads workers and register it as device devId.
+ * Returns NULL on failure. */
+WC_CRYPTOCB_POOL* wc_CryptoCb_PoolNew(int devId, int threads, void* heap)
+{
+    WC_CRYPTOCB_POOL* pool;
+    int ret = 0;
+    int i;
+
+    WOLFSSL_ENTER("wc_CryptoCb_PoolNew");
+
+    if (devId == INVALID_DEVID || threads <= 0 ||
+                                         threads > CRYPTOCB_POOL_MAX_THREADS)
+        return NULL;
+
+    pool = (WC_CRYPTOCB_POOL*)XMALLOC(sizeof(WC_CRYPTOCB_POOL), heap,
+                                      DYNAMIC_TYPE_TMP_BUFFER);
+    if (pool == NULL)
+        return NULL;
+    XMEMSET(pool, 0, sizeof(WC_CRYPTOCB_POOL));
+    pool->heap       = heap;
+    pool->devId      = devId;
+    pool->threads    = threads;
+    pool->batchDevId = INVALID_DEVID;
+
+    pool->workers = (CryptoCbPoolWorker*)XMALLOC(
+            sizeof(CryptoCbPoolWorker) * threads, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (pool->workers == NULL) {
+        XFREE(pool, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return NULL;
+    }
+    XMEMSET(pool->workers, 0, sizeof(CryptoCbPoolWorker) * threads);
+
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        XFREE(pool->workers, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(pool, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return NULL;
+    }
+    if (pthread_cond_init(&pool->cond, NULL) != 0) {
+        pthread_mutex_destroy(&pool->lock);
+        XFREE(pool->workers, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(pool, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return NULL;
+    }
+    if (wolfEventQueue_Init(&pool->done) != 0) {
+        pthread_cond_destroy(&pool->cond);
+        pthread_mutex_destroy(&pool->lock);
+        XFREE(pool->workers, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(pool, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return NULL;
+    }
+
+    for (i = 0; ret == 0 && i < threads; i++) {
+        CryptoCbPoolWorker* worker = &pool->workers[i];
+
+        worker->pool = pool;
+        ret = wc_InitRng_ex(&worker->rng, heap, INVALID_DEVID);
+        if (ret == 0) {
+            worker->haveRng = 1;
+            if (pthread_create(&worker->tid, NULL, CryptoCbPoolThread,
+                                                                worker) != 0)
+                ret = WC_INIT_E;
+            else
+                worker->started = 1;
+        }
+    }
+    if (ret == 0)
+        ret = wc_CryptoCb_RegisterDevice(devId, CryptoCbPoolCb, pool);
+
+    if (ret != 0) {
+        WOLFSSL_MSG("Crypto callback pool setup failed");
+        wc_CryptoCb_PoolFree(pool);
+        pool = NULL;
+    }
+
+    WOLFSSL_LEAVE("wc_CryptoCb_PoolNew", ret);
+
+    return pool;
+}
+
+/* Stop the workers, unregister the device and free the pool. Operations
+ * still queued are not run. */
+void wc_CryptoCb_PoolFree(WC_CRYPTOCB_POOL* pool)
+{
+    int i;
+
+    if (pool == NULL)
+        return;
+
+    WOLFSSL_ENTER("wc_CryptoCb_PoolFree");
+
+    if (wc_CryptoCb_FindDevice(pool->devId) != NULL &&
+            wc_CryptoCb_FindDevice(pool->devId)->ctx == pool)
+        wc_CryptoCb_UnRegisterDevice(pool->devId);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pool->workHead = NULL;
+    pool->workTail = NULL;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->threads; i++) {
+        if (pool->workers[i].started)
+            pthread_join(pool->workers[i].tid, NULL);
+        if (pool->workers[i].haveRng)
+            wc_FreeRng(&pool->workers[i].rng);
+    }
+
+    CryptoCbPoolFreeJobs(pool);
+    wolfEventQueue_Free(&pool->done);
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+    XFREE(pool->workers, pool->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(pool, pool->heap, DYNAMIC_TYPE_TMP_BUFFER);
+}
+
+/* Get up to maxEvents completed operations, each event's context is the key
+ * and ret is the result. Events are valid until the operation is called
+ * again. */
+int wc_CryptoCb_PoolPoll(WC_CRYPTOCB_POOL* pool, WOLF_EVENT** events,
+                         int maxEvents, int* eventCount)
+{
+    int count = 0;
+    int ret;
+    int i;
+
+    if (pool == NULL || events == NULL || maxEvents <= 0 ||
+                                                         eventCount == NULL)
+        return BAD_FUNC_ARG;
+
+    if (pthread_mutex_lock(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+
+    ret = wolfEventQueue_Poll(&pool->done, NULL, events, maxEvents, 0,
+                              &count);
+    for (i = 0; i < count; i++)
+        ((CryptoCbPoolJob*)events[i])->queued = 0;
+    pthread_mutex_unlock(&pool->lock);
+
+    *eventCount = count;
+
+    return ret;
+}
+
+/* Have workers give queued operations of the same type, up to maxBatch, to
+ * device devId in one call. INVALID_DEVID turns it off. */
+int wc_CryptoCb_PoolSetBatch(WC_CRYPTOCB_POOL* pool, int devId, int maxBatch)
+{
+    if (pool == NULL || devId == pool->devId)
+        return BAD_FUNC_ARG;
+    if (devId != INVALID_DEVID &&
+                      (maxBatch <= 0 || maxBatch > CRYPTOCB_POOL_MAX_BATCH))
+        return BAD_FUNC_ARG;
+
+    if (pthread_mutex_lock(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    pool->batchDevId = devId;
+    pool->maxBatch   = maxBatch;
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+/* Returns 1 when devId is registered to a pool */
+int wc_CryptoCb_PoolIsDevice(int devId)
+{
+    CryptoCb* dev;
+
+    if (devId == INVALID_DEVID)
+        return 0;
+
+    dev = wc_CryptoCb_FindDevice(devId);
+    return (dev != NULL && dev->cb == CryptoCbPoolCb);
+}
+#endif /* WOLF_CRYPTO_CB_POOL */
+
 #endif /* WOLF_CRYPTO_CB */
@@ -3834,7 +3834,10 @@ int wc_ecc_shared_secret(ecc_key* private_key, ecc_key* public_key, byte* out,
 #elif defined(WOLFSSL_SILABS_SE_ACCEL)
     err = silabs_ecc_shared_secret(private_key, public_key, out, outlen);
 #else
+   WC_USDT_PROBE2(ecc__shared__secret__start, private_key,
+                  private_key->dp->id);
    err = wc_ecc_shared_secret_ex(private_key, &public_key->pubkey, out, outlen);
+   WC_USDT_PROBE2(ecc__shared__secret__done, private_key, err);
 #endif /* WOLFSSL_ATECC508A */
 
    return err;
@@ -4665,7 +4668,13 @@ int wc_ecc_make_key_ex2(WC_RNG* rng, int keysize, ecc_key* key, int curve_id,
 WOLFSSL_ABI
 int wc_ecc_make_key_ex(WC_RNG* rng, int keysize, ecc_key* key, int curve_id)
 {
-    return wc_ecc_make_key_ex2(rng, keysize, key, curve_id, WC_ECC_FLAG_NONE);
+    int err;
+
+    WC_USDT_PROBE2(ecc__make__key__start, key, curve_id);
+    err = wc_ecc_make_key_ex2(rng, keysize, key, curve_id, WC_ECC_FLAG_NONE);
+    WC_USDT_PROBE2(ecc__make__key__done, key, err);
+
+    return err;
 }
 
 #ifdef ECC_DUMP_OID
@@ -5142,7 +5151,9 @@ int wc_ecc_sign_hash(const byte* in, word32 inlen, byte* out, word32 *outlen,
 
 #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_ECC)
     /* handle async cases */
+    WC_USDT_PROBE2(ecc__sign__start, key, inlen);
     err = wc_ecc_sign_hash_async(in, inlen, out, outlen, rng, key);
+    WC_USDT_PROBE2(ecc__sign__done, key, err);
 #else
 
 #ifdef WOLFSSL_SMALL_STACK
@@ -5166,6 +5177,7 @@ int wc_ecc_sign_hash(const byte* in, word32 inlen, byte* out, word32 *outlen,
         return err;
     }
 
+    WC_USDT_PROBE2(ecc__sign__start, key, inlen);
 /* hardware crypto */
 #if defined(WOLFSSL_ATECC508A) || defined(WOLFSSL_ATECC608A) || \
     defined(PLUTON_CRYPTO_ECC) || defined(WOLFSSL_CRYPTOCELL) || \
@@ -5174,6 +5186,7 @@ int wc_ecc_sign_hash(const byte* in, word32 inlen, byte* out, word32 *outlen,
 #else
     err = wc_ecc_sign_hash_ex(in, inlen, rng, key, r, s);
 #endif
+    WC_USDT_PROBE2(ecc__sign__done, key, err);
     if (err < 0) {
         mp_clear(r);
         mp_clear(s);
@@ -6267,7 +6280,9 @@ int wc_ecc_verify_hash(const byte* sig, word32 siglen, const byte* hash,
         case ECC_STATE_VERIFY_DO:
             key->state = ECC_STATE_VERIFY_DO;
 
+            WC_USDT_PROBE2(ecc__verify__start, key, hashlen);
             err = wc_ecc_verify_hash_ex(r, s, hash, hashlen, res, key);
+            WC_USDT_PROBE2(ecc__verify__done, key, err);
 
         #ifndef WOLFSSL_ASYNC_CRYPT
             /* done with R/S */
@@ -571,6 +571,58 @@ static int wolfSSL_EVP_CipherUpdate_GCM_AAD(WOLFSSL_EVP_CIPHER_CTX *ctx,
     return 0;
 }
 
+#ifdef WOLFSSL_AESGCM_STREAM
+/* Start the incremental AES-GCM operation with the IV on first use. */
+static int wolfSSL_EVP_CipherStart_GCM(WOLFSSL_EVP_CIPHER_CTX *ctx)
+{
+    int ret = 0;
+
+    if (!ctx->gcmStreamInit) {
+        ret = wc_AesGcmInit(&ctx->cipher.aes, NULL, 0, ctx->iv,
+                            (word32)ctx->ivSz);
+        if (ret == 0)
+            ctx->gcmStreamInit = 1;
+    }
+
+    return ret;
+}
+
+static int wolfSSL_EVP_CipherUpdate_GCM(WOLFSSL_EVP_CIPHER_CTX *ctx,
+                                   unsigned char *out, int *outl,
+                                   const unsigned char *in, int inl)
+{
+    int ret;
+
+    *outl = 0;
+    ret = wolfSSL_EVP_CipherStart_GCM(ctx);
+    if (ret == 0) {
+        if (out == NULL) {
+            /* in/inl is additional authenticated data */
+            if (ctx->enc)
+                ret = wc_AesGcmEncryptUpdate(&ctx->cipher.aes, NULL, NULL, 0,
+                                             in, (word32)inl);
+            else
+                ret = wc_AesGcmDecryptUpdate(&ctx->cipher.aes, NULL, NULL, 0,
+                                             in, (word32)inl);
+        }
+        else if (ctx->enc) {
+            ret = wc_AesGcmEncryptUpdate(&ctx->cipher.aes, out, in,
+                                         (word32)inl, NULL, 0);
+        }
+        else {
+            ret = wc_AesGcmDecryptUpdate(&ctx->cipher.aes, out, in,
+                                         (word32)inl, NULL, 0);
+        }
+    }
+
+    if (ret != 0)
+        return WOLFSSL_FAILURE;
+
+    if (out != NULL)
+        *outl = inl;
+    return WOLFSSL_SUCCESS;
+}
+#else
 static int wolfSSL_EVP_CipherUpdate_GCM(WOLFSSL_EVP_CIPHER_CTX *ctx,
                                    unsigned char *out, int *outl,
                                    const unsigned char *in, int inl)
@@ -607,6 +659,7 @@ static int wolfSSL_EVP_CipherUpdate_GCM(WOLFSSL_EVP_CIPHER_CTX *ctx,
 
     return WOLFSSL_SUCCESS;
 }
+#endif /* WOLFSSL_AESGCM_STREAM */
 #endif
 
 /* returns WOLFSSL_SUCCESS on success and WOLFSSL_FAILURE on failure */
@@ -770,6 +823,20 @@ int  wolfSSL_EVP_CipherFinal(WOLFSSL_EVP_CIPHER_CTX *ctx,
         case AES_128_GCM_TYPE:
         case AES_192_GCM_TYPE:
         case AES_256_GCM_TYPE:
+        #ifdef WOLFSSL_AESGCM_STREAM
+            ret = wolfSSL_EVP_CipherStart_GCM(ctx);
+            if (ret == 0) {
+                if (ctx->enc)
+                    ret = wc_AesGcmEncryptFinal(&ctx->cipher.aes, ctx->authTag,
+                                                (word32)ctx->authTagSz);
+                else
+                    ret = wc_AesGcmDecryptFinal(&ctx->cipher.aes, ctx->authTag,
+                                                (word32)ctx->authTagSz);
+            }
+            ret = (ret == 0) ? WOLFSSL_SUCCESS : WOLFSSL_FAILURE;
+            *outl = 0;
+            ctx->gcmStreamInit = 0;
+        #else
             if ((ctx->gcmBuffer && ctx->gcmBufferLen > 0)
              || (ctx->gcmBufferLen == 0)) {
                 if (ctx->enc)
@@ -799,6 +866,7 @@ int  wolfSSL_EVP_CipherFinal(WOLFSSL_EVP_CIPHER_CTX *ctx,
             else {
                 *outl = 0;
             }
+        #endif /* WOLFSSL_AESGCM_STREAM */
             /* Clear IV, since IV reuse is not recommended for AES GCM. */
             XMEMSET(ctx->iv, 0, AES_BLOCK_SIZE);
             break;
@@ -4123,6 +4191,9 @@ int wolfSSL_EVP_MD_type(const WOLFSSL_EVP_MD *md)
                 ctx->gcmAuthIn = NULL;
             }
             ctx->gcmAuthInSz = 0;
+    #ifdef WOLFSSL_AESGCM_STREAM
+            ctx->gcmStreamInit = 0;
+    #endif
 #endif
         }
 
@@ -4273,6 +4344,9 @@ int wolfSSL_EVP_MD_type(const WOLFSSL_EVP_MD *md)
             ctx->gcmAuthIn = NULL;
         }
         ctx->gcmAuthInSz = 0;
+    #ifdef WOLFSSL_AESGCM_STREAM
+        ctx->gcmStreamInit = 0;
+    #endif
 #endif
 
 #ifndef NO_AES
@@ -51,6 +51,7 @@ Possible memory options:
  * WOLFSSL_MALLOC_CHECK:            Reports malloc or alignment failure using WOLFSSL_STATIC_ALIGN
  * WOLFSSL_FORCE_MALLOC_FAIL_TEST:  Used for internal testing to induce random malloc failures.
  * WOLFSSL_HEAP_TEST:               Used for internal testing of heap hint
+ * WOLFSSL_MEM_TYPE_STATS:          Counts live bytes and allocations per DYNAMIC_TYPE and WOLFSSL_CTX.
  */
 
 #ifdef WOLFSSL_ZEPHYR
@@ -89,7 +90,7 @@ void *z_realloc(void *ptr, size_t size)
     }
 #endif
 #if defined(WOLFSSL_MALLOC_CHECK) || defined(WOLFSSL_TRACK_MEMORY_FULL) || \
-                                                     defined(WOLFSSL_MEMORY_LOG)
+    defined(WOLFSSL_MEMORY_LOG) || defined(WOLFSSL_MEM_TYPE_STATS)
     #include <stdio.h>
 #endif
 
@@ -236,6 +237,282 @@ void* wolfSSL_Realloc(void *ptr, size_t size)
 }
 #endif /* WOLFSSL_STATIC_MEMORY */
 
+#ifdef WOLFSSL_MEM_TYPE_STATS
+/* Each allocation is prefixed with a header holding its size, type and
+ * owner so the free can take it off the right counters. The header keeps
+ * the alignment malloc gives. */
+#define MEM_STATS_HDR_SZ 16
+
+typedef struct MemStatsHdr {
+    size_t size;
+    word16 type;
+    word16 owner;
+    word32 gen;   /* owner's generation when allocated */
+} MemStatsHdr;
+
+#ifdef SINGLE_THREADED
+    #define MEM_ATOMIC_ADD(p, n)  (*(p) += (n))
+    #define MEM_ATOMIC_SUB(p, n)  (*(p) -= (n))
+    #define MEM_ATOMIC_LOAD(p)    (*(p))
+    #define MEM_ATOMIC_INC(p)     (++(*(p)))
+#elif defined(__GNUC__)
+    #define MEM_ATOMIC_ADD(p, n)  \
+        __atomic_add_fetch((p), (word64)(n), __ATOMIC_RELAXED)
+    #define MEM_ATOMIC_SUB(p, n)  \
+        __atomic_sub_fetch((p), (word64)(n), __ATOMIC_RELAXED)
+    #define MEM_ATOMIC_LOAD(p)    __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define MEM_ATOMIC_INC(p)     __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+    #define MEM_ATOMIC_ADD(p, n)  \
+        ((word64)InterlockedExchangeAdd64((LONG64*)(p), (LONG64)(n)) + (n))
+    #define MEM_ATOMIC_SUB(p, n)  \
+        ((word64)InterlockedExchangeAdd64((LONG64*)(p), -(LONG64)(n)) - (n))
+    #define MEM_ATOMIC_LOAD(p)    \
+        ((word64)InterlockedCompareExchange64((LONG64*)(p), 0, 0))
+    #define MEM_ATOMIC_INC(p)     ((word64)InterlockedIncrement64((LONG64*)(p)))
+#else
+    #error WOLFSSL_MEM_TYPE_STATS needs atomic operations or SINGLE_THREADED
+#endif
+
+static WC_MEM_TYPE_STATS memStats[WC_MEM_STATS_OWNERS][WC_MEM_TYPE_COUNT];
+/* bumped when an owner is freed, so memory it left behind is not taken off
+ * the next CTX given the same owner */
+static word32 memStatsGen[WC_MEM_STATS_OWNERS];
+static byte   memStatsUsed[WC_MEM_STATS_OWNERS];
+/* owner charged for allocations made on this thread */
+static THREAD_LS_T int memStatsOwner = 0;
+
+static const char* const memStatsTypeName[WC_MEM_TYPE_COUNT] = {
+    "OTHER", "CA", "CERT", "KEY", "FILE", "SUBJECT_CN", "PUBLIC_KEY", "SIGNER",
+    "NONE", "BIGINT", "RSA", "METHOD", "OUT_BUFFER", "IN_BUFFER", "INFO", "DH",
+    "DOMAIN", "SSL", "CTX", "WRITEV", "OPENSSL", "DSA", "CRL", "REVOKED",
+    "CRL_ENTRY", "CERT_MANAGER", "CRL_MONITOR", "OCSP_STATUS", "OCSP_ENTRY",
+    "ALTNAME", "SUITES", "CIPHER", "RNG", "ARRAYS", "DTLS_POOL", "SOCKADDR",
+    "LIBZ", "ECC", "TMP_BUFFER", "DTLS_MSG", "X509", "TLSX", "OCSP",
+    "SIGNATURE", "HASHES", "SRP", "COOKIE_PWD", "USER_CRYPTO", "OCSP_REQUEST",
+    "X509_EXT", "X509_STORE", "X509_CTX", "URL", "DTLS_FRAG", "DTLS_BUFFER",
+    "SESSION_TICK", "PKCS", "MUTEX", "PKCS7", "AES_BUFFER", "WOLF_BIGINT",
+    "ASN1", "LOG", "WRITEDUP", "PRIVATE_KEY", "HMAC", "ASYNC", "ASYNC_NUMA",
+    "ASYNC_NUMA64", "CURVE25519", "ED25519", "SECRET", "DIGEST", "RSA_BUFFER",
+    "DCERT", "STRING", "PEM", "DER", "CERT_EXT", "ALPN", "ENCRYPTEDINFO",
+    "DIRCTX", "HASHCTX", "SEED", "SYMMETRIC_KEY", "ECC_BUFFER", "QSH", "SALT",
+    "HASH_TMP", "BLOB", "NAME_ENTRY", "CURVE448", "ED448", "AES", "CMAC",
+    "HS_ARENA"
+};
+
+static void MemStatsPeak(word64* peak, word64 cur)
+{
+#if defined(SINGLE_THREADED)
+    if (cur > *peak)
+        *peak = cur;
+#elif defined(__GNUC__)
+    word64 old = __atomic_load_n(peak, __ATOMIC_RELAXED);
+
+    while (cur > old && !__atomic_compare_exchange_n(peak, &old, cur, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+#else
+    word64 old = MEM_ATOMIC_LOAD(peak);
+
+    while (cur > old) {
+        word64 seen = (word64)InterlockedCompareExchange64((LONG64*)peak,
+                                                  (LONG64)cur, (LONG64)old);
+        if (seen == old)
+            break;
+        old = seen;
+    }
+#endif
+}
+
+static void MemStatsAdd(WC_MEM_TYPE_STATS* stats, size_t size)
+{
+    MemStatsPeak(&stats->peakBytes, MEM_ATOMIC_ADD(&stats->curBytes, size));
+    MEM_ATOMIC_INC(&stats->curAllocs);
+    MEM_ATOMIC_INC(&stats->totalAllocs);
+}
+
+static void MemStatsSub(WC_MEM_TYPE_STATS* stats, size_t size)
+{
+    MEM_ATOMIC_SUB(&stats->curBytes, size);
+    MEM_ATOMIC_SUB(&stats->curAllocs, 1);
+}
+
+static void* MemStatsTrack(byte* mem, size_t size, int type)
+{
+    MemStatsHdr* hdr = (MemStatsHdr*)mem;
+    int          owner = memStatsOwner;
+
+    if (type <= 0 || type >= WC_MEM_TYPE_COUNT)
+        type = 0;
+    hdr->size  = size;
+    hdr->type  = (word16)type;
+    hdr->owner = (word16)owner;
+    hdr->gen   = memStatsGen[owner];
+
+    MemStatsAdd(&memStats[0][type], size);
+    if (owner != 0)
+        MemStatsAdd(&memStats[owner][type], size);
+
+    return mem + MEM_STATS_HDR_SZ;
+}
+
+static void MemStatsUntrack(const MemStatsHdr* hdr)
+{
+    MemStatsSub(&memStats[0][hdr->type], hdr->size);
+    if (hdr->owner != 0 && hdr->gen == memStatsGen[hdr->owner])
+        MemStatsSub(&memStats[hdr->owner][hdr->type], hdr->size);
+}
+
+void* wc_MemStatsMalloc(size_t size, void* heap, int type)
+{
+    byte* mem;
+
+    (void)heap;
+
+    mem = (byte*)wolfSSL_Malloc(size + MEM_STATS_HDR_SZ);
+    if (mem == NULL)
+        return NULL;
+
+    return MemStatsTrack(mem, size, type);
+}
+
+void wc_MemStatsFree(void *ptr, void* heap, int type)
+{
+    byte* mem;
+
+    (void)heap;
+    (void)type; /* counted against the type it was allocated with */
+
+    if (ptr != NULL) {
+        mem = (byte*)ptr - MEM_STATS_HDR_SZ;
+        MemStatsUntrack((MemStatsHdr*)mem);
+        wolfSSL_Free(mem);
+    }
+}
+
+void* wc_MemStatsRealloc(void *ptr, size_t size, void* heap, int type)
+{
+    byte*       mem = NULL;
+    byte*       res;
+    MemStatsHdr old;
+
+    (void)heap;
+
+    if (ptr != NULL) {
+        mem = (byte*)ptr - MEM_STATS_HDR_SZ;
+        XMEMCPY(&old, mem, sizeof(old));
+    }
+
+    /* on failure the old block is left as it was, still counted */
+    res = (byte*)wolfSSL_Realloc(mem, size + MEM_STATS_HDR_SZ);
+    if (res == NULL)
+        return NULL;
+
+    if (mem != NULL)
+        MemStatsUntrack(&old);
+    return MemStatsTrack(res, size, type);
+}
+
+/* Get the counters of type for owner, 0 for the whole library. */
+int wc_MemStatsGet(int owner, int type, WC_MEM_TYPE_STATS* stats)
+{
+    WC_MEM_TYPE_STATS* c;
+
+    if (stats == NULL || owner < 0 || owner >= WC_MEM_STATS_OWNERS ||
+            type < 0 || type >= WC_MEM_TYPE_COUNT)
+        return BAD_FUNC_ARG;
+
+    c = &memStats[owner][type];
+    stats->curBytes    = MEM_ATOMIC_LOAD(&c->curBytes);
+    stats->peakBytes   = MEM_ATOMIC_LOAD(&c->peakBytes);
+    stats->curAllocs   = MEM_ATOMIC_LOAD(&c->curAllocs);
+    stats->totalAllocs = MEM_ATOMIC_LOAD(&c->totalAllocs);
+
+    return 0;
+}
+
+/* Hand out a free owner with its counters cleared, 0 if all are in use. */
+int wc_MemStatsNewOwner(void)
+{
+    int owner;
+
+    for (owner = 1; owner < WC_MEM_STATS_OWNERS; owner++) {
+    #if defined(SINGLE_THREADED)
+        if (memStatsUsed[owner] == 0) {
+            memStatsUsed[owner] = 1;
+    #elif defined(__GNUC__)
+        if (__atomic_exchange_n(&memStatsUsed[owner], 1,
+                                                     __ATOMIC_ACQ_REL) == 0) {
+    #else
+        if (InterlockedExchange8((char*)&memStatsUsed[owner], 1) == 0) {
+    #endif
+            XMEMSET(memStats[owner], 0, sizeof(memStats[owner]));
+            return owner;
+        }
+    }
+
+    return 0;
+}
+
+/* Give back owner, memory it still has is only counted for the library. */
+void wc_MemStatsFreeOwner(int owner)
+{
+    if (owner <= 0 || owner >= WC_MEM_STATS_OWNERS)
+        return;
+
+    if (memStatsOwner == owner)
+        memStatsOwner = 0;
+    memStatsGen[owner]++;
+#if defined(SINGLE_THREADED)
+    memStatsUsed[owner] = 0;
+#elif defined(__GNUC__)
+    __atomic_store_n(&memStatsUsed[owner], 0, __ATOMIC_RELEASE);
+#else
+    InterlockedExchange8((char*)&memStatsUsed[owner], 0);
+#endif
+}
+
+/* Charge this thread's allocations to owner from now on, returns the
+ * previous owner. */
+int wc_MemStatsSetOwner(int owner)
+{
+    int prev = memStatsOwner;
+
+    if (owner < 0 || owner >= WC_MEM_STATS_OWNERS)
+        owner = 0;
+    memStatsOwner = owner;
+
+    return prev;
+}
+
+#if !defined(NO_FILESYSTEM) && !defined(NO_STDIO_FILESYSTEM)
+/* Print the types owner has allocated, 0 for the whole library. */
+void wc_MemStatsPrint(int owner)
+{
+    WC_MEM_TYPE_STATS stats;
+    word64 curBytes = 0, peakBytes = 0;
+    int    type;
+
+    printf("%-14s %12s %12s %10s %12s\n", "type", "cur bytes",
+           "peak bytes", "cur allocs", "total allocs");
+    for (type = 0; type < WC_MEM_TYPE_COUNT; type++) {
+        if (wc_MemStatsGet(owner, type, &stats) != 0 ||
+                                                   stats.totalAllocs == 0)
+            continue;
+        printf("%-14s %12llu %12llu %10llu %12llu\n", memStatsTypeName[type],
+               (unsigned long long)stats.curBytes,
+               (unsigned long long)stats.peakBytes,
+               (unsigned long long)stats.curAllocs,
+               (unsigned long long)stats.totalAllocs);
+        curBytes  += stats.curBytes;
+        peakBytes += stats.peakBytes;
+    }
+    printf("%-14s %12llu %12llu\n", "total", (unsigned long long)curBytes,
+           (unsigned long long)peakBytes);
+}
+#endif
+#endif /* WOLFSSL_MEM_TYPE_STATS */
+
 #ifdef WOLFSSL_STATIC_MEMORY
 
 struct wc_Memory {
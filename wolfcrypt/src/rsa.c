@@ -2551,6 +2551,15 @@ static int wc_RsaFunctionAsync(const byte* in, word32 inLen, byte* out,
 }
 #endif /* WOLFSSL_ASYNC_CRYPT && WC_ASYNC_ENABLE_RSA */
 
+#ifdef WOLF_CRYPTO_CB_POOL
+    /* The crypto callback pool gives the result when the operation is
+     * called again, so stay in the state that calls it. */
+    #define RSA_PENDING_ADVANCES(key, ret) \
+        ((ret) == WC_PENDING_E && !wc_CryptoCb_PoolIsDevice((key)->devId))
+#else
+    #define RSA_PENDING_ADVANCES(key, ret) ((ret) == WC_PENDING_E)
+#endif
+
 #if defined(WC_RSA_DIRECT) || defined(WC_RSA_NO_PADDING)
 /* Function that does the RSA operation directly with no padding.
  *
@@ -2615,7 +2624,7 @@ int wc_RsaDirect(byte* in, word32 inLen, byte* out, word32* outSz,
             key->dataLen = *outSz;
 
             ret = wc_RsaFunction(in, inLen, out, &key->dataLen, type, key, rng);
-            if (ret >= 0 || ret == WC_PENDING_E) {
+            if (ret >= 0 || RSA_PENDING_ADVANCES(key, ret)) {
                 key->state = (type == RSA_PRIVATE_ENCRYPT ||
                     type == RSA_PUBLIC_ENCRYPT) ? RSA_STATE_ENCRYPT_RES:
                                                   RSA_STATE_DECRYPT_RES;
@@ -2819,6 +2828,7 @@ int wc_RsaFunction(const byte* in, word32 inLen, byte* out,
 #endif
 #endif
 
+    WC_USDT_PROBE3(rsa__function__start, key, type, inLen);
 #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_RSA)
     if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_RSA &&
                                                         key->n.raw.len > 0) {
@@ -2835,6 +2845,7 @@ int wc_RsaFunction(const byte* in, word32 inLen, byte* out,
     {
         ret = wc_RsaFunctionSync(in, inLen, out, outLen, type, key, rng);
     }
+    WC_USDT_PROBE2(rsa__function__done, key, ret);
 
     /* handle error */
     if (ret < 0 && ret != WC_PENDING_E
@@ -2956,7 +2967,7 @@ static int RsaPublicEncryptEx(const byte* in, word32 inLen, byte* out,
         key->dataLen = outLen;
         ret = wc_RsaFunction(out, sz, out, &key->dataLen, rsa_type, key, rng);
 
-        if (ret >= 0 || ret == WC_PENDING_E) {
+        if (ret >= 0 || RSA_PENDING_ADVANCES(key, ret)) {
             key->state = RSA_STATE_ENCRYPT_RES;
         }
         if (ret < 0) {
@@ -3098,7 +3109,7 @@ static int RsaPrivateDecryptEx(byte* in, word32 inLen, byte* out,
         ret = wc_RsaFunction(in, inLen, out, &key->dataLen, rsa_type, key, rng);
 #endif
 
-        if (ret >= 0 || ret == WC_PENDING_E) {
+        if (ret >= 0 || RSA_PENDING_ADVANCES(key, ret)) {
             key->state = RSA_STATE_DECRYPT_UNPAD;
         }
         if (ret < 0) {
@@ -339,6 +339,16 @@
     /* Software implementation */
     #define USE_SHA_SOFTWARE_IMPL
 
+    /* SHA extensions */
+    #ifdef USE_INTEL_SPEEDUP
+        #include <wolfssl/wolfcrypt/cpuid.h>
+    #endif
+    #if defined(USE_INTEL_SPEEDUP) && !defined(NO_INTEL_SHA) && \
+        defined(WC_HAVE_TARGET_ATTR)
+        #define HAVE_INTEL_SHA
+        #include <immintrin.h>
+    #endif
+
     static int InitSha(wc_Sha* sha)
     {
         int ret = 0;
@@ -483,6 +493,118 @@ static WC_INLINE void AddLength(wc_Sha* sha, word32 len)
     }
 #endif /* !USE_CUSTOM_SHA_TRANSFORM */
 
+#ifdef HAVE_INTEL_SHA
+    static int transform_check = 0;
+    static int Transform_Sha_ni = 0;
+
+    static void Sha_SetTransform(void)
+    {
+        if (transform_check)
+            return;
+
+        Transform_Sha_ni = IS_INTEL_SHA(cpuid_get_flags()) != 0;
+
+        transform_check = 1;
+    }
+
+    /* Next four message words from the previous sixteen: w0 to w3 hold
+     * W[i-16..i-13], W[i-12..i-9], W[i-8..i-5] and W[i-4..i-1]. */
+    #define SHA1_NI_SCHED(w0, w1, w2, w3)                                    \
+        _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), w3)
+
+    /* Four rounds on words w with round function f. The E input in ein is
+     * derived from A of four rounds back, kept in eout for the next call. */
+    #define SHA1_NI_RND4(ein, eout, w, f)                                    \
+        do {                                                                 \
+            ein  = _mm_sha1nexte_epu32(ein, w);                              \
+            eout = abcd;                                                     \
+            abcd = _mm_sha1rnds4_epu32(abcd, ein, f);                        \
+        } while (0)
+
+    /* Hash len bytes of message blocks with the SHA extensions. raw is set
+     * when data is the big-endian message, clear when the words have been
+     * byte reversed into sha->buffer already. */
+    static WC_TARGET_SHA_NI void Transform_Sha_SHANI(wc_Sha* sha,
+                                      const byte* data, word32 len, int raw)
+    {
+        const __m128i mask = raw ?
+            _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL) :
+            _mm_set_epi64x(0x0302010007060504ULL, 0x0b0a09080f0e0d0cULL);
+        __m128i abcd, e0, e1;
+        __m128i save_abcd, save_e;
+        __m128i w0, w1, w2, w3;
+
+        abcd = _mm_loadu_si128((const __m128i*)sha->digest);
+        abcd = _mm_shuffle_epi32(abcd, 0x1B);
+        e0   = _mm_set_epi32((int)sha->digest[4], 0, 0, 0);
+
+        for (; len >= WC_SHA_BLOCK_SIZE; len -= WC_SHA_BLOCK_SIZE) {
+            save_abcd = abcd;
+            save_e    = e0;
+
+            w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data + 0),
+                                  mask);
+            w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data + 1),
+                                  mask);
+            w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data + 2),
+                                  mask);
+            w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data + 3),
+                                  mask);
+
+            /* rounds 0 to 3 take E straight from the state */
+            e0   = _mm_add_epi32(e0, w0);
+            e1   = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+            SHA1_NI_RND4(e1, e0, w1, 0);
+            SHA1_NI_RND4(e0, e1, w2, 0);
+            SHA1_NI_RND4(e1, e0, w3, 0);
+            w0 = SHA1_NI_SCHED(w0, w1, w2, w3); SHA1_NI_RND4(e0, e1, w0, 0);
+
+            w1 = SHA1_NI_SCHED(w1, w2, w3, w0); SHA1_NI_RND4(e1, e0, w1, 1);
+            w2 = SHA1_NI_SCHED(w2, w3, w0, w1); SHA1_NI_RND4(e0, e1, w2, 1);
+            w3 = SHA1_NI_SCHED(w3, w0, w1, w2); SHA1_NI_RND4(e1, e0, w3, 1);
+            w0 = SHA1_NI_SCHED(w0, w1, w2, w3); SHA1_NI_RND4(e0, e1, w0, 1);
+            w1 = SHA1_NI_SCHED(w1, w2, w3, w0); SHA1_NI_RND4(e1, e0, w1, 1);
+
+            w2 = SHA1_NI_SCHED(w2, w3, w0, w1); SHA1_NI_RND4(e0, e1, w2, 2);
+            w3 = SHA1_NI_SCHED(w3, w0, w1, w2); SHA1_NI_RND4(e1, e0, w3, 2);
+            w0 = SHA1_NI_SCHED(w0, w1, w2, w3); SHA1_NI_RND4(e0, e1, w0, 2);
+            w1 = SHA1_NI_SCHED(w1, w2, w3, w0); SHA1_NI_RND4(e1, e0, w1, 2);
+            w2 = SHA1_NI_SCHED(w2, w3, w0, w1); SHA1_NI_RND4(e0, e1, w2, 2);
+
+            w3 = SHA1_NI_SCHED(w3, w0, w1, w2); SHA1_NI_RND4(e1, e0, w3, 3);
+            w0 = SHA1_NI_SCHED(w0, w1, w2, w3); SHA1_NI_RND4(e0, e1, w0, 3);
+            w1 = SHA1_NI_SCHED(w1, w2, w3, w0); SHA1_NI_RND4(e1, e0, w1, 3);
+            w2 = SHA1_NI_SCHED(w2, w3, w0, w1); SHA1_NI_RND4(e0, e1, w2, 3);
+            w3 = SHA1_NI_SCHED(w3, w0, w1, w2); SHA1_NI_RND4(e1, e0, w3, 3);
+
+            /* E of the next block from A of rounds 76 to 79 */
+            e0   = _mm_sha1nexte_epu32(e0, save_e);
+            abcd = _mm_add_epi32(abcd, save_abcd);
+
+            data += WC_SHA_BLOCK_SIZE;
+        }
+
+        abcd = _mm_shuffle_epi32(abcd, 0x1B);
+        _mm_storeu_si128((__m128i*)sha->digest, abcd);
+        sha->digest[4] = (word32)_mm_extract_epi32(e0, 3);
+    }
+
+    /* Blocks from sha->buffer are already in host word order. */
+    static WC_INLINE int Transform_Sha(wc_Sha* sha, const byte* data)
+    {
+        if (Transform_Sha_ni) {
+            SAVE_VECTOR_REGISTERS();
+            Transform_Sha_SHANI(sha, data, WC_SHA_BLOCK_SIZE, 0);
+            RESTORE_VECTOR_REGISTERS();
+            return 0;
+        }
+        return Transform(sha, data);
+    }
+    #undef  XTRANSFORM
+    #define XTRANSFORM(S,B)   Transform_Sha((S),(B))
+#endif /* HAVE_INTEL_SHA */
+
 
 int wc_InitSha_ex(wc_Sha* sha, void* heap, int devId)
 {
@@ -505,6 +627,11 @@ int wc_InitSha_ex(wc_Sha* sha, void* heap, int devId)
     if (ret != 0)
         return ret;
 
+#ifdef HAVE_INTEL_SHA
+    /* choose best Transform function under this runtime environment */
+    Sha_SetTransform();
+#endif
+
 #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_SHA)
     ret = wolfAsync_DevCtxInit(&sha->asyncDev, WOLFSSL_ASYNC_MARKER_SHA,
                                                             sha->heap, devId);
@@ -592,6 +719,17 @@ int wc_ShaUpdate(wc_Sha* sha, const byte* data, word32 len)
     }
 
     /* process blocks */
+#ifdef HAVE_INTEL_SHA
+    if (Transform_Sha_ni && len >= WC_SHA_BLOCK_SIZE) {
+        /* SHA extensions read the big-endian message in place */
+        blocksLen = len & ~(WC_SHA_BLOCK_SIZE-1);
+        SAVE_VECTOR_REGISTERS();
+        Transform_Sha_SHANI(sha, data, blocksLen, 1);
+        RESTORE_VECTOR_REGISTERS();
+        data += blocksLen;
+        len  -= blocksLen;
+    }
+#endif
 #ifdef XTRANSFORM_LEN
     /* get number of blocks */
     /* 64-1 = 0x3F (~ Inverted = 0xFFFFFFC0) */
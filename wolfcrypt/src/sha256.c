@@ -169,6 +169,17 @@ where 0 <= L < 2^64.
     #ifndef NO_AVX2_SUPPORT
         #define HAVE_INTEL_AVX2
     #endif
+
+    /* SHA extensions and the multi-buffer lanes */
+    #ifdef WC_HAVE_TARGET_ATTR
+        #include <immintrin.h>
+        #ifndef NO_INTEL_SHA
+            #define HAVE_INTEL_SHA
+        #endif
+        #if defined(WOLFSSL_SHA256_MULTI_BUFFER) && defined(HAVE_INTEL_AVX2)
+            #define HAVE_INTEL_SHA256_MB
+        #endif
+    #endif
 #endif /* USE_INTEL_SPEEDUP */
 
 #if defined(HAVE_INTEL_AVX2)
@@ -306,6 +317,12 @@ static int InitSha256(wc_Sha256* sha256)
     }  /* extern "C" */
 #endif
 
+    #ifdef HAVE_INTEL_SHA
+        static int Transform_Sha256_SHANI(wc_Sha256* sha256, const byte* data);
+        static int Transform_Sha256_SHANI_Len(wc_Sha256* sha256,
+                                              const byte* data, word32 len);
+    #endif
+
     static int (*Transform_Sha256_p)(wc_Sha256* sha256, const byte* data);
                                                        /* = _Transform_Sha256 */
     static int (*Transform_Sha256_Len_p)(wc_Sha256* sha256, const byte* data,
@@ -345,6 +362,14 @@ static int InitSha256(wc_Sha256* sha256)
 
         intel_flags = cpuid_get_flags();
 
+    #ifdef HAVE_INTEL_SHA
+        if (IS_INTEL_SHA(intel_flags)) {
+            Transform_Sha256_p = Transform_Sha256_SHANI;
+            Transform_Sha256_Len_p = Transform_Sha256_SHANI_Len;
+            Transform_Sha256_is_vectorized = 1;
+        }
+        else
+    #endif
     #ifdef HAVE_INTEL_AVX2
         if (1 && IS_INTEL_AVX2(intel_flags)) {
         #ifdef HAVE_INTEL_RORX
@@ -939,6 +964,463 @@ static int InitSha256(wc_Sha256* sha256)
 /* End wc_ software implementation */
 
 
+#ifdef HAVE_INTEL_SHA
+    /* Next four message words from the previous sixteen: w0 to w3 hold
+     * W[i-16..i-13], W[i-12..i-9], W[i-8..i-5] and W[i-4..i-1]. */
+    #define SHA256_NI_SCHED(w0, w1, w2, w3)                                  \
+        _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1),      \
+                                           _mm_alignr_epi8(w3, w2, 4)), w3)
+
+    /* Four rounds, two per instruction, on words i..i+3 in w. */
+    #define SHA256_NI_RND4(w, i)                                             \
+        do {                                                                 \
+            m  = _mm_add_epi32(w, _mm_loadu_si128((const __m128i*)&K[i]));   \
+            s1 = _mm_sha256rnds2_epu32(s1, s0, m);                           \
+            s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(m, 0x0E));  \
+        } while (0)
+
+    /* Hash len bytes of big-endian message blocks with the SHA extensions.
+     * The state is kept as ABEF and CDGH, the layout sha256rnds2 works on. */
+    static WC_TARGET_SHA_NI int Transform_Sha256_SHANI_Len(wc_Sha256* sha256,
+                                                 const byte* data, word32 len)
+    {
+        const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                             0x0405060700010203ULL);
+        __m128i s0, s1, t, m;
+        __m128i save0, save1;
+        __m128i w0, w1, w2, w3;
+        int i;
+
+        t  = _mm_loadu_si128((const __m128i*)&sha256->digest[0]);
+        s1 = _mm_loadu_si128((const __m128i*)&sha256->digest[4]);
+        t  = _mm_shuffle_epi32(t, 0xB1);                 /* CDAB */
+        s1 = _mm_shuffle_epi32(s1, 0x1B);                /* EFGH */
+        s0 = _mm_alignr_epi8(t, s1, 8);                  /* ABEF */
+        s1 = _mm_blend_epi16(s1, t, 0xF0);               /* CDGH */
+
+        for (; len >= WC_SHA256_BLOCK_SIZE; len -= WC_SHA256_BLOCK_SIZE) {
+            save0 = s0;
+            save1 = s1;
+
+            w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data +  0),
+                                  bswap);
+            w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data +  1),
+                                  bswap);
+            w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data +  2),
+                                  bswap);
+            w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data +  3),
+                                  bswap);
+            SHA256_NI_RND4(w0,  0);
+            SHA256_NI_RND4(w1,  4);
+            SHA256_NI_RND4(w2,  8);
+            SHA256_NI_RND4(w3, 12);
+            for (i = 16; i < 64; i += 16) {
+                w0 = SHA256_NI_SCHED(w0, w1, w2, w3);
+                SHA256_NI_RND4(w0, i +  0);
+                w1 = SHA256_NI_SCHED(w1, w2, w3, w0);
+                SHA256_NI_RND4(w1, i +  4);
+                w2 = SHA256_NI_SCHED(w2, w3, w0, w1);
+                SHA256_NI_RND4(w2, i +  8);
+                w3 = SHA256_NI_SCHED(w3, w0, w1, w2);
+                SHA256_NI_RND4(w3, i + 12);
+            }
+
+            s0 = _mm_add_epi32(s0, save0);
+            s1 = _mm_add_epi32(s1, save1);
+            data += WC_SHA256_BLOCK_SIZE;
+        }
+
+        t  = _mm_shuffle_epi32(s0, 0x1B);                /* FEBA */
+        s1 = _mm_shuffle_epi32(s1, 0xB1);                /* DCHG */
+        s0 = _mm_blend_epi16(t, s1, 0xF0);               /* DCBA */
+        s1 = _mm_alignr_epi8(s1, t, 8);                  /* HGFE */
+        _mm_storeu_si128((__m128i*)&sha256->digest[0], s0);
+        _mm_storeu_si128((__m128i*)&sha256->digest[4], s1);
+
+        return 0;
+    }
+
+    static int Transform_Sha256_SHANI(wc_Sha256* sha256, const byte* data)
+    {
+        return Transform_Sha256_SHANI_Len(sha256, data, WC_SHA256_BLOCK_SIZE);
+    }
+#endif /* HAVE_INTEL_SHA */
+
+
+#ifdef HAVE_INTEL_SHA256_MB
+    /* Multi-buffer SHA-256: one message per 32-bit vector lane. The state is
+     * kept column-wise, word k of lane l at [k * lanes + l], so each word
+     * loads as one vector across all lanes. */
+    #define SHA256_MB_MAX_LANES  16
+
+    #define MB8_ADD(a, b)     _mm256_add_epi32(a, b)
+    #define MB8_ROR(x, n)     _mm256_or_si256(_mm256_srli_epi32(x, n),        \
+                                              _mm256_slli_epi32(x, 32 - (n)))
+    #define MB8_XOR3(a, b, c) _mm256_xor_si256(_mm256_xor_si256(a, b), c)
+    #define MB8_S0(x)   MB8_XOR3(MB8_ROR(x,  2), MB8_ROR(x, 13), MB8_ROR(x, 22))
+    #define MB8_S1(x)   MB8_XOR3(MB8_ROR(x,  6), MB8_ROR(x, 11), MB8_ROR(x, 25))
+    #define MB8_G0(x)   MB8_XOR3(MB8_ROR(x,  7), MB8_ROR(x, 18),                \
+                                 _mm256_srli_epi32(x,  3))
+    #define MB8_G1(x)   MB8_XOR3(MB8_ROR(x, 17), MB8_ROR(x, 19),                \
+                                 _mm256_srli_epi32(x, 10))
+    #define MB8_CH(x, y, z)   _mm256_xor_si256(_mm256_and_si256(x, y),        \
+                                               _mm256_andnot_si256(x, z))
+    #define MB8_MAJ(x, y, z)  _mm256_or_si256(_mm256_and_si256(x, y),         \
+                                  _mm256_and_si256(z, _mm256_or_si256(x, y)))
+
+    #define MB8_SCHED(i)                                                     \
+        w[(i) & 15] = MB8_ADD(MB8_ADD(MB8_G1(w[((i) - 2) & 15]),             \
+                                      w[((i) - 7) & 15]),                    \
+                              MB8_ADD(MB8_G0(w[((i) - 15) & 15]),            \
+                                      w[(i) & 15]))
+    #define MB8_RND(a, b, c, d, e, f, g, h, i)                               \
+        do {                                                                 \
+            t0 = MB8_ADD(MB8_ADD(h, MB8_S1(e)),                              \
+                         MB8_ADD(MB8_CH(e, f, g),                            \
+                            MB8_ADD(_mm256_set1_epi32((int)K[i]),            \
+                                    w[(i) & 15])));                          \
+            t1 = MB8_ADD(MB8_S0(a), MB8_MAJ(a, b, c));                       \
+            d  = MB8_ADD(d, t0);                                             \
+            h  = MB8_ADD(t0, t1);                                            \
+        } while (0)
+
+    /* Message words off / 4 to off / 4 + 7 of 8 blocks, one vector per word
+     * with the word of block j in lane j, byte reversed. */
+    static WC_INLINE WC_TARGET_AVX2 void Sha256MB_Load8(__m256i* w,
+                                       const byte* const* blk, int off)
+    {
+        const __m256i bswap = _mm256_set_epi64x(
+            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+        __m256i r[8], t[8];
+        int j;
+
+        for (j = 0; j < 8; j++)
+            r[j] = _mm256_loadu_si256((const __m256i*)(blk[j] + off));
+
+        /* 8x8 transpose of 32-bit words */
+        for (j = 0; j < 8; j += 2) {
+            t[j + 0] = _mm256_unpacklo_epi32(r[j], r[j + 1]);
+            t[j + 1] = _mm256_unpackhi_epi32(r[j], r[j + 1]);
+        }
+        for (j = 0; j < 8; j += 4) {
+            r[j + 0] = _mm256_unpacklo_epi64(t[j + 0], t[j + 2]);
+            r[j + 1] = _mm256_unpackhi_epi64(t[j + 0], t[j + 2]);
+            r[j + 2] = _mm256_unpacklo_epi64(t[j + 1], t[j + 3]);
+            r[j + 3] = _mm256_unpackhi_epi64(t[j + 1], t[j + 3]);
+        }
+        for (j = 0; j < 4; j++) {
+            w[j + 0] = _mm256_shuffle_epi8(
+                           _mm256_permute2x128_si256(r[j], r[j + 4], 0x20),
+                           bswap);
+            w[j + 4] = _mm256_shuffle_epi8(
+                           _mm256_permute2x128_si256(r[j], r[j + 4], 0x31),
+                           bswap);
+        }
+    }
+
+    /* One block for each of 8 lanes. s is the state, blk the blocks. */
+    static WC_TARGET_AVX2 void Sha256MB_Block_AVX2(word32* s,
+                                                   const byte* const* blk)
+    {
+        __m256i* v = (__m256i*)s;
+        __m256i w[16];
+        __m256i a, b, c, d, e, f, g, h, t0, t1;
+        int i;
+
+        a = v[0]; b = v[1]; c = v[2]; d = v[3];
+        e = v[4]; f = v[5]; g = v[6]; h = v[7];
+
+        Sha256MB_Load8(w + 0, blk,  0);
+        Sha256MB_Load8(w + 8, blk, 32);
+        for (i = 0; i < 64; i += 8) {
+            if (i >= 16) {
+                MB8_SCHED(i + 0); MB8_SCHED(i + 1); MB8_SCHED(i + 2);
+                MB8_SCHED(i + 3); MB8_SCHED(i + 4); MB8_SCHED(i + 5);
+                MB8_SCHED(i + 6); MB8_SCHED(i + 7);
+            }
+            MB8_RND(a, b, c, d, e, f, g, h, i + 0);
+            MB8_RND(h, a, b, c, d, e, f, g, i + 1);
+            MB8_RND(g, h, a, b, c, d, e, f, i + 2);
+            MB8_RND(f, g, h, a, b, c, d, e, i + 3);
+            MB8_RND(e, f, g, h, a, b, c, d, i + 4);
+            MB8_RND(d, e, f, g, h, a, b, c, i + 5);
+            MB8_RND(c, d, e, f, g, h, a, b, i + 6);
+            MB8_RND(b, c, d, e, f, g, h, a, i + 7);
+        }
+
+        v[0] = MB8_ADD(v[0], a); v[1] = MB8_ADD(v[1], b);
+        v[2] = MB8_ADD(v[2], c); v[3] = MB8_ADD(v[3], d);
+        v[4] = MB8_ADD(v[4], e); v[5] = MB8_ADD(v[5], f);
+        v[6] = MB8_ADD(v[6], g); v[7] = MB8_ADD(v[7], h);
+    }
+
+    #define MB16_ADD(a, b)     _mm512_add_epi32(a, b)
+    #define MB16_ROR(x, n)     _mm512_ror_epi32(x, n)
+    #define MB16_XOR3(a, b, c) _mm512_ternarylogic_epi32(a, b, c, 0x96)
+    #define MB16_S0(x)  MB16_XOR3(MB16_ROR(x,  2), MB16_ROR(x, 13),           \
+                                  MB16_ROR(x, 22))
+    #define MB16_S1(x)  MB16_XOR3(MB16_ROR(x,  6), MB16_ROR(x, 11),           \
+                                  MB16_ROR(x, 25))
+    #define MB16_G0(x)  MB16_XOR3(MB16_ROR(x,  7), MB16_ROR(x, 18),           \
+                                  _mm512_srli_epi32(x,  3))
+    #define MB16_G1(x)  MB16_XOR3(MB16_ROR(x, 17), MB16_ROR(x, 19),           \
+                                  _mm512_srli_epi32(x, 10))
+    #define MB16_CH(x, y, z)   _mm512_ternarylogic_epi32(x, y, z, 0xCA)
+    #define MB16_MAJ(x, y, z)  _mm512_ternarylogic_epi32(x, y, z, 0xE8)
+
+    #define MB16_SCHED(i)                                                    \
+        w[(i) & 15] = MB16_ADD(MB16_ADD(MB16_G1(w[((i) - 2) & 15]),          \
+                                        w[((i) - 7) & 15]),                  \
+                               MB16_ADD(MB16_G0(w[((i) - 15) & 15]),         \
+                                        w[(i) & 15]))
+    #define MB16_RND(a, b, c, d, e, f, g, h, i)                              \
+        do {                                                                 \
+            t0 = MB16_ADD(MB16_ADD(h, MB16_S1(e)),                           \
+                          MB16_ADD(MB16_CH(e, f, g),                         \
+                             MB16_ADD(_mm512_set1_epi32((int)K[i]),          \
+                                      w[(i) & 15])));                        \
+            t1 = MB16_ADD(MB16_S0(a), MB16_MAJ(a, b, c));                    \
+            d  = MB16_ADD(d, t0);                                            \
+            h  = MB16_ADD(t0, t1);                                           \
+        } while (0)
+
+    /* One block for each of 16 lanes, as Sha256MB_Block_AVX2(). */
+    static WC_TARGET_AVX512 void Sha256MB_Block_AVX512(word32* s,
+                                                   const byte* const* blk)
+    {
+        __m512i* v = (__m512i*)s;
+        __m512i w[16];
+        __m512i a, b, c, d, e, f, g, h, t0, t1;
+        __m256i lo[16], hi[16];
+        int i;
+
+        a = v[0]; b = v[1]; c = v[2]; d = v[3];
+        e = v[4]; f = v[5]; g = v[6]; h = v[7];
+
+        Sha256MB_Load8(lo + 0, blk + 0,  0);
+        Sha256MB_Load8(lo + 8, blk + 0, 32);
+        Sha256MB_Load8(hi + 0, blk + 8,  0);
+        Sha256MB_Load8(hi + 8, blk + 8, 32);
+        for (i = 0; i < 16; i++) {
+            w[i] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[i]), hi[i], 1);
+        }
+        for (i = 0; i < 64; i += 8) {
+            if (i >= 16) {
+                MB16_SCHED(i + 0); MB16_SCHED(i + 1); MB16_SCHED(i + 2);
+                MB16_SCHED(i + 3); MB16_SCHED(i + 4); MB16_SCHED(i + 5);
+                MB16_SCHED(i + 6); MB16_SCHED(i + 7);
+            }
+            MB16_RND(a, b, c, d, e, f, g, h, i + 0);
+            MB16_RND(h, a, b, c, d, e, f, g, i + 1);
+            MB16_RND(g, h, a, b, c, d, e, f, i + 2);
+            MB16_RND(f, g, h, a, b, c, d, e, i + 3);
+            MB16_RND(e, f, g, h, a, b, c, d, i + 4);
+            MB16_RND(d, e, f, g, h, a, b, c, i + 5);
+            MB16_RND(c, d, e, f, g, h, a, b, i + 6);
+            MB16_RND(b, c, d, e, f, g, h, a, i + 7);
+        }
+
+        v[0] = MB16_ADD(v[0], a); v[1] = MB16_ADD(v[1], b);
+        v[2] = MB16_ADD(v[2], c); v[3] = MB16_ADD(v[3], d);
+        v[4] = MB16_ADD(v[4], e); v[5] = MB16_ADD(v[5], f);
+        v[6] = MB16_ADD(v[6], g); v[7] = MB16_ADD(v[7], h);
+    }
+
+    /* Message of one lane: an optional head block joining the bytes left in
+     * the state's buffer with the new data, whole blocks read in place, then
+     * one or two padded tail blocks. */
+    typedef struct Sha256MbLane {
+        wc_Sha256*  sha256;
+        byte*       hash;
+        const byte* data;
+        word32      next;       /* index of the next block */
+        word32      blocks;     /* blocks in total */
+        word32      bodyStart;  /* first block read from data */
+        word32      tailStart;  /* first block read from tail */
+        byte        head[WC_SHA256_BLOCK_SIZE];
+        byte        tail[2 * WC_SHA256_BLOCK_SIZE];
+    } Sha256MbLane;
+
+    static void Sha256MB_SetLane(Sha256MbLane* lane, word32* s, int lanes,
+                   wc_Sha256* sha256, const byte* data, word32 len, byte* hash)
+    {
+        word32 buffLen = sha256->buffLen;
+        word32 full = (buffLen + len) / WC_SHA256_BLOCK_SIZE;
+        word32 rem = (buffLen + len) % WC_SHA256_BLOCK_SIZE;
+        word32 tailSz;
+        word32 lo, hi;
+        int k;
+
+        lane->sha256 = sha256;
+        lane->hash = hash;
+        lane->next = 0;
+        lane->bodyStart = 0;
+        if (buffLen > 0 && full > 0) {
+            XMEMCPY(lane->head, sha256->buffer, buffLen);
+            XMEMCPY(lane->head + buffLen, data,
+                    WC_SHA256_BLOCK_SIZE - buffLen);
+            data += WC_SHA256_BLOCK_SIZE - buffLen;
+            lane->bodyStart = 1;
+        }
+        lane->data = data;
+        lane->tailStart = full;
+
+        XMEMSET(lane->tail, 0, sizeof(lane->tail));
+        if (full == 0) {
+            XMEMCPY(lane->tail, sha256->buffer, buffLen);
+            if (len > 0)
+                XMEMCPY(lane->tail + buffLen, data, len);
+        }
+        else {
+            XMEMCPY(lane->tail, data + (full - lane->bodyStart) *
+                    WC_SHA256_BLOCK_SIZE, rem);
+        }
+        tailSz = (rem < WC_SHA256_PAD_SIZE) ? WC_SHA256_BLOCK_SIZE :
+                                              2 * WC_SHA256_BLOCK_SIZE;
+        lane->tail[rem] = 0x80;
+
+        /* length in bits */
+        lo = sha256->loLen + len;
+        hi = sha256->hiLen + (lo < sha256->loLen);
+        c32toa((hi << 3) | (lo >> 29), lane->tail + tailSz - 8);
+        c32toa(lo << 3, lane->tail + tailSz - 4);
+
+        lane->blocks = full + tailSz / WC_SHA256_BLOCK_SIZE;
+
+        for (k = 0; k < 8; k++)
+            s[k * lanes] = sha256->digest[k];
+    }
+
+    static const byte* Sha256MB_LaneBlock(const Sha256MbLane* lane)
+    {
+        if (lane->next < lane->bodyStart)
+            return lane->head;
+        if (lane->next < lane->tailStart)
+            return lane->data + (lane->next - lane->bodyStart) *
+                                                        WC_SHA256_BLOCK_SIZE;
+        return lane->tail + (lane->next - lane->tailStart) *
+                                                        WC_SHA256_BLOCK_SIZE;
+    }
+
+    /* Number of lanes to hash cnt messages with, 0 to hash one at a time. */
+    static int Sha256MB_Lanes(wc_Sha256* const* sha256, const word32* len,
+                              word32 cnt)
+    {
+        int lanes;
+        word32 i;
+        word32 longMsgs = 0;
+
+        Sha256_SetTransform();
+        if (IS_INTEL_AVX512(intel_flags))
+            lanes = 16;
+        else if (IS_INTEL_AVX2(intel_flags))
+            lanes = 8;
+        else
+            return 0;
+
+        if (cnt < 2)
+            return 0;
+
+        for (i = 0; i < cnt; i++) {
+            if (len[i] >= 4 * WC_SHA256_BLOCK_SIZE)
+                longMsgs++;
+            if (sha256[i]->buffLen >= WC_SHA256_BLOCK_SIZE)
+                return 0;
+        #ifdef WOLF_CRYPTO_CB
+            if (sha256[i]->devId != INVALID_DEVID)
+                return 0;
+        #endif
+        #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_SHA256)
+            if (sha256[i]->asyncDev.marker == WOLFSSL_ASYNC_MARKER_SHA256)
+                return 0;
+        #endif
+        }
+
+    #ifdef HAVE_INTEL_SHA
+        /* the SHA extensions beat 8 lanes, and 16 lanes unless they are kept
+         * full with mostly longer messages */
+        if (IS_INTEL_SHA(intel_flags) && (lanes == 8 || cnt < 8 ||
+                                          longMsgs < cnt / 2)) {
+            return 0;
+        }
+    #endif
+
+        return lanes;
+    }
+
+    static int Sha256MB_Hash(wc_Sha256* const* sha256,
+                             const byte* const* data, const word32* len,
+                             byte* const* hash, word32 cnt, int lanes)
+    {
+        ALIGN64 word32 s[8 * SHA256_MB_MAX_LANES];
+        const byte* blk[SHA256_MB_MAX_LANES];
+        static const byte zeroBlock[WC_SHA256_BLOCK_SIZE] = { 0 };
+    #ifdef WOLFSSL_SMALL_STACK
+        Sha256MbLane* lane;
+    #else
+        Sha256MbLane lane[SHA256_MB_MAX_LANES];
+    #endif
+        word32 job = 0;
+        int active = 0;
+        int i, k;
+
+    #ifdef WOLFSSL_SMALL_STACK
+        lane = (Sha256MbLane*)XMALLOC(sizeof(Sha256MbLane) * lanes,
+                                      sha256[0]->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (lane == NULL)
+            return MEMORY_E;
+    #endif
+        XMEMSET(lane, 0, sizeof(Sha256MbLane) * lanes);
+
+        SAVE_VECTOR_REGISTERS();
+        for (;;) {
+            /* start the next messages on lanes that are free */
+            for (i = 0; i < lanes && job < cnt; i++) {
+                if (lane[i].blocks == 0) {
+                    Sha256MB_SetLane(&lane[i], s + i, lanes, sha256[job],
+                                     data[job], len[job], hash[job]);
+                    job++;
+                    active++;
+                }
+            }
+            if (active == 0)
+                break;
+
+            for (i = 0; i < lanes; i++) {
+                blk[i] = (lane[i].blocks != 0) ? Sha256MB_LaneBlock(&lane[i]) :
+                                                 zeroBlock;
+            }
+
+            if (lanes == 16)
+                Sha256MB_Block_AVX512(s, blk);
+            else
+                Sha256MB_Block_AVX2(s, blk);
+
+            for (i = 0; i < lanes; i++) {
+                if (lane[i].blocks == 0)
+                    continue;
+                if (++lane[i].next == lane[i].blocks) {
+                    for (k = 0; k < 8; k++)
+                        c32toa(s[k * lanes + i], lane[i].hash + k * 4);
+                    (void)InitSha256(lane[i].sha256);  /* reset state */
+                    lane[i].blocks = 0;
+                    active--;
+                }
+            }
+        }
+        RESTORE_VECTOR_REGISTERS();
+
+        ForceZero(lane, sizeof(Sha256MbLane) * lanes);
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(lane, sha256[0]->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+
+        return 0;
+    }
+#endif /* HAVE_INTEL_SHA256_MB */
+
+
 #ifdef XTRANSFORM
 
     static WC_INLINE void AddLength(wc_Sha256* sha256, word32 len)
@@ -988,7 +1470,7 @@ static int InitSha256(wc_Sha256* sha256)
             #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
                 #if defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-                if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+                if (!Transform_Sha256_is_vectorized)
                 #endif
                 {
                     ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1066,7 +1548,7 @@ static int InitSha256(wc_Sha256* sha256)
             #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
                 #if defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-                if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+                if (!Transform_Sha256_is_vectorized)
                 #endif
                 {
                     ByteReverseWords(local32, local32, WC_SHA256_BLOCK_SIZE);
@@ -1154,7 +1636,7 @@ static int InitSha256(wc_Sha256* sha256)
         #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
             #if defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-            if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+            if (!Transform_Sha256_is_vectorized)
             #endif
             {
                 ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1192,7 +1674,7 @@ static int InitSha256(wc_Sha256* sha256)
     #if defined(LITTLE_ENDIAN_ORDER) && !defined(FREESCALE_MMCAU_SHA)
         #if defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-        if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+        if (!Transform_Sha256_is_vectorized)
         #endif
         {
             ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1209,7 +1691,7 @@ static int InitSha256(wc_Sha256* sha256)
         /* Kinetis requires only these bytes reversed */
         #if defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-        if (IS_INTEL_AVX1(intel_flags) || IS_INTEL_AVX2(intel_flags))
+        if (Transform_Sha256_is_vectorized)
         #endif
         {
             ByteReverseWords(
@@ -1727,6 +2209,47 @@ int wc_Sha256GetFlags(wc_Sha256* sha256, word32* flags)
     return 0;
 }
 #endif
+
+#ifdef WOLFSSL_SHA256_MULTI_BUFFER
+/* Finish cnt independent hashes: each state takes its last data and is then
+ * finalized into its hash and reset, as with wc_Sha256Update() followed by
+ * wc_Sha256Final(). Messages are hashed side by side in vector lanes when
+ * the CPU allows it. */
+int wc_Sha256MultiBuffer(wc_Sha256* const* sha256, const byte* const* data,
+                         const word32* len, byte* const* hash, word32 cnt)
+{
+    int ret = 0;
+    word32 i;
+#ifdef HAVE_INTEL_SHA256_MB
+    int lanes;
+#endif
+
+    if (cnt > 0 && (sha256 == NULL || data == NULL || len == NULL ||
+                                                              hash == NULL)) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if (sha256[i] == NULL || hash[i] == NULL ||
+                                          (data[i] == NULL && len[i] > 0)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+#ifdef HAVE_INTEL_SHA256_MB
+    lanes = Sha256MB_Lanes(sha256, len, cnt);
+    if (lanes > 0)
+        return Sha256MB_Hash(sha256, data, len, hash, cnt, lanes);
+#endif
+
+    for (i = 0; ret == 0 && i < cnt; i++) {
+        ret = wc_Sha256Update(sha256[i], data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha256Final(sha256[i], hash[i]);
+    }
+
+    return ret;
+}
+#endif /* WOLFSSL_SHA256_MULTI_BUFFER */
 #endif /* !WOLFSSL_TI_HASH */
 
 #endif /* NO_SHA256 */
@@ -52,6 +52,20 @@
     #include <wolfcrypt/src/misc.c>
 #endif
 
+/* Keccak-f[1600] using BMI1/BMI2 and, for the parallel SHAKE API, four
+ * interleaved states in vector registers */
+#ifdef USE_INTEL_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+#endif
+#if defined(USE_INTEL_SPEEDUP) && !defined(WOLFSSL_SHA3_SMALL) && \
+    defined(WC_HAVE_TARGET_ATTR)
+    #define HAVE_INTEL_SHA3_BMI2
+    #ifdef WOLFSSL_SHAKE_X4
+        #include <immintrin.h>
+        #define HAVE_INTEL_SHAKE_X4
+    #endif
+#endif
+
 
 #ifdef WOLFSSL_SHA3_SMALL
 /* Rotate a 64-bit value left.
@@ -374,7 +388,7 @@ while (0)
 
 #define S(s1, i) ROTL64(s1[KI_##i], KR_##i)
 
-#ifdef SHA3_BY_SPEC
+#if defined(SHA3_BY_SPEC) || defined(HAVE_INTEL_SHA3_BMI2)
 /* Mix the row values.
  * BMI1 has ANDN instruction ((~a) & b) - Haswell and above.
  *
@@ -384,7 +398,7 @@ while (0)
  * t0  Temporary variable. (Unused)
  * t1  Temporary variable. (Unused)
  */
-#define ROW_MIX(s2, s1, b, t0, t1)            \
+#define ROW_MIX_ANDN(s2, s1, b, t0, t1)       \
 do                                            \
 {                                             \
     b[0] = s1[0];                             \
@@ -439,6 +453,10 @@ do                                            \
     s2[24] = b[4] ^ (~b[0] & b[1]);           \
 }                                             \
 while (0)
+#endif
+
+#ifdef SHA3_BY_SPEC
+#define ROW_MIX     ROW_MIX_ANDN
 #else
 /* Mix the row values.
  * a ^ (~b & c) == a ^ (c & (b ^ c)) == (a ^ b) ^ (b | c)
@@ -536,8 +554,57 @@ static void BlockSha3(word64 *s)
         s[0] ^= hash_keccak_r[i+1];
     }
 }
+
+#ifdef HAVE_INTEL_SHA3_BMI2
+/* The block operation performed on the state using ANDN (BMI1) for the row
+ * mix and RORX (BMI2) for the rotates. All BMI2 CPUs have BMI1.
+ *
+ * s  The state.
+ */
+static WC_TARGET_BMI2 void BlockSha3_BMI2(word64 *s)
+{
+    word64 n[25];
+    word64 b[5];
+    word64 t0;
+    byte i;
+
+    for (i = 0; i < 24; i += 2)
+    {
+        COL_MIX(s, b, x, t0);
+        ROW_MIX_ANDN(n, s, b, t0, t0);
+        n[0] ^= hash_keccak_r[i];
+
+        COL_MIX(n, b, x, t0);
+        ROW_MIX_ANDN(s, n, b, t0, t0);
+        s[0] ^= hash_keccak_r[i+1];
+    }
+}
+#endif /* HAVE_INTEL_SHA3_BMI2 */
 #endif /* WOLFSSL_SHA3_SMALL */
 
+#ifdef HAVE_INTEL_SHA3_BMI2
+static void (*BlockSha3_p)(word64 *s) = BlockSha3;
+static int block_check = 0;
+static word32 intel_flags;
+
+/* Choose the block operation for the CPU - once. */
+static void Sha3_SetBlock(void)
+{
+    if (block_check)
+        return;
+
+    intel_flags = cpuid_get_flags();
+    if (IS_INTEL_BMI2(intel_flags))
+        BlockSha3_p = BlockSha3_BMI2;
+
+    block_check = 1;
+}
+
+#define SHA3_BLOCK(s)   (*BlockSha3_p)(s)
+#else
+#define SHA3_BLOCK(s)   BlockSha3(s)
+#endif
+
 /* Convert the array of bytes, in little-endian order, to a 64-bit integer.
  *
  * a  Array of bytes.
@@ -567,6 +634,9 @@ static int InitSha3(wc_Sha3* sha3)
 {
     int i;
 
+#ifdef HAVE_INTEL_SHA3_BMI2
+    Sha3_SetBlock();
+#endif
     for (i = 0; i < 25; i++)
         sha3->s[i] = 0;
     sha3->i = 0;
@@ -609,7 +679,7 @@ static int Sha3Update(wc_Sha3* sha3, const byte* data, word32 len, byte p)
         {
             for (i = 0; i < p; i++)
                 sha3->s[i] ^= Load64BitBigEndian(sha3->t + 8 * i);
-            BlockSha3(sha3->s);
+            SHA3_BLOCK(sha3->s);
             sha3->i = 0;
         }
     }
@@ -617,7 +687,7 @@ static int Sha3Update(wc_Sha3* sha3, const byte* data, word32 len, byte p)
     {
         for (i = 0; i < p; i++)
             sha3->s[i] ^= Load64BitBigEndian(data + 8 * i);
-        BlockSha3(sha3->s);
+        SHA3_BLOCK(sha3->s);
         len -= p * 8;
         data += p * 8;
     }
@@ -653,7 +723,7 @@ static int Sha3Final(wc_Sha3* sha3, byte padChar, byte* hash, byte p, byte l)
         sha3->t[i] = 0;
     for (i = 0; i < p; i++)
         sha3->s[i] ^= Load64BitBigEndian(sha3->t + 8 * i);
-    BlockSha3(sha3->s);
+    SHA3_BLOCK(sha3->s);
 #if defined(BIG_ENDIAN_ORDER)
     ByteReverseWords64(sha3->s, sha3->s, ((l+7)/8)*8);
 #endif
@@ -1223,4 +1293,415 @@ int wc_Shake256_Copy(wc_Shake* src, wc_Shake* dst)
 }
 #endif
 
+#ifdef WOLFSSL_SHAKE_X4
+#ifdef HAVE_INTEL_SHAKE_X4
+/* AVX2 has no vector rotate - shift both ways and OR. */
+#define X4_ROL_AVX2(a, n)                                               \
+    _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+#define X4_XOR5_AVX2(a, b, c, d, e)                                     \
+    _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a, b),           \
+                                      _mm256_xor_si256(c, d)), e)
+/* a ^ (~b & c) */
+#define X4_CHI_AVX2(a, b, c)                                            \
+    _mm256_xor_si256(a, _mm256_andnot_si256(b, c))
+
+/* AVX-512VL rotates in one instruction and mixes three inputs with
+ * ternarylogic: 0x96 is a ^ b ^ c and 0xd2 is a ^ (~b & c). */
+#define X4_ROL_AVX512(a, n)     _mm256_rol_epi64(a, n)
+#define X4_XOR5_AVX512(a, b, c, d, e)                                   \
+    _mm256_ternarylogic_epi64(_mm256_ternarylogic_epi64(a, b, c, 0x96), \
+                              d, e, 0x96)
+#define X4_CHI_AVX512(a, b, c)  _mm256_ternarylogic_epi64(a, b, c, 0xd2)
+
+/* XOR t into each number in column x. */
+#define X4_COL_XOR(s, x, t)                                             \
+    s[x +  0] = _mm256_xor_si256(s[x +  0], t);                         \
+    s[x +  5] = _mm256_xor_si256(s[x +  5], t);                         \
+    s[x + 10] = _mm256_xor_si256(s[x + 10], t);                         \
+    s[x + 15] = _mm256_xor_si256(s[x + 15], t);                         \
+    s[x + 20] = _mm256_xor_si256(s[x + 20], t)
+
+/* Mix the XOR of the column's values into each number by column - for four
+ * interleaved states.
+ *
+ * s     The states.
+ * b     Temporary array of XORed column values.
+ * t     Temporary variable.
+ * ROL   Rotate operation.
+ * XOR5  Five input XOR operation.
+ */
+#define X4_COL_MIX(s, b, t, ROL, XOR5)                                  \
+do                                                                      \
+{                                                                       \
+    b[0] = XOR5(s[0], s[5], s[10], s[15], s[20]);                       \
+    b[1] = XOR5(s[1], s[6], s[11], s[16], s[21]);                       \
+    b[2] = XOR5(s[2], s[7], s[12], s[17], s[22]);                       \
+    b[3] = XOR5(s[3], s[8], s[13], s[18], s[23]);                       \
+    b[4] = XOR5(s[4], s[9], s[14], s[19], s[24]);                       \
+    t = _mm256_xor_si256(b[4], ROL(b[1], 1));                           \
+    X4_COL_XOR(s, 0, t);                                                \
+    t = _mm256_xor_si256(b[0], ROL(b[2], 1));                           \
+    X4_COL_XOR(s, 1, t);                                                \
+    t = _mm256_xor_si256(b[1], ROL(b[3], 1));                           \
+    X4_COL_XOR(s, 2, t);                                                \
+    t = _mm256_xor_si256(b[2], ROL(b[4], 1));                           \
+    X4_COL_XOR(s, 3, t);                                                \
+    t = _mm256_xor_si256(b[3], ROL(b[0], 1));                           \
+    X4_COL_XOR(s, 4, t);                                                \
+}                                                                       \
+while (0)
+
+#define X4_S(s1, i, ROL)        ROL(s1[KI_##i], KR_##i)
+
+/* Calculate row y of the new states from the swapped and rotated values. */
+#define X4_CHI_ROW(s2, y, b, CHI)                                       \
+    s2[y * 5 + 0] = CHI(b[0], b[1], b[2]);                              \
+    s2[y * 5 + 1] = CHI(b[1], b[2], b[3]);                              \
+    s2[y * 5 + 2] = CHI(b[2], b[3], b[4]);                              \
+    s2[y * 5 + 3] = CHI(b[3], b[4], b[0]);                              \
+    s2[y * 5 + 4] = CHI(b[4], b[0], b[1])
+
+/* Mix the row values - for four interleaved states.
+ *
+ * s2   The new states.
+ * s1   The current states.
+ * b    Temporary array of row values.
+ * ROL  Rotate operation.
+ * CHI  a ^ (~b & c) operation.
+ */
+#define X4_ROW_MIX(s2, s1, b, ROL, CHI)                                 \
+do                                                                      \
+{                                                                       \
+    b[0] = s1[0];                                                       \
+    b[1] = X4_S(s1, 0, ROL);                                            \
+    b[2] = X4_S(s1, 1, ROL);                                            \
+    b[3] = X4_S(s1, 2, ROL);                                            \
+    b[4] = X4_S(s1, 3, ROL);                                            \
+    X4_CHI_ROW(s2, 0, b, CHI);                                          \
+    b[0] = X4_S(s1, 4, ROL);                                            \
+    b[1] = X4_S(s1, 5, ROL);                                            \
+    b[2] = X4_S(s1, 6, ROL);                                            \
+    b[3] = X4_S(s1, 7, ROL);                                            \
+    b[4] = X4_S(s1, 8, ROL);                                            \
+    X4_CHI_ROW(s2, 1, b, CHI);                                          \
+    b[0] = X4_S(s1, 9, ROL);                                            \
+    b[1] = X4_S(s1, 10, ROL);                                           \
+    b[2] = X4_S(s1, 11, ROL);                                           \
+    b[3] = X4_S(s1, 12, ROL);                                           \
+    b[4] = X4_S(s1, 13, ROL);                                           \
+    X4_CHI_ROW(s2, 2, b, CHI);                                          \
+    b[0] = X4_S(s1, 14, ROL);                                           \
+    b[1] = X4_S(s1, 15, ROL);                                           \
+    b[2] = X4_S(s1, 16, ROL);                                           \
+    b[3] = X4_S(s1, 17, ROL);                                           \
+    b[4] = X4_S(s1, 18, ROL);                                           \
+    X4_CHI_ROW(s2, 3, b, CHI);                                          \
+    b[0] = X4_S(s1, 19, ROL);                                           \
+    b[1] = X4_S(s1, 20, ROL);                                           \
+    b[2] = X4_S(s1, 21, ROL);                                           \
+    b[3] = X4_S(s1, 22, ROL);                                           \
+    b[4] = X4_S(s1, 23, ROL);                                           \
+    X4_CHI_ROW(s2, 4, b, CHI);                                          \
+}                                                                       \
+while (0)
+
+/* The block operation performed on four interleaved states with AVX2.
+ *
+ * s  The states - one 64-bit lane per state.
+ */
+static WC_TARGET_AVX2 void BlockSha3_x4_AVX2(__m256i* s)
+{
+    __m256i n[25];
+    __m256i b[5];
+    __m256i t;
+    int i;
+
+    for (i = 0; i < 24; i += 2) {
+        X4_COL_MIX(s, b, t, X4_ROL_AVX2, X4_XOR5_AVX2);
+        X4_ROW_MIX(n, s, b, X4_ROL_AVX2, X4_CHI_AVX2);
+        n[0] = _mm256_xor_si256(n[0],
+                           _mm256_set1_epi64x((long long)hash_keccak_r[i]));
+
+        X4_COL_MIX(n, b, t, X4_ROL_AVX2, X4_XOR5_AVX2);
+        X4_ROW_MIX(s, n, b, X4_ROL_AVX2, X4_CHI_AVX2);
+        s[0] = _mm256_xor_si256(s[0],
+                         _mm256_set1_epi64x((long long)hash_keccak_r[i+1]));
+    }
+}
+
+/* The block operation performed on four interleaved states with AVX-512VL.
+ *
+ * s  The states - one 64-bit lane per state.
+ */
+static WC_TARGET_AVX512 void BlockSha3_x4_AVX512(__m256i* s)
+{
+    __m256i n[25];
+    __m256i b[5];
+    __m256i t;
+    int i;
+
+    for (i = 0; i < 24; i += 2) {
+        X4_COL_MIX(s, b, t, X4_ROL_AVX512, X4_XOR5_AVX512);
+        X4_ROW_MIX(n, s, b, X4_ROL_AVX512, X4_CHI_AVX512);
+        n[0] = _mm256_xor_si256(n[0],
+                           _mm256_set1_epi64x((long long)hash_keccak_r[i]));
+
+        X4_COL_MIX(n, b, t, X4_ROL_AVX512, X4_XOR5_AVX512);
+        X4_ROW_MIX(s, n, b, X4_ROL_AVX512, X4_CHI_AVX512);
+        s[0] = _mm256_xor_si256(s[0],
+                         _mm256_set1_epi64x((long long)hash_keccak_r[i+1]));
+    }
+}
+
+/* Transpose four rows of four 64-bit numbers. */
+#define X4_TRANSPOSE(r0, r1, r2, r3)                                    \
+do                                                                      \
+{                                                                       \
+    __m256i t0 = _mm256_unpacklo_epi64(r0, r1);                         \
+    __m256i t1 = _mm256_unpackhi_epi64(r0, r1);                         \
+    __m256i t2 = _mm256_unpacklo_epi64(r2, r3);                         \
+    __m256i t3 = _mm256_unpackhi_epi64(r2, r3);                         \
+    r0 = _mm256_permute2x128_si256(t0, t2, 0x20);                       \
+    r1 = _mm256_permute2x128_si256(t1, t3, 0x20);                       \
+    r2 = _mm256_permute2x128_si256(t0, t2, 0x31);                       \
+    r3 = _mm256_permute2x128_si256(t1, t3, 0x31);                       \
+}                                                                       \
+while (0)
+
+/* XOR a block of p 64-bit numbers from each of the four inputs into the
+ * interleaved states.
+ */
+static WC_TARGET_AVX2 void Shake_x4_Absorb(__m256i* s,
+                                             const byte* const* d, byte p)
+{
+    __m256i r0, r1, r2, r3;
+    byte i;
+
+    for (i = 0; i + 4 <= p; i += 4) {
+        r0 = _mm256_loadu_si256((const __m256i*)(d[0] + 8 * i));
+        r1 = _mm256_loadu_si256((const __m256i*)(d[1] + 8 * i));
+        r2 = _mm256_loadu_si256((const __m256i*)(d[2] + 8 * i));
+        r3 = _mm256_loadu_si256((const __m256i*)(d[3] + 8 * i));
+        X4_TRANSPOSE(r0, r1, r2, r3);
+        s[i + 0] = _mm256_xor_si256(s[i + 0], r0);
+        s[i + 1] = _mm256_xor_si256(s[i + 1], r1);
+        s[i + 2] = _mm256_xor_si256(s[i + 2], r2);
+        s[i + 3] = _mm256_xor_si256(s[i + 3], r3);
+    }
+    for (; i < p; i++) {
+        s[i] = _mm256_xor_si256(s[i], _mm256_set_epi64x(
+                (long long)Load64BitBigEndian(d[3] + 8 * i),
+                (long long)Load64BitBigEndian(d[2] + 8 * i),
+                (long long)Load64BitBigEndian(d[1] + 8 * i),
+                (long long)Load64BitBigEndian(d[0] + 8 * i)));
+    }
+}
+
+/* Write a block of p 64-bit numbers from the interleaved states to each of
+ * the four outputs.
+ */
+static WC_TARGET_AVX2 void Shake_x4_Squeeze(const __m256i* s,
+                                              byte* const* o, byte p)
+{
+    __m256i r0, r1, r2, r3;
+    ALIGN32 word64 w[4];
+    byte i;
+
+    for (i = 0; i + 4 <= p; i += 4) {
+        r0 = s[i + 0];
+        r1 = s[i + 1];
+        r2 = s[i + 2];
+        r3 = s[i + 3];
+        X4_TRANSPOSE(r0, r1, r2, r3);
+        _mm256_storeu_si256((__m256i*)(o[0] + 8 * i), r0);
+        _mm256_storeu_si256((__m256i*)(o[1] + 8 * i), r1);
+        _mm256_storeu_si256((__m256i*)(o[2] + 8 * i), r2);
+        _mm256_storeu_si256((__m256i*)(o[3] + 8 * i), r3);
+    }
+    for (; i < p; i++) {
+        _mm256_store_si256((__m256i*)w, s[i]);
+        XMEMCPY(o[0] + 8 * i, &w[0], 8);
+        XMEMCPY(o[1] + 8 * i, &w[1], 8);
+        XMEMCPY(o[2] + 8 * i, &w[2], 8);
+        XMEMCPY(o[3] + 8 * i, &w[3], 8);
+    }
+}
+
+/* Absorb four messages of the same length and squeeze the same amount of
+ * output from each, with the four Keccak states interleaved.
+ *
+ * in      Four messages.
+ * inLen   Length of each message.
+ * out     Four output buffers.
+ * outLen  Number of bytes to squeeze into each output buffer.
+ * p       Number of 64-bit numbers in a block of data to process.
+ * block   Block operation on the interleaved states.
+ */
+static WC_TARGET_AVX2 void Shake_x4_Hash(const byte* const* in,
+    word32 inLen, byte* const* out, word32 outLen, byte p,
+    void (*block)(__m256i* s))
+{
+    __m256i s[25];
+    byte t[4][WC_SHAKE128_COUNT * 8];
+    const byte* d[4];
+    byte* o[4];
+    word32 rate = (word32)p * 8;
+    word32 off;
+    word32 n;
+    int i;
+
+    for (i = 0; i < 25; i++)
+        s[i] = _mm256_setzero_si256();
+
+    for (off = 0; inLen - off >= rate; off += rate) {
+        for (i = 0; i < 4; i++)
+            d[i] = in[i] + off;
+        Shake_x4_Absorb(s, d, p);
+        block(s);
+    }
+    n = inLen - off;
+    for (i = 0; i < 4; i++) {
+        if (n > 0)
+            XMEMCPY(t[i], in[i] + off, n);
+        XMEMSET(t[i] + n, 0, rate - n);
+        t[i][n] = 0x1f;
+        t[i][rate - 1] |= 0x80;
+        d[i] = t[i];
+    }
+    Shake_x4_Absorb(s, d, p);
+
+    for (off = 0; off < outLen; off += rate) {
+        block(s);
+        n = outLen - off;
+        if (n >= rate) {
+            for (i = 0; i < 4; i++)
+                o[i] = out[i] + off;
+            Shake_x4_Squeeze(s, o, p);
+        }
+        else {
+            for (i = 0; i < 4; i++)
+                o[i] = t[i];
+            Shake_x4_Squeeze(s, o, p);
+            for (i = 0; i < 4; i++)
+                XMEMCPY(out[i] + off, t[i], n);
+        }
+    }
+
+    ForceZero(t, sizeof(t));
+    ForceZero(s, sizeof(s));
+}
+#endif /* HAVE_INTEL_SHAKE_X4 */
+
+/* Absorb one message and squeeze outLen bytes from the state.
+ *
+ * sha3    wc_Sha3 object to hold the state.
+ * in      Message.
+ * inLen   Length of the message.
+ * out     Output buffer.
+ * outLen  Number of bytes to squeeze.
+ * p       Number of 64-bit numbers in a block of data to process.
+ */
+static void Shake_Hash(wc_Sha3* sha3, const byte* in, word32 inLen, byte* out,
+                       word32 outLen, byte p)
+{
+    word32 rate = (word32)p * 8;
+    word32 n;
+    word32 j;
+    byte i;
+
+    InitSha3(sha3);
+    Sha3Update(sha3, in, inLen, p);
+    XMEMSET(sha3->t + sha3->i, 0, rate - sha3->i);
+    sha3->t[sha3->i]  = 0x1f;
+    sha3->t[rate - 1] |= 0x80;
+    for (i = 0; i < p; i++)
+        sha3->s[i] ^= Load64BitBigEndian(sha3->t + 8 * i);
+
+    while (outLen > 0) {
+        SHA3_BLOCK(sha3->s);
+        n = (outLen < rate) ? outLen : rate;
+    #ifdef BIG_ENDIAN_ORDER
+        for (j = 0; j < n; j++)
+            out[j] = (byte)(sha3->s[j / 8] >> (8 * (j % 8)));
+    #else
+        (void)j;
+        XMEMCPY(out, sha3->s, n);
+    #endif
+        out += n;
+        outLen -= n;
+    }
+}
+
+/* Calculate the SHAKE output of four messages of the same length.
+ *
+ * in      Four messages.
+ * inLen   Length of each message.
+ * out     Four output buffers.
+ * outLen  Number of bytes of output to put in each buffer.
+ * p       Number of 64-bit numbers in a block of data to process.
+ * returns BAD_FUNC_ARG when a pointer is NULL, 0 otherwise.
+ */
+static int Shake_x4(const byte* const* in, word32 inLen, byte* const* out,
+                    word32 outLen, byte p)
+{
+    wc_Sha3 sha3;
+    int i;
+
+    if (in == NULL || out == NULL)
+        return BAD_FUNC_ARG;
+    for (i = 0; i < 4; i++) {
+        if ((in[i] == NULL && inLen > 0) || (out[i] == NULL && outLen > 0))
+            return BAD_FUNC_ARG;
+    }
+
+#ifdef HAVE_INTEL_SHAKE_X4
+    Sha3_SetBlock();
+    if (IS_INTEL_AVX2(intel_flags)) {
+        SAVE_VECTOR_REGISTERS();
+        Shake_x4_Hash(in, inLen, out, outLen, p,
+            IS_INTEL_AVX512(intel_flags) ? BlockSha3_x4_AVX512 :
+                                           BlockSha3_x4_AVX2);
+        RESTORE_VECTOR_REGISTERS();
+        return 0;
+    }
+#endif
+
+    for (i = 0; i < 4; i++)
+        Shake_Hash(&sha3, in[i], inLen, out[i], outLen, p);
+    ForceZero(&sha3, sizeof(sha3));
+
+    return 0;
+}
+
+/* Calculate SHAKE128 of four messages of the same length at once.
+ * On x86_64 with AVX2 the four Keccak states are processed in parallel.
+ *
+ * in      Four messages.
+ * inLen   Length of each message.
+ * out     Four output buffers.
+ * outLen  Number of bytes of output to put in each buffer.
+ * returns BAD_FUNC_ARG when a pointer is NULL, 0 otherwise.
+ */
+int wc_Shake128_x4(const byte* const* in, word32 inLen, byte* const* out,
+                   word32 outLen)
+{
+    return Shake_x4(in, inLen, out, outLen, WC_SHAKE128_COUNT);
+}
+
+/* Calculate SHAKE256 of four messages of the same length at once.
+ * On x86_64 with AVX2 the four Keccak states are processed in parallel.
+ *
+ * in      Four messages.
+ * inLen   Length of each message.
+ * out     Four output buffers.
+ * outLen  Number of bytes of output to put in each buffer.
+ * returns BAD_FUNC_ARG when a pointer is NULL, 0 otherwise.
+ */
+int wc_Shake256_x4(const byte* const* in, word32 inLen, byte* const* out,
+                   word32 outLen)
+{
+    return Shake_x4(in, inLen, out, outLen, WC_SHAKE256_COUNT);
+}
+#endif /* WOLFSSL_SHAKE_X4 */
+
 #endif /* WOLFSSL_SHA3 */
@@ -2033,6 +2033,78 @@ int wolfSSL_CryptHwMutexUnLock(void)
 
 #endif
 
+#ifdef WOLFSSL_USE_RWLOCK
+
+int wc_InitRwLock(wolfSSL_RwLock* m)
+{
+    if (pthread_rwlock_init(m, NULL) == 0)
+        return 0;
+    else
+        return BAD_MUTEX_E;
+}
+
+int wc_FreeRwLock(wolfSSL_RwLock* m)
+{
+    if (pthread_rwlock_destroy(m) == 0)
+        return 0;
+    else
+        return BAD_MUTEX_E;
+}
+
+int wc_LockRwLock_Rd(wolfSSL_RwLock* m)
+{
+    if (pthread_rwlock_rdlock(m) == 0)
+        return 0;
+    else
+        return BAD_MUTEX_E;
+}
+
+int wc_LockRwLock_Wr(wolfSSL_RwLock* m)
+{
+    if (pthread_rwlock_wrlock(m) == 0)
+        return 0;
+    else
+        return BAD_MUTEX_E;
+}
+
+int wc_UnLockRwLock(wolfSSL_RwLock* m)
+{
+    if (pthread_rwlock_unlock(m) == 0)
+        return 0;
+    else
+        return BAD_MUTEX_E;
+}
+
+#else
+
+/* No native rwlock, readers and writers share the mutex */
+int wc_InitRwLock(wolfSSL_RwLock* m)
+{
+    return wc_InitMutex(m);
+}
+
+int wc_FreeRwLock(wolfSSL_RwLock* m)
+{
+    return wc_FreeMutex(m);
+}
+
+int wc_LockRwLock_Rd(wolfSSL_RwLock* m)
+{
+    return wc_LockMutex(m);
+}
+
+int wc_LockRwLock_Wr(wolfSSL_RwLock* m)
+{
+    return wc_LockMutex(m);
+}
+
+int wc_UnLockRwLock(wolfSSL_RwLock* m)
+{
+    return wc_UnLockMutex(m);
+}
+
+#endif /* WOLFSSL_USE_RWLOCK */
+
 #ifndef NO_ASN_TIME
 #if defined(_WIN32_WCE)
 time_t windows_time(time_t* timer)
@@ -65,6 +65,14 @@ int wolfEvent_Poll(WOLF_EVENT* event, WOLF_EVENT_FLAG flags)
         ret = wolfAsync_EventPoll(event, flags);
     }
 #endif /* WOLFSSL_ASYNC_CRYPT */
+#ifdef WOLF_CRYPTO_CB_POOL
+    if (event->type == WOLF_EVENT_TYPE_CRYPTOCB_POOL) {
+        /* completed by the pool worker */
+        ret = 0;
+    }
+#endif
+
+    (void)flags;
 
     return ret;
 }
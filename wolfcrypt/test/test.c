@@ -361,6 +361,7 @@ WOLFSSL_TEST_SUBROUTINE int  sha512_test(void);
 WOLFSSL_TEST_SUBROUTINE int  sha384_test(void);
 WOLFSSL_TEST_SUBROUTINE int  sha3_test(void);
 WOLFSSL_TEST_SUBROUTINE int  shake256_test(void);
+WOLFSSL_TEST_SUBROUTINE int  shake_x4_test(void);
 WOLFSSL_TEST_SUBROUTINE int  hash_test(void);
 WOLFSSL_TEST_SUBROUTINE int  hmac_md5_test(void);
 WOLFSSL_TEST_SUBROUTINE int  hmac_sha_test(void);
@@ -441,9 +442,11 @@ WOLFSSL_TEST_SUBROUTINE int scrypt_test(void);
 #endif
 #ifdef HAVE_BLAKE2
     WOLFSSL_TEST_SUBROUTINE int  blake2b_test(void);
+    WOLFSSL_TEST_SUBROUTINE int  blake2bp_test(void);
 #endif
 #ifdef HAVE_BLAKE2S
     WOLFSSL_TEST_SUBROUTINE int  blake2s_test(void);
+    WOLFSSL_TEST_SUBROUTINE int  blake2sp_test(void);
 #endif
 #ifdef HAVE_LIBZ
     WOLFSSL_TEST_SUBROUTINE int compress_test(void);
@@ -849,6 +852,13 @@ initDefaultName();
         test_pass("SHAKE256 test passed!\n");
 #endif
 
+#ifdef WOLFSSL_SHAKE_X4
+    if ( (ret = shake_x4_test()) != 0)
+        return err_sys("SHAKE x4 test failed!\n", ret);
+    else
+        test_pass("SHAKE x4 test passed!\n");
+#endif
+
     if ( (ret = hash_test()) != 0)
         return err_sys("Hash     test failed!\n", ret);
     else
@@ -866,12 +876,20 @@ initDefaultName();
         return err_sys("BLAKE2b  test failed!\n", ret);
     else
         test_pass("BLAKE2b  test passed!\n");
+    if ( (ret = blake2bp_test()) != 0)
+        return err_sys("BLAKE2bp test failed!\n", ret);
+    else
+        test_pass("BLAKE2bp test passed!\n");
 #endif
 #ifdef HAVE_BLAKE2S
     if ( (ret = blake2s_test()) != 0)
         return err_sys("BLAKE2s  test failed!\n", ret);
     else
         test_pass("BLAKE2s  test passed!\n");
+    if ( (ret = blake2sp_test()) != 0)
+        return err_sys("BLAKE2sp test failed!\n", ret);
+    else
+        test_pass("BLAKE2sp test passed!\n");
 #endif
 
 #ifndef NO_HMAC
@@ -2368,6 +2386,95 @@ WOLFSSL_TEST_SUBROUTINE int blake2b_test(void)
 
     return 0;
 }
+
+#define BLAKE2BP_TESTS 4
+
+/* Empty and 1024-byte inputs, unkeyed and keyed with the bytes 0, 1, 2, ... */
+static const byte blake2bp_vec[BLAKE2BP_TESTS][BLAKE2B_OUTBYTES] =
+{
+  {
+    0xB5, 0xEF, 0x81, 0x1A, 0x80, 0x38, 0xF7, 0x0B,
+    0x62, 0x8F, 0xA8, 0xB2, 0x94, 0xDA, 0xAE, 0x74,
+    0x92, 0xB1, 0xEB, 0xE3, 0x43, 0xA8, 0x0E, 0xAA,
+    0xBB, 0xF1, 0xF6, 0xAE, 0x66, 0x4D, 0xD6, 0x7B,
+    0x9D, 0x90, 0xB0, 0x12, 0x07, 0x91, 0xEA, 0xB8,
+    0x1D, 0xC9, 0x69, 0x85, 0xF2, 0x88, 0x49, 0xF6,
+    0xA3, 0x05, 0x18, 0x6A, 0x85, 0x50, 0x1B, 0x40,
+    0x51, 0x14, 0xBF, 0xA6, 0x78, 0xDF, 0x93, 0x80
+  },
+  {
+    0x9D, 0x94, 0x61, 0x07, 0x3E, 0x4E, 0xB6, 0x40,
+    0xA2, 0x55, 0x35, 0x7B, 0x83, 0x9F, 0x39, 0x4B,
+    0x83, 0x8C, 0x6F, 0xF5, 0x7C, 0x9B, 0x68, 0x6A,
+    0x3F, 0x76, 0x10, 0x7C, 0x10, 0x66, 0x72, 0x8F,
+    0x3C, 0x99, 0x56, 0xBD, 0x78, 0x5C, 0xBC, 0x3B,
+    0xF7, 0x9D, 0xC2, 0xAB, 0x57, 0x8C, 0x5A, 0x0C,
+    0x06, 0x3B, 0x9D, 0x9C, 0x40, 0x58, 0x48, 0xDE,
+    0x1D, 0xBE, 0x82, 0x1C, 0xD0, 0x5C, 0x94, 0x0A
+  },
+  {
+    0x98, 0xB6, 0xDE, 0x75, 0xC4, 0x2E, 0x1E, 0x5C,
+    0xDD, 0x66, 0x23, 0xAC, 0xA4, 0x7A, 0x1A, 0x35,
+    0x9E, 0x9A, 0xEF, 0x84, 0xF1, 0x0D, 0x6B, 0xF1,
+    0x25, 0x09, 0x33, 0x31, 0xD9, 0xF5, 0xC6, 0x3F,
+    0xC7, 0xA2, 0x90, 0x8B, 0x66, 0xF5, 0x1B, 0xF0,
+    0x68, 0xDD, 0x21, 0x3B, 0x90, 0xF7, 0x2F, 0xB1,
+    0x3D, 0xA8, 0xD7, 0xD3, 0x7C, 0xC7, 0xB0, 0x20,
+    0x18, 0x8D, 0xF4, 0x51, 0xFF, 0xD3, 0x26, 0x84
+  },
+  {
+    0x86, 0x8A, 0x4B, 0xE4, 0x29, 0xBF, 0xE1, 0x26,
+    0x79, 0x6F, 0x52, 0x80, 0x04, 0xB9, 0x9B, 0xB7,
+    0x9B, 0x3C, 0xB1, 0x49, 0x77, 0x1E, 0x8D, 0x9F,
+    0x0D, 0x96, 0x2E, 0x39, 0xD5, 0x8D, 0xB1, 0xC2,
+    0x8D, 0x42, 0xDC, 0xF2, 0x3E, 0xAE, 0xD7, 0x36,
+    0x1F, 0xE1, 0xAE, 0x8B, 0xC1, 0x82, 0xA7, 0xE0,
+    0x36, 0x35, 0x2B, 0xF5, 0x71, 0x97, 0x6D, 0x2B,
+    0xFD, 0x63, 0xE9, 0x2D, 0x92, 0x0B, 0xB4, 0x9A
+  }
+};
+
+WOLFSSL_TEST_SUBROUTINE int blake2bp_test(void)
+{
+    Blake2bp b2bp;
+    byte     digest[64];
+    byte     key[64];
+    byte     input[1024];
+    word32   j, sz;
+    int      i, ret;
+
+    for (i = 0; i < (int)sizeof(key); i++)
+        key[i] = (byte)i;
+    for (i = 0; i < (int)sizeof(input); i++)
+        input[i] = (byte)i;
+
+    for (i = 0; i < BLAKE2BP_TESTS; i++) {
+        sz = (i < 2) ? 0 : (word32)sizeof(input);
+
+        ret = wc_InitBlake2bp_WithKey(&b2bp, 64, (i & 1) ? key : NULL,
+                                     (i & 1) ? (word32)sizeof(key) : 0);
+        if (ret != 0)
+            return -2040 - i;
+
+        /* Odd sized pieces so the 4 leaves are fed across block edges */
+        for (j = 0; j < sz; j += 100) {
+            ret = wc_Blake2bpUpdate(&b2bp, input + j,
+                                    (sz - j < 100) ? sz - j : 100);
+            if (ret != 0)
+                return -2050 - i;
+        }
+
+        ret = wc_Blake2bpFinal(&b2bp, digest, 64);
+        if (ret != 0)
+            return -2060 - i;
+
+        if (XMEMCMP(digest, blake2bp_vec[i], 64) != 0) {
+            return -2070 - i;
+        }
+    }
+
+    return 0;
+}
 #endif /* HAVE_BLAKE2 */
 
 #ifdef HAVE_BLAKE2S
@@ -2429,6 +2536,79 @@ WOLFSSL_TEST_SUBROUTINE int blake2s_test(void)
 
     return 0;
 }
+
+#define BLAKE2SP_TESTS 4
+
+/* Empty and 1024-byte inputs, unkeyed and keyed with the bytes 0, 1, 2, ... */
+static const byte blake2sp_vec[BLAKE2SP_TESTS][BLAKE2S_OUTBYTES] =
+{
+  {
+    0xDD, 0x0E, 0x89, 0x17, 0x76, 0x93, 0x3F, 0x43,
+    0xC7, 0xD0, 0x32, 0xB0, 0x8A, 0x91, 0x7E, 0x25,
+    0x74, 0x1F, 0x8A, 0xA9, 0xA1, 0x2C, 0x12, 0xE1,
+    0xCA, 0xC8, 0x80, 0x15, 0x00, 0xF2, 0xCA, 0x4F
+  },
+  {
+    0x71, 0x5C, 0xB1, 0x38, 0x95, 0xAE, 0xB6, 0x78,
+    0xF6, 0x12, 0x41, 0x60, 0xBF, 0xF2, 0x14, 0x65,
+    0xB3, 0x0F, 0x4F, 0x68, 0x74, 0x19, 0x3F, 0xC8,
+    0x51, 0xB4, 0x62, 0x10, 0x43, 0xF0, 0x9C, 0xC6
+  },
+  {
+    0xC9, 0xF7, 0x91, 0x71, 0xD1, 0x9C, 0x37, 0x03,
+    0xB7, 0xEB, 0xF9, 0xF7, 0x62, 0xCE, 0x3F, 0xD2,
+    0x4B, 0x30, 0x2E, 0x22, 0x81, 0xF7, 0x2D, 0xA3,
+    0x1A, 0x65, 0x01, 0x4F, 0xF9, 0x23, 0xC8, 0x59
+  },
+  {
+    0x70, 0xF4, 0x61, 0xC5, 0x06, 0x64, 0x94, 0xB5,
+    0xEB, 0x28, 0xA9, 0x59, 0xEF, 0xA3, 0xA9, 0x19,
+    0x1A, 0x5E, 0x52, 0x64, 0x2E, 0x6F, 0x5B, 0x5F,
+    0x22, 0xC7, 0x51, 0x92, 0x72, 0x39, 0xD4, 0x60
+  }
+};
+
+WOLFSSL_TEST_SUBROUTINE int blake2sp_test(void)
+{
+    Blake2sp b2sp;
+    byte     digest[32];
+    byte     key[32];
+    byte     input[1024];
+    word32   j, sz;
+    int      i, ret;
+
+    for (i = 0; i < (int)sizeof(key); i++)
+        key[i] = (byte)i;
+    for (i = 0; i < (int)sizeof(input); i++)
+        input[i] = (byte)i;
+
+    for (i = 0; i < BLAKE2SP_TESTS; i++) {
+        sz = (i < 2) ? 0 : (word32)sizeof(input);
+
+        ret = wc_InitBlake2sp_WithKey(&b2sp, 32, (i & 1) ? key : NULL,
+                                     (i & 1) ? (word32)sizeof(key) : 0);
+        if (ret != 0)
+            return -2140 - i;
+
+        /* Odd sized pieces so the 8 leaves are fed across block edges */
+        for (j = 0; j < sz; j += 100) {
+            ret = wc_Blake2spUpdate(&b2sp, input + j,
+                                    (sz - j < 100) ? sz - j : 100);
+            if (ret != 0)
+                return -2150 - i;
+        }
+
+        ret = wc_Blake2spFinal(&b2sp, digest, 32);
+        if (ret != 0)
+            return -2160 - i;
+
+        if (XMEMCMP(digest, blake2sp_vec[i], 32) != 0) {
+            return -2170 - i;
+        }
+    }
+
+    return 0;
+}
 #endif /* HAVE_BLAKE2S */
 
 
@@ -2610,6 +2790,66 @@ WOLFSSL_TEST_SUBROUTINE int sha256_test(void)
         ERROR_OUT(-2310, exit);
     } /* END LARGE HASH TEST */
 
+#ifdef WOLFSSL_SHA256_MULTI_BUFFER
+    /* BEGIN MULTI-BUFFER TEST */ {
+    /* more messages than lanes, of mixed lengths and some with data already
+     * buffered, checked against hashing each one on its own */
+    #define SHA256_MB_TEST_CNT 21
+    wc_Sha256* mbSha;
+    wc_Sha256* mbPtr[SHA256_MB_TEST_CNT];
+    const byte* mbData[SHA256_MB_TEST_CNT];
+    word32     mbLen[SHA256_MB_TEST_CNT];
+    byte       mbHash[SHA256_MB_TEST_CNT][WC_SHA256_DIGEST_SIZE];
+    byte*      mbOut[SHA256_MB_TEST_CNT];
+    byte       mbInput[1024];
+    word32     pre;
+
+    for (i = 0; i < (int)sizeof(mbInput); i++) {
+        mbInput[i] = (byte)(i * 7 + 3);
+    }
+    mbSha = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256) * SHA256_MB_TEST_CNT,
+                                HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (mbSha == NULL)
+        ERROR_OUT(-2311, exit);
+    for (i = 0; i < SHA256_MB_TEST_CNT; i++) {
+        pre = (i % 3 == 0) ? (word32)(i * 11) % WC_SHA256_BLOCK_SIZE : 0;
+        mbPtr[i]  = &mbSha[i];
+        mbData[i] = mbInput + pre;
+        mbLen[i]  = (word32)(i * 151 + 1) % (sizeof(mbInput) - pre);
+        mbOut[i]  = mbHash[i];
+        ret = wc_InitSha256_ex(&mbSha[i], HEAP_HINT, devId);
+        if (ret == 0)
+            ret = wc_Sha256Update(&mbSha[i], mbInput, pre);
+        if (ret != 0)
+            break;
+    }
+    if (ret == 0) {
+        ret = wc_Sha256MultiBuffer(mbPtr, mbData, mbLen, mbOut,
+                                   SHA256_MB_TEST_CNT);
+        if (ret != 0)
+            ret = -2312;
+    }
+    else
+        ret = -2313;
+    for (i = 0; ret == 0 && i < SHA256_MB_TEST_CNT; i++) {
+        pre = (word32)(mbData[i] - mbInput);
+        ret = wc_Sha256Update(&sha, mbInput, pre + mbLen[i]);
+        if (ret == 0)
+            ret = wc_Sha256Final(&sha, hash);
+        if (ret != 0)
+            ret = -2314;
+        else if (XMEMCMP(hash, mbHash[i], WC_SHA256_DIGEST_SIZE) != 0)
+            ret = -2315;
+    }
+    for (i = 0; i < SHA256_MB_TEST_CNT; i++) {
+        wc_Sha256Free(&mbSha[i]);
+    }
+    XFREE(mbSha, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (ret != 0)
+        goto exit;
+    } /* END MULTI-BUFFER TEST */
+#endif /* WOLFSSL_SHA256_MULTI_BUFFER */
+
 exit:
 
     wc_Sha256Free(&sha);
@@ -3383,6 +3623,102 @@ exit:
 #endif
 }
 #endif
+#ifdef WOLFSSL_SHAKE_X4
+WOLFSSL_TEST_SUBROUTINE int shake_x4_test(void)
+{
+    int ret = 0;
+    int i, j;
+    byte msg[4][200];
+    byte hash[4][300];
+    const byte* in[4];
+    byte* out[4];
+    const byte emptyHash[2][32] = {
+        {
+        0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d,
+        0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e,
+        0xd7, 0x3b, 0x80, 0x93, 0xf6, 0xef, 0xbc, 0x88,
+        0xeb, 0x1a, 0x6e, 0xac, 0xfa, 0x66, 0xef, 0x26
+        },
+        {
+        0x46, 0xb9, 0xdd, 0x2b, 0x0b, 0xa8, 0x8d, 0x13,
+        0x23, 0x3b, 0x3f, 0xeb, 0x74, 0x3e, 0xeb, 0x24,
+        0x3f, 0xcd, 0x52, 0xea, 0x62, 0xb8, 0x1b, 0x82,
+        0xb5, 0x0c, 0x27, 0x64, 0x6e, 0xd5, 0x76, 0x2f
+        }
+    };
+    /* First 16 bytes of each lane's output. */
+    const byte heads[2][4][16] = {
+        {
+        { 0x0c, 0x42, 0x34, 0xca, 0x1e, 0x31, 0x80, 0x1a,
+          0xe6, 0x06, 0xf8, 0xb8, 0xd8, 0xe0, 0x66, 0x5c },
+        { 0xae, 0x6c, 0x17, 0x7b, 0x32, 0xa1, 0x88, 0x26,
+          0xe6, 0xfc, 0xc4, 0x23, 0x31, 0xbb, 0x88, 0xb9 },
+        { 0x64, 0x92, 0x4e, 0x7a, 0x83, 0xe6, 0x7b, 0x7b,
+          0xcb, 0xbb, 0xd4, 0xf1, 0xdc, 0x81, 0xfd, 0x21 },
+        { 0xb8, 0x41, 0x8b, 0xd5, 0x93, 0xa7, 0x2a, 0x11,
+          0x9e, 0x39, 0xaf, 0xc5, 0x65, 0x33, 0xd7, 0xc9 }
+        },
+        {
+        { 0x4e, 0xe1, 0xca, 0x03, 0x27, 0x2b, 0x05, 0xd3,
+          0xbf, 0xb1, 0xe1, 0xc7, 0x9a, 0x96, 0x7f, 0x82 },
+        { 0xc0, 0xcb, 0xb3, 0x5a, 0x19, 0x0e, 0x6f, 0xf5,
+          0xc3, 0x0c, 0x31, 0x87, 0x50, 0x00, 0x23, 0x0c },
+        { 0x9a, 0x03, 0xe1, 0x21, 0xea, 0x69, 0x33, 0xbd,
+          0x4a, 0x5d, 0x4b, 0x22, 0xce, 0x89, 0x59, 0x28 },
+        { 0xfa, 0xf8, 0x7f, 0x63, 0x3a, 0x3f, 0x7e, 0x4b,
+          0xbb, 0x3a, 0x6a, 0x40, 0x23, 0x0c, 0xfd, 0x67 }
+        }
+    };
+    /* Last 16 bytes of lane 0's output - squeezed from the third block. */
+    const byte tails[2][16] = {
+        { 0x08, 0x60, 0x95, 0xb9, 0x43, 0x3e, 0x06, 0xa8,
+          0x4f, 0x60, 0x9a, 0x0c, 0x91, 0x79, 0x3c, 0xc7 },
+        { 0x4f, 0x3f, 0x0c, 0xce, 0xdf, 0xa0, 0x5b, 0x29,
+          0xe8, 0x4e, 0x1a, 0x11, 0xa6, 0x35, 0xbf, 0xe7 }
+    };
+
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < (int)sizeof(msg[i]); j++)
+            msg[i][j] = (byte)(j + i);
+        in[i] = msg[i];
+        out[i] = hash[i];
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (i == 0)
+            ret = wc_Shake128_x4(in, 0, out, 32);
+        else
+            ret = wc_Shake256_x4(in, 0, out, 32);
+        if (ret != 0)
+            return -3110;
+        for (j = 0; j < 4; j++) {
+            if (XMEMCMP(hash[j], emptyHash[i], 32) != 0)
+                return -3111;
+        }
+
+        if (i == 0)
+            ret = wc_Shake128_x4(in, sizeof(msg[0]), out, sizeof(hash[0]));
+        else
+            ret = wc_Shake256_x4(in, sizeof(msg[0]), out, sizeof(hash[0]));
+        if (ret != 0)
+            return -3112;
+        for (j = 0; j < 4; j++) {
+            if (XMEMCMP(hash[j], heads[i][j], 16) != 0)
+                return -3113;
+        }
+        if (XMEMCMP(hash[0] + sizeof(hash[0]) - 16, tails[i], 16) != 0)
+            return -3114;
+    }
+
+    if (wc_Shake128_x4(NULL, 0, out, 32) != BAD_FUNC_ARG)
+        return -3115;
+    out[3] = NULL;
+    if (wc_Shake256_x4(in, 0, out, 32) != BAD_FUNC_ARG)
+        return -3116;
+
+    return 0;
+}
+#endif
 
 
 WOLFSSL_TEST_SUBROUTINE int hash_test(void)
@@ -6158,6 +6494,78 @@ WOLFSSL_TEST_SUBROUTINE int chacha20_poly1305_aead_test(void)
         return -4956;
     }
 
+    /* Long messages - one-shot (single pass) against init/update/final */
+    {
+        static const word32 longLen[] = { 1300, 2048 };
+        byte* longPlain;
+        byte* longCipher;
+        byte* longCheck;
+        word32 i;
+        int j;
+
+        longPlain = (byte*)XMALLOC(3 * 2048, HEAP_HINT,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        if (longPlain == NULL)
+            return -4957;
+        longCipher = longPlain + 2048;
+        longCheck = longCipher + 2048;
+        for (i = 0; i < 2048; i++)
+            longPlain[i] = (byte)i;
+
+        for (j = 0; err == 0 && j < (int)(sizeof(longLen) / sizeof(word32));
+                                                                         j++) {
+            err = wc_ChaCha20Poly1305_Encrypt(key2, iv2, aad2, sizeof(aad2),
+                longPlain, longLen[j], longCipher, generatedAuthTag);
+            if (err != 0) {
+                err = -4958;
+                break;
+            }
+            err = wc_ChaCha20Poly1305_Init(&aead, key2, iv2,
+                CHACHA20_POLY1305_AEAD_ENCRYPT);
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_UpdateAad(&aead, aad2, sizeof(aad2));
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_UpdateData(&aead, longPlain,
+                    longCheck, longLen[j]);
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_Final(&aead, generatedPlaintext);
+            if (err != 0) {
+                err = -4959;
+                break;
+            }
+            if (XMEMCMP(longCipher, longCheck, longLen[j]) != 0 ||
+                    XMEMCMP(generatedAuthTag, generatedPlaintext,
+                        CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE) != 0) {
+                err = -4960;
+                break;
+            }
+
+            /* in-place decrypt */
+            err = wc_ChaCha20Poly1305_Decrypt(key2, iv2, aad2, sizeof(aad2),
+                longCheck, longLen[j], generatedAuthTag, longCheck);
+            if (err != 0) {
+                err = -4961;
+                break;
+            }
+            if (XMEMCMP(longCheck, longPlain, longLen[j]) != 0) {
+                err = -4962;
+                break;
+            }
+
+            /* modified ciphertext fails */
+            longCipher[longLen[j] - 1] ^= 1;
+            err = wc_ChaCha20Poly1305_Decrypt(key2, iv2, aad2, sizeof(aad2),
+                longCipher, longLen[j], generatedAuthTag, longCheck);
+            if (err != MAC_CMP_FAILED_E) {
+                err = -4963;
+                break;
+            }
+            err = 0;
+        }
+
+        XFREE(longPlain, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+
     return err;
 }
 #endif /* HAVE_CHACHA && HAVE_POLY1305 */
@@ -7909,6 +8317,84 @@ static int aes_xts_128_test(void)
     if (XMEMCMP(p2, buf, sizeof(p2)))
         ERROR_OUT(-5416, out);
 
+    /* more blocks than the widest parallel code handles at once, with
+     * stealing, plain text is 0x00, 0x01, ... */
+    {
+        WOLFSSL_SMALL_STACK_STATIC unsigned char cl[] = {
+            0xbd, 0xfa, 0xf1, 0xea, 0xc6, 0x60, 0x83, 0x03,
+            0x0f, 0xe0, 0x23, 0x93, 0x31, 0x77, 0x0b, 0x4a,
+            0x59, 0xf2, 0x88, 0xcf, 0x48, 0xb6, 0xe9, 0xc9,
+            0x48, 0xca, 0x1b, 0x78, 0x87, 0x84, 0x88, 0xd9,
+            0xac, 0x2b, 0xf8, 0xe4, 0xf8, 0x22, 0x39, 0xa7,
+            0x47, 0x98, 0x16, 0xee, 0x32, 0xbd, 0x91, 0x47,
+            0x0c, 0xf3, 0x09, 0x60, 0x0e, 0xf2, 0x87, 0x3b,
+            0x6a, 0x9d, 0x41, 0x23, 0x0b, 0xf8, 0x4b, 0xa4,
+            0x9e, 0x4c, 0x7f, 0x4e, 0x8c, 0x71, 0xff, 0x34,
+            0x7d, 0x0c, 0x87, 0x3d, 0x5c, 0x6a, 0x57, 0x25,
+            0x3b, 0x7d, 0x7c, 0x82, 0x04, 0x19, 0x4c, 0x6e,
+            0x3e, 0x7b, 0xc3, 0xf7, 0x2b, 0xee, 0x26, 0x87,
+            0x10, 0x9b, 0x27, 0xdd, 0x27, 0xb7, 0x1a, 0xab,
+            0xc2, 0xf6, 0xfa, 0xf8, 0x7c, 0xd2, 0xea, 0xc1,
+            0x36, 0x8b, 0x54, 0x16, 0xa8, 0xf9, 0x55, 0x5a,
+            0x6c, 0xf4, 0xeb, 0x39, 0x9f, 0x8d, 0xc7, 0xbd,
+            0x11, 0xa5, 0xa6, 0xcf, 0xd6, 0xb8, 0xd0, 0xdb,
+            0x55, 0xbb, 0x94, 0x55, 0xa3, 0xfc, 0x07, 0x8e,
+            0x9e, 0x6d, 0x7c, 0x09, 0xa5, 0x33, 0x8e, 0x01,
+            0xc3, 0x74, 0x2b, 0xfb, 0xce, 0x76, 0xb7, 0x23,
+            0x08, 0x50, 0xd7, 0xbe, 0x28, 0x4a, 0x88, 0x26,
+            0xb6, 0xb8, 0xc5, 0xae, 0x15, 0xbb, 0xf0, 0xff,
+            0x71, 0xb0, 0x30, 0x95, 0x57, 0xcc, 0x92, 0x12,
+            0x75, 0x04, 0x05, 0x4d, 0x36, 0xb5, 0xc9, 0x32,
+            0x66, 0x2b, 0x12, 0xcd, 0xcc, 0x92, 0xeb, 0xd8,
+            0xc1, 0x5d, 0x60, 0x7f, 0xf0, 0x73, 0x57, 0x9b,
+            0x0b, 0x95, 0xb7, 0x1b, 0x68, 0x47, 0xae, 0x94,
+            0xbe, 0x60, 0x26, 0x8a, 0x49, 0x90, 0x31, 0xdb,
+            0xbd, 0x75, 0xd4, 0xfe, 0xc4, 0x6e, 0xf6, 0x65,
+            0x68, 0xd0, 0xe8, 0x37, 0x22, 0xb9, 0x69, 0xc1,
+            0xf1, 0x1c, 0x55, 0x44, 0xde, 0xa1, 0x35, 0x2f,
+            0xd9, 0x23, 0x43, 0x5f, 0xc3, 0x56, 0x4a, 0x55,
+            0x80, 0xe9, 0x52, 0xbc, 0x5a, 0x63, 0x7f, 0xd3,
+            0x56, 0x9b, 0x6e, 0x8c, 0x09, 0xac, 0x23, 0x41,
+            0xeb, 0xf1, 0x2b, 0xa7, 0x07, 0x12, 0x28
+        };
+        unsigned char large[sizeof(cl)];
+        unsigned char largeCipher[sizeof(cl)];
+        word32 j;
+
+        for (j = 0; j < sizeof(large); j++)
+            large[j] = (unsigned char)j;
+        wc_AesXtsFree(aes);
+        if (wc_AesXtsSetKey(aes, k1, sizeof(k1), AES_ENCRYPTION,
+                HEAP_HINT, devId) != 0)
+            ERROR_OUT(-5418, out);
+        ret = wc_AesXtsEncrypt(aes, largeCipher, large, sizeof(large), i1,
+                sizeof(i1));
+    #if defined(WOLFSSL_ASYNC_CRYPT)
+        ret = wc_AsyncWait(ret, &aes->aes.asyncDev, WC_ASYNC_FLAG_NONE);
+    #endif
+        if (ret != 0)
+            ERROR_OUT(-5419, out);
+        if (XMEMCMP(cl, largeCipher, sizeof(cl)))
+            ERROR_OUT(-5420, out);
+        wc_AesXtsFree(aes);
+
+        XMEMSET(large, 0, sizeof(large));
+        if (wc_AesXtsSetKey(aes, k1, sizeof(k1), AES_DECRYPTION,
+                HEAP_HINT, devId) != 0)
+            ERROR_OUT(-5421, out);
+        ret = wc_AesXtsDecrypt(aes, large, largeCipher, sizeof(large), i1,
+                sizeof(i1));
+    #if defined(WOLFSSL_ASYNC_CRYPT)
+        ret = wc_AsyncWait(ret, &aes->aes.asyncDev, WC_ASYNC_FLAG_NONE);
+    #endif
+        if (ret != 0)
+            ERROR_OUT(-5422, out);
+        for (j = 0; j < sizeof(large); j++) {
+            if (large[j] != (unsigned char)j)
+                ERROR_OUT(-5423, out);
+        }
+    }
+
   out:
 
     if (aes_inited)
@@ -8894,6 +9380,50 @@ WOLFSSL_TEST_SUBROUTINE int aes_test(void)
         if (XMEMCMP(ctr256Cipher, cipher, sizeof(ctr256Cipher)))
             ERROR_OUT(-5942, out);
 #endif /* WOLFSSL_AES_256 */
+
+#ifdef WOLFSSL_AES_128
+        {
+            /* more than eight blocks of key stream with the carry out of the
+             * low 64 bits of the counter in the middle */
+            WOLFSSL_SMALL_STACK_STATIC const byte ctrWrapIv[] =
+            {
+                0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,
+                0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xfc
+            };
+            WOLFSSL_SMALL_STACK_STATIC const byte ctrWrapStream[] =
+            {
+            0x63,0xd9,0x0a,0xb8,0x9e,0x74,0xe8,0xbd,
+            0x4d,0xb4,0x79,0x34,0xfa,0x84,0x2c,0x24,
+            0x0a,0x9a,0x9b,0x6f,0xd8,0x33,0x3b,0xd8,
+            0xd0,0x9a,0xc9,0x6f,0xe4,0xce,0xf2,0x47,
+            0x6b,0xbc,0x64,0x38,0xbc,0x53,0x82,0x2f,
+            0x44,0x9e,0xdc,0xa1,0x5c,0x5e,0x02,0x1c,
+            0x9e,0x58,0x2c,0x69,0x9d,0xdc,0x00,0x85,
+            0xc0,0xd3,0x6b,0x60,0xe1,0x4c,0x06,0xd0,
+            0xd4,0xcc,0xbe,0xd3,0x8d,0xf0,0x3f,0x15,
+            0x6b,0x7a,0x8a,0x31,0x96,0x6d,0x9c,0x0f,
+            0x0c,0x2e,0x33,0x8d,0x39,0x41,0xb7,0xcc,
+            0x33,0xba,0xd5,0x14,0xeb,0x77,0x3a,0xee,
+            0x87,0x34,0x6c,0xeb,0xf0,0x20,0xbe,0x99,
+            0x85,0x3a,0x19,0xdb,0x93,0x19,0x00,0xf0,
+            0xb5,0xb0,0xe1,0xfd,0x4a,0xf4,0x99,0x54,
+            0x43,0xf8,0x31,0xd9,0xe8,0xb7,0x32,0xca,
+            0x43,0x80,0x41,0x2c,0x76,0x94,0xbc,0x55,
+            0x8c,0xc1,0x2b,0x69,0x8f,0x59,0x1a,0x75
+            };
+            byte stream[sizeof(ctrWrapStream)];
+
+            wc_AesSetKeyDirect(enc, ctr128Key, sizeof(ctr128Key),
+                               ctrWrapIv, AES_ENCRYPTION);
+            XMEMSET(stream, 0, sizeof(stream));
+            ret = wc_AesCtrEncrypt(enc, stream, stream, sizeof(stream));
+            if (ret != 0) {
+                ERROR_OUT(-5950, out);
+            }
+            if (XMEMCMP(stream, ctrWrapStream, sizeof(ctrWrapStream)))
+                ERROR_OUT(-5951, out);
+        }
+#endif /* WOLFSSL_AES_128 */
     }
 #endif /* WOLFSSL_AES_COUNTER */
 
@@ -9631,16 +10161,22 @@ WOLFSSL_TEST_SUBROUTINE int aesgcm_test(void)
     #if !defined(BENCH_AESGCM_LARGE)
         #define BENCH_AESGCM_LARGE 1024
     #endif
-    byte *large_input = (byte *)XMALLOC(BENCH_AESGCM_LARGE, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
-    byte *large_output = (byte *)XMALLOC(BENCH_AESGCM_LARGE + AES_BLOCK_SIZE, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
-    byte *large_outdec = (byte *)XMALLOC(BENCH_AESGCM_LARGE, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    /* the known answer tests below also need room for 1100 bytes */
+    #if BENCH_AESGCM_LARGE > 1100
+        #define AESGCM_LARGE_SZ BENCH_AESGCM_LARGE
+    #else
+        #define AESGCM_LARGE_SZ 1100
+    #endif
+    byte *large_input = (byte *)XMALLOC(AESGCM_LARGE_SZ, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    byte *large_output = (byte *)XMALLOC(AESGCM_LARGE_SZ + AES_BLOCK_SIZE, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    byte *large_outdec = (byte *)XMALLOC(AESGCM_LARGE_SZ, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
 
     if ((! large_input) || (! large_output) || (! large_outdec))
         ERROR_OUT(MEMORY_E, out);
 
-    XMEMSET(large_input, 0, BENCH_AESGCM_LARGE);
-    XMEMSET(large_output, 0, BENCH_AESGCM_LARGE + AES_BLOCK_SIZE);
-    XMEMSET(large_outdec, 0, BENCH_AESGCM_LARGE);
+    XMEMSET(large_input, 0, AESGCM_LARGE_SZ);
+    XMEMSET(large_output, 0, AESGCM_LARGE_SZ + AES_BLOCK_SIZE);
+    XMEMSET(large_outdec, 0, AESGCM_LARGE_SZ);
 #endif
 
 #ifdef WOLFSSL_SMALL_STACK
@@ -9700,7 +10236,7 @@ WOLFSSL_TEST_SUBROUTINE int aesgcm_test(void)
     /* Large buffer test */
 #ifdef BENCH_AESGCM_LARGE
     /* setup test buffer */
-    for (alen=0; alen<BENCH_AESGCM_LARGE; alen++)
+    for (alen=0; alen<AESGCM_LARGE_SZ; alen++)
         large_input[alen] = (byte)alen;
 
     /* AES-GCM encrypt and decrypt both use AES encrypt internally */
@@ -9712,6 +10248,19 @@ WOLFSSL_TEST_SUBROUTINE int aesgcm_test(void)
 #endif
     if (result != 0)
         ERROR_OUT(-6309, out);
+#if BENCH_AESGCM_LARGE == 1024
+    {
+        /* known tag, the message is long enough for the widest code */
+        WOLFSSL_SMALL_STACK_STATIC const byte tl[] =
+        {
+            0xed, 0x5f, 0xe1, 0x8a, 0xf2, 0xda, 0xae, 0xd7,
+            0x93, 0x2a, 0x10, 0xe2, 0x98, 0xf8, 0xda, 0x86
+        };
+
+        if (XMEMCMP(resultT, tl, sizeof(tl)))
+            ERROR_OUT(-6344, out);
+    }
+#endif
 
 #ifdef HAVE_AES_DECRYPT
     result = wc_AesGcmDecrypt(dec, large_outdec, large_output,
@@ -9725,6 +10274,60 @@ WOLFSSL_TEST_SUBROUTINE int aesgcm_test(void)
     if (XMEMCMP(large_input, large_outdec, BENCH_AESGCM_LARGE))
         ERROR_OUT(-6311, out);
 #endif /* HAVE_AES_DECRYPT */
+
+    /* Known tags for lengths that end in a partial group of blocks (1040) and
+     * a partial block (1100), with AAD that is not a multiple of the block
+     * size. */
+    {
+        WOLFSSL_SMALL_STACK_STATIC const byte tl1040[] =
+        {
+            0x8b, 0x72, 0xf1, 0x27, 0xaa, 0xae, 0x9a, 0x5b,
+            0x0b, 0x77, 0x75, 0xd3, 0xfa, 0x82, 0x07, 0x3a
+        };
+        WOLFSSL_SMALL_STACK_STATIC const byte tl1100[] =
+        {
+            0xca, 0xb5, 0x7c, 0xe7, 0x58, 0x18, 0x86, 0xd7,
+            0x01, 0x22, 0x68, 0x2e, 0x19, 0xbe, 0xac, 0x09
+        };
+        const byte* kat_aad[2];
+        const byte* kat_tag[2];
+        word32 kat_aadSz[2] = { (word32)sizeof(a), 77 };
+        word32 kat_sz[2] = { 1040, 1100 };
+        int i;
+
+        kat_aad[0] = a;
+        kat_aad[1] = large_input;
+        kat_tag[0] = tl1040;
+        kat_tag[1] = tl1100;
+
+        for (i = 0; i < 2; i++) {
+            result = wc_AesGcmEncrypt(enc, large_output, large_input,
+                                      kat_sz[i], iv1, sizeof(iv1), resultT,
+                                      sizeof(resultT), kat_aad[i],
+                                      kat_aadSz[i]);
+        #if defined(WOLFSSL_ASYNC_CRYPT)
+            result = wc_AsyncWait(result, &enc->asyncDev, WC_ASYNC_FLAG_NONE);
+        #endif
+            if (result != 0)
+                ERROR_OUT(-6358, out);
+            if (XMEMCMP(resultT, kat_tag[i], sizeof(resultT)))
+                ERROR_OUT(-6359, out);
+        #ifdef HAVE_AES_DECRYPT
+            XMEMSET(large_outdec, 0, kat_sz[i]);
+            result = wc_AesGcmDecrypt(dec, large_outdec, large_output,
+                                      kat_sz[i], iv1, sizeof(iv1), resultT,
+                                      sizeof(resultT), kat_aad[i],
+                                      kat_aadSz[i]);
+        #if defined(WOLFSSL_ASYNC_CRYPT)
+            result = wc_AsyncWait(result, &dec->asyncDev, WC_ASYNC_FLAG_NONE);
+        #endif
+            if (result != 0)
+                ERROR_OUT(-6360, out);
+            if (XMEMCMP(large_input, large_outdec, kat_sz[i]))
+                ERROR_OUT(-6361, out);
+        #endif /* HAVE_AES_DECRYPT */
+        }
+    }
 #endif /* BENCH_AESGCM_LARGE */
 #if defined(ENABLE_NON_12BYTE_IV_TEST) && defined(WOLFSSL_AES_256)
     /* Variable IV length test */
@@ -9992,6 +10595,113 @@ WOLFSSL_TEST_SUBROUTINE int aesgcm_test(void)
 #endif /* WOLFSSL_AES_256 && !(WC_NO_RNG || HAVE_SELFTEST) */
 #endif /* HAVE_FIPS_VERSION >= 2 */
 
+#if defined(WOLFSSL_AESGCM_STREAM) && defined(WOLFSSL_AES_256)
+    /* Streaming API: AAD and text split at odd places must give the same
+     * result as the one-shot API. */
+    XMEMSET(resultT, 0, sizeof(resultT));
+    XMEMSET(resultC, 0, sizeof(resultC));
+    XMEMSET(resultP, 0, sizeof(resultP));
+
+    result = wc_AesGcmInit(enc, k1, sizeof(k1), iv1, sizeof(iv1));
+    if (result != 0)
+        ERROR_OUT(-6345, out);
+    result = wc_AesGcmEncryptUpdate(enc, NULL, NULL, 0, a, 7);
+    if (result == 0)
+        result = wc_AesGcmEncryptUpdate(enc, resultC, p, 1, a + 7,
+                                        sizeof(a) - 7);
+    if (result == 0)
+        result = wc_AesGcmEncryptUpdate(enc, resultC + 1, p + 1, 17, NULL, 0);
+    if (result == 0)
+        result = wc_AesGcmEncryptUpdate(enc, resultC + 18, p + 18,
+                                        sizeof(p) - 18, NULL, 0);
+    if (result == 0)
+        result = wc_AesGcmEncryptFinal(enc, resultT, sizeof(t1));
+    if (result != 0)
+        ERROR_OUT(-6346, out);
+    if (XMEMCMP(c1, resultC, sizeof(c1)))
+        ERROR_OUT(-6347, out);
+    if (XMEMCMP(t1, resultT, sizeof(t1)))
+        ERROR_OUT(-6348, out);
+
+#ifdef HAVE_AES_DECRYPT
+    /* decrypt in place */
+    XMEMCPY(resultP, c1, sizeof(c1));
+    result = wc_AesGcmInit(dec, k1, sizeof(k1), iv1, sizeof(iv1));
+    if (result == 0)
+        result = wc_AesGcmDecryptUpdate(dec, resultP, resultP, 33, a,
+                                        sizeof(a));
+    if (result == 0)
+        result = wc_AesGcmDecryptUpdate(dec, resultP + 33, resultP + 33,
+                                        sizeof(c1) - 33, NULL, 0);
+    if (result == 0)
+        result = wc_AesGcmDecryptFinal(dec, t1, sizeof(t1));
+    if (result != 0)
+        ERROR_OUT(-6349, out);
+    if (XMEMCMP(p, resultP, sizeof(p)))
+        ERROR_OUT(-6350, out);
+
+    /* a bad tag must fail */
+    resultT[0] ^= 1;
+    result = wc_AesGcmInit(dec, NULL, 0, iv1, sizeof(iv1));
+    if (result == 0)
+        result = wc_AesGcmDecryptUpdate(dec, resultP, c1, sizeof(c1), a,
+                                        sizeof(a));
+    if (result == 0)
+        result = wc_AesGcmDecryptFinal(dec, resultT, sizeof(t1));
+    if (result != AES_GCM_AUTH_E)
+        ERROR_OUT(-6351, out);
+#endif /* HAVE_AES_DECRYPT */
+
+#ifdef BENCH_AESGCM_LARGE
+    /* Long text, enough for the multi-block paths, with an IV that is
+     * not 12 bytes. */
+    {
+        word32 off;
+        word32 chunk;
+
+        result = wc_AesGcmSetKey(enc, k1, sizeof(k1));
+        if (result == 0)
+            result = wc_AesGcmEncrypt(enc, large_output, large_input,
+                                      BENCH_AESGCM_LARGE, p, 13,
+                                      resultT, sizeof(resultT), a, sizeof(a));
+        if (result != 0)
+            ERROR_OUT(-6352, out);
+
+        result = wc_AesGcmInit(enc, NULL, 0, p, 13);
+        if (result == 0)
+            result = wc_AesGcmEncryptUpdate(enc, NULL, NULL, 0, a, sizeof(a));
+        for (off = 0, chunk = 1; result == 0 && off < BENCH_AESGCM_LARGE;
+                                             off += chunk, chunk += 37) {
+            if (chunk > BENCH_AESGCM_LARGE - off)
+                chunk = BENCH_AESGCM_LARGE - off;
+            result = wc_AesGcmEncryptUpdate(enc, large_outdec + off,
+                                     large_input + off, chunk, NULL, 0);
+        }
+        if (result == 0)
+            result = wc_AesGcmEncryptFinal(enc, resultC, sizeof(resultT));
+        if (result != 0)
+            ERROR_OUT(-6353, out);
+        if (XMEMCMP(large_output, large_outdec, BENCH_AESGCM_LARGE))
+            ERROR_OUT(-6354, out);
+        if (XMEMCMP(resultT, resultC, sizeof(resultT)))
+            ERROR_OUT(-6355, out);
+
+    #ifdef HAVE_AES_DECRYPT
+        result = wc_AesGcmInit(dec, k1, sizeof(k1), p, 13);
+        if (result == 0)
+            result = wc_AesGcmDecryptUpdate(dec, large_outdec, large_output,
+                                            BENCH_AESGCM_LARGE, a, sizeof(a));
+        if (result == 0)
+            result = wc_AesGcmDecryptFinal(dec, resultT, sizeof(resultT));
+        if (result != 0)
+            ERROR_OUT(-6356, out);
+        if (XMEMCMP(large_input, large_outdec, BENCH_AESGCM_LARGE))
+            ERROR_OUT(-6357, out);
+    #endif /* HAVE_AES_DECRYPT */
+    }
+#endif /* BENCH_AESGCM_LARGE */
+#endif /* WOLFSSL_AESGCM_STREAM && WOLFSSL_AES_256 */
+
     wc_AesFree(enc);
     wc_AesFree(dec);
 
@@ -10412,6 +11122,62 @@ WOLFSSL_TEST_SUBROUTINE int aesccm_test(void)
     if (result != 0)
         ERROR_OUT(-6526, out);
 
+    /* 7 byte nonce so the counter is 8 bytes, several whole blocks and a
+     * partial one, 16 byte tag, decrypted in place. plain text is 0x00,
+     * 0x01, ... */
+    {
+        WOLFSSL_SMALL_STACK_STATIC const byte n7[] =
+        {
+            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16
+        };
+        WOLFSSL_SMALL_STACK_STATIC const byte c7[] =
+        {
+            0x0a, 0x2d, 0x2b, 0x69, 0x93, 0x44, 0xe0, 0x83,
+            0xe0, 0xbe, 0xa8, 0x47, 0x6b, 0x3c, 0xf3, 0xd2,
+            0x18, 0x34, 0x1e, 0xcb, 0x32, 0xd9, 0xdd, 0xab,
+            0xa1, 0x0a, 0x16, 0x89, 0x2b, 0xbd, 0xc3, 0x4f,
+            0xca, 0x52, 0x82, 0xe4, 0x36, 0xf6, 0xdb, 0x45,
+            0xb9, 0x9c, 0xfa, 0xf0, 0xfa, 0xf1, 0xfa, 0x22,
+            0x8a, 0x4f, 0xee, 0xae, 0x59, 0x2d, 0x7f, 0x66,
+            0x99, 0xa4, 0x00, 0x84, 0x66, 0x31, 0x09, 0x00,
+            0x54, 0x78, 0x8b, 0x88, 0xcd, 0x30, 0xb6, 0x59,
+            0xf0, 0xf9, 0x1f, 0x59, 0xf8, 0x56, 0x8d, 0x61,
+            0x1c, 0x42, 0x50, 0x83, 0xd8, 0x63, 0x8c, 0xba,
+            0xb7, 0x1b, 0x79, 0x21, 0xcf, 0x68, 0xd0, 0xb2,
+            0x0b, 0x8f, 0x17, 0x2a
+        };
+        WOLFSSL_SMALL_STACK_STATIC const byte t7[] =
+        {
+            0x06, 0x12, 0x7a, 0x45, 0x53, 0xfc, 0x7a, 0xe0,
+            0x56, 0xe1, 0x55, 0x92, 0xc5, 0x7a, 0xbe, 0xa7
+        };
+        byte buf7[sizeof(c7)];
+        byte tag7[sizeof(t7)];
+        word32 j;
+
+        for (j = 0; j < sizeof(buf7); j++)
+            buf7[j] = (byte)j;
+        result = wc_AesCcmEncrypt(enc, buf7, buf7, sizeof(buf7), n7,
+                                  sizeof(n7), tag7, sizeof(tag7), a,
+                                  sizeof(a));
+        if (result != 0)
+            ERROR_OUT(-6531, out);
+        if (XMEMCMP(c7, buf7, sizeof(c7)))
+            ERROR_OUT(-6532, out);
+        if (XMEMCMP(t7, tag7, sizeof(t7)))
+            ERROR_OUT(-6533, out);
+
+        result = wc_AesCcmDecrypt(enc, buf7, buf7, sizeof(buf7), n7,
+                                  sizeof(n7), tag7, sizeof(tag7), a,
+                                  sizeof(a));
+        if (result != 0)
+            ERROR_OUT(-6534, out);
+        for (j = 0; j < sizeof(buf7); j++) {
+            if (buf7[j] != (byte)j)
+                ERROR_OUT(-6535, out);
+        }
+    }
+
     ret = 0;
 
   out:
@@ -59,6 +59,9 @@
 #ifdef HAVE_POLY1305
     #include <wolfssl/wolfcrypt/poly1305.h>
 #endif
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+    #include <wolfssl/wolfcrypt/chacha20_poly1305.h>
+#endif
 #ifdef HAVE_CAMELLIA
     #include <wolfssl/wolfcrypt/camellia.h>
 #endif
@@ -1922,11 +1925,54 @@ struct WOLFSSL_CIPHER {
 
 /* wolfSSL OCSP controller */
 #ifdef HAVE_OCSP
+#ifndef OCSP_TABLE_SIZE
+    #define OCSP_TABLE_SIZE 16   /* initial hash rows, must be a power of 2 */
+#endif
+#ifndef OCSP_CACHE_SIZE
+    #define OCSP_CACHE_SIZE 1024 /* max cached responses, 0 for no limit */
+#endif
+
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+#ifndef OCSP_STAPLING_REFRESH_RETRY
+    #define OCSP_STAPLING_REFRESH_RETRY 60    /* seconds until failed fetch
+                                               * is retried */
+#endif
+#ifndef OCSP_STAPLING_REFRESH_DEFAULT
+    #define OCSP_STAPLING_REFRESH_DEFAULT 3600 /* seconds until response
+                                                * without nextUpdate is
+                                                * refreshed */
+#endif
+
+typedef struct OcspStaple OcspStaple;
+
+/* OCSP response of a server certificate kept fresh by the refresh thread */
+struct OcspStaple {
+    OcspStaple*  next;
+    OcspRequest* request;    /* sent on every refresh */
+    byte*        response;   /* DER response, NULL until first fetch */
+    word32       responseSz;
+    int          status;     /* OCSP check result of response */
+    time_t       nextUpdate; /* response is stale after this, 0 for never */
+    time_t       refreshAt;  /* fetch a new response at this time */
+};
+#endif
+
 struct WOLFSSL_OCSP {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
-    OcspEntry*            ocspList;      /* OCSP response list */
+    OcspEntry*            ocspList;      /* OCSP response list, MRU first */
+    OcspEntry*            ocspTail;      /* least recently used response */
+    OcspEntry**           ocspTable;     /* hash rows, one entry per cert */
+    word32                ocspTableSz;   /* number of rows, power of 2 */
+    word32                ocspCount;     /* number of cached responses */
+    word32                ocspMaxCount;  /* cache bound, 0 for no limit */
     wolfSSL_Mutex         ocspLock;      /* OCSP list lock */
     int                   error;
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+    OcspStaple*           staples;       /* responses kept fresh by thread */
+    pthread_cond_t        refreshCond;   /* wakes the refresh thread */
+    pthread_t             refreshTid;    /* refresh thread */
+    int                   refreshStop;   /* refresh thread should exit */
+#endif
 #if defined(OPENSSL_ALL) || defined(OPENSSL_EXTRA) || \
     defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
     int(*statusCb)(WOLFSSL*, void*);
@@ -1994,6 +2040,9 @@ struct WOLFSSL_CRL {
     CRL_Entry*            crlList;       /* our CRL list */
 #ifdef HAVE_CRL_IO
     CbCrlIO               crlIOCb;
+    #ifdef HAVE_HTTP_CLIENT_NONBLOCK
+    WOLFIO_HTTP_NB*       crlNb;         /* nonblocking download in flight */
+    #endif
 #endif
     wolfSSL_Mutex         crlLock;       /* CRL list lock */
     CRL_Monitor           monitors[2];   /* PEM and DER possible */
@@ -2016,7 +2065,48 @@ struct WOLFSSL_CRL {
 
 
 #ifndef CA_TABLE_SIZE
-    #define CA_TABLE_SIZE 11
+    #define CA_TABLE_SIZE 11    /* initial rows, grows with the CA count */
+#endif
+#ifndef CA_TABLE_LOAD
+    #define CA_TABLE_LOAD 2     /* average CAs per row before growing */
+#endif
+#ifndef CA_TABLE_MAX_SIZE
+    #define CA_TABLE_MAX_SIZE (1 << 20)
+#endif
+
+#ifdef WOLFSSL_TRUST_STORE
+#if defined(HAVE_SYS_MMAN_H) && !defined(NO_FILESYSTEM) && \
+    !defined(WOLFSSL_TRUST_STORE_NO_MMAP)
+    #define WOLFSSL_TRUST_STORE_MMAP
+#endif
+
+/* Precompiled trust store attached to a cert manager. Signer keys and names
+ * point into mem, so it lives until the CAs are unloaded. */
+typedef struct TrustStore TrustStore;
+struct TrustStore {
+    TrustStore* next;
+    const byte* mem;
+    word32      sz;
+    byte        owned:1;              /* mem allocated by us */
+    byte        mapped:1;             /* mem mapped from a file */
+};
+#endif /* WOLFSSL_TRUST_STORE */
+
+#ifdef WOLFSSL_PARALLEL_CA_LOAD
+    #if defined(SINGLE_THREADED) || !defined(WOLFSSL_PTHREADS)
+        #error "Parallel CA loading requires pthreads"
+    #endif
+    #ifndef CA_LOAD_THREADS
+        #define CA_LOAD_THREADS 4   /* max worker threads per load */
+    #endif
+#endif
+#if defined(WOLFSSL_PARALLEL_CA_LOAD) || defined(WOLFSSL_LAZY_CA_LOAD)
+    #ifdef WOLFSSL_RENESAS_TSIP_TLS
+        #error "Parallel and lazy CA loading not supported with TSIP"
+    #endif
+    #ifndef CA_LOAD_BATCH
+        #define CA_LOAD_BATCH 16    /* signers added per table lock */
+    #endif
 #endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     #define TP_TABLE_SIZE 11
@@ -2024,7 +2114,18 @@ struct WOLFSSL_CRL {
 
 /* wolfSSL Certificate Manager */
 struct WOLFSSL_CERT_MANAGER {
-    Signer*         caTable[CA_TABLE_SIZE]; /* the CA signer table */
+    Signer**        caTable;             /* CA signers by key id hash */
+#ifndef NO_SKID
+    Signer**        caNameTable;         /* same CA signers by name hash */
+#endif
+    word32          caTableSz;           /* rows in each CA table */
+    word32          caCount;             /* CA signers in the tables */
+#ifdef WOLFSSL_TRUST_STORE
+    TrustStore*     trustStores;         /* attached precompiled stores */
+#endif
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    Signer*         caRetired;           /* lazy CAs that failed to decode */
+#endif
     void*           heap;                /* heap helper */
 #ifdef WOLFSSL_TRUST_PEER_CERT
     TrustedPeerCert* tpTable[TP_TABLE_SIZE]; /* table of trusted peer certs */
@@ -2038,6 +2139,9 @@ struct WOLFSSL_CERT_MANAGER {
 #endif
     char*           ocspOverrideURL;     /* use this responder */
     void*           ocspIOCtx;           /* I/O callback CTX */
+#ifdef HAVE_OCSP
+    word32          ocspCacheSz;         /* max cached OCSP responses */
+#endif
 #ifndef NO_WOLFSSL_CM_VERIFY
     VerifyCallback  verifyCallback;      /* Verify callback */
 #endif
@@ -2045,7 +2149,7 @@ struct WOLFSSL_CERT_MANAGER {
     CbMissingCRL    cbMissingCRL;          /* notify thru cb of missing crl */
     CbOCSPIO        ocspIOCb;              /* I/O callback for OCSP lookup */
     CbOCSPRespFree  ocspRespFreeCb;        /* Frees OCSP Response from IO Cb */
-    wolfSSL_Mutex   caLock;                /* CA list lock */
+    wolfSSL_RwLock  caLock;                /* CA list lock, shared for lookups */
     byte            crlEnabled:1;          /* is CRL on ? */
     byte            crlCheckAll:1;         /* always leaf, but all ? */
     byte            ocspEnabled:1;         /* is OCSP on ? */
@@ -2329,6 +2433,63 @@ WOLFSSL_LOCAL int    TLSX_SNI_GetFromBuffer(const byte* buffer, word32 bufferSz,
                                          byte type, byte* sni, word32* inOutSz);
 #endif
 
+#if defined(WOLFSSL_SNI_TABLE) && !defined(NO_WOLFSSL_SERVER)
+#ifdef NO_CERTS
+    #error WOLFSSL_SNI_TABLE needs certificate support
+#endif
+
+#ifndef SNI_TABLE_SIZE
+    #define SNI_TABLE_SIZE 31   /* initial rows, grows with the name count */
+#endif
+#ifndef SNI_TABLE_LOAD
+    #define SNI_TABLE_LOAD 2    /* average names per row before growing */
+#endif
+#ifndef SNI_TABLE_MAX_SIZE
+    #define SNI_TABLE_MAX_SIZE (1 << 22)
+#endif
+#define SNI_TABLE_NAME_MAX 255  /* longest DNS host name */
+
+/* Server certificate, chain and key for the host names that map to it.
+ * Shared by the table and each WOLFSSL using it, freed by the last one. */
+typedef struct SniCert {
+    DerBuffer*    certificate;
+    DerBuffer*    certChain;        /* after the certificate, size prefixed */
+    DerBuffer*    key;
+    int           certChainCnt;
+    int           keySz;
+    word32        pkCurveOID;
+    int           refCount;
+    wolfSSL_Mutex refMutex;
+    byte          keyType;
+    byte          haveECDSAsig:1;
+    byte          haveECC:1;
+    byte          haveStaticECC:1;
+} SniCert;
+
+/* host name entry, a wildcard "*.example.com" is kept as "example.com" */
+typedef struct SniName {
+    struct SniName* next;
+    SniCert*        cert;
+    word32          hash;
+    word16          nameSz;
+    byte            wildcard;
+    char            name[1];        /* lower case, allocated to nameSz */
+} SniName;
+
+/* exact and wildcard host names to the certificate to use */
+typedef struct SniTable {
+    SniName**      rows;
+    word32         rowsSz;
+    word32         count;
+    wolfSSL_RwLock lock;
+} SniTable;
+
+WOLFSSL_LOCAL void FreeSniTable(SniTable* table, void* heap);
+WOLFSSL_LOCAL int  SNI_GetTable(WOLFSSL_CTX* ctx, SniTable** pTable);
+WOLFSSL_LOCAL int  SNI_SelectCert(WOLFSSL* ssl, const byte* name, word16 sz);
+WOLFSSL_LOCAL void SNI_ReleaseCert(WOLFSSL* ssl, int restore);
+#endif /* WOLFSSL_SNI_TABLE && !NO_WOLFSSL_SERVER */
+
 #endif /* HAVE_SNI */
 
 /* Trusted CA Key Indication - RFC 6066 (section 6) */
@@ -2713,6 +2874,117 @@ typedef struct {
 #endif
 
 
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+/* per handshake timing */
+typedef struct HsTiming {
+    WOLFSSL_HS_TIMING rec;          /* what the user gets */
+    word64 start;                   /* when the handshake started */
+    word64 opStart[WOLFSSL_HST_OP_COUNT]; /* when running operation started */
+    byte   started;                 /* handshake being timed */
+} HsTiming;
+
+WOLFSSL_LOCAL void HsTimingStart(WOLFSSL* ssl);
+WOLFSSL_LOCAL void HsTimingDone(WOLFSSL* ssl);
+WOLFSSL_LOCAL void HsTimingBegin(WOLFSSL* ssl, int op);
+WOLFSSL_LOCAL void HsTimingEnd(WOLFSSL* ssl, int op);
+WOLFSSL_LOCAL void HsTimingMsg(WOLFSSL* ssl, byte type, int ret);
+
+    #define HS_TIMING_START(ssl)     HsTimingStart(ssl)
+    #define HS_TIMING_DONE(ssl)      HsTimingDone(ssl)
+    #define HS_TIMING_BEGIN(ssl, op) HsTimingBegin((ssl), (op))
+    #define HS_TIMING_END(ssl, op)   HsTimingEnd((ssl), (op))
+    #define HS_TIMING_MSG(ssl, type, ret) HsTimingMsg((ssl), (type), (ret))
+#else
+    #define HS_TIMING_START(ssl)
+    #define HS_TIMING_DONE(ssl)
+    #define HS_TIMING_BEGIN(ssl, op)
+    #define HS_TIMING_END(ssl, op)
+    #define HS_TIMING_MSG(ssl, type, ret)
+#endif /* WOLFSSL_HANDSHAKE_TIMING */
+
+#ifdef WOLFSSL_PERF_COUNTERS
+/* performance counters, same order as WOLFSSL_PERF_STATS */
+enum PerfCounter {
+    PERF_FULL_HANDSHAKE = 0,
+    PERF_RESUMED_HANDSHAKE,
+    PERF_SESSION_HIT,
+    PERF_SESSION_MISS,
+    PERF_SESSION_ADD,
+    PERF_BYTES_ENCRYPTED,
+    PERF_BYTES_DECRYPTED,
+    PERF_RECORDS_ENCRYPTED,
+    PERF_RECORDS_DECRYPTED,
+    PERF_ALERTS_SENT,
+    PERF_ALERTS_RECEIVED,
+    PERF_BUFFER_GROWS,
+    PERF_BUFFER_SHRINKS,
+    PERF_OCSP_LOOKUPS,
+    PERF_CRL_LOOKUPS,
+    PERF_COUNTER_COUNT
+};
+
+WOLFSSL_LOCAL void PerfAdd(WOLFSSL_CTX* ctx, int counter, word64 n);
+WOLFSSL_LOCAL void PerfGet(WOLFSSL_CTX* ctx, WOLFSSL_PERF_STATS* stats);
+WOLFSSL_LOCAL void PerfReset(WOLFSSL_CTX* ctx);
+
+    #define PERF_ADD(ssl, counter, n) PerfAdd((ssl)->ctx, (counter), (word64)(n))
+    #define PERF_INC(ssl, counter)    PerfAdd((ssl)->ctx, (counter), 1)
+#else
+    #define PERF_ADD(ssl, counter, n)
+    #define PERF_INC(ssl, counter)
+#endif /* WOLFSSL_PERF_COUNTERS */
+/* handshake finishing, counted as full or resumed once before handShakeDone
+ * is set (TLS 1.3 post-handshake auth finishes again) */
+#define PERF_HANDSHAKE_DONE(ssl) PERF_ADD((ssl), (ssl)->options.resuming ? \
+                                   PERF_RESUMED_HANDSHAKE : PERF_FULL_HANDSHAKE, \
+                                   !(ssl)->options.handShakeDone)
+
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    /* charge this thread's allocations to the CTX from here on */
+    #define MEM_STATS_OWNER(ctx) \
+        wc_MemStatsSetOwner((ctx) != NULL ? (ctx)->memOwner : 0)
+    /* same for the length of a call, keeping the owner to give back */
+    #define MEM_STATS_PUSH(ctx, prev) (prev) = MEM_STATS_OWNER(ctx)
+    #define MEM_STATS_POP(prev)       wc_MemStatsSetOwner(prev)
+#else
+    #define MEM_STATS_OWNER(ctx)
+    #define MEM_STATS_PUSH(ctx, prev) (prev) = 0
+    #define MEM_STATS_POP(prev)       (void)(prev)
+#endif
+
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+#ifndef WOLFSSL_HS_ARENA_SZ
+    #define WOLFSSL_HS_ARENA_SZ 32768  /* bytes in a handshake arena chunk */
+#endif
+
+/* Handshake lifetime allocations bumped out of one chunk per WOLFSSL. The
+ * chunk is made when a handshake starts, so an idle WOLFSSL holds none, and
+ * given back to the heap once all its allocations are freed after the
+ * handshake is done. Space freed during the handshake is not reused until
+ * every allocation in the chunk is freed, peak counts it as used. */
+typedef struct HsArena {
+    byte*  buf;                     /* chunk, NULL until first used */
+    word32 used;                    /* bytes handed out since last reset */
+    word32 live;                    /* allocations in chunk not yet freed */
+    word32 peak;                    /* most bytes used at once */
+    word32 fallbacks;               /* allocations that did not fit */
+    byte   started;                 /* handshake started, chunk may be made */
+} HsArena;
+
+WOLFSSL_LOCAL void* HsArenaAlloc(WOLFSSL* ssl, word32 sz, int type);
+WOLFSSL_LOCAL void  HsArenaFree(WOLFSSL* ssl, void* ptr, int type);
+WOLFSSL_LOCAL void  HsArenaStart(WOLFSSL* ssl);
+WOLFSSL_LOCAL void  HsArenaRelease(WOLFSSL* ssl, int force);
+
+    #define HS_XMALLOC(ssl, sz, type)  HsArenaAlloc((ssl), (word32)(sz), (type))
+    #define HS_XFREE(ssl, p, type)     HsArenaFree((ssl), (p), (type))
+    #define HS_ARENA_START(ssl)        HsArenaStart(ssl)
+#else
+    #define HS_XMALLOC(ssl, sz, type)  XMALLOC((sz), (ssl)->heap, (type))
+    #define HS_XFREE(ssl, p, type)     XFREE((p), (ssl)->heap, (type))
+    #define HS_ARENA_START(ssl)
+#endif /* WOLFSSL_HANDSHAKE_ARENA */
+
 /* wolfSSL context type */
 struct WOLFSSL_CTX {
     WOLFSSL_METHOD* method;
@@ -2722,6 +2994,16 @@ struct WOLFSSL_CTX {
     wolfSSL_Mutex   countMutex;   /* reference count mutex */
     int         refCount;         /* reference count */
     int         err;              /* error code in case of mutex not created */
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+    word32      hsHist[WOLFSSL_HST_OP_COUNT][WOLFSSL_HST_BUCKETS];
+                                  /* handshake timing, under countMutex */
+#endif
+#ifdef WOLFSSL_PERF_COUNTERS
+    word64      perf[PERF_COUNTER_COUNT]; /* updated atomically */
+#endif
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    int         memOwner;         /* memory stats owner, 0 if none left */
+#endif
 #ifndef NO_DH
     buffer      serverDH_P;
     buffer      serverDH_G;
@@ -2901,6 +3183,9 @@ struct WOLFSSL_CTX {
 #ifdef HAVE_SNI
     CallbackSniRecv sniRecvCb;
     void*           sniRecvCbArg;
+#if defined(WOLFSSL_SNI_TABLE) && !defined(NO_WOLFSSL_SERVER)
+    SniTable*       sniTable;     /* server certificates by host name */
+#endif
 #endif
 #if defined(WOLFSSL_MULTICAST) && defined(WOLFSSL_DTLS)
     CallbackMcastHighwater mcastHwCb; /* Sequence number highwater callback */
@@ -4057,6 +4342,12 @@ struct WOLFSSL {
     HandShakeDoneCb hsDoneCb;          /*  notify user handshake done */
     void*           hsDoneCtx;         /*  user handshake cb context  */
 #endif
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+    HsTiming        hsTiming;          /* where handshake time went */
+#endif
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+    HsArena         hsArena;           /* handshake lifetime allocations */
+#endif
 #ifdef WOLFSSL_ASYNC_CRYPT
     struct WOLFSSL_ASYNC async;
 #elif defined(WOLFSSL_NONBLOCK_OCSP)
@@ -4243,6 +4534,10 @@ struct WOLFSSL {
                                             flag found in buffers.weOwnCert) */
 #endif
     byte             keepCert;           /* keep certificate after handshake */
+#if defined(HAVE_SNI) && defined(WOLFSSL_SNI_TABLE) && \
+                                                !defined(NO_WOLFSSL_SERVER)
+    SniCert*         sniCert;            /* picked by SNI, holds a reference */
+#endif
 #if defined(HAVE_EX_DATA) || defined(FORTRESS)
     WOLFSSL_CRYPTO_EX_DATA ex_data; /* external data, for Fortress */
 #endif
@@ -4284,6 +4579,10 @@ struct WOLFSSL {
 #endif /* HAVE_TLS_EXTENSIONS */
 #ifdef HAVE_OCSP
         void*       ocspIOCtx;
+    #ifdef WOLFSSL_NONBLOCK_OCSP
+        byte        ocspNonce[MAX_OCSP_NONCE_SZ]; /* of lookup in progress */
+        int         ocspNonceSz;
+    #endif
         byte ocspProducedDate[MAX_DATE_SZ];
         int ocspProducedDateFormat;
     #ifdef OPENSSL_EXTRA
@@ -62,6 +62,12 @@ WOLFSSL_LOCAL int  CheckOcspRequest(WOLFSSL_OCSP* ocsp,
 WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int responseSz,
                                     WOLFSSL_BUFFER_INFO *responseBuffer, CertStatus *status,
                                     OcspEntry *entry, OcspRequest *ocspRequest);
+WOLFSSL_LOCAL int  SetOCSPCacheSize(WOLFSSL_OCSP* ocsp, word32 sz);
+#ifdef HAVE_OCSP_STAPLING_REFRESH
+WOLFSSL_LOCAL int  AddOcspStaple(WOLFSSL_OCSP* ocsp, const byte* der,
+                                                                  word32 derSz);
+WOLFSSL_LOCAL int  StartOcspRefresh(WOLFSSL_OCSP* ocsp);
+#endif
 
 #if defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY) || \
     defined(WOLFSSL_APACHE_HTTPD) || defined(HAVE_LIGHTY)
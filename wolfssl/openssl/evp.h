@@ -360,6 +360,9 @@ struct WOLFSSL_EVP_CIPHER_CTX {
     int     authTagSz;
     byte*   gcmAuthIn;
     int     gcmAuthInSz;
+#ifdef WOLFSSL_AESGCM_STREAM
+    byte    gcmStreamInit; /* wc_AesGcmInit() called with iv */
+#endif
 #endif
 #endif
 };
@@ -820,6 +820,8 @@ WOLFSSL_ABI WOLFSSL_API int wolfSSL_CTX_use_PrivateKey_file(WOLFSSL_CTX*,
 #define WOLFSSL_LOAD_FLAG_IGNORE_ERR    0x00000001
 #define WOLFSSL_LOAD_FLAG_DATE_ERR_OKAY 0x00000002
 #define WOLFSSL_LOAD_FLAG_PEM_CA_ONLY   0x00000004
+#define WOLFSSL_LOAD_FLAG_PARALLEL      0x00000008
+#define WOLFSSL_LOAD_FLAG_LAZY          0x00000010
 
 #ifndef WOLFSSL_LOAD_VERIFY_DEFAULT_FLAGS
 #define WOLFSSL_LOAD_VERIFY_DEFAULT_FLAGS WOLFSSL_LOAD_FLAG_NONE
@@ -2833,6 +2835,20 @@ WOLFSSL_API void* wolfSSL_GetRsaDecCtx(WOLFSSL* ssl);
     WOLFSSL_API int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm);
 #ifdef WOLFSSL_TRUST_PEER_CERT
     WOLFSSL_API int wolfSSL_CertManagerUnload_trust_peers(WOLFSSL_CERT_MANAGER* cm);
+#endif
+#ifdef WOLFSSL_TRUST_STORE
+    WOLFSSL_API int wolfSSL_CertManagerLoadTrustStoreBuffer(
+            WOLFSSL_CERT_MANAGER* cm, const unsigned char* buf, long sz);
+    WOLFSSL_API int wolfSSL_CertManagerSaveTrustStoreBuffer(
+            WOLFSSL_CERT_MANAGER* cm, unsigned char* buf, int* sz);
+    #ifndef NO_FILESYSTEM
+    WOLFSSL_API int wolfSSL_CertManagerLoadTrustStore(WOLFSSL_CERT_MANAGER* cm,
+                                                      const char* fname);
+    WOLFSSL_API int wolfSSL_CertManagerSaveTrustStore(WOLFSSL_CERT_MANAGER* cm,
+                                                      const char* fname);
+    WOLFSSL_API int wolfSSL_CTX_LoadTrustStore(WOLFSSL_CTX* ctx,
+                                               const char* fname);
+    #endif
 #endif
     WOLFSSL_API int wolfSSL_CertManagerVerify(WOLFSSL_CERT_MANAGER*, const char* f,
                                                                     int format);
@@ -2870,6 +2886,8 @@ WOLFSSL_API void* wolfSSL_GetRsaDecCtx(WOLFSSL* ssl);
                                                                    const char*);
     WOLFSSL_API int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
+    WOLFSSL_API int wolfSSL_CertManagerSetOCSPCacheSize(WOLFSSL_CERT_MANAGER*,
+                                                                unsigned int);
 
     WOLFSSL_API int wolfSSL_CertManagerEnableOCSPStapling(
                                                       WOLFSSL_CERT_MANAGER* cm);
@@ -2913,10 +2931,14 @@ WOLFSSL_API WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
     WOLFSSL_API int wolfSSL_CTX_SetOCSP_OverrideURL(WOLFSSL_CTX*, const char*);
     WOLFSSL_API int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
+    WOLFSSL_API int wolfSSL_CTX_SetOCSPCacheSize(WOLFSSL_CTX*, unsigned int);
     WOLFSSL_API int wolfSSL_CTX_EnableOCSPStapling(WOLFSSL_CTX*);
     WOLFSSL_API int wolfSSL_CTX_DisableOCSPStapling(WOLFSSL_CTX*);
     WOLFSSL_API int wolfSSL_CTX_EnableOCSPMustStaple(WOLFSSL_CTX*);
     WOLFSSL_API int wolfSSL_CTX_DisableOCSPMustStaple(WOLFSSL_CTX*);
+#if defined(HAVE_OCSP_STAPLING_REFRESH) && !defined(NO_WOLFSSL_SERVER)
+    WOLFSSL_API int wolfSSL_CTX_EnableOCSPStaplingRefresh(WOLFSSL_CTX*);
+#endif
 #endif /* !NO_CERTS */
 
 
@@ -2984,6 +3006,14 @@ WOLFSSL_API int wolfSSL_SNI_GetFromBuffer(
                  const unsigned char* clientHello, unsigned int helloSz,
                  unsigned char type, unsigned char* sni, unsigned int* inOutSz);
 
+#ifdef WOLFSSL_SNI_TABLE
+WOLFSSL_API int wolfSSL_CTX_SNI_AddCert_buffer(WOLFSSL_CTX* ctx,
+                 const char* hostName, const unsigned char* chain, long chainSz,
+                 const unsigned char* key, long keySz, int format);
+WOLFSSL_API int wolfSSL_CTX_SNI_RemoveCert(WOLFSSL_CTX* ctx,
+                                           const char* hostName);
+#endif
+
 #endif /* NO_WOLFSSL_SERVER */
 
 /* SNI status */
@@ -3304,6 +3334,85 @@ WOLFSSL_API int wolfSSL_CTX_DisableExtendedMasterSecret(WOLFSSL_CTX* ctx);
 typedef int (*HandShakeDoneCb)(WOLFSSL*, void*);
 WOLFSSL_API int wolfSSL_SetHsDoneCb(WOLFSSL*, HandShakeDoneCb, void*);
 
+#ifdef WOLFSSL_HANDSHAKE_TIMING
+#ifndef WORD64_AVAILABLE
+    #error WOLFSSL_HANDSHAKE_TIMING requires a 64-bit type
+#endif
+
+/* handshake timing, operations timed */
+enum {
+    WOLFSSL_HST_TOTAL        = 0, /* whole handshake, set when done */
+    WOLFSSL_HST_KEYSHARE_GEN = 1, /* ephemeral (EC)DH key generation */
+    WOLFSSL_HST_KEY_AGREE    = 2, /* (EC)DH shared secret */
+    WOLFSSL_HST_SIGN         = 3, /* signing our handshake messages */
+    WOLFSSL_HST_VERIFY       = 4, /* verifying the peer's handshake signature */
+    WOLFSSL_HST_CERT_VERIFY  = 5, /* peer certificate chain, includes OCSP */
+    WOLFSSL_HST_OCSP         = 6, /* OCSP lookup and stapled response */
+    WOLFSSL_HST_TICKET_ENC   = 7, /* session ticket creation */
+    WOLFSSL_HST_OP_COUNT     = 8,
+
+    WOLFSSL_HST_MSG_COUNT    = 32, /* message types below this are timed */
+    WOLFSSL_HST_BUCKETS      = 32  /* histogram buckets, log2 microseconds */
+};
+
+typedef struct WOLFSSL_HS_TIMING {
+    word64 opNs[WOLFSSL_HST_OP_COUNT];    /* nanoseconds in each operation */
+    word32 opCount[WOLFSSL_HST_OP_COUNT]; /* times each operation ran */
+    word64 msgNs[WOLFSSL_HST_MSG_COUNT];  /* nanoseconds from start until
+                                             message type was processed */
+} WOLFSSL_HS_TIMING;
+
+WOLFSSL_API int wolfSSL_get_handshake_timing(WOLFSSL* ssl,
+                                            WOLFSSL_HS_TIMING* timing);
+WOLFSSL_API int wolfSSL_CTX_get_handshake_histogram(WOLFSSL_CTX* ctx, int op,
+                                            word32* buckets, int bucketsSz);
+WOLFSSL_API int wolfSSL_CTX_reset_handshake_histogram(WOLFSSL_CTX* ctx);
+#endif /* WOLFSSL_HANDSHAKE_TIMING */
+
+#ifdef WOLFSSL_PERF_COUNTERS
+#ifndef WORD64_AVAILABLE
+    #error WOLFSSL_PERF_COUNTERS requires a 64-bit type
+#endif
+
+/* operational counters, per CTX and for the whole library */
+typedef struct WOLFSSL_PERF_STATS {
+    word64 fullHandshakes;     /* handshakes done with a new session */
+    word64 resumedHandshakes;  /* handshakes done resuming a session */
+    word64 sessionCacheHits;   /* server found session to resume (ID/ticket) */
+    word64 sessionCacheMisses; /* server could not resume, full handshake */
+    word64 sessionCacheAdds;   /* sessions added to the session cache */
+    word64 bytesEncrypted;     /* application data bytes written */
+    word64 bytesDecrypted;     /* application data bytes read */
+    word64 recordsEncrypted;   /* records encrypted, any content type */
+    word64 recordsDecrypted;   /* records decrypted, any content type */
+    word64 alertsSent;
+    word64 alertsReceived;
+    word64 bufferGrows;        /* I/O buffer moved to a bigger dynamic one */
+    word64 bufferShrinks;      /* I/O buffer back to the static one */
+    word64 ocspLookups;        /* OCSP checks of peer certificates */
+    word64 crlLookups;         /* CRL checks of peer certificates */
+} WOLFSSL_PERF_STATS;
+
+WOLFSSL_API int wolfSSL_CTX_get_perf_stats(WOLFSSL_CTX* ctx,
+                                           WOLFSSL_PERF_STATS* stats);
+WOLFSSL_API int wolfSSL_CTX_reset_perf_stats(WOLFSSL_CTX* ctx);
+WOLFSSL_API int wolfSSL_get_perf_stats(WOLFSSL_PERF_STATS* stats);
+WOLFSSL_API int wolfSSL_reset_perf_stats(void);
+#endif /* WOLFSSL_PERF_COUNTERS */
+
+#ifdef WOLFSSL_MEM_TYPE_STATS
+WOLFSSL_API int wolfSSL_CTX_get_mem_stats(WOLFSSL_CTX* ctx, int type,
+                                          WC_MEM_TYPE_STATS* stats);
+#if !defined(NO_FILESYSTEM) && !defined(NO_STDIO_FILESYSTEM)
+WOLFSSL_API int wolfSSL_CTX_print_mem_stats(WOLFSSL_CTX* ctx);
+#endif
+#endif /* WOLFSSL_MEM_TYPE_STATS */
+
+#ifdef WOLFSSL_HANDSHAKE_ARENA
+WOLFSSL_API int wolfSSL_get_hs_arena_stats(WOLFSSL* ssl, word32* peak,
+                                           word32* fallbacks);
+#endif
+
 
 WOLFSSL_API int wolfSSL_PrintSessionStats(void);
 WOLFSSL_API int wolfSSL_get_session_stats(unsigned int* active,
@@ -187,6 +187,27 @@ struct Aes {
 #ifdef HAVE_CAVIUM_OCTEON_SYNC
     word32 y0;
 #endif
+#ifdef WOLFSSL_AESGCM_STREAM
+    /* state of an incremental (Init/Update/Final) operation */
+    ALIGN16 byte gcmCtr[AES_BLOCK_SIZE];  /* last counter block used */
+    ALIGN16 byte gcmX[AES_BLOCK_SIZE];    /* running GHASH */
+    ALIGN16 byte gcmEky0[AES_BLOCK_SIZE]; /* E(K, Y0), masks the tag */
+    ALIGN16 byte gcmPart[AES_BLOCK_SIZE]; /* AAD or cipher text not hashed */
+    ALIGN16 byte gcmKs[AES_BLOCK_SIZE];   /* key stream of a partial block */
+#ifdef WOLFSSL_AESNI
+    ALIGN16 byte gcmHt[8][AES_BLOCK_SIZE]; /* H to H^8 for AES-NI */
+#endif
+#ifdef WORD64_AVAILABLE
+    word64 gcmASz;
+    word64 gcmCSz;
+#else
+    word32 gcmASz;
+    word32 gcmCSz;
+#endif
+    byte   gcmAOver;  /* bytes of AAD in gcmPart */
+    byte   gcmCOver;  /* bytes of cipher text in gcmPart */
+    byte   gcmIvSet;
+#endif
 #endif /* HAVE_AESGCM */
 #ifdef WOLFSSL_AESNI
     byte use_aesni;
@@ -374,6 +395,21 @@ WOLFSSL_API int wc_AesEcbDecrypt(Aes* aes, byte* out,
                                    const byte* authIn, word32 authInSz);
 #endif /* WC_NO_RNG */
 
+#ifdef WOLFSSL_AESGCM_STREAM
+ WOLFSSL_API int  wc_AesGcmInit(Aes* aes, const byte* key, word32 len,
+                                   const byte* iv, word32 ivSz);
+ WOLFSSL_API int  wc_AesGcmEncryptUpdate(Aes* aes, byte* out,
+                                   const byte* in, word32 sz,
+                                   const byte* authIn, word32 authInSz);
+ WOLFSSL_API int  wc_AesGcmEncryptFinal(Aes* aes, byte* authTag,
+                                   word32 authTagSz);
+ WOLFSSL_API int  wc_AesGcmDecryptUpdate(Aes* aes, byte* out,
+                                   const byte* in, word32 sz,
+                                   const byte* authIn, word32 authInSz);
+ WOLFSSL_API int  wc_AesGcmDecryptFinal(Aes* aes, const byte* authTag,
+                                   word32 authTagSz);
+#endif /* WOLFSSL_AESGCM_STREAM */
+
  WOLFSSL_API int wc_GmacSetKey(Gmac* gmac, const byte* key, word32 len);
  WOLFSSL_API int wc_GmacUpdate(Gmac* gmac, const byte* iv, word32 ivSz,
                                const byte* authIn, word32 authInSz,
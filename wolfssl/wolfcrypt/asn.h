@@ -994,6 +994,9 @@ struct Signer {
     byte    pathLength;
     byte    pathLengthSet : 1;
     byte    selfSigned : 1;
+#ifdef WOLFSSL_TRUST_STORE
+    byte    trustStore : 1;          /* publicKey and name not owned */
+#endif
     const byte* publicKey;
     int     nameLen;
     char*   name;                    /* common name */
@@ -1015,8 +1018,16 @@ struct Signer {
 #endif
 #ifdef WOLFSSL_RENESAS_TSIP_TLS
     word32 cm_idx;
+#endif
+#ifdef WOLFSSL_LAZY_CA_LOAD
+    DerBuffer* lazyDer;              /* only hashes set until decoded */
+    byte    lazyVerify;              /* verify setting to decode with */
+    byte    lazyRetired;             /* failed to decode, off the tables */
 #endif
     Signer* next;
+#ifndef NO_SKID
+    Signer* nameNext;                /* next on the subject name hash row */
+#endif
 };
 
 
@@ -1234,6 +1245,10 @@ WOLFSSL_LOCAL int GetSerialNumber(const byte* input, word32* inOutIdx,
     byte* serial, int* serialSz, word32 maxIdx);
 WOLFSSL_LOCAL int GetNameHash(const byte* source, word32* idx, byte* hash,
                              int maxIdx);
+#ifdef WOLFSSL_LAZY_CA_LOAD
+WOLFSSL_LOCAL int GetCertSignerHashes(const byte* source, word32 sz,
+                                      byte* nameHash, byte* keyIdHash);
+#endif
 WOLFSSL_LOCAL int wc_CheckPrivateKeyCert(const byte* key, word32 keySz, DecodedCert* der);
 WOLFSSL_LOCAL int wc_CheckPrivateKey(const byte* privKey, word32 privKeySz,
                                      const byte* pubKey, word32 pubKeySz, enum Key_Sum ks);
@@ -1382,6 +1397,8 @@ typedef struct OcspEntry OcspEntry;
 struct OcspEntry
 {
     OcspEntry *next;                      /* next entry                */
+    OcspEntry *prev;                      /* previous cache entry      */
+    OcspEntry *hashNext;                  /* next entry in cache row   */
     word32 hashAlgoOID;                   /* hash algo ID              */
     byte issuerHash[OCSP_DIGEST_SIZE];    /* issuer hash               */
     byte issuerKeyHash[OCSP_DIGEST_SIZE]; /* issuer public key hash    */
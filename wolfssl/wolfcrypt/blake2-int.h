@@ -76,8 +76,9 @@
     byte  salt[BLAKE2B_SALTBYTES]; /* 24 */
     byte  personal[BLAKE2S_PERSONALBYTES];  /* 32 */
   } blake2s_param;
+#pragma pack(pop)
 
-  ALIGN32 typedef struct __blake2s_state
+  typedef struct ALIGN32 __blake2s_state
   {
     word32 h[8];
     word32 t[2];
@@ -87,6 +88,7 @@
     byte  last_node;
   } blake2s_state ;
 
+#pragma pack(push, 1)
   typedef struct __blake2b_param
   {
     byte  digest_length; /* 1 */
@@ -101,8 +103,9 @@
     byte  salt[BLAKE2B_SALTBYTES]; /* 48 */
     byte  personal[BLAKE2B_PERSONALBYTES];  /* 64 */
   } blake2b_param;
+#pragma pack(pop)
 
-  ALIGN64 typedef struct __blake2b_state
+  typedef struct ALIGN64 __blake2b_state
   {
     word64 h[8];
     word64 t[2];
@@ -112,11 +115,14 @@
     byte  last_node;
   } blake2b_state;
 
+  /* Tree modes: leaf i hashes blocks i, i + n, i + 2n, ... of the input
+   * and the root hashes the leaf outputs. Up to two rounds of n blocks are
+   * buffered so that each leaf's last block is known when finalizing. */
   typedef struct __blake2sp_state
   {
     blake2s_state S[8][1];
     blake2s_state R[1];
-    byte buf[8 * BLAKE2S_BLOCKBYTES];
+    byte buf[2 * 8 * BLAKE2S_BLOCKBYTES];
     word32 buflen;
   } blake2sp_state;
 
@@ -124,10 +130,9 @@
   {
     blake2b_state S[4][1];
     blake2b_state R[1];
-    byte buf[4 * BLAKE2B_BLOCKBYTES];
+    byte buf[2 * 4 * BLAKE2B_BLOCKBYTES];
     word64 buflen;
   } blake2bp_state;
-#pragma pack(pop)
 
   /* Streaming API */
   int blake2s_init( blake2s_state *S, const byte outlen );
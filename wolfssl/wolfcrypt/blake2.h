@@ -63,6 +63,12 @@ typedef struct Blake2b {
     blake2b_state S[1];         /* our state */
     word32        digestSz;     /* digest size used on init */
 } Blake2b;
+
+/* BLAKE2bp digest, four-way parallel tree mode */
+typedef struct Blake2bp {
+    blake2bp_state S[1];        /* our state */
+    word32         digestSz;    /* digest size used on init */
+} Blake2bp;
 #endif
 
 #ifdef HAVE_BLAKE2S
@@ -71,6 +77,12 @@ typedef struct Blake2s {
     blake2s_state S[1];         /* our state */
     word32        digestSz;     /* digest size used on init */
 } Blake2s;
+
+/* BLAKE2sp digest, eight-way parallel tree mode */
+typedef struct Blake2sp {
+    blake2sp_state S[1];        /* our state */
+    word32         digestSz;    /* digest size used on init */
+} Blake2sp;
 #endif
 
 
@@ -79,6 +91,11 @@ WOLFSSL_API int wc_InitBlake2b(Blake2b*, word32);
 WOLFSSL_API int wc_InitBlake2b_WithKey(Blake2b*, word32, const byte *, word32);
 WOLFSSL_API int wc_Blake2bUpdate(Blake2b*, const byte*, word32);
 WOLFSSL_API int wc_Blake2bFinal(Blake2b*, byte*, word32);
+
+WOLFSSL_API int wc_InitBlake2bp(Blake2bp*, word32);
+WOLFSSL_API int wc_InitBlake2bp_WithKey(Blake2bp*, word32, const byte *, word32);
+WOLFSSL_API int wc_Blake2bpUpdate(Blake2bp*, const byte*, word32);
+WOLFSSL_API int wc_Blake2bpFinal(Blake2bp*, byte*, word32);
 #endif
 
 #ifdef HAVE_BLAKE2S
@@ -86,6 +103,11 @@ WOLFSSL_API int wc_InitBlake2s(Blake2s*, word32);
 WOLFSSL_API int wc_InitBlake2s_WithKey(Blake2s*, word32, const byte *, word32);
 WOLFSSL_API int wc_Blake2sUpdate(Blake2s*, const byte*, word32);
 WOLFSSL_API int wc_Blake2sFinal(Blake2s*, byte*, word32);
+
+WOLFSSL_API int wc_InitBlake2sp(Blake2sp*, word32);
+WOLFSSL_API int wc_InitBlake2sp_WithKey(Blake2sp*, word32, const byte *, word32);
+WOLFSSL_API int wc_Blake2spUpdate(Blake2sp*, const byte*, word32);
+WOLFSSL_API int wc_Blake2spFinal(Blake2sp*, byte*, word32);
 #endif
 
 
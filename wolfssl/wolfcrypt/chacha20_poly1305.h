@@ -124,6 +124,11 @@ WOLFSSL_API int wc_ChaCha20Poly1305_UpdateData(ChaChaPoly_Aead* aead,
 WOLFSSL_API int wc_ChaCha20Poly1305_Final(ChaChaPoly_Aead* aead,
     byte outAuthTag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE]);
 
+/* Encrypt or decrypt and calculate the tag in one call - used by TLS */
+WOLFSSL_LOCAL int wc_ChaCha20Poly1305_Process(ChaCha* chacha, Poly1305* poly,
+    const byte* aad, word32 aadSz, const byte* in, byte* out, word32 sz,
+    int isEncrypt, byte tag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE]);
+
 #ifdef HAVE_XCHACHA
 
 WOLFSSL_API int wc_XChaCha20Poly1305_Init(
@@ -43,6 +43,11 @@
     #define CPUID_AESNI  0x0020
     #define CPUID_ADX    0x0040   /* ADCX, ADOX */
     #define CPUID_MOVBE  0x0080   /* Move and byte swap */
+    #define CPUID_AVX512 0x0100   /* AVX-512 F, BW and VL with OS support */
+    #define CPUID_VAES   0x0200   /* AES on YMM/ZMM registers */
+    #define CPUID_VPCLMULQDQ 0x0400 /* carry-less multiply on YMM/ZMM */
+    #define CPUID_SHA    0x0800   /* SHA-1 and SHA-256 extensions */
+    #define CPUID_SSE41  0x1000   /* SSE4.1, includes SSSE3 */
 
     #define IS_INTEL_AVX1(f)    ((f) & CPUID_AVX1)
     #define IS_INTEL_AVX2(f)    ((f) & CPUID_AVX2)
@@ -52,6 +57,35 @@
     #define IS_INTEL_AESNI(f)   ((f) & CPUID_AESNI)
     #define IS_INTEL_ADX(f)     ((f) & CPUID_ADX)
     #define IS_INTEL_MOVBE(f)   ((f) & CPUID_MOVBE)
+    #define IS_INTEL_AVX512(f)  ((f) & CPUID_AVX512)
+    #define IS_INTEL_VAES(f)    ((f) & CPUID_VAES)
+    #define IS_INTEL_VPCLMULQDQ(f) ((f) & CPUID_VPCLMULQDQ)
+    #define IS_INTEL_SHA(f)     ((f) & CPUID_SHA)
+    #define IS_INTEL_SSE41(f)   ((f) & CPUID_SSE41)
+
+    /* Functions compiled for an instruction set beyond the build's baseline
+     * with a target attribute and picked at run time with the flags above.
+     */
+    #if !defined(_MSC_VER) && !defined(__INTEL_COMPILER) && \
+        !defined(WOLFSSL_LINUXKM) && !defined(HAVE_FIPS) && \
+        ((defined(__clang__) && __clang_major__ >= 4) || \
+         (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 5))
+        #define WC_HAVE_TARGET_ATTR
+        #define WC_TARGET(isa)      __attribute__((target(isa)))
+        #define WC_TARGET_SSE41     WC_TARGET("sse4.1")
+        #define WC_TARGET_AVX2      WC_TARGET("avx2")
+        #define WC_TARGET_AVX512    WC_TARGET("avx2,avx512f,avx512bw,avx512vl")
+        #define WC_TARGET_BMI2      WC_TARGET("bmi,bmi2")
+        #define WC_TARGET_SHA_NI    WC_TARGET("sha,ssse3,sse4.1")
+
+        /* VAES and VPCLMULQDQ need newer compilers. */
+        #if (defined(__clang__) && __clang_major__ >= 7) || \
+            (!defined(__clang__) && __GNUC__ >= 8)
+            #define WC_HAVE_TARGET_ATTR_VAES
+            #define WC_TARGET_VAES  WC_TARGET("avx512f,avx512bw,avx512vl," \
+                                        "vaes,vpclmulqdq,aes,pclmul,sse4.1")
+        #endif
+    #endif
 
     void cpuid_set_flags(void);
     word32 cpuid_get_flags(void);
@@ -29,7 +29,7 @@
 
 /* Defines the Crypto Callback interface version, for compatibility */
 /* Increment this when Crypto Callback interface changes are made */
-#define CRYPTO_CB_VER   2
+#define CRYPTO_CB_VER   3
 
 
 #ifdef WOLF_CRYPTO_CB
@@ -55,6 +55,9 @@
 #ifndef WC_NO_RNG
     #include <wolfssl/wolfcrypt/random.h>
 #endif
+#ifdef WOLF_CRYPTO_CB_POOL
+    #include <wolfssl/wolfcrypt/wolfevent.h>
+#endif
 #ifndef NO_DES3
     #include <wolfssl/wolfcrypt/des3.h>
 #endif
@@ -216,6 +219,14 @@ typedef struct wc_CryptoInfo {
         word32 sz;
     } seed;
 #endif
+#ifdef WOLF_CRYPTO_CB_POOL
+    struct {
+        int type; /* enum wc_PkType, same for every operation */
+        struct wc_CryptoInfo** ops; /* WC_ALGO_TYPE_PK operations */
+        int* rets; /* result of each, CRYPTOCB_UNAVAILABLE runs it alone */
+        int count;
+    } batch;
+#endif
 } wc_CryptoInfo;
 
 
@@ -306,6 +317,33 @@ WOLFSSL_LOCAL int wc_CryptoCb_RandomBlock(WC_RNG* rng, byte* out, word32 sz);
 WOLFSSL_LOCAL int wc_CryptoCb_RandomSeed(OS_Seed* os, byte* seed, word32 sz);
 #endif
 
+#ifdef WOLF_CRYPTO_CB_POOL
+#if defined(SINGLE_THREADED) || defined(USE_WINDOWS_API)
+    #error WOLF_CRYPTO_CB_POOL requires pthreads
+#endif
+#if defined(NO_RSA) && !defined(HAVE_ECC)
+    #error WOLF_CRYPTO_CB_POOL requires RSA or ECC
+#endif
+
+#ifndef CRYPTOCB_POOL_MAX_BATCH
+    #define CRYPTOCB_POOL_MAX_BATCH 16 /* operations per batch call */
+#endif
+
+typedef struct WC_CRYPTOCB_POOL WC_CRYPTOCB_POOL;
+
+WOLFSSL_API WC_CRYPTOCB_POOL* wc_CryptoCb_PoolNew(int devId, int threads,
+    void* heap);
+WOLFSSL_API void wc_CryptoCb_PoolFree(WC_CRYPTOCB_POOL* pool);
+WOLFSSL_API int  wc_CryptoCb_PoolPoll(WC_CRYPTOCB_POOL* pool,
+    WOLF_EVENT** events, int maxEvents, int* eventCount);
+WOLFSSL_API int  wc_CryptoCb_PoolSetBatch(WC_CRYPTOCB_POOL* pool, int devId,
+    int maxBatch);
+
+WOLFSSL_LOCAL int wc_CryptoCb_PkBatch(int devId, int type,
+    wc_CryptoInfo** ops, int* rets, int count);
+WOLFSSL_LOCAL int wc_CryptoCb_PoolIsDevice(int devId);
+#endif /* WOLF_CRYPTO_CB_POOL */
+
 #endif /* WOLF_CRYPTO_CB */
 
 #ifdef __cplusplus
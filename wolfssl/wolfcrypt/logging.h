@@ -139,6 +139,24 @@ WOLFSSL_API void wolfSSL_Debugging_OFF(void);
     #define WOLFSSL_TIME(n)
 #endif
 
+#ifdef WOLFSSL_USDT
+    /* User-level statically defined tracepoints, provider "wolfssl". A probe
+     * is a nop until a tracer (bpftrace, perf, SystemTap) attaches, e.g.
+     *   bpftrace -e 'usdt:./libwolfssl.so:wolfssl:ecc__sign__done { ... }'
+     * Probes are named <object>__<event>, paired ones end in __start and
+     * __done with the return code as the last argument of __done. */
+    #include <sys/sdt.h>
+    #define WC_USDT_PROBE0(name)          DTRACE_PROBE(wolfssl, name)
+    #define WC_USDT_PROBE1(name, a)       DTRACE_PROBE1(wolfssl, name, a)
+    #define WC_USDT_PROBE2(name, a, b)    DTRACE_PROBE2(wolfssl, name, a, b)
+    #define WC_USDT_PROBE3(name, a, b, c) DTRACE_PROBE3(wolfssl, name, a, b, c)
+#else
+    #define WC_USDT_PROBE0(name)
+    #define WC_USDT_PROBE1(name, a)
+    #define WC_USDT_PROBE2(name, a, b)
+    #define WC_USDT_PROBE3(name, a, b, c)
+#endif
+
 #if defined(DEBUG_WOLFSSL) && !defined(WOLFSSL_DEBUG_ERRORS_ONLY)
     #if defined(_WIN32)
         #if defined(INTIME_RTOS)
@@ -87,6 +87,45 @@ WOLFSSL_API int wolfSSL_GetAllocators(wolfSSL_Malloc_cb*,
                                       wolfSSL_Free_cb*,
                                       wolfSSL_Realloc_cb*);
 
+#ifdef WOLFSSL_MEM_TYPE_STATS
+    #if defined(WOLFSSL_STATIC_MEMORY) || defined(WOLFSSL_DEBUG_MEMORY)
+        #error WOLFSSL_MEM_TYPE_STATS is not supported with static or debug \
+               memory
+    #endif
+    #ifndef WORD64_AVAILABLE
+        #error WOLFSSL_MEM_TYPE_STATS requires a 64-bit type
+    #endif
+
+    /* DYNAMIC_TYPE_* values counted on their own, others are counted as 0 */
+    #define WC_MEM_TYPE_COUNT    96
+    /* owner 0 is the whole library, the rest are handed out per WOLFSSL_CTX
+     * by wc_MemStatsNewOwner() and given back when it is freed */
+    #ifndef WC_MEM_STATS_OWNERS
+        #define WC_MEM_STATS_OWNERS  16
+    #endif
+
+    typedef struct WC_MEM_TYPE_STATS {
+        word64 curBytes;    /* bytes allocated now */
+        word64 peakBytes;   /* most bytes allocated at once */
+        word64 curAllocs;   /* allocations not freed yet */
+        word64 totalAllocs; /* allocations made */
+    } WC_MEM_TYPE_STATS;
+
+    WOLFSSL_API void* wc_MemStatsMalloc(size_t size, void* heap, int type);
+    WOLFSSL_API void  wc_MemStatsFree(void *ptr, void* heap, int type);
+    WOLFSSL_API void* wc_MemStatsRealloc(void *ptr, size_t size, void* heap,
+                                         int type);
+
+    WOLFSSL_API int  wc_MemStatsGet(int owner, int type,
+                                    WC_MEM_TYPE_STATS* stats);
+    WOLFSSL_API int  wc_MemStatsNewOwner(void);
+    WOLFSSL_API void wc_MemStatsFreeOwner(int owner);
+    WOLFSSL_API int  wc_MemStatsSetOwner(int owner);
+    #if !defined(NO_FILESYSTEM) && !defined(NO_STDIO_FILESYSTEM)
+        WOLFSSL_API void wc_MemStatsPrint(int owner);
+    #endif
+#endif /* WOLFSSL_MEM_TYPE_STATS */
+
 #ifdef WOLFSSL_STATIC_MEMORY
     #define WOLFSSL_STATIC_TIMEOUT 1
     #ifndef WOLFSSL_STATIC_ALIGN
@@ -202,6 +202,13 @@ WOLFSSL_API void wc_Sha256Free(wc_Sha256*);
 WOLFSSL_API int wc_Sha256GetHash(wc_Sha256*, byte*);
 WOLFSSL_API int wc_Sha256Copy(wc_Sha256* src, wc_Sha256* dst);
 
+#ifdef WOLFSSL_SHA256_MULTI_BUFFER
+WOLFSSL_API int wc_Sha256MultiBuffer(wc_Sha256* const* sha256,
+                                     const byte* const* data,
+                                     const word32* len, byte* const* hash,
+                                     word32 cnt);
+#endif
+
 #ifdef WOLFSSL_PIC32MZ_HASH
 WOLFSSL_API void wc_Sha256SizeSet(wc_Sha256*, word32);
 #endif
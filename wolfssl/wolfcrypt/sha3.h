@@ -58,6 +58,9 @@ enum {
     WC_SHA3_512_DIGEST_SIZE  = 64,
     WC_SHA3_512_COUNT        =  9,
 
+    WC_SHAKE128_COUNT        = 21,
+    WC_SHAKE256_COUNT        = 17,
+
 #if !defined(HAVE_SELFTEST) || \
     defined(HAVE_SELFTEST_VERSION) && (HAVE_SELFTEST_VERSION >= 2)
     /* These values are used for HMAC, not SHA-3 directly.
@@ -152,6 +155,13 @@ WOLFSSL_API int wc_Shake256_Final(wc_Shake*, byte*, word32);
 WOLFSSL_API void wc_Shake256_Free(wc_Shake*);
 WOLFSSL_API int wc_Shake256_Copy(wc_Shake* src, wc_Sha3* dst);
 
+#ifdef WOLFSSL_SHAKE_X4
+WOLFSSL_API int wc_Shake128_x4(const byte* const* in, word32 inLen,
+                               byte* const* out, word32 outLen);
+WOLFSSL_API int wc_Shake256_x4(const byte* const* in, word32 inLen,
+                               byte* const* out, word32 outLen);
+#endif
+
 #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
     WOLFSSL_API int wc_Sha3_SetFlags(wc_Sha3* sha3, word32 flags);
     WOLFSSL_API int wc_Sha3_GetFlags(wc_Sha3* sha3, word32* flags);
@@ -395,6 +395,11 @@ decouple library dependencies with standard string, memory and so on.
                 #define XFREE(p, h, t)       {void* xp = (p); if((xp)) wolfSSL_Free((xp), (h), (t));}
                 #define XREALLOC(p, n, h, t) wolfSSL_Realloc((p), (n), (h), (t))
             #endif /* WOLFSSL_DEBUG_MEMORY */
+        #elif defined(WOLFSSL_MEM_TYPE_STATS)
+            /* count each allocation against its type and owner */
+            #define XMALLOC(s, h, t)     wc_MemStatsMalloc((s), (h), (t))
+            #define XFREE(p, h, t)       {void* xp = (p); if((xp)) wc_MemStatsFree((xp), (h), (t));}
+            #define XREALLOC(p, n, h, t) wc_MemStatsRealloc((p), (n), (h), (t))
         #elif !defined(FREERTOS) && !defined(FREERTOS_TCP)
             #ifdef WOLFSSL_DEBUG_MEMORY
                 #define XMALLOC(s, h, t)     ((void)h, (void)t, wolfSSL_Malloc((s), __func__, __LINE__))
@@ -761,6 +766,7 @@ decouple library dependencies with standard string, memory and so on.
         DYNAMIC_TYPE_ED448        = 92,
         DYNAMIC_TYPE_AES          = 93,
         DYNAMIC_TYPE_CMAC         = 94,
+        DYNAMIC_TYPE_HS_ARENA     = 95,
         DYNAMIC_TYPE_SNIFFER_SERVER     = 1000,
         DYNAMIC_TYPE_SNIFFER_SESSION    = 1001,
         DYNAMIC_TYPE_SNIFFER_PB         = 1002,
@@ -789,8 +795,9 @@ decouple library dependencies with standard string, memory and so on.
         WC_ALGO_TYPE_RNG = 4,
         WC_ALGO_TYPE_SEED = 5,
         WC_ALGO_TYPE_HMAC = 6,
+        WC_ALGO_TYPE_PK_BATCH = 7,
 
-        WC_ALGO_TYPE_MAX = WC_ALGO_TYPE_HMAC
+        WC_ALGO_TYPE_MAX = WC_ALGO_TYPE_PK_BATCH
     };
 
     /* hash types */
@@ -361,6 +361,9 @@
         typedef CRITICAL_SECTION wolfSSL_Mutex;
     #elif defined(WOLFSSL_PTHREADS)
         typedef pthread_mutex_t wolfSSL_Mutex;
+        #if !defined(WOLFSSL_NO_RWLOCK) && !defined(WOLFSSL_USE_RWLOCK)
+            #define WOLFSSL_USE_RWLOCK
+        #endif
     #elif defined(WOLFSSL_KTHREADS)
         typedef struct mutex wolfSSL_Mutex;
     #elif defined(THREADX)
@@ -418,6 +421,14 @@
     #endif /* USE_WINDOWS_API */
 #endif /* SINGLE_THREADED */
 
+/* Reader/writer lock: concurrent readers, exclusive writer. Falls back to
+ * the plain mutex where the platform has no native rwlock. */
+#ifdef WOLFSSL_USE_RWLOCK
+    typedef pthread_rwlock_t wolfSSL_RwLock;
+#else
+    typedef wolfSSL_Mutex wolfSSL_RwLock;
+#endif
+
 /* Enable crypt HW mutex for Freescale MMCAU, PIC32MZ or STM32 */
 #if defined(FREESCALE_MMCAU) || defined(WOLFSSL_MICROCHIP_PIC32MZ) || \
     defined(STM32_CRYPTO) || defined(STM32_HASH) || defined(STM32_RNG)
@@ -451,6 +462,12 @@ WOLFSSL_API wolfSSL_Mutex* wc_InitAndAllocMutex(void);
 WOLFSSL_API int wc_FreeMutex(wolfSSL_Mutex*);
 WOLFSSL_API int wc_LockMutex(wolfSSL_Mutex*);
 WOLFSSL_API int wc_UnLockMutex(wolfSSL_Mutex*);
+/* Reader/writer lock functions */
+WOLFSSL_API int wc_InitRwLock(wolfSSL_RwLock*);
+WOLFSSL_API int wc_FreeRwLock(wolfSSL_RwLock*);
+WOLFSSL_API int wc_LockRwLock_Rd(wolfSSL_RwLock*);
+WOLFSSL_API int wc_LockRwLock_Wr(wolfSSL_RwLock*);
+WOLFSSL_API int wc_UnLockRwLock(wolfSSL_RwLock*);
 #if defined(OPENSSL_EXTRA) || defined(HAVE_WEBSERVER)
 /* dynamically set which mutex to use. unlock / lock is controlled by flag */
 typedef void (mutex_cb)(int flag, int type, const char* file, int line);
@@ -41,6 +41,9 @@ typedef enum WOLF_EVENT_TYPE {
     WOLF_EVENT_TYPE_ASYNC_FIRST = WOLF_EVENT_TYPE_ASYNC_WOLFSSL,
     WOLF_EVENT_TYPE_ASYNC_LAST = WOLF_EVENT_TYPE_ASYNC_WOLFCRYPT,
 #endif /* WOLFSSL_ASYNC_CRYPT */
+#ifdef WOLF_CRYPTO_CB_POOL
+    WOLF_EVENT_TYPE_CRYPTOCB_POOL,    /* context is the key */
+#endif
 } WOLF_EVENT_TYPE;
 
 typedef enum WOLF_EVENT_STATE {
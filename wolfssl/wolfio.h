@@ -361,10 +361,32 @@
     #endif
 #endif /* WOLFSSL_NO_SOCK */
 
+/* Nonblocking OCSP and CRL lookups over HTTP */
+#if defined(HAVE_HTTP_CLIENT) && defined(WOLFSSL_NONBLOCK_OCSP) && \
+    defined(HAVE_SOCKADDR)
+    #define HAVE_HTTP_CLIENT_NONBLOCK
+
+    typedef struct WOLFIO_HTTP_NB {
+        SOCKET_T       sfd;      /* socket of request in flight */
+        int            state;    /* connect, send or receive */
+        SOCKADDR_S     addr;     /* responder address while connecting */
+        XSOCKLENT      addrSz;
+        unsigned char* key;      /* URL and body, identifies the lookup */
+        int            keySz;
+        unsigned char* buf;      /* request, then response */
+        int            bufSz;
+        int            len;      /* bytes in buf */
+        int            idx;      /* bytes of request sent */
+        void*          heap;
+    } WOLFIO_HTTP_NB;
+#endif /* HAVE_HTTP_CLIENT_NONBLOCK */
+
 
 /* IO API's */
-#ifdef HAVE_IO_TIMEOUT
+#if defined(HAVE_IO_TIMEOUT) || defined(HAVE_HTTP_CLIENT_NONBLOCK)
     WOLFSSL_API  int wolfIO_SetBlockingMode(SOCKET_T sockfd, int non_blocking);
+#endif
+#ifdef HAVE_IO_TIMEOUT
     WOLFSSL_API void wolfIO_SetTimeout(int to_sec);
     WOLFSSL_API  int wolfIO_Select(SOCKET_T sockfd, int to_sec);
 #endif
@@ -441,6 +463,11 @@ WOLFSSL_API int BioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
     WOLFSSL_API int EmbedOcspLookup(void*, const char*, int, unsigned char*,
                                    int, unsigned char**);
     WOLFSSL_API void EmbedOcspRespFree(void*, unsigned char*);
+    #ifdef HAVE_HTTP_CLIENT_NONBLOCK
+    WOLFSSL_API int EmbedOcspLookupNonBlock(void*, const char*, int,
+                                   unsigned char*, int, unsigned char**);
+    WOLFSSL_API void EmbedOcspRespFreeNonBlock(void*, unsigned char*);
+    #endif
 #endif
 
 #ifdef HAVE_CRL_IO
@@ -451,6 +478,10 @@ WOLFSSL_API int BioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
 
     WOLFSSL_API int EmbedCrlLookup(WOLFSSL_CRL* crl, const char* url,
         int urlSz);
+    #ifdef HAVE_HTTP_CLIENT_NONBLOCK
+    WOLFSSL_API int EmbedCrlLookupNonBlock(WOLFSSL_CRL* crl, const char* url,
+        int urlSz);
+    #endif
 #endif
 
 
@@ -469,6 +500,13 @@ WOLFSSL_API int BioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
         int dynType, void* heap);
 #endif /* HAVE_HTTP_CLIENT */
 
+#ifdef HAVE_HTTP_CLIENT_NONBLOCK
+    WOLFSSL_API WOLFIO_HTTP_NB* wolfIO_HttpNbNew(void* heap);
+    WOLFSSL_API void wolfIO_HttpNbFree(WOLFIO_HTTP_NB* nb);
+    WOLFSSL_API SOCKET_T wolfIO_HttpNbGetFd(WOLFIO_HTTP_NB* nb);
+    WOLFSSL_API int wolfIO_HttpNbWantWrite(WOLFIO_HTTP_NB* nb);
+#endif /* HAVE_HTTP_CLIENT_NONBLOCK */
+
 
 /* I/O callbacks */
 typedef int (*CallbackIORecv)(WOLFSSL *ssl, char *buf, int sz, void *ctx);